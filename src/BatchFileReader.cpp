@@ -0,0 +1,65 @@
+/****************************************************************
+ * @file BatchFileReader.cpp
+ * @brief Implements the BatchFileReader class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of BatchFileReader.
+ ***************************************************************/
+#include "BatchFileReader.h"
+#include "CommandBuilder.h"
+
+BatchFileReader::BatchFileReader()
+{
+}
+
+/****************************************************************
+ * @brief Opens a batch file, closing any previous one.
+ ***************************************************************/
+bool BatchFileReader::open(const QString &path)
+{
+    close();
+    m_file.setFileName(path);
+    return m_file.open(QIODevice::ReadOnly | QIODevice::Text);
+}
+
+void BatchFileReader::close()
+{
+    m_file.close();
+    m_lineNumber = 0;
+}
+
+QString BatchFileReader::errorString() const
+{
+    return m_file.errorString();
+}
+
+/****************************************************************
+ * @brief Reads the next non-blank line.
+ ***************************************************************/
+bool BatchFileReader::next(QStringList *values, QString *error)
+{
+    error->clear();
+    while (m_file.isOpen() && !m_file.atEnd())
+    {
+        const QString line = QString::fromUtf8(m_file.readLine()).trimmed();
+        ++m_lineNumber;
+        if (line.isEmpty())
+        {
+            continue;
+        }
+        *values = CommandBuilder::splitArguments(line, error);
+        return true;
+    }
+    return false;
+}
+
+int BatchFileReader::lineNumber() const
+{
+    return m_lineNumber;
+}
+
+/************** End of BatchFileReader.cpp **********************/
@@ -0,0 +1,59 @@
+/****************************************************************
+ * @file BatchFileReader.h
+ * @brief Declares the BatchFileReader class, a streaming batch parser.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the BatchFileReader class. It reads a batch file
+ * one line per call to next(), so only the line being parsed is in
+ * memory no matter how long the file is. Each non-blank line is
+ * split into input values with CommandBuilder::splitArguments().
+ ***************************************************************/
+#ifndef BATCHFILEREADER_H
+#define BATCHFILEREADER_H
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+/****************************************************************
+ * @class BatchFileReader
+ * @brief Reads a batch file line by line.
+ ***************************************************************/
+class BatchFileReader
+{
+public:
+    BatchFileReader();
+
+    /****************************************************************
+     * @brief Opens a batch file, closing any previous one.
+     * @return false if the file cannot be read.
+     ***************************************************************/
+    bool open(const QString &path);
+    void close();
+    QString errorString() const;
+
+    /****************************************************************
+     * @brief Reads the next non-blank line.
+     * @param values Receives the line's words.
+     * @param error Receives a message if the line is malformed
+     *        (values then hold what could be parsed), else cleared.
+     * @return false at the end of the file.
+     ***************************************************************/
+    bool next(QStringList *values, QString *error);
+
+    /****************************************************************
+     * @brief 1-based number of the line last returned by next().
+     ***************************************************************/
+    int lineNumber() const;
+
+private:
+    QFile m_file;
+    int m_lineNumber = 0;
+};
+
+#endif // BATCHFILEREADER_H
+/************** End of BatchFileReader.h ************************/
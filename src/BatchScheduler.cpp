@@ -0,0 +1,441 @@
+/****************************************************************
+ * @file BatchScheduler.cpp
+ * @brief Implements the BatchScheduler class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of BatchScheduler.
+ ***************************************************************/
+#include "BatchScheduler.h"
+#include "Telemetry.h"
+#include <QProcessEnvironment>
+#include <QTimer>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+/** Up to this many jobs the summary lists every job by name. */
+static const int kFullSummaryJobs = 200;
+
+/****************************************************************
+ * @brief Constructor: Initializes an empty, idle scheduler.
+ ***************************************************************/
+BatchScheduler::BatchScheduler(QObject *parent) : QObject(parent)
+{
+}
+
+/****************************************************************
+ * @brief Destructor: Kills jobs that are still running.
+ ***************************************************************/
+BatchScheduler::~BatchScheduler()
+{
+    for (auto it = m_running.begin(); it != m_running.end(); ++it)
+    {
+        it->process->disconnect(this);
+        it->process->kill();
+        it->process->waitForFinished(1000);
+    }
+}
+
+void BatchScheduler::setMaxParallel(int count)
+{
+    m_maxParallel = qMax(1, count);
+    if (m_active)
+    {
+        startNext();
+    }
+}
+
+int BatchScheduler::maxParallel() const
+{
+    return m_maxParallel;
+}
+
+void BatchScheduler::setTimeout(int timeoutMs)
+{
+    m_timeoutMs = qMax(0, timeoutMs);
+}
+
+int BatchScheduler::timeout() const
+{
+    return m_timeoutMs;
+}
+
+void BatchScheduler::setGpuSlots(const QList<int> &devices)
+{
+    if (m_active)
+    {
+        qWarning() << "BatchScheduler: GPU slots cannot change while running";
+        return;
+    }
+    m_gpuSlots = devices;
+}
+
+QList<int> BatchScheduler::gpuSlots() const
+{
+    return m_gpuSlots;
+}
+
+/****************************************************************
+ * @brief Queues a job.
+ ***************************************************************/
+void BatchScheduler::addJob(const QString &label, const QString &program, const QStringList &arguments)
+{
+    if (m_active)
+    {
+        qWarning() << "BatchScheduler: cannot add jobs while running";
+        return;
+    }
+    m_queue.append(Command{label, program, arguments});
+}
+
+void BatchScheduler::setSource(const Source &source)
+{
+    if (!m_active)
+    {
+        m_source = source;
+    }
+}
+
+void BatchScheduler::clear()
+{
+    if (!m_active)
+    {
+        m_queue.clear();
+        m_source = nullptr;
+        m_results.clear();
+    }
+}
+
+/****************************************************************
+ * @brief Starts jobs up to the concurrency limit.
+ ***************************************************************/
+bool BatchScheduler::start()
+{
+    if (m_active || (m_queue.isEmpty() && !m_source))
+    {
+        return false;
+    }
+    m_results.clear();
+    m_freeGpus = m_gpuSlots;
+    m_sourceDone = !m_source;
+    m_done = 0;
+    m_succeeded = 0;
+    m_batchMs = 0;
+    m_canceling = false;
+    m_active = true;
+    m_batchClock.start();
+    emit progressChanged(0, totalJobs());
+    startNext();
+    return true;
+}
+
+/****************************************************************
+ * @brief Kills running jobs and drops the rest.
+ ***************************************************************/
+void BatchScheduler::cancel()
+{
+    if (!m_active || m_canceling)
+    {
+        return;
+    }
+    m_canceling = true;
+    m_queue.clear();
+    m_sourceDone = true;
+    for (auto it = m_running.begin(); it != m_running.end(); ++it)
+    {
+        it->process->kill();
+    }
+    // The last finishJob() reports finished(); if none run, do it here
+    startNext();
+}
+
+bool BatchScheduler::isRunning() const
+{
+    return m_active;
+}
+
+int BatchScheduler::jobCount() const
+{
+    return m_results.size();
+}
+
+int BatchScheduler::runningCount() const
+{
+    return m_running.size();
+}
+
+/****************************************************************
+ * @brief Next command from the queue, then from the source.
+ ***************************************************************/
+bool BatchScheduler::takeCommand(Command *command)
+{
+    if (!m_queue.isEmpty())
+    {
+        *command = m_queue.takeFirst();
+        return true;
+    }
+    if (m_sourceDone)
+    {
+        return false;
+    }
+    if (!m_source(command))
+    {
+        m_sourceDone = true;
+        return false;
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Launches jobs while slots are free; ends the batch when
+ *        nothing is left to start or running.
+ ***************************************************************/
+void BatchScheduler::startNext()
+{
+    // A job that fails to start finishes inside startJob(); the loop
+    // below refills its slot instead of recursing once per line.
+    if (m_starting)
+    {
+        return;
+    }
+    m_starting = true;
+    Command command;
+    while (!m_canceling && freeSlots() > 0 && takeCommand(&command))
+    {
+        startJob(command);
+    }
+    m_starting = false;
+    if (m_active && m_running.isEmpty() && (m_canceling || (m_queue.isEmpty() && m_sourceDone)))
+    {
+        m_active = false;
+        m_batchMs = m_batchClock.elapsed();
+        emit progressChanged(m_done, m_results.size());
+        emit finished(m_succeeded, m_results.size() - m_succeeded);
+    }
+}
+
+/****************************************************************
+ * @brief Starts one job, with its GPU and timeout if configured.
+ ***************************************************************/
+void BatchScheduler::startJob(const Command &command)
+{
+    const int index = m_results.size();
+    Result result;
+    result.label = command.label;
+    result.gpu = m_freeGpus.isEmpty() ? -1 : m_freeGpus.takeFirst();
+    m_results.append(result);
+
+    Running &job = m_running[index];
+    job.process = new QProcess(this);
+    job.process->setProcessChannelMode(QProcess::MergedChannels);
+    if (result.gpu >= 0)
+    {
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        env.insert("CUDA_VISIBLE_DEVICES", QString::number(result.gpu));
+        job.process->setProcessEnvironment(env);
+    }
+
+    connect(job.process, &QProcess::readyReadStandardOutput, this, [this, index]() { readOutput(index); });
+    connect(job.process, &QProcess::finished, this,
+            [this, index](int exitCode, QProcess::ExitStatus status)
+            {
+                JobState state = JobState::Failed;
+                if (m_running.value(index).timedOut)
+                {
+                    state = JobState::TimedOut;
+                }
+                else if (m_canceling)
+                {
+                    state = JobState::Canceled;
+                }
+                else if (status == QProcess::NormalExit && exitCode == 0)
+                {
+                    state = JobState::Succeeded;
+                }
+                finishJob(index, state, status == QProcess::NormalExit ? exitCode : -1);
+            });
+    connect(job.process, &QProcess::errorOccurred, this,
+            [this, index](QProcess::ProcessError error)
+            {
+                if (error == QProcess::FailedToStart && m_running.contains(index))
+                {
+                    emit jobOutput(index, tr("Failed to start: %1").arg(m_running.value(index).process->errorString()));
+                    finishJob(index, JobState::Failed, -1);
+                }
+            });
+
+    if (m_timeoutMs > 0)
+    {
+        job.timer = new QTimer(this);
+        job.timer->setSingleShot(true);
+        connect(job.timer, &QTimer::timeout, this, [this, index]()
+                {
+                    const auto it = m_running.find(index);
+                    if (it != m_running.end())
+                    {
+                        it->timedOut = true;
+                        it->process->kill();
+                    }
+                });
+        job.timer->start(m_timeoutMs);
+    }
+
+    job.clock.start();
+    job.span = Telemetry::begin("batch job", "batch", QJsonObject{{"label", command.label}, {"gpu", result.gpu}});
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
+    DEBUG_MSG() << "Batch job" << index << "on GPU" << result.gpu << command.program << command.arguments;
+    emit jobStarted(index, command.label, result.gpu);
+    emit progressChanged(m_done, totalJobs());
+    job.process->start(command.program, command.arguments);
+}
+
+/****************************************************************
+ * @brief Emits the complete lines a job has written so far.
+ ***************************************************************/
+void BatchScheduler::readOutput(int index)
+{
+    const auto it = m_running.find(index);
+    if (it == m_running.end())
+    {
+        return;
+    }
+    it->pending += it->process->readAllStandardOutput();
+    const int end = it->pending.lastIndexOf('\n');
+    if (end < 0)
+    {
+        return;
+    }
+    const QString lines = QString::fromUtf8(it->pending.left(end));
+    it->pending.remove(0, end + 1);
+    emit jobOutput(index, lines);
+}
+
+/****************************************************************
+ * @brief Records a job's outcome, frees its slot and GPU.
+ ***************************************************************/
+void BatchScheduler::finishJob(int index, JobState state, int exitCode)
+{
+    if (!m_running.contains(index))
+    {
+        return;
+    }
+    readOutput(index);
+    Running job = m_running.take(index);
+    Telemetry::end(job.span, state == JobState::Succeeded);
+    if (!job.pending.isEmpty())
+    {
+        emit jobOutput(index, QString::fromUtf8(job.pending));
+    }
+    job.process->disconnect(this);
+    job.process->deleteLater();
+    if (job.timer)
+    {
+        job.timer->stop();
+        job.timer->deleteLater();
+    }
+
+    Result &result = m_results[index];
+    if (result.gpu >= 0)
+    {
+        m_freeGpus.append(result.gpu);
+    }
+    result.state = state;
+    result.exitCode = exitCode;
+    result.elapsedMs = job.clock.elapsed();
+    if (state == JobState::Succeeded)
+    {
+        ++m_succeeded;
+        if (index >= kFullSummaryJobs)
+        {
+            result.label.clear();
+        }
+    }
+    ++m_done;
+
+    emit jobFinished(index, state, exitCode);
+    emit progressChanged(m_done, totalJobs());
+    startNext();
+}
+
+int BatchScheduler::freeSlots() const
+{
+    const int slots = m_maxParallel - int(m_running.size());
+    return m_gpuSlots.isEmpty() ? slots : qMin(slots, int(m_freeGpus.size()));
+}
+
+int BatchScheduler::totalJobs() const
+{
+    return m_sourceDone ? int(m_results.size() + m_queue.size()) : -1;
+}
+
+QString BatchScheduler::stateName(JobState state)
+{
+    switch (state)
+    {
+    case JobState::Queued:
+        return tr("queued");
+    case JobState::Running:
+        return tr("running");
+    case JobState::Succeeded:
+        return tr("ok");
+    case JobState::Failed:
+        return tr("failed");
+    case JobState::TimedOut:
+        return tr("timeout");
+    case JobState::Canceled:
+        return tr("canceled");
+    }
+    return QString();
+}
+
+/****************************************************************
+ * @brief Plain-text table of the jobs and per-state totals.
+ ***************************************************************/
+QString BatchScheduler::summary() const
+{
+    const bool all = m_results.size() <= kFullSummaryJobs;
+    QStringList lines;
+    lines << QString("%1  %2 %3 %4 %5  %6")
+                 .arg("#", 6).arg(tr("State"), -9).arg(tr("Exit"), 5)
+                 .arg(tr("Time"), 9).arg(tr("GPU"), 4).arg(tr("Command"));
+
+    int counts[6] = {0, 0, 0, 0, 0, 0};
+    qint64 busyMs = 0;
+    for (int i = 0; i < m_results.size(); ++i)
+    {
+        const Result &result = m_results.at(i);
+        ++counts[static_cast<int>(result.state)];
+        busyMs += result.elapsedMs;
+        if (!all && result.state == JobState::Succeeded)
+        {
+            continue;
+        }
+        lines << QString("%1  %2 %3 %4 %5  %6")
+                     .arg(i + 1, 6)
+                     .arg(stateName(result.state), -9)
+                     .arg(result.exitCode >= 0 ? QString::number(result.exitCode) : QString("-"), 5)
+                     .arg(QString("%1s").arg(result.elapsedMs / 1000.0, 0, 'f', 1), 9)
+                     .arg(result.gpu >= 0 ? QString::number(result.gpu) : QString("-"), 4)
+                     .arg(result.label);
+    }
+    if (!all)
+    {
+        lines << tr("(%1 successful jobs not listed)").arg(counts[static_cast<int>(JobState::Succeeded)]);
+    }
+    lines << tr("%1 jobs: %2 ok, %3 failed, %4 timed out, %5 canceled; %6 s wall, %7 s total job time")
+                 .arg(m_results.size())
+                 .arg(counts[static_cast<int>(JobState::Succeeded)])
+                 .arg(counts[static_cast<int>(JobState::Failed)])
+                 .arg(counts[static_cast<int>(JobState::TimedOut)])
+                 .arg(counts[static_cast<int>(JobState::Canceled)])
+                 .arg(m_batchMs / 1000.0, 0, 'f', 1)
+                 .arg(busyMs / 1000.0, 0, 'f', 1);
+    return lines.join('\n');
+}
+
+/************** End of BatchScheduler.cpp ***********************/
@@ -0,0 +1,226 @@
+/****************************************************************
+ * @file BatchScheduler.h
+ * @brief Declares the BatchScheduler class for parallel batch jobs.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the BatchScheduler class. It runs a list of
+ * independent commands with at most N processes at a time:
+ *   - Each job may have a timeout, after which it is killed.
+ *   - A failing or timed-out job does not stop the batch.
+ *   - With GPU slots set, every running job owns one GPU and sees
+ *     only that device through CUDA_VISIBLE_DEVICES, so N is also
+ *     capped by the number of GPUs.
+ * Jobs come from addJob() and then from an optional source that
+ * is only asked for the next command when a slot frees up, so a
+ * batch of any length starts at once and only the running jobs
+ * are held in memory.
+ *
+ * Output is split into whole lines per job so lines of parallel
+ * jobs never interleave mid-line. summary() formats a table of
+ * the jobs once the batch has finished.
+ ***************************************************************/
+#ifndef BATCHSCHEDULER_H
+#define BATCHSCHEDULER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QProcess>
+#include <QElapsedTimer>
+#include <functional>
+
+class QTimer;
+
+/****************************************************************
+ * @class BatchScheduler
+ * @brief Bounded-concurrency QProcess job runner.
+ ***************************************************************/
+class BatchScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************
+     * @enum JobState
+     * @brief Lifecycle of one job.
+     ***************************************************************/
+    enum class JobState
+    {
+        Queued,
+        Running,
+        Succeeded,
+        Failed,
+        TimedOut,
+        Canceled
+    };
+
+    /****************************************************************
+     * @struct Command
+     * @brief What to run for one job.
+     ***************************************************************/
+    struct Command
+    {
+        QString label;                 ///< shown in output and summary
+        QString program;
+        QStringList arguments;
+    };
+
+    /** Fills the next command; returns false when there are no more. */
+    using Source = std::function<bool(Command *)>;
+
+    explicit BatchScheduler(QObject *parent = nullptr);
+    ~BatchScheduler();
+
+    /****************************************************************
+     * @brief Sets how many jobs may run at once (minimum 1).
+     ***************************************************************/
+    void setMaxParallel(int count);
+    int maxParallel() const;
+
+    /****************************************************************
+     * @brief Sets the per-job time limit.
+     * @param timeoutMs Milliseconds, 0 for no limit.
+     ***************************************************************/
+    void setTimeout(int timeoutMs);
+    int timeout() const;
+
+    /****************************************************************
+     * @brief Gives each running job its own GPU.
+     * @param devices CUDA device ids; empty disables GPU slots.
+     ***************************************************************/
+    void setGpuSlots(const QList<int> &devices);
+    QList<int> gpuSlots() const;
+
+    /****************************************************************
+     * @brief Queues a job; call before start().
+     * @param label Text shown in output and the summary.
+     * @param program Executable.
+     * @param arguments Arguments for the executable.
+     ***************************************************************/
+    void addJob(const QString &label, const QString &program, const QStringList &arguments);
+
+    /****************************************************************
+     * @brief Sets where jobs come from after the addJob() queue.
+     *        Called on the GUI thread whenever a slot is free.
+     * @param source Generator, or nullptr for none.
+     ***************************************************************/
+    void setSource(const Source &source);
+
+    /****************************************************************
+     * @brief Drops queued jobs, the source and past results;
+     *        ignored while running.
+     ***************************************************************/
+    void clear();
+
+    /****************************************************************
+     * @brief Starts jobs up to the concurrency limit.
+     *        Ends with finished().
+     * @return false if already running or there is nothing to run.
+     ***************************************************************/
+    bool start();
+
+    /****************************************************************
+     * @brief Kills running jobs and drops the rest; finished() is
+     *        still emitted.
+     ***************************************************************/
+    void cancel();
+
+    bool isRunning() const;
+
+    /****************************************************************
+     * @brief Jobs started so far (all jobs once finished).
+     ***************************************************************/
+    int jobCount() const;
+    int runningCount() const;
+
+    /****************************************************************
+     * @brief Plain-text table: job, state, exit code, time, GPU,
+     *        command; followed by per-state totals. Large batches
+     *        list only the jobs that did not succeed.
+     ***************************************************************/
+    QString summary() const;
+
+    static QString stateName(JobState state);
+
+signals:
+    void jobStarted(int index, const QString &label, int gpu);
+
+    /****************************************************************
+     * @brief Whole lines written by a job (stdout and stderr merged).
+     ***************************************************************/
+    void jobOutput(int index, const QString &lines);
+
+    void jobFinished(int index, BatchScheduler::JobState state, int exitCode);
+
+    /****************************************************************
+     * @param total Number of jobs, or -1 while the source may
+     *        still deliver more.
+     ***************************************************************/
+    void progressChanged(int done, int total);
+
+    void finished(int succeeded, int failed);
+
+private:
+    /****************************************************************
+     * @struct Result
+     * @brief Outcome of a started job; the label is dropped for
+     *        successful jobs of large batches.
+     ***************************************************************/
+    struct Result
+    {
+        QString label;
+        JobState state = JobState::Running;
+        int exitCode = -1;
+        int gpu = -1;
+        qint64 elapsedMs = 0;
+    };
+
+    /****************************************************************
+     * @struct Running
+     * @brief Process and bookkeeping of a running job.
+     ***************************************************************/
+    struct Running
+    {
+        QProcess *process = nullptr;
+        QTimer *timer = nullptr;
+        QElapsedTimer clock;
+        QByteArray pending;            ///< partial last line
+        bool timedOut = false;
+        qint64 span = 0;               ///< Telemetry span
+    };
+
+    bool takeCommand(Command *command);
+    void startNext();
+    void startJob(const Command &command);
+    void readOutput(int index);
+    void finishJob(int index, JobState state, int exitCode);
+    int freeSlots() const;
+    int totalJobs() const;
+
+    QList<Command> m_queue;
+    Source m_source;
+    bool m_sourceDone = false;
+    QVector<Result> m_results;
+    QHash<int, Running> m_running;
+    int m_maxParallel = 1;
+    int m_timeoutMs = 0;
+    QList<int> m_gpuSlots;
+    QList<int> m_freeGpus;
+    int m_done = 0;
+    int m_succeeded = 0;
+    bool m_active = false;
+    bool m_canceling = false;
+    bool m_starting = false;         ///< inside startNext()
+    QElapsedTimer m_batchClock;
+    qint64 m_batchMs = 0;
+};
+
+#endif // BATCHSCHEDULER_H
+/************** End of BatchScheduler.h *************************/
@@ -0,0 +1,846 @@
+/****************************************************************
+ * @file CandidateFetcher.cpp
+ * @brief Implements the CandidateFetcher class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of CandidateFetcher.
+ * Only final releases (digits and dots) that are not yanked are
+ * candidates; pre-, post- and dev releases are skipped like the
+ * bash resolver does. The requires_dist phase only narrows the
+ * matrix; a failed metadata lookup leaves that candidate without
+ * edges.
+ ***************************************************************/
+#include "CandidateFetcher.h"
+#include "DependencyGraph.h"
+#include "PackedVersion.h"
+#include "Telemetry.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QRegularExpression>
+#include <QSet>
+#include <QUrl>
+#include <QDebug>
+#include <algorithm>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const int kRequestTimeoutMs = 30000;
+static const qint64 kMaxCacheBytes = 256LL * 1024 * 1024;
+static const qint64 kReleasesFreshMs = 15 * 60 * 1000; ///< about as long as PyPI lets caches keep them
+
+/****************************************************************
+ * @struct RequirementSpec
+ * @brief The parts of a requirement line that select candidates.
+ ***************************************************************/
+struct RequirementSpec
+{
+    QString name;            ///< as written, including [extras]
+    QString project;         ///< PEP 503 normalized, for the URL
+    QString floor;
+    bool strictFloor = false;
+    QString upper;
+    bool upperInclusive = false;
+    QString exact;           ///< "===" pin, the only candidate
+    QStringList excluded;    ///< "!=" versions, "X.*" for a prefix
+    SpecifierSet specifiers; ///< exact PEP 440 check where it compiles
+};
+
+/****************************************************************
+ * @brief Splits a version into its numeric release components.
+ ***************************************************************/
+static QVector<int> versionParts(const QString &version)
+{
+    QVector<int> parts;
+    const QStringList fields = version.split('.');
+    parts.reserve(fields.size());
+    for (int i = 0; i < fields.size(); ++i)
+    {
+        parts.append(fields.at(i).toInt());
+    }
+    return parts;
+}
+
+/****************************************************************
+ * @brief Increments the second-to-last component ("1.4.2" -> "1.5").
+ *        Used for the upper bound of "~=" and "==X.*".
+ ***************************************************************/
+static QString bumpPrefix(const QStringList &fields)
+{
+    if (fields.isEmpty())
+    {
+        return QString();
+    }
+    QStringList prefix = fields.mid(0, fields.size() - 1);
+    if (prefix.isEmpty())
+    {
+        prefix = fields;
+    }
+    prefix.last() = QString::number(prefix.last().toInt() + 1);
+    return prefix.join('.');
+}
+
+/****************************************************************
+ * @brief Release group of a version: major.minor.
+ ***************************************************************/
+static QString minorGroup(const QString &version)
+{
+    const QStringList fields = version.split('.');
+    return fields.first() + '.' + (fields.size() > 1 ? fields.at(1) : QString("0"));
+}
+
+/****************************************************************
+ * @brief Final releases only: "1", "1.4", "1.4.2" ...
+ ***************************************************************/
+static bool isStableVersion(const QString &version)
+{
+    static const QRegularExpression re("^\\d+(\\.\\d+)*$");
+    return re.match(version).hasMatch();
+}
+
+/****************************************************************
+ * @brief Folds the parsed clauses of a requirement into a range.
+ * @param floorEqual true for candidate selection, where "==V" in
+ *        requirements.txt is a floor (V and the next minors);
+ *        false for requires_dist, where it pins V exactly.
+ * @return false for lines that are not resolved through the index
+ *         (options, URLs, editable installs, invalid lines).
+ ***************************************************************/
+static bool parseRequirement(const Requirement &requirement, RequirementSpec *spec, bool floorEqual)
+{
+    if (requirement.kind != Requirement::Kind::Package || !requirement.url.isEmpty())
+    {
+        return false;
+    }
+    spec->name = requirement.nameWithExtras();
+    spec->project = requirement.project;
+    Requirement compiled = requirement;
+    for (int i = 0; floorEqual && i < compiled.clauses.size(); ++i)
+    {
+        if (compiled.clauses.at(i).op == Requirement::Op::Equal && !compiled.version(i).endsWith(".*"))
+        {
+            compiled.clauses[i].op = Requirement::Op::GreaterEqual;
+        }
+    }
+    spec->specifiers = SpecifierSet::compile(compiled);
+
+    for (int i = 0; i < requirement.clauses.size(); ++i)
+    {
+        const Requirement::Op oper = requirement.clauses.at(i).op;
+        QString version = requirement.version(i);
+        QString floor;
+        QString upper;
+        bool strict = false;
+
+        if (oper == Requirement::Op::Arbitrary)
+        {
+            spec->exact = version;
+            continue;
+        }
+        if (oper == Requirement::Op::Equal && version.endsWith(".*"))
+        {
+            version.chop(2);
+            QStringList fields = version.split('.');
+            fields.append("0");
+            floor = version;
+            upper = bumpPrefix(fields);
+        }
+        else if (oper == Requirement::Op::Equal || oper == Requirement::Op::GreaterEqual)
+        {
+            floor = version;
+            if (oper == Requirement::Op::Equal && !floorEqual
+                && (spec->upper.isEmpty() || CandidateFetcher::compareVersions(version, spec->upper) <= 0))
+            {
+                spec->upper = version;
+                spec->upperInclusive = true;
+            }
+        }
+        else if (oper == Requirement::Op::Greater)
+        {
+            floor = version;
+            strict = true;
+        }
+        else if (oper == Requirement::Op::Compatible)
+        {
+            floor = version;
+            upper = bumpPrefix(version.split('.'));
+        }
+        else if (oper == Requirement::Op::Less || oper == Requirement::Op::LessEqual)
+        {
+            if (spec->upper.isEmpty() || CandidateFetcher::compareVersions(version, spec->upper) < 0)
+            {
+                spec->upper = version;
+                spec->upperInclusive = oper == Requirement::Op::LessEqual;
+            }
+            continue;
+        }
+        else if (oper == Requirement::Op::NotEqual)
+        {
+            spec->excluded << version;
+            continue;
+        }
+
+        if (!floor.isEmpty()
+            && (spec->floor.isEmpty() || CandidateFetcher::compareVersions(floor, spec->floor) > 0))
+        {
+            spec->floor = floor;
+            spec->strictFloor = strict;
+        }
+        if (!upper.isEmpty()
+            && (spec->upper.isEmpty() || CandidateFetcher::compareVersions(upper, spec->upper) < 0))
+        {
+            spec->upper = upper;
+            spec->upperInclusive = false;
+        }
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief True if the leading release numbers of a version are the
+ *        prefix of a "!=X.*" exclusion.
+ ***************************************************************/
+static bool hasPrefix(const QString &version, QString prefix)
+{
+    prefix.chop(2);
+    const QVector<int> head = versionParts(prefix);
+    const QVector<int> parts = versionParts(version);
+    for (int i = 0; i < head.size(); ++i)
+    {
+        if ((i < parts.size() ? parts.at(i) : 0) != head.at(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Checks a release against the parsed specifiers: through
+ *        the compiled SpecifierSet, the same check DependencyGraph
+ *        makes, and by release numbers only for what it cannot hold.
+ ***************************************************************/
+static bool inRange(const RequirementSpec &spec, const QString &version)
+{
+    PackedVersion packed;
+    if (spec.specifiers.isValid() && PackedVersion::pack(version, &packed))
+    {
+        return spec.specifiers.matches(packed);
+    }
+    if (!spec.floor.isEmpty())
+    {
+        const int c = CandidateFetcher::compareVersions(version, spec.floor);
+        if (c < 0 || (c == 0 && spec.strictFloor))
+        {
+            return false;
+        }
+    }
+    if (!spec.upper.isEmpty())
+    {
+        const int c = CandidateFetcher::compareVersions(version, spec.upper);
+        if (c > 0 || (c == 0 && !spec.upperInclusive))
+        {
+            return false;
+        }
+    }
+    for (int i = 0; i < spec.excluded.size(); ++i)
+    {
+        const QString &excluded = spec.excluded.at(i);
+        if (excluded.endsWith(".*") ? hasPrefix(version, excluded)
+                                    : CandidateFetcher::compareVersions(version, excluded) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Constructor: Sets up the shared manager and disk cache.
+ ***************************************************************/
+CandidateFetcher::CandidateFetcher(QObject *parent)
+    : QObject(parent)
+    , m_indexUrl("https://pypi.org/pypi")
+{
+    m_diskCache = new QNetworkDiskCache(this);
+    m_diskCache->setMaximumCacheSize(kMaxCacheBytes);
+    setCacheDir(QDir::temp().filePath("PipMatrixResolver/http"));
+    m_metadataDir = QDir::temp().filePath("PipMatrixResolver");
+    m_manager.setCache(m_diskCache);
+    m_manager.setAutoDeleteReplies(false);
+}
+
+void CandidateFetcher::setCacheDir(const QString &dir)
+{
+    QDir().mkpath(dir);
+    m_diskCache->setCacheDirectory(dir);
+}
+
+void CandidateFetcher::setMetadataDir(const QString &dir)
+{
+    m_metadataDir = dir;
+}
+
+void CandidateFetcher::setMatrixRange(int range)
+{
+    m_matrixRange = qMax(0, range);
+}
+
+int CandidateFetcher::matrixRange() const
+{
+    return m_matrixRange;
+}
+
+void CandidateFetcher::setIndexUrl(const QString &url)
+{
+    m_indexUrl = url;
+    while (m_indexUrl.endsWith('/'))
+    {
+        m_indexUrl.chop(1);
+    }
+}
+
+QNetworkAccessManager *CandidateFetcher::networkManager()
+{
+    return &m_manager;
+}
+
+bool CandidateFetcher::isFetching() const
+{
+    return !m_replies.isEmpty() || !m_metadataReplies.isEmpty();
+}
+
+const QVector<ResolverSet> &CandidateFetcher::staticConflicts() const
+{
+    return m_staticConflicts;
+}
+
+const QHash<QString, QSet<QString>> &CandidateFetcher::dependencies() const
+{
+    return m_dependencies;
+}
+
+/****************************************************************
+ * @brief Issues one JSON API request, through the shared cache
+ *        unless the metadata store keeps what is used of it.
+ ***************************************************************/
+QNetworkReply *CandidateFetcher::get(const QString &url, const QByteArray &etag)
+{
+    QNetworkRequest request{QUrl(url)};
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    if (m_store.path().isEmpty())
+    {
+        request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+        request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, true);
+    }
+    else
+    {
+        request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+        request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+        if (!etag.isEmpty())
+        {
+            request.setRawHeader("If-None-Match", etag);
+        }
+    }
+    request.setRawHeader("Accept", "application/json");
+    request.setTransferTimeout(kRequestTimeoutMs);
+    return m_manager.get(request);
+}
+
+/****************************************************************
+ * @brief Maps the store of the current index, if it is not yet.
+ ***************************************************************/
+void CandidateFetcher::openStore()
+{
+    if (m_metadataDir.isEmpty())
+    {
+        m_store.open(QString());
+        return;
+    }
+    const QByteArray hash = QCryptographicHash::hash(m_indexUrl.toUtf8(), QCryptographicHash::Sha1).toHex();
+    const QString path = QDir(m_metadataDir).filePath(QString("metadata-%1.pmrm").arg(QString(hash.left(8))));
+    if (path != m_store.path())
+    {
+        m_store.open(path);
+    }
+}
+
+/****************************************************************
+ * @brief Starts discovery for every requirement line at once.
+ ***************************************************************/
+void CandidateFetcher::fetch(const QStringList &requirementLines)
+{
+    const QStringList lines = Requirement::logicalLines(requirementLines);
+    QVector<Requirement> requirements;
+    requirements.reserve(lines.size());
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        requirements.append(Requirement::parse(lines.at(i)));
+    }
+    fetch(requirements);
+}
+
+/****************************************************************
+ * @brief Starts discovery for already parsed requirements.
+ ***************************************************************/
+void CandidateFetcher::fetch(const QVector<Requirement> &requirements)
+{
+    cancel();
+    m_requirements.clear();
+    m_releases.clear();
+    m_packages.clear();
+    m_requiresDist.clear();
+    m_staticConflicts.clear();
+    m_dependencies.clear();
+    m_fromCache = 0;
+    m_elapsed.start();
+    openStore();
+
+    QStringList projects;
+    QSet<QString> seen;
+    for (int i = 0; i < requirements.size(); ++i)
+    {
+        const Requirement &requirement = requirements.at(i);
+        if (requirement.kind == Requirement::Kind::Blank || requirement.kind == Requirement::Kind::Comment)
+        {
+            continue;
+        }
+        m_requirements.append(requirement);
+        if (requirement.isIndexPackage() && !seen.contains(requirement.project))
+        {
+            seen.insert(requirement.project);
+            projects << requirement.project;
+        }
+    }
+
+    m_total = projects.size();
+    emit logMessage(tr("Querying PyPI for %1 packages").arg(m_total));
+    m_span = Telemetry::begin("PyPI lookup", "network", QJsonObject{{"projects", m_total}});
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < projects.size(); ++i)
+    {
+        const QString &project = projects.at(i);
+        if (m_store.contains(project) && now - m_store.checked(project) < kReleasesFreshMs)
+        {
+            m_releases.insert(project, m_store.releases(project));
+            ++m_fromCache;
+            Telemetry::add(Telemetry::Counter::CacheHits);
+            continue;
+        }
+        QNetworkReply *reply = get(QString("%1/%2/json").arg(m_indexUrl, project), m_store.etag(project));
+        m_replies.insert(reply, project);
+        connect(reply, &QNetworkReply::finished, this, &CandidateFetcher::onReplyFinished);
+    }
+    if (m_replies.isEmpty())
+    {
+        finishAll();
+    }
+}
+
+/****************************************************************
+ * @brief Aborts outstanding requests.
+ ***************************************************************/
+void CandidateFetcher::cancel()
+{
+    const QList<QNetworkReply *> replies = m_replies.keys() + m_metadataReplies.keys();
+    m_replies.clear();
+    m_metadataReplies.clear();
+    Telemetry::end(m_span, false);
+    m_span = 0;
+    for (int i = 0; i < replies.size(); ++i)
+    {
+        replies.at(i)->disconnect(this);
+        replies.at(i)->abort();
+        replies.at(i)->deleteLater();
+    }
+}
+
+/****************************************************************
+ * @brief Collects the non-yanked releases of one project.
+ ***************************************************************/
+void CandidateFetcher::onReplyFinished()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    if (!reply || !m_replies.contains(reply))
+    {
+        return;
+    }
+    const QString project = m_replies.take(reply);
+    reply->deleteLater();
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (reply->error() != QNetworkReply::NoError && m_store.contains(project))
+    {
+        emit logMessage(tr("PyPI lookup failed for %1: %2; using the stored releases")
+                            .arg(project, reply->errorString()));
+        m_releases.insert(project, m_store.releases(project));
+    }
+    else if (reply->error() != QNetworkReply::NoError)
+    {
+        emit logMessage(tr("PyPI lookup failed for %1: %2").arg(project, reply->errorString()));
+    }
+    else if (status == 304 && m_store.contains(project))
+    {
+        m_store.markChecked(project);
+        m_releases.insert(project, m_store.releases(project));
+        ++m_fromCache;
+        Telemetry::add(Telemetry::Counter::CacheHits);
+    }
+    else
+    {
+        const QByteArray body = reply->readAll();
+        if (reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool())
+        {
+            ++m_fromCache;
+            Telemetry::add(Telemetry::Counter::CacheHits);
+        }
+        else
+        {
+            Telemetry::add(Telemetry::Counter::BytesDownloaded, body.size());
+        }
+        const QJsonObject releases = QJsonDocument::fromJson(body).object().value("releases").toObject();
+        QStringList versions;
+        for (auto it = releases.constBegin(); it != releases.constEnd(); ++it)
+        {
+            const QJsonArray files = it.value().toArray();
+            bool available = false;
+            for (int i = 0; i < files.size() && !available; ++i)
+            {
+                available = !files.at(i).toObject().value("yanked").toBool();
+            }
+            if (available)
+            {
+                versions << it.key();
+            }
+        }
+        m_releases.insert(project, versions);
+        if (!m_store.path().isEmpty())
+        {
+            m_store.setReleases(project, versions, reply->rawHeader("ETag"));
+        }
+    }
+
+    emit progressChanged(m_total - m_replies.size(), m_total);
+    if (m_replies.isEmpty())
+    {
+        finishAll();
+    }
+}
+
+/****************************************************************
+ * @brief Builds every column in one pass once all responses are
+ *        in, then asks for each candidate's requires_dist.
+ ***************************************************************/
+void CandidateFetcher::finishAll()
+{
+    m_packages.clear();
+    m_packages.reserve(m_requirements.size());
+    for (int i = 0; i < m_requirements.size(); ++i)
+    {
+        const Requirement &requirement = m_requirements.at(i);
+        PackageCandidates pkg = buildCandidates(requirement, m_releases.value(requirement.project),
+                                                m_matrixRange);
+        if (pkg.versions.isEmpty())
+        {
+            // Unknown project, failed lookup, URL, include or option
+            // line: pip-compile gets the line exactly as written.
+            pkg.name = requirement.line;
+            pkg.marker.clear();
+            pkg.versions = QStringList{QString()};
+        }
+        m_packages.append(pkg);
+    }
+    emit logMessage(tr("Candidate discovery: %1 packages in %2 ms (%3 from cache)")
+                        .arg(m_total)
+                        .arg(m_elapsed.elapsed())
+                        .arg(m_fromCache));
+
+    m_requiresDist.clear();
+    m_requiresDist.resize(m_packages.size());
+    m_metadataFailed = 0;
+    m_metadataStored = 0;
+    for (int i = 0; i < m_packages.size(); ++i)
+    {
+        const QStringList &versions = m_packages.at(i).versions;
+        m_requiresDist[i].resize(versions.size());
+        for (int j = 0; j < versions.size(); ++j)
+        {
+            if (versions.at(j).isEmpty())
+            {
+                continue;
+            }
+            if (m_store.requiresDist(m_requirements.at(i).project, versions.at(j), &m_requiresDist[i][j]))
+            {
+                ++m_metadataStored;
+                continue;
+            }
+            QNetworkReply *reply = get(QString("%1/%2/%3/json")
+                                           .arg(m_indexUrl, m_requirements.at(i).project, versions.at(j)));
+            m_metadataReplies.insert(reply, ResolverChoice{i, j});
+            connect(reply, &QNetworkReply::finished, this, &CandidateFetcher::onMetadataFinished);
+        }
+    }
+    m_metadataTotal = int(m_metadataReplies.size());
+    if (m_metadataReplies.isEmpty())
+    {
+        finishMetadata();
+    }
+}
+
+/****************************************************************
+ * @brief Collects the requires_dist of one candidate.
+ ***************************************************************/
+void CandidateFetcher::onMetadataFinished()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    if (!reply || !m_metadataReplies.contains(reply))
+    {
+        return;
+    }
+    const ResolverChoice candidate = m_metadataReplies.take(reply);
+    reply->deleteLater();
+
+    if (reply->error() != QNetworkReply::NoError)
+    {
+        ++m_metadataFailed;
+        DEBUG_MSG() << "metadata lookup failed" << reply->url() << reply->errorString();
+    }
+    else
+    {
+        const QByteArray body = reply->readAll();
+        if (reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool())
+        {
+            Telemetry::add(Telemetry::Counter::CacheHits);
+        }
+        else
+        {
+            Telemetry::add(Telemetry::Counter::BytesDownloaded, body.size());
+        }
+        // null when the project publishes no dependency metadata
+        const QJsonArray entries = QJsonDocument::fromJson(body).object().value("info").toObject()
+                                       .value("requires_dist").toArray();
+        QStringList &requiresDist = m_requiresDist[candidate.package][candidate.version];
+        for (int i = 0; i < entries.size(); ++i)
+        {
+            requiresDist << entries.at(i).toString();
+        }
+        m_store.setRequiresDist(m_requirements.at(candidate.package).project,
+                                m_packages.at(candidate.package).versions.at(candidate.version), requiresDist);
+    }
+
+    emit progressChanged(m_metadataTotal - int(m_metadataReplies.size()), m_metadataTotal);
+    if (m_metadataReplies.isEmpty())
+    {
+        finishMetadata();
+    }
+}
+
+/****************************************************************
+ * @brief Narrows and reorders the matrix by its dependency graph.
+ ***************************************************************/
+void CandidateFetcher::finishMetadata()
+{
+    DependencyGraph graph(m_packages);
+    for (int i = 0; i < m_requiresDist.size(); ++i)
+    {
+        for (int j = 0; j < m_requiresDist.at(i).size(); ++j)
+        {
+            graph.addRequiresDist(i, j, m_requiresDist.at(i).at(j));
+        }
+    }
+    const int removed = graph.eliminate();
+
+    QStringList projects;
+    for (int i = 0; i < m_packages.size(); ++i)
+    {
+        projects << Requirement::parse(m_packages.at(i).name).project;
+    }
+    for (int i = 0; i < m_requiresDist.size(); ++i)
+    {
+        for (int j = 0; j < m_requiresDist.at(i).size(); ++j)
+        {
+            const QStringList &entries = m_requiresDist.at(i).at(j);
+            for (int k = 0; k < entries.size(); ++k)
+            {
+                const QString project = Requirement::parse(entries.at(k)).project;
+                if (!project.isEmpty() && !projects.at(i).isEmpty() && project != projects.at(i)
+                    && projects.contains(project))
+                {
+                    m_dependencies[projects.at(i)].insert(project);
+                }
+            }
+        }
+    }
+
+    QVector<PackageCandidates> packages = m_packages;
+    m_staticConflicts = graph.apply(&packages);
+    if (m_metadataStored > 0)
+    {
+        emit logMessage(tr("requires_dist of %1 candidates from the metadata store").arg(m_metadataStored));
+    }
+    if (m_store.isDirty())
+    {
+        QString error;
+        if (!m_store.save(&error))
+        {
+            emit logMessage(tr("Cannot save the metadata store %1: %2").arg(m_store.path(), error));
+        }
+    }
+    if (m_metadataFailed > 0)
+    {
+        emit logMessage(tr("No requires_dist for %1 of %2 candidates").arg(m_metadataFailed).arg(m_metadataTotal));
+    }
+    emit logMessage(tr("Dependency graph: %1 edges, %2 candidates removed, %3 pairs ruled out")
+                        .arg(graph.edgeCount())
+                        .arg(removed)
+                        .arg(m_staticConflicts.size()));
+    m_packages.clear();
+    m_requiresDist.clear();
+    Telemetry::end(m_span);
+    m_span = 0;
+    emit candidatesReady(packages);
+}
+
+/****************************************************************
+ * @brief Turns a list of released versions into candidates.
+ ***************************************************************/
+PackageCandidates CandidateFetcher::buildCandidates(const QString &requirement,
+                                                    const QStringList &releases,
+                                                    int matrixRange)
+{
+    return buildCandidates(Requirement::parse(requirement), releases, matrixRange);
+}
+
+PackageCandidates CandidateFetcher::buildCandidates(const Requirement &requirement,
+                                                    const QStringList &releases,
+                                                    int matrixRange)
+{
+    PackageCandidates pkg;
+    RequirementSpec spec;
+    if (!parseRequirement(requirement, &spec, true))
+    {
+        return pkg;
+    }
+    pkg.name = spec.name;
+    pkg.marker = requirement.text(requirement.marker).toString();
+    if (!spec.exact.isEmpty())
+    {
+        pkg.versions << spec.exact;
+        return pkg;
+    }
+
+    QStringList stable;
+    for (int i = 0; i < releases.size(); ++i)
+    {
+        if (isStableVersion(releases.at(i)) && inRange(spec, releases.at(i)))
+        {
+            stable << releases.at(i);
+        }
+    }
+    if (stable.isEmpty())
+    {
+        return pkg;
+    }
+    std::sort(stable.begin(), stable.end(),
+              [](const QString &a, const QString &b) { return compareVersions(a, b) < 0; });
+
+    // Latest patch of every minor release, oldest first
+    QStringList minors;
+    QString group;
+    for (int i = 0; i < stable.size(); ++i)
+    {
+        const QString g = minorGroup(stable.at(i));
+        if (g == group)
+        {
+            minors.last() = stable.at(i);
+        }
+        else
+        {
+            minors << stable.at(i);
+            group = g;
+        }
+    }
+
+    if (!spec.floor.isEmpty())
+    {
+        // floor (first release that satisfies it) + next minors
+        pkg.versions << stable.first();
+        const QString floorGroup = minorGroup(stable.first());
+        int start = 0;
+        while (start < minors.size() && minorGroup(minors.at(start)) != floorGroup)
+        {
+            ++start;
+        }
+        for (int k = 1; k <= matrixRange && start + k < minors.size(); ++k)
+        {
+            pkg.versions << minors.at(start + k);
+        }
+    }
+    else
+    {
+        // No floor: the newest minors, newest first
+        for (int k = 0; k <= matrixRange && k < minors.size(); ++k)
+        {
+            pkg.versions << minors.at(minors.size() - 1 - k);
+        }
+    }
+    return pkg;
+}
+
+/****************************************************************
+ * @brief Checks a final release against a requirement's specifiers.
+ ***************************************************************/
+bool CandidateFetcher::satisfies(const Requirement &requirement, const QString &version)
+{
+    RequirementSpec spec;
+    if (!parseRequirement(requirement, &spec, false))
+    {
+        return false;
+    }
+    if (!spec.exact.isEmpty())
+    {
+        return spec.exact == version;
+    }
+    return inRange(spec, version);
+}
+
+/****************************************************************
+ * @brief PEP 503 normalized project name.
+ ***************************************************************/
+QString CandidateFetcher::normalizeName(const QString &name)
+{
+    return Requirement::normalizeName(name);
+}
+
+/****************************************************************
+ * @brief Numeric comparison of release versions.
+ ***************************************************************/
+int CandidateFetcher::compareVersions(const QString &a, const QString &b)
+{
+    const QVector<int> pa = versionParts(a);
+    const QVector<int> pb = versionParts(b);
+    const int n = qMax(pa.size(), pb.size());
+    for (int i = 0; i < n; ++i)
+    {
+        const int x = i < pa.size() ? pa.at(i) : 0;
+        const int y = i < pb.size() ? pb.at(i) : 0;
+        if (x != y)
+        {
+            return x < y ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/************** End of CandidateFetcher.cpp *********************/
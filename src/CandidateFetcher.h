@@ -0,0 +1,213 @@
+/****************************************************************
+ * @file CandidateFetcher.h
+ * @brief Declares the CandidateFetcher class for PyPI discovery.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the CandidateFetcher class. Given the lines of
+ * a requirements file it queries the PyPI JSON API
+ * (/pypi/<project>/json) for every package at once and builds the
+ * resolver's candidate matrix: the floor version from the
+ * requirement plus the latest patch of the next MATRIX_RANGE
+ * minor releases.
+ *
+ * Then every candidate's own metadata (/pypi/<project>/<version>/json)
+ * is fetched for its requires_dist. A DependencyGraph over those
+ * drops the candidates nothing else can accompany, orders the
+ * columns most constrained first and lists the candidate pairs that
+ * exclude each other (staticConflicts()), so the resolver never
+ * compiles them.
+ *
+ * One QNetworkAccessManager is shared by all requests (and may be
+ * reused by other downloads through networkManager()). HTTP/2 is
+ * allowed so the requests multiplex over one connection, and a
+ * QNetworkDiskCache stores responses; stale entries are
+ * revalidated with If-None-Match / If-Modified-Since, so an
+ * unchanged project costs a 304 instead of a full download.
+ *
+ * With a metadata directory set, the releases and requires_dist
+ * go to a MetadataStore instead of the disk cache: projects
+ * checked in the last 15 minutes come straight from the mapped
+ * file, older ones are revalidated against the stored ETag (a 304
+ * is answered from the store, without the body) and a requires_dist
+ * once stored is never requested again. If the index cannot be
+ * reached, stored releases are used as they are.
+ ***************************************************************/
+#ifndef CANDIDATEFETCHER_H
+#define CANDIDATEFETCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QNetworkAccessManager>
+#include "MetadataStore.h"
+#include "Requirement.h"
+#include "ResolverEngine.h"
+
+class QNetworkDiskCache;
+class QNetworkReply;
+
+/****************************************************************
+ * @class CandidateFetcher
+ * @brief Concurrent, cached PyPI version lookup.
+ ***************************************************************/
+class CandidateFetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CandidateFetcher(QObject *parent = nullptr);
+
+    /****************************************************************
+     * @brief Sets where HTTP responses are cached.
+     * @param dir Directory for the QNetworkDiskCache.
+     ***************************************************************/
+    void setCacheDir(const QString &dir);
+
+    /****************************************************************
+     * @brief Sets where the MetadataStore of each index is kept
+     *        (metadata-<index hash>.pmrm); empty turns it off.
+     ***************************************************************/
+    void setMetadataDir(const QString &dir);
+
+    /****************************************************************
+     * @brief Sets how many newer minor releases follow the floor.
+     * @param range MATRIX_RANGE, 0 keeps only the floor.
+     ***************************************************************/
+    void setMatrixRange(int range);
+    int matrixRange() const;
+
+    /****************************************************************
+     * @brief Sets the JSON API root, default https://pypi.org/pypi.
+     ***************************************************************/
+    void setIndexUrl(const QString &url);
+
+    /****************************************************************
+     * @brief The shared manager; use it for other downloads so they
+     *        share connections and the disk cache.
+     ***************************************************************/
+    QNetworkAccessManager *networkManager();
+
+    /****************************************************************
+     * @brief Starts discovery for every requirement line at once.
+     *        Ends with candidatesReady(), even if some lookups fail
+     *        (those lines are passed through unpinned).
+     * @param requirementLines Lines of a requirements file.
+     ***************************************************************/
+    void fetch(const QStringList &requirementLines);
+
+    /****************************************************************
+     * @brief Same, for requirements already parsed by the caller
+     *        (the requirements table parses each line once on load).
+     ***************************************************************/
+    void fetch(const QVector<Requirement> &requirements);
+
+    /****************************************************************
+     * @brief Aborts outstanding requests; no signal is emitted.
+     ***************************************************************/
+    void cancel();
+
+    bool isFetching() const;
+
+    /****************************************************************
+     * @brief Turns a list of released versions into candidates.
+     * @param requirement One requirement line (name, extras, specifiers).
+     * @param releases Versions published for the project.
+     * @param matrixRange Newer minor releases to add after the floor.
+     * @return Candidate column; versions empty if nothing matched.
+     ***************************************************************/
+    static PackageCandidates buildCandidates(const QString &requirement,
+                                             const QStringList &releases,
+                                             int matrixRange);
+    static PackageCandidates buildCandidates(const Requirement &requirement,
+                                             const QStringList &releases,
+                                             int matrixRange);
+
+    /****************************************************************
+     * @brief PEP 503 normalized project name ("Foo_Bar" -> "foo-bar").
+     ***************************************************************/
+    static QString normalizeName(const QString &name);
+
+    /****************************************************************
+     * @brief Numeric comparison of release versions ("1.10" > "1.9").
+     * @return <0, 0 or >0.
+     ***************************************************************/
+    static int compareVersions(const QString &a, const QString &b);
+
+    /****************************************************************
+     * @brief Checks a final release against a requirement's
+     *        specifiers (name, extras and marker are not looked at),
+     *        through SpecifierSet wherever it compiles.
+     ***************************************************************/
+    static bool satisfies(const Requirement &requirement, const QString &version);
+
+    /****************************************************************
+     * @brief Candidate pairs ruled out by requires_dist in the last
+     *        candidatesReady() matrix; see
+     *        ResolverEngine::setStaticConflicts().
+     ***************************************************************/
+    const QVector<ResolverSet> &staticConflicts() const;
+
+    /****************************************************************
+     * @brief Project -> matrix projects that some candidate of it
+     *        names in requires_dist (markers included), from the
+     *        last candidatesReady() matrix.
+     ***************************************************************/
+    const QHash<QString, QSet<QString>> &dependencies() const;
+
+signals:
+    /****************************************************************
+     * @brief Emitted once with one column per requirement line.
+     ***************************************************************/
+    void candidatesReady(const QVector<PackageCandidates> &packages);
+
+    /****************************************************************
+     * @brief Emitted as responses arrive.
+     ***************************************************************/
+    void progressChanged(int done, int total);
+
+    void logMessage(const QString &message);
+
+private slots:
+    void onReplyFinished();
+    void onMetadataFinished();
+
+private:
+    QNetworkReply *get(const QString &url, const QByteArray &etag = QByteArray());
+    void openStore();
+    void finishAll();
+    void finishMetadata();
+
+    QNetworkAccessManager m_manager;
+    QNetworkDiskCache *m_diskCache = nullptr;
+    QString m_indexUrl;
+    QString m_metadataDir;
+    MetadataStore m_store;
+    int m_matrixRange = 2;
+
+    QVector<Requirement> m_requirements;       ///< requirements being fetched
+    QHash<QString, QStringList> m_releases;    ///< project -> released versions
+    QHash<QNetworkReply *, QString> m_replies; ///< outstanding reply -> project
+    QVector<PackageCandidates> m_packages;     ///< columns waiting for metadata
+    QVector<QVector<QStringList>> m_requiresDist; ///< column -> version -> entries
+    QHash<QNetworkReply *, ResolverChoice> m_metadataReplies; ///< reply -> candidate
+    QVector<ResolverSet> m_staticConflicts;
+    QHash<QString, QSet<QString>> m_dependencies; ///< project -> projects it requires
+    int m_metadataTotal = 0;
+    int m_metadataFailed = 0;
+    int m_metadataStored = 0;        ///< requires_dist read from m_store
+    int m_total = 0;
+    int m_fromCache = 0;
+    qint64 m_span = 0;               ///< Telemetry span of the whole lookup
+    QElapsedTimer m_elapsed;
+};
+
+#endif // CANDIDATEFETCHER_H
+/************** End of CandidateFetcher.h ***********************/
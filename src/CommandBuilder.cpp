@@ -0,0 +1,150 @@
+/****************************************************************
+ * @file CommandBuilder.cpp
+ * @brief Implements the CommandBuilder class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of CommandBuilder.
+ ***************************************************************/
+#include "CommandBuilder.h"
+#include <QObject>
+
+/****************************************************************
+ * @brief Constructor: Captures the project; extra args are split
+ *        once here instead of for every command.
+ ***************************************************************/
+CommandBuilder::CommandBuilder(const ProjectDef &project, const QString &python, const QString &extraArgs)
+    : m_project(project)
+    , m_python(python)
+    , m_extraArgs(splitArguments(extraArgs))
+{
+}
+
+/****************************************************************
+ * @brief Program and arguments for one set of input values.
+ ***************************************************************/
+void CommandBuilder::build(const QStringList &values, QString *program, QStringList *arguments) const
+{
+    *program = m_python;
+    arguments->clear();
+    *arguments << m_project.scriptPath;
+    for (int i = 0; i < m_project.inputs.size() && i < values.size(); ++i)
+    {
+        if (values.at(i).isEmpty())
+        {
+            continue;
+        }
+        if (!m_project.inputs.at(i).switchName.isEmpty())
+        {
+            *arguments << m_project.inputs.at(i).switchName;
+        }
+        *arguments << values.at(i);
+    }
+    *arguments << m_extraArgs;
+}
+
+/****************************************************************
+ * @brief The same command as one displayable, quoted line.
+ ***************************************************************/
+QString CommandBuilder::commandLine(const QStringList &values) const
+{
+    QString program;
+    QStringList arguments;
+    build(values, &program, &arguments);
+    QStringList words;
+    words << quote(program);
+    for (int i = 0; i < arguments.size(); ++i)
+    {
+        words << quote(arguments.at(i));
+    }
+    return words.join(' ');
+}
+
+/****************************************************************
+ * @brief Splits a line into words with shell-style quoting.
+ ***************************************************************/
+QStringList CommandBuilder::splitArguments(const QString &line, QString *error)
+{
+    QStringList words;
+    QString word;
+    bool inWord = false;
+    QChar quoteChar;
+    for (int i = 0; i < line.size(); ++i)
+    {
+        const QChar c = line.at(i);
+        if (!quoteChar.isNull())
+        {
+            if (c == quoteChar)
+            {
+                quoteChar = QChar();
+            }
+            else if (c == '\\' && quoteChar == '"' && i + 1 < line.size() && line.at(i + 1) == '"')
+            {
+                word += line.at(++i);
+            }
+            else
+            {
+                word += c;
+            }
+        }
+        else if (c.isSpace())
+        {
+            if (inWord)
+            {
+                words << word;
+                word.clear();
+                inWord = false;
+            }
+        }
+        else if (c == '"' || c == '\'')
+        {
+            quoteChar = c;
+            inWord = true;
+        }
+        else if (c == '\\' && i + 1 < line.size()
+                 && (line.at(i + 1).isSpace() || line.at(i + 1) == '"' || line.at(i + 1) == '\''))
+        {
+            word += line.at(++i);
+            inWord = true;
+        }
+        else
+        {
+            word += c;
+            inWord = true;
+        }
+    }
+    if (!quoteChar.isNull() && error)
+    {
+        *error = QObject::tr("Unterminated %1 quote").arg(quoteChar);
+    }
+    if (inWord)
+    {
+        words << word;
+    }
+    return words;
+}
+
+/****************************************************************
+ * @brief Quotes a word if it is empty or contains spaces/quotes.
+ ***************************************************************/
+QString CommandBuilder::quote(const QString &word)
+{
+    bool plain = !word.isEmpty();
+    for (int i = 0; i < word.size() && plain; ++i)
+    {
+        const QChar c = word.at(i);
+        plain = !c.isSpace() && c != '"' && c != '\'';
+    }
+    if (plain)
+    {
+        return word;
+    }
+    QString quoted = word;
+    quoted.replace("\"", "\\\"");
+    return QString("\"%1\"").arg(quoted);
+}
+
+/************** End of CommandBuilder.cpp ***********************/
@@ -0,0 +1,97 @@
+/****************************************************************
+ * @file CommandBuilder.h
+ * @brief Declares the CommandBuilder class and project definitions.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines ProjectDef and CommandBuilder. A builder turns
+ * a project (script, input switches, extra arguments) plus one set
+ * of input values into a program and argument list, without any
+ * widgets, so batch lines can be turned into commands on demand.
+ *
+ * splitArguments() understands shell-style quoting: "double" and
+ * 'single' quoted words, \" inside double quotes, and a backslash
+ * before a space or quote. Other backslashes are kept, so Windows
+ * paths need no escaping.
+ ***************************************************************/
+#ifndef COMMANDBUILDER_H
+#define COMMANDBUILDER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/****************************************************************
+ * @struct InputDef
+ * @brief Defines a single input argument for a command.
+ ***************************************************************/
+struct InputDef
+{
+    QString label;
+    QString switchName;
+};
+
+/****************************************************************
+ * @struct ProjectDef
+ * @brief Defines a project with script, inputs, and extra args.
+ ***************************************************************/
+struct ProjectDef
+{
+    QString name;
+    QString scriptPath;
+    QVector<InputDef> inputs;
+    QString extraArgs;
+};
+
+/****************************************************************
+ * @class CommandBuilder
+ * @brief Builds the command line of a project from input values.
+ ***************************************************************/
+class CommandBuilder
+{
+public:
+    /****************************************************************
+     * @param project Script and input switches.
+     * @param python Interpreter that runs the script.
+     * @param extraArgs Appended after the inputs (shell quoting).
+     ***************************************************************/
+    CommandBuilder(const ProjectDef &project, const QString &python, const QString &extraArgs);
+
+    /****************************************************************
+     * @brief Program and arguments for one set of input values.
+     * @param values One value per project input; empty values and
+     *        missing trailing values leave that switch out.
+     * @param program Receives the interpreter.
+     * @param arguments Receives script, switches and extra args.
+     ***************************************************************/
+    void build(const QStringList &values, QString *program, QStringList *arguments) const;
+
+    /****************************************************************
+     * @brief The same command as one displayable, quoted line.
+     ***************************************************************/
+    QString commandLine(const QStringList &values) const;
+
+    /****************************************************************
+     * @brief Splits a line into words with shell-style quoting.
+     * @param line Text to split.
+     * @param error Receives a message for an unterminated quote
+     *        (optional); the partial word is still returned.
+     ***************************************************************/
+    static QStringList splitArguments(const QString &line, QString *error = nullptr);
+
+    /****************************************************************
+     * @brief Quotes a word if it is empty or contains spaces/quotes.
+     ***************************************************************/
+    static QString quote(const QString &word);
+
+private:
+    ProjectDef m_project;
+    QString m_python;
+    QStringList m_extraArgs;
+};
+
+#endif // COMMANDBUILDER_H
+/************** End of CommandBuilder.h *************************/
@@ -19,14 +19,46 @@
 #include <QFormLayout>
 #include <QDialogButtonBox>
 #include <QScrollArea>
-#include <QTextStream>
 
 /****************************************************************
  * @brief Constructor: Builds the UI and loads initial state.
  ***************************************************************/
 CommandsTab::CommandsTab(TerminalEngine* engine, QWidget* parent)
-    : QWidget(parent), engine(engine)
+    : QWidget(parent), engine(engine), batchScheduler(new BatchScheduler(this))
 {
+    connect(batchScheduler, &BatchScheduler::jobStarted, this,
+            [this](int index, const QString &label, int gpu)
+            {
+                outputSink->append(gpu >= 0 ? QString("[%1] Running on GPU %2: %3").arg(index + 1).arg(gpu).arg(label)
+                                            : QString("[%1] Running: %2").arg(index + 1).arg(label),
+                                   OutputSink::Style::Command);
+            });
+    connect(batchScheduler, &BatchScheduler::jobOutput, this, [this](int index, const QString &lines)
+            {
+                // Prefix every line so parallel jobs can be told apart
+                const QString prefix = QString("[%1] ").arg(index + 1);
+                outputSink->append(prefix + QString(lines).replace("\n", "\n" + prefix));
+            });
+    connect(batchScheduler, &BatchScheduler::jobFinished, this,
+            [this](int index, BatchScheduler::JobState state, int exitCode)
+            {
+                outputSink->append(QString("[%1] Finished: %2, exit code %3")
+                                       .arg(index + 1)
+                                       .arg(BatchScheduler::stateName(state))
+                                       .arg(exitCode),
+                                   state == BatchScheduler::JobState::Succeeded ? OutputSink::Style::Normal
+                                                                                : OutputSink::Style::Error);
+            });
+    connect(batchScheduler, &BatchScheduler::progressChanged, this, [this](int done, int total)
+            {
+                showStatusMessage(total < 0 ? QString("Batch: %1 done, %2 running")
+                                                  .arg(done).arg(batchScheduler->runningCount())
+                                            : QString("Batch: %1 of %2 done, %3 running")
+                                                  .arg(done).arg(total).arg(batchScheduler->runningCount()),
+                                  0);
+            });
+    connect(batchScheduler, &BatchScheduler::finished, this, &CommandsTab::onBatchFinished);
+
     buildUI();
     loadProjects("projects.json");
 }
@@ -92,6 +124,7 @@ void CommandsTab::buildUI()
     // Output console
     outputConsole = new QTextEdit;
     outputConsole->setReadOnly(true);
+    outputSink = new OutputSink(outputConsole);
     mainLayout->addWidget(new QLabel("Command Output:"));
     mainLayout->addWidget(outputConsole);
 
@@ -223,35 +256,31 @@ void CommandsTab::rebuildInputs(const ProjectDef &proj)
     }
 }
 
+/****************************************************************
+ * @brief Builds the command line shown in the preview.
+ ***************************************************************/
 QString CommandsTab::buildCommand() const
 {
     int index = projectDropdown->currentIndex();
     if (index < 0 || index >= projects.size())
         return QString();
 
-    const ProjectDef& proj = projects.at(index);
-
     // Use engine’s resolved interpreter
-    QString pythonExe = engine->pythonCommand();
-    QStringList args;
-
-    args << QString("\"%1\"").arg(proj.scriptPath);
+    CommandBuilder builder(projects.at(index), engine->pythonCommand(), extraArgsEdit->text());
+    return builder.commandLine(inputValues());
+}
 
+/****************************************************************
+ * @brief Current text of every input field.
+ ***************************************************************/
+QStringList CommandsTab::inputValues() const
+{
+    QStringList values;
     for (int i = 0; i < inputEdits.size(); ++i)
     {
-        QString val = inputEdits.at(i)->text().trimmed();
-        if (!val.isEmpty())
-        {
-            args << proj.inputs.at(i).switchName << QString("\"%1\"").arg(val);
-        }
-    }
-
-    if (!extraArgsEdit->text().isEmpty())
-    {
-        args << extraArgsEdit->text();
+        values << inputEdits.at(i)->text().trimmed();
     }
-
-    return QString("%1 %2").arg(pythonExe, args.join(' '));
+    return values;
 }
 
 /****************************************************************
@@ -308,125 +337,141 @@ void CommandsTab::onRunCommand()
         return;
     }
 
-    QString cmd = buildCommand();
-    outputConsole->append(QString("Running: %1").arg(cmd));
-    executeCommand(cmd);
+    CommandBuilder builder(projects.at(projectDropdown->currentIndex()), engine->pythonCommand(),
+                           extraArgsEdit->text());
+    QString program;
+    QStringList arguments;
+    builder.build(inputValues(), &program, &arguments);
+    outputSink->append(QString("Running: %1").arg(builder.commandLine(inputValues())), OutputSink::Style::Command);
+    executeCommand(program, arguments);
 }
 
 /****************************************************************
- * @brief Runs batch commands sequentially from a file.
+ * @brief Runs the commands of a batch file, several at a time.
  ***************************************************************/
 void CommandsTab::onRunBatch()
 {
-    QString batchFile = batchFileEdit->text();
-    QFile file(batchFile);
-    if (!file.open(QIODevice::ReadOnly))
+    if (batchScheduler->isRunning())
     {
-        QMessageBox::critical(this, "Error", "Cannot open batch file.");
+        outputSink->append("Stopping batch...", OutputSink::Style::Error);
+        batchScheduler->cancel();
         return;
     }
 
-    QTextStream in(&file);
-    batchQueue.clear();
-
     int index = projectDropdown->currentIndex();
     if (index < 0 || index >= projects.size())
     {
         QMessageBox::critical(this, "Error", "No project selected.");
         return;
     }
-    const ProjectDef &proj = projects.at(index);
+    if (!batchReader.open(batchFileEdit->text()))
+    {
+        QMessageBox::critical(this, "Error", "Cannot open batch file.");
+        return;
+    }
+
+    // Use venv Python path from engine in place of plain "python"
+    QString python = engine->pythonCommand();
+    if (python.toLower() == "python")
+    {
+        python = engine->venvPythonPath(engine->venvPath);
+    }
 
-    while (!in.atEnd())
+    // Lines are read and turned into commands only as slots free up
+    const CommandBuilder builder(projects.at(index), python, extraArgsEdit->text());
+    batchSkipped = 0;
+    batchScheduler->clear();
+    batchScheduler->setSource([this, builder](BatchScheduler::Command *command)
+                              {
+                                  return nextBatchCommand(builder, command);
+                              });
+
+    outputSink->append(QString("Running batch %1, %2 at a time%3")
+                           .arg(batchFileEdit->text())
+                           .arg(batchGpuCount > 0 ? qMin(batchScheduler->maxParallel(), batchGpuCount)
+                                                  : batchScheduler->maxParallel())
+                           .arg(batchGpuCount > 0 ? QString(" (one per GPU)") : QString()));
+    // Set first: an empty file finishes inside start()
+    runBatchButton->setText("Stop Batch");
+    if (!batchScheduler->start())
     {
-        QString line = in.readLine().trimmed();
-        if (line.isEmpty()) continue;
+        batchReader.close();
+        runBatchButton->setText("Run Batch");
+    }
+}
 
-        // Fill inputs from line
-        QStringList batchInputs = line.split(' ', Qt::SkipEmptyParts);
-        for (int i = 0; i < inputEdits.size(); ++i)
+/****************************************************************
+ * @brief Reads batch lines until one makes a command.
+ * @return false at the end of the batch file.
+ ***************************************************************/
+bool CommandsTab::nextBatchCommand(const CommandBuilder &builder, BatchScheduler::Command *command)
+{
+    QStringList values;
+    QString error;
+    while (batchReader.next(&values, &error))
+    {
+        if (!error.isEmpty())
         {
-            if (i < batchInputs.size())
-                inputEdits.at(i)->setText(batchInputs.at(i));
-            else
-                inputEdits.at(i)->clear();
+            ++batchSkipped;
+            outputSink->append(QString("Batch line %1 skipped: %2").arg(batchReader.lineNumber()).arg(error),
+                               OutputSink::Style::Error);
+            continue;
         }
-
-        QString cmd = buildCommand();
-        batchQueue.append(cmd);
+        builder.build(values, &command->program, &command->arguments);
+        command->label = builder.commandLine(values);
+        return true;
     }
+    batchReader.close();
+    return false;
+}
 
-    outputConsole->append(QString("Queued %1 batch commands").arg(batchQueue.size()));
-    runNextBatchCommand();
+/****************************************************************
+ * @brief Prints the per-job summary once the batch is done.
+ ***************************************************************/
+void CommandsTab::onBatchFinished(int succeeded, int failed)
+{
+    batchReader.close();
+    outputSink->append("Batch execution finished.");
+    if (batchSkipped > 0)
+    {
+        outputSink->append(QString("%1 malformed batch lines were skipped").arg(batchSkipped), OutputSink::Style::Error);
+    }
+    outputSink->append(batchScheduler->summary(), failed > 0 ? OutputSink::Style::Error : OutputSink::Style::Normal);
+    runBatchButton->setText("Run Batch");
+    showStatusMessage(QString("Batch finished: %1 succeeded, %2 failed").arg(succeeded).arg(failed), 5000);
 }
 
 /****************************************************************
- * @brief Runs the next command in the batch queue.
+ * @brief Sets concurrency, timeout and GPU slots for batches.
  ***************************************************************/
-void CommandsTab::runNextBatchCommand()
+void CommandsTab::setBatchOptions(int parallel, int timeoutMs, int gpuCount)
 {
-    if (batchQueue.isEmpty())
+    batchScheduler->setMaxParallel(parallel);
+    batchScheduler->setTimeout(timeoutMs);
+    if (batchScheduler->isRunning())
     {
-        outputConsole->append("Batch execution finished.");
         return;
     }
-
-    QString cmd = batchQueue.takeFirst();
-    outputConsole->append(QString("Batch Running: %1").arg(cmd));
-
-    // Use venv Python path from engine
-    QString venvPython = engine->venvPythonPath(engine->venvPath);
-    QStringList parts = QProcess::splitCommand(cmd);
-
-    // Replace "python" with venv python
-    if (!parts.isEmpty() && parts.first().toLower() == "python")
+    batchGpuCount = qMax(0, gpuCount);
+    QList<int> devices;
+    for (int i = 0; i < batchGpuCount; ++i)
     {
-        parts[0] = venvPython;
+        devices << i;
     }
-
-    QString program = parts.takeFirst();
-
-    batchProc = new QProcess(this);
-    batchProc->setProcessChannelMode(QProcess::MergedChannels);
-
-    connect(batchProc, &QProcess::readyReadStandardOutput, [this]()
-            {
-                outputConsole->append(batchProc->readAllStandardOutput());
-            });
-    connect(batchProc, &QProcess::readyReadStandardError, [this]()
-            {
-                outputConsole->append(batchProc->readAllStandardError());
-            });
-    connect(batchProc, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-            [this](int exitCode, QProcess::ExitStatus status)
-            {
-                outputConsole->append(QString("Process finished with code %1, status %2")
-                                          .arg(exitCode).arg(status));
-                batchProc->deleteLater();
-                batchProc = nullptr;
-                runNextBatchCommand(); // run next queued command
-            });
-
-    batchProc->start(program, parts);
+    batchScheduler->setGpuSlots(devices);
 }
 
 /****************************************************************
  * @brief Executes a command using QProcess with program + args.
  ***************************************************************/
-/****************************************************************
- * @brief Executes a command using QProcess with program + args.
- ***************************************************************/
-void CommandsTab::executeCommand(const QString &cmd)
+void CommandsTab::executeCommand(const QString &program, const QStringList &arguments)
 {
-    // Split program and args safely
-    QStringList parts = QProcess::splitCommand(cmd);
-    if (parts.isEmpty())
+    if (program.isEmpty())
     {
         showStatusMessage("Invalid command string", 5000);
         return;
     }
 
-    QString program = parts.takeFirst();
     QProcess *proc = new QProcess(this);
 
     // Merge stdout + stderr into one channel
@@ -435,13 +480,13 @@ void CommandsTab::executeCommand(const QString &cmd)
     // Only connect to standard output in merged mode
     connect(proc, &QProcess::readyReadStandardOutput, [this, proc]()
             {
-                outputConsole->append(proc->readAllStandardOutput());
+                outputSink->append(QString::fromUtf8(proc->readAllStandardOutput()));
             });
 
     connect(proc, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
             [this, proc](int exitCode, QProcess::ExitStatus status)
             {
-                outputConsole->append(
+                outputSink->append(
                     QString("Process finished with code %1, status %2")
                         .arg(exitCode)
                         .arg(status)
@@ -449,7 +494,7 @@ void CommandsTab::executeCommand(const QString &cmd)
                 proc->deleteLater();
             });
 
-    proc->start(program, parts);
+    proc->start(program, arguments);
 }
 
 void CommandsTab::showStatusMessage(const QString& msg, int timeoutMs)
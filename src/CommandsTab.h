@@ -38,28 +38,10 @@
 #include <QSpinBox>
 #include <QFileDialog>
 #include "TerminalEngine.h"
-
-/****************************************************************
- * @struct InputDef
- * @brief Defines a single input argument for a command.
- ***************************************************************/
-struct InputDef
-{
-    QString label;
-    QString switchName;
-};
-
-/****************************************************************
- * @struct ProjectDef
- * @brief Defines a project with script, inputs, and extra args.
- ***************************************************************/
-struct ProjectDef
-{
-    QString name;
-    QString scriptPath;
-    QVector<InputDef> inputs;
-    QString extraArgs;
-};
+#include "OutputSink.h"
+#include "BatchScheduler.h"
+#include "BatchFileReader.h"
+#include "CommandBuilder.h"
 
 /****************************************************************
  * @class CommandsTab
@@ -85,6 +67,15 @@ public:
      ************************************************************/
     void showStatusMessage(const QString& msg, int timeoutMs = 5000);
 
+    /************************************************************
+     * @brief Sets how batch files are run.
+     * @param parallel  Jobs run at once
+     * @param timeoutMs Per-job limit in ms, 0 for none
+     * @param gpuCount  GPUs to spread jobs over (one job per GPU,
+     *                  CUDA_VISIBLE_DEVICES), 0 to ignore GPUs
+     ************************************************************/
+    void setBatchOptions(int parallel, int timeoutMs, int gpuCount);
+
 signals:
     void requestStatusMessage(const QString& msg, int timeoutMs);
 
@@ -103,13 +94,15 @@ private:
     void buildUI();
     void rebuildInputs(const ProjectDef &proj);
     QString buildCommand() const;
+    QStringList inputValues() const;
     bool validateFiles(QString &errorMsg) const;
-    void executeCommand(const QString &cmd);
+    void executeCommand(const QString &program, const QStringList &arguments);
+    bool nextBatchCommand(const CommandBuilder &builder, BatchScheduler::Command *command);
 
     // Project editor dialog helpers
     bool showProjectDialog(ProjectDef &proj, bool isEdit = false);
     void refreshProjectDropdown();
-    void runNextBatchCommand();   ///< helper to run next queued command
+    void onBatchFinished(int succeeded, int failed);
     // Variables:
     QVector<ProjectDef> projects;
     QComboBox *projectDropdown;
@@ -118,6 +111,7 @@ private:
     QLineEdit *extraArgsEdit;
     QLineEdit *commandPreview;
     QTextEdit *outputConsole;
+    OutputSink *outputSink;
     QLineEdit *batchFileEdit;
     QPushButton *runButton;
     QPushButton *runBatchButton;
@@ -127,8 +121,10 @@ private:
     QToolButton *clearButton;
     TerminalEngine* engine;
 
-    QStringList batchQueue;       ///< queued batch commands
-    QProcess* batchProc = nullptr; ///< active batch process
+    BatchScheduler *batchScheduler; ///< runs batch lines in parallel
+    BatchFileReader batchReader;    ///< feeds batchScheduler line by line
+    int batchSkipped = 0;           ///< malformed batch lines
+    int batchGpuCount = 0;
 
 };
 
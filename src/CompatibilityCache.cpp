@@ -0,0 +1,308 @@
+/****************************************************************
+ * @file CompatibilityCache.cpp
+ * @brief Implements the CompatibilityCache class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of CompatibilityCache.
+ * Layout of the cache directory:
+ *   compat_<hash>.json   results and conflicts of one environment
+ *   locks/<hash>.txt     compiled requirements of passing sets
+ ***************************************************************/
+#include "CompatibilityCache.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const int kCacheFormat = 1;
+static const int kSaveDelayMs = 2000;
+
+/****************************************************************
+ * @brief Short stable hash used for file names.
+ ***************************************************************/
+static QString shortHash(const QString &text)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(text.toUtf8(), QCryptographicHash::Sha1)
+                                   .toHex().left(16));
+}
+
+/****************************************************************
+ * @brief Constructor: Initializes an empty, unopened cache.
+ ***************************************************************/
+CompatibilityCache::CompatibilityCache(QObject *parent) : QObject(parent)
+{
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(kSaveDelayMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, [this]() { save(); });
+}
+
+/****************************************************************
+ * @brief Destructor: Flushes pending changes.
+ ***************************************************************/
+CompatibilityCache::~CompatibilityCache()
+{
+    save();
+}
+
+/****************************************************************
+ * @brief Builds the key that separates incompatible environments.
+ ***************************************************************/
+QString CompatibilityCache::environmentKey(const QString &pythonVersion, const QString &os,
+                                           const QString &release, bool useCpu, bool cuda)
+{
+    return QString("python=%1|os=%2|release=%3|cpu=%4|cuda=%5")
+        .arg(pythonVersion.trimmed(), os.trimmed(), release.trimmed())
+        .arg(useCpu ? 1 : 0)
+        .arg(cuda ? 1 : 0);
+}
+
+/****************************************************************
+ * @brief Loads (or starts) the cache file for an environment.
+ ***************************************************************/
+bool CompatibilityCache::open(const QString &dir, const QString &environment)
+{
+    if (dir == m_dir && environment == m_environment)
+    {
+        return true;
+    }
+    save();
+    m_dir = dir;
+    m_environment = environment;
+    m_results.clear();
+    m_conflicts.clear();
+    m_conflictKeys.clear();
+    QDir().mkpath(locksDir());
+
+    QFile file(filePath());
+    if (!file.exists())
+    {
+        return true;
+    }
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Cannot read compatibility cache" << file.fileName();
+        return false;
+    }
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    const QJsonObject root = doc.object();
+    if (error.error != QJsonParseError::NoError
+        || root.value("format").toInt() != kCacheFormat
+        || root.value("environment").toString() != m_environment)
+    {
+        qWarning() << "Ignoring unreadable compatibility cache" << file.fileName();
+        return false;
+    }
+
+    const QJsonObject results = root.value("results").toObject();
+    for (auto it = results.constBegin(); it != results.constEnd(); ++it)
+    {
+        const QJsonObject value = it.value().toObject();
+        Entry entry;
+        entry.passed = value.value("passed").toBool();
+        entry.lockFile = value.value("lock").toString();
+        m_results.insert(it.key(), entry);
+    }
+    const QJsonArray conflicts = root.value("conflicts").toArray();
+    for (int i = 0; i < conflicts.size(); ++i)
+    {
+        QStringList pins;
+        const QJsonArray array = conflicts.at(i).toArray();
+        for (int j = 0; j < array.size(); ++j)
+        {
+            pins << array.at(j).toString();
+        }
+        if (!pins.isEmpty() && !m_conflictKeys.contains(pins.join(';')))
+        {
+            m_conflictKeys.insert(pins.join(';'));
+            m_conflicts.append(pins);
+        }
+    }
+    DEBUG_MSG() << "Compatibility cache" << m_environment << m_results.size() << "results"
+                << m_conflicts.size() << "conflicts";
+    return true;
+}
+
+QString CompatibilityCache::environment() const
+{
+    return m_environment;
+}
+
+/****************************************************************
+ * @brief Looks up a previously tested pin set.
+ ***************************************************************/
+bool CompatibilityCache::lookup(const QString &setKey, bool *passed, QString *outputPath) const
+{
+    const auto it = m_results.constFind(setKey);
+    if (it == m_results.constEnd())
+    {
+        return false;
+    }
+    if (passed)
+    {
+        *passed = it.value().passed;
+    }
+    if (outputPath)
+    {
+        *outputPath = it.value().lockFile.isEmpty()
+                          ? QString()
+                          : QDir(locksDir()).filePath(it.value().lockFile);
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Records a pip-compile outcome.
+ ***************************************************************/
+void CompatibilityCache::record(const QString &setKey, bool passed, const QString &outputPath)
+{
+    if (m_environment.isEmpty())
+    {
+        return;
+    }
+    Entry entry;
+    entry.passed = passed;
+    if (passed && QFileInfo::exists(outputPath))
+    {
+        entry.lockFile = shortHash(m_environment + '\n' + setKey) + ".txt";
+        const QString target = QDir(locksDir()).filePath(entry.lockFile);
+        QFile::remove(target);
+        if (!QFile::copy(outputPath, target))
+        {
+            entry.lockFile.clear();
+        }
+    }
+    m_results.insert(setKey, entry);
+    markDirty();
+}
+
+/****************************************************************
+ * @brief Records a minimal failing set as requirement lines.
+ ***************************************************************/
+void CompatibilityCache::recordConflict(const QStringList &pins)
+{
+    QStringList sorted = pins;
+    sorted.sort();
+    const QString key = sorted.join(';');
+    if (m_environment.isEmpty() || sorted.isEmpty() || m_conflictKeys.contains(key))
+    {
+        return;
+    }
+    m_conflictKeys.insert(key);
+    m_conflicts.append(sorted);
+    markDirty();
+}
+
+const QList<QStringList> &CompatibilityCache::conflicts() const
+{
+    return m_conflicts;
+}
+
+int CompatibilityCache::resultCount() const
+{
+    return m_results.size();
+}
+
+/****************************************************************
+ * @brief Forgets everything recorded for this environment.
+ ***************************************************************/
+void CompatibilityCache::clear()
+{
+    for (auto it = m_results.constBegin(); it != m_results.constEnd(); ++it)
+    {
+        if (!it.value().lockFile.isEmpty())
+        {
+            QFile::remove(QDir(locksDir()).filePath(it.value().lockFile));
+        }
+    }
+    m_results.clear();
+    m_conflicts.clear();
+    m_conflictKeys.clear();
+    markDirty();
+}
+
+/****************************************************************
+ * @brief Writes pending changes atomically.
+ ***************************************************************/
+bool CompatibilityCache::save()
+{
+    m_saveTimer.stop();
+    if (!m_dirty || m_environment.isEmpty())
+    {
+        return true;
+    }
+
+    QJsonObject results;
+    for (auto it = m_results.constBegin(); it != m_results.constEnd(); ++it)
+    {
+        QJsonObject value;
+        value.insert("passed", it.value().passed);
+        if (!it.value().lockFile.isEmpty())
+        {
+            value.insert("lock", it.value().lockFile);
+        }
+        results.insert(it.key(), value);
+    }
+    QJsonArray conflicts;
+    for (int i = 0; i < m_conflicts.size(); ++i)
+    {
+        conflicts.append(QJsonArray::fromStringList(m_conflicts.at(i)));
+    }
+    QJsonObject root;
+    root.insert("format", kCacheFormat);
+    root.insert("environment", m_environment);
+    root.insert("results", results);
+    root.insert("conflicts", conflicts);
+
+    QDir().mkpath(m_dir);
+    QSaveFile file(filePath());
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "Cannot write compatibility cache" << file.fileName();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit())
+    {
+        qWarning() << "Cannot commit compatibility cache" << file.fileName();
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+QString CompatibilityCache::filePath() const
+{
+    return QDir(m_dir).filePath(QString("compat_%1.json").arg(shortHash(m_environment)));
+}
+
+QString CompatibilityCache::locksDir() const
+{
+    return QDir(m_dir).filePath("locks");
+}
+
+/****************************************************************
+ * @brief Schedules a save so bursts of results cost one write.
+ ***************************************************************/
+void CompatibilityCache::markDirty()
+{
+    m_dirty = true;
+    if (!m_saveTimer.isActive())
+    {
+        m_saveTimer.start();
+    }
+}
+
+/************** End of CompatibilityCache.cpp *******************/
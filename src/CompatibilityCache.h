@@ -0,0 +1,123 @@
+/****************************************************************
+ * @file CompatibilityCache.h
+ * @brief Declares the CompatibilityCache class for resolver results.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the CompatibilityCache class, an on-disk
+ * record of every pin set pip-compile has accepted or rejected
+ * and of every minimal failing subset the resolver learned.
+ * Results only hold for the environment they were produced in,
+ * so each environment key (Python version, OS, release, CPU and
+ * CUDA flags) gets its own JSON file in the cache directory.
+ ***************************************************************/
+#ifndef COMPATIBILITYCACHE_H
+#define COMPATIBILITYCACHE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+
+/****************************************************************
+ * @class CompatibilityCache
+ * @brief Persistent pass/fail memo keyed by environment.
+ ***************************************************************/
+class CompatibilityCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CompatibilityCache(QObject *parent = nullptr);
+    ~CompatibilityCache();
+
+    /****************************************************************
+     * @brief Builds the key that separates incompatible environments.
+     * @param pythonVersion Interpreter version, e.g. "3.10".
+     * @param os OS name from detectSystem().
+     * @param release OS release from detectSystem().
+     * @param useCpu CPU-only flag.
+     * @param cuda CUDA flag.
+     * @return Stable, human-readable key.
+     ***************************************************************/
+    static QString environmentKey(const QString &pythonVersion, const QString &os,
+                                  const QString &release, bool useCpu, bool cuda);
+
+    /****************************************************************
+     * @brief Loads (or starts) the cache file for an environment.
+     *        Pending changes of a previous environment are saved.
+     * @param dir Cache directory, created on demand.
+     * @param environment Key from environmentKey().
+     * @return true if an existing cache was read or none existed.
+     ***************************************************************/
+    bool open(const QString &dir, const QString &environment);
+
+    QString environment() const;
+
+    /****************************************************************
+     * @brief Looks up a previously tested pin set.
+     * @param setKey Sorted pins joined with ';'.
+     * @param passed Receives the recorded outcome.
+     * @param outputPath Receives the stored compiled file (passes only).
+     * @return true if the set was tested in this environment before.
+     ***************************************************************/
+    bool lookup(const QString &setKey, bool *passed, QString *outputPath = nullptr) const;
+
+    /****************************************************************
+     * @brief Records a pip-compile outcome. For passes the compiled
+     *        file is copied into the cache so it outlives the run.
+     ***************************************************************/
+    void record(const QString &setKey, bool passed, const QString &outputPath = QString());
+
+    /****************************************************************
+     * @brief Records a minimal failing set as requirement lines.
+     ***************************************************************/
+    void recordConflict(const QStringList &pins);
+
+    /****************************************************************
+     * @brief Minimal failing sets known for this environment.
+     ***************************************************************/
+    const QList<QStringList> &conflicts() const;
+
+    int resultCount() const;
+
+    /****************************************************************
+     * @brief Forgets everything recorded for this environment.
+     ***************************************************************/
+    void clear();
+
+    /****************************************************************
+     * @brief Writes pending changes now (also done on a short delay
+     *        after each change and on destruction).
+     * @return true on success or if nothing was pending.
+     ***************************************************************/
+    bool save();
+
+private:
+    struct Entry
+    {
+        bool passed = false;
+        QString lockFile; ///< relative to locks/, passes only
+    };
+
+    QString filePath() const;
+    QString locksDir() const;
+    void markDirty();
+
+    QString m_dir;
+    QString m_environment;
+    QHash<QString, Entry> m_results;
+    QList<QStringList> m_conflicts;
+    QSet<QString> m_conflictKeys;
+    bool m_dirty = false;
+    QTimer m_saveTimer;
+};
+
+#endif // COMPATIBILITYCACHE_H
+/************** End of CompatibilityCache.h *********************/
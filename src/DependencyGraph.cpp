@@ -0,0 +1,361 @@
+/****************************************************************
+ * @file DependencyGraph.cpp
+ * @brief Implements the DependencyGraph class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of DependencyGraph. The
+ * candidate versions of every column are packed once; each
+ * requires_dist entry is compiled to a SpecifierSet and filters a
+ * whole column in one pass. CandidateFetcher::satisfies() is only
+ * used for what PackedVersion cannot hold.
+ ***************************************************************/
+#include "DependencyGraph.h"
+#include "CandidateFetcher.h"
+#include "PackedVersion.h"
+#include "Requirement.h"
+#include <QRegularExpression>
+#include <algorithm>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+/****************************************************************
+ * @brief Final release, optionally with a trailing ".*".
+ ***************************************************************/
+static bool isPlainVersion(const QString &version, bool wildcard)
+{
+    static const QRegularExpression plain("^\\d+(\\.\\d+)*$");
+    static const QRegularExpression starred("^\\d+(\\.\\d+)*(\\.\\*)?$");
+    return (wildcard ? starred : plain).match(version).hasMatch();
+}
+
+/****************************************************************
+ * @brief A requires_dist entry that holds in every environment
+ *        and compares final releases only.
+ ***************************************************************/
+static bool isCertain(const Requirement &requirement)
+{
+    if (requirement.kind != Requirement::Kind::Package || !requirement.url.isEmpty()
+        || !requirement.marker.isEmpty() || requirement.clauses.isEmpty())
+    {
+        return false;
+    }
+    for (int i = 0; i < requirement.clauses.size(); ++i)
+    {
+        if (requirement.clauses.at(i).op == Requirement::Op::Arbitrary
+            || !isPlainVersion(requirement.version(i), true))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Constructor: Interns the projects and lays out the nodes.
+ ***************************************************************/
+DependencyGraph::DependencyGraph(const QVector<PackageCandidates> &packages)
+{
+    m_versions.reserve(packages.size());
+    m_packed.reserve(packages.size());
+    m_offsets.reserve(packages.size());
+    int nodes = 0;
+    for (int i = 0; i < packages.size(); ++i)
+    {
+        const PackageCandidates &package = packages.at(i);
+        m_versions.append(package.versions);
+        m_offsets.append(nodes);
+        nodes += int(package.versions.size());
+
+        const int count = int(package.versions.size());
+        QVector<PackedVersion> packed(count);
+        QBitArray finals(count);
+        QBitArray fits(count);
+        for (int v = 0; v < count; ++v)
+        {
+            finals.setBit(v, isPlainVersion(package.versions.at(v), false));
+            fits.setBit(v, finals.testBit(v) && PackedVersion::pack(package.versions.at(v), &packed[v]));
+        }
+        m_packed.append(packed);
+        m_final.append(finals);
+        m_fits.append(fits);
+
+        const bool unpinned = package.versions.size() == 1 && package.versions.first().isEmpty();
+        const QString project = unpinned ? QString() : Requirement::parse(package.name).project;
+        if (project.isEmpty())
+        {
+            continue;
+        }
+        auto it = m_projectIds.constFind(project);
+        if (it == m_projectIds.constEnd())
+        {
+            it = m_projectIds.insert(Requirement::intern(project), int(m_projectColumns.size()));
+            m_projectColumns.append(QVector<int>());
+        }
+        m_projectColumns[it.value()].append(i);
+    }
+    m_edges.resize(nodes);
+    m_viable.fill(true, nodes);
+}
+
+int DependencyGraph::columnCount() const
+{
+    return int(m_versions.size());
+}
+
+int DependencyGraph::edgeCount() const
+{
+    int count = 0;
+    for (int i = 0; i < m_edges.size(); ++i)
+    {
+        count += int(m_edges.at(i).size());
+    }
+    return count;
+}
+
+int DependencyGraph::node(int column, int version) const
+{
+    return m_offsets.at(column) + version;
+}
+
+int DependencyGraph::projectId(const QString &project) const
+{
+    return m_projectIds.value(project, -1);
+}
+
+/****************************************************************
+ * @brief Adds the requires_dist entries of one candidate. Several
+ *        entries for the same project narrow one edge.
+ ***************************************************************/
+void DependencyGraph::addRequiresDist(int column, int version, const QStringList &requiresDist)
+{
+    if (column < 0 || column >= columnCount() || version < 0 || version >= m_versions.at(column).size())
+    {
+        return;
+    }
+    QVector<Edge> &edges = m_edges[node(column, version)];
+    for (int i = 0; i < requiresDist.size(); ++i)
+    {
+        const Requirement requirement = Requirement::parse(requiresDist.at(i));
+        const int id = projectId(requirement.project);
+        if (id < 0 || !isCertain(requirement))
+        {
+            continue;
+        }
+        const SpecifierSet specifiers = SpecifierSet::compile(requirement);
+        const QVector<int> &columns = m_projectColumns.at(id);
+        for (int c = 0; c < columns.size(); ++c)
+        {
+            const int target = columns.at(c);
+            if (target == column)
+            {
+                continue;
+            }
+            const QStringList &versions = m_versions.at(target);
+            const int count = int(versions.size());
+            QVector<quint8> matches(count, 0);
+            if (specifiers.isValid())
+            {
+                specifiers.filter(m_packed.at(target).constData(), count, matches.data());
+            }
+            QBitArray allowed(count, true);
+            for (int v = 0; v < count; ++v)
+            {
+                // Only final releases are compared; anything else may match
+                if (!m_final.at(target).testBit(v))
+                {
+                    continue;
+                }
+                allowed.setBit(v, specifiers.isValid() && m_fits.at(target).testBit(v)
+                                      ? matches.at(v) != 0
+                                      : CandidateFetcher::satisfies(requirement, versions.at(v)));
+            }
+            int e = 0;
+            while (e < edges.size() && edges.at(e).column != target)
+            {
+                ++e;
+            }
+            if (e < edges.size())
+            {
+                edges[e].allowed &= allowed;
+            }
+            else if (allowed.count(true) < allowed.size())
+            {
+                edges.append(Edge{target, allowed});
+            }
+        }
+    }
+}
+
+bool DependencyGraph::edgeAllows(int fromNode, int column, int version) const
+{
+    const QVector<Edge> &edges = m_edges.at(fromNode);
+    for (int e = 0; e < edges.size(); ++e)
+    {
+        if (edges.at(e).column == column)
+        {
+            return edges.at(e).allowed.testBit(version);
+        }
+    }
+    return true;
+}
+
+bool DependencyGraph::compatible(int column, int version, int otherColumn, int otherVersion) const
+{
+    return edgeAllows(node(column, version), otherColumn, otherVersion)
+           && edgeAllows(node(otherColumn, otherVersion), column, version);
+}
+
+bool DependencyGraph::isViable(int column, int version) const
+{
+    return m_viable.testBit(node(column, version));
+}
+
+/****************************************************************
+ * @brief Arc consistency over the viable candidates.
+ ***************************************************************/
+int DependencyGraph::eliminate()
+{
+    int removed = 0;
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int c = 0; c < columnCount(); ++c)
+        {
+            int left = 0;
+            for (int v = 0; v < m_versions.at(c).size(); ++v)
+            {
+                left += isViable(c, v) ? 1 : 0;
+            }
+            for (int v = 0; v < m_versions.at(c).size() && left > 1; ++v)
+            {
+                if (!isViable(c, v))
+                {
+                    continue;
+                }
+                bool supported = true;
+                for (int k = 0; k < columnCount() && supported; ++k)
+                {
+                    if (k == c)
+                    {
+                        continue;
+                    }
+                    bool any = false;
+                    for (int w = 0; w < m_versions.at(k).size() && !any; ++w)
+                    {
+                        any = isViable(k, w) && compatible(c, v, k, w);
+                    }
+                    supported = any || m_versions.at(k).isEmpty();
+                }
+                if (!supported)
+                {
+                    DEBUG_MSG() << "eliminated" << c << m_versions.at(c).at(v);
+                    m_viable.clearBit(node(c, v));
+                    --left;
+                    ++removed;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return removed;
+}
+
+/****************************************************************
+ * @brief Most constrained first: the odometer then prunes whole
+ *        subtrees near its root instead of deep leaves.
+ ***************************************************************/
+QVector<int> DependencyGraph::searchOrder() const
+{
+    QVector<int> viable(columnCount(), 0);
+    QVector<int> clashes(columnCount(), 0);
+    for (int c = 0; c < columnCount(); ++c)
+    {
+        for (int v = 0; v < m_versions.at(c).size(); ++v)
+        {
+            if (!isViable(c, v))
+            {
+                continue;
+            }
+            ++viable[c];
+            for (int k = 0; k < columnCount(); ++k)
+            {
+                for (int w = 0; k != c && w < m_versions.at(k).size(); ++w)
+                {
+                    clashes[c] += isViable(k, w) && !compatible(c, v, k, w) ? 1 : 0;
+                }
+            }
+        }
+    }
+
+    QVector<int> order(columnCount());
+    for (int c = 0; c < columnCount(); ++c)
+    {
+        order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        if (viable.at(a) != viable.at(b))
+        {
+            return viable.at(a) < viable.at(b);
+        }
+        return clashes.at(a) > clashes.at(b);
+    });
+    return order;
+}
+
+/****************************************************************
+ * @brief Rewrites the matrix and lists its incompatible pairs.
+ ***************************************************************/
+QVector<ResolverSet> DependencyGraph::apply(QVector<PackageCandidates> *packages) const
+{
+    QVector<ResolverSet> conflicts;
+    if (!packages || packages->size() != columnCount())
+    {
+        return conflicts;
+    }
+    const QVector<int> order = searchOrder();
+    QVector<QVector<int>> kept(columnCount()); ///< new column -> old version indices
+    QVector<PackageCandidates> rewritten;
+    rewritten.reserve(columnCount());
+    for (int i = 0; i < order.size(); ++i)
+    {
+        PackageCandidates package = packages->at(order.at(i));
+        package.versions.clear();
+        for (int v = 0; v < m_versions.at(order.at(i)).size(); ++v)
+        {
+            if (isViable(order.at(i), v))
+            {
+                package.versions << m_versions.at(order.at(i)).at(v);
+                kept[i].append(v);
+            }
+        }
+        rewritten.append(package);
+    }
+
+    for (int a = 0; a < order.size(); ++a)
+    {
+        for (int b = a + 1; b < order.size(); ++b)
+        {
+            for (int x = 0; x < kept.at(a).size(); ++x)
+            {
+                for (int y = 0; y < kept.at(b).size(); ++y)
+                {
+                    if (!compatible(order.at(a), kept.at(a).at(x), order.at(b), kept.at(b).at(y)))
+                    {
+                        conflicts.append(ResolverSet{{a, x}, {b, y}});
+                    }
+                }
+            }
+        }
+    }
+    *packages = rewritten;
+    return conflicts;
+}
+
+/************** End of DependencyGraph.cpp **********************/
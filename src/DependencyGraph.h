@@ -0,0 +1,113 @@
+/****************************************************************
+ * @file DependencyGraph.h
+ * @brief Declares DependencyGraph, the requires_dist edges between
+ *        the candidates of a matrix.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines DependencyGraph. Every candidate (column,
+ * version) is a node; its PyPI requires_dist entries that name
+ * another column become edges holding which of that column's
+ * versions they allow. Project names are interned to ids once, and
+ * each node keeps a flat adjacency array, so the checks below are
+ * index lookups only.
+ *
+ * From the edges alone, before pip-compile runs:
+ *   - eliminate() drops a candidate that no version of some other
+ *     column can accompany (repeated until nothing changes)
+ *   - staticConflicts() lists the remaining pairs that exclude
+ *     each other, for ResolverEngine::setStaticConflicts()
+ *   - searchOrder() puts the most constrained columns first
+ *
+ * Only what is certain is used: entries with an environment marker
+ * (extras, python_version, ...) and specifiers with pre-release or
+ * local versions are ignored, so a pair is never ruled out that
+ * pip could have accepted.
+ ***************************************************************/
+#ifndef DEPENDENCYGRAPH_H
+#define DEPENDENCYGRAPH_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "PackedVersion.h"
+#include "ResolverEngine.h"
+
+/****************************************************************
+ * @class DependencyGraph
+ * @brief Static compatibility of a candidate matrix.
+ ***************************************************************/
+class DependencyGraph
+{
+public:
+    /****************************************************************
+     * @brief Builds the nodes of a matrix, one column per package.
+     *        Unpinned columns (version "") take part in no edge.
+     ***************************************************************/
+    explicit DependencyGraph(const QVector<PackageCandidates> &packages = {});
+
+    int columnCount() const;
+    int edgeCount() const;
+
+    /****************************************************************
+     * @brief Adds the requires_dist entries of one candidate.
+     ***************************************************************/
+    void addRequiresDist(int column, int version, const QStringList &requiresDist);
+
+    /****************************************************************
+     * @brief Can these two candidates be installed together?
+     ***************************************************************/
+    bool compatible(int column, int version, int otherColumn, int otherVersion) const;
+
+    /****************************************************************
+     * @brief Removes candidates that clash with every version of
+     *        another column. A column is never emptied; pip-compile
+     *        gets to report that conflict itself.
+     * @return Number of candidates removed.
+     ***************************************************************/
+    int eliminate();
+    bool isViable(int column, int version) const;
+
+    /****************************************************************
+     * @brief Columns by fewest viable candidates, then by most
+     *        constrained neighbours; ties keep the input order.
+     ***************************************************************/
+    QVector<int> searchOrder() const;
+
+    /****************************************************************
+     * @brief Rewrites a matrix: viable candidates only, columns in
+     *        searchOrder().
+     * @param packages The matrix the graph was built from.
+     * @return The incompatible pairs, in the rewritten indices.
+     ***************************************************************/
+    QVector<ResolverSet> apply(QVector<PackageCandidates> *packages) const;
+
+private:
+    struct Edge
+    {
+        int column = 0;
+        QBitArray allowed;           ///< per version of column
+    };
+
+    int node(int column, int version) const;
+    int projectId(const QString &project) const;
+    bool edgeAllows(int fromNode, int column, int version) const;
+
+    QHash<QString, int> m_projectIds;    ///< normalized name -> id
+    QVector<QVector<int>> m_projectColumns; ///< id -> columns naming it
+    QVector<QStringList> m_versions;     ///< column -> candidate versions
+    QVector<QVector<PackedVersion>> m_packed; ///< column -> packed versions
+    QVector<QBitArray> m_final;          ///< column -> final releases, compared
+    QVector<QBitArray> m_fits;           ///< column -> packed successfully
+    QVector<int> m_offsets;              ///< column -> first node
+    QVector<QVector<Edge>> m_edges;      ///< node -> adjacency array
+    QBitArray m_viable;                  ///< node -> still a candidate
+};
+
+#endif // DEPENDENCYGRAPH_H
+/************** End of DependencyGraph.h ************************/
@@ -0,0 +1,268 @@
+/****************************************************************
+ * @file FailureClassifier.cpp
+ * @brief Implements the FailureClassifier class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of FailureClassifier. The
+ * patterns follow the messages of pip's resolver (pip 20.3 and
+ * later), which pip-tools passes through unchanged.
+ ***************************************************************/
+#include "FailureClassifier.h"
+#include "Requirement.h"
+#include <QRegularExpression>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+void FailureClassifier::reset()
+{
+    m_partial.clear();
+    m_kind = Kind::Unknown;
+    m_decided = false;
+    m_inConflict = false;
+    m_unreachable = false;
+    m_collecting.clear();
+    m_packages.clear();
+    m_reason.clear();
+}
+
+/****************************************************************
+ * @brief Matches the complete lines of a stderr chunk.
+ ***************************************************************/
+bool FailureClassifier::feed(const QByteArray &data)
+{
+    if (m_decided)
+    {
+        return true;
+    }
+    m_partial += data;
+    qsizetype start = 0;
+    qsizetype end = m_partial.indexOf('\n');
+    while (end >= 0 && !m_decided)
+    {
+        matchLine(QString::fromUtf8(m_partial.constData() + start, end - start));
+        start = end + 1;
+        end = m_partial.indexOf('\n', start);
+    }
+    m_partial.remove(0, start);
+    if (m_partial.size() > kMaxLineBytes)
+    {
+        // Progress bars and dumped build logs, not a message
+        m_partial.clear();
+    }
+    return m_decided;
+}
+
+bool FailureClassifier::finish()
+{
+    if (!m_decided && !m_partial.isEmpty())
+    {
+        matchLine(QString::fromUtf8(m_partial));
+    }
+    m_partial.clear();
+    if (!m_decided && m_unreachable)
+    {
+        decide(Kind::Environment, QStringLiteral("package index unreachable"));
+    }
+    return m_decided;
+}
+
+bool FailureClassifier::isDecided() const
+{
+    return m_decided;
+}
+
+FailureClassifier::Kind FailureClassifier::kind() const
+{
+    return m_kind;
+}
+
+const QStringList &FailureClassifier::packages() const
+{
+    return m_packages;
+}
+
+const QString &FailureClassifier::reason() const
+{
+    return m_reason;
+}
+
+QString FailureClassifier::kindName(Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::ResolutionImpossible:
+        return QStringLiteral("ResolutionImpossible");
+    case Kind::NoMatchingDistribution:
+        return QStringLiteral("NoMatchingDistribution");
+    case Kind::BuildFailure:
+        return QStringLiteral("BuildFailure");
+    case Kind::Environment:
+        return QStringLiteral("Environment");
+    case Kind::Unknown:
+        break;
+    }
+    return QStringLiteral("Unknown");
+}
+
+/****************************************************************
+ * @brief Checks one stderr line against the failure signatures.
+ ***************************************************************/
+void FailureClassifier::matchLine(const QString &text)
+{
+    static const QRegularExpression cannotInstall(
+        "^ERROR: Cannot install (.+?) because these package versions have conflicting dependencies");
+    static const QRegularExpression listSeparator(",\\s*(?:and\\s+)?|\\s+and\\s+");
+    static const QRegularExpression userRequested("^The user requested (?:\\(constraint\\) )?(\\S+)");
+    static const QRegularExpression dependsOn("^(\\S+) \\S+ depends on (\\S+)");
+    static const QRegularExpression couldNotFind(
+        "^ERROR: Could not find a version that satisfies the requirement (\\S+)");
+    static const QRegularExpression noMatching("^ERROR: No matching distribution found for (\\S+)");
+    static const QRegularExpression collecting("^Collecting (\\S+)");
+    static const QRegularExpression failedBuild("^(?:ERROR: )?Failed (?:to build|building wheel for) (.+)$");
+    static const QRegularExpression network(
+        "Retrying \\(Retry\\(|Could not fetch URL|NewConnectionError|ConnectionError|Max retries exceeded"
+        "|Temporary failure in name resolution|ReadTimeoutError|SSLError|ProxyError");
+    // Only the interpreter's own launch error: a setup.py that does
+    // "import pip.req" fails the same way inside its build output
+    static const QRegularExpression missingTools("^.+: No module named (?:piptools|pip)$");
+    static const QRegularExpression brokenVenv("No space left on device|Could not install packages due to an OSError");
+
+    const QString line = text.trimmed();
+    if (line.isEmpty())
+    {
+        return;
+    }
+    if (missingTools.match(line).hasMatch() || brokenVenv.match(line).hasMatch())
+    {
+        decide(Kind::Environment, line);
+        return;
+    }
+    // pip or pip-tools itself crashed; build output is indented
+    if (text.startsWith(QLatin1String("Traceback (most recent call last):"))
+        || text.startsWith(QLatin1String("ERROR: Exception:")))
+    {
+        decide(Kind::Environment, line);
+        return;
+    }
+    if (network.match(line).hasMatch())
+    {
+        m_unreachable = true; // pip may still recover
+        return;
+    }
+
+    QRegularExpressionMatch match = cannotInstall.match(line);
+    if (match.hasMatch())
+    {
+        const QStringList requirements = match.captured(1).split(listSeparator, Qt::SkipEmptyParts);
+        for (int i = 0; i < requirements.size(); ++i)
+        {
+            blame(requirements.at(i));
+        }
+        return;
+    }
+    if (line.startsWith(QLatin1String("The conflict is caused by:")))
+    {
+        m_inConflict = true;
+        return;
+    }
+    if (m_inConflict)
+    {
+        match = userRequested.match(line);
+        if (match.hasMatch())
+        {
+            blame(match.capturedView(1));
+            return;
+        }
+        match = dependsOn.match(line);
+        if (match.hasMatch())
+        {
+            blame(match.capturedView(1));
+            blame(match.capturedView(2));
+            return;
+        }
+        m_inConflict = false; // "To fix this you could try to:"
+    }
+    if (line.startsWith(QLatin1String("ERROR:")) && line.contains(QLatin1String("ResolutionImpossible")))
+    {
+        decide(Kind::ResolutionImpossible, line);
+        return;
+    }
+
+    match = couldNotFind.match(line);
+    if (match.hasMatch())
+    {
+        blame(match.capturedView(1));
+        return;
+    }
+    match = noMatching.match(line);
+    if (match.hasMatch())
+    {
+        blame(match.capturedView(1));
+        // After network errors "no match" only means nothing was fetched
+        decide(m_unreachable ? Kind::Environment : Kind::NoMatchingDistribution, line);
+        return;
+    }
+
+    match = collecting.match(line);
+    if (match.hasMatch())
+    {
+        const Requirement requirement = Requirement::parse(match.captured(1));
+        m_collecting = requirement.project;
+        return;
+    }
+    if (line.startsWith(QLatin1String("error: metadata-generation-failed")))
+    {
+        blame(m_collecting);
+        decide(Kind::BuildFailure, line);
+        return;
+    }
+    match = failedBuild.match(line);
+    if (match.hasMatch())
+    {
+        const QStringList names = match.captured(1).split(listSeparator, Qt::SkipEmptyParts);
+        for (int i = 0; i < names.size(); ++i)
+        {
+            blame(names.at(i));
+        }
+        decide(Kind::BuildFailure, line);
+    }
+}
+
+void FailureClassifier::decide(Kind kind, const QString &line)
+{
+    DEBUG_MSG() << "pip-compile failure" << kindName(kind) << m_packages;
+    m_kind = kind;
+    m_reason = line;
+    m_decided = true;
+}
+
+/****************************************************************
+ * @brief Records the project of "name[extras]<specifiers>".
+ ***************************************************************/
+void FailureClassifier::blame(QStringView requirement)
+{
+    if (requirement.startsWith('-'))
+    {
+        return; // "-r requirements.in (line 2)"; the names follow
+    }
+    qsizetype end = 0;
+    while (end < requirement.size()
+           && (requirement.at(end).isLetterOrNumber() || requirement.at(end) == '-'
+               || requirement.at(end) == '_' || requirement.at(end) == '.'))
+    {
+        ++end;
+    }
+    const QString project = Requirement::normalizeName(requirement.left(end));
+    if (!project.isEmpty() && !m_packages.contains(project))
+    {
+        m_packages << Requirement::intern(project);
+    }
+}
+
+/************** End of FailureClassifier.cpp ********************/
@@ -0,0 +1,108 @@
+/****************************************************************
+ * @file FailureClassifier.h
+ * @brief Declares FailureClassifier, a streaming matcher for
+ *        pip-compile failure messages.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines FailureClassifier. PipCompileRunner feeds it
+ * every stderr chunk as it is read; once a line shows that the
+ * compile cannot succeed, the classifier is decided and the runner
+ * kills the process instead of waiting for pip to wind down.
+ *
+ * Recognized:
+ *   - ResolutionImpossible, with the packages named in "Cannot
+ *     install ..." and "The conflict is caused by:"
+ *   - "No matching distribution found for X"
+ *   - build failures: metadata-generation-failed, "Failed to build
+ *     X", "Failed building wheel for X"
+ *   - Environment: the test itself is broken (pip-tools missing
+ *     from the venv, disk full, a traceback of pip or pip-tools
+ *     itself) or the index was unreachable, in which case pip's
+ *     "No matching distribution" is not a verdict
+ * The package names (PEP 503 normalized) are a hint for the
+ * resolver's diagnosis, not a verdict: ResolverEngine compiles
+ * the blamed pins alone before it learns them as a conflict.
+ ***************************************************************/
+#ifndef FAILURECLASSIFIER_H
+#define FAILURECLASSIFIER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+/****************************************************************
+ * @class FailureClassifier
+ * @brief Decides from partial stderr that a compile has failed.
+ ***************************************************************/
+class FailureClassifier
+{
+public:
+    /****************************************************************
+     * @enum Kind
+     * @brief Why pip-compile failed.
+     ***************************************************************/
+    enum class Kind
+    {
+        Unknown,
+        ResolutionImpossible,
+        NoMatchingDistribution,
+        BuildFailure,
+        Environment          ///< no verdict on the pins
+    };
+
+    /****************************************************************
+     * @brief Forgets everything; call before each test.
+     ***************************************************************/
+    void reset();
+
+    /****************************************************************
+     * @brief Matches the complete lines of a stderr chunk; a partial
+     *        last line waits for the next chunk.
+     * @return true once decided (also on later calls).
+     ***************************************************************/
+    bool feed(const QByteArray &data);
+
+    /****************************************************************
+     * @brief Matches the partial last line after the process ended.
+     ***************************************************************/
+    bool finish();
+
+    bool isDecided() const;
+    Kind kind() const;
+
+    /****************************************************************
+     * @brief Projects the messages blame, in order, no duplicates.
+     ***************************************************************/
+    const QStringList &packages() const;
+
+    /****************************************************************
+     * @brief The line that decided the failure.
+     ***************************************************************/
+    const QString &reason() const;
+
+    static QString kindName(Kind kind);
+
+    static const int kMaxLineBytes = 64 * 1024;
+
+private:
+    void matchLine(const QString &line);
+    void decide(Kind kind, const QString &line);
+    void blame(QStringView requirement);
+
+    QByteArray m_partial;            ///< line still being received
+    Kind m_kind = Kind::Unknown;
+    bool m_decided = false;
+    bool m_inConflict = false;       ///< inside "The conflict is caused by:"
+    bool m_unreachable = false;      ///< pip reported network trouble
+    QString m_collecting;            ///< project of the last "Collecting" line
+    QStringList m_packages;
+    QString m_reason;
+};
+
+#endif // FAILURECLASSIFIER_H
+/************** End of FailureClassifier.h **********************/
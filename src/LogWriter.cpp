@@ -0,0 +1,488 @@
+/****************************************************************
+ * @file LogWriter.cpp
+ * @brief Implements the LogWriter class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of LogWriter. Producers
+ * hold the mutex only to append to the queue; the writer thread
+ * swaps the whole queue out and writes it without the lock, so a
+ * slow disk never blocks the GUI thread. Segments are buffered
+ * QFiles flushed once per batch.
+ ***************************************************************/
+#include "LogWriter.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const int kCompressionLevel = 6;
+
+LogWriter::LogWriter(QObject *parent) : QObject(parent)
+{
+}
+
+LogWriter::~LogWriter()
+{
+    close();
+}
+
+/****************************************************************
+ * @brief Continues numbering after the newest existing segment.
+ ***************************************************************/
+bool LogWriter::open(const QString &dir, const QString &name, QString *error)
+{
+    close();
+    if (!QDir().mkpath(dir))
+    {
+        if (error)
+        {
+            *error = tr("Cannot create %1").arg(dir);
+        }
+        return false;
+    }
+    m_dir = dir;
+    m_name = name;
+    const QVector<int> existing = segments(dir, name);
+    m_segment = existing.isEmpty() ? 1 : existing.last() + 1;
+    m_failed = false;
+    m_droppedReported = 0;
+    if (!openSegment())
+    {
+        if (error)
+        {
+            *error = m_log.errorString();
+        }
+        closeSegment();
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_queue.clear();
+    m_queuedBytes = 0;
+    m_enqueued = 0;
+    m_written = 0;
+    m_dropped = 0;
+    m_stop = false;
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("LogWriter");
+    m_thread->start(QThread::LowPriority);
+    return true;
+}
+
+/****************************************************************
+ * @brief Writes the queue, stops the thread and closes the segment.
+ ***************************************************************/
+void LogWriter::close()
+{
+    QThread *thread = nullptr;
+    {
+        QMutexLocker locker(&m_mutex);
+        thread = m_thread;
+        m_stop = true;
+        m_wake.wakeAll();
+    }
+    if (thread)
+    {
+        thread->wait();
+        delete thread;
+    }
+    QMutexLocker locker(&m_mutex);
+    m_thread = nullptr;
+    m_currentPath.clear();
+    m_drained.wakeAll();
+    locker.unlock();
+    closeSegment();
+}
+
+bool LogWriter::isOpen() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_thread != nullptr;
+}
+
+void LogWriter::setSegmentBytes(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_segmentBytes = qMax<qint64>(4096, bytes);
+}
+
+void LogWriter::setMaxBytes(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxBytes = qMax<qint64>(0, bytes);
+}
+
+void LogWriter::setCompressRotated(bool compress)
+{
+    QMutexLocker locker(&m_mutex);
+    m_compress = compress;
+}
+
+void LogWriter::write(const QString &source, Level level, const QString &message)
+{
+    const QJsonObject record{{"time", QDateTime::currentDateTime().toString(Qt::ISODateWithMs)},
+                             {"source", source},
+                             {"level", QString::fromLatin1(levelName(level))},
+                             {"message", message}};
+    enqueue({QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n', QByteArray()});
+}
+
+void LogWriter::writeTest(int testId, const QStringList &pins, bool passed, const QByteArray &output)
+{
+    const QString combination = combinationId(pins);
+    const QJsonObject record{{"time", QDateTime::currentDateTime().toString(Qt::ISODateWithMs)},
+                             {"source", "pip-compile"},
+                             {"level", QString::fromLatin1(levelName(passed ? Level::Info : Level::Error))},
+                             {"test", testId},
+                             {"combination", combination},
+                             {"passed", passed},
+                             {"pins", QJsonArray::fromStringList(pins)},
+                             {"output", QString::fromUtf8(output)}};
+    enqueue({QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n', combination.toLatin1()});
+}
+
+/****************************************************************
+ * @brief Queues a record, or drops it when the queue is full.
+ ***************************************************************/
+void LogWriter::enqueue(Record record)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_thread)
+    {
+        return;
+    }
+    if (m_queuedBytes + record.line.size() > kMaxQueuedBytes)
+    {
+        ++m_dropped;
+        return;
+    }
+    m_queuedBytes += record.line.size();
+    m_queue.append(std::move(record));
+    ++m_enqueued;
+    m_wake.wakeOne();
+}
+
+void LogWriter::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    const quint64 target = m_enqueued;
+    while (m_thread && m_written < target)
+    {
+        m_drained.wait(&m_mutex);
+    }
+}
+
+qint64 LogWriter::dropped() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_dropped;
+}
+
+QString LogWriter::currentSegment() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_currentPath;
+}
+
+QString LogWriter::combinationId(const QStringList &pins)
+{
+    QStringList sorted = pins;
+    std::sort(sorted.begin(), sorted.end());
+    return QString::fromLatin1(QCryptographicHash::hash(sorted.join('\n').toUtf8(), QCryptographicHash::Sha1)
+                                   .toHex()
+                                   .left(16));
+}
+
+/****************************************************************
+ * @brief Scans the indexes newest first, then reads one line from
+ *        the segment (decompressing it if it was rotated).
+ ***************************************************************/
+bool LogWriter::readCombination(const QString &dir, const QString &name,
+                                const QString &combinationId, QJsonObject *record)
+{
+    const QByteArray key = combinationId.toLatin1() + ' ';
+    const QVector<int> numbers = segments(dir, name);
+    const QDir folder(dir);
+    for (int i = int(numbers.size()) - 1; i >= 0; --i)
+    {
+        const QString base = QString("%1-%2").arg(name).arg(numbers.at(i), 6, 10, QChar('0'));
+        QFile index(folder.filePath(base + ".idx"));
+        if (!index.open(QIODevice::ReadOnly))
+        {
+            continue;
+        }
+        const QList<QByteArray> lines = index.readAll().split('\n');
+        for (int j = int(lines.size()) - 1; j >= 0; --j)
+        {
+            if (!lines.at(j).startsWith(key))
+            {
+                continue;
+            }
+            const QList<QByteArray> fields = lines.at(j).split(' ');
+            if (fields.size() != 3)
+            {
+                continue;
+            }
+            const qint64 offset = fields.at(1).toLongLong();
+            const qint64 length = fields.at(2).toLongLong();
+            QByteArray line;
+            QFile plain(folder.filePath(base + ".log"));
+            QFile packed(folder.filePath(base + ".log.z"));
+            if (plain.open(QIODevice::ReadOnly) && plain.seek(offset))
+            {
+                line = plain.read(length);
+            }
+            else if (packed.open(QIODevice::ReadOnly))
+            {
+                line = qUncompress(packed.readAll()).mid(offset, length);
+            }
+            const QJsonDocument doc = QJsonDocument::fromJson(line);
+            if (!doc.isObject())
+            {
+                return false; // truncated or deleted
+            }
+            if (record)
+            {
+                *record = doc.object();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/****************************************************************
+ * @brief Writer thread: writes queued batches until close().
+ ***************************************************************/
+void LogWriter::run()
+{
+    QMutexLocker locker(&m_mutex);
+    for (;;)
+    {
+        if (m_queue.isEmpty())
+        {
+            if (m_stop)
+            {
+                break;
+            }
+            m_wake.wait(&m_mutex);
+            continue;
+        }
+        QVector<Record> batch;
+        batch.swap(m_queue);
+        m_queuedBytes = 0;
+        const qint64 dropped = m_dropped;
+        const qint64 segmentBytes = m_segmentBytes;
+        const qint64 maxBytes = m_maxBytes;
+        const bool compress = m_compress;
+        locker.unlock();
+
+        if (dropped > m_droppedReported)
+        {
+            const QJsonObject note{{"time", QDateTime::currentDateTime().toString(Qt::ISODateWithMs)},
+                                   {"source", "log"},
+                                   {"level", QString::fromLatin1(levelName(Level::Warning))},
+                                   {"message", QString("%1 records dropped, the disk is not keeping up")
+                                                   .arg(dropped - m_droppedReported)}};
+            writeRecord({QJsonDocument(note).toJson(QJsonDocument::Compact) + '\n', QByteArray()},
+                        segmentBytes, maxBytes, compress);
+            m_droppedReported = dropped;
+        }
+        for (int i = 0; i < batch.size(); ++i)
+        {
+            writeRecord(batch.at(i), segmentBytes, maxBytes, compress);
+        }
+        m_log.flush();
+        m_index.flush();
+
+        locker.relock();
+        m_written += quint64(batch.size());
+        m_drained.wakeAll();
+    }
+}
+
+/****************************************************************
+ * @brief Appends one record, rotating first if it would overflow
+ *        the segment.
+ ***************************************************************/
+void LogWriter::writeRecord(const Record &record, qint64 segmentBytes, qint64 maxBytes, bool compress)
+{
+    if (m_segmentSize > 0 && m_segmentSize + record.line.size() > segmentBytes)
+    {
+        rotate(maxBytes, compress);
+    }
+    if (!m_log.isOpen())
+    {
+        return;
+    }
+    const qint64 offset = m_segmentSize;
+    if (m_log.write(record.line) != record.line.size())
+    {
+        fail(tr("Cannot write %1: %2").arg(m_log.fileName(), m_log.errorString()));
+        return;
+    }
+    m_segmentSize += record.line.size();
+    if (!record.combination.isEmpty())
+    {
+        // Length without the newline
+        m_index.write(record.combination + ' ' + QByteArray::number(offset) + ' '
+                      + QByteArray::number(record.line.size() - 1) + '\n');
+    }
+}
+
+bool LogWriter::openSegment()
+{
+    m_log.setFileName(segmentPath(m_segment, ".log"));
+    m_index.setFileName(segmentPath(m_segment, ".idx"));
+    if (!m_log.open(QIODevice::WriteOnly | QIODevice::Append)
+        || !m_index.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        return false;
+    }
+    m_segmentSize = m_log.size();
+    QMutexLocker locker(&m_mutex);
+    m_currentPath = m_log.fileName();
+    return true;
+}
+
+void LogWriter::closeSegment()
+{
+    m_log.close();
+    m_index.close();
+}
+
+/****************************************************************
+ * @brief Closes the full segment, compresses it, trims the folder
+ *        to the size limit and starts the next segment.
+ ***************************************************************/
+void LogWriter::rotate(qint64 maxBytes, bool compress)
+{
+    const QString closed = m_log.fileName();
+    closeSegment();
+    if (compress)
+    {
+        QFile in(closed);
+        QSaveFile out(closed + ".z");
+        if (in.open(QIODevice::ReadOnly) && out.open(QIODevice::WriteOnly))
+        {
+            out.write(qCompress(in.readAll(), kCompressionLevel));
+            in.close();
+            if (out.commit())
+            {
+                QFile::remove(closed);
+            }
+            else
+            {
+                fail(tr("Cannot compress %1: %2").arg(closed, out.errorString()));
+            }
+        }
+    }
+    ++m_segment;
+    enforceLimit(maxBytes);
+    if (!openSegment())
+    {
+        fail(tr("Cannot open %1: %2").arg(m_log.fileName(), m_log.errorString()));
+        closeSegment();
+    }
+    DEBUG_MSG() << "Log rotated to" << m_log.fileName();
+}
+
+/****************************************************************
+ * @brief Deletes the oldest closed segments above maxBytes.
+ ***************************************************************/
+void LogWriter::enforceLimit(qint64 maxBytes)
+{
+    if (maxBytes <= 0)
+    {
+        return;
+    }
+    const QVector<int> numbers = segments(m_dir, m_name);
+    QVector<qint64> sizes(numbers.size());
+    qint64 total = 0;
+    for (int i = 0; i < numbers.size(); ++i)
+    {
+        sizes[i] = QFileInfo(segmentPath(numbers.at(i), ".log")).size()
+                   + QFileInfo(segmentPath(numbers.at(i), ".log.z")).size()
+                   + QFileInfo(segmentPath(numbers.at(i), ".idx")).size();
+        total += sizes.at(i);
+    }
+    for (int i = 0; i < numbers.size() && total > maxBytes; ++i)
+    {
+        QFile::remove(segmentPath(numbers.at(i), ".log"));
+        QFile::remove(segmentPath(numbers.at(i), ".log.z"));
+        QFile::remove(segmentPath(numbers.at(i), ".idx"));
+        total -= sizes.at(i);
+    }
+}
+
+/****************************************************************
+ * @brief Reports the first failure; later ones repeat it.
+ ***************************************************************/
+void LogWriter::fail(const QString &error)
+{
+    DEBUG_MSG() << error;
+    if (!m_failed)
+    {
+        m_failed = true;
+        emit writeFailed(error);
+    }
+}
+
+QString LogWriter::segmentPath(int segment, const QString &suffix) const
+{
+    return QDir(m_dir).filePath(QString("%1-%2%3").arg(m_name).arg(segment, 6, 10, QChar('0')).arg(suffix));
+}
+
+QByteArray LogWriter::levelName(Level level)
+{
+    switch (level)
+    {
+    case Level::Info:
+        return "info";
+    case Level::Warning:
+        return "warning";
+    case Level::Error:
+        return "error";
+    }
+    return "info";
+}
+
+/****************************************************************
+ * @brief Segment numbers present in dir, oldest first.
+ ***************************************************************/
+QVector<int> LogWriter::segments(const QString &dir, const QString &name)
+{
+    const QStringList files = QDir(dir).entryList({name + "-*.log", name + "-*.log.z"}, QDir::Files);
+    QVector<int> numbers;
+    const int start = int(name.size()) + 1;
+    for (int i = 0; i < files.size(); ++i)
+    {
+        const QString &file = files.at(i);
+        const int dot = int(file.indexOf('.', start));
+        bool ok = false;
+        const int number = file.mid(start, dot - start).toInt(&ok);
+        if (ok && number > 0)
+        {
+            numbers.append(number);
+        }
+    }
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+    return numbers;
+}
+
+/************** End of LogWriter.cpp ****************************/
@@ -0,0 +1,183 @@
+/****************************************************************
+ * @file LogWriter.h
+ * @brief Declares LogWriter, the rotating on-disk log.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines LogWriter. Records are JSON lines appended to
+ * numbered segments in a log folder:
+ *   <name>-000001.log     one JSON object per line
+ *   <name>-000001.idx     "<combination> <offset> <length>" lines
+ * The GUI thread only formats a record and queues it; a writer
+ * thread appends the queue in batches. A segment that reaches the
+ * segment size is closed, optionally compressed (<name>-N.log.z,
+ * qCompress format) and the oldest segments are deleted while the
+ * folder is over its size limit. Segment numbers never change, so
+ * an index entry stays valid until its segment is deleted.
+ *
+ * pip-compile output is written with writeTest() under the
+ * combination's id, so readCombination() seeks straight to the
+ * last output of one pin set, in this or any earlier session.
+ *
+ * If the disk cannot keep up the queue is capped and records are
+ * dropped (and counted) rather than stalling the GUI.
+ ***************************************************************/
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QFile>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QWaitCondition>
+
+class QThread;
+
+/****************************************************************
+ * @class LogWriter
+ * @brief Asynchronous, size-capped JSON lines log.
+ ***************************************************************/
+class LogWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Level
+    {
+        Info,
+        Warning,
+        Error
+    };
+
+    explicit LogWriter(QObject *parent = nullptr);
+
+    /****************************************************************
+     * @brief Writes what is queued and stops the writer thread.
+     ***************************************************************/
+    ~LogWriter();
+
+    /****************************************************************
+     * @brief Starts a new segment in dir and the writer thread.
+     * @param dir Log folder, created on demand.
+     * @param name Segment prefix, e.g. "resolve".
+     * @return false with error set if the segment cannot be created.
+     ***************************************************************/
+    bool open(const QString &dir, const QString &name, QString *error = nullptr);
+    void close();
+    bool isOpen() const;
+
+    /****************************************************************
+     * @brief Size at which a segment is closed and a new one started.
+     ***************************************************************/
+    void setSegmentBytes(qint64 bytes);
+
+    /****************************************************************
+     * @brief Size limit of all segments together, 0 for unlimited.
+     ***************************************************************/
+    void setMaxBytes(qint64 bytes);
+
+    void setCompressRotated(bool compress);
+
+    /****************************************************************
+     * @brief Queues a plain record; safe from any thread.
+     * @param source Producer, e.g. "app" or "terminal".
+     ***************************************************************/
+    void write(const QString &source, Level level, const QString &message);
+
+    /****************************************************************
+     * @brief Queues one pip-compile result, indexed by combinationId().
+     ***************************************************************/
+    void writeTest(int testId, const QStringList &pins, bool passed, const QByteArray &output);
+
+    /****************************************************************
+     * @brief Blocks until every record queued so far is on disk.
+     ***************************************************************/
+    void flush();
+
+    /****************************************************************
+     * @brief Records dropped because the queue was full.
+     ***************************************************************/
+    qint64 dropped() const;
+
+    QString currentSegment() const;
+
+    /****************************************************************
+     * @brief Stable id of a pin set: the same pins in any order give
+     *        the same id, across runs and sessions.
+     ***************************************************************/
+    static QString combinationId(const QStringList &pins);
+
+    /****************************************************************
+     * @brief Finds the newest record of a combination.
+     * @param dir Log folder.
+     * @param name Segment prefix used with open().
+     * @return false if no segment still holds it.
+     ***************************************************************/
+    static bool readCombination(const QString &dir, const QString &name,
+                                const QString &combinationId, QJsonObject *record);
+
+    static const qint64 kDefaultSegmentBytes = 64 * 1024 * 1024;
+    static const qint64 kMaxQueuedBytes = 32 * 1024 * 1024;
+
+signals:
+    /****************************************************************
+     * @brief Emitted (queued, from the writer thread) once per
+     *        failure to write, rotate or compress.
+     ***************************************************************/
+    void writeFailed(const QString &error);
+
+private:
+    struct Record
+    {
+        QByteArray line;          ///< JSON plus '\n'
+        QByteArray combination;   ///< empty for plain records
+    };
+
+    void enqueue(Record record);
+    void run();
+    void writeRecord(const Record &record, qint64 segmentBytes, qint64 maxBytes, bool compress);
+    bool openSegment();
+    void rotate(qint64 maxBytes, bool compress);
+    void closeSegment();
+    void enforceLimit(qint64 maxBytes);
+    void fail(const QString &error);
+    QString segmentPath(int segment, const QString &suffix) const;
+    static QByteArray levelName(Level level);
+    static QVector<int> segments(const QString &dir, const QString &name);
+
+    // Shared with the writer thread, guarded by m_mutex
+    mutable QMutex m_mutex;
+    QWaitCondition m_wake;
+    QWaitCondition m_drained;
+    QVector<Record> m_queue;
+    qint64 m_queuedBytes = 0;
+    quint64 m_enqueued = 0;
+    quint64 m_written = 0;
+    qint64 m_dropped = 0;
+    bool m_stop = false;
+    qint64 m_segmentBytes = kDefaultSegmentBytes;
+    qint64 m_maxBytes = 0;
+    bool m_compress = true;
+    QString m_currentPath;
+    QThread *m_thread = nullptr;
+
+    // Writer thread only (and open()/close() while it is stopped)
+    QString m_dir;
+    QString m_name;
+    int m_segment = 0;
+    QFile m_log;
+    QFile m_index;
+    qint64 m_segmentSize = 0;        ///< m_log.size() without flushing it
+    qint64 m_droppedReported = 0;
+    bool m_failed = false;
+};
+
+#endif // LOGWRITER_H
+/************** End of LogWriter.h ******************************/
@@ -20,15 +20,14 @@
 #include "MainWindow.h"
 #include <QApplication>
 #include <QDebug>
-#include <QEventLoop>
 #include <QFileDialog>
 #include <QHeaderView>
 #include <QLabel>
-#include <QNetworkAccessManager>
+#include <QLocale>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QProcess>
-#include <QSysInfo>
+#include <QThread>
 #include <QUrl>
 #include <utility>
 #include "Config.h"
@@ -43,7 +42,23 @@ const QString DEFAULT_PYTHON_VERSION = "3.10";
 const QString DEFAULT_PIP_VERSION = "23.2";
 const QString DEFAULT_PIPTOOLS_VERSION = "6.13";
 const int DEFAULT_MAX_ITEMS = 10;
+const int DEFAULT_PARALLEL_WORKERS = qMax(1, QThread::idealThreadCount());
+const int DEFAULT_MATRIX_RANGE = 2;
+const int DEFAULT_DOWNLOAD_TIMEOUT_SEC = 30;
+const bool DEFAULT_USE_TEMPLATE_VENV = true;
+const bool DEFAULT_USE_WHEELHOUSE = true;
+const int DEFAULT_WHEELHOUSE_LIMIT_GB = 20;
+const int DEFAULT_PREFETCH_AHEAD = 3;
+const int DEFAULT_PREFETCH_RATE_MB = 0;
+const int DEFAULT_BATCH_PARALLEL = 4;
+const int DEFAULT_BATCH_TIMEOUT_MIN = 0;
+const bool DEFAULT_BATCH_GPU_SLOTS = true;
+const int DEFAULT_LOG_LIMIT_MB = 2048;
+const bool DEFAULT_COMPRESS_LOGS = true;
 const QString DEFAULT_APP_VERSION = "1.0";
+const qint64 PACKAGE_INDEX_MAX_AGE_SECS = 24 * 60 * 60;
+const int PACKAGE_SEARCH_RESULTS = 20;
+const int STATS_REFRESH_MS = 1000;
 const QString MainWindow::kOrganizationName = "AM-Tower";
 const QString MainWindow::kApplicationName = "PipMatrixResolver";
 
@@ -52,13 +67,30 @@ const QString MainWindow::kApplicationName = "PipMatrixResolver";
  ***************************************************************/
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
-    , requirementsModel(new QStandardItemModel(this))
+    , requirementsModel(new RequirementsModel(this))
     , localHistoryModel(new QStandardItemModel(this))
     , webHistoryModel(new QStandardItemModel(this))
     , maxHistoryItems(10)
     , terminalEngine(new TerminalEngine(this))
-{
+    , resolveSession(new ResolveSession(this))
+    , packageManager(new PackageManager(this))
+    , packageIndex(new PackageIndex(this))
+    , systemProbe(new SystemProbe(this))
+    , logWriter(new LogWriter(this))
+{
+    // Before setupUi(): setPythonCommand() reads probe results from it
+    SystemProbe::setCacheFile(QDir(cacheDir()).filePath("probes.json"));
+    resolveSession->setCacheDir(cacheDir());
+    matrixModel = new MatrixModel(resolveSession->engine(), this);
     setupUi();
+    QString logError;
+    if (!logWriter->open(QDir(logsDir()).filePath("log"), "session", &logError))
+    {
+        appendLog(tr("Logging to disk is off: %1").arg(logError));
+    }
+    connect(logWriter, &LogWriter::writeFailed, this, [this](const QString &error) {
+        logSink->append(tr("Log file error: %1").arg(error), OutputSink::Style::Error);
+    });
     // Disable terminal tab at startup
     tabTerminal->setEnabled(false);
 
@@ -82,6 +114,12 @@ MainWindow::MainWindow(QWidget *parent)
     loadHistory();
     // Statusbar que.
     connect(&statusTimer, &QTimer::timeout, this, &MainWindow::showNextStatusMessage);
+    // Stats tab
+    connect(exportTraceBtn, &QPushButton::clicked, this, &MainWindow::onExportTrace);
+    connect(resetStatsBtn, &QPushButton::clicked, this, &MainWindow::onResetStats);
+    connect(&statsTimer, &QTimer::timeout, this, &MainWindow::refreshStats);
+    statsTimer.start(STATS_REFRESH_MS);
+    refreshStats();
     connect(commandsTab, &CommandsTab::requestStatusMessage,
             this, [this](const QString& msg, int timeoutMs){
                 statusBar->showMessage(msg, timeoutMs);
@@ -100,6 +138,36 @@ MainWindow::MainWindow(QWidget *parent)
     connect(actionPause, &QAction::triggered, this, &MainWindow::pauseResolve);
     connect(actionResume, &QAction::triggered, this, &MainWindow::resumeResolve);
     connect(actionStop, &QAction::triggered, this, &MainWindow::stopResolve);
+    connect(actionCancelDownload, &QAction::triggered, this, &MainWindow::cancelUrlLoad);
+
+    // Connect the matrix resolver
+    connect(resolveSession, &ResolveSession::logMessage, this, &MainWindow::appendLog);
+    connect(resolveSession, &ResolveSession::progressChanged, this, &MainWindow::updateProgress);
+    connect(resolveSession->progress(), &ResolveProgress::updated, this, &MainWindow::updateResolveProgress);
+    connect(resolveSession, &ResolveSession::searchStarted, matrixModel, &MatrixModel::reload);
+    connect(resolveSession, &ResolveSession::resolved,
+            this, [this](const QStringList &pins, const QString &outputPath) {
+                appendLog(tr("Working set: %1").arg(pins.join(", ")));
+                saveRunTrace();
+                showCompiledResult(outputPath);
+            });
+    connect(resolveSession, &ResolveSession::exhausted, this, [this]() {
+        saveRunTrace();
+        queueStatusMessage(tr("No compatible combination found"), 5000);
+    });
+    connect(resolveSession, &ResolveSession::failed, this, [this](const QString &error) {
+        appendLog(error);
+        queueStatusMessage(error, 5000);
+    });
+    connect(resolveSession->runner(), &PipCompileRunner::testLog, logWriter, &LogWriter::writeTest);
+
+    // An interrupted resolve (crash, reboot, exit) can be continued
+    QDateTime checkpointSaved;
+    if (resolveSession->hasCheckpoint(&checkpointSaved))
+    {
+        appendLog(tr("An interrupted resolve from %1 can be continued with Resume")
+                      .arg(QLocale().toString(checkpointSaved, QLocale::ShortFormat)));
+    }
 
     // Connect settings buttons
     if (buttonBoxPreferences)
@@ -135,13 +203,44 @@ MainWindow::MainWindow(QWidget *parent)
     connect(searchPackageBtn, &QPushButton::clicked, this, &MainWindow::onSearchPackage);
     connect(installPackageBtn, &QPushButton::clicked, this, &MainWindow::onInstallPackage);
     connect(uninstallPackageBtn, &QPushButton::clicked, this, &MainWindow::onUninstallPackage);
+    connect(packageManager,
+            &PackageManager::installedChanged,
+            this,
+            &MainWindow::onInstalledPackagesChanged);
+    connect(packageManager,
+            &PackageManager::jobFinished,
+            this,
+            &MainWindow::onPackageJobFinished);
+    connect(packageManager, &PackageManager::output, this, [this](const QString &text, bool isError) {
+        const QString trimmed = text.trimmed();
+        if (!trimmed.isEmpty())
+        {
+            packageOutput->appendPlainText(isError ? "[ERROR] " + trimmed : trimmed);
+            logWriter->write("packages", isError ? LogWriter::Level::Error : LogWriter::Level::Info, trimmed);
+        }
+    });
 
     connect(mainTabs, &QTabWidget::currentChanged, this, [this](int index) {
         if (mainTabs->widget(index)->objectName() == "tabPackageManager")
         {
             refreshInstalledPackages();
+            openPackageIndex();
         }
     });
+
+    // Search-as-you-type over the local PyPI name index
+    packageIndex->setNetworkManager(resolveSession->fetcher()->networkManager());
+    packageSearchTimer.setSingleShot(true);
+    packageSearchTimer.setInterval(150);
+    connect(&packageSearchTimer, &QTimer::timeout, this, &MainWindow::updatePackageCompletions);
+    connect(packageNameInput, &QLineEdit::textEdited, this, [this]() { packageSearchTimer.start(); });
+    connect(packageIndex, &PackageIndex::ready, this, [this](int count) {
+        packageNameInput->setPlaceholderText(tr("Search %1 PyPI projects").arg(QLocale().toString(count)));
+    });
+    connect(packageIndex, &PackageIndex::logMessage, packageOutput, &QPlainTextEdit::appendPlainText);
+    connect(packageIndex, &PackageIndex::refreshFailed, this, [this](const QString &error) {
+        packageOutput->appendPlainText(tr("[ERROR] Package index update failed: %1").arg(error));
+    });
     connect(installedPackagesList,
             &QListWidget::doubleClicked,
             this,
@@ -152,7 +251,9 @@ MainWindow::MainWindow(QWidget *parent)
     refreshHistoryTables();
     checkAndRestoreSettings();
 
-    detectSystem();
+    // GPU and interpreter probes run once the window is shown
+    connect(systemProbe, &SystemProbe::finished, this, &MainWindow::onSystemProbed);
+    QTimer::singleShot(0, this, &MainWindow::detectSystem);
     restoreCpuCudaSettings();
     setupVenvPaths();
 
@@ -161,7 +262,10 @@ MainWindow::MainWindow(QWidget *parent)
 /****************************************************************
  * @brief Destructor for MainWindow.
  ***************************************************************/
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow()
+{
+    // ResolveSession keeps an interrupted resolve resumable
+}
 
 /****************************************************************
  * @brief Sets up the entire UI dynamically.
@@ -199,16 +303,37 @@ void MainWindow::setupUi()
     bottomSplitter = new QSplitter(Qt::Horizontal, tabMain);
     logView = new QPlainTextEdit(bottomSplitter);
     logView->setReadOnly(true);
-    progress = new QProgressBar(bottomSplitter);
+    logSink = new OutputSink(logView);
+    progressPanel = new QWidget(bottomSplitter);
+    QVBoxLayout *progressLayout = new QVBoxLayout(progressPanel);
+    progressLayout->setContentsMargins(0, 0, 0, 0);
+    progress = new QProgressBar(progressPanel);
+    progressLabel = new QLabel(progressPanel);
+    progressLabel->setWordWrap(true);
+    progressLabel->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    progressLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    progressLayout->addWidget(progress);
+    progressLayout->addWidget(progressLabel, 1);
     bottomSplitter->addWidget(logView);
-    bottomSplitter->addWidget(progress);
+    bottomSplitter->addWidget(progressPanel);
     mainTabLayout->addWidget(bottomSplitter);
 
     requirementsView->setModel(requirementsModel);
     requirementsView->setAlternatingRowColors(true);
+    // Uniform rows: no per-row measuring, however long the file
+    requirementsView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    requirementsView->verticalHeader()->setDefaultSectionSize(requirementsView->fontMetrics().height() + 6);
     requirementsView->setSelectionBehavior(QAbstractItemView::SelectRows);
     requirementsView->setSelectionMode(QAbstractItemView::ExtendedSelection);
 
+    // Rows are computed on demand, so nothing may ask for all of them
+    matrixView->setModel(matrixModel);
+    matrixView->setWordWrap(false);
+    matrixView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    matrixView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    matrixView->verticalHeader()->setDefaultSectionSize(matrixView->fontMetrics().height() + 6);
+    matrixView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+
     mainTabs->addTab(tabMain, tr("Main"));
 
     // === TAB: HISTORY ===
@@ -273,6 +398,7 @@ void MainWindow::setupUi()
     QVBoxLayout *terminalLayout = new QVBoxLayout(tabTerminal);
 
     terminalOutput = new QPlainTextEdit(tabTerminal);
+    terminalSink = new OutputSink(terminalOutput);
     terminalLayout->addWidget(terminalOutput);
 
     QHBoxLayout *terminalCommandLayout = new QHBoxLayout();
@@ -297,6 +423,11 @@ void MainWindow::setupUi()
 
     QHBoxLayout *packageManagerCommandLayout = new QHBoxLayout();
     packageNameInput = new QLineEdit(tabPackageManager);
+    packageCompletions = new QStringListModel(this);
+    packageCompleter = new QCompleter(packageCompletions, this);
+    packageCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion); // ranked by PackageIndex
+    packageCompleter->setMaxVisibleItems(PACKAGE_SEARCH_RESULTS);
+    packageNameInput->setCompleter(packageCompleter);
     searchPackageBtn = new QPushButton(tr("Search"), tabPackageManager);
     installPackageBtn = new QPushButton(tr("Install"), tabPackageManager);
     uninstallPackageBtn = new QPushButton(tr("Uninstall"), tabPackageManager);
@@ -347,6 +478,100 @@ void MainWindow::setupUi()
     spinMaxItems->setToolTip(tr("-1 = unlimited, 0 not allowed, ≥1 valid"));
     formLayout->addRow(tr("Maximum number of items:"), spinMaxItems);
 
+    spinParallelWorkers = new QSpinBox(tabSettings);
+    spinParallelWorkers->setMinimum(1);
+    spinParallelWorkers->setMaximum(256);
+    spinParallelWorkers->setValue(DEFAULT_PARALLEL_WORKERS);
+    spinParallelWorkers->setToolTip(tr("Concurrent pip-compile processes during a matrix resolve; each gets its own venv clone"));
+    formLayout->addRow(tr("Parallel workers:"), spinParallelWorkers);
+
+    spinMatrixRange = new QSpinBox(tabSettings);
+    spinMatrixRange->setMinimum(0);
+    spinMatrixRange->setMaximum(20);
+    spinMatrixRange->setValue(DEFAULT_MATRIX_RANGE);
+    spinMatrixRange->setToolTip(tr("Newer minor releases tried after each package's floor version"));
+    formLayout->addRow(tr("Matrix range:"), spinMatrixRange);
+
+    spinDownloadTimeout = new QSpinBox(tabSettings);
+    spinDownloadTimeout->setMinimum(1);
+    spinDownloadTimeout->setMaximum(3600);
+    spinDownloadTimeout->setSuffix(tr(" s"));
+    spinDownloadTimeout->setValue(DEFAULT_DOWNLOAD_TIMEOUT_SEC);
+    spinDownloadTimeout->setToolTip(tr("A URL download is aborted after this long without data"));
+    formLayout->addRow(tr("Download timeout:"), spinDownloadTimeout);
+
+    useTemplateVenvCheckBox = new QCheckBox(tabSettings);
+    useTemplateVenvCheckBox->setChecked(DEFAULT_USE_TEMPLATE_VENV);
+    useTemplateVenvCheckBox->setToolTip(tr("Build each Python/pip/pip-tools combination once and clone it for new venvs"));
+    formLayout->addRow(tr("Use template venv:"), useTemplateVenvCheckBox);
+
+    useWheelhouseCheckBox = new QCheckBox(tabSettings);
+    useWheelhouseCheckBox->setChecked(DEFAULT_USE_WHEELHOUSE);
+    useWheelhouseCheckBox->setToolTip(tr("Keep candidate wheels in a shared local wheelhouse and resolve against it"));
+    formLayout->addRow(tr("Use wheelhouse:"), useWheelhouseCheckBox);
+
+    spinWheelhouseLimit = new QSpinBox(tabSettings);
+    spinWheelhouseLimit->setMinimum(0);
+    spinWheelhouseLimit->setMaximum(10000);
+    spinWheelhouseLimit->setSuffix(tr(" GB"));
+    spinWheelhouseLimit->setSpecialValueText(tr("Unlimited"));
+    spinWheelhouseLimit->setValue(DEFAULT_WHEELHOUSE_LIMIT_GB);
+    spinWheelhouseLimit->setToolTip(tr("Least recently used wheels are evicted above this size"));
+    formLayout->addRow(tr("Wheelhouse limit:"), spinWheelhouseLimit);
+
+    spinPrefetchAhead = new QSpinBox(tabSettings);
+    spinPrefetchAhead->setMinimum(0);
+    spinPrefetchAhead->setMaximum(50);
+    spinPrefetchAhead->setSuffix(tr(" combinations"));
+    spinPrefetchAhead->setSpecialValueText(tr("All candidates first"));
+    spinPrefetchAhead->setValue(DEFAULT_PREFETCH_AHEAD);
+    spinPrefetchAhead->setToolTip(tr("Wheels of the combinations tried next are fetched while the current one compiles"));
+    formLayout->addRow(tr("Prefetch ahead:"), spinPrefetchAhead);
+
+    spinPrefetchRate = new QSpinBox(tabSettings);
+    spinPrefetchRate->setMinimum(0);
+    spinPrefetchRate->setMaximum(10000);
+    spinPrefetchRate->setSuffix(tr(" MB/s"));
+    spinPrefetchRate->setSpecialValueText(tr("Unlimited"));
+    spinPrefetchRate->setValue(DEFAULT_PREFETCH_RATE_MB);
+    spinPrefetchRate->setToolTip(tr("Average download rate of fetching ahead"));
+    formLayout->addRow(tr("Prefetch rate:"), spinPrefetchRate);
+
+    spinBatchParallel = new QSpinBox(tabSettings);
+    spinBatchParallel->setMinimum(1);
+    spinBatchParallel->setMaximum(256);
+    spinBatchParallel->setValue(DEFAULT_BATCH_PARALLEL);
+    spinBatchParallel->setToolTip(tr("Commands of a batch file run at the same time"));
+    formLayout->addRow(tr("Batch parallel jobs:"), spinBatchParallel);
+
+    spinBatchTimeout = new QSpinBox(tabSettings);
+    spinBatchTimeout->setMinimum(0);
+    spinBatchTimeout->setMaximum(10080);
+    spinBatchTimeout->setSuffix(tr(" min"));
+    spinBatchTimeout->setSpecialValueText(tr("None"));
+    spinBatchTimeout->setValue(DEFAULT_BATCH_TIMEOUT_MIN);
+    spinBatchTimeout->setToolTip(tr("A batch job running longer than this is killed and the batch continues"));
+    formLayout->addRow(tr("Batch job timeout:"), spinBatchTimeout);
+
+    batchGpuSlotsCheckBox = new QCheckBox(tabSettings);
+    batchGpuSlotsCheckBox->setChecked(DEFAULT_BATCH_GPU_SLOTS);
+    batchGpuSlotsCheckBox->setToolTip(tr("Run at most one batch job per detected NVIDIA GPU, each with its own CUDA_VISIBLE_DEVICES"));
+    formLayout->addRow(tr("One batch job per GPU:"), batchGpuSlotsCheckBox);
+
+    spinLogLimit = new QSpinBox(tabSettings);
+    spinLogLimit->setMinimum(0);
+    spinLogLimit->setMaximum(1000000);
+    spinLogLimit->setSuffix(tr(" MB"));
+    spinLogLimit->setSpecialValueText(tr("Unlimited"));
+    spinLogLimit->setValue(DEFAULT_LOG_LIMIT_MB);
+    spinLogLimit->setToolTip(tr("The oldest log segments in the logs folder are deleted above this size"));
+    formLayout->addRow(tr("Log folder limit:"), spinLogLimit);
+
+    compressLogsCheckBox = new QCheckBox(tabSettings);
+    compressLogsCheckBox->setChecked(DEFAULT_COMPRESS_LOGS);
+    compressLogsCheckBox->setToolTip(tr("Compress each log segment once it is full"));
+    formLayout->addRow(tr("Compress old logs:"), compressLogsCheckBox);
+
     gpuDetectedCheckBox = new QCheckBox(tabSettings);
     gpuDetectedCheckBox->setEnabled(false);
     formLayout->addRow(tr("GPU Detected:"), gpuDetectedCheckBox);
@@ -386,6 +611,37 @@ void MainWindow::setupUi()
 
     mainTabs->addTab(tabSettings, tr("Settings"));
 
+    // === TAB: STATS ===
+    tabStats = new QWidget();
+    tabStats->setObjectName("tabStats");
+    QVBoxLayout *statsLayout = new QVBoxLayout(tabStats);
+
+    statsSummaryLabel = new QLabel(tabStats);
+    statsSummaryLabel->setWordWrap(true);
+    statsLayout->addWidget(statsSummaryLabel);
+
+    statsModel = new QStandardItemModel(0, 7, this);
+    statsModel->setHorizontalHeaderLabels({tr("Phase"), tr("Count"), tr("Failed"), tr("Running"),
+                                           tr("Total (s)"), tr("Mean (ms)"), tr("Max (ms)")});
+    statsTable = new QTableView(tabStats);
+    statsTable->setObjectName("statsTable");
+    statsTable->setModel(statsModel);
+    statsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    statsTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    statsTable->verticalHeader()->setVisible(false);
+    statsLayout->addWidget(statsTable);
+
+    QHBoxLayout *statsButtonLayout = new QHBoxLayout();
+    exportTraceBtn = new QPushButton(tr("Export trace..."), tabStats);
+    exportTraceBtn->setToolTip(tr("Chrome trace event JSON for chrome://tracing or ui.perfetto.dev"));
+    resetStatsBtn = new QPushButton(tr("Reset"), tabStats);
+    statsButtonLayout->addStretch();
+    statsButtonLayout->addWidget(exportTraceBtn);
+    statsButtonLayout->addWidget(resetStatsBtn);
+    statsLayout->addLayout(statsButtonLayout);
+
+    mainTabs->addTab(tabStats, tr("Stats"));
+
     // === MENU BAR ===
     menuBar = new QMenuBar(this);
     setMenuBar(menuBar);
@@ -402,8 +658,15 @@ void MainWindow::setupUi()
     actionFetchRequirements = new QAction(QIcon(":/icons/icons/url.svg"),
                                           tr("Fetch requirements from URL..."),
                                           this);
+    actionFetchRequirements->setObjectName("actionFetchRequirements");
     menuFile->addAction(actionFetchRequirements);
 
+    actionCancelDownload = new QAction(QIcon(":/icons/icons/cancel.svg"),
+                                       tr("Cancel download"),
+                                       this);
+    actionCancelDownload->setEnabled(false);
+    menuFile->addAction(actionCancelDownload);
+
     menuFile->addSeparator();
 
     // Recent menus (created here, populated later)
@@ -462,6 +725,7 @@ void MainWindow::setupUi()
 
     mainToolBar->addAction(actionOpenRequirements);
     mainToolBar->addAction(actionFetchRequirements);
+    mainToolBar->addAction(actionCancelDownload);
     mainToolBar->addAction(actionCreateVenv);
     mainToolBar->addAction(actionResolveMatrix);
     mainToolBar->addAction(actionPause);
@@ -489,6 +753,11 @@ void MainWindow::setupUi()
             this,
             &MainWindow::onTerminalCommandFinished);
     connect(terminalEngine, &TerminalEngine::venvProgress, this, &MainWindow::onVenvProgress);
+    connect(terminalEngine,
+            &TerminalEngine::venvCreationFinished,
+            this,
+            &MainWindow::onVenvCreationFinished);
+    terminalEngine->setTemplateRoot(QDir(cacheDir()).filePath("templates"));
 
     // Settings tab connections (safe order)
     connect(saveSettingsButton, &QPushButton::clicked, this, &MainWindow::onSaveSettings);
@@ -588,6 +857,10 @@ void MainWindow::loadRequirementsFromFile(const QString &path)
     {
         return;
     }
+    if (urlReply)
+    {
+        cancelUrlLoad();
+    }
     if (!QFile::exists(path))
     {
         QMessageBox::warning(this, tr("File missing"), tr("File no longer exists:\n%1").arg(path));
@@ -596,7 +869,7 @@ void MainWindow::loadRequirementsFromFile(const QString &path)
         saveHistory();
         return;
     }
-    const QStringList lines = readTextFileLines(path);
+    const QStringList lines = Requirement::logicalLines(readTextFileLines(path));
     QStringList errors;
     if (!validateRequirementsWithErrors(lines, errors))
     {
@@ -607,7 +880,6 @@ void MainWindow::loadRequirementsFromFile(const QString &path)
     }
     if (requirementsModel)
     {
-        requirementsModel->clear();
         writeTableToModel(lines);
     }
     applySettingsFromUi();
@@ -626,7 +898,9 @@ void MainWindow::loadRequirementsFromFile(const QString &path)
 }
 
 /****************************************************************
- * @brief Loads requirements from a URL.
+ * @brief Starts loading requirements from a URL. Lines stream into
+ *        the table as they arrive; the previous table comes back
+ *        if the download fails, times out or is cancelled.
  ***************************************************************/
 void MainWindow::loadRequirementsFromUrl(const QString &url)
 {
@@ -634,31 +908,151 @@ void MainWindow::loadRequirementsFromUrl(const QString &url)
     {
         return;
     }
-    QByteArray content;
-    if (!downloadText(url, content))
+    if (urlReply)
+    {
+        cancelUrlLoad();
+    }
+
+    urlPreviousLines = requirementsModel->lines();
+    urlLoading = url;
+    urlBuffer.clear();
+    urlErrors.clear();
+    urlLinesSeen = 0;
+    urlCancelled = false;
+    resetRequirementsTable();
+
+    QNetworkRequest request{QUrl(url)};
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
+                         QNetworkRequest::NoLessSafeRedirectPolicy);
+    request.setTransferTimeout(spinDownloadTimeout->value() * 1000);
+    urlReply = resolveSession->fetcher()->networkManager()->get(request);
+    connect(urlReply, &QNetworkReply::readyRead, this, &MainWindow::onUrlReadyRead);
+    connect(urlReply, &QNetworkReply::finished, this, &MainWindow::onUrlFinished);
+
+    actionCancelDownload->setEnabled(true);
+    queueStatusMessage(tr("Downloading %1...").arg(url), 3000);
+}
+
+/****************************************************************
+ * @brief Cancel action: aborts the running URL download.
+ ***************************************************************/
+void MainWindow::cancelUrlLoad()
+{
+    if (!urlReply)
+    {
+        return;
+    }
+    urlCancelled = true;
+    urlReply->abort(); // finished() follows synchronously
+}
+
+/****************************************************************
+ * @brief Consumes each chunk as the network delivers it.
+ ***************************************************************/
+void MainWindow::onUrlReadyRead()
+{
+    if (!urlReply)
+    {
+        return;
+    }
+    urlBuffer += urlReply->readAll();
+    consumeUrlLines(false);
+}
+
+/****************************************************************
+ * @brief Validates and appends the complete lines received so far.
+ ***************************************************************/
+void MainWindow::consumeUrlLines(bool flush)
+{
+    const int end = flush ? urlBuffer.size() : urlBuffer.lastIndexOf('\n') + 1;
+    if (end <= 0)
     {
-        QMessageBox::warning(this,
-                             tr("Download failed"),
-                             tr("Failed to fetch requirements from URL:\n%1").arg(url));
-        historyRecentWeb.removeAll(url);
-        refreshRecentMenus();
-        saveHistory();
         return;
     }
-    const QStringList lines = QString::fromUtf8(content).split('\n', Qt::KeepEmptyParts);
+    // Blank lines count for the error line numbers, as in a file;
+    // the table skips them
+    QStringList physical = QString::fromUtf8(urlBuffer.constData(), end).split('\n');
+    if (urlBuffer.at(end - 1) == '\n')
+    {
+        physical.removeLast(); // after the final newline
+    }
+    QStringList lines = Requirement::logicalLines(physical);
+    urlBuffer.remove(0, end);
+    if (!flush && !lines.isEmpty() && lines.last().endsWith('\\'))
+    {
+        // Continued on a line that has not arrived yet
+        urlBuffer.prepend(lines.takeLast().toUtf8() + '\n');
+    }
+
     QStringList errors;
-    if (!validateRequirementsWithErrors(lines, errors))
+    if (!validateRequirementsWithErrors(lines, errors, urlLinesSeen + 1))
     {
+        urlErrors << errors;
+    }
+    urlLinesSeen += lines.size();
+    if (!urlErrors.isEmpty())
+    {
+        // No point downloading the rest of an invalid file
+        if (urlReply && urlReply->isRunning())
+        {
+            urlReply->abort();
+        }
+        return;
+    }
+    appendRequirementRows(lines);
+}
+
+/****************************************************************
+ * @brief Completes the URL load; history is only touched on success.
+ ***************************************************************/
+void MainWindow::onUrlFinished()
+{
+    QNetworkReply *reply = urlReply;
+    if (!reply)
+    {
+        return;
+    }
+    urlReply = nullptr;
+    reply->deleteLater();
+    actionCancelDownload->setEnabled(false);
+
+    const QString url = urlLoading;
+    const bool networkOk = reply->error() == QNetworkReply::NoError;
+    if (networkOk && urlErrors.isEmpty())
+    {
+        urlBuffer += reply->readAll();
+        consumeUrlLines(true);
+    }
+
+    if (!urlErrors.isEmpty())
+    {
+        writeTableToModel(urlPreviousLines);
         QMessageBox::warning(this,
                              tr("Invalid requirements.txt"),
-                             tr("Fetched content failed validation:\n%1").arg(errors.join("\n")));
+                             tr("Fetched content failed validation:\n%1").arg(urlErrors.join("\n")));
         return;
     }
-    if (requirementsModel)
+    if (urlCancelled)
     {
-        requirementsModel->clear();
-        writeTableToModel(lines);
+        writeTableToModel(urlPreviousLines);
+        appendLog(tr("Download cancelled: %1").arg(url));
+        return;
+    }
+    if (!networkOk)
+    {
+        writeTableToModel(urlPreviousLines);
+        QMessageBox::warning(this,
+                             tr("Download failed"),
+                             tr("Failed to fetch requirements from URL:\n%1\n%2")
+                                 .arg(url, reply->errorString()));
+        historyRecentWeb.removeAll(url);
+        refreshRecentMenus();
+        saveHistory();
+        return;
     }
+
+    finishRequirementsTable();
     applySettingsFromUi();
     historyRecentWeb.removeAll(url);
     historyRecentWeb.prepend(url);
@@ -782,6 +1176,19 @@ void MainWindow::loadAppSettings()
     QString pipVer = settings.value("PipVersion", DEFAULT_PIP_VERSION).toString();
     QString pipToolsVer = settings.value("PipToolsVersion", DEFAULT_PIPTOOLS_VERSION).toString();
     int maxItems = settings.value("app/maxItems", DEFAULT_MAX_ITEMS).toInt();
+    int workers = settings.value("app/parallelWorkers", DEFAULT_PARALLEL_WORKERS).toInt();
+    int matrixRange = settings.value("app/matrixRange", DEFAULT_MATRIX_RANGE).toInt();
+    int downloadTimeout = settings.value("app/downloadTimeout", DEFAULT_DOWNLOAD_TIMEOUT_SEC).toInt();
+    bool useTemplate = settings.value("app/useTemplateVenv", DEFAULT_USE_TEMPLATE_VENV).toBool();
+    bool useWheelhouse = settings.value("app/useWheelhouse", DEFAULT_USE_WHEELHOUSE).toBool();
+    int wheelhouseLimit = settings.value("app/wheelhouseLimitGb", DEFAULT_WHEELHOUSE_LIMIT_GB).toInt();
+    int prefetchAhead = settings.value("app/prefetchAhead", DEFAULT_PREFETCH_AHEAD).toInt();
+    int prefetchRate = settings.value("app/prefetchRateMb", DEFAULT_PREFETCH_RATE_MB).toInt();
+    int batchParallel = settings.value("app/batchParallel", DEFAULT_BATCH_PARALLEL).toInt();
+    int batchTimeout = settings.value("app/batchTimeoutMin", DEFAULT_BATCH_TIMEOUT_MIN).toInt();
+    bool batchGpuSlots = settings.value("app/batchGpuSlots", DEFAULT_BATCH_GPU_SLOTS).toBool();
+    int logLimit = settings.value("app/logLimitMb", DEFAULT_LOG_LIMIT_MB).toInt();
+    bool compressLogs = settings.value("app/compressLogs", DEFAULT_COMPRESS_LOGS).toBool();
 
     // Update internal state
     maxHistoryItems = maxItems;
@@ -791,9 +1198,24 @@ void MainWindow::loadAppSettings()
     pipVersionEdit->setText(pipVer);
     pipToolsVersionEdit->setText(pipToolsVer);
     spinMaxItems->setValue(maxItems);
+    spinParallelWorkers->setValue(workers);
+    spinMatrixRange->setValue(matrixRange);
+    spinDownloadTimeout->setValue(downloadTimeout);
+    useTemplateVenvCheckBox->setChecked(useTemplate);
+    useWheelhouseCheckBox->setChecked(useWheelhouse);
+    spinWheelhouseLimit->setValue(wheelhouseLimit);
+    spinPrefetchAhead->setValue(prefetchAhead);
+    spinPrefetchRate->setValue(prefetchRate);
+    spinBatchParallel->setValue(batchParallel);
+    spinBatchTimeout->setValue(batchTimeout);
+    batchGpuSlotsCheckBox->setChecked(batchGpuSlots);
+    spinLogLimit->setValue(logLimit);
+    compressLogsCheckBox->setChecked(compressLogs);
 
     // Apply Python command immediately
     terminalEngine->setPythonCommand(pythonVer);
+    applyBatchSettings();
+    applyLogSettings();
 
     // Validate and sync UI
     validateAppSettings();
@@ -817,7 +1239,22 @@ void MainWindow::onSaveSettings()
     settings.setValue("PipVersion", pipVer);
     settings.setValue("PipToolsVersion", pipToolsVer);
     settings.setValue("app/maxItems", maxItems);
+    settings.setValue("app/parallelWorkers", spinParallelWorkers->value());
+    settings.setValue("app/matrixRange", spinMatrixRange->value());
+    settings.setValue("app/downloadTimeout", spinDownloadTimeout->value());
+    settings.setValue("app/useTemplateVenv", useTemplateVenvCheckBox->isChecked());
+    settings.setValue("app/useWheelhouse", useWheelhouseCheckBox->isChecked());
+    settings.setValue("app/wheelhouseLimitGb", spinWheelhouseLimit->value());
+    settings.setValue("app/prefetchAhead", spinPrefetchAhead->value());
+    settings.setValue("app/prefetchRateMb", spinPrefetchRate->value());
+    settings.setValue("app/batchParallel", spinBatchParallel->value());
+    settings.setValue("app/batchTimeoutMin", spinBatchTimeout->value());
+    settings.setValue("app/batchGpuSlots", batchGpuSlotsCheckBox->isChecked());
+    settings.setValue("app/logLimitMb", spinLogLimit->value());
+    settings.setValue("app/compressLogs", compressLogsCheckBox->isChecked());
     settings.sync();
+    applyBatchSettings();
+    applyLogSettings();
 
     queueStatusMessage(tr("Settings saved. Python command updated to: %1").arg(terminalEngine->pythonCommand()), 5000);
 }
@@ -829,6 +1266,8 @@ void MainWindow::onApplySettings()
 {
     QString pythonVer = pythonVersionEdit->text().trimmed();
     terminalEngine->setPythonCommand(pythonVer);
+    applyBatchSettings();
+    applyLogSettings();
 
     queueStatusMessage(tr("Settings applied. Python command updated to: %1").arg(terminalEngine->pythonCommand()), 5000);
 }
@@ -843,6 +1282,19 @@ void MainWindow::onRestoreDefaults()
     pipVersionEdit->setText(DEFAULT_PIP_VERSION);
     pipToolsVersionEdit->setText(DEFAULT_PIPTOOLS_VERSION);
     spinMaxItems->setValue(DEFAULT_MAX_ITEMS);
+    spinParallelWorkers->setValue(DEFAULT_PARALLEL_WORKERS);
+    spinMatrixRange->setValue(DEFAULT_MATRIX_RANGE);
+    spinDownloadTimeout->setValue(DEFAULT_DOWNLOAD_TIMEOUT_SEC);
+    useTemplateVenvCheckBox->setChecked(DEFAULT_USE_TEMPLATE_VENV);
+    useWheelhouseCheckBox->setChecked(DEFAULT_USE_WHEELHOUSE);
+    spinWheelhouseLimit->setValue(DEFAULT_WHEELHOUSE_LIMIT_GB);
+    spinPrefetchAhead->setValue(DEFAULT_PREFETCH_AHEAD);
+    spinPrefetchRate->setValue(DEFAULT_PREFETCH_RATE_MB);
+    spinBatchParallel->setValue(DEFAULT_BATCH_PARALLEL);
+    spinBatchTimeout->setValue(DEFAULT_BATCH_TIMEOUT_MIN);
+    batchGpuSlotsCheckBox->setChecked(DEFAULT_BATCH_GPU_SLOTS);
+    spinLogLimit->setValue(DEFAULT_LOG_LIMIT_MB);
+    compressLogsCheckBox->setChecked(DEFAULT_COMPRESS_LOGS);
     useCpuCheckBox->setChecked(false);
     cudaCheckBox->setChecked(false);
 
@@ -855,9 +1307,24 @@ void MainWindow::onRestoreDefaults()
     settings.setValue("PipVersion", DEFAULT_PIP_VERSION);
     settings.setValue("PipToolsVersion", DEFAULT_PIPTOOLS_VERSION);
     settings.setValue("app/maxItems", DEFAULT_MAX_ITEMS);
+    settings.setValue("app/parallelWorkers", DEFAULT_PARALLEL_WORKERS);
+    settings.setValue("app/matrixRange", DEFAULT_MATRIX_RANGE);
+    settings.setValue("app/downloadTimeout", DEFAULT_DOWNLOAD_TIMEOUT_SEC);
+    settings.setValue("app/useTemplateVenv", DEFAULT_USE_TEMPLATE_VENV);
+    settings.setValue("app/useWheelhouse", DEFAULT_USE_WHEELHOUSE);
+    settings.setValue("app/wheelhouseLimitGb", DEFAULT_WHEELHOUSE_LIMIT_GB);
+    settings.setValue("app/prefetchAhead", DEFAULT_PREFETCH_AHEAD);
+    settings.setValue("app/prefetchRateMb", DEFAULT_PREFETCH_RATE_MB);
+    settings.setValue("app/batchParallel", DEFAULT_BATCH_PARALLEL);
+    settings.setValue("app/batchTimeoutMin", DEFAULT_BATCH_TIMEOUT_MIN);
+    settings.setValue("app/batchGpuSlots", DEFAULT_BATCH_GPU_SLOTS);
+    settings.setValue("app/logLimitMb", DEFAULT_LOG_LIMIT_MB);
+    settings.setValue("app/compressLogs", DEFAULT_COMPRESS_LOGS);
     settings.setValue("AppVersion", DEFAULT_APP_VERSION);
     settings.sync();
 
+    applyLogSettings();
+
     queueStatusMessage(tr("Defaults restored. Python command set to: %1").arg(terminalEngine->pythonCommand()), 5000);
 }
 
@@ -878,8 +1345,23 @@ void MainWindow::saveAppSettings()
     settings.setValue("PipVersion", pipVer);
     settings.setValue("PipToolsVersion", pipToolsVer);
     settings.setValue("app/maxItems", maxItems);
+    settings.setValue("app/parallelWorkers", spinParallelWorkers->value());
+    settings.setValue("app/matrixRange", spinMatrixRange->value());
+    settings.setValue("app/downloadTimeout", spinDownloadTimeout->value());
+    settings.setValue("app/useTemplateVenv", useTemplateVenvCheckBox->isChecked());
+    settings.setValue("app/useWheelhouse", useWheelhouseCheckBox->isChecked());
+    settings.setValue("app/wheelhouseLimitGb", spinWheelhouseLimit->value());
+    settings.setValue("app/prefetchAhead", spinPrefetchAhead->value());
+    settings.setValue("app/prefetchRateMb", spinPrefetchRate->value());
+    settings.setValue("app/batchParallel", spinBatchParallel->value());
+    settings.setValue("app/batchTimeoutMin", spinBatchTimeout->value());
+    settings.setValue("app/batchGpuSlots", batchGpuSlotsCheckBox->isChecked());
+    settings.setValue("app/logLimitMb", spinLogLimit->value());
+    settings.setValue("app/compressLogs", compressLogsCheckBox->isChecked());
     settings.setValue("AppVersion", DEFAULT_APP_VERSION);
     settings.sync();
+    applyBatchSettings();
+    applyLogSettings();
 
     queueStatusMessage(tr("Application settings saved. Python command updated to: %1").arg(terminalEngine->pythonCommand()), 5000);
 }
@@ -916,7 +1398,8 @@ void MainWindow::updateUiFromSettings()
 }
 
 /****************************************************************
- * @brief Writes requirements into a one-column model.
+ * @brief Writes requirements into the model; only rows that differ
+ *        from the current ones are touched.
  ***************************************************************/
 void MainWindow::writeTableToModel(const QStringList &lines)
 {
@@ -924,27 +1407,39 @@ void MainWindow::writeTableToModel(const QStringList &lines)
     {
         return;
     }
+    requirementsModel->setLines(lines);
+    finishRequirementsTable();
+}
+
+/****************************************************************
+ * @brief Empties the requirements table.
+ ***************************************************************/
+void MainWindow::resetRequirementsTable()
+{
     requirementsModel->clear();
-    requirementsModel->setColumnCount(1);
-    requirementsModel->setHorizontalHeaderLabels({tr("requirements.txt")});
-    requirementsView->resizeRowsToContents();
+}
 
-    for (const QString &line : lines)
-    {
-        const QString trimmed = line.trimmed();
-        if (trimmed.isEmpty())
-        {
-            continue;
-        }
-        auto *item = new QStandardItem(trimmed);
-        item->setEditable(false);
-        requirementsModel->appendRow(item);
-    }
-    requirementsView->resizeColumnsToContents();
-    requirementsView->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+/****************************************************************
+ * @brief Appends non-empty lines as rows.
+ ***************************************************************/
+void MainWindow::appendRequirementRows(const QStringList &lines)
+{
+    requirementsModel->appendLines(lines);
+}
+
+/****************************************************************
+ * @brief Sizes the table and splitter once all rows are in.
+ *        The column is sized from the longest line alone rather
+ *        than by measuring every row.
+ ***************************************************************/
+void MainWindow::finishRequirementsTable()
+{
+    const int longest = requirementsModel->longestRow();
+    const QString widest = longest >= 0 ? requirementsModel->row(longest).line : QString();
+    const int textWidth = qMax(requirementsView->fontMetrics().horizontalAdvance(widest),
+                               requirementsView->horizontalHeader()->sectionSizeHint(0));
     requirementsView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-    requirementsView->resizeColumnsToContents();
-    requirementsView->resizeRowsToContents();
+    requirementsView->setColumnWidth(0, textWidth + 16); // cell margins
 
     // Get the actual width of requirementsView and add 66px
     int reqWidth = requirementsView->verticalHeader()->width();
@@ -971,7 +1466,8 @@ void MainWindow::writeTableToModel(const QStringList &lines)
 void MainWindow::appendLog(const QString &line)
 {
     QString time = QDateTime::currentDateTime().toString("HH:mm:ss");
-    logView->appendPlainText(QString("[%1] %2").arg(time, line));
+    logSink->append(QString("[%1] %2").arg(time, line));
+    logWriter->write("app", LogWriter::Level::Info, line);
 }
 
 /****************************************************************
@@ -983,6 +1479,16 @@ void MainWindow::updateProgress(int percent)
     progress->setValue(percent);
 }
 
+/****************************************************************
+ * @brief Shows a search sample under the progress bar; once per
+ *        ResolveProgress interval, never per test.
+ * @param sample The latest sample.
+ ***************************************************************/
+void MainWindow::updateResolveProgress(const ResolveProgress::Sample &sample)
+{
+    progressLabel->setText(ResolveProgress::describe(sample));
+}
+
 /****************************************************************
  * @brief Shows compiled result message path.
  * @param path The compiled output path.
@@ -1105,92 +1611,154 @@ QStringList MainWindow::readTextFileLines(const QString &path)
 /****************************************************************
  * @brief Validates requirements.txt lines.
  ***************************************************************/
-bool MainWindow::validateRequirementsWithErrors(const QStringList &lines, QStringList &errors)
+bool MainWindow::validateRequirementsWithErrors(const QStringList &lines, QStringList &errors, int firstLine)
 {
     errors.clear();
-    bool valid = true;
-    for (const QString &line : lines)
+    for (int i = 0; i < lines.size(); ++i)
     {
-        if (line.isEmpty())
+        const Requirement requirement = Requirement::parse(lines.at(i));
+        if (requirement.kind == Requirement::Kind::Invalid)
         {
-            continue;
+            errors << tr("Line %1: %2 (%3)").arg(firstLine + i).arg(requirement.line, requirement.error);
         }
-        // Example validation: must not start with a dash or space
-        if (line.startsWith('-') || line.startsWith(' '))
-        {
-            errors << tr("Invalid line: %1").arg(line);
-            valid = false;
-        }
-        // Add more validation rules as needed
     }
-    return valid;
+    return errors.isEmpty();
 }
 
 /****************************************************************
- * @brief Downloads text from a URL.
+ * @brief Returns the logs directory path.
  ***************************************************************/
-bool MainWindow::downloadText(const QString &url, QByteArray &out)
+QString MainWindow::logsDir()
 {
-    QNetworkAccessManager manager;
-    QNetworkRequest request{QUrl(url)};
-    QNetworkReply *reply = manager.get(request);
-    QEventLoop loop;
-    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
-    if (reply->error() != QNetworkReply::NoError)
-    {
-        reply->deleteLater();
-        return false;
-    }
-    out = reply->readAll();
-    reply->deleteLater();
-    return true;
+    QString dir = QDir::homePath() + "/PipMatrixResolverLogs";
+    QDir().mkpath(dir);
+    return dir;
 }
 
 /****************************************************************
- * @brief Returns the logs directory path.
+ * @brief Returns the resolver cache directory, next to logsDir().
  ***************************************************************/
-QString MainWindow::logsDir()
+QString MainWindow::cacheDir()
 {
-    QString dir = QDir::homePath() + "/PipMatrixResolverLogs";
+    QString dir = QDir::homePath() + "/PipMatrixResolverCache";
     QDir().mkpath(dir);
     return dir;
 }
 
 /****************************************************************
- * @brief Starts matrix resolution (stub).
+ * @brief Parsed requirements of the table, without comments; the
+ *        rows were parsed when they were loaded.
+ ***************************************************************/
+QVector<Requirement> MainWindow::requirements() const
+{
+    QVector<Requirement> out;
+    for (int row = 0; row < requirementsModel->rowCount(); ++row)
+    {
+        const Requirement &requirement = requirementsModel->row(row).requirement;
+        if (requirement.kind != Requirement::Kind::Blank && requirement.kind != Requirement::Kind::Comment)
+        {
+            out.append(requirement);
+        }
+    }
+    return out;
+}
+
+/****************************************************************
+ * @brief Starts matrix resolution over the loaded requirements.
  ***************************************************************/
 void MainWindow::startResolve()
 {
-    appendLog(tr("Starting matrix resolution..."));
-    // Add your matrix resolution logic here
+    if (resolveSession->isBusy())
+    {
+        appendLog(tr("Matrix resolution is already running"));
+        return;
+    }
+
+    const QVector<Requirement> lines = requirements();
+    if (lines.isEmpty())
+    {
+        QMessageBox::information(this,
+                                 tr("Resolve matrix"),
+                                 tr("Load a requirements file first."));
+        return;
+    }
+
+    // Workers clone the dedicated testing venv, falling back to the main one
+    QString baseVenv = venvTestingPath;
+    if (!VenvManager::isVenv(baseVenv))
+    {
+        baseVenv = terminalEngine->venvPath;
+    }
+    if (!VenvManager::isVenv(baseVenv))
+    {
+        QMessageBox::warning(this,
+                             tr("Resolve matrix"),
+                             tr("No virtual environment found. Use Tools → Create venv."));
+        return;
+    }
+
+    ResolveSession::Options options = resolveOptions();
+    options.baseVenv = baseVenv;
+    // Results are only reused within the same environment
+    options.environment = CompatibilityCache::environmentKey(pythonVersionEdit->text(),
+                                                             osEdit->text(),
+                                                             osReleaseEdit->text(),
+                                                             useCpuCheckBox->isChecked(),
+                                                             cudaCheckBox->isChecked());
+    progress->setValue(0);
+    progressLabel->clear();
+    resolveSession->start(lines, options);
+    refreshStats();
 }
 
 /****************************************************************
- * @brief Pauses matrix resolution (stub).
+ * @brief Resolve settings from the Settings tab.
+ ***************************************************************/
+ResolveSession::Options MainWindow::resolveOptions()
+{
+    ResolveSession::Options options;
+    options.workDir = QDir(logsDir()).filePath("matrix");
+    options.workers = spinParallelWorkers->value();
+    options.matrixRange = spinMatrixRange->value();
+    options.useWheelhouse = useWheelhouseCheckBox->isChecked();
+    options.wheelhouseLimit = qint64(spinWheelhouseLimit->value()) * 1024 * 1024 * 1024;
+    options.prefetchAhead = spinPrefetchAhead->value();
+    options.prefetchRate = qint64(spinPrefetchRate->value()) * 1024 * 1024;
+    return options;
+}
+
+/****************************************************************
+ * @brief Pauses matrix resolution; the running test completes.
  ***************************************************************/
 void MainWindow::pauseResolve()
 {
-    appendLog(tr("Pausing..."));
-    // Add your pause logic here
+    resolveSession->pause();
 }
 
 /****************************************************************
- * @brief Resumes matrix resolution (stub).
+ * @brief Resumes matrix resolution from the paused position.
  ***************************************************************/
 void MainWindow::resumeResolve()
 {
-    appendLog(tr("Resuming..."));
-    // Add your resume logic here
+    if (!resolveSession->isBusy() && resolveSession->checkpoint()->exists())
+    {
+        // Continue a resolve from the checkpoint file, e.g. after a crash or reboot
+        QString error;
+        if (!resolveSession->resumeCheckpoint(resolveOptions(), &error))
+        {
+            QMessageBox::warning(this, tr("Resume matrix"), error);
+        }
+        return;
+    }
+    resolveSession->resume();
 }
 
 /****************************************************************
- * @brief Stops matrix resolution (stub).
+ * @brief Stops matrix resolution and kills the running test.
  ***************************************************************/
 void MainWindow::stopResolve()
 {
-    appendLog(tr("Stopping..."));
-    // Add your stop logic here
+    resolveSession->stop();
 }
 
 /****************************************************************
@@ -1517,71 +2085,46 @@ void MainWindow::restoreCpuCudaSettings()
  ***************************************************************/
 void MainWindow::detectSystem()
 {
-    // GPU detection (simple: check for NVIDIA)
-    bool gpuDetected = false;
     QString os, release, version;
-#if defined(Q_OS_WIN)
-    os = "Windows";
-    release = QSysInfo::productType();
-    version = QSysInfo::productVersion();
-#elif defined(Q_OS_MAC)
-    os = "Mac";
-    release = QSysInfo::productType();
-    version = QSysInfo::productVersion();
-#elif defined(Q_OS_LINUX)
-    os = "Linux";
-    QFile f("/etc/os-release");
-    if (f.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        while (!f.atEnd())
-        {
-            QString line = f.readLine();
-            if (line.startsWith("ID="))
-                release = line.mid(3).trimmed().replace("\"", "");
-            if (line.startsWith("VERSION_ID="))
-                version = line.mid(11).trimmed().replace("\"", "");
-        }
-    }
-#endif
+    SystemProbe::detectOs(&os, &release, &version);
     osEdit->setText(os);
     osReleaseEdit->setText(release);
     osVersionEdit->setText(version);
 
-#if defined(Q_OS_WIN)
-    QProcess proc;
-    proc.start("wmic path win32_VideoController get name");
-    proc.waitForFinished();
-    QString output = proc.readAllStandardOutput();
-    if (output.contains("NVIDIA", Qt::CaseInsensitive))
-        gpuDetected = true;
-#elif defined(Q_OS_LINUX)
-    QProcess proc;
-    proc.start("lspci");
-    proc.waitForFinished();
-    QString output = proc.readAllStandardOutput();
-    if (output.contains("NVIDIA", Qt::CaseInsensitive))
-        gpuDetected = true;
-#elif defined(Q_OS_MAC)
-    QProcess proc;
-    proc.start("system_profiler SPDisplaysDataType");
-    proc.waitForFinished();
-    QString output = proc.readAllStandardOutput();
-    if (output.contains("NVIDIA", Qt::CaseInsensitive))
-        gpuDetected = true;
-#endif
-    if (!gpuDetected)
-    {
-        gpuDetected = detectNvidiaGpu();
-    }
-    gpuDetectedCheckBox->setChecked(gpuDetected);
-
-    // Save to QSettings
+    // Last known GPU state until the probes report
     QSettings s(kOrganizationName, kApplicationName);
     s.setValue("settings/os", os);
     s.setValue("settings/osRelease", release);
     s.setValue("settings/osVersion", version);
-    s.setValue("settings/gpuDetected", gpuDetected);
-    if (gpuDetected)
+    gpuDetectedCheckBox->setChecked(s.value("settings/gpuDetected", false).toBool());
+    gpuCount = s.value("settings/gpuCount", 0).toInt();
+    applyBatchSettings();
+
+    QList<QStringList> warmup;
+    warmup << (QStringList() << TerminalEngine::pythonExe() << TerminalEngine::pythonBaseArgs() << "--version");
+    const QStringList candidates = TerminalEngine::pythonCandidates();
+    for (int i = 0; i < candidates.size(); ++i)
+    {
+        warmup << QStringList{candidates.at(i), "--version"};
+    }
+    systemProbe->start(warmup);
+}
+
+/****************************************************************
+ * @brief Applies the GPU probe results.
+ * @param info What detectSystem()'s probes found.
+ ***************************************************************/
+void MainWindow::onSystemProbed(const SystemInfo &info)
+{
+    gpuDetectedCheckBox->setChecked(info.gpuDetected);
+    gpuCount = info.gpuDetected ? qMax(1, info.gpuCount) : 0;
+    applyBatchSettings();
+
+    // Save to QSettings
+    QSettings s(kOrganizationName, kApplicationName);
+    s.setValue("settings/gpuDetected", info.gpuDetected);
+    s.setValue("settings/gpuCount", gpuCount);
+    if (info.gpuDetected)
     {
         queueStatusMessage(tr("GPU Detected"), 5000);
     }
@@ -1603,36 +2146,51 @@ void MainWindow::onCreateVenv()
         pythonVersion = DEFAULT_PYTHON_VERSION;
     }
 
-    // Get pip and pip-tools versions (currently informational)
+    // Get pip and pip-tools versions pinned into the venv
     QString pipVersion = pipVersionEdit->text().trimmed();
     QString pipToolsVersion = pipToolsVersionEdit->text().trimmed();
-    Q_UNUSED(pipVersion);
-    Q_UNUSED(pipToolsVersion);
+
+    if (terminalEngine->isCreatingVenv())
+    {
+        queueStatusMessage(tr("Virtual environment creation already running"), 3000);
+        return;
+    }
 
     // Set venv path
     QString venvPath = QDir::currentPath() + "/.venv";
     terminalEngine->setVenvPath(venvPath);
+    terminalEngine->setUseTemplate(useTemplateVenvCheckBox->isChecked());
 
     // Switch to terminal tab
     mainTabs->setCurrentWidget(tabTerminal);
 
     // Clear terminal and show progress
-    terminalOutput->clear();
+    terminalSink->clear();
     appendTerminalOutput("=== Creating Virtual Environment ===", false);
     appendTerminalOutput(QString("Python version: %1").arg(pythonVersion), false);
     appendTerminalOutput(QString("Virtual environment path: %1").arg(venvPath), false);
     appendTerminalOutput("", false);
 
-    // UI state during creation
-    QApplication::setOverrideCursor(Qt::WaitCursor);
+    // UI state during creation; Stop cancels it
+    actionCreateVenv->setEnabled(false);
     runCommandBtn->setEnabled(false);
-    stopCommandBtn->setEnabled(false);
+    stopCommandBtn->setEnabled(true);
 
-    bool success = terminalEngine->createVirtualEnvironment(pythonVersion);
+    if (!terminalEngine->createVirtualEnvironment(pythonVersion, pipVersion, pipToolsVersion))
+    {
+        onVenvCreationFinished(false);
+    }
+}
 
+/****************************************************************
+ * @brief Restores the UI and activates the venv once
+ *        createVirtualEnvironment() completes.
+ ***************************************************************/
+void MainWindow::onVenvCreationFinished(bool success)
+{
+    actionCreateVenv->setEnabled(true);
     runCommandBtn->setEnabled(true);
     stopCommandBtn->setEnabled(false);
-    QApplication::restoreOverrideCursor();
 
     int terminalTabIndex = mainTabs->indexOf(tabTerminal);
 
@@ -1691,7 +2249,7 @@ void MainWindow::onRunCommand()
  ***************************************************************/
 void MainWindow::onClearTerminal()
 {
-    terminalOutput->clear();
+    terminalSink->clear();
 }
 
 /****************************************************************
@@ -1708,6 +2266,7 @@ void MainWindow::onStopCommand()
 void MainWindow::onTerminalOutput(const QString &output, bool isError)
 {
     appendTerminalOutput(output, isError);
+    logWriter->write("terminal", isError ? LogWriter::Level::Error : LogWriter::Level::Info, output);
 }
 
 /****************************************************************
@@ -1752,35 +2311,16 @@ void MainWindow::onVenvProgress(const QString &message)
  ***************************************************************/
 void MainWindow::appendTerminalOutput(const QString &text, bool isError)
 {
-    if (text.isEmpty())
-    {
-        terminalOutput->appendPlainText("");
-        return;
-    }
-
-    QTextCursor cursor = terminalOutput->textCursor();
-    cursor.movePosition(QTextCursor::End);
-
-    QTextCharFormat format;
+    OutputSink::Style style = OutputSink::Style::Normal;
     if (isError)
     {
-        format.setForeground(QColor(Qt::red));
+        style = OutputSink::Style::Error;
     }
     else if (text.startsWith("===") || text.startsWith("$"))
     {
-        format.setForeground(QColor(Qt::blue));
-        format.setFontWeight(QFont::Bold);
+        style = OutputSink::Style::Command;
     }
-    else
-    {
-        format.setForeground(QColor(Qt::black));
-    }
-
-    cursor.setCharFormat(format);
-    cursor.insertText(text + "\n");
-
-    terminalOutput->setTextCursor(cursor);
-    terminalOutput->ensureCursorVisible();
+    terminalSink->append(text, style);
 }
 
 /****************************************************************
@@ -1794,70 +2334,32 @@ void MainWindow::setupVenvPaths()
     QString venvTesting = projectRoot + "/.venvs/venv_testing";
     s.setValue("venv/venv_running", venvRunning);
     s.setValue("venv/venv_testing", venvTesting);
+    venvRunningPath = venvRunning;
+    venvTestingPath = venvTesting;
 }
 
 /****************************************************************
- * @brief detect Gpu Via PowerShell.
+ * @brief Hands the batch settings and GPU count to CommandsTab.
  ***************************************************************/
-bool MainWindow::detectGpuViaPowerShell()
+void MainWindow::applyBatchSettings()
 {
-    QProcess proc;
-    proc.start(
-        "powershell",
-        QStringList() << "-Command"
-                      << "Get-WmiObject Win32_VideoController | Select-Object -ExpandProperty Name");
-    proc.waitForFinished();
-    QString output = proc.readAllStandardOutput();
-    return output.contains("NVIDIA", Qt::CaseInsensitive);
-}
-
-/****************************************************************
- * @brief detect Gpu Via DxDiag.
- ***************************************************************/
-bool MainWindow::detectGpuViaDxDiag()
-{
-    QProcess proc;
-    proc.start("cmd", QStringList() << "/c" << "dxdiag /t dxdiag.txt");
-    proc.waitForFinished();
-    QFile file("dxdiag.txt");
-    bool found = false;
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        QString dxdiagOutput = file.readAll();
-        found = dxdiagOutput.contains("NVIDIA", Qt::CaseInsensitive);
-        file.remove(); // Clean up
-    }
-    return found;
+    commandsTab->setBatchOptions(spinBatchParallel->value(),
+                                 spinBatchTimeout->value() * 60 * 1000,
+                                 batchGpuSlotsCheckBox->isChecked() ? gpuCount : 0);
 }
 
-/****************************************************************
- * @brief detect Gpu Via Nvidia Smi.
- ***************************************************************/
-bool MainWindow::detectGpuViaNvidiaSmi()
+void MainWindow::applyLogSettings()
 {
-    QProcess proc;
-    proc.start("nvidia-smi");
-    proc.waitForFinished();
-    QString output = proc.readAllStandardOutput();
-    return output.contains("NVIDIA", Qt::CaseInsensitive);
+    logWriter->setMaxBytes(qint64(spinLogLimit->value()) * 1024 * 1024);
+    logWriter->setCompressRotated(compressLogsCheckBox->isChecked());
 }
 
 /****************************************************************
- * @brief detect Nvidia Gpu.
+ * @brief Venv the Package Manager tab works on.
  ***************************************************************/
-bool MainWindow::detectNvidiaGpu()
+QString MainWindow::packageVenvPath() const
 {
-    // Primary test: PowerShell WMI
-    if (detectGpuViaPowerShell())
-        return true;
-    // Fallback 1: dxdiag
-    if (detectGpuViaDxDiag())
-        return true;
-    // Fallback 2: nvidia-smi
-    if (detectGpuViaNvidiaSmi())
-        return true;
-    // Not detected
-    return false;
+    return QDir::current().filePath("venv_running");
 }
 
 /****************************************************************
@@ -1871,22 +2373,58 @@ void MainWindow::onSearchPackage()
         packageOutput->appendPlainText("Enter a package name to search.");
         return;
     }
-    QProcess process;
-    QString venvPython;
-#if defined(Q_OS_WIN)
-    venvPython = QDir::current().filePath("venv_running/Scripts/python.exe");
-#else
-    venvPython = QDir::current().filePath("venv_running/bin/python");
-#endif
-    QStringList args = {"-m", "pip", "search", pkg};
-    process.start(venvPython, args);
-    process.waitForFinished();
-    QString output = process.readAllStandardOutput();
-    QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-    for (int i = 0; i < lines.size(); ++i)
+    openPackageIndex();
+    if (!packageIndex->isLoaded())
+    {
+        packageOutput->appendPlainText(tr("The package index is not downloaded yet."));
+        return;
+    }
+    const QStringList matches = packageIndex->search(pkg, PACKAGE_SEARCH_RESULTS);
+    if (matches.isEmpty())
+    {
+        packageOutput->appendPlainText(tr("No project matches %1.").arg(pkg));
+        return;
+    }
+    packageOutput->appendPlainText(tr("Projects matching %1:").arg(pkg));
+    for (int i = 0; i < matches.size(); ++i)
     {
-        installedPackagesList->addItem(lines.at(i));
+        packageOutput->appendPlainText("  " + matches.at(i));
     }
+    // An exact name also gets the versions the index offers
+    if (matches.first() == QString::fromLatin1(PackageIndex::normalize(pkg.toUtf8())))
+    {
+        packageManager->setVenv(packageVenvPath());
+        packageManager->search(matches.first());
+    }
+}
+
+/****************************************************************
+ * @brief Loads the local PyPI name index once; it refreshes
+ *        itself in the background when older than a day.
+ ***************************************************************/
+void MainWindow::openPackageIndex()
+{
+    if (packageIndexOpened)
+    {
+        return;
+    }
+    packageIndexOpened = true;
+    packageIndex->open(QDir(cacheDir()).filePath("pypi-names.idx"), PACKAGE_INDEX_MAX_AGE_SECS);
+}
+
+/****************************************************************
+ * @brief Shows the best index matches for the typed name.
+ ***************************************************************/
+void MainWindow::updatePackageCompletions()
+{
+    const QString text = packageNameInput->text().trimmed();
+    if (text.isEmpty() || !packageIndex->isLoaded())
+    {
+        packageCompletions->setStringList(QStringList());
+        return;
+    }
+    packageCompletions->setStringList(packageIndex->search(text, PACKAGE_SEARCH_RESULTS));
+    packageCompleter->complete();
 }
 
 /****************************************************************
@@ -1911,22 +2449,9 @@ void MainWindow::onInstallPackage()
         packageOutput->appendPlainText("Enter a package name to install.");
         return;
     }
-    QProcess process;
-    QString venvPython;
-#if defined(Q_OS_WIN)
-    venvPython = QDir::current().filePath("venv_running/Scripts/python.exe");
-#else
-    venvPython = QDir::current().filePath("venv_running/bin/python");
-#endif
-    QStringList args = {"-m", "pip", "install", pkg};
-    process.start(venvPython, args);
-    process.waitForFinished();
-    QString output = process.readAllStandardOutput();
-    QString error = process.readAllStandardError();
-    if (!output.isEmpty())
-        packageOutput->appendPlainText(output);
-    if (!error.isEmpty())
-        packageOutput->appendPlainText("[ERROR] " + error);
+    packageOutput->appendPlainText(tr("Installing %1...").arg(pkg));
+    packageManager->setVenv(packageVenvPath());
+    packageManager->install(pkg);
 }
 
 /****************************************************************
@@ -1940,45 +2465,44 @@ void MainWindow::onUninstallPackage()
         packageOutput->appendPlainText("Enter a package name to uninstall.");
         return;
     }
-    QProcess process;
-    QString venvPython;
-#if defined(Q_OS_WIN)
-    venvPython = QDir::current().filePath("venv_running/Scripts/python.exe");
-#else
-    venvPython = QDir::current().filePath("venv_running/bin/python");
-#endif
-    QStringList args = {"-m", "pip", "uninstall", "-y", pkg};
-    process.start(venvPython, args);
-    process.waitForFinished();
-    QString output = process.readAllStandardOutput();
-    QString error = process.readAllStandardError();
-    if (!output.isEmpty())
-        packageOutput->appendPlainText(output);
-    if (!error.isEmpty())
-        packageOutput->appendPlainText("[ERROR] " + error);
+    packageOutput->appendPlainText(tr("Uninstalling %1...").arg(pkg));
+    packageManager->setVenv(packageVenvPath());
+    packageManager->uninstall(pkg);
 }
 
 /****************************************************************
  * @brief Refreshes the list of installed packages in venv.
+ *        The list is filled by onInstalledPackagesChanged().
  ***************************************************************/
 void MainWindow::refreshInstalledPackages()
+{
+    packageManager->setVenv(packageVenvPath());
+    packageManager->refresh();
+}
+
+/****************************************************************
+ * @brief Shows the packages read from site-packages.
+ ***************************************************************/
+void MainWindow::onInstalledPackagesChanged(const QVector<InstalledPackage> &packages)
 {
     installedPackagesList->clear();
-    QProcess process;
-    QString venvPython;
-#if defined(Q_OS_WIN)
-    venvPython = QDir::current().filePath("venv_running/Scripts/python.exe");
-#else
-    venvPython = QDir::current().filePath("venv_running/bin/python");
-#endif
-    QStringList args = {"-m", "pip", "list", "--format=freeze"};
-    process.start(venvPython, args);
-    process.waitForFinished();
-    QString output = process.readAllStandardOutput();
-    QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-    for (int i = 0; i < lines.size(); ++i)
+    for (int i = 0; i < packages.size(); ++i)
     {
-        installedPackagesList->addItem(lines.at(i));
+        installedPackagesList->addItem(packages.at(i).name + "==" + packages.at(i).version);
+    }
+}
+
+/****************************************************************
+ * @brief Reports the end of a pip job.
+ ***************************************************************/
+void MainWindow::onPackageJobFinished(PackageManager::Operation operation,
+                                      const QString &argument,
+                                      bool ok)
+{
+    Q_UNUSED(operation);
+    if (!ok)
+    {
+        packageOutput->appendPlainText(tr("[ERROR] pip failed for %1").arg(argument));
     }
 }
 
@@ -2037,4 +2561,107 @@ void MainWindow::showNextStatusMessage()
     }
 }
 
+/****************************************************************
+ * @brief Shows the run's counters and per-phase totals.
+ ***************************************************************/
+void MainWindow::refreshStats()
+{
+    if (!tabStats->isVisible() && statsModel->rowCount() > 0)
+    {
+        return; // cheap to skip while nobody looks
+    }
+    const Telemetry::Snapshot snap = Telemetry::snapshot();
+    QStringList counters;
+    for (int c = 0; c < int(Telemetry::Counter::Count); ++c)
+    {
+        const Telemetry::Counter counter = Telemetry::Counter(c);
+        const qint64 value = snap.counters[c];
+        counters << tr("%1: %2").arg(Telemetry::counterName(counter),
+                                     counter == Telemetry::Counter::BytesDownloaded
+                                         ? QLocale().formattedDataSize(value)
+                                         : QLocale().toString(value));
+    }
+    QString summary = tr("Run time %1 s. %2.").arg(snap.elapsedUs / 1000000).arg(counters.join(", "));
+    if (snap.dropped > 0)
+    {
+        summary += tr(" The trace is full; %1 spans were not kept.").arg(snap.dropped);
+    }
+    statsSummaryLabel->setText(summary);
+
+    statsModel->setRowCount(int(snap.phases.size()));
+    for (int i = 0; i < snap.phases.size(); ++i)
+    {
+        const Telemetry::Phase &phase = snap.phases.at(i);
+        const QStringList cells = {
+            phase.name,
+            QString::number(phase.count),
+            QString::number(phase.failed),
+            QString::number(phase.active),
+            QString::number(phase.totalUs / 1e6, 'f', 2),
+            phase.count > 0 ? QString::number(phase.totalUs / 1e3 / phase.count, 'f', 1) : QString(),
+            QString::number(phase.maxUs / 1e3, 'f', 1)};
+        for (int column = 0; column < cells.size(); ++column)
+        {
+            QStandardItem *item = statsModel->item(i, column);
+            if (!item)
+            {
+                item = new QStandardItem();
+                if (column > 0)
+                {
+                    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                }
+                statsModel->setItem(i, column, item);
+            }
+            item->setText(cells.at(column));
+        }
+    }
+}
+
+/****************************************************************
+ * @brief Export trace button: writes the run to a chosen file.
+ ***************************************************************/
+void MainWindow::onExportTrace()
+{
+    const QString suggested = QDir(logsDir()).filePath(
+        QString("trace-%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+    const QString path = QFileDialog::getSaveFileName(this, tr("Export trace"), suggested,
+                                                      tr("Trace files (*.json)"));
+    if (path.isEmpty())
+    {
+        return;
+    }
+    QString error;
+    if (!Telemetry::exportTrace(path, &error))
+    {
+        QMessageBox::warning(this, tr("Export trace"), tr("Cannot write %1: %2").arg(path, error));
+        return;
+    }
+    queueStatusMessage(tr("Trace saved to %1").arg(path), 5000);
+}
+
+void MainWindow::onResetStats()
+{
+    Telemetry::reset();
+    refreshStats();
+}
+
+/****************************************************************
+ * @brief Keeps a trace of every finished resolve in logsDir().
+ ***************************************************************/
+void MainWindow::saveRunTrace()
+{
+    const QString path = QDir(logsDir()).filePath(
+        QString("trace-%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+    QString error;
+    if (Telemetry::exportTrace(path, &error))
+    {
+        appendLog(tr("Run trace: %1").arg(path));
+    }
+    else
+    {
+        appendLog(tr("Cannot write run trace %1: %2").arg(path, error));
+    }
+    refreshStats();
+}
+
 /************** End of MainWindow.cpp ***************************/
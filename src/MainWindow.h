@@ -47,8 +47,22 @@
 #include <QLineEdit>
 #include <QSpinBox>
 #include <QListWidget>
+#include <QLabel>
+#include <QCompleter>
+#include <QStringListModel>
+#include <QNetworkReply>
 #include "CommandsTab.h"
 #include "TerminalEngine.h"
+#include "ResolveSession.h"
+#include "VenvManager.h"
+#include "OutputSink.h"
+#include "PackageManager.h"
+#include "PackageIndex.h"
+#include "SystemProbe.h"
+#include "RequirementsModel.h"
+#include "MatrixModel.h"
+#include "Telemetry.h"
+#include "LogWriter.h"
 
 /****************************************************************
  * @class MainWindow
@@ -86,8 +100,10 @@ private slots:
     void pauseResolve();
     void resumeResolve();
     void stopResolve();
+    void cancelUrlLoad();
     void appendLog(const QString &line);
     void updateProgress(int percent);
+    void updateResolveProgress(const ResolveProgress::Sample &sample);
     void showCompiledResult(const QString &path);
     void showAboutBox();
     void showReadmeDialog();
@@ -123,20 +139,38 @@ private slots:
 
     void refreshInstalledPackages();
     void onInstalledPackagesListDoubleClicked(const QModelIndex &index);
+    void onInstalledPackagesChanged(const QVector<InstalledPackage> &packages);
+    void onPackageJobFinished(PackageManager::Operation operation, const QString &argument, bool ok);
 
     // Terminal engine slots
     void onTerminalOutput(const QString &output, bool isError);
     void onTerminalCommandStarted(const QString &command);
     void onTerminalCommandFinished(int exitCode, QProcess::ExitStatus exitStatus);
     void onVenvProgress(const QString &message);
+    void onVenvCreationFinished(bool success);
     //void onVenvStatusChanged(bool active);
 
     void onPythonVersionChanged(const QString &newVersion);
 
+    // Stats tab
+    void refreshStats();
+    void onExportTrace();
+    void onResetStats();
+
 private:
     void setupUi();
     void loadRequirementsFromFile(const QString &path);
     void loadRequirementsFromUrl(const QString &url);
+    void onUrlReadyRead();
+    void onUrlFinished();
+    /****************************************************************
+     * @brief Validates and appends the complete lines received so far.
+     * @param flush true at end of download: the partial tail is a line.
+     ***************************************************************/
+    void consumeUrlLines(bool flush);
+    void resetRequirementsTable();
+    void appendRequirementRows(const QStringList &lines);
+    void finishRequirementsTable();
     void saveHistory();
     void loadHistory();
     /****************************************************************
@@ -150,25 +184,39 @@ private:
     ***************************************************************/
     void checkAndRestoreSettings();
 
-    bool detectGpuViaPowerShell();
-    bool detectNvidiaGpu();
-    bool detectGpuViaNvidiaSmi();
-    bool detectGpuViaDxDiag();
+    /****************************************************************
+    * @brief Hands the batch settings and GPU count to CommandsTab.
+    ***************************************************************/
+    void applyBatchSettings();
+    /****************************************************************
+    * @brief Hands the log size limit and compression to logWriter.
+    ***************************************************************/
+    void applyLogSettings();
     /****************************************************************
     * @brief Saves all settings from the Settings tab to QSettings.
     ***************************************************************/
     void saveSettings();
     // Startup/system functions
     void detectSystem();
+    void onSystemProbed(const SystemInfo &info);
     void restoreCpuCudaSettings();
     void setupVenvPaths();
 
     // Utility functions moved from MatrixUtility
     QStringList readTextFileLines(const QString &path);
-    bool validateRequirementsWithErrors(const QStringList &lines, QStringList &errors);
+    /****************************************************************
+     * @brief Parses each line; Invalid lines are reported as errors.
+     * @param firstLine Number of lines[0], for the messages.
+     ***************************************************************/
+    bool validateRequirementsWithErrors(const QStringList &lines, QStringList &errors, int firstLine = 1);
     QString normalizeRawUrl(const QString &inputUrl);
-    bool downloadText(const QString &url, QByteArray &out);
     QString logsDir();
+    QString cacheDir();
+    /****************************************************************
+     * @brief Parsed requirements of the table, without comments.
+     ***************************************************************/
+    QVector<Requirement> requirements() const;
+    ResolveSession::Options resolveOptions();
     void appendTerminalOutput(const QString &text, bool isError);
     void refreshPythonVersionUI();
     void showNextStatusMessage();
@@ -192,6 +240,7 @@ private:
     // Actions
     QAction *actionOpenRequirements;
     QAction *actionFetchRequirements;
+    QAction *actionCancelDownload;
     QAction *actionExit;
     QAction *actionCreateVenv;
     QAction *actionResolveMatrix;
@@ -206,11 +255,15 @@ private:
     QWidget *tabMain;
     QSplitter *splitter;
     QSplitter *bottomSplitter;
-    QStandardItemModel *requirementsModel;
+    RequirementsModel *requirementsModel;
     QTableView *requirementsView;
     QTableView *matrixView;
+    MatrixModel *matrixModel = nullptr;   ///< created after resolveSession
     QPlainTextEdit *logView;
+    OutputSink *logSink;
+    QWidget *progressPanel;
     QProgressBar *progress;
+    QLabel *progressLabel;            ///< throughput, workers and ETA
 
     // Tab: History
     QWidget *tabHistory;
@@ -232,6 +285,7 @@ private:
     // Tab: Terminal
     QWidget *tabTerminal;
     QPlainTextEdit *terminalOutput;
+    OutputSink *terminalSink;
     QLineEdit *commandInput;
     QPushButton *runCommandBtn;
     QPushButton *clearTerminalBtn;
@@ -256,6 +310,19 @@ private:
     QLineEdit *pipVersionEdit;
     QLineEdit *pipToolsVersionEdit;
     QSpinBox *spinMaxItems;
+    QSpinBox *spinParallelWorkers;
+    QSpinBox *spinMatrixRange;
+    QSpinBox *spinDownloadTimeout;
+    QCheckBox *useTemplateVenvCheckBox;
+    QCheckBox *useWheelhouseCheckBox;
+    QSpinBox *spinWheelhouseLimit;
+    QSpinBox *spinPrefetchAhead;
+    QSpinBox *spinPrefetchRate;
+    QSpinBox *spinBatchParallel;
+    QSpinBox *spinBatchTimeout;
+    QCheckBox *batchGpuSlotsCheckBox;
+    QSpinBox *spinLogLimit;
+    QCheckBox *compressLogsCheckBox;
     QCheckBox *gpuDetectedCheckBox;
     QCheckBox *useCpuCheckBox;
     QCheckBox *cudaCheckBox;
@@ -266,6 +333,16 @@ private:
     QPushButton *restoreDefaultsButton;
     QDialogButtonBox *buttonBoxPreferences;
 
+    // Tab: Stats
+    QWidget *tabStats;
+    QLabel *statsSummaryLabel;
+    QTableView *statsTable;
+    QStandardItemModel *statsModel;
+    QPushButton *exportTraceBtn;
+    QPushButton *resetStatsBtn;
+    QTimer statsTimer;
+    void saveRunTrace();
+
     QMenu *recentLocalMenu;
     QMenu *recentWebMenu;
 
@@ -276,8 +353,34 @@ private:
     // Terminal engine
     TerminalEngine *terminalEngine;
 
+    // Matrix resolver
+    ResolveSession *resolveSession;
+
+    // Package Manager tab
+    PackageManager *packageManager;
+    QString packageVenvPath() const;
+    PackageIndex *packageIndex;
+    bool packageIndexOpened = false;
+    QCompleter *packageCompleter = nullptr;
+    QStringListModel *packageCompletions = nullptr;
+    QTimer packageSearchTimer;
+    void openPackageIndex();
+    void updatePackageCompletions();
+
+    // Streaming URL load
+    QNetworkReply *urlReply = nullptr;
+    QString urlLoading;
+    QByteArray urlBuffer;
+    QStringList urlErrors;
+    int urlLinesSeen = 0;
+    QStringList urlPreviousLines;
+    bool urlCancelled = false;
+
     // Settings
     int maxHistoryItems; // -1=unlimited, 0 invalid, ≥1 valid
+    int gpuCount = 0;    // NVIDIA GPUs found by detectSystem()
+    SystemProbe *systemProbe;
+    LogWriter *logWriter;
     QStringList statusQueue;
     QTimer statusTimer;
 
@@ -0,0 +1,239 @@
+/****************************************************************
+ * @file MatrixModel.cpp
+ * @brief Implements the MatrixModel class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of MatrixModel. Results
+ * arrive far faster than anyone can read them, so the model polls
+ * the engine's state revision a few times a second and announces
+ * one dataChanged() for the whole grid; the view only repaints the
+ * rows it shows.
+ ***************************************************************/
+#include "MatrixModel.h"
+#include <QColor>
+#include <limits>
+
+static const int kRefreshIntervalMs = 250;
+static const quint64 kWeightCap = quint64(1) << 62;
+
+MatrixModel::MatrixModel(ResolverEngine *engine, QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_engine(engine)
+{
+    m_refreshTimer.setInterval(kRefreshIntervalMs);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &MatrixModel::onRefreshTimer);
+}
+
+int MatrixModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows;
+}
+
+int MatrixModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_radix.size());
+}
+
+/****************************************************************
+ * @brief Computes a cell from the row number and the engine.
+ ***************************************************************/
+QVariant MatrixModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows || index.column() >= m_radix.size() || !matchesEngine())
+    {
+        return QVariant();
+    }
+    if (role == Qt::DisplayRole)
+    {
+        const int column = index.column();
+        const int version = int((quint64(index.row()) / m_weight.at(column)) % quint64(m_radix.at(column)));
+        const QString text = m_engine->candidates().at(column).versions.value(version);
+        return text.isEmpty() ? tr("(any)") : text;
+    }
+    if (role == Qt::BackgroundRole || role == Qt::ToolTipRole)
+    {
+        const ResolverEngine::CombinationState state = stateAt(index.row());
+        if (role == Qt::ToolTipRole)
+        {
+            switch (state)
+            {
+            case ResolverEngine::CombinationState::Pending:
+                return tr("Pending");
+            case ResolverEngine::CombinationState::Testing:
+                return tr("Compiling");
+            case ResolverEngine::CombinationState::Passed:
+                return tr("Compiled");
+            case ResolverEngine::CombinationState::Failed:
+                return tr("Failed");
+            case ResolverEngine::CombinationState::Pruned:
+                return tr("Skipped: contains a known conflict");
+            }
+            return QVariant();
+        }
+        switch (state)
+        {
+        case ResolverEngine::CombinationState::Pending:
+            return QVariant();
+        case ResolverEngine::CombinationState::Testing:
+            return QColor(255, 236, 179);
+        case ResolverEngine::CombinationState::Passed:
+            return QColor(200, 230, 201);
+        case ResolverEngine::CombinationState::Failed:
+            return QColor(255, 205, 210);
+        case ResolverEngine::CombinationState::Pruned:
+            return QColor(224, 224, 224);
+        }
+    }
+    return QVariant();
+}
+
+QVariant MatrixModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && section < m_radix.size() && matchesEngine())
+    {
+        const PackageCandidates &package = m_engine->candidates().at(section);
+        if (role == Qt::DisplayRole)
+        {
+            return package.name;
+        }
+        if (role == Qt::ToolTipRole)
+        {
+            return tr("%1: %2 candidates\n%3 combinations")
+                .arg(package.name)
+                .arg(m_radix.at(section))
+                .arg(m_total, 0, 'g', 6);
+        }
+        return QVariant();
+    }
+    if (orientation == Qt::Vertical && role == Qt::DisplayRole)
+    {
+        return section + 1;
+    }
+    return QVariant();
+}
+
+/****************************************************************
+ * @brief Re-reads the candidate matrix from the engine.
+ ***************************************************************/
+void MatrixModel::reload()
+{
+    beginResetModel();
+    const QVector<PackageCandidates> &packages = m_engine->candidates();
+    const int n = int(packages.size());
+    m_radix.resize(n);
+    m_weight.resize(n);
+    quint64 weight = 1;
+    m_total = n > 0 ? 1.0 : 0.0;
+    for (int i = n - 1; i >= 0; --i)
+    {
+        m_radix[i] = qMax(1, int(packages.at(i).versions.size()));
+        m_weight[i] = weight;
+        weight = weight > kWeightCap / quint64(m_radix.at(i)) ? kWeightCap : weight * quint64(m_radix.at(i));
+        m_total *= m_radix.at(i);
+    }
+    m_rows = n == 0 ? 0 : int(qMin<quint64>(weight, quint64(std::numeric_limits<int>::max())));
+    m_cachedRow = -1;
+    m_shownRevision = m_engine->stateRevision();
+    endResetModel();
+
+    if (m_rows > 0)
+    {
+        m_refreshTimer.start();
+    }
+    else
+    {
+        m_refreshTimer.stop();
+    }
+}
+
+QVector<int> MatrixModel::versionsAt(int row) const
+{
+    QVector<int> versions(m_radix.size());
+    for (int i = 0; i < m_radix.size(); ++i)
+    {
+        versions[i] = int((quint64(row) / m_weight.at(i)) % quint64(m_radix.at(i)));
+    }
+    return versions;
+}
+
+int MatrixModel::rowOf(const QVector<int> &versions) const
+{
+    if (versions.size() != m_radix.size())
+    {
+        return -1;
+    }
+    quint64 row = 0;
+    for (int i = 0; i < versions.size(); ++i)
+    {
+        if (versions.at(i) > 0 && m_weight.at(i) >= quint64(m_rows))
+        {
+            return -1;
+        }
+        row += quint64(versions.at(i)) * m_weight.at(i);
+    }
+    return row < quint64(m_rows) ? int(row) : -1;
+}
+
+ResolverEngine::CombinationState MatrixModel::stateAt(int row) const
+{
+    const quint64 revision = m_engine->stateRevision();
+    if (row != m_cachedRow || revision != m_cachedRevision)
+    {
+        m_cachedState = m_engine->combinationState(versionsAt(row));
+        m_cachedRow = row;
+        m_cachedRevision = revision;
+    }
+    return m_cachedState;
+}
+
+/****************************************************************
+ * @brief False once the engine got a different matrix than the
+ *        one the rows were laid out for.
+ ***************************************************************/
+bool MatrixModel::matchesEngine() const
+{
+    const QVector<PackageCandidates> &packages = m_engine->candidates();
+    if (packages.size() != m_radix.size())
+    {
+        return false;
+    }
+    for (int i = 0; i < packages.size(); ++i)
+    {
+        if (qMax(1, int(packages.at(i).versions.size())) != m_radix.at(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+double MatrixModel::totalCombinations() const
+{
+    return m_total;
+}
+
+/****************************************************************
+ * @brief Repaints the grid when the search state moved on.
+ ***************************************************************/
+void MatrixModel::onRefreshTimer()
+{
+    if (!matchesEngine())
+    {
+        reload();
+        return;
+    }
+    const quint64 revision = m_engine->stateRevision();
+    if (revision == m_shownRevision || m_rows == 0)
+    {
+        return;
+    }
+    m_shownRevision = revision;
+    emit dataChanged(index(0, 0), index(m_rows - 1, int(m_radix.size()) - 1),
+                     {Qt::BackgroundRole, Qt::ToolTipRole});
+}
+
+/************** End of MatrixModel.cpp **************************/
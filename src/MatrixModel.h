@@ -0,0 +1,95 @@
+/****************************************************************
+ * @file MatrixModel.h
+ * @brief Declares the MatrixModel class for the candidate grid.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines MatrixModel, a read-only table model over the
+ * resolver's combination space: one column per package, one row
+ * per combination, in the order the odometer visits them (the
+ * first package is the most significant digit).
+ *
+ * Nothing is stored per row. A row number is decoded into version
+ * indices on demand and classified by ResolverEngine, so the view
+ * scrolls over millions of combinations while only the visible
+ * rows are ever computed. Rows are capped at INT_MAX, the item
+ * model limit; the header tooltip shows the real total.
+ ***************************************************************/
+#ifndef MATRIXMODEL_H
+#define MATRIXMODEL_H
+
+#include <QAbstractTableModel>
+#include <QTimer>
+#include <QVector>
+#include "ResolverEngine.h"
+
+/****************************************************************
+ * @class MatrixModel
+ * @brief Virtual model of the candidate matrix.
+ ***************************************************************/
+class MatrixModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************
+     * @brief Constructor.
+     * @param engine Source of candidates and results. Not owned.
+     ***************************************************************/
+    explicit MatrixModel(ResolverEngine *engine, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    /****************************************************************
+     * @brief Re-reads the candidate matrix; call after the engine's
+     *        candidates are replaced or restored.
+     ***************************************************************/
+    void reload();
+
+    /****************************************************************
+     * @brief Version index per package of a row.
+     ***************************************************************/
+    QVector<int> versionsAt(int row) const;
+
+    /****************************************************************
+     * @brief Row of a combination, -1 if it is past the row cap.
+     ***************************************************************/
+    int rowOf(const QVector<int> &versions) const;
+
+    ResolverEngine::CombinationState stateAt(int row) const;
+
+    /****************************************************************
+     * @brief Size of the combination space, uncapped.
+     ***************************************************************/
+    double totalCombinations() const;
+
+private slots:
+    void onRefreshTimer();
+
+private:
+    bool matchesEngine() const;
+
+    ResolverEngine *m_engine;
+    QVector<int> m_radix;            ///< candidates per package
+    QVector<quint64> m_weight;       ///< combinations per step of each package
+    int m_rows = 0;
+    double m_total = 0.0;
+
+    // Painting walks a row's cells in turn; remember the last row
+    mutable int m_cachedRow = -1;
+    mutable quint64 m_cachedRevision = 0;
+    mutable ResolverEngine::CombinationState m_cachedState = ResolverEngine::CombinationState::Pending;
+
+    QTimer m_refreshTimer;
+    quint64 m_shownRevision = 0;
+};
+
+#endif // MATRIXMODEL_H
+/************** End of MatrixModel.h ****************************/
@@ -0,0 +1,807 @@
+/****************************************************************
+ * @file MetadataStore.cpp
+ * @brief Implements the MetadataStore class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of MetadataStore. open()
+ * checks every index of the file once (integer compares over the
+ * mapped records, no allocation), so lookups can trust them.
+ ***************************************************************/
+#include "MetadataStore.h"
+#include <QByteArrayView>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const quint32 kMagic = 0x4D524D50; ///< "PMRM" read as a little-endian quint32
+static const quint32 kNone = 0xFFFFFFFFu;  ///< no string
+static const quint16 kRequiresKnown = 0x0001;
+
+/****************************************************************
+ * @struct FileHeader
+ * @brief Start of the file; the sections follow in this order.
+ ***************************************************************/
+struct FileHeader
+{
+    quint32 magic;
+    quint32 format;
+    quint32 projects;
+    quint32 versions;
+    quint32 components;
+    quint32 edges;
+    quint32 strings;
+    quint32 blobBytes;
+};
+
+struct ProjectRecord
+{
+    quint32 name;
+    quint32 etag;
+    qint64 checked;
+    quint32 firstVersion;
+    quint32 versionCount;
+};
+
+struct VersionRecord
+{
+    quint32 firstComponent;
+    quint16 componentCount;
+    quint16 flags;
+    quint32 firstEdge;
+    quint32 edgeCount;
+    quint32 text;                ///< kNone unless the numbers lose it
+    quint32 reserved;
+};
+
+static_assert(sizeof(FileHeader) == 32, "MetadataStore header layout");
+static_assert(sizeof(ProjectRecord) == 24, "MetadataStore project layout");
+static_assert(sizeof(VersionRecord) == 24, "MetadataStore version layout");
+
+/****************************************************************
+ * @struct Layout
+ * @brief Byte offsets of the sections, from the header counts.
+ ***************************************************************/
+struct Layout
+{
+    qint64 projects = 0;
+    qint64 versions = 0;
+    qint64 components = 0;
+    qint64 edges = 0;
+    qint64 offsets = 0;
+    qint64 blob = 0;
+    qint64 end = 0;
+};
+
+static qint64 align8(qint64 bytes)
+{
+    return (bytes + 7) & ~qint64(7);
+}
+
+static Layout layoutOf(const FileHeader &header)
+{
+    Layout layout;
+    layout.projects = sizeof(FileHeader);
+    layout.versions = align8(layout.projects + qint64(header.projects) * sizeof(ProjectRecord));
+    layout.components = align8(layout.versions + qint64(header.versions) * sizeof(VersionRecord));
+    layout.edges = align8(layout.components + qint64(header.components) * sizeof(quint32));
+    layout.offsets = align8(layout.edges + qint64(header.edges) * sizeof(quint32));
+    layout.blob = align8(layout.offsets + (qint64(header.strings) + 1) * sizeof(quint32));
+    layout.end = layout.blob + header.blobBytes;
+    return layout;
+}
+
+template <typename T>
+static const T *section(const uchar *map, qint64 offset)
+{
+    return reinterpret_cast<const T *>(map + offset);
+}
+
+static int compareComponents(const quint32 *a, int na, const quint32 *b, int nb)
+{
+    const int n = qMax(na, nb);
+    for (int i = 0; i < n; ++i)
+    {
+        const quint32 x = i < na ? a[i] : 0;
+        const quint32 y = i < nb ? b[i] : 0;
+        if (x != y)
+        {
+            return x < y ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static int compareBytes(QByteArrayView a, QByteArrayView b)
+{
+    const int c = std::memcmp(a.data(), b.data(), size_t(qMin(a.size(), b.size())));
+    if (c != 0)
+    {
+        return c;
+    }
+    return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+}
+
+static QString joinComponents(const quint32 *components, int count)
+{
+    QString text;
+    for (int i = 0; i < count; ++i)
+    {
+        if (i > 0)
+        {
+            text += '.';
+        }
+        text += QString::number(components[i]);
+    }
+    return text;
+}
+
+MetadataStore::MetadataStore() = default;
+
+MetadataStore::~MetadataStore()
+{
+    close();
+}
+
+/****************************************************************
+ * @brief Maps the store file.
+ ***************************************************************/
+bool MetadataStore::open(const QString &path)
+{
+    close();
+    m_overlay.clear();
+    m_dirty = false;
+    m_path = path;
+    if (m_path.isEmpty())
+    {
+        return false;
+    }
+    m_file.setFileName(m_path);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    m_size = m_file.size();
+    if (m_size >= qint64(sizeof(FileHeader)))
+    {
+        m_map = m_file.map(0, m_size);
+    }
+    if (!m_map || !validate())
+    {
+        qWarning() << "Ignoring invalid metadata store" << m_path;
+        close();
+        return false;
+    }
+    DEBUG_MSG() << "metadata store" << m_path << projectCount() << "projects," << m_size << "bytes";
+    return true;
+}
+
+void MetadataStore::close()
+{
+    if (m_map)
+    {
+        m_file.unmap(const_cast<uchar *>(m_map));
+        m_map = nullptr;
+    }
+    m_file.close();
+    m_size = 0;
+}
+
+QString MetadataStore::path() const
+{
+    return m_path;
+}
+
+bool MetadataStore::isMapped() const
+{
+    return m_map != nullptr;
+}
+
+int MetadataStore::projectCount() const
+{
+    int count = int(m_overlay.size());
+    if (m_map)
+    {
+        const FileHeader &header = *section<FileHeader>(m_map, 0);
+        const ProjectRecord *projects = section<ProjectRecord>(m_map, layoutOf(header).projects);
+        for (quint32 i = 0; i < header.projects; ++i)
+        {
+            if (!m_overlay.contains(string(projects[i].name)))
+            {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+bool MetadataStore::contains(const QString &project) const
+{
+    return m_overlay.contains(project) || findMapped(project) >= 0;
+}
+
+/****************************************************************
+ * @brief Stored releases, from the overlay or the mapped file.
+ ***************************************************************/
+QStringList MetadataStore::releases(const QString &project) const
+{
+    QStringList versions;
+    const auto it = m_overlay.constFind(project);
+    if (it != m_overlay.constEnd())
+    {
+        versions.reserve(it->releases.size());
+        for (int i = 0; i < it->releases.size(); ++i)
+        {
+            versions << it->releases.at(i).text;
+        }
+        return versions;
+    }
+    const int index = findMapped(project);
+    if (index < 0)
+    {
+        return versions;
+    }
+    const FileHeader &header = *section<FileHeader>(m_map, 0);
+    const ProjectRecord &record = section<ProjectRecord>(m_map, layoutOf(header).projects)[index];
+    versions.reserve(int(record.versionCount));
+    for (quint32 v = 0; v < record.versionCount; ++v)
+    {
+        versions << versionText(record.firstVersion + v);
+    }
+    return versions;
+}
+
+QByteArray MetadataStore::etag(const QString &project) const
+{
+    const auto it = m_overlay.constFind(project);
+    if (it != m_overlay.constEnd())
+    {
+        return it->etag;
+    }
+    const int index = findMapped(project);
+    if (index < 0)
+    {
+        return QByteArray();
+    }
+    const FileHeader &header = *section<FileHeader>(m_map, 0);
+    return string(section<ProjectRecord>(m_map, layoutOf(header).projects)[index].etag).toLatin1();
+}
+
+qint64 MetadataStore::checked(const QString &project) const
+{
+    const auto it = m_overlay.constFind(project);
+    if (it != m_overlay.constEnd())
+    {
+        return it->checked;
+    }
+    const int index = findMapped(project);
+    if (index < 0)
+    {
+        return 0;
+    }
+    const FileHeader &header = *section<FileHeader>(m_map, 0);
+    return section<ProjectRecord>(m_map, layoutOf(header).projects)[index].checked;
+}
+
+/****************************************************************
+ * @brief Binary search of the project's versions by number.
+ ***************************************************************/
+bool MetadataStore::requiresDist(const QString &project, const QString &version, QStringList *entries) const
+{
+    QVector<quint32> wanted;
+    if (!packVersion(version, &wanted))
+    {
+        return false;
+    }
+    const auto it = m_overlay.constFind(project);
+    if (it != m_overlay.constEnd())
+    {
+        for (int i = 0; i < it->releases.size(); ++i)
+        {
+            const Release &release = it->releases.at(i);
+            if (compareComponents(release.components.constData(), int(release.components.size()),
+                                  wanted.constData(), int(wanted.size())) == 0)
+            {
+                if (release.known && entries)
+                {
+                    *entries = release.requiresDist;
+                }
+                return release.known;
+            }
+        }
+        return false;
+    }
+    const int index = findMapped(project);
+    if (index < 0)
+    {
+        return false;
+    }
+    const FileHeader &header = *section<FileHeader>(m_map, 0);
+    const Layout layout = layoutOf(header);
+    const ProjectRecord &record = section<ProjectRecord>(m_map, layout.projects)[index];
+    const VersionRecord *versions = section<VersionRecord>(m_map, layout.versions) + record.firstVersion;
+    const quint32 *components = section<quint32>(m_map, layout.components);
+    int low = 0;
+    int high = int(record.versionCount) - 1;
+    while (low <= high)
+    {
+        const int middle = (low + high) / 2;
+        const VersionRecord &candidate = versions[middle];
+        const int c = compareComponents(components + candidate.firstComponent, candidate.componentCount,
+                                        wanted.constData(), int(wanted.size()));
+        if (c < 0)
+        {
+            low = middle + 1;
+        }
+        else if (c > 0)
+        {
+            high = middle - 1;
+        }
+        else
+        {
+            const bool known = candidate.flags & kRequiresKnown;
+            if (known && entries)
+            {
+                const quint32 *edges = section<quint32>(m_map, layout.edges) + candidate.firstEdge;
+                entries->clear();
+                for (quint32 e = 0; e < candidate.edgeCount; ++e)
+                {
+                    *entries << string(edges[e]);
+                }
+            }
+            return known;
+        }
+    }
+    return false;
+}
+
+/****************************************************************
+ * @brief Replaces the releases of a project.
+ ***************************************************************/
+void MetadataStore::setReleases(const QString &project, const QStringList &versions, const QByteArray &etag)
+{
+    Entry *entry = editable(project);
+    QHash<QString, Release> previous;
+    for (int i = 0; i < entry->releases.size(); ++i)
+    {
+        previous.insert(entry->releases.at(i).text, entry->releases.at(i));
+    }
+
+    QVector<Release> releases;
+    releases.reserve(versions.size());
+    for (int i = 0; i < versions.size(); ++i)
+    {
+        Release release = previous.value(versions.at(i));
+        if (release.text.isEmpty())
+        {
+            if (!packVersion(versions.at(i), &release.components))
+            {
+                continue; // pre-, post- and dev releases are never candidates
+            }
+            release.text = versions.at(i);
+        }
+        releases.append(release);
+    }
+    std::stable_sort(releases.begin(), releases.end(), [](const Release &a, const Release &b)
+                     {
+                         return compareComponents(a.components.constData(), int(a.components.size()),
+                                                  b.components.constData(), int(b.components.size())) < 0;
+                     });
+    // "1.0" and "1.0.0" are one version; keep the first
+    releases.erase(std::unique(releases.begin(), releases.end(), [](const Release &a, const Release &b)
+                               {
+                                   return compareComponents(a.components.constData(), int(a.components.size()),
+                                                            b.components.constData(),
+                                                            int(b.components.size())) == 0;
+                               }),
+                   releases.end());
+
+    entry->releases = releases;
+    entry->etag = etag;
+    entry->checked = QDateTime::currentMSecsSinceEpoch();
+    m_dirty = true;
+}
+
+void MetadataStore::markChecked(const QString &project)
+{
+    if (contains(project))
+    {
+        editable(project)->checked = QDateTime::currentMSecsSinceEpoch();
+        m_dirty = true;
+    }
+}
+
+void MetadataStore::setRequiresDist(const QString &project, const QString &version, const QStringList &entries)
+{
+    QVector<quint32> wanted;
+    if (!contains(project) || !packVersion(version, &wanted))
+    {
+        return;
+    }
+    Entry *entry = editable(project);
+    for (int i = 0; i < entry->releases.size(); ++i)
+    {
+        Release &release = entry->releases[i];
+        if (compareComponents(release.components.constData(), int(release.components.size()),
+                              wanted.constData(), int(wanted.size())) == 0)
+        {
+            release.known = true;
+            release.requiresDist = entries;
+            m_dirty = true;
+            return;
+        }
+    }
+}
+
+bool MetadataStore::isDirty() const
+{
+    return m_dirty;
+}
+
+/****************************************************************
+ * @brief Merges the overlay into the current file and rewrites it.
+ ***************************************************************/
+bool MetadataStore::save(QString *error)
+{
+    if (m_path.isEmpty())
+    {
+        if (error)
+        {
+            *error = QStringLiteral("No metadata store file set");
+        }
+        return false;
+    }
+    if (!m_dirty)
+    {
+        return true;
+    }
+
+    // Pick up what another process saved since open()
+    const QHash<QString, Entry> overlay = m_overlay;
+    open(m_path);
+    m_overlay = overlay;
+    m_dirty = true;
+    const QByteArray data = encode();
+
+    close(); // a mapped file cannot be replaced on Windows
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+    {
+        if (error)
+        {
+            *error = file.errorString();
+        }
+        open(m_path);
+        m_overlay = overlay;
+        m_dirty = true;
+        return false;
+    }
+    DEBUG_MSG() << "metadata store saved" << m_path << data.size() << "bytes";
+    return open(m_path);
+}
+
+/****************************************************************
+ * @brief Release numbers of a final release.
+ ***************************************************************/
+bool MetadataStore::packVersion(const QString &version, QVector<quint32> *components)
+{
+    components->clear();
+    if (version.isEmpty())
+    {
+        return false;
+    }
+    const QStringList fields = version.split('.');
+    if (fields.size() > 0xFFFF)
+    {
+        return false;
+    }
+    components->reserve(fields.size());
+    for (int i = 0; i < fields.size(); ++i)
+    {
+        const QString &field = fields.at(i);
+        bool ok = !field.isEmpty();
+        for (int c = 0; c < field.size() && ok; ++c)
+        {
+            ok = field.at(c).isDigit() && field.at(c).unicode() < 128;
+        }
+        const uint number = ok ? field.toUInt(&ok) : 0;
+        if (!ok)
+        {
+            components->clear();
+            return false;
+        }
+        components->append(number);
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Checks every count, index and string bound of the map.
+ ***************************************************************/
+bool MetadataStore::validate() const
+{
+    const FileHeader &header = *section<FileHeader>(m_map, 0);
+    if (header.magic != kMagic || header.format != kFormat)
+    {
+        return false;
+    }
+    const Layout layout = layoutOf(header);
+    if (layout.end != m_size)
+    {
+        return false;
+    }
+    const quint32 *offsets = section<quint32>(m_map, layout.offsets);
+    if (offsets[0] != 0 || offsets[header.strings] != header.blobBytes)
+    {
+        return false;
+    }
+    for (quint32 i = 0; i < header.strings; ++i)
+    {
+        if (offsets[i] > offsets[i + 1])
+        {
+            return false;
+        }
+    }
+    const auto validString = [&header](quint32 id, bool optional)
+    {
+        return id < header.strings || (optional && id == kNone);
+    };
+    const ProjectRecord *projects = section<ProjectRecord>(m_map, layout.projects);
+    for (quint32 i = 0; i < header.projects; ++i)
+    {
+        if (!validString(projects[i].name, false) || !validString(projects[i].etag, true)
+            || qint64(projects[i].firstVersion) + projects[i].versionCount > header.versions)
+        {
+            return false;
+        }
+    }
+    const VersionRecord *versions = section<VersionRecord>(m_map, layout.versions);
+    for (quint32 i = 0; i < header.versions; ++i)
+    {
+        if (qint64(versions[i].firstComponent) + versions[i].componentCount > header.components
+            || qint64(versions[i].firstEdge) + versions[i].edgeCount > header.edges
+            || !validString(versions[i].text, true))
+        {
+            return false;
+        }
+    }
+    const quint32 *edges = section<quint32>(m_map, layout.edges);
+    for (quint32 i = 0; i < header.edges; ++i)
+    {
+        if (!validString(edges[i], false))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Binary search of the mapped projects by UTF-8 name.
+ ***************************************************************/
+int MetadataStore::findMapped(const QString &project) const
+{
+    if (!m_map)
+    {
+        return -1;
+    }
+    const FileHeader &header = *section<FileHeader>(m_map, 0);
+    const Layout layout = layoutOf(header);
+    const ProjectRecord *projects = section<ProjectRecord>(m_map, layout.projects);
+    const quint32 *offsets = section<quint32>(m_map, layout.offsets);
+    const char *blob = section<char>(m_map, layout.blob);
+    const QByteArray key = project.toUtf8();
+    int low = 0;
+    int high = int(header.projects) - 1;
+    while (low <= high)
+    {
+        const int middle = (low + high) / 2;
+        const quint32 name = projects[middle].name;
+        const int c = compareBytes(QByteArrayView(blob + offsets[name], offsets[name + 1] - offsets[name]), key);
+        if (c < 0)
+        {
+            low = middle + 1;
+        }
+        else if (c > 0)
+        {
+            high = middle - 1;
+        }
+        else
+        {
+            return middle;
+        }
+    }
+    return -1;
+}
+
+/****************************************************************
+ * @brief Copies one mapped project into an editable entry.
+ ***************************************************************/
+MetadataStore::Entry MetadataStore::decode(int project) const
+{
+    const FileHeader &header = *section<FileHeader>(m_map, 0);
+    const Layout layout = layoutOf(header);
+    const ProjectRecord &record = section<ProjectRecord>(m_map, layout.projects)[project];
+    const VersionRecord *versions = section<VersionRecord>(m_map, layout.versions);
+    const quint32 *components = section<quint32>(m_map, layout.components);
+    const quint32 *edges = section<quint32>(m_map, layout.edges);
+
+    Entry entry;
+    entry.etag = string(record.etag).toLatin1();
+    entry.checked = record.checked;
+    entry.releases.reserve(int(record.versionCount));
+    for (quint32 v = 0; v < record.versionCount; ++v)
+    {
+        const VersionRecord &version = versions[record.firstVersion + v];
+        Release release;
+        release.text = versionText(record.firstVersion + v);
+        release.components = QVector<quint32>(components + version.firstComponent,
+                                              components + version.firstComponent + version.componentCount);
+        release.known = version.flags & kRequiresKnown;
+        for (quint32 e = 0; e < version.edgeCount; ++e)
+        {
+            release.requiresDist << string(edges[version.firstEdge + e]);
+        }
+        entry.releases.append(release);
+    }
+    return entry;
+}
+
+MetadataStore::Entry *MetadataStore::editable(const QString &project)
+{
+    auto it = m_overlay.find(project);
+    if (it == m_overlay.end())
+    {
+        const int index = findMapped(project);
+        it = m_overlay.insert(project, index >= 0 ? decode(index) : Entry());
+    }
+    return &it.value();
+}
+
+/****************************************************************
+ * @brief Serializes the mapped projects and the overlay.
+ ***************************************************************/
+QByteArray MetadataStore::encode() const
+{
+    // name -> mapped index, -1 for projects only in the overlay
+    QVector<QPair<QByteArray, int>> names;
+    if (m_map)
+    {
+        const FileHeader &header = *section<FileHeader>(m_map, 0);
+        const ProjectRecord *projects = section<ProjectRecord>(m_map, layoutOf(header).projects);
+        for (quint32 i = 0; i < header.projects; ++i)
+        {
+            const QString name = string(projects[i].name);
+            if (!m_overlay.contains(name))
+            {
+                names.append(qMakePair(name.toUtf8(), int(i)));
+            }
+        }
+    }
+    for (auto it = m_overlay.constBegin(); it != m_overlay.constEnd(); ++it)
+    {
+        names.append(qMakePair(it.key().toUtf8(), -1));
+    }
+    std::sort(names.begin(), names.end(), [](const QPair<QByteArray, int> &a, const QPair<QByteArray, int> &b)
+              { return compareBytes(a.first, b.first) < 0; });
+
+    QHash<QByteArray, quint32> ids;
+    QVector<quint32> offsets;
+    QByteArray blob;
+    const auto intern = [&](const QByteArray &text) -> quint32
+    {
+        const auto it = ids.constFind(text);
+        if (it != ids.constEnd())
+        {
+            return it.value();
+        }
+        const quint32 id = quint32(offsets.size());
+        offsets.append(quint32(blob.size()));
+        blob += text;
+        ids.insert(text, id);
+        return id;
+    };
+
+    QVector<ProjectRecord> projects;
+    QVector<VersionRecord> versions;
+    QVector<quint32> components;
+    QVector<quint32> edges;
+    projects.reserve(names.size());
+    for (int i = 0; i < names.size(); ++i)
+    {
+        const Entry entry = names.at(i).second >= 0 ? decode(names.at(i).second)
+                                                    : m_overlay.value(QString::fromUtf8(names.at(i).first));
+        ProjectRecord project{};
+        project.name = intern(names.at(i).first);
+        project.etag = entry.etag.isEmpty() ? kNone : intern(entry.etag);
+        project.checked = entry.checked;
+        project.firstVersion = quint32(versions.size());
+        project.versionCount = quint32(entry.releases.size());
+        for (int v = 0; v < entry.releases.size(); ++v)
+        {
+            const Release &release = entry.releases.at(v);
+            VersionRecord version{};
+            version.firstComponent = quint32(components.size());
+            version.componentCount = quint16(release.components.size());
+            version.flags = release.known ? kRequiresKnown : 0;
+            version.firstEdge = quint32(edges.size());
+            version.edgeCount = quint32(release.requiresDist.size());
+            version.text = release.text == joinComponents(release.components.constData(),
+                                                          int(release.components.size()))
+                               ? kNone
+                               : intern(release.text.toUtf8());
+            components += release.components;
+            for (int e = 0; e < release.requiresDist.size(); ++e)
+            {
+                edges.append(intern(release.requiresDist.at(e).toUtf8()));
+            }
+            versions.append(version);
+        }
+        projects.append(project);
+    }
+
+    FileHeader header{};
+    header.magic = kMagic;
+    header.format = kFormat;
+    header.projects = quint32(projects.size());
+    header.versions = quint32(versions.size());
+    header.components = quint32(components.size());
+    header.edges = quint32(edges.size());
+    header.strings = quint32(offsets.size());
+    header.blobBytes = quint32(blob.size());
+    offsets.append(quint32(blob.size()));
+    const Layout layout = layoutOf(header);
+
+    QByteArray data(layout.end, '\0');
+    char *out = data.data();
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + layout.projects, projects.constData(), size_t(projects.size()) * sizeof(ProjectRecord));
+    std::memcpy(out + layout.versions, versions.constData(), size_t(versions.size()) * sizeof(VersionRecord));
+    std::memcpy(out + layout.components, components.constData(), size_t(components.size()) * sizeof(quint32));
+    std::memcpy(out + layout.edges, edges.constData(), size_t(edges.size()) * sizeof(quint32));
+    std::memcpy(out + layout.offsets, offsets.constData(), size_t(offsets.size()) * sizeof(quint32));
+    std::memcpy(out + layout.blob, blob.constData(), size_t(blob.size()));
+    return data;
+}
+
+QString MetadataStore::string(quint32 id) const
+{
+    if (!m_map)
+    {
+        return QString();
+    }
+    const FileHeader &header = *section<FileHeader>(m_map, 0);
+    if (id >= header.strings)
+    {
+        return QString();
+    }
+    const Layout layout = layoutOf(header);
+    const quint32 *offsets = section<quint32>(m_map, layout.offsets);
+    return QString::fromUtf8(section<char>(m_map, layout.blob) + offsets[id], offsets[id + 1] - offsets[id]);
+}
+
+QString MetadataStore::versionText(quint32 version) const
+{
+    const FileHeader &header = *section<FileHeader>(m_map, 0);
+    const Layout layout = layoutOf(header);
+    const VersionRecord &record = section<VersionRecord>(m_map, layout.versions)[version];
+    if (record.text != kNone)
+    {
+        return string(record.text);
+    }
+    return joinComponents(section<quint32>(m_map, layout.components) + record.firstComponent,
+                          record.componentCount);
+}
+
+/************** End of MetadataStore.cpp ************************/
@@ -0,0 +1,173 @@
+/****************************************************************
+ * @file MetadataStore.h
+ * @brief Declares MetadataStore, the compact on-disk copy of the
+ *        PyPI metadata CandidateFetcher uses.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines MetadataStore. A /pypi/<project>/json body is
+ * megabytes for projects like torch, and all CandidateFetcher keeps
+ * of it is the list of final, non-yanked releases; of each
+ * candidate's /pypi/<project>/<version>/json only requires_dist.
+ * The store keeps exactly that in one binary file, which open()
+ * maps (QFile::map) and every lookup reads in place: nothing is
+ * parsed or copied at startup, and only the projects looked up
+ * become QStrings.
+ *
+ * File (native byte order, sections 8-byte aligned, in this order):
+ *   Header      magic "PMRM", format, counts of every section
+ *   projects    {name, etag, checked ms, first version, versions},
+ *               sorted by the UTF-8 of the PEP 503 name
+ *   versions    {first component, components, flags, first edge,
+ *               edges, text}, ascending per project
+ *   components  quint32 release numbers ("1.26.4" -> 1 26 4)
+ *   edges       string ids of requires_dist entries
+ *   offsets     quint32 per string into the blob, plus its end
+ *   blob        UTF-8 of the interned strings (names, ETags and
+ *               requires_dist entries, each stored once)
+ * A version's text is only kept when it does not round-trip
+ * through its numbers (certifi's "2023.07.22").
+ *
+ * Changes go to an in-memory overlay; save() merges it with the
+ * current file (another process may have saved meanwhile), writes
+ * a new file through QSaveFile and maps that. A file with another
+ * magic, format or invalid bounds is ignored and replaced by the
+ * next save().
+ ***************************************************************/
+#ifndef METADATASTORE_H
+#define METADATASTORE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/****************************************************************
+ * @class MetadataStore
+ * @brief Memory-mapped releases and requires_dist per project.
+ ***************************************************************/
+class MetadataStore
+{
+public:
+    static const quint32 kFormat = 1;
+
+    MetadataStore();
+    ~MetadataStore();
+
+    /****************************************************************
+     * @brief Maps the store file; pending changes are dropped.
+     * @return false if it is missing or invalid (the store is then
+     *         empty and save() creates the file).
+     ***************************************************************/
+    bool open(const QString &path);
+    void close();
+    QString path() const;
+    bool isMapped() const;
+
+    /****************************************************************
+     * @brief Projects in the file and the overlay.
+     ***************************************************************/
+    int projectCount() const;
+
+    bool contains(const QString &project) const;
+
+    /****************************************************************
+     * @brief Stored releases of a project, oldest first.
+     ***************************************************************/
+    QStringList releases(const QString &project) const;
+
+    QByteArray etag(const QString &project) const;
+
+    /****************************************************************
+     * @brief When the releases were last confirmed by the index, ms
+     *        since the epoch; 0 if the project is not stored.
+     ***************************************************************/
+    qint64 checked(const QString &project) const;
+
+    /****************************************************************
+     * @brief requires_dist of one stored release.
+     * @return false if it was never stored (an empty list is stored
+     *         for releases without dependency metadata).
+     ***************************************************************/
+    bool requiresDist(const QString &project, const QString &version, QStringList *entries) const;
+
+    /****************************************************************
+     * @brief Replaces the releases of a project and marks it
+     *        checked now. Versions that are not final releases are
+     *        left out; requires_dist of kept releases is kept.
+     ***************************************************************/
+    void setReleases(const QString &project, const QStringList &versions, const QByteArray &etag);
+
+    /****************************************************************
+     * @brief Marks a project checked now (a 304 from the index).
+     ***************************************************************/
+    void markChecked(const QString &project);
+
+    /****************************************************************
+     * @brief Stores requires_dist of a release already stored by
+     *        setReleases(); other versions are ignored.
+     ***************************************************************/
+    void setRequiresDist(const QString &project, const QString &version, const QStringList &entries);
+
+    bool isDirty() const;
+
+    /****************************************************************
+     * @brief Writes the file and maps it again.
+     * @return false with error set if it cannot be written; the
+     *         changes then stay pending.
+     ***************************************************************/
+    bool save(QString *error = nullptr);
+
+    /****************************************************************
+     * @brief Release numbers of a final release ("1.26.4").
+     * @return false for anything else or numbers above 32 bits.
+     ***************************************************************/
+    static bool packVersion(const QString &version, QVector<quint32> *components);
+
+private:
+    /****************************************************************
+     * @struct Release
+     * @brief One stored version while it is being edited.
+     ***************************************************************/
+    struct Release
+    {
+        QString text;
+        QVector<quint32> components;
+        bool known = false;            ///< requires_dist stored
+        QStringList requiresDist;
+    };
+
+    /****************************************************************
+     * @struct Entry
+     * @brief One project while it is being edited.
+     ***************************************************************/
+    struct Entry
+    {
+        QByteArray etag;
+        qint64 checked = 0;
+        QVector<Release> releases;     ///< ascending
+    };
+
+    bool validate() const;
+    int findMapped(const QString &project) const;
+    Entry decode(int project) const;
+    Entry *editable(const QString &project);
+    QByteArray encode() const;
+    QString string(quint32 id) const;
+    QString versionText(quint32 version) const;
+
+    QString m_path;
+    QFile m_file;
+    const uchar *m_map = nullptr;
+    qint64 m_size = 0;
+    QHash<QString, Entry> m_overlay;   ///< changed projects
+    bool m_dirty = false;
+};
+
+#endif // METADATASTORE_H
+/************** End of MetadataStore.h **************************/
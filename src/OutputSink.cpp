@@ -0,0 +1,172 @@
+/****************************************************************
+ * @file OutputSink.cpp
+ * @brief Implements the OutputSink class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of OutputSink class.
+ * The view only follows new output when it was already scrolled
+ * to the bottom, so reading back through a long log is not
+ * interrupted by every flush.
+ ***************************************************************/
+#include "OutputSink.h"
+#include <QPlainTextEdit>
+#include <QScrollBar>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QTextEdit>
+#include <QColor>
+#include <QFont>
+
+static const int kFlushIntervalMs = 16;
+
+/****************************************************************
+ * @brief Constructor for a QPlainTextEdit view (owned by it).
+ ***************************************************************/
+OutputSink::OutputSink(QPlainTextEdit *view) : OutputSink(view, view->document())
+{
+}
+
+/****************************************************************
+ * @brief Constructor for a QTextEdit view (owned by it).
+ ***************************************************************/
+OutputSink::OutputSink(QTextEdit *view) : OutputSink(view, view->document())
+{
+}
+
+/****************************************************************
+ * @brief Shared constructor: sets up formats and the flush timer.
+ ***************************************************************/
+OutputSink::OutputSink(QAbstractScrollArea *view, QTextDocument *document)
+    : QObject(view)
+    , m_view(view)
+    , m_document(document)
+{
+    m_document->setMaximumBlockCount(m_maxLines);
+    m_document->setUndoRedoEnabled(false);
+
+    m_normalFormat.setForeground(QColor(Qt::black));
+    m_errorFormat.setForeground(QColor(Qt::red));
+    m_commandFormat.setForeground(QColor(Qt::blue));
+    m_commandFormat.setFontWeight(QFont::Bold);
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushIntervalMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &OutputSink::flush);
+}
+
+void OutputSink::setMaximumLines(int lines)
+{
+    m_maxLines = qMax(0, lines);
+    m_document->setMaximumBlockCount(m_maxLines);
+}
+
+int OutputSink::maximumLines() const
+{
+    return m_maxLines;
+}
+
+/****************************************************************
+ * @brief Queues text for the next flush.
+ ***************************************************************/
+void OutputSink::append(const QString &text, Style style)
+{
+    QString body = text;
+    if (body.endsWith('\n'))
+    {
+        body.chop(1);
+    }
+    const QStringList lines = body.split('\n');
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        QString line = lines.at(i);
+        if (line.endsWith('\r'))
+        {
+            line.chop(1);
+        }
+        m_pending.append({style, line});
+    }
+
+    // Lines the document would evict anyway are never rendered.
+    if (m_maxLines > 0 && m_pending.size() > m_maxLines)
+    {
+        m_pending.remove(0, m_pending.size() - m_maxLines);
+    }
+    if (!m_flushTimer.isActive())
+    {
+        m_flushTimer.start();
+    }
+}
+
+/****************************************************************
+ * @brief Writes queued lines in one edit block.
+ ***************************************************************/
+void OutputSink::flush()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty())
+    {
+        return;
+    }
+
+    QScrollBar *bar = m_view->verticalScrollBar();
+    const bool follow = bar->value() >= bar->maximum();
+
+    QTextCursor cursor(m_document);
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    const bool emptyDocument = m_document->isEmpty();
+    int i = 0;
+    while (i < m_pending.size())
+    {
+        // One insert per run of lines sharing a style
+        const Style style = m_pending.at(i).style;
+        QString run;
+        while (i < m_pending.size() && m_pending.at(i).style == style)
+        {
+            if (!run.isEmpty() || i > 0 || !emptyDocument)
+            {
+                run += '\n';
+            }
+            run += m_pending.at(i).text;
+            ++i;
+        }
+        cursor.insertText(run, formatFor(style));
+    }
+    cursor.endEditBlock();
+    m_pending.clear();
+
+    if (follow)
+    {
+        bar->setValue(bar->maximum());
+    }
+}
+
+/****************************************************************
+ * @brief Drops queued lines and empties the view.
+ ***************************************************************/
+void OutputSink::clear()
+{
+    m_flushTimer.stop();
+    m_pending.clear();
+    m_document->clear();
+}
+
+const QTextCharFormat &OutputSink::formatFor(Style style) const
+{
+    switch (style)
+    {
+    case Style::Error:
+        return m_errorFormat;
+    case Style::Command:
+        return m_commandFormat;
+    case Style::Normal:
+    default:
+        return m_normalFormat;
+    }
+}
+
+/************** End of OutputSink.cpp ***************************/
@@ -0,0 +1,101 @@
+/****************************************************************
+ * @file OutputSink.h
+ * @brief Declares the OutputSink class for batched console output.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the OutputSink class. Producers (process
+ * output, log lines) call append() as often as they like; lines
+ * are queued and written to the view at most once per frame
+ * (~16 ms) in a single edit block, with one char format per run of
+ * equally styled lines. The document keeps a bounded number of
+ * lines (setMaximumBlockCount), so a chatty pip run cannot grow
+ * the GUI without limit, and the pending queue is capped the same
+ * way.
+ ***************************************************************/
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QTimer>
+#include <QTextCharFormat>
+
+class QAbstractScrollArea;
+class QPlainTextEdit;
+class QTextDocument;
+class QTextEdit;
+
+/****************************************************************
+ * @class OutputSink
+ * @brief Coalescing, size-bounded writer for a text view.
+ ***************************************************************/
+class OutputSink : public QObject
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************
+     * @enum Style
+     * @brief Formatting applied to a line.
+     ***************************************************************/
+    enum class Style
+    {
+        Normal,
+        Error,
+        Command
+    };
+
+    explicit OutputSink(QPlainTextEdit *view);
+    explicit OutputSink(QTextEdit *view);
+
+    /****************************************************************
+     * @brief Caps the number of lines kept in the view.
+     * @param lines Maximum line count, 0 for unlimited.
+     ***************************************************************/
+    void setMaximumLines(int lines);
+    int maximumLines() const;
+
+    /****************************************************************
+     * @brief Queues text; each line is written with the same style.
+     *        A single trailing newline is ignored.
+     ***************************************************************/
+    void append(const QString &text, Style style = Style::Normal);
+
+    /****************************************************************
+     * @brief Writes everything queued now.
+     ***************************************************************/
+    void flush();
+
+    /****************************************************************
+     * @brief Drops queued lines and empties the view.
+     ***************************************************************/
+    void clear();
+
+private:
+    OutputSink(QAbstractScrollArea *view, QTextDocument *document);
+    const QTextCharFormat &formatFor(Style style) const;
+
+    struct Line
+    {
+        Style style;
+        QString text;
+    };
+
+    QAbstractScrollArea *m_view;
+    QTextDocument *m_document;
+    int m_maxLines = 10000;
+    QList<Line> m_pending;
+    QTimer m_flushTimer;
+    QTextCharFormat m_normalFormat;
+    QTextCharFormat m_errorFormat;
+    QTextCharFormat m_commandFormat;
+};
+
+#endif // OUTPUTSINK_H
+/************** End of OutputSink.h *****************************/
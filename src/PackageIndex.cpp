@@ -0,0 +1,605 @@
+/****************************************************************
+ * @file PackageIndex.cpp
+ * @brief Implements the PackageIndex class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of PackageIndex.
+ * Index file layout:
+ *   PMRNAMES 1\n
+ *   <etag>\n
+ *   name\n name\n ...        (sorted, normalized)
+ * The file's modification time is when the page was last checked.
+ ***************************************************************/
+#include "PackageIndex.h"
+#include "Telemetry.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+namespace
+{
+const QByteArray kMagic = "PMRNAMES 1\n";
+const int kTransferTimeoutMs = 60000;
+const int kRankedCandidates = 500;  ///< prefix/substring hits ranked by length
+}
+
+int PackageIndex::Names::size() const
+{
+    return offsets.size();
+}
+
+QByteArrayView PackageIndex::Names::at(int i) const
+{
+    const quint32 start = offsets.at(i);
+    const quint32 end = i + 1 < offsets.size() ? offsets.at(i + 1) : quint32(block.size());
+    return QByteArrayView(block.constData() + start, end - start - 1);
+}
+
+/****************************************************************
+ * @brief Constructor: Installs the worker result when ready.
+ ***************************************************************/
+PackageIndex::PackageIndex(QObject *parent)
+    : QObject(parent)
+    , m_indexUrl("https://pypi.org/simple/")
+{
+    connect(&m_watcher, &QFutureWatcher<std::shared_ptr<const Names>>::finished, this, [this]()
+            {
+                const std::shared_ptr<const Names> names = m_watcher.result();
+                if (names)
+                {
+                    install(names);
+                }
+                if (!m_refreshAfterLoad)
+                {
+                    return;
+                }
+                m_refreshAfterLoad = false;
+                const bool stale = !m_names
+                                   || (m_maxAgeSecs >= 0
+                                       && m_names->updated.secsTo(QDateTime::currentDateTime()) > m_maxAgeSecs);
+                if (stale)
+                {
+                    refresh();
+                }
+            });
+}
+
+/****************************************************************
+ * @brief Destructor: Stops the download and waits for the worker.
+ ***************************************************************/
+PackageIndex::~PackageIndex()
+{
+    cancel();
+    m_watcher.waitForFinished();
+}
+
+void PackageIndex::setNetworkManager(QNetworkAccessManager *manager)
+{
+    m_manager = manager;
+}
+
+void PackageIndex::setIndexUrl(const QString &url)
+{
+    m_indexUrl = url;
+}
+
+/****************************************************************
+ * @brief Loads the index file in the background.
+ ***************************************************************/
+void PackageIndex::open(const QString &path, qint64 maxAgeSecs)
+{
+    m_path = path;
+    m_maxAgeSecs = maxAgeSecs;
+    m_refreshAfterLoad = true;
+    m_watcher.setFuture(QtConcurrent::run(&PackageIndex::load, path));
+}
+
+/****************************************************************
+ * @brief Downloads the index page if it changed.
+ ***************************************************************/
+void PackageIndex::refresh()
+{
+    if (m_reply)
+    {
+        return;
+    }
+    if (m_watcher.isRunning())
+    {
+        m_refreshAfterLoad = true;
+        m_maxAgeSecs = 0;
+        return;
+    }
+    if (!m_manager)
+    {
+        m_manager = new QNetworkAccessManager(this);
+    }
+
+    QNetworkRequest request{QUrl(m_indexUrl)};
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    // Tens of MB: keep it out of the shared HTTP cache, the ETag is kept here
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+    request.setRawHeader("Accept", "application/vnd.pypi.simple.v1+html, text/html;q=0.1");
+    if (m_names && !m_names->etag.isEmpty())
+    {
+        request.setRawHeader("If-None-Match", m_names->etag);
+    }
+    request.setTransferTimeout(kTransferTimeoutMs);
+
+    m_page.clear();
+    m_lines.clear();
+    m_reply = m_manager->get(request);
+    connect(m_reply, &QNetworkReply::readyRead, this, &PackageIndex::onReadyRead);
+    connect(m_reply, &QNetworkReply::finished, this, &PackageIndex::onReplyFinished);
+    emit logMessage(tr("Updating the package index from %1").arg(m_indexUrl));
+}
+
+void PackageIndex::cancel()
+{
+    if (m_reply)
+    {
+        m_reply->abort(); // finished() follows synchronously
+    }
+}
+
+bool PackageIndex::isLoaded() const
+{
+    return m_names != nullptr;
+}
+
+bool PackageIndex::isRefreshing() const
+{
+    return m_reply != nullptr || (m_watcher.isRunning() && !m_refreshAfterLoad);
+}
+
+int PackageIndex::size() const
+{
+    return m_names ? m_names->size() : 0;
+}
+
+QDateTime PackageIndex::updated() const
+{
+    return m_names ? m_names->updated : QDateTime();
+}
+
+/****************************************************************
+ * @brief Picks names out of each chunk as it arrives.
+ ***************************************************************/
+void PackageIndex::onReadyRead()
+{
+    // No status at all for file:// index mirrors
+    const int status = m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status != 200 && status != 0)
+    {
+        return;
+    }
+    const QByteArray chunk = m_reply->readAll();
+    Telemetry::add(Telemetry::Counter::BytesDownloaded, chunk.size());
+    m_page += chunk;
+    takeAnchors(&m_page, &m_lines);
+}
+
+/****************************************************************
+ * @brief Ends a refresh: unchanged (304), failed, or a new page
+ *        that is sorted and saved on a worker thread.
+ ***************************************************************/
+void PackageIndex::onReplyFinished()
+{
+    QNetworkReply *reply = m_reply;
+    m_reply = nullptr;
+    reply->deleteLater();
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (reply->error() == QNetworkReply::OperationCanceledError)
+    {
+        m_page.clear();
+        m_lines.clear();
+        return;
+    }
+    if (status == 304)
+    {
+        touch();
+        emit logMessage(tr("Package index is up to date (%1 names)").arg(size()));
+        emit ready(size());
+        return;
+    }
+    if (reply->error() != QNetworkReply::NoError)
+    {
+        emit refreshFailed(reply->errorString());
+        return;
+    }
+
+    const QByteArray tail = reply->readAll();
+    Telemetry::add(Telemetry::Counter::BytesDownloaded, tail.size());
+    m_page += tail;
+    takeAnchors(&m_page, &m_lines);
+    m_page.clear();
+    if (m_lines.isEmpty())
+    {
+        emit refreshFailed(tr("%1 listed no projects").arg(m_indexUrl));
+        return;
+    }
+
+    const QByteArray lines = std::exchange(m_lines, QByteArray());
+    const QByteArray etag = reply->rawHeader("ETag");
+    const QString path = m_path;
+    m_watcher.setFuture(QtConcurrent::run([lines, etag, path]()
+                                          {
+                                              std::shared_ptr<const Names> names = build(lines, etag);
+                                              if (!path.isEmpty() && !save(path, *names))
+                                              {
+                                                  qWarning() << "Cannot save package index" << path;
+                                              }
+                                              return names;
+                                          }));
+}
+
+/****************************************************************
+ * @brief Puts a loaded or rebuilt index in use.
+ ***************************************************************/
+void PackageIndex::install(std::shared_ptr<const Names> names)
+{
+    m_names = std::move(names);
+    DEBUG_MSG() << "package index" << m_names->size() << "names";
+    emit ready(m_names->size());
+}
+
+/****************************************************************
+ * @brief Records that an unchanged page was checked just now.
+ ***************************************************************/
+void PackageIndex::touch()
+{
+    if (!m_names)
+    {
+        return;
+    }
+    const QDateTime now = QDateTime::currentDateTime();
+    QFile file(m_path);
+    if (file.open(QIODevice::ReadWrite | QIODevice::ExistingOnly))
+    {
+        file.setFileTime(now, QFileDevice::FileModificationTime);
+    }
+    std::shared_ptr<Names> copy = std::make_shared<Names>(*m_names); // block is shared, not copied
+    copy->updated = now;
+    m_names = std::move(copy);
+}
+
+/****************************************************************
+ * @brief Best matches for a query, best first.
+ ***************************************************************/
+QStringList PackageIndex::search(const QString &query, int limit) const
+{
+    QStringList results;
+    const QByteArray q = normalize(query.trimmed().toUtf8());
+    if (!m_names || q.isEmpty() || q.contains('\n') || limit <= 0)
+    {
+        return results;
+    }
+    const Names &names = *m_names;
+    QSet<int> taken;
+    auto byLength = [&names](int a, int b)
+    {
+        const qsizetype la = names.at(a).size();
+        const qsizetype lb = names.at(b).size();
+        return la != lb ? la < lb : a < b;
+    };
+    auto add = [&](const QVector<int> &hits)
+    {
+        for (int i = 0; i < hits.size() && results.size() < limit; ++i)
+        {
+            if (!taken.contains(hits.at(i)))
+            {
+                taken.insert(hits.at(i));
+                results << QString::fromLatin1(names.at(hits.at(i)));
+            }
+        }
+    };
+
+    // Exact and prefix matches form one sorted run, shortest first
+    int first = 0;
+    int count = names.size();
+    while (count > 0)
+    {
+        const int step = count / 2;
+        if (names.at(first + step) < QByteArrayView(q))
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    QVector<int> hits;
+    for (int i = first; i < names.size() && hits.size() < kRankedCandidates && names.at(i).startsWith(q); ++i)
+    {
+        hits << i;
+    }
+    std::sort(hits.begin(), hits.end(), byLength);
+    add(hits);
+
+    // Substring matches; one memmem-style scan of the whole block
+    if (results.size() < limit)
+    {
+        hits.clear();
+        const QByteArrayView block(names.block);
+        qsizetype from = 0;
+        while (hits.size() < kRankedCandidates)
+        {
+            const qsizetype pos = block.indexOf(QByteArrayView(q), from);
+            if (pos < 0)
+            {
+                break;
+            }
+            const int index = int(std::upper_bound(names.offsets.cbegin(), names.offsets.cend(), quint32(pos))
+                                  - names.offsets.cbegin()) - 1;
+            if (!names.at(index).startsWith(q))
+            {
+                hits << index;
+            }
+            from = index + 1 < names.size() ? qsizetype(names.offsets.at(index + 1)) : block.size();
+        }
+        std::sort(hits.begin(), hits.end(), byLength);
+        add(hits);
+    }
+
+    // Typos: names within a small edit distance
+    if (results.size() < limit && q.size() >= 3)
+    {
+        const int maxDistance = q.size() <= 5 ? 1 : 2;
+        QVector<QPair<int, int>> close;   // distance, index
+        for (int i = 0; i < names.size(); ++i)
+        {
+            const QByteArrayView name = names.at(i);
+            if (qAbs(name.size() - q.size()) > maxDistance || taken.contains(i))
+            {
+                continue;
+            }
+            const int distance = boundedDistance(name, q, maxDistance);
+            if (distance <= maxDistance)
+            {
+                close.append(qMakePair(distance, i));
+            }
+        }
+        std::sort(close.begin(), close.end());
+        hits.clear();
+        for (int i = 0; i < close.size(); ++i)
+        {
+            hits << close.at(i).second;
+        }
+        add(hits);
+    }
+    return results;
+}
+
+/****************************************************************
+ * @brief Replaces the index without touching disk.
+ ***************************************************************/
+void PackageIndex::setNames(const QList<QByteArray> &names)
+{
+    QByteArray lines;
+    for (int i = 0; i < names.size(); ++i)
+    {
+        lines += names.at(i) + '\n';
+    }
+    install(build(lines, QByteArray()));
+}
+
+/****************************************************************
+ * @brief PEP 503: lower case, runs of "-_." become one "-".
+ ***************************************************************/
+QByteArray PackageIndex::normalize(QByteArrayView name)
+{
+    QByteArray out;
+    out.reserve(name.size());
+    bool separator = false;
+    for (qsizetype i = 0; i < name.size(); ++i)
+    {
+        const char c = name.at(i);
+        if (c == '-' || c == '_' || c == '.')
+        {
+            separator = true;
+            continue;
+        }
+        if (separator)
+        {
+            out += '-';
+            separator = false;
+        }
+        out += (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+    }
+    if (separator)
+    {
+        out += '-';
+    }
+    return out;
+}
+
+/****************************************************************
+ * @brief Takes every complete anchor's text out of buffer.
+ ***************************************************************/
+int PackageIndex::takeAnchors(QByteArray *buffer, QByteArray *names)
+{
+    int found = 0;
+    qsizetype consumed = 0;
+    while (true)
+    {
+        const qsizetype close = buffer->indexOf("</a>", consumed);
+        if (close < 0)
+        {
+            break;
+        }
+        const qsizetype open = buffer->lastIndexOf('>', close);
+        if (open >= consumed)
+        {
+            const QByteArray name = buffer->mid(open + 1, close - open - 1).trimmed();
+            if (!name.isEmpty())
+            {
+                *names += name;
+                *names += '\n';
+                ++found;
+            }
+        }
+        consumed = close + 4;
+    }
+    buffer->remove(0, consumed);
+    return found;
+}
+
+/****************************************************************
+ * @brief Normalizes, sorts and de-duplicates "name\n" lines.
+ ***************************************************************/
+std::shared_ptr<const PackageIndex::Names> PackageIndex::build(const QByteArray &lines,
+                                                               const QByteArray &etag)
+{
+    QByteArray normalized;
+    normalized.reserve(lines.size());
+    std::vector<std::pair<quint32, quint32>> spans;   // start, length in normalized
+    qsizetype start = 0;
+    while (start < lines.size())
+    {
+        qsizetype end = lines.indexOf('\n', start);
+        if (end < 0)
+        {
+            end = lines.size();
+        }
+        const QByteArray name = normalize(QByteArrayView(lines).sliced(start, end - start).trimmed());
+        if (!name.isEmpty())
+        {
+            spans.emplace_back(quint32(normalized.size()), quint32(name.size()));
+            normalized += name;
+        }
+        start = end + 1;
+    }
+
+    auto view = [&normalized](const std::pair<quint32, quint32> &span)
+    {
+        return QByteArrayView(normalized.constData() + span.first, span.second);
+    };
+    std::sort(spans.begin(), spans.end(), [&view](const auto &a, const auto &b)
+              {
+                  return view(a) < view(b);
+              });
+
+    std::shared_ptr<Names> names = std::make_shared<Names>();
+    names->etag = etag;
+    names->updated = QDateTime::currentDateTime();
+    names->block.reserve(normalized.size() + qsizetype(spans.size()));
+    names->offsets.reserve(qsizetype(spans.size()));
+    for (size_t i = 0; i < spans.size(); ++i)
+    {
+        if (i > 0 && view(spans[i]) == view(spans[i - 1]))
+        {
+            continue;
+        }
+        names->offsets.append(quint32(names->block.size()));
+        names->block += view(spans[i]);
+        names->block += '\n';
+    }
+    return names;
+}
+
+/****************************************************************
+ * @brief Writes the index file atomically.
+ ***************************************************************/
+bool PackageIndex::save(const QString &path, const Names &names)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    file.write(kMagic);
+    file.write(names.etag + '\n');
+    file.write(names.block);
+    return file.commit();
+}
+
+/****************************************************************
+ * @brief Reads an index file; nullptr if missing or malformed.
+ ***************************************************************/
+std::shared_ptr<const PackageIndex::Names> PackageIndex::load(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return nullptr;
+    }
+    QByteArray data = file.readAll();
+    const qsizetype etagEnd = data.indexOf('\n', kMagic.size());
+    if (!data.startsWith(kMagic) || etagEnd < 0 || (data.size() > etagEnd + 1 && !data.endsWith('\n')))
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Names> names = std::make_shared<Names>();
+    names->etag = data.mid(kMagic.size(), etagEnd - kMagic.size());
+    names->updated = QFileInfo(path).lastModified();
+    names->block = data.remove(0, etagEnd + 1);
+
+    const char *begin = names->block.constData();
+    const char *end = begin + names->block.size();
+    const char *p = begin;
+    while (p < end)
+    {
+        names->offsets.append(quint32(p - begin));
+        p = static_cast<const char *>(std::memchr(p, '\n', size_t(end - p))) + 1;
+    }
+    return names;
+}
+
+/****************************************************************
+ * @brief Levenshtein distance that stops once above limit.
+ ***************************************************************/
+int PackageIndex::boundedDistance(QByteArrayView a, QByteArrayView b, int limit)
+{
+    if (qAbs(a.size() - b.size()) > limit)
+    {
+        return limit + 1;
+    }
+    std::vector<int> previous(size_t(b.size() + 1));
+    std::vector<int> current(size_t(b.size() + 1));
+    for (qsizetype j = 0; j <= b.size(); ++j)
+    {
+        previous[size_t(j)] = int(j);
+    }
+    for (qsizetype i = 1; i <= a.size(); ++i)
+    {
+        current[0] = int(i);
+        int rowMin = current[0];
+        for (qsizetype j = 1; j <= b.size(); ++j)
+        {
+            const int cost = a.at(i - 1) == b.at(j - 1) ? 0 : 1;
+            current[size_t(j)] = std::min({previous[size_t(j)] + 1,
+                                           current[size_t(j - 1)] + 1,
+                                           previous[size_t(j - 1)] + cost});
+            rowMin = std::min(rowMin, current[size_t(j)]);
+        }
+        if (rowMin > limit)
+        {
+            return limit + 1;
+        }
+        std::swap(previous, current);
+    }
+    return std::min(previous[size_t(b.size())], limit + 1);
+}
+
+/************** End of PackageIndex.cpp *************************/
@@ -0,0 +1,172 @@
+/****************************************************************
+ * @file PackageIndex.h
+ * @brief Declares the PackageIndex class, a local PyPI name index.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the PackageIndex class. PyPI no longer answers
+ * "pip search", so the Package Manager tab searches a local copy of
+ * every project name instead, taken from the PEP 503 /simple/ page.
+ *
+ * The names are PEP 503 normalized, sorted, and kept as one
+ * '\n'-separated byte block plus an offset per name (about 10 MB
+ * for the whole of PyPI). The same block is the on-disk file, so
+ * loading is one read. Lookups rank exact and prefix matches
+ * (binary search), then substring matches (one scan of the block),
+ * then names within a small edit distance, fast enough to run on
+ * every keystroke.
+ *
+ * refresh() streams the page and picks names out of it as chunks
+ * arrive; the download is conditional on the stored ETag, so an
+ * unchanged index costs a 304. Sorting and saving run on a worker
+ * thread and the new index replaces the old one when it is ready.
+ ***************************************************************/
+#ifndef PACKAGEINDEX_H
+#define PACKAGEINDEX_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QDateTime>
+#include <QFutureWatcher>
+#include <memory>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/****************************************************************
+ * @class PackageIndex
+ * @brief Searchable, locally stored list of PyPI project names.
+ ***************************************************************/
+class PackageIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************
+     * @struct Names
+     * @brief Sorted names; immutable once built, shared by copies.
+     ***************************************************************/
+    struct Names
+    {
+        QByteArray block;           ///< "name\n" for every name, sorted
+        QVector<quint32> offsets;   ///< start of each name in block
+        QByteArray etag;            ///< ETag of the page it came from
+        QDateTime updated;          ///< when the page was last checked
+
+        int size() const;
+        QByteArrayView at(int i) const;
+    };
+
+    explicit PackageIndex(QObject *parent = nullptr);
+    ~PackageIndex();
+
+    /****************************************************************
+     * @brief Uses a shared manager for downloads (not owned).
+     ***************************************************************/
+    void setNetworkManager(QNetworkAccessManager *manager);
+
+    /****************************************************************
+     * @brief Sets the index page, default https://pypi.org/simple/.
+     ***************************************************************/
+    void setIndexUrl(const QString &url);
+
+    /****************************************************************
+     * @brief Loads the index file in the background; ends with
+     *        ready(). If the file is missing or was last checked
+     *        more than maxAgeSecs ago, refresh() follows.
+     * @param path Index file, created by refresh().
+     * @param maxAgeSecs Age that triggers a refresh, <0 never.
+     ***************************************************************/
+    void open(const QString &path, qint64 maxAgeSecs);
+
+    /****************************************************************
+     * @brief Downloads the index page if it changed; ends with
+     *        ready() or refreshFailed().
+     ***************************************************************/
+    void refresh();
+
+    void cancel();
+
+    bool isLoaded() const;
+    bool isRefreshing() const;
+    int size() const;
+    QDateTime updated() const;
+
+    /****************************************************************
+     * @brief Best matches for a query, best first.
+     * @param query Name or part of a name (normalized first).
+     * @param limit Maximum results.
+     ***************************************************************/
+    QStringList search(const QString &query, int limit) const;
+
+    /****************************************************************
+     * @brief Replaces the index without touching disk (for tests).
+     ***************************************************************/
+    void setNames(const QList<QByteArray> &names);
+
+    /****************************************************************
+     * @brief PEP 503 normalization of an ASCII name.
+     ***************************************************************/
+    static QByteArray normalize(QByteArrayView name);
+
+    /****************************************************************
+     * @brief Takes every complete "<a ...>name</a>" out of buffer.
+     * @param buffer Page text so far; the incomplete tail is kept.
+     * @param names Receives "name\n" per anchor.
+     * @return Number of names appended.
+     ***************************************************************/
+    static int takeAnchors(QByteArray *buffer, QByteArray *names);
+
+    /****************************************************************
+     * @brief Normalizes, sorts and de-duplicates "name\n" lines.
+     ***************************************************************/
+    static std::shared_ptr<const Names> build(const QByteArray &lines, const QByteArray &etag);
+
+    static bool save(const QString &path, const Names &names);
+    static std::shared_ptr<const Names> load(const QString &path);
+
+    /****************************************************************
+     * @brief Edit distance, or limit + 1 once it exceeds limit.
+     ***************************************************************/
+    static int boundedDistance(QByteArrayView a, QByteArrayView b, int limit);
+
+signals:
+    /****************************************************************
+     * @brief Emitted when a loaded or refreshed index is in use.
+     ***************************************************************/
+    void ready(int count);
+
+    void refreshFailed(const QString &error);
+
+    void logMessage(const QString &message);
+
+private slots:
+    void onReadyRead();
+    void onReplyFinished();
+
+private:
+    void install(std::shared_ptr<const Names> names);
+    void touch();
+
+    QNetworkAccessManager *m_manager = nullptr;
+    QString m_indexUrl;
+    QString m_path;
+    qint64 m_maxAgeSecs = -1;
+
+    std::shared_ptr<const Names> m_names;
+    QFutureWatcher<std::shared_ptr<const Names>> m_watcher;
+    bool m_refreshAfterLoad = false;
+
+    QNetworkReply *m_reply = nullptr;
+    QByteArray m_page;          ///< unparsed tail of the page
+    QByteArray m_lines;         ///< names found so far
+};
+
+#endif // PACKAGEINDEX_H
+/************** End of PackageIndex.h ***************************/
@@ -0,0 +1,280 @@
+/****************************************************************
+ * @file PackageManager.cpp
+ * @brief Implements the PackageManager class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of PackageManager.
+ * A distribution is a <name>-<version>.dist-info folder holding a
+ * METADATA file, or a *.egg-info folder/file holding PKG-INFO; the
+ * Name and Version headers are read from them.
+ ***************************************************************/
+#include "PackageManager.h"
+#include "VenvManager.h"
+#include "Telemetry.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+/****************************************************************
+ * @brief Constructor: Wires the pip process and the scan watcher.
+ ***************************************************************/
+PackageManager::PackageManager(QObject *parent) : QObject(parent)
+{
+    connect(&m_process, &QProcess::readyReadStandardOutput, this, [this]()
+            {
+                emit output(QString::fromLocal8Bit(m_process.readAllStandardOutput()), false);
+            });
+    connect(&m_process, &QProcess::readyReadStandardError, this, [this]()
+            {
+                emit output(QString::fromLocal8Bit(m_process.readAllStandardError()), true);
+            });
+    connect(&m_process, &QProcess::finished, this, &PackageManager::onProcessFinished);
+    connect(&m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error)
+            {
+                if (error == QProcess::FailedToStart && m_running)
+                {
+                    emit output(tr("Cannot start pip: %1").arg(m_process.errorString()), true);
+                    onProcessFinished(-1, QProcess::CrashExit);
+                }
+            });
+
+    connect(&m_scanWatcher, &QFutureWatcher<QVector<InstalledPackage>>::finished, this, [this]()
+            {
+                const QVector<InstalledPackage> packages = m_scanWatcher.result();
+                if (m_rescan)
+                {
+                    m_rescan = false;
+                    refresh();
+                    return;
+                }
+                emit installedChanged(packages);
+            });
+}
+
+/****************************************************************
+ * @brief Destructor: Kills a running pip and waits for the scan.
+ ***************************************************************/
+PackageManager::~PackageManager()
+{
+    m_queue.clear();
+    m_process.disconnect(this);
+    if (m_process.state() != QProcess::NotRunning)
+    {
+        m_process.kill();
+        m_process.waitForFinished(2000);
+    }
+    m_scanWatcher.waitForFinished();
+}
+
+void PackageManager::setVenv(const QString &venvPath)
+{
+    m_venv = venvPath;
+}
+
+QString PackageManager::venv() const
+{
+    return m_venv;
+}
+
+/****************************************************************
+ * @brief Re-reads the installed packages on a worker thread.
+ ***************************************************************/
+void PackageManager::refresh()
+{
+    if (m_scanWatcher.isRunning())
+    {
+        m_rescan = true;
+        return;
+    }
+    const QStringList dirs = VenvManager::sitePackagesDirs(m_venv);
+    m_scanWatcher.setFuture(QtConcurrent::run(&PackageManager::scanInstalled, dirs));
+}
+
+void PackageManager::install(const QString &spec)
+{
+    enqueue(Operation::Install, spec);
+}
+
+void PackageManager::uninstall(const QString &name)
+{
+    enqueue(Operation::Uninstall, name);
+}
+
+void PackageManager::search(const QString &name)
+{
+    enqueue(Operation::Search, name);
+}
+
+/****************************************************************
+ * @brief Kills the running job and drops queued ones.
+ ***************************************************************/
+void PackageManager::cancel()
+{
+    m_queue.clear();
+    if (m_process.state() != QProcess::NotRunning)
+    {
+        m_process.kill();
+    }
+}
+
+bool PackageManager::isBusy() const
+{
+    return m_running || !m_queue.isEmpty();
+}
+
+void PackageManager::enqueue(Operation operation, const QString &argument)
+{
+    m_queue.append(Job{operation, argument});
+    if (!m_running)
+    {
+        startNext();
+    }
+}
+
+/****************************************************************
+ * @brief Starts the next queued pip job, if any.
+ ***************************************************************/
+void PackageManager::startNext()
+{
+    if (m_running || m_queue.isEmpty())
+    {
+        return;
+    }
+    m_current = m_queue.takeFirst();
+
+    QStringList args = {"-m", "pip"};
+    switch (m_current.operation)
+    {
+    case Operation::Install:
+        args << "install" << m_current.argument;
+        break;
+    case Operation::Uninstall:
+        args << "uninstall" << "-y" << m_current.argument;
+        break;
+    case Operation::Search:
+        args << "index" << "versions" << m_current.argument;
+        break;
+    }
+    args << "--disable-pip-version-check";
+
+    m_running = true;
+    emit jobStarted(m_current.operation, m_current.argument);
+    DEBUG_MSG() << "pip" << args;
+    m_span = Telemetry::begin("pip " + args.at(2), "packages", QJsonObject{{"argument", m_current.argument}});
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
+    m_process.start(VenvManager::pythonPath(m_venv), args);
+}
+
+/****************************************************************
+ * @brief Reports a finished job, refreshes after changes, and
+ *        starts the next one.
+ ***************************************************************/
+void PackageManager::onProcessFinished(int exitCode, QProcess::ExitStatus status)
+{
+    if (!m_running)
+    {
+        return;
+    }
+    m_running = false;
+    const bool ok = status == QProcess::NormalExit && exitCode == 0;
+    Telemetry::end(m_span, ok);
+    m_span = 0;
+    emit jobFinished(m_current.operation, m_current.argument, ok);
+    if (m_current.operation != Operation::Search)
+    {
+        refresh();
+    }
+    startNext();
+}
+
+/****************************************************************
+ * @brief Reads Name and Version from a METADATA/PKG-INFO file.
+ ***************************************************************/
+bool PackageManager::readMetadata(const QString &path, InstalledPackage *package)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    // Headers end at the first blank line; the body can be huge
+    while (!file.atEnd() && (package->name.isEmpty() || package->version.isEmpty()))
+    {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty())
+        {
+            break;
+        }
+        if (line.startsWith("Name:"))
+        {
+            package->name = QString::fromUtf8(line.mid(5).trimmed());
+        }
+        else if (line.startsWith("Version:"))
+        {
+            package->version = QString::fromUtf8(line.mid(8).trimmed());
+        }
+    }
+    return !package->name.isEmpty();
+}
+
+/****************************************************************
+ * @brief Reads the distributions in site-packages folders.
+ ***************************************************************/
+QVector<InstalledPackage> PackageManager::scanInstalled(const QStringList &sitePackages)
+{
+    QVector<InstalledPackage> packages;
+    QSet<QString> seen;
+    for (int d = 0; d < sitePackages.size(); ++d)
+    {
+        const QDir dir(sitePackages.at(d));
+        const QFileInfoList entries = dir.entryInfoList(QStringList() << "*.dist-info" << "*.egg-info",
+                                                        QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot);
+        for (int i = 0; i < entries.size(); ++i)
+        {
+            const QFileInfo &entry = entries.at(i);
+            QString metadata;
+            if (entry.isFile())
+            {
+                metadata = entry.filePath();                       // legacy single-file egg-info
+            }
+            else if (entry.fileName().endsWith(".dist-info"))
+            {
+                metadata = QDir(entry.filePath()).filePath("METADATA");
+            }
+            else
+            {
+                metadata = QDir(entry.filePath()).filePath("PKG-INFO");
+            }
+
+            InstalledPackage package;
+            if (!readMetadata(metadata, &package))
+            {
+                continue;
+            }
+            const QString key = package.name.toLower();
+            if (!seen.contains(key))
+            {
+                seen.insert(key);
+                packages.append(package);
+            }
+        }
+    }
+    std::sort(packages.begin(), packages.end(), [](const InstalledPackage &a, const InstalledPackage &b)
+              {
+                  return a.name.compare(b.name, Qt::CaseInsensitive) < 0;
+              });
+    return packages;
+}
+
+/************** End of PackageManager.cpp ***********************/
@@ -0,0 +1,142 @@
+/****************************************************************
+ * @file PackageManager.h
+ * @brief Declares the PackageManager class behind the Package
+ *        Manager tab.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the PackageManager class. Nothing in it blocks
+ * the GUI thread:
+ *   - Installed packages are listed by reading the *.dist-info and
+ *     *.egg-info metadata in site-packages on a worker thread, so
+ *     no interpreter is started and a 400-package venv lists in
+ *     milliseconds.
+ *   - Install, uninstall and search run pip through one queue that
+ *     owns a single QProcess; jobs run one after another because
+ *     pip must not modify a venv twice at once. The list refreshes
+ *     itself after every change.
+ ***************************************************************/
+#ifndef PACKAGEMANAGER_H
+#define PACKAGEMANAGER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QProcess>
+#include <QFutureWatcher>
+
+/****************************************************************
+ * @struct InstalledPackage
+ * @brief One distribution found in site-packages.
+ ***************************************************************/
+struct InstalledPackage
+{
+    QString name;
+    QString version;
+};
+
+/****************************************************************
+ * @class PackageManager
+ * @brief Async pip operations and metadata-based package listing.
+ ***************************************************************/
+class PackageManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************
+     * @enum Operation
+     * @brief Kind of pip job.
+     ***************************************************************/
+    enum class Operation
+    {
+        Install,
+        Uninstall,
+        Search
+    };
+    Q_ENUM(Operation)
+
+    explicit PackageManager(QObject *parent = nullptr);
+    ~PackageManager();
+
+    /****************************************************************
+     * @brief Sets the venv whose packages are managed.
+     ***************************************************************/
+    void setVenv(const QString &venvPath);
+    QString venv() const;
+
+    /****************************************************************
+     * @brief Re-reads the installed packages; ends with
+     *        installedChanged(). Calls while a scan runs are merged.
+     ***************************************************************/
+    void refresh();
+
+    /****************************************************************
+     * @brief Queues "pip install <spec>".
+     ***************************************************************/
+    void install(const QString &spec);
+
+    /****************************************************************
+     * @brief Queues "pip uninstall -y <name>".
+     ***************************************************************/
+    void uninstall(const QString &name);
+
+    /****************************************************************
+     * @brief Queues "pip index versions <name>", which lists the
+     *        versions the index offers ("pip search" no longer
+     *        works against PyPI).
+     ***************************************************************/
+    void search(const QString &name);
+
+    /****************************************************************
+     * @brief Kills the running job and drops queued ones.
+     ***************************************************************/
+    void cancel();
+
+    bool isBusy() const;
+
+    /****************************************************************
+     * @brief Reads the distributions in site-packages folders.
+     *        Thread-safe; sorted by name, case-insensitively.
+     ***************************************************************/
+    static QVector<InstalledPackage> scanInstalled(const QStringList &sitePackages);
+
+signals:
+    void installedChanged(const QVector<InstalledPackage> &packages);
+
+    void output(const QString &text, bool isError);
+
+    void jobStarted(PackageManager::Operation operation, const QString &argument);
+
+    void jobFinished(PackageManager::Operation operation, const QString &argument, bool ok);
+
+private:
+    struct Job
+    {
+        Operation operation;
+        QString argument;
+    };
+
+    void enqueue(Operation operation, const QString &argument);
+    void startNext();
+    void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+
+    static bool readMetadata(const QString &path, InstalledPackage *package);
+
+    QString m_venv;
+    QList<Job> m_queue;
+    Job m_current;
+    QProcess m_process;
+    qint64 m_span = 0;               ///< Telemetry span of the running job
+    bool m_running = false;
+    QFutureWatcher<QVector<InstalledPackage>> m_scanWatcher;
+    bool m_rescan = false;
+};
+
+#endif // PACKAGEMANAGER_H
+/************** End of PackageManager.h *************************/
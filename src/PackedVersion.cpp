@@ -0,0 +1,609 @@
+/****************************************************************
+ * @file PackedVersion.cpp
+ * @brief Implements PackedVersion and SpecifierSet.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains a hand-written PEP 440 version parser that
+ * accepts the spellings pip normalizes ("1.0-RC1", "1.0.post",
+ * "1.0-1", "v2.0"), and the clause folding and filter passes of
+ * SpecifierSet. The comparisons inside the passes use & and | on
+ * bools rather than && and ||, so each loop body has no branch.
+ ***************************************************************/
+#include "PackedVersion.h"
+#include <algorithm>
+#include <iterator>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+namespace
+{
+const quint64 kReleaseMask = 0xFFFF000000000000ULL;
+const quint64 kMaxField = 0xFFFF;
+const quint64 kNoDev = 0xFFFF;
+const quint32 kPhaseDev = 0;
+const quint32 kPhaseFinal = 4;
+
+/****************************************************************
+ * @class Cursor
+ * @brief Walks a version string left to right.
+ ***************************************************************/
+class Cursor
+{
+public:
+    explicit Cursor(QStringView text) : m_text(text) {}
+
+    bool atEnd() const { return m_pos >= m_text.size(); }
+    QChar peek(int ahead = 0) const
+    {
+        return m_pos + ahead < m_text.size() ? m_text.at(m_pos + ahead) : QChar();
+    }
+    bool peekDigit(int ahead = 0) const
+    {
+        const char16_t c = peek(ahead).unicode();
+        return c >= '0' && c <= '9';
+    }
+    qsizetype pos() const { return m_pos; }
+    void reset(qsizetype pos) { m_pos = pos; }
+    void advance() { ++m_pos; }
+
+    /****************************************************************
+     * @brief Reads the digits at the cursor.
+     * @return false if there are none or the value exceeds limit.
+     ***************************************************************/
+    bool number(quint64 limit, quint64 *value)
+    {
+        if (!peekDigit())
+        {
+            return false;
+        }
+        quint64 result = 0;
+        bool fits = true;
+        while (peekDigit())
+        {
+            result = result * 10 + (peek().unicode() - '0');
+            fits = fits && result <= limit;
+            if (!fits)
+            {
+                result = limit + 1; // keeps the product from overflowing
+            }
+            advance();
+        }
+        *value = result;
+        return fits;
+    }
+
+    /****************************************************************
+     * @brief Takes a lowercase word, ignoring the case of the text.
+     ***************************************************************/
+    bool word(const char *text)
+    {
+        int n = 0;
+        while (text[n] != '\0')
+        {
+            if (peek(n).toLower() != QLatin1Char(text[n]))
+            {
+                return false;
+            }
+            ++n;
+        }
+        m_pos += n;
+        return true;
+    }
+
+    void separator()
+    {
+        const QChar c = peek();
+        if (c == '-' || c == '_' || c == '.')
+        {
+            advance();
+        }
+    }
+
+    /****************************************************************
+     * @brief Optional [-_.]N after a suffix word; 0 when absent.
+     ***************************************************************/
+    bool suffixNumber(quint64 limit, quint64 *value)
+    {
+        const qsizetype start = m_pos;
+        separator();
+        if (!peekDigit())
+        {
+            m_pos = start;
+            *value = 0;
+            return true;
+        }
+        return number(limit, value);
+    }
+
+private:
+    QStringView m_text;
+    qsizetype m_pos = 0;
+};
+
+/****************************************************************
+ * @brief Builds the release part from epoch and four numbers.
+ ***************************************************************/
+PackedVersion fromFields(const quint64 fields[5])
+{
+    PackedVersion packed;
+    packed.high = fields[0] << 48 | fields[1] << 32 | fields[2] << 16 | fields[3];
+    packed.low = fields[4] << 48;
+    return packed;
+}
+
+void toFields(const PackedVersion &version, quint64 fields[5])
+{
+    fields[0] = version.high >> 48;
+    fields[1] = (version.high >> 32) & kMaxField;
+    fields[2] = (version.high >> 16) & kMaxField;
+    fields[3] = version.high & kMaxField;
+    fields[4] = version.low >> 48;
+}
+
+bool next(const PackedVersion &version, PackedVersion *result)
+{
+    *result = version;
+    if (++result->low == 0 && ++result->high == 0)
+    {
+        return false;
+    }
+    return true;
+}
+
+bool previous(const PackedVersion &version, PackedVersion *result)
+{
+    *result = version;
+    if (result->low-- == 0 && result->high-- == 0)
+    {
+        return false;
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Every version whose release starts with the first length
+ *        numbers of version ("==1.24.*").
+ ***************************************************************/
+bool prefixRange(const PackedVersion &version, int length, PackedVersion *first, PackedVersion *last)
+{
+    if (length > 4)
+    {
+        // The numbers past the fourth are 0, as in every packed version
+        *first = version.releaseFirst();
+        *last = version.releaseLast();
+        return true;
+    }
+    quint64 fields[5];
+    toFields(version, fields);
+    for (int k = length + 1; k < 5; ++k)
+    {
+        fields[k] = 0;
+    }
+    *first = fromFields(fields);
+    if (++fields[length] > kMaxField)
+    {
+        return false;
+    }
+    return previous(fromFields(fields), last);
+}
+
+inline bool notBelow(const PackedVersion &v, const PackedVersion &bound)
+{
+    return (v.high > bound.high) | ((v.high == bound.high) & (v.low >= bound.low));
+}
+
+inline bool inside(const PackedVersion &v, const PackedVersion &first, const PackedVersion &last)
+{
+    return notBelow(v, first) & notBelow(last, v);
+}
+
+inline bool sameRelease(const PackedVersion &v, const PackedVersion &release)
+{
+    return (v.high == release.high) & ((v.low & kReleaseMask) == (release.low & kReleaseMask));
+}
+
+inline bool isPre(const PackedVersion &v)
+{
+    return (((v.low >> 45) & 0x7) < kPhaseFinal) | ((v.low & 0xFFFF) != kNoDev);
+}
+
+inline bool isPost(const PackedVersion &v)
+{
+    return ((v.low >> 16) & 0xFFFF) != 0;
+}
+} // namespace
+
+/****************************************************************
+ * @brief Parses epoch, release, pre, post and dev in that order.
+ ***************************************************************/
+bool PackedVersion::pack(QStringView version, PackedVersion *packed, int *releaseLength)
+{
+    Cursor cursor(version.trimmed());
+    if (cursor.peek() == 'v' || cursor.peek() == 'V')
+    {
+        cursor.advance();
+    }
+
+    quint64 fields[5] = {0, 0, 0, 0, 0};
+    quint64 value = 0;
+    if (!cursor.number(kMaxField, &value))
+    {
+        return false;
+    }
+    if (cursor.peek() == '!')
+    {
+        fields[0] = value;
+        cursor.advance();
+        if (!cursor.number(kMaxField, &value))
+        {
+            return false;
+        }
+    }
+    fields[1] = value;
+    int length = 1;
+    while (cursor.peek() == '.' && cursor.peekDigit(1))
+    {
+        cursor.advance();
+        if (!cursor.number(kMaxField, &value))
+        {
+            return false;
+        }
+        if (length < 4)
+        {
+            fields[length + 1] = value;
+        }
+        else if (value != 0)
+        {
+            return false;
+        }
+        ++length;
+    }
+
+    static const struct
+    {
+        const char *word;
+        quint32 phase;
+    } kPreWords[] = {{"alpha", 1}, {"beta", 2}, {"preview", 3}, {"pre", 3},
+                     {"rc", 3},    {"a", 1},    {"b", 2},       {"c", 3}};
+    quint32 phase = kPhaseFinal;
+    quint64 pre = 0;
+    bool hasPre = false;
+    qsizetype start = cursor.pos();
+    cursor.separator();
+    for (size_t w = 0; w < std::size(kPreWords); ++w)
+    {
+        if (cursor.word(kPreWords[w].word))
+        {
+            phase = kPreWords[w].phase;
+            hasPre = true;
+            break;
+        }
+    }
+    if (!hasPre)
+    {
+        cursor.reset(start);
+    }
+    else if (!cursor.suffixNumber(0x1FFF, &pre))
+    {
+        return false;
+    }
+
+    quint64 post = 0;
+    bool hasPost = false;
+    start = cursor.pos();
+    if (cursor.peek() == '-' && cursor.peekDigit(1))
+    {
+        // "1.0-1" is an implicit post-release
+        cursor.advance();
+        if (!cursor.number(kMaxField - 1, &post))
+        {
+            return false;
+        }
+        hasPost = true;
+    }
+    else
+    {
+        cursor.separator();
+        if (cursor.word("post") || cursor.word("rev") || cursor.word("r"))
+        {
+            if (!cursor.suffixNumber(kMaxField - 1, &post))
+            {
+                return false;
+            }
+            hasPost = true;
+        }
+        else
+        {
+            cursor.reset(start);
+        }
+    }
+
+    quint64 dev = kNoDev;
+    start = cursor.pos();
+    cursor.separator();
+    if (cursor.word("dev"))
+    {
+        if (!cursor.suffixNumber(kMaxField - 1, &dev))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        cursor.reset(start);
+    }
+
+    if (!cursor.atEnd())
+    {
+        return false; // local version or trailing text
+    }
+    if (!hasPre && !hasPost && dev != kNoDev)
+    {
+        phase = kPhaseDev; // "1.0.dev1" sorts before "1.0a1"
+    }
+
+    *packed = fromFields(fields);
+    packed->low |= quint64(phase << 13 | quint32(pre)) << 32 | (hasPost ? post + 1 : 0) << 16 | dev;
+    if (releaseLength)
+    {
+        *releaseLength = length;
+    }
+    return true;
+}
+
+bool PackedVersion::isPreRelease() const
+{
+    return isPre(*this);
+}
+
+bool PackedVersion::isPostRelease() const
+{
+    return isPost(*this);
+}
+
+PackedVersion PackedVersion::releaseFirst() const
+{
+    return PackedVersion{high, low & kReleaseMask};
+}
+
+PackedVersion PackedVersion::releaseLast() const
+{
+    return PackedVersion{high, low | ~kReleaseMask};
+}
+
+bool PackedVersion::sameRelease(const PackedVersion &other) const
+{
+    return ::sameRelease(*this, other);
+}
+
+/****************************************************************
+ * @brief Folds the clauses; the first one that cannot be packed
+ *        makes the whole set invalid.
+ ***************************************************************/
+SpecifierSet SpecifierSet::compile(const Requirement &requirement)
+{
+    SpecifierSet set;
+    if (requirement.kind != Requirement::Kind::Package || !requirement.url.isEmpty())
+    {
+        return set;
+    }
+    set.m_allowed.first = PackedVersion{0, 0};
+    set.m_allowed.last = PackedVersion{~quint64(0), ~quint64(0)};
+    for (int i = 0; i < requirement.clauses.size(); ++i)
+    {
+        const Requirement::Clause &clause = requirement.clauses.at(i);
+        if (!set.addClause(clause.op, requirement.text(clause.version)))
+        {
+            DEBUG_MSG() << "Cannot pack" << requirement.line;
+            return SpecifierSet();
+        }
+    }
+    set.m_valid = true;
+    return set;
+}
+
+bool SpecifierSet::addClause(Requirement::Op oper, QStringView version)
+{
+    const bool wildcard = version.endsWith(QLatin1StringView(".*"));
+    if (wildcard)
+    {
+        version.chop(2);
+    }
+    PackedVersion packed;
+    int length = 0;
+    if (oper == Requirement::Op::Arbitrary || !PackedVersion::pack(version, &packed, &length))
+    {
+        return false;
+    }
+
+    const PackedVersion lowest{0, 0};
+    const PackedVersion highest{~quint64(0), ~quint64(0)};
+    Range range{packed, packed};
+    if (wildcard || oper == Requirement::Op::Compatible)
+    {
+        if (wildcard && (oper != Requirement::Op::Equal && oper != Requirement::Op::NotEqual))
+        {
+            return false;
+        }
+        if (wildcard && (packed.isPreRelease() || packed.isPostRelease()))
+        {
+            return false; // a prefix is a release only
+        }
+        if (!wildcard && length < 2)
+        {
+            return false; // "~=1" is not a valid clause
+        }
+        if (!prefixRange(packed, wildcard ? length : length - 1, &range.first, &range.last))
+        {
+            return false;
+        }
+        if (oper == Requirement::Op::Compatible)
+        {
+            range.first = packed; // ~=1.4.2 is >=1.4.2, ==1.4.*
+        }
+    }
+    else if (oper == Requirement::Op::LessEqual)
+    {
+        range.first = lowest;
+    }
+    else if (oper == Requirement::Op::GreaterEqual)
+    {
+        range.last = highest;
+    }
+    else if (oper == Requirement::Op::Less)
+    {
+        range.first = lowest;
+        if (!previous(packed, &range.last))
+        {
+            range = Range{highest, lowest}; // nothing is below 0.dev0
+        }
+        if (!packed.isPreRelease())
+        {
+            m_noPreOf.append(packed.releaseFirst());
+        }
+    }
+    else if (oper == Requirement::Op::Greater)
+    {
+        range.last = highest;
+        if (!next(packed, &range.first))
+        {
+            range = Range{highest, lowest};
+        }
+        if (!packed.isPostRelease())
+        {
+            m_noPostOf.append(packed.releaseFirst());
+        }
+    }
+
+    if (oper == Requirement::Op::NotEqual)
+    {
+        m_excluded.append(range);
+        return true;
+    }
+    m_allowed.first = std::max(m_allowed.first, range.first);
+    m_allowed.last = std::min(m_allowed.last, range.last);
+    return true;
+}
+
+bool SpecifierSet::isValid() const
+{
+    return m_valid;
+}
+
+bool SpecifierSet::matches(const PackedVersion &version) const
+{
+    quint8 match = 0;
+    filter(&version, 1, &match);
+    return match != 0;
+}
+
+/****************************************************************
+ * @brief One pass per bound and exclusion over the whole array.
+ ***************************************************************/
+void SpecifierSet::filter(const PackedVersion *versions, int count, quint8 *matches) const
+{
+    if (!m_valid)
+    {
+        std::fill(matches, matches + count, quint8(0));
+        return;
+    }
+    const PackedVersion first = m_allowed.first;
+    const PackedVersion last = m_allowed.last;
+    for (int i = 0; i < count; ++i)
+    {
+        matches[i] = quint8(inside(versions[i], first, last));
+    }
+    for (int e = 0; e < m_excluded.size(); ++e)
+    {
+        const Range range = m_excluded.at(e);
+        for (int i = 0; i < count; ++i)
+        {
+            matches[i] &= quint8(!inside(versions[i], range.first, range.last));
+        }
+    }
+    for (int r = 0; r < m_noPreOf.size(); ++r)
+    {
+        const PackedVersion release = m_noPreOf.at(r);
+        for (int i = 0; i < count; ++i)
+        {
+            matches[i] &= quint8(!(sameRelease(versions[i], release) & isPre(versions[i])));
+        }
+    }
+    for (int r = 0; r < m_noPostOf.size(); ++r)
+    {
+        const PackedVersion release = m_noPostOf.at(r);
+        for (int i = 0; i < count; ++i)
+        {
+            matches[i] &= quint8(!(sameRelease(versions[i], release) & isPost(versions[i])));
+        }
+    }
+}
+
+/****************************************************************
+ * @brief The allowed range is two binary searches; each exclusion
+ *        clears only the versions inside it.
+ ***************************************************************/
+int SpecifierSet::filterSorted(const QVector<PackedVersion> &versions, QBitArray *matches) const
+{
+    matches->fill(false, int(versions.size()));
+    if (!m_valid)
+    {
+        return 0;
+    }
+    const auto lower = [&versions](const PackedVersion &bound)
+    {
+        return int(std::lower_bound(versions.cbegin(), versions.cend(), bound) - versions.cbegin());
+    };
+    const auto upper = [&versions](const PackedVersion &bound)
+    {
+        return int(std::upper_bound(versions.cbegin(), versions.cend(), bound) - versions.cbegin());
+    };
+
+    const int begin = lower(m_allowed.first);
+    const int end = upper(m_allowed.last);
+    if (end <= begin)
+    {
+        return 0;
+    }
+    matches->fill(true, begin, end);
+    for (int e = 0; e < m_excluded.size(); ++e)
+    {
+        const int from = qMax(begin, lower(m_excluded.at(e).first));
+        const int to = qMin(end, upper(m_excluded.at(e).last));
+        if (from < to)
+        {
+            matches->fill(false, from, to);
+        }
+    }
+    for (int r = 0; r < m_noPreOf.size(); ++r)
+    {
+        const int to = qMin(end, upper(m_noPreOf.at(r).releaseLast()));
+        for (int i = qMax(begin, lower(m_noPreOf.at(r))); i < to; ++i)
+        {
+            if (isPre(versions.at(i)))
+            {
+                matches->clearBit(i);
+            }
+        }
+    }
+    for (int r = 0; r < m_noPostOf.size(); ++r)
+    {
+        const int to = qMin(end, upper(m_noPostOf.at(r).releaseLast()));
+        for (int i = qMax(begin, lower(m_noPostOf.at(r))); i < to; ++i)
+        {
+            if (isPost(versions.at(i)))
+            {
+                matches->clearBit(i);
+            }
+        }
+    }
+    return matches->count(true);
+}
+
+/************** End of PackedVersion.cpp ************************/
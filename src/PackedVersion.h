@@ -0,0 +1,139 @@
+/****************************************************************
+ * @file PackedVersion.h
+ * @brief Declares PackedVersion, a PEP 440 version in two integers,
+ *        and SpecifierSet, a compiled version specifier.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines PackedVersion and SpecifierSet. A version is
+ * parsed once into 128 bits laid out so that PEP 440 order is the
+ * plain integer order of (high, low):
+ *   high  epoch 16 | release[0] 16 | release[1] 16 | release[2] 16
+ *   low   release[3] 16 | phase 3, pre 13 | post+1 16 | dev 16
+ * phase is 0 for "X.devN", 1-3 for a/b/rc and 4 for final and
+ * post releases; dev is 0xFFFF when absent. Release numbers past
+ * the fourth must be 0 (trailing zeros do not count in PEP 440).
+ * Local versions, numbers too wide for their field and "===" are
+ * not packed; callers fall back to comparing text.
+ *
+ * A SpecifierSet folds the clauses of a requirement into one
+ * inclusive range plus a few exclusions ("!=", "!=X.*", and the
+ * pre-/post-release rules of "<" and ">"). filter() applies each to
+ * a whole array in its own branch-free pass, which compilers turn
+ * into vector code; filterSorted() finds the same answer in a
+ * sorted array with binary searches. Whether pre-releases are
+ * candidates at all stays the caller's policy.
+ ***************************************************************/
+#ifndef PACKEDVERSION_H
+#define PACKEDVERSION_H
+
+#include <QBitArray>
+#include <QStringView>
+#include <QVector>
+#include "Requirement.h"
+
+/****************************************************************
+ * @struct PackedVersion
+ * @brief A PEP 440 version ordered by integer comparison.
+ ***************************************************************/
+struct PackedVersion
+{
+    quint64 high = 0;
+    quint64 low = 0;
+
+    /****************************************************************
+     * @brief Parses a public version ("v1!2.0rc1.post2.dev3").
+     * @param releaseLength Release numbers written ("1.24" -> 2).
+     * @return false if it is not a PEP 440 version or does not fit.
+     ***************************************************************/
+    static bool pack(QStringView version, PackedVersion *packed, int *releaseLength = nullptr);
+
+    bool isPreRelease() const;   ///< a, b, rc or dev
+    bool isPostRelease() const;
+
+    /****************************************************************
+     * @brief Lowest and highest versions of the same epoch and
+     *        release ("1.4" -> 1.4.dev0 ... 1.4.postN.devN).
+     ***************************************************************/
+    PackedVersion releaseFirst() const;
+    PackedVersion releaseLast() const;
+
+    bool sameRelease(const PackedVersion &other) const;
+};
+
+inline bool operator==(const PackedVersion &a, const PackedVersion &b)
+{
+    return a.high == b.high && a.low == b.low;
+}
+
+inline bool operator!=(const PackedVersion &a, const PackedVersion &b)
+{
+    return !(a == b);
+}
+
+inline bool operator<(const PackedVersion &a, const PackedVersion &b)
+{
+    return a.high < b.high || (a.high == b.high && a.low < b.low);
+}
+
+inline bool operator<=(const PackedVersion &a, const PackedVersion &b)
+{
+    return !(b < a);
+}
+
+/****************************************************************
+ * @class SpecifierSet
+ * @brief The version clauses of one requirement, compiled.
+ ***************************************************************/
+class SpecifierSet
+{
+public:
+    /****************************************************************
+     * @brief Compiles the clauses of a named requirement.
+     * @return An invalid set for "===", URLs and versions that
+     *         PackedVersion cannot hold.
+     ***************************************************************/
+    static SpecifierSet compile(const Requirement &requirement);
+
+    bool isValid() const;
+
+    bool matches(const PackedVersion &version) const;
+
+    /****************************************************************
+     * @brief Sets matches[i] to 1 if versions[i] is allowed, else 0.
+     *        The versions may be in any order.
+     ***************************************************************/
+    void filter(const PackedVersion *versions, int count, quint8 *matches) const;
+
+    /****************************************************************
+     * @brief Same answer for versions sorted ascending, found with
+     *        binary searches; only the exclusions are walked.
+     * @return Number of versions allowed.
+     ***************************************************************/
+    int filterSorted(const QVector<PackedVersion> &versions, QBitArray *matches) const;
+
+private:
+    /****************************************************************
+     * @struct Range
+     * @brief Inclusive interval of packed versions.
+     ***************************************************************/
+    struct Range
+    {
+        PackedVersion first;
+        PackedVersion last;
+    };
+
+    bool addClause(Requirement::Op oper, QStringView version);
+
+    bool m_valid = false;
+    Range m_allowed;                     ///< intersection of the bounds
+    QVector<Range> m_excluded;           ///< "!=" and "!=X.*"
+    QVector<PackedVersion> m_noPreOf;    ///< "<V": no pre-release of V's release
+    QVector<PackedVersion> m_noPostOf;   ///< ">V": no post-release of V's release
+};
+
+#endif // PACKEDVERSION_H
+/************** End of PackedVersion.h **************************/
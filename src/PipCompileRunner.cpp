@@ -0,0 +1,495 @@
+/****************************************************************
+ * @file PipCompileRunner.cpp
+ * @brief Implements the PipCompileRunner class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of PipCompileRunner class.
+ * Each test gets its own folder under the work dir holding the
+ * requirements.in that was compiled and the resulting output.
+ * Worker state lives under work dir/worker_<n>/ (venv, pip-cache,
+ * tmp) and survives between resolves.
+ ***************************************************************/
+#include "PipCompileRunner.h"
+#include "VenvManager.h"
+#include "Telemetry.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+/****************************************************************
+ * @brief Constructor: Initializes an idle runner.
+ ***************************************************************/
+PipCompileRunner::PipCompileRunner(QObject *parent) : QObject(parent)
+{
+    m_workDir = QDir::temp().filePath("PipMatrixResolver");
+}
+
+/****************************************************************
+ * @brief Destructor: Kills any running pip-compile.
+ ***************************************************************/
+PipCompileRunner::~PipCompileRunner()
+{
+    cancelAll();
+    destroyPool();
+}
+
+void PipCompileRunner::setBaseVenv(const QString &venvPath)
+{
+    if (venvPath != m_baseVenv)
+    {
+        m_baseVenv = venvPath;
+        m_poolDirty = true;
+    }
+}
+
+void PipCompileRunner::setWorkerCount(int count)
+{
+    count = qMax(1, count);
+    if (count != m_workerCount)
+    {
+        m_workerCount = count;
+        m_poolDirty = true;
+    }
+}
+
+int PipCompileRunner::workerCount() const
+{
+    return m_workers.isEmpty() ? m_workerCount : int(m_workers.size());
+}
+
+void PipCompileRunner::setWorkDir(const QString &dir)
+{
+    if (dir != m_workDir)
+    {
+        m_workDir = dir;
+        m_poolDirty = true;
+    }
+}
+
+void PipCompileRunner::setTimeoutMs(int timeoutMs)
+{
+    m_timeoutMs = timeoutMs;
+}
+
+/****************************************************************
+ * @brief Resolves against a local wheelhouse.
+ ***************************************************************/
+void PipCompileRunner::setFindLinks(const QString &findLinks, bool offline)
+{
+    m_findLinks = findLinks;
+    m_offline = offline && !findLinks.isEmpty();
+}
+
+QString PipCompileRunner::findLinks() const
+{
+    return m_findLinks;
+}
+
+bool PipCompileRunner::isOffline() const
+{
+    return m_offline;
+}
+
+QString PipCompileRunner::baseVenv() const
+{
+    return m_baseVenv;
+}
+
+/****************************************************************
+ * @brief Kills running tests and drops queued ones. Workers and
+ *        their venv clones are kept for the next resolve.
+ ***************************************************************/
+void PipCompileRunner::cancelAll()
+{
+    m_queue.clear();
+    for (int i = 0; i < m_workers.size(); ++i)
+    {
+        Worker *worker = m_workers.at(i);
+        const bool running = worker->testId != 0;
+        worker->testId = 0;
+        if (worker->process && worker->process->state() != QProcess::NotRunning)
+        {
+            worker->process->disconnect(this);
+            worker->process->kill();
+            worker->process->waitForFinished(2000);
+        }
+        releaseProcess(worker);
+        if (running)
+        {
+            QDir(QFileInfo(worker->outputPath).absolutePath()).removeRecursively();
+        }
+    }
+}
+
+/****************************************************************
+ * @brief Removes the folders passed tests left behind.
+ ***************************************************************/
+void PipCompileRunner::discardOutputs(const QString &keepPath)
+{
+    const QString keep = keepPath.isEmpty() ? QString() : QFileInfo(keepPath).absolutePath();
+    for (int i = 0; i < m_passedDirs.size(); ++i)
+    {
+        if (m_passedDirs.at(i) != keep)
+        {
+            QDir(m_passedDirs.at(i)).removeRecursively();
+        }
+    }
+    m_passedDirs.clear();
+}
+
+/****************************************************************
+ * @brief Queues a set of pins for compilation.
+ ***************************************************************/
+void PipCompileRunner::runTest(int testId, const QStringList &pins)
+{
+    m_queue.append(qMakePair(testId, pins));
+    ensurePool();
+    startNext();
+}
+
+/****************************************************************
+ * @brief Rebuilds the pool if settings changed and nothing runs.
+ ***************************************************************/
+void PipCompileRunner::ensurePool()
+{
+    if (!m_poolDirty || isBusy())
+    {
+        return;
+    }
+    const int previous = workerCount();
+    destroyPool();
+    m_poolDirty = false;
+    ++m_generation;
+
+    emit outputReceived(QString("Preparing %1 pip-compile worker(s) from %2")
+                            .arg(m_workerCount).arg(m_baseVenv), false);
+    for (int i = 0; i < m_workerCount; ++i)
+    {
+        Worker *worker = new Worker;
+        worker->index = i;
+        worker->rootDir = QDir(m_workDir).filePath(QString("worker_%1").arg(i));
+        worker->timer = new QTimer(this);
+        worker->timer->setSingleShot(true);
+        connect(worker->timer, &QTimer::timeout, this, [this, worker]()
+                {
+                    if (worker->process && worker->process->state() != QProcess::NotRunning)
+                    {
+                        emit outputReceived(QString("pip-compile timed out after %1 ms").arg(m_timeoutMs), true);
+                        worker->timedOut = true;
+                        worker->process->kill(); // finished() follows and reports an error
+                    }
+                });
+        m_workers.append(worker);
+        prepareWorker(worker);
+    }
+    if (m_workerCount != previous)
+    {
+        emit workerCountChanged(m_workerCount);
+    }
+}
+
+/****************************************************************
+ * @brief Creates the worker folders and clones the base venv in
+ *        the background. The worker accepts tests once ready.
+ ***************************************************************/
+void PipCompileRunner::prepareWorker(Worker *worker)
+{
+    QDir root(worker->rootDir);
+    root.mkpath("pip-cache");
+    root.mkpath("tmp");
+
+    const QString source = m_baseVenv;
+    const QString target = root.filePath("venv");
+    const int generation = m_generation;
+    const int index = worker->index;
+    const qint64 span = Telemetry::begin("worker venv clone", QString("worker %1").arg(index));
+
+    QFutureWatcher<QString> *watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this,
+            [this, watcher, generation, index, source, target, span]()
+            {
+                const QString error = watcher->result();
+                watcher->deleteLater();
+                Telemetry::end(span, error.isEmpty());
+                if (generation != m_generation || index >= m_workers.size())
+                {
+                    return; // pool was rebuilt while cloning
+                }
+                Worker *worker = m_workers.at(index);
+                if (error.isEmpty())
+                {
+                    worker->pythonExe = VenvManager::pythonPath(target);
+                }
+                else
+                {
+                    emit outputReceived(QString("Worker %1: %2; using base venv").arg(index).arg(error), true);
+                    worker->pythonExe = VenvManager::pythonPath(source);
+                }
+                worker->ready = true;
+                startNext();
+            });
+    watcher->setFuture(QtConcurrent::run([source, target]()
+                                         {
+                                             QString error;
+                                             if (!VenvManager::cloneVenv(source, target, &error, VenvManager::CloneMode::Fast))
+                                             {
+                                                 return error.isEmpty() ? QString("clone failed") : error;
+                                             }
+                                             return QString();
+                                         }));
+}
+
+/****************************************************************
+ * @brief Hands queued tests to every idle, ready worker.
+ ***************************************************************/
+void PipCompileRunner::startNext()
+{
+    for (int i = 0; i < m_workers.size() && !m_queue.isEmpty(); ++i)
+    {
+        Worker *worker = m_workers.at(i);
+        if (worker->ready && !worker->process)
+        {
+            const QPair<int, QStringList> job = m_queue.takeFirst();
+            startOn(worker, job.first, job.second);
+        }
+    }
+}
+
+/****************************************************************
+ * @brief Writes requirements.in for a test and starts it on a worker.
+ ***************************************************************/
+void PipCompileRunner::startOn(Worker *worker, int testId, const QStringList &pins, bool online)
+{
+    worker->testId = testId;
+    worker->pins = pins;
+    worker->online = online;
+    worker->stderrData.clear();
+    worker->classifier.reset();
+    worker->timedOut = false;
+
+    const QString testDir = QDir(m_workDir).filePath(QString("test_%1").arg(testId));
+    QDir().mkpath(testDir);
+    const QString inPath = QDir(testDir).filePath("requirements.in");
+    worker->outputPath = QDir(testDir).filePath("requirements.txt");
+
+    QFile inFile(inPath);
+    if (!inFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+    {
+        emit outputReceived(QString("Cannot write %1").arg(inPath), true);
+        finish(worker, TestOutcome::Error);
+        return;
+    }
+    QTextStream out(&inFile);
+    for (int i = 0; i < pins.size(); ++i)
+    {
+        out << pins.at(i) << "\n";
+    }
+    inFile.close();
+
+    worker->process = new QProcess(this);
+    worker->process->setWorkingDirectory(testDir);
+    worker->process->setProcessEnvironment(environmentFor(worker));
+    connect(worker->process, &QProcess::readyReadStandardError, this, [worker]()
+            {
+                const QByteArray chunk = worker->process->readAllStandardError();
+                worker->stderrData += chunk;
+                if (!worker->classifier.isDecided() && worker->classifier.feed(chunk))
+                {
+                    // The outcome is known; pip would only wind down
+                    DEBUG_MSG() << "early exit" << worker->testId << worker->classifier.reason();
+                    Telemetry::add(Telemetry::Counter::EarlyExits);
+                    worker->process->kill(); // finished() follows and fails the test
+                }
+            });
+    connect(worker->process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, [this, worker](int exitCode, QProcess::ExitStatus exitStatus)
+            {
+                const QByteArray rest = worker->process->readAllStandardError();
+                worker->stderrData += rest;
+                const bool passed = exitStatus == QProcess::NormalExit && exitCode == 0;
+                if (!passed && m_offline && !worker->online && !worker->timedOut)
+                {
+                    // The wheelhouse may lack a version only this combination
+                    // needs; only the index can say whether the pins fail.
+                    emit outputReceived(QString("Test %1 failed offline; compiling online").arg(worker->testId), false);
+                    const int testId = worker->testId;
+                    const QStringList pins = worker->pins;
+                    releaseProcess(worker);
+                    startOn(worker, testId, pins, true);
+                    return;
+                }
+                if (!passed && !worker->stderrData.isEmpty())
+                {
+                    emit outputReceived(QString::fromUtf8(worker->stderrData), true);
+                }
+                emit testLog(worker->testId, worker->pins, passed, worker->stderrData);
+                if (passed)
+                {
+                    finish(worker, TestOutcome::Passed);
+                    return;
+                }
+                const bool classified = worker->classifier.feed(rest) || worker->classifier.finish();
+                const bool environment = classified && worker->classifier.kind() == FailureClassifier::Kind::Environment;
+                // Only a recognized verdict of pip's is a verdict on the pins;
+                // an unexplained exit (our early kill is always explained)
+                // may be a pip/pip-tools mismatch failing every set alike.
+                if (worker->timedOut || environment || !classified)
+                {
+                    finish(worker, TestOutcome::Error);
+                    return;
+                }
+                if (classified)
+                {
+                    emit failureClassified(worker->testId,
+                                           FailureClassifier::kindName(worker->classifier.kind()),
+                                           worker->classifier.packages());
+                }
+                finish(worker, TestOutcome::Failed);
+            });
+    connect(worker->process, &QProcess::errorOccurred, this, [this, worker](QProcess::ProcessError error)
+            {
+                // Only start failures end a test here; crashes arrive via finished().
+                if (error == QProcess::FailedToStart)
+                {
+                    emit outputReceived(QString("Failed to start %1").arg(worker->pythonExe), true);
+                    finish(worker, TestOutcome::Error);
+                }
+            });
+
+    QStringList args;
+    args << "-m" << "piptools" << "compile"
+         << "--quiet" << "--no-header" << "--no-annotate"
+         << "--output-file" << worker->outputPath;
+    if (!m_findLinks.isEmpty())
+    {
+        args << "--find-links" << m_findLinks << "--no-emit-find-links";
+        if (m_offline && !worker->online)
+        {
+            args << "--no-index";
+        }
+    }
+    args << inPath;
+
+    DEBUG_MSG() << "worker" << worker->index << "test" << testId << pins;
+    worker->span = Telemetry::begin("pip-compile", QString("worker %1").arg(worker->index),
+                                    QJsonObject{{"test", testId}, {"pins", pins.join(", ")}});
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
+    if (m_timeoutMs > 0)
+    {
+        worker->timer->start(m_timeoutMs);
+    }
+    worker->process->start(worker->pythonExe, args);
+}
+
+/****************************************************************
+ * @brief Builds the isolated environment for a worker's process.
+ ***************************************************************/
+QProcessEnvironment PipCompileRunner::environmentFor(const Worker *worker) const
+{
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    const QDir root(worker->rootDir);
+    const QString tmp = QDir::toNativeSeparators(root.filePath("tmp"));
+    const QString binDir = QFileInfo(worker->pythonExe).absolutePath();
+
+    env.insert("PIP_CACHE_DIR", QDir::toNativeSeparators(root.filePath("pip-cache")));
+    env.insert("PIP_DISABLE_PIP_VERSION_CHECK", "1");
+    env.insert("TMP", tmp);
+    env.insert("TEMP", tmp);
+    env.insert("TMPDIR", tmp);
+    env.insert("VIRTUAL_ENV", QDir::toNativeSeparators(QFileInfo(binDir).absolutePath()));
+    env.insert("PATH", QDir::toNativeSeparators(binDir) + QDir::listSeparator() + env.value("PATH"));
+    env.remove("PYTHONHOME");
+    return env;
+}
+
+/****************************************************************
+ * @brief Reports a worker's test and gives it the next one.
+ ***************************************************************/
+void PipCompileRunner::finish(Worker *worker, TestOutcome outcome)
+{
+    const int testId = worker->testId;
+    const QString outputPath = worker->outputPath;
+    const bool passed = outcome == TestOutcome::Passed;
+    worker->testId = 0;
+    Telemetry::end(worker->span, passed);
+    worker->span = 0;
+    releaseProcess(worker);
+
+    // Its stderr went out with testLog(); only a pass has output
+    const QString testDir = QFileInfo(outputPath).absolutePath();
+    if (testId != 0 && !passed)
+    {
+        QDir(testDir).removeRecursively();
+    }
+    else if (testId != 0)
+    {
+        m_passedDirs << testDir;
+    }
+
+    // The worker may be rebuilt by a runTest() issued from the
+    // receiver, so it must not be touched after this emit.
+    if (testId != 0)
+    {
+        emit testFinished(testId, outcome, passed ? outputPath : QString());
+    }
+    startNext();
+}
+
+/****************************************************************
+ * @brief Detaches and schedules deletion of a worker's process.
+ ***************************************************************/
+void PipCompileRunner::releaseProcess(Worker *worker)
+{
+    Telemetry::end(worker->span, false); // cancelled
+    worker->span = 0;
+    worker->timer->stop();
+    if (worker->process)
+    {
+        worker->process->disconnect(this);
+        worker->process->deleteLater();
+        worker->process = nullptr;
+    }
+}
+
+/****************************************************************
+ * @brief Deletes all workers; callers ensure none is running.
+ ***************************************************************/
+void PipCompileRunner::destroyPool()
+{
+    for (int i = 0; i < m_workers.size(); ++i)
+    {
+        Worker *worker = m_workers.at(i);
+        releaseProcess(worker);
+        delete worker->timer;
+        delete worker;
+    }
+    m_workers.clear();
+}
+
+/****************************************************************
+ * @brief Checks whether any worker has a process running.
+ ***************************************************************/
+bool PipCompileRunner::isBusy() const
+{
+    for (int i = 0; i < m_workers.size(); ++i)
+    {
+        if (m_workers.at(i)->process)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/************** End of PipCompileRunner.cpp *********************/
@@ -0,0 +1,214 @@
+/****************************************************************
+ * @file PipCompileRunner.h
+ * @brief Declares the PipCompileRunner class that runs resolver tests.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the PipCompileRunner class. It receives pin
+ * sets from ResolverEngine::testRequested(), writes them to a
+ * requirements.in and runs "python -m piptools compile" on it.
+ * The outcome is reported back through testFinished().
+ *
+ * Tests run on a pool of N workers. Each worker owns a clone of
+ * the base venv (venv_testing), its own temp folder and its own
+ * PIP_CACHE_DIR, so concurrent pip processes never share state.
+ * Clones are copy-on-write where the filesystem allows (see
+ * VenvManager), made in the background and reused between resolves
+ * until the base venv is recreated.
+ *
+ * stderr is matched by a FailureClassifier as it arrives: a test
+ * whose failure is already certain (ResolutionImpossible, no
+ * matching distribution, a failed build) is killed at once, and
+ * the packages pip blamed go out through failureClassified().
+ *
+ * Only pip's own verdict is reported as Passed or Failed: exit 0,
+ * or a failure the classifier recognized. A timeout, a process
+ * that does not start or crashes, an unwritable test folder, an
+ * exit the classifier cannot explain and its Environment kind
+ * (unreachable index, broken venv, a traceback of pip itself) are
+ * TestOutcome::Error, which is never cached.
+ ***************************************************************/
+#ifndef PIPCOMPILERUNNER_H
+#define PIPCOMPILERUNNER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QPair>
+#include <QVector>
+#include <QProcess>
+#include <QTimer>
+#include "FailureClassifier.h"
+#include "TestOutcome.h"
+
+/****************************************************************
+ * @class PipCompileRunner
+ * @brief Runs queued pip-compile tests on a pool of workers.
+ ***************************************************************/
+class PipCompileRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PipCompileRunner(QObject *parent = nullptr);
+    ~PipCompileRunner();
+
+    /****************************************************************
+     * @brief Sets the venv (with pip-tools installed) that every
+     *        worker clones.
+     * @param venvPath Root folder of the base venv.
+     ***************************************************************/
+    void setBaseVenv(const QString &venvPath);
+
+    /****************************************************************
+     * @brief Sets the number of concurrent pip-compile processes.
+     *        Takes effect the next time the pool is idle.
+     * @param count Worker count (minimum 1).
+     ***************************************************************/
+    void setWorkerCount(int count);
+
+    /****************************************************************
+     * @brief Workers in the current pool, which lags setWorkerCount()
+     *        until the pool is rebuilt; the requested count before
+     *        the first pool exists.
+     ***************************************************************/
+    int workerCount() const;
+
+    /****************************************************************
+     * @brief Sets the scratch directory for workers and tests.
+     * @param dir Directory, created on demand.
+     ***************************************************************/
+    void setWorkDir(const QString &dir);
+
+    /****************************************************************
+     * @brief Sets the per-test timeout; a timed out test is an
+     *        Error, not a failure.
+     * @param timeoutMs Milliseconds, 0 disables the timeout.
+     ***************************************************************/
+    void setTimeoutMs(int timeoutMs);
+
+    /****************************************************************
+     * @brief Resolves against a local wheelhouse (see Wheelhouse).
+     * @param findLinks Page or folder for --find-links, empty to
+     *        use the package index only.
+     * @param offline true adds --no-index. Each pin's wheel brings
+     *        only its own dependency closure, so a test that fails
+     *        offline is compiled again online before it is reported.
+     ***************************************************************/
+    void setFindLinks(const QString &findLinks, bool offline);
+    QString findLinks() const;
+    bool isOffline() const;
+
+    QString baseVenv() const;
+
+    /****************************************************************
+     * @brief Kills running tests and drops queued ones; no
+     *        results are reported for them.
+     ***************************************************************/
+    void cancelAll();
+
+    /****************************************************************
+     * @brief Deletes the folders of passed tests; the cache holds a
+     *        copy of what mattered by now.
+     * @param keepPath outputPath of a test to keep, e.g. the winner.
+     ***************************************************************/
+    void discardOutputs(const QString &keepPath = QString());
+
+public slots:
+    /****************************************************************
+     * @brief Compiles a set of pins on the next free worker.
+     * @param testId Identifier echoed back in testFinished().
+     * @param pins Requirement lines for requirements.in.
+     ***************************************************************/
+    void runTest(int testId, const QStringList &pins);
+
+signals:
+    /****************************************************************
+     * @brief Emitted when a test completes.
+     * @param testId Identifier given to runTest().
+     * @param outcome Passed if pip-compile exited with code 0,
+     *        Failed if FailureClassifier recognized pip rejecting
+     *        the pins, Error for any other exit.
+     * @param outputPath Compiled requirements.txt of a passed test;
+     *        it stays until discardOutputs(). The folder of any
+     *        other test is gone once testLog() has been emitted.
+     ***************************************************************/
+    void testFinished(int testId, TestOutcome outcome, const QString &outputPath);
+
+    /****************************************************************
+     * @brief Emitted with pip-compile stderr text and pool status.
+     ***************************************************************/
+    void outputReceived(const QString &output, bool isError);
+
+    /****************************************************************
+     * @brief Emitted for every finished test with its full pip-compile
+     *        stderr, for the on-disk log (see LogWriter::writeTest).
+     ***************************************************************/
+    void testLog(int testId, const QStringList &pins, bool passed, const QByteArray &output);
+
+    /****************************************************************
+     * @brief Emitted right before testFinished() of a failed test
+     *        whose stderr matched a known failure.
+     * @param kind FailureClassifier::kindName().
+     * @param packages Normalized names pip blamed (may be empty).
+     ***************************************************************/
+    void failureClassified(int testId, const QString &kind, const QStringList &packages);
+
+    /****************************************************************
+     * @brief Emitted when a rebuilt pool changes workerCount().
+     ***************************************************************/
+    void workerCountChanged(int count);
+
+private:
+    /****************************************************************
+     * @struct Worker
+     * @brief One pool slot with its isolated venv, cache and temp.
+     ***************************************************************/
+    struct Worker
+    {
+        int index = 0;
+        QString rootDir;
+        QString pythonExe;
+        bool ready = false;
+        QProcess *process = nullptr;
+        QTimer *timer = nullptr;
+        int testId = 0;
+        QStringList pins;
+        QString outputPath;
+        QByteArray stderrData;
+        FailureClassifier classifier;
+        bool timedOut = false;
+        bool online = false;         ///< rerun of an offline failure
+        qint64 span = 0;             ///< Telemetry span of the running test
+    };
+
+    void ensurePool();
+    void prepareWorker(Worker *worker);
+    void startNext();
+    void startOn(Worker *worker, int testId, const QStringList &pins, bool online = false);
+    void finish(Worker *worker, TestOutcome outcome);
+    void releaseProcess(Worker *worker);
+    void destroyPool();
+    bool isBusy() const;
+    QProcessEnvironment environmentFor(const Worker *worker) const;
+
+    QString m_baseVenv;
+    QString m_workDir;
+    int m_workerCount = 1;
+    int m_timeoutMs = 0;
+    QString m_findLinks;
+    bool m_offline = false;
+    int m_generation = 0;                    ///< bumps when the pool is rebuilt
+    bool m_poolDirty = true;                 ///< settings changed since last build
+
+    QVector<Worker *> m_workers;
+    QList<QPair<int, QStringList>> m_queue;
+    QStringList m_passedDirs;                ///< test folders kept for their output
+};
+
+#endif // PIPCOMPILERUNNER_H
+/************** End of PipCompileRunner.h ***********************/
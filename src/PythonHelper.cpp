@@ -0,0 +1,413 @@
+/****************************************************************
+ * @file PythonHelper.cpp
+ * @brief Implements the PythonHelper class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of PythonHelper and the
+ * helper script. The script keeps the real stdout for the protocol
+ * and points sys.stdout at stderr, so a .pth hook or anything else
+ * that prints cannot break a reply; stderr is discarded.
+ ***************************************************************/
+#include "PythonHelper.h"
+#include "Telemetry.h"
+#include <QDeadlineTimer>
+#include <QJsonDocument>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const char kHelperScript[] = R"PY(
+import importlib.metadata as metadata, json, platform, re, sys
+
+reply = sys.stdout
+sys.stdout = sys.stderr
+
+def canonical(name):
+    return re.sub(r"[-_.]+", "-", name).lower()
+
+def dependencies(dist):
+    names = []
+    for line in dist.requires or []:
+        if "extra" in line.partition(";")[2]:
+            continue
+        match = re.match(r"[A-Za-z0-9._-]+", line)
+        if match:
+            names.append(match.group(0))
+    return names
+
+def distributions():
+    found = {}
+    for dist in metadata.distributions():
+        name = dist.metadata["Name"]
+        if name and canonical(name) not in found:
+            found[canonical(name)] = dist
+    return found
+
+def op_ping(request):
+    return "pong"
+
+def op_version(request):
+    found = distributions()
+    pip = found.get("pip")
+    tools = found.get("pip-tools")
+    return {"python": platform.python_version(), "executable": sys.executable, "prefix": sys.prefix,
+            "pip": pip.version if pip else None,
+            "pip-location": str(pip.locate_file("pip")) if pip else None,
+            "pip-tools": tools.version if tools else None}
+
+def op_list(request):
+    found = distributions()
+    return [{"name": found[key].metadata["Name"], "version": found[key].version} for key in sorted(found)]
+
+def op_show(request):
+    found = distributions()
+    shown = []
+    for name in request.get("names", []):
+        dist = found.get(canonical(name))
+        if dist is None:
+            continue
+        meta = dist.metadata
+        required_by = sorted(other.metadata["Name"] for other in found.values()
+                             if canonical(name) in [canonical(n) for n in dependencies(other)])
+        shown.append({"name": meta["Name"], "version": dist.version, "summary": meta["Summary"] or "",
+                      "home-page": meta["Home-page"] or "", "author": meta["Author"] or "",
+                      "author-email": meta["Author-email"] or "", "license": meta["License"] or "",
+                      "location": str(dist.locate_file("")), "requires": dependencies(dist),
+                      "required-by": required_by})
+    return shown
+
+OPS = {"ping": op_ping, "version": op_version, "list": op_list, "show": op_show}
+
+while True:
+    line = sys.stdin.buffer.readline()
+    if not line:
+        break
+    if not line.strip():
+        continue
+    request = {}
+    try:
+        request = json.loads(line.decode("utf-8"))
+        answer = {"id": request.get("id"), "ok": True, "result": OPS[request["op"]](request)}
+    except BaseException as error:
+        answer = {"id": request.get("id") if isinstance(request, dict) else None, "ok": False,
+                  "error": "%s: %s" % (type(error).__name__, error)}
+    reply.write(json.dumps(answer) + "\n")
+    reply.flush()
+)PY";
+
+/****************************************************************
+ * @brief Constructor.
+ ***************************************************************/
+PythonHelper::PythonHelper(QObject *parent) : QObject(parent)
+{
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setInterval(kDefaultIdleTimeoutMs);
+    connect(&m_idleTimer, &QTimer::timeout, this, [this]()
+            {
+                if (m_pending.isEmpty())
+                {
+                    DEBUG_MSG() << "python helper idle, stopping" << m_python;
+                    stop();
+                }
+                else
+                {
+                    m_idleTimer.start();
+                }
+            });
+}
+
+/****************************************************************
+ * @brief Destructor: the helper goes with the object.
+ ***************************************************************/
+PythonHelper::~PythonHelper()
+{
+    if (m_process)
+    {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished(2000);
+    }
+}
+
+void PythonHelper::setPython(const QString &pythonExe)
+{
+    if (pythonExe == m_python)
+    {
+        return;
+    }
+    stop();
+    m_python = pythonExe;
+}
+
+QString PythonHelper::python() const
+{
+    return m_python;
+}
+
+void PythonHelper::setIdleTimeout(int ms)
+{
+    m_idleTimer.setInterval(qMax(0, ms));
+    if (ms <= 0)
+    {
+        m_idleTimer.stop();
+    }
+}
+
+int PythonHelper::idleTimeout() const
+{
+    return m_idleTimer.interval();
+}
+
+bool PythonHelper::isRunning() const
+{
+    return m_process && m_process->state() == QProcess::Running;
+}
+
+int PythonHelper::launches() const
+{
+    return m_launches;
+}
+
+/****************************************************************
+ * @brief Sends a request answered through replied().
+ ***************************************************************/
+int PythonHelper::request(const QString &op, const QJsonObject &args)
+{
+    QString error;
+    const int id = send(op, args, &error);
+    if (id == 0)
+    {
+        qWarning() << "Python helper:" << error;
+    }
+    return id;
+}
+
+/****************************************************************
+ * @brief Sends a request and waits for its line.
+ ***************************************************************/
+bool PythonHelper::call(const QString &op, const QJsonObject &args, int timeoutMs, QJsonValue *result,
+                        QString *error)
+{
+    QString sendError;
+    const int id = send(op, args, &sendError);
+    if (id == 0)
+    {
+        if (error)
+        {
+            *error = sendError;
+        }
+        return false;
+    }
+    m_waiting.insert(id);
+
+    QDeadlineTimer deadline(timeoutMs);
+    while (!m_replies.contains(id) && m_process && !deadline.hasExpired())
+    {
+        // Writes the request too; readyRead runs readReplies()
+        QProcess *process = m_process;
+        if (!process->waitForReadyRead(int(qMax<qint64>(1, deadline.remainingTime())))
+            && m_process == process && process->state() == QProcess::NotRunning)
+        {
+            onExited();
+        }
+    }
+    m_waiting.remove(id);
+    if (!m_replies.contains(id))
+    {
+        // A helper stuck in one request would stall every later one
+        Telemetry::end(m_pending.take(id), false);
+        stop();
+        if (error)
+        {
+            *error = tr("Python helper did not answer \"%1\" within %2 ms").arg(op).arg(timeoutMs);
+        }
+        return false;
+    }
+    const Reply reply = m_replies.take(id);
+    if (result)
+    {
+        *result = reply.result;
+    }
+    if (error)
+    {
+        *error = reply.error;
+    }
+    return reply.ok;
+}
+
+/****************************************************************
+ * @brief Kills the helper; onExited() fails what was pending.
+ ***************************************************************/
+void PythonHelper::stop()
+{
+    m_idleTimer.stop();
+    if (!m_process)
+    {
+        return;
+    }
+    if (m_process->state() != QProcess::NotRunning)
+    {
+        m_process->closeWriteChannel();
+        m_process->kill();
+        m_process->waitForFinished(2000);
+    }
+    if (m_process)
+    {
+        onExited();
+    }
+}
+
+QByteArray PythonHelper::script()
+{
+    return QByteArray(kHelperScript);
+}
+
+/****************************************************************
+ * @brief Starts the interpreter unless it runs already.
+ ***************************************************************/
+bool PythonHelper::ensureStarted(QString *error)
+{
+    if (isRunning())
+    {
+        return true;
+    }
+    if (m_python.isEmpty())
+    {
+        *error = tr("No Python interpreter set for the helper");
+        return false;
+    }
+    if (m_process)
+    {
+        onExited();
+    }
+
+    m_process = new QProcess(this);
+    m_process->setStandardErrorFile(QProcess::nullDevice());
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &PythonHelper::readReplies);
+    connect(m_process, &QProcess::finished, this, &PythonHelper::onExited);
+    connect(m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError processError)
+            {
+                if (processError == QProcess::FailedToStart)
+                {
+                    onExited();
+                }
+            });
+
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
+    ++m_launches;
+    m_partial.clear();
+    m_process->start(m_python, {"-u", "-c", QString::fromUtf8(kHelperScript)});
+    if (!m_process || !m_process->waitForStarted(10000))
+    {
+        *error = tr("Cannot start the Python helper with %1").arg(m_python);
+        if (m_process)
+        {
+            onExited();
+        }
+        return false;
+    }
+    DEBUG_MSG() << "python helper started" << m_python << "pid" << m_process->processId();
+    return true;
+}
+
+/****************************************************************
+ * @brief Writes one request line.
+ ***************************************************************/
+int PythonHelper::send(const QString &op, const QJsonObject &args, QString *error)
+{
+    if (!ensureStarted(error))
+    {
+        return 0;
+    }
+    const int id = m_nextId++;
+    QJsonObject request = args;
+    request.insert("id", id);
+    request.insert("op", op);
+    m_pending.insert(id, Telemetry::begin("python helper", "helper", QJsonObject{{"op", op}}));
+    Telemetry::add(Telemetry::Counter::HelperQueries);
+    m_process->write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+    if (m_idleTimer.interval() > 0)
+    {
+        m_idleTimer.start();
+    }
+    return id;
+}
+
+/****************************************************************
+ * @brief Parses the complete reply lines.
+ ***************************************************************/
+void PythonHelper::readReplies()
+{
+    if (!m_process)
+    {
+        return;
+    }
+    m_partial += m_process->readAllStandardOutput();
+    qsizetype start = 0;
+    qsizetype end = m_partial.indexOf('\n');
+    while (end >= 0)
+    {
+        const QByteArray line = m_partial.mid(start, end - start);
+        start = end + 1;
+        end = m_partial.indexOf('\n', start);
+
+        QJsonParseError parseError;
+        const QJsonObject reply = QJsonDocument::fromJson(line, &parseError).object();
+        if (parseError.error != QJsonParseError::NoError)
+        {
+            DEBUG_MSG() << "python helper sent" << line;
+            continue;
+        }
+        finishRequest(reply.value("id").toInt(), reply.value("ok").toBool(), reply.value("result"),
+                      reply.value("error").toString());
+    }
+    m_partial.remove(0, start);
+}
+
+/****************************************************************
+ * @brief Ends the span of a request and hands out its answer.
+ ***************************************************************/
+void PythonHelper::finishRequest(int id, bool ok, const QJsonValue &result, const QString &error)
+{
+    if (!m_pending.contains(id))
+    {
+        return; // timed out in call(), or not ours
+    }
+    Telemetry::end(m_pending.take(id), ok);
+    if (m_waiting.contains(id))
+    {
+        m_replies.insert(id, Reply{ok, result, error});
+        return;
+    }
+    emit replied(id, ok, result, error);
+}
+
+/****************************************************************
+ * @brief Drops the process and fails its pending requests.
+ ***************************************************************/
+void PythonHelper::onExited()
+{
+    if (!m_process)
+    {
+        return;
+    }
+    QProcess *process = m_process;
+    m_process = nullptr;
+    process->disconnect(this);
+    process->deleteLater();
+    m_partial.clear();
+
+    const QString reason = tr("Python helper exited");
+    const QList<int> ids = m_pending.keys();
+    for (int i = 0; i < ids.size(); ++i)
+    {
+        finishRequest(ids.at(i), false, QJsonValue(), reason);
+    }
+}
+
+/************** End of PythonHelper.cpp *************************/
@@ -0,0 +1,165 @@
+/****************************************************************
+ * @file PythonHelper.h
+ * @brief Declares PythonHelper, a persistent interpreter that
+ *        answers small queries about one venv.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines PythonHelper. Every "pip --version" or
+ * "pip show" used to start a new interpreter, which costs
+ * 100-300 ms on Windows before pip is even imported. PythonHelper
+ * starts "python -u -c <script()>" once and sends it one JSON
+ * request per line on stdin; each answer is one JSON line on
+ * stdout:
+ *
+ *   -> {"id":7,"op":"show","names":["numpy"]}
+ *   <- {"id":7,"ok":true,"result":[{"name":"numpy",...}]}
+ *   <- {"id":8,"ok":false,"error":"KeyError: 'op'"}
+ *
+ * Operations (importlib.metadata, Python 3.8+):
+ *   ping                      "pong"
+ *   version                   {"python","executable","prefix","pip",
+ *                              "pip-location","pip-tools"}
+ *   list                      [{"name","version"}] sorted by name
+ *   show     names:[...]      [{"name","version","summary","home-page",
+ *                               "author","author-email","license",
+ *                               "location","requires","required-by"}],
+ *                              unknown names left out
+ *
+ * The helper is started on the first request and stopped after
+ * setIdleTimeout() without one. It caches nothing itself, but
+ * sys.path is only read at start, so call stop() after anything
+ * changes the venv; the next request starts a fresh helper. It
+ * never imports installed packages: an import test keeps stale
+ * modules in sys.modules and a crashing extension would take the
+ * helper with it, so those run in a process of their own. A
+ * helper that exits fails its pending requests and is started
+ * again by the next one. Installs and pip-compile still run in
+ * processes of their own.
+ *
+ * Only TerminalEngine sends it requests. The resolver's own
+ * interpreter queries (the host Python version in
+ * ResolveSession::hostEnvironment(), the Settings probes) go
+ * through SystemProbe::run(), whose cache answers them without a
+ * process once an interpreter has been seen, so a helper there
+ * would only add a launch.
+ ***************************************************************/
+#ifndef PYTHONHELPER_H
+#define PYTHONHELPER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QProcess>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+/****************************************************************
+ * @class PythonHelper
+ * @brief One long-lived interpreter speaking JSON lines.
+ ***************************************************************/
+class PythonHelper : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int kDefaultIdleTimeoutMs = 5 * 60 * 1000;
+
+    explicit PythonHelper(QObject *parent = nullptr);
+    ~PythonHelper();
+
+    /****************************************************************
+     * @brief Sets the interpreter, normally the venv's python. A
+     *        helper of another interpreter is stopped.
+     ***************************************************************/
+    void setPython(const QString &pythonExe);
+    QString python() const;
+
+    /****************************************************************
+     * @brief Stops the helper after this long without a request;
+     *        0 keeps it until stop().
+     ***************************************************************/
+    void setIdleTimeout(int ms);
+    int idleTimeout() const;
+
+    bool isRunning() const;
+
+    /****************************************************************
+     * @brief Interpreters started so far.
+     ***************************************************************/
+    int launches() const;
+
+    /****************************************************************
+     * @brief Sends a request, starting the helper if needed.
+     * @param op Operation name, see the file description.
+     * @param args Extra request members, e.g. {"names":[...]}.
+     * @return Id of the replied() that answers it, 0 if the helper
+     *         cannot start (replied() is then not emitted).
+     ***************************************************************/
+    int request(const QString &op, const QJsonObject &args = QJsonObject());
+
+    /****************************************************************
+     * @brief Blocking form of request() for callers that need the
+     *        answer right away; does not emit replied().
+     * @return false with error set on a failed request, a helper
+     *         that cannot start or a timeout; a timeout also stops
+     *         the helper, which answers one request at a time.
+     ***************************************************************/
+    bool call(const QString &op, const QJsonObject &args, int timeoutMs, QJsonValue *result,
+              QString *error = nullptr);
+
+    /****************************************************************
+     * @brief Kills the helper; pending requests fail.
+     ***************************************************************/
+    void stop();
+
+    /****************************************************************
+     * @brief The Python source the helper runs.
+     ***************************************************************/
+    static QByteArray script();
+
+signals:
+    /****************************************************************
+     * @brief Answer to request().
+     * @param result The "result" member when ok.
+     * @param error Python's "Type: message", or why the helper went.
+     ***************************************************************/
+    void replied(int id, bool ok, const QJsonValue &result, const QString &error);
+
+private:
+    /****************************************************************
+     * @struct Reply
+     * @brief Answer held for call().
+     ***************************************************************/
+    struct Reply
+    {
+        bool ok = false;
+        QJsonValue result;
+        QString error;
+    };
+
+    bool ensureStarted(QString *error);
+    int send(const QString &op, const QJsonObject &args, QString *error);
+    void readReplies();
+    void finishRequest(int id, bool ok, const QJsonValue &result, const QString &error);
+    void onExited();
+
+    QProcess *m_process = nullptr;
+    QString m_python;
+    QByteArray m_partial;                  ///< stdout after the last newline
+    QHash<int, qint64> m_pending;          ///< id -> Telemetry span
+    QSet<int> m_waiting;                   ///< ids call() is blocked on
+    QHash<int, Reply> m_replies;           ///< answers of m_waiting
+    QTimer m_idleTimer;
+    int m_nextId = 1;
+    int m_launches = 0;
+};
+
+#endif // PYTHONHELPER_H
+/************** End of PythonHelper.h ***************************/
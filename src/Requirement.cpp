@@ -0,0 +1,615 @@
+/****************************************************************
+ * @file Requirement.cpp
+ * @brief Implements the Requirement parser.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains a hand-written PEP 508 parser. It walks the
+ * line once, left to right, and records offsets; nothing is
+ * copied except the normalized project name, and that only the
+ * first time a project is seen.
+ ***************************************************************/
+#include "Requirement.h"
+#include <QCoreApplication>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+namespace
+{
+const int kMaxLineLength = 0xFFFF;
+
+bool isNameChar(QChar c)
+{
+    return (c.unicode() < 128 && c.isLetterOrNumber()) || c == '-' || c == '_' || c == '.';
+}
+
+bool isAlnum(QChar c)
+{
+    return c.unicode() < 128 && c.isLetterOrNumber();
+}
+
+bool isVersionChar(QChar c)
+{
+    return isAlnum(c) || c == '.' || c == '*' || c == '+' || c == '!' || c == '-' || c == '_';
+}
+
+QString message(const char *text)
+{
+    return QCoreApplication::translate("Requirement", text);
+}
+
+/****************************************************************
+ * @class Cursor
+ * @brief Position in the line being parsed.
+ ***************************************************************/
+class Cursor
+{
+public:
+    explicit Cursor(QStringView text) : m_text(text) {}
+
+    bool atEnd() const { return m_pos >= m_text.size(); }
+    QChar peek(int ahead = 0) const
+    {
+        return m_pos + ahead < m_text.size() ? m_text.at(m_pos + ahead) : QChar();
+    }
+    int pos() const { return int(m_pos); }
+    void advance(int n = 1) { m_pos += n; }
+    bool startsWith(QLatin1StringView s) const { return m_text.sliced(m_pos).startsWith(s); }
+    bool take(QLatin1StringView s)
+    {
+        if (!startsWith(s))
+        {
+            return false;
+        }
+        m_pos += s.size();
+        return true;
+    }
+    void skipSpace()
+    {
+        while (!atEnd() && peek().isSpace())
+        {
+            ++m_pos;
+        }
+    }
+    /// A comment starts at "#" at the line start or after whitespace
+    bool atComment() const
+    {
+        return peek() == '#' && (m_pos == 0 || m_text.at(m_pos - 1).isSpace());
+    }
+    Requirement::Span spanTo(int start) const
+    {
+        Requirement::Span span;
+        span.start = quint16(start);
+        span.length = quint16(m_pos - start);
+        return span;
+    }
+    /// Runs to the next whitespace
+    Requirement::Span word()
+    {
+        const int start = pos();
+        while (!atEnd() && !peek().isSpace())
+        {
+            ++m_pos;
+        }
+        return spanTo(start);
+    }
+
+private:
+    QStringView m_text;
+    qsizetype m_pos = 0;
+};
+
+Requirement::Span trimmedSpan(QStringView text, int start, int end)
+{
+    while (start < end && text.at(start).isSpace())
+    {
+        ++start;
+    }
+    while (end > start && text.at(end - 1).isSpace())
+    {
+        --end;
+    }
+    Requirement::Span span;
+    span.start = quint16(start);
+    span.length = quint16(end - start);
+    return span;
+}
+
+/****************************************************************
+ * @brief Checks quotes and parentheses of a marker expression.
+ ***************************************************************/
+bool balancedMarker(QStringView marker)
+{
+    int depth = 0;
+    QChar quote;
+    for (qsizetype i = 0; i < marker.size(); ++i)
+    {
+        const QChar c = marker.at(i);
+        if (!quote.isNull())
+        {
+            if (c == quote)
+            {
+                quote = QChar();
+            }
+            continue;
+        }
+        if (c == '"' || c == '\'')
+        {
+            quote = c;
+        }
+        else if (c == '(')
+        {
+            ++depth;
+        }
+        else if (c == ')' && --depth < 0)
+        {
+            return false;
+        }
+    }
+    return depth == 0 && quote.isNull();
+}
+
+/****************************************************************
+ * @brief Parses the trailing "--hash=..." and other options.
+ * @return false with error set for malformed hashes.
+ ***************************************************************/
+bool parseTrailingOptions(Cursor &c, Requirement *r)
+{
+    while (true)
+    {
+        c.skipSpace();
+        if (c.atEnd() || c.atComment())
+        {
+            return true;
+        }
+        if (!c.startsWith(QLatin1StringView("--")))
+        {
+            r->error = message("unexpected text: %1").arg(r->line.mid(c.pos()));
+            return false;
+        }
+        if (c.take(QLatin1StringView("--hash")))
+        {
+            if (c.peek() == '=')
+            {
+                c.advance();
+            }
+            else
+            {
+                c.skipSpace();
+            }
+            const Requirement::Span hash = c.word();
+            const QStringView value = r->text(hash);
+            const qsizetype colon = value.indexOf(':');
+            if (colon <= 0 || colon == value.size() - 1)
+            {
+                r->error = message("malformed --hash, expected algorithm:digest");
+                return false;
+            }
+            r->hashes.append(hash);
+            continue;
+        }
+        // Per-requirement options such as --config-settings are kept in the line
+        c.word();
+    }
+}
+}
+
+QStringView Requirement::text(Span span) const
+{
+    return QStringView(line).sliced(span.start, span.length);
+}
+
+QString Requirement::version(int clause) const
+{
+    return text(clauses.at(clause).version).toString();
+}
+
+bool Requirement::isIndexPackage() const
+{
+    if (kind != Kind::Package || !url.isEmpty())
+    {
+        return false;
+    }
+    for (int i = 0; i < clauses.size(); ++i)
+    {
+        if (clauses.at(i).op == Op::Arbitrary)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString Requirement::nameWithExtras() const
+{
+    if (extras.isEmpty())
+    {
+        return text(name).toString();
+    }
+    QString out = text(name).toString();
+    out += '[';
+    out += text(extras);
+    out += ']';
+    return out;
+}
+
+QStringList Requirement::extraList() const
+{
+    QStringList out;
+    const QList<QStringView> parts = text(extras).split(',', Qt::SkipEmptyParts);
+    for (int i = 0; i < parts.size(); ++i)
+    {
+        out << parts.at(i).trimmed().toString();
+    }
+    return out;
+}
+
+/****************************************************************
+ * @brief Parses one logical line.
+ ***************************************************************/
+Requirement Requirement::parse(const QString &text)
+{
+    Requirement r;
+    r.line = text.trimmed();
+    if (r.line.size() > kMaxLineLength)
+    {
+        r.kind = Kind::Invalid;
+        r.error = message("line is too long");
+        return r;
+    }
+    Cursor c(r.line);
+    if (c.atEnd())
+    {
+        return r;
+    }
+    if (c.peek() == '#')
+    {
+        r.kind = Kind::Comment;
+        return r;
+    }
+
+    // pip options: -r file, --requirement=file, -rfile ...
+    if (c.peek() == '-')
+    {
+        const int start = c.pos();
+        while (!c.atEnd() && !c.peek().isSpace() && c.peek() != '=')
+        {
+            c.advance();
+        }
+        QStringView option = QStringView(r.line).sliced(start, c.pos() - start);
+        int argumentStart = -1;
+        if (!option.startsWith(QLatin1StringView("--")) && option.size() > 2)
+        {
+            argumentStart = start + 2;     // short option with the value attached
+            option = option.first(2);
+        }
+        if (option == QLatin1StringView("-r") || option == QLatin1StringView("--requirement"))
+        {
+            r.kind = Kind::Include;
+        }
+        else if (option == QLatin1StringView("-c") || option == QLatin1StringView("--constraint"))
+        {
+            r.kind = Kind::Constraint;
+        }
+        else if (option == QLatin1StringView("-e") || option == QLatin1StringView("--editable"))
+        {
+            r.kind = Kind::Editable;
+        }
+        else
+        {
+            r.kind = Kind::Option;
+        }
+        if (argumentStart < 0)
+        {
+            if (c.peek() == '=')
+            {
+                c.advance();
+            }
+            argumentStart = c.pos();
+        }
+        int end = int(r.line.size());
+        for (int i = argumentStart; i < r.line.size(); ++i)
+        {
+            if (r.line.at(i) == '#' && r.line.at(i - 1).isSpace())
+            {
+                end = i;
+                break;
+            }
+        }
+        r.argument = trimmedSpan(r.line, argumentStart, end);
+        if (r.kind != Kind::Option && r.argument.isEmpty())
+        {
+            r.error = message("%1 needs a file or path").arg(option.toString());
+            r.kind = Kind::Invalid;
+        }
+        return r;
+    }
+
+    // Unnamed URL or path: ./pkg, /abs/pkg, https://..., C:\pkg
+    if (!isAlnum(c.peek()) || (r.line.contains(QLatin1StringView("://")) && !r.line.contains('@')))
+    {
+        const Span url = c.word();
+        const QStringView value = r.text(url);
+        if (value.contains(QLatin1StringView("://")) || value.startsWith('.') || value.startsWith('/')
+            || value.startsWith('~') || (value.size() > 2 && value.at(1) == ':'))
+        {
+            r.kind = Kind::Url;
+            r.url = url;
+            c.skipSpace();
+            if (c.peek() == ';')
+            {
+                c.advance();
+                const int start = c.pos();
+                while (!c.atEnd() && !c.atComment())
+                {
+                    c.advance();
+                }
+                r.marker = trimmedSpan(r.line, start, c.pos());
+            }
+            return r;
+        }
+        r.kind = Kind::Invalid;
+        r.error = message("expected a package name");
+        return r;
+    }
+
+    // name
+    r.kind = Kind::Package;
+    {
+        const int start = c.pos();
+        while (!c.atEnd() && isNameChar(c.peek()))
+        {
+            c.advance();
+        }
+        r.name = c.spanTo(start);
+        if (!isAlnum(r.line.at(c.pos() - 1)))
+        {
+            r.kind = Kind::Invalid;
+            r.error = message("package name must end with a letter or digit");
+            return r;
+        }
+    }
+    c.skipSpace();
+
+    // [extras]
+    if (c.peek() == '[')
+    {
+        c.advance();
+        const int start = c.pos();
+        while (!c.atEnd() && c.peek() != ']')
+        {
+            if (!isNameChar(c.peek()) && c.peek() != ',' && !c.peek().isSpace())
+            {
+                r.kind = Kind::Invalid;
+                r.error = message("invalid character in extras");
+                return r;
+            }
+            c.advance();
+        }
+        if (c.atEnd())
+        {
+            r.kind = Kind::Invalid;
+            r.error = message("missing \"]\" after extras");
+            return r;
+        }
+        r.extras = trimmedSpan(r.line, start, c.pos());
+        c.advance();
+        c.skipSpace();
+    }
+
+    // @ url   or   version specifiers
+    if (c.peek() == '@')
+    {
+        c.advance();
+        c.skipSpace();
+        r.url = c.word();
+        if (r.url.isEmpty())
+        {
+            r.kind = Kind::Invalid;
+            r.error = message("missing URL after \"@\"");
+            return r;
+        }
+    }
+    else
+    {
+        const bool parenthesized = c.peek() == '(';
+        if (parenthesized)
+        {
+            c.advance();
+        }
+        static const struct { const char *text; Op op; } kOps[] = {
+            {"===", Op::Arbitrary}, {"==", Op::Equal}, {"~=", Op::Compatible}, {"!=", Op::NotEqual},
+            {"<=", Op::LessEqual}, {">=", Op::GreaterEqual}, {"<", Op::Less}, {">", Op::Greater}};
+        while (true)
+        {
+            c.skipSpace();
+            int found = -1;
+            for (int i = 0; i < int(sizeof(kOps) / sizeof(kOps[0])); ++i)
+            {
+                if (c.take(QLatin1StringView(kOps[i].text)))
+                {
+                    found = i;
+                    break;
+                }
+            }
+            if (found < 0)
+            {
+                if (!r.clauses.isEmpty())
+                {
+                    r.kind = Kind::Invalid;
+                    r.error = message("expected a comparison operator after \",\"");
+                    return r;
+                }
+                break;
+            }
+            c.skipSpace();
+            const int start = c.pos();
+            while (!c.atEnd() && isVersionChar(c.peek()))
+            {
+                c.advance();
+            }
+            Clause clause;
+            clause.op = kOps[found].op;
+            clause.version = c.spanTo(start);
+            if (clause.version.isEmpty())
+            {
+                r.kind = Kind::Invalid;
+                r.error = message("missing version after %1").arg(QLatin1StringView(kOps[found].text));
+                return r;
+            }
+            r.clauses.append(clause);
+            c.skipSpace();
+            if (c.peek() != ',')
+            {
+                break;
+            }
+            c.advance();
+        }
+        if (parenthesized)
+        {
+            if (c.peek() != ')')
+            {
+                r.kind = Kind::Invalid;
+                r.error = message("missing \")\" after version specifiers");
+                return r;
+            }
+            c.advance();
+        }
+    }
+
+    // ; marker   (up to the first --option or comment)
+    c.skipSpace();
+    if (c.peek() == ';')
+    {
+        c.advance();
+        const int start = c.pos();
+        while (!c.atEnd() && !c.atComment()
+               && !(c.startsWith(QLatin1StringView("--")) && r.line.at(c.pos() - 1).isSpace()))
+        {
+            c.advance();
+        }
+        r.marker = trimmedSpan(r.line, start, c.pos());
+        if (r.marker.isEmpty() || !balancedMarker(r.text(r.marker)))
+        {
+            r.kind = Kind::Invalid;
+            r.error = message("malformed environment marker");
+            return r;
+        }
+    }
+
+    if (!parseTrailingOptions(c, &r))
+    {
+        r.kind = Kind::Invalid;
+        return r;
+    }
+    r.project = intern(normalizeName(r.text(r.name)));
+    return r;
+}
+
+/****************************************************************
+ * @brief Joins backslash continuations.
+ ***************************************************************/
+QStringList Requirement::logicalLines(const QStringList &lines)
+{
+    QStringList out;
+    out.reserve(lines.size());
+    QString pending;
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        QString line = lines.at(i);
+        if (line.endsWith('\r'))
+        {
+            line.chop(1);
+        }
+        if (!pending.isEmpty())
+        {
+            pending.chop(1);                              // the backslash
+            line = pending.trimmed() + ' ' + line.trimmed();
+            pending.clear();
+        }
+        if (line.endsWith('\\'))
+        {
+            pending = line;
+            continue;
+        }
+        out << line;
+    }
+    if (!pending.isEmpty())
+    {
+        out << pending;
+    }
+    return out;
+}
+
+/****************************************************************
+ * @brief PEP 503: lower case, runs of "-_." become one "-".
+ ***************************************************************/
+QString Requirement::normalizeName(QStringView name)
+{
+    QString out;
+    out.reserve(name.size());
+    bool separator = false;
+    for (qsizetype i = 0; i < name.size(); ++i)
+    {
+        const QChar ch = name.at(i);
+        if (ch == '-' || ch == '_' || ch == '.')
+        {
+            separator = true;
+            continue;
+        }
+        if (separator && !out.isEmpty())
+        {
+            out += '-';
+        }
+        separator = false;
+        out += ch.toLower();
+    }
+    return out;
+}
+
+/****************************************************************
+ * @brief Shared copy of a normalized name.
+ ***************************************************************/
+QString Requirement::intern(const QString &name)
+{
+    static QMutex mutex;
+    static QSet<QString> names;
+    QMutexLocker locker(&mutex);
+    const auto it = names.constFind(name);
+    if (it != names.constEnd())
+    {
+        return *it;
+    }
+    names.insert(name);
+    return name;
+}
+
+QString Requirement::opText(Op op)
+{
+    switch (op)
+    {
+    case Op::Compatible:
+        return QStringLiteral("~=");
+    case Op::Equal:
+        return QStringLiteral("==");
+    case Op::NotEqual:
+        return QStringLiteral("!=");
+    case Op::LessEqual:
+        return QStringLiteral("<=");
+    case Op::GreaterEqual:
+        return QStringLiteral(">=");
+    case Op::Less:
+        return QStringLiteral("<");
+    case Op::Greater:
+        return QStringLiteral(">");
+    case Op::Arbitrary:
+        return QStringLiteral("===");
+    }
+    return QString();
+}
+
+/************** End of Requirement.cpp **************************/
@@ -0,0 +1,148 @@
+/****************************************************************
+ * @file Requirement.h
+ * @brief Declares Requirement, the parsed form of one requirements
+ *        file line.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the Requirement struct and its PEP 508 parser.
+ * A line is parsed once, when it is loaded; the requirements table,
+ * CandidateFetcher and the resolver then all work from the result
+ * instead of re-splitting the text.
+ *
+ * Understood: name, [extras], version specifiers (optionally in
+ * parentheses), "@ url", "; marker", --hash options, trailing
+ * comments, and the pip lines -r/--requirement, -c/--constraint,
+ * -e/--editable and other --options.
+ *
+ * The struct keeps the line itself (one implicitly shared QString)
+ * and 16-bit offsets into it, so sub-parts cost no allocations.
+ * Project names are PEP 503 normalized and interned: every
+ * Requirement naming "numpy" shares one string.
+ ***************************************************************/
+#ifndef REQUIREMENT_H
+#define REQUIREMENT_H
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QVector>
+
+/****************************************************************
+ * @struct Requirement
+ * @brief One parsed requirements file line.
+ ***************************************************************/
+struct Requirement
+{
+    /****************************************************************
+     * @enum Kind
+     * @brief What a line is.
+     ***************************************************************/
+    enum class Kind : quint8
+    {
+        Blank,
+        Comment,
+        Package,      ///< name[extras] specifiers/url ; marker
+        Url,          ///< direct URL or path without a name
+        Include,      ///< -r file
+        Constraint,   ///< -c file
+        Editable,     ///< -e path or url
+        Option,       ///< any other pip option line
+        Invalid
+    };
+
+    /****************************************************************
+     * @enum Op
+     * @brief Version comparison operator.
+     ***************************************************************/
+    enum class Op : quint8
+    {
+        Compatible,   ///< ~=
+        Equal,        ///< ==
+        NotEqual,     ///< !=
+        LessEqual,    ///< <=
+        GreaterEqual, ///< >=
+        Less,         ///< <
+        Greater,      ///< >
+        Arbitrary     ///< ===
+    };
+
+    /****************************************************************
+     * @struct Span
+     * @brief Offset and length of a part of the line.
+     ***************************************************************/
+    struct Span
+    {
+        quint16 start = 0;
+        quint16 length = 0;
+        bool isEmpty() const { return length == 0; }
+    };
+
+    /****************************************************************
+     * @struct Clause
+     * @brief One version specifier clause.
+     ***************************************************************/
+    struct Clause
+    {
+        Op op = Op::Equal;
+        Span version;
+    };
+
+    QString line;              ///< trimmed text as written
+    QString project;           ///< normalized, interned; empty unless named
+    Kind kind = Kind::Blank;
+    Span name;                 ///< as written
+    Span extras;               ///< inside the brackets
+    Span url;                  ///< after "@", or the whole URL/path
+    Span marker;               ///< after ";"
+    Span argument;             ///< file/path of -r, -c, -e and options
+    QVector<Clause> clauses;
+    QVector<Span> hashes;      ///< "algo:hex" of each --hash
+    QString error;             ///< reason when kind is Invalid
+
+    QStringView text(Span span) const;
+    QString version(int clause) const;
+
+    /****************************************************************
+     * @brief A named requirement resolved through the index (no
+     *        URL, no "===").
+     ***************************************************************/
+    bool isIndexPackage() const;
+
+    /****************************************************************
+     * @brief "name[extras]" as written, for pins.
+     ***************************************************************/
+    QString nameWithExtras() const;
+
+    QStringList extraList() const;
+
+    /****************************************************************
+     * @brief Parses one logical line (continuations already joined).
+     ***************************************************************/
+    static Requirement parse(const QString &line);
+
+    /****************************************************************
+     * @brief Joins lines ending in a backslash with the next line.
+     *        A final line that still ends in a backslash is kept
+     *        as is, so streamed input can wait for its rest.
+     ***************************************************************/
+    static QStringList logicalLines(const QStringList &lines);
+
+    /****************************************************************
+     * @brief PEP 503 normalization ("Foo_Bar" -> "foo-bar").
+     ***************************************************************/
+    static QString normalizeName(QStringView name);
+
+    /****************************************************************
+     * @brief Shared copy of a normalized name.
+     ***************************************************************/
+    static QString intern(const QString &name);
+
+    static QString opText(Op op);
+};
+
+#endif // REQUIREMENT_H
+/************** End of Requirement.h ****************************/
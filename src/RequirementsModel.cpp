@@ -0,0 +1,282 @@
+/****************************************************************
+ * @file RequirementsModel.cpp
+ * @brief Implements the RequirementsModel class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of RequirementsModel.
+ * setLines() first skips the common leading and trailing rows, so
+ * the usual reload (a few pins bumped, some lines appended) costs
+ * one pass with no structural change. Inside the remaining middle
+ * it removes vanished rows in contiguous runs, then walks the new
+ * order inserting runs of new rows and moving rows that changed
+ * place.
+ ***************************************************************/
+#include "RequirementsModel.h"
+#include <QHash>
+#include <QSet>
+
+RequirementsModel::RequirementsModel(QObject *parent) : QAbstractTableModel(parent)
+{
+}
+
+int RequirementsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_rows.size());
+}
+
+int RequirementsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 1;
+}
+
+QVariant RequirementsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size())
+    {
+        return QVariant();
+    }
+    if (role == Qt::DisplayRole || role == Qt::ToolTipRole)
+    {
+        return m_rows.at(index.row()).line;
+    }
+    return QVariant();
+}
+
+QVariant RequirementsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole)
+    {
+        return QVariant();
+    }
+    if (orientation == Qt::Horizontal)
+    {
+        return tr("requirements.txt");
+    }
+    return section + 1;
+}
+
+Qt::ItemFlags RequirementsModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+    {
+        return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
+
+/****************************************************************
+ * @brief Makes the rows equal to lines, touching only what differs.
+ ***************************************************************/
+void RequirementsModel::setLines(const QStringList &lines)
+{
+    QVector<RequirementRow> target = parseAll(lines);
+    assignKeys(&target);
+
+    auto update = [this](int row, const RequirementRow &from)
+    {
+        if (m_rows.at(row).line != from.line)
+        {
+            m_rows[row] = from;
+            const QModelIndex changed = index(row, 0);
+            emit dataChanged(changed, changed, {Qt::DisplayRole, Qt::ToolTipRole});
+        }
+    };
+
+    // Common head and tail, matched by identity
+    int head = 0;
+    while (head < m_rows.size() && head < target.size() && m_rows.at(head).key == target.at(head).key)
+    {
+        update(head, target.at(head));
+        ++head;
+    }
+    int tail = 0;
+    while (tail < m_rows.size() - head && tail < target.size() - head
+           && m_rows.at(m_rows.size() - 1 - tail).key == target.at(target.size() - 1 - tail).key)
+    {
+        update(m_rows.size() - 1 - tail, target.at(target.size() - 1 - tail));
+        ++tail;
+    }
+    const int targetEnd = target.size() - tail;
+
+    // Remove rows that are gone, one signal per contiguous run
+    QSet<QString> wanted;
+    for (int i = head; i < targetEnd; ++i)
+    {
+        wanted.insert(target.at(i).key);
+    }
+    int row = m_rows.size() - tail - 1;
+    while (row >= head)
+    {
+        if (wanted.contains(m_rows.at(row).key))
+        {
+            --row;
+            continue;
+        }
+        int first = row;
+        while (first - 1 >= head && !wanted.contains(m_rows.at(first - 1).key))
+        {
+            --first;
+        }
+        beginRemoveRows(QModelIndex(), first, row);
+        m_rows.remove(first, row - first + 1);
+        endRemoveRows();
+        row = first - 1;
+    }
+
+    // Every remaining middle row is wanted; bring them into order
+    QSet<QString> present;
+    for (int i = head; i < m_rows.size() - tail; ++i)
+    {
+        present.insert(m_rows.at(i).key);
+    }
+    for (int i = head; i < targetEnd; ++i)
+    {
+        const int middleEnd = m_rows.size() - tail;
+        if (i < middleEnd && m_rows.at(i).key == target.at(i).key)
+        {
+            update(i, target.at(i));
+            continue;
+        }
+        if (!present.contains(target.at(i).key))
+        {
+            int last = i;
+            while (last + 1 < targetEnd && !present.contains(target.at(last + 1).key))
+            {
+                ++last;
+            }
+            beginInsertRows(QModelIndex(), i, last);
+            m_rows.insert(i, last - i + 1, RequirementRow());
+            for (int k = i; k <= last; ++k)
+            {
+                m_rows[k] = target.at(k);
+            }
+            endInsertRows();
+            i = last;
+            continue;
+        }
+        int from = i + 1;
+        while (from < middleEnd && m_rows.at(from).key != target.at(i).key)
+        {
+            ++from;
+        }
+        beginMoveRows(QModelIndex(), from, from, QModelIndex(), i);
+        m_rows.move(from, i);
+        endMoveRows();
+        update(i, target.at(i));
+    }
+}
+
+/****************************************************************
+ * @brief Appends lines at the end.
+ ***************************************************************/
+void RequirementsModel::appendLines(const QStringList &lines)
+{
+    QVector<RequirementRow> added = parseAll(lines);
+    if (added.isEmpty())
+    {
+        return;
+    }
+    beginInsertRows(QModelIndex(), m_rows.size(), m_rows.size() + added.size() - 1);
+    m_rows += added;
+    assignKeys(&m_rows);
+    endInsertRows();
+}
+
+void RequirementsModel::clear()
+{
+    if (m_rows.isEmpty())
+    {
+        return;
+    }
+    beginResetModel();
+    m_rows.clear();
+    endResetModel();
+}
+
+QStringList RequirementsModel::lines() const
+{
+    QStringList out;
+    out.reserve(m_rows.size());
+    for (int i = 0; i < m_rows.size(); ++i)
+    {
+        out << m_rows.at(i).line;
+    }
+    return out;
+}
+
+const RequirementRow &RequirementsModel::row(int index) const
+{
+    return m_rows.at(index);
+}
+
+QVector<Requirement> RequirementsModel::requirements() const
+{
+    QVector<Requirement> out;
+    out.reserve(m_rows.size());
+    for (int i = 0; i < m_rows.size(); ++i)
+    {
+        out.append(m_rows.at(i).requirement);
+    }
+    return out;
+}
+
+int RequirementsModel::longestRow() const
+{
+    int longest = -1;
+    for (int i = 0; i < m_rows.size(); ++i)
+    {
+        if (longest < 0 || m_rows.at(i).line.size() > m_rows.at(longest).line.size())
+        {
+            longest = i;
+        }
+    }
+    return longest;
+}
+
+/****************************************************************
+ * @brief Parses a requirement line into a row.
+ ***************************************************************/
+RequirementRow RequirementsModel::parse(const QString &line)
+{
+    RequirementRow row;
+    row.requirement = Requirement::parse(line);
+    row.line = row.requirement.line;
+    return row;
+}
+
+QVector<RequirementRow> RequirementsModel::parseAll(const QStringList &lines) const
+{
+    QVector<RequirementRow> rows;
+    rows.reserve(lines.size());
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        if (!lines.at(i).trimmed().isEmpty())
+        {
+            rows.append(parse(lines.at(i)));
+        }
+    }
+    return rows;
+}
+
+/****************************************************************
+ * @brief Keys are the name (or line); repeats get "#n" appended.
+ ***************************************************************/
+void RequirementsModel::assignKeys(QVector<RequirementRow> *rows)
+{
+    QHash<QString, int> seen;
+    for (int i = 0; i < rows->size(); ++i)
+    {
+        RequirementRow &row = (*rows)[i];
+        const QString &project = row.requirement.project;
+        const QString base = project.isEmpty() ? "\n" + row.line : project;
+        const int count = seen.value(base, 0);
+        seen.insert(base, count + 1);
+        row.key = count == 0 ? base : base + '#' + QString::number(count + 1);
+    }
+}
+
+/************** End of RequirementsModel.cpp ********************/
@@ -0,0 +1,106 @@
+/****************************************************************
+ * @file RequirementsModel.h
+ * @brief Declares the RequirementsModel class for the requirements
+ *        table.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines RequirementsModel, a one-column table model over
+ * a flat vector of parsed requirement lines. It replaces a
+ * QStandardItemModel that was cleared and refilled with one item
+ * per line on every load.
+ *
+ * setLines() applies the difference to the current rows: rows are
+ * matched by project name (or by the whole line for comments and
+ * unparsed lines), unchanged rows are left alone, changed pins are
+ * updated in place, and only added, removed or moved rows are
+ * announced. Selections and other per-row view state therefore
+ * survive a reload, and reloading a file of thousands of pins
+ * touches only the rows that changed.
+ ***************************************************************/
+#ifndef REQUIREMENTSMODEL_H
+#define REQUIREMENTSMODEL_H
+
+#include "Requirement.h"
+#include <QAbstractTableModel>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/****************************************************************
+ * @struct RequirementRow
+ * @brief One non-empty line of a requirements file.
+ ***************************************************************/
+struct RequirementRow
+{
+    QString line;              ///< trimmed text as shown
+    Requirement requirement;   ///< parsed once, when the row is loaded
+    QString key;               ///< identity used to match rows between loads
+};
+
+/****************************************************************
+ * @class RequirementsModel
+ * @brief Diff-applying model of requirement lines.
+ ***************************************************************/
+class RequirementsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit RequirementsModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    /****************************************************************
+     * @brief Makes the rows equal to lines, touching only the rows
+     *        that differ. Blank lines are skipped.
+     ***************************************************************/
+    void setLines(const QStringList &lines);
+
+    /****************************************************************
+     * @brief Appends lines at the end (streamed loads).
+     ***************************************************************/
+    void appendLines(const QStringList &lines);
+
+    void clear();
+
+    /****************************************************************
+     * @brief The rows' text, in order.
+     ***************************************************************/
+    QStringList lines() const;
+
+    const RequirementRow &row(int index) const;
+
+    /****************************************************************
+     * @brief The parsed rows, in order, for the fetcher.
+     ***************************************************************/
+    QVector<Requirement> requirements() const;
+
+    /****************************************************************
+     * @brief Index of the longest line, -1 if empty; lets the view
+     *        size its column from one row instead of all of them.
+     ***************************************************************/
+    int longestRow() const;
+
+    /****************************************************************
+     * @brief Parses a requirement line into a row.
+     ***************************************************************/
+    static RequirementRow parse(const QString &line);
+
+private:
+    QVector<RequirementRow> parseAll(const QStringList &lines) const;
+    static void assignKeys(QVector<RequirementRow> *rows);
+
+    QVector<RequirementRow> m_rows;
+};
+
+#endif // REQUIREMENTSMODEL_H
+/************** End of RequirementsModel.h **********************/
@@ -0,0 +1,491 @@
+/****************************************************************
+ * @file ResolveCoordinator.cpp
+ * @brief Implements the ResolveCoordinator class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of ResolveCoordinator:
+ * worker handshakes, least-loaded dispatch and result collection.
+ ***************************************************************/
+#include "ResolveCoordinator.h"
+#include "Telemetry.h"
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMessageAuthenticationCode>
+#include <QRandomGenerator>
+#include <QSaveFile>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <algorithm>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+// A line longer than this is not a protocol message
+static const qsizetype kMaxMessageBytes = 16 * 1024 * 1024;
+// Random bytes per challenge
+static const int kNonceBytes = 32;
+
+/****************************************************************
+ * @brief Equality that takes as long whatever bytes differ, so the
+ *        expected proof cannot be guessed byte by byte.
+ ***************************************************************/
+static bool sameBytes(const QByteArray &a, const QByteArray &b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    unsigned char difference = 0;
+    for (qsizetype i = 0; i < a.size(); ++i)
+    {
+        difference |= static_cast<unsigned char>(a.at(i) ^ b.at(i));
+    }
+    return difference == 0;
+}
+
+ResolveCoordinator::ResolveCoordinator(QObject *parent)
+    : QObject(parent)
+    , m_server(new QTcpServer(this))
+{
+    connect(m_server, &QTcpServer::newConnection, this, &ResolveCoordinator::onNewConnection);
+}
+
+ResolveCoordinator::~ResolveCoordinator()
+{
+    for (int i = 0; i < m_peers.size(); ++i)
+    {
+        m_peers.at(i)->socket->disconnect(this);
+        delete m_peers.at(i);
+    }
+    m_peers.clear();
+}
+
+/****************************************************************
+ * @brief Opens the port; without a token anyone who can reach it
+ *        could feed results into the search, so that is refused.
+ ***************************************************************/
+bool ResolveCoordinator::listen(quint16 port, QString *error, const QHostAddress &address)
+{
+    if (m_token.isEmpty())
+    {
+        if (error)
+        {
+            *error = tr("A token is required to accept workers");
+        }
+        return false;
+    }
+    if (!m_server->listen(address, port))
+    {
+        if (error)
+        {
+            *error = m_server->errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+quint16 ResolveCoordinator::serverPort() const
+{
+    return m_server->serverPort();
+}
+
+void ResolveCoordinator::setToken(const QString &token)
+{
+    m_token = token;
+}
+
+void ResolveCoordinator::setHelloTimeout(int timeoutMs)
+{
+    m_helloTimeoutMs = qMax(1, timeoutMs);
+}
+
+void ResolveCoordinator::setEnvironment(const QString &environment)
+{
+    if (environment == m_environment)
+    {
+        return;
+    }
+    m_environment = environment;
+    const QList<Peer *> peers = m_peers;
+    for (int i = 0; i < peers.size(); ++i)
+    {
+        if (peers.at(i)->accepted)
+        {
+            drop(peers.at(i), tr("environment changed to %1").arg(environment));
+        }
+    }
+}
+
+void ResolveCoordinator::setWorkDir(const QString &dir)
+{
+    m_workDir = dir;
+}
+
+void ResolveCoordinator::setFindLinks(const QString &findLinks, bool offline)
+{
+    m_findLinks = findLinks;
+    m_offline = offline;
+}
+
+int ResolveCoordinator::slotCount() const
+{
+    int count = 0;
+    for (int i = 0; i < m_peers.size(); ++i)
+    {
+        if (m_peers.at(i)->accepted)
+        {
+            count += m_peers.at(i)->capacity;
+        }
+    }
+    return count;
+}
+
+int ResolveCoordinator::workerCount() const
+{
+    int count = 0;
+    for (int i = 0; i < m_peers.size(); ++i)
+    {
+        count += m_peers.at(i)->accepted ? 1 : 0;
+    }
+    return count;
+}
+
+int ResolveCoordinator::testsQueued() const
+{
+    return int(m_queue.size());
+}
+
+void ResolveCoordinator::cancelAll()
+{
+    for (auto it = m_tests.cbegin(); it != m_tests.cend(); ++it)
+    {
+        Telemetry::end(it.value().span, false);
+    }
+    m_tests.clear();
+    m_queue.clear();
+    for (int i = 0; i < m_peers.size(); ++i)
+    {
+        Peer *peer = m_peers.at(i);
+        if (peer->accepted && !peer->tests.isEmpty())
+        {
+            peer->tests.clear();
+            peer->socket->write(encode(QJsonObject{{"type", "cancel"}}));
+        }
+    }
+}
+
+void ResolveCoordinator::discardOutputs(const QString &keepPath)
+{
+    for (int i = 0; i < m_compiled.size(); ++i)
+    {
+        if (m_compiled.at(i) != keepPath)
+        {
+            QFile::remove(m_compiled.at(i));
+        }
+    }
+    m_compiled.clear();
+}
+
+QByteArray ResolveCoordinator::encode(const QJsonObject &message)
+{
+    return QJsonDocument(message).toJson(QJsonDocument::Compact) + '\n';
+}
+
+QString ResolveCoordinator::proof(const QString &token, const QString &nonce)
+{
+    return QString::fromLatin1(
+        QMessageAuthenticationCode::hash(nonce.toUtf8(), token.toUtf8(), QCryptographicHash::Sha256).toHex());
+}
+
+void ResolveCoordinator::runTest(int testId, const QStringList &pins)
+{
+    Test test;
+    test.id = testId;
+    test.pins = pins;
+    m_tests.insert(testId, test);
+    m_queue << testId;
+    dispatch();
+}
+
+void ResolveCoordinator::onNewConnection()
+{
+    while (QTcpSocket *socket = m_server->nextPendingConnection())
+    {
+        Peer *peer = new Peer;
+        peer->socket = socket;
+        peer->name = QString("%1:%2").arg(socket->peerAddress().toString()).arg(socket->peerPort());
+        socket->setParent(this);
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        m_peers << peer;
+        connect(socket, &QTcpSocket::readyRead, this, [this, peer]() { onReadyRead(peer); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, peer]() { onDisconnected(peer); });
+        // Bound to the socket: never fires once it is gone
+        QTimer::singleShot(m_helloTimeoutMs, socket, [this, peer, socket]() { onHelloTimeout(peer, socket); });
+        QByteArray nonce(kNonceBytes, Qt::Uninitialized);
+        QRandomGenerator::system()->fillRange(reinterpret_cast<quint32 *>(nonce.data()), kNonceBytes / 4);
+        peer->nonce = QString::fromLatin1(nonce.toHex());
+        socket->write(encode(QJsonObject{{"type", "challenge"}, {"nonce", peer->nonce}}));
+        DEBUG_MSG() << "worker connected" << peer->name;
+    }
+}
+
+/****************************************************************
+ * @brief Closes a connection still without a valid hello. The
+ *        peer may be deleted already while its socket waits for
+ *        deleteLater(), so it is only used if still listed.
+ ***************************************************************/
+void ResolveCoordinator::onHelloTimeout(Peer *peer, QTcpSocket *socket)
+{
+    if (m_peers.contains(peer) && peer->socket == socket && !peer->accepted)
+    {
+        drop(peer, tr("no hello within %1 ms").arg(m_helloTimeoutMs));
+    }
+}
+
+void ResolveCoordinator::onReadyRead(Peer *peer)
+{
+    peer->buffer += peer->socket->readAll();
+    qsizetype end = peer->buffer.indexOf('\n');
+    while (end >= 0)
+    {
+        const QByteArray line = peer->buffer.left(end);
+        peer->buffer.remove(0, end + 1);
+        const QJsonDocument document = QJsonDocument::fromJson(line);
+        if (!document.isObject())
+        {
+            drop(peer, tr("malformed message"));
+            return;
+        }
+        handle(peer, document.object());
+        if (!m_peers.contains(peer))
+        {
+            return; // dropped while handling
+        }
+        end = peer->buffer.indexOf('\n');
+    }
+    if (peer->buffer.size() > kMaxMessageBytes)
+    {
+        drop(peer, tr("message too long"));
+    }
+}
+
+void ResolveCoordinator::onDisconnected(Peer *peer)
+{
+    if (!m_peers.contains(peer))
+    {
+        return;
+    }
+    if (peer->accepted)
+    {
+        emit logMessage(tr("Worker %1 disconnected").arg(peer->name));
+    }
+    requeue(peer);
+    m_peers.removeAll(peer);
+    peer->socket->deleteLater();
+    const bool accepted = peer->accepted;
+    delete peer;
+    if (accepted)
+    {
+        emit slotsChanged(slotCount());
+    }
+    dispatch();
+}
+
+void ResolveCoordinator::handle(Peer *peer, const QJsonObject &message)
+{
+    const QString type = message.value("type").toString();
+    if (type == "hello" && !peer->accepted)
+    {
+        accept(peer, message);
+    }
+    else if (type == "result" && peer->accepted)
+    {
+        finish(peer, message);
+    }
+    else
+    {
+        drop(peer, tr("unexpected \"%1\" message").arg(type));
+    }
+}
+
+/****************************************************************
+ * @brief Checks a worker's hello; its results are only valid for
+ *        this search if it compiles in the same environment.
+ ***************************************************************/
+void ResolveCoordinator::accept(Peer *peer, const QJsonObject &hello)
+{
+    QString error;
+    const QByteArray expected = proof(m_token, peer->nonce).toLatin1();
+    if (m_token.isEmpty() || !sameBytes(hello.value("proof").toString().toLatin1(), expected))
+    {
+        error = tr("wrong token");
+    }
+    else if (hello.value("environment").toString() != m_environment)
+    {
+        error = tr("environment %1, expected %2").arg(hello.value("environment").toString(), m_environment);
+    }
+    else if (hello.value("slots").toInt() < 1)
+    {
+        error = tr("no slots");
+    }
+    if (!error.isEmpty())
+    {
+        peer->socket->write(encode(QJsonObject{{"type", "reject"}, {"error", error}}));
+        drop(peer, error);
+        return;
+    }
+    if (!hello.value("name").toString().isEmpty())
+    {
+        peer->name = QString("%1 (%2)").arg(hello.value("name").toString(), peer->name);
+    }
+    peer->capacity = hello.value("slots").toInt();
+    peer->accepted = true;
+    peer->socket->write(encode(QJsonObject{{"type", "welcome"}}));
+    emit logMessage(tr("Worker %1 joined with %2 slots").arg(peer->name).arg(peer->capacity));
+    emit slotsChanged(slotCount());
+    dispatch();
+}
+
+void ResolveCoordinator::finish(Peer *peer, const QJsonObject &result)
+{
+    const int testId = result.value("id").toInt();
+    if (!peer->tests.remove(testId) || !m_tests.contains(testId))
+    {
+        return; // cancelled meanwhile
+    }
+    const Test test = m_tests.take(testId);
+    const bool passed = result.value("passed").toBool();
+    const bool error = !passed && result.value("outcome").toString() == testOutcomeName(TestOutcome::Error);
+    Telemetry::end(test.span, passed);
+
+    QString outputPath;
+    if (passed)
+    {
+        outputPath = writeCompiled(testId, result.value("compiled").toString().toUtf8());
+    }
+    else
+    {
+        const QStringList lines = result.value("log").toString().trimmed().split('\n');
+        if (!lines.isEmpty() && !lines.last().isEmpty())
+        {
+            emit logMessage(QString("[%1] %2").arg(peer->name, lines.last().trimmed()));
+        }
+    }
+    const QJsonArray blamed = result.value("blamed").toArray();
+    if (!passed && !error && result.contains("failure"))
+    {
+        QStringList packages;
+        for (int i = 0; i < blamed.size(); ++i)
+        {
+            packages << blamed.at(i).toString();
+        }
+        emit failureClassified(testId, result.value("failure").toString(), packages);
+    }
+    emit testFinished(testId, passed ? TestOutcome::Passed : (error ? TestOutcome::Error : TestOutcome::Failed),
+                      outputPath);
+    dispatch();
+}
+
+/****************************************************************
+ * @brief Closes a worker's connection; onDisconnected() requeues
+ *        its tests.
+ ***************************************************************/
+void ResolveCoordinator::drop(Peer *peer, const QString &reason)
+{
+    emit logMessage(tr("Worker %1 dropped: %2").arg(peer->name, reason));
+    QTcpSocket *socket = peer->socket;
+    socket->disconnectFromHost();
+    // disconnected() may already have been handled synchronously
+    if (m_peers.contains(peer) && socket->state() == QAbstractSocket::UnconnectedState)
+    {
+        onDisconnected(peer);
+    }
+}
+
+void ResolveCoordinator::requeue(Peer *peer)
+{
+    // Oldest first, ahead of tests that were never sent
+    QList<int> ids(peer->tests.cbegin(), peer->tests.cend());
+    std::sort(ids.begin(), ids.end());
+    for (int i = int(ids.size()) - 1; i >= 0; --i)
+    {
+        auto it = m_tests.find(ids.at(i));
+        if (it == m_tests.end())
+        {
+            continue;
+        }
+        Telemetry::end(it->span, false);
+        Telemetry::add(Telemetry::Counter::Retries);
+        it->span = 0;
+        it->peer = nullptr;
+        m_queue.prepend(ids.at(i));
+    }
+    peer->tests.clear();
+}
+
+/****************************************************************
+ * @brief Sends queued tests to the workers with the most free
+ *        slots, so a fast node never sits idle behind a slow one.
+ ***************************************************************/
+void ResolveCoordinator::dispatch()
+{
+    while (!m_queue.isEmpty())
+    {
+        Peer *best = nullptr;
+        int bestFree = 0;
+        for (int i = 0; i < m_peers.size(); ++i)
+        {
+            Peer *peer = m_peers.at(i);
+            const int freeSlots = peer->capacity - int(peer->tests.size());
+            if (peer->accepted && freeSlots > bestFree)
+            {
+                best = peer;
+                bestFree = freeSlots;
+            }
+        }
+        if (!best)
+        {
+            return;
+        }
+        const int testId = m_queue.takeFirst();
+        auto it = m_tests.find(testId);
+        if (it == m_tests.end())
+        {
+            continue;
+        }
+        it->peer = best;
+        it->span = Telemetry::begin("remote pip-compile", best->name, QJsonObject{{"test", testId}});
+        best->tests.insert(testId);
+        best->socket->write(encode(QJsonObject{{"type", "test"},
+                                               {"id", testId},
+                                               {"pins", QJsonArray::fromStringList(it->pins)},
+                                               {"findLinks", m_findLinks},
+                                               {"offline", m_offline}}));
+    }
+}
+
+QString ResolveCoordinator::writeCompiled(int testId, const QByteArray &compiled)
+{
+    const QString dir = QDir(m_workDir.isEmpty() ? QDir::tempPath() : m_workDir).filePath("remote");
+    QDir().mkpath(dir);
+    const QString path = QDir(dir).filePath(QString("test-%1.txt").arg(testId));
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(compiled) != compiled.size() || !file.commit())
+    {
+        emit logMessage(tr("Cannot write %1: %2").arg(path, file.errorString()));
+        return QString();
+    }
+    m_compiled << path;
+    return path;
+}
+
+/************** End of ResolveCoordinator.cpp *******************/
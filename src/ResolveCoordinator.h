@@ -0,0 +1,199 @@
+/****************************************************************
+ * @file ResolveCoordinator.h
+ * @brief Declares ResolveCoordinator, which spreads pip-compile
+ *        tests over remote pmr-cli workers.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines ResolveCoordinator. It takes the place of the
+ * local PipCompileRunner behind ResolverEngine: every set the
+ * engine asks about is sent to the remote worker with the most free
+ * slots (see ResolveWorker) and the compiled file comes back.
+ *
+ * The search itself stays in one engine on the coordinator, so a
+ * conflict learned from any worker's failure prunes the whole
+ * candidate space at once, and every result lands in the
+ * coordinator's CompatibilityCache. Workers only compile.
+ *
+ * Protocol: JSON lines over TCP.
+ *   coord  -> {"type":"challenge","nonce":hex}
+ *   worker -> {"type":"hello","proof":hex,"environment":..,"slots":N,"name":..}
+ *   coord  -> {"type":"welcome"} | {"type":"reject","error":..}
+ *   coord  -> {"type":"test","id":N,"pins":[..],"findLinks":..,"offline":b}
+ *   worker -> {"type":"result","id":N,"passed":b,"outcome":..,"compiled":..,
+ *              "log":..,"failure":kind,"blamed":[..]}   (last two optional)
+ * "outcome" is testOutcomeName(); "error" (no verdict from pip) is
+ * passed on as TestOutcome::Error and never cached.
+ *   coord  -> {"type":"cancel"}
+ * A worker with a different environment key is rejected; the tests
+ * of a worker that disconnects are sent to the others again.
+ *
+ * Results go straight into the engine and the cache, so only
+ * workers that know the shared token may join. The token itself
+ * never crosses the wire: the proof is proof(token, nonce), an
+ * HMAC-SHA256 of a fresh random nonce, compared in constant time.
+ * A connection that has not sent a valid hello within
+ * kHelloTimeoutMs is closed. The traffic is not encrypted; bind to
+ * a private interface when the network is not trusted.
+ ***************************************************************/
+#ifndef RESOLVECOORDINATOR_H
+#define RESOLVECOORDINATOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QJsonObject>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include "TestOutcome.h"
+
+class QTcpServer;
+class QTcpSocket;
+
+/****************************************************************
+ * @class ResolveCoordinator
+ * @brief Remote test dispatcher for ResolverEngine.
+ ***************************************************************/
+class ResolveCoordinator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ResolveCoordinator(QObject *parent = nullptr);
+    ~ResolveCoordinator();
+
+    /****************************************************************
+     * @brief Accepts workers; fails while no token is set.
+     * @param port TCP port, 0 for any free one (see serverPort()).
+     * @param address Interface to bind, every one by default.
+     ***************************************************************/
+    bool listen(quint16 port, QString *error = nullptr, const QHostAddress &address = QHostAddress::Any);
+    quint16 serverPort() const;
+
+    /****************************************************************
+     * @brief Shared secret workers must prove they know.
+     ***************************************************************/
+    void setToken(const QString &token);
+
+    /****************************************************************
+     * @brief Time a new connection has for its hello (default
+     *        kHelloTimeoutMs).
+     ***************************************************************/
+    void setHelloTimeout(int timeoutMs);
+
+    /****************************************************************
+     * @brief Only workers with this environment key are accepted;
+     *        connected workers with another key are dropped.
+     ***************************************************************/
+    void setEnvironment(const QString &environment);
+
+    /****************************************************************
+     * @brief Folder for the compiled files workers send back.
+     ***************************************************************/
+    void setWorkDir(const QString &dir);
+
+    /****************************************************************
+     * @brief Wheelhouse passed on to workers with each test; they
+     *        use it only if the path exists on their side too.
+     ***************************************************************/
+    void setFindLinks(const QString &findLinks, bool offline);
+
+    /****************************************************************
+     * @brief Test slots of all accepted workers together.
+     ***************************************************************/
+    int slotCount() const;
+    int workerCount() const;
+    int testsQueued() const;
+
+    /****************************************************************
+     * @brief Drops queued tests and cancels running ones; no
+     *        results are reported for them.
+     ***************************************************************/
+    void cancelAll();
+
+    /****************************************************************
+     * @brief Deletes the compiled files workers sent back, see
+     *        PipCompileRunner::discardOutputs().
+     ***************************************************************/
+    void discardOutputs(const QString &keepPath = QString());
+
+    static QByteArray encode(const QJsonObject &message);
+
+    /****************************************************************
+     * @brief Hex HMAC-SHA256 of a challenge nonce keyed by the token.
+     ***************************************************************/
+    static QString proof(const QString &token, const QString &nonce);
+
+    static const int kHelloTimeoutMs = 5000;
+
+public slots:
+    /****************************************************************
+     * @brief Queues a test for the next free remote slot.
+     ***************************************************************/
+    void runTest(int testId, const QStringList &pins);
+
+signals:
+    void testFinished(int testId, TestOutcome outcome, const QString &outputPath);
+
+    /****************************************************************
+     * @brief A worker's FailureClassifier verdict, right before
+     *        testFinished(); see PipCompileRunner::failureClassified().
+     ***************************************************************/
+    void failureClassified(int testId, const QString &kind, const QStringList &packages);
+    void slotsChanged(int count);
+    void logMessage(const QString &line);
+
+private slots:
+    void onNewConnection();
+
+private:
+    struct Peer
+    {
+        QTcpSocket *socket = nullptr;
+        QString name;
+        QByteArray buffer;
+        QString nonce;               ///< challenge sent on connect
+        int capacity = 0;
+        bool accepted = false;
+        QSet<int> tests;             ///< running on this worker
+    };
+    struct Test
+    {
+        int id = 0;
+        QStringList pins;
+        Peer *peer = nullptr;
+        qint64 span = 0;             ///< Telemetry span while running
+    };
+
+    void onReadyRead(Peer *peer);
+    void onHelloTimeout(Peer *peer, QTcpSocket *socket);
+    void onDisconnected(Peer *peer);
+    void handle(Peer *peer, const QJsonObject &message);
+    void accept(Peer *peer, const QJsonObject &hello);
+    void finish(Peer *peer, const QJsonObject &result);
+    void drop(Peer *peer, const QString &reason);
+    void requeue(Peer *peer);
+    void dispatch();
+    QString writeCompiled(int testId, const QByteArray &compiled);
+
+    QTcpServer *m_server;
+    QList<Peer *> m_peers;
+    QList<int> m_queue;              ///< test ids waiting for a slot
+    QHash<int, Test> m_tests;        ///< queued and running
+    QString m_token;
+    int m_helloTimeoutMs = kHelloTimeoutMs;
+    QString m_environment;
+    QString m_workDir;
+    QString m_findLinks;
+    bool m_offline = false;
+    QStringList m_compiled;          ///< files written by writeCompiled()
+};
+
+#endif // RESOLVECOORDINATOR_H
+/************** End of ResolveCoordinator.h *********************/
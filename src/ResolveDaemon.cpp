@@ -0,0 +1,417 @@
+/****************************************************************
+ * @file ResolveDaemon.cpp
+ * @brief Implements the ResolveDaemon class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of ResolveDaemon: request
+ * parsing, the job queue and the event stream.
+ ***************************************************************/
+#include "ResolveDaemon.h"
+#include "Telemetry.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+ResolveDaemon::ResolveDaemon(ResolveSession *session, const Job &defaults, QObject *parent)
+    : QObject(parent)
+    , m_session(session)
+    , m_defaults(defaults)
+    , m_server(new QLocalServer(this))
+{
+    connect(m_server, &QLocalServer::newConnection, this, &ResolveDaemon::onNewConnection);
+    connect(m_session, &ResolveSession::logMessage, this, [this](const QString &line) {
+        QJsonObject event{{"event", "log"}, {"message", line}};
+        send(event);
+    });
+    connect(m_session, &ResolveSession::progressChanged, this, [this](int percent) {
+        QJsonObject event{{"event", "progress"}, {"percent", percent}};
+        send(event);
+    });
+    connect(m_session->progress(), &ResolveProgress::updated, this, [this](const ResolveProgress::Sample &sample) {
+        QJsonObject event = sample.toJson();
+        event.insert("event", "stats");
+        send(event);
+    });
+    connect(m_session, &ResolveSession::resolved,
+            this, [this](const QStringList &pins, const QString &outputPath) {
+                QJsonObject event{{"event", "resolved"},
+                                  {"pins", QJsonArray::fromStringList(pins)},
+                                  {"output", outputPath}};
+                if (!m_current.output.isEmpty())
+                {
+                    QFile::remove(m_current.output);
+                    if (QFile::copy(outputPath, m_current.output))
+                    {
+                        event.insert("output", m_current.output);
+                    }
+                    else
+                    {
+                        event.insert("warning", tr("Cannot write %1").arg(m_current.output));
+                    }
+                }
+                finish(event);
+            });
+    connect(m_session, &ResolveSession::exhausted, this, [this]() {
+        finish(QJsonObject{{"event", "exhausted"}});
+    });
+    connect(m_session, &ResolveSession::stopped, this, [this]() {
+        finish(QJsonObject{{"event", "stopped"}});
+    });
+    connect(m_session, &ResolveSession::failed, this, [this](const QString &error) {
+        finish(QJsonObject{{"event", "failed"}, {"error", error}});
+    });
+}
+
+ResolveDaemon::~ResolveDaemon()
+{
+    m_server->close();
+}
+
+bool ResolveDaemon::listen(const QString &name, QString *error)
+{
+    // Only the user who started the daemon may submit jobs
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    if (!m_server->listen(name))
+    {
+        QLocalServer::removeServer(name);
+        if (!m_server->listen(name))
+        {
+            if (error)
+            {
+                *error = m_server->errorString();
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+QString ResolveDaemon::defaultSocketName()
+{
+    return QStringLiteral("pip-matrix-resolver");
+}
+
+/****************************************************************
+ * @brief Reads one JSON request; fields that are present must
+ *        have the right type.
+ ***************************************************************/
+bool ResolveDaemon::parseJob(const QByteArray &line, const Job &defaults, Job *job, QString *error)
+{
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject())
+    {
+        *error = tr("Not a JSON object: %1").arg(parseError.errorString());
+        return false;
+    }
+    const QJsonObject object = document.object();
+    *job = defaults;
+    job->cmd = object.value("cmd").toString();
+    job->id = object.value("id").toString();
+    if (job->cmd == "status" || job->cmd == "stop" || job->cmd == "shutdown")
+    {
+        return true;
+    }
+    if (job->cmd != "resolve")
+    {
+        *error = tr("Unknown cmd \"%1\"").arg(job->cmd);
+        return false;
+    }
+
+    auto readString = [&](const char *key, QString *value) -> bool {
+        const QJsonValue v = object.value(key);
+        if (v.isUndefined())
+        {
+            return true;
+        }
+        if (!v.isString())
+        {
+            *error = tr("\"%1\" must be a string").arg(key);
+            return false;
+        }
+        *value = v.toString();
+        return true;
+    };
+    auto readBool = [&](const char *key, bool *value) -> bool {
+        const QJsonValue v = object.value(key);
+        if (v.isUndefined())
+        {
+            return true;
+        }
+        if (!v.isBool())
+        {
+            *error = tr("\"%1\" must be true or false").arg(key);
+            return false;
+        }
+        *value = v.toBool();
+        return true;
+    };
+    auto readInt = [&](const char *key, int minimum, int *value) -> bool {
+        const QJsonValue v = object.value(key);
+        if (v.isUndefined())
+        {
+            return true;
+        }
+        if (!v.isDouble() || v.toDouble() != double(v.toInt()) || v.toInt() < minimum)
+        {
+            *error = tr("\"%1\" must be an integer of at least %2").arg(key).arg(minimum);
+            return false;
+        }
+        *value = v.toInt();
+        return true;
+    };
+
+    int wheelhouseLimitGb = int(job->options.wheelhouseLimit / (1024LL * 1024 * 1024));
+    int prefetchRateMb = int(job->options.prefetchRate / (1024LL * 1024));
+    if (!readString("requirements", &job->requirementsFile)
+        || !readString("venv", &job->options.baseVenv)
+        || !readString("python", &job->pythonVersion)
+        || !readString("output", &job->output)
+        || !readString("trace", &job->trace)
+        || !readInt("workers", 1, &job->options.workers)
+        || !readInt("range", 0, &job->options.matrixRange)
+        || !readInt("wheelhouseLimitGb", 0, &wheelhouseLimitGb)
+        || !readInt("prefetchAhead", 0, &job->options.prefetchAhead)
+        || !readInt("prefetchRateMb", 0, &prefetchRateMb)
+        || !readBool("wheelhouse", &job->options.useWheelhouse)
+        || !readBool("incremental", &job->options.incremental)
+        || !readBool("cpu", &job->useCpu)
+        || !readBool("cuda", &job->cuda))
+    {
+        return false;
+    }
+    job->options.wheelhouseLimit = qint64(wheelhouseLimitGb) * 1024 * 1024 * 1024;
+    job->options.prefetchRate = qint64(prefetchRateMb) * 1024 * 1024;
+
+    const QJsonValue lines = object.value("lines");
+    if (!lines.isUndefined())
+    {
+        if (!lines.isArray())
+        {
+            *error = tr("\"lines\" must be an array of strings");
+            return false;
+        }
+        job->requirementsFile.clear();
+        job->lines.clear();
+        const QJsonArray array = lines.toArray();
+        for (int i = 0; i < array.size(); ++i)
+        {
+            if (!array.at(i).isString())
+            {
+                *error = tr("\"lines\" must be an array of strings");
+                return false;
+            }
+            job->lines << array.at(i).toString();
+        }
+    }
+    if (job->requirementsFile.isEmpty() && job->lines.isEmpty())
+    {
+        *error = tr("A resolve needs \"requirements\" or \"lines\"");
+        return false;
+    }
+    if (job->options.baseVenv.isEmpty())
+    {
+        *error = tr("A resolve needs \"venv\"");
+        return false;
+    }
+    return true;
+}
+
+void ResolveDaemon::onNewConnection()
+{
+    while (QLocalSocket *socket = m_server->nextPendingConnection())
+    {
+        m_clients << socket;
+        connect(socket, &QLocalSocket::readyRead, this, &ResolveDaemon::onReadyRead);
+        connect(socket, &QLocalSocket::disconnected, this, &ResolveDaemon::onDisconnected);
+        DEBUG_MSG() << "client connected" << m_clients.size();
+    }
+}
+
+void ResolveDaemon::onReadyRead()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    if (!socket)
+    {
+        return;
+    }
+    QByteArray &buffer = m_buffers[socket];
+    buffer += socket->readAll();
+    qsizetype end = buffer.indexOf('\n');
+    while (end >= 0)
+    {
+        const QByteArray line = buffer.left(end).trimmed();
+        buffer.remove(0, end + 1);
+        if (!line.isEmpty())
+        {
+            handle(socket, line);
+        }
+        end = buffer.indexOf('\n');
+    }
+}
+
+void ResolveDaemon::onDisconnected()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    if (!socket)
+    {
+        return;
+    }
+    // Its jobs keep running; the results stay in the output files
+    m_clients.removeAll(socket);
+    m_buffers.remove(socket);
+    socket->deleteLater();
+}
+
+/****************************************************************
+ * @brief Runs one request. Errors go back to the sender only.
+ ***************************************************************/
+void ResolveDaemon::handle(QLocalSocket *socket, const QByteArray &line)
+{
+    Job job;
+    QString error;
+    if (!parseJob(line, m_defaults, &job, &error))
+    {
+        send(QJsonObject{{"event", "error"}, {"error", error}}, socket);
+        return;
+    }
+    if (job.cmd == "status")
+    {
+        send(status(), socket);
+        return;
+    }
+    if (job.cmd == "stop")
+    {
+        // Only the current job; queued ones follow
+        m_session->stop();
+        return;
+    }
+    if (job.cmd == "shutdown")
+    {
+        m_queue.clear();
+        if (m_running)
+        {
+            m_session->stop();
+        }
+        emit shutdownRequested();
+        return;
+    }
+
+    if (job.id.isEmpty())
+    {
+        job.id = QString("job-%1").arg(m_nextId++);
+    }
+    m_queue << job;
+    send(QJsonObject{{"event", "queued"}, {"job", job.id}, {"position", int(m_queue.size())}});
+    startNext();
+}
+
+/****************************************************************
+ * @brief Starts the next queued job if the session is idle.
+ ***************************************************************/
+void ResolveDaemon::startNext()
+{
+    while (!m_running && !m_queue.isEmpty())
+    {
+        m_current = m_queue.takeFirst();
+        QVector<Requirement> requirements;
+        QString error;
+        const bool read = m_current.requirementsFile.isEmpty()
+                              ? ResolveSession::parseRequirements(m_current.lines, &requirements, &error)
+                              : ResolveSession::readRequirements(m_current.requirementsFile, &requirements,
+                                                                 &error);
+        if (!read)
+        {
+            send(QJsonObject{{"event", "failed"}, {"job", m_current.id}, {"error", error}});
+            continue;
+        }
+        ResolveSession::Options options = m_current.options;
+        options.environment = ResolveSession::hostEnvironment(options.baseVenv,
+                                                              m_current.pythonVersion,
+                                                              m_current.useCpu,
+                                                              m_current.cuda);
+        m_running = true;
+        send(QJsonObject{{"event", "started"}, {"job", m_current.id}, {"environment", options.environment}});
+        if (!m_session->start(requirements, options))
+        {
+            m_running = false;
+            send(QJsonObject{{"event", "failed"}, {"job", m_current.id},
+                             {"error", tr("Matrix resolution is already running")}});
+        }
+    }
+}
+
+/****************************************************************
+ * @brief Reports the end of the current job and starts the next.
+ ***************************************************************/
+void ResolveDaemon::finish(const QJsonObject &event)
+{
+    if (!m_running)
+    {
+        return;
+    }
+    m_running = false;
+    QJsonObject done = event;
+    if (!m_current.trace.isEmpty())
+    {
+        QString error;
+        if (Telemetry::exportTrace(m_current.trace, &error))
+        {
+            done.insert("trace", m_current.trace);
+        }
+        else
+        {
+            done.insert("warning", tr("Cannot write run trace %1: %2").arg(m_current.trace, error));
+        }
+    }
+    send(done);
+    startNext();
+}
+
+/****************************************************************
+ * @brief Writes one event line, tagged with the current job.
+ * @param socket Recipient, or nullptr for every client.
+ ***************************************************************/
+void ResolveDaemon::send(QJsonObject event, QLocalSocket *socket)
+{
+    if (!event.contains("job") && m_running)
+    {
+        event.insert("job", m_current.id);
+    }
+    const QByteArray line = QJsonDocument(event).toJson(QJsonDocument::Compact) + '\n';
+    if (socket)
+    {
+        socket->write(line);
+        return;
+    }
+    for (int i = 0; i < m_clients.size(); ++i)
+    {
+        m_clients.at(i)->write(line);
+    }
+}
+
+QJsonObject ResolveDaemon::status() const
+{
+    QJsonArray queued;
+    for (int i = 0; i < m_queue.size(); ++i)
+    {
+        queued.append(m_queue.at(i).id);
+    }
+    return QJsonObject{{"event", "status"},
+                       {"busy", m_session->isBusy()},
+                       {"paused", m_session->isPaused()},
+                       {"job", m_running ? m_current.id : QString()},
+                       {"queued", queued}};
+}
+
+/************** End of ResolveDaemon.cpp ************************/
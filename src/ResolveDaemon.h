@@ -0,0 +1,125 @@
+/****************************************************************
+ * @file ResolveDaemon.h
+ * @brief Declares ResolveDaemon, the pmr-cli job server.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines ResolveDaemon. It listens on a local socket
+ * (named pipe on Windows) and takes one JSON object per line:
+ *   {"cmd":"resolve","id":"a","requirements":"/path/requirements.txt",
+ *    "venv":"/path/venv","workers":4,"range":2,"wheelhouse":true,
+ *    "wheelhouseLimitGb":20,"prefetchAhead":3,"prefetchRateMb":0,
+ *    "incremental":true,
+ *    "python":"3.11","cpu":false,"cuda":true,"output":"/path/out.txt"}
+ *   {"cmd":"status"}   {"cmd":"stop"}   {"cmd":"shutdown"}
+ * "lines" (an array of requirement lines) may replace
+ * "requirements"; missing fields take the pmr-cli defaults.
+ *
+ * Jobs run one at a time on a single ResolveSession, so they share
+ * the compatibility cache, wheelhouse and warmed worker venvs.
+ * Events are JSON lines sent to every connected client:
+ *   queued, started, log, progress, stats, resolved, exhausted,
+ *   stopped, failed, status, error
+ * and carry the job id where there is one. "stats" is a
+ * ResolveProgress sample, sent once a second during the search.
+ ***************************************************************/
+#ifndef RESOLVEDAEMON_H
+#define RESOLVEDAEMON_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "ResolveSession.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+/****************************************************************
+ * @class ResolveDaemon
+ * @brief Queues resolve jobs from local clients.
+ ***************************************************************/
+class ResolveDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************
+     * @struct Job
+     * @brief One parsed request line.
+     ***************************************************************/
+    struct Job
+    {
+        QString cmd;                  ///< resolve, status, stop or shutdown
+        QString id;
+        QString requirementsFile;
+        QStringList lines;            ///< used when requirementsFile is empty
+        ResolveSession::Options options;
+        QString pythonVersion;        ///< empty to ask the venv's interpreter
+        bool useCpu = false;
+        bool cuda = true;
+        QString output;               ///< copy of the compiled file, optional
+        QString trace;                ///< Chrome trace of the run, optional
+    };
+
+    /****************************************************************
+     * @param session Runs the jobs; not owned.
+     * @param defaults Options for fields a job leaves out.
+     ***************************************************************/
+    ResolveDaemon(ResolveSession *session, const Job &defaults, QObject *parent = nullptr);
+    ~ResolveDaemon();
+
+    /****************************************************************
+     * @brief Starts listening, replacing a stale socket of a daemon
+     *        that did not exit cleanly.
+     ***************************************************************/
+    bool listen(const QString &name, QString *error = nullptr);
+
+    /****************************************************************
+     * @brief Parses one request line.
+     * @param defaults Values for the fields the line leaves out.
+     * @return false with error set for malformed or unknown input.
+     ***************************************************************/
+    static bool parseJob(const QByteArray &line, const Job &defaults, Job *job, QString *error);
+
+    static QString defaultSocketName();
+
+signals:
+    /****************************************************************
+     * @brief A client asked the daemon to exit; the current job has
+     *        been stopped and its checkpoint kept.
+     ***************************************************************/
+    void shutdownRequested();
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+
+private:
+    void handle(QLocalSocket *socket, const QByteArray &line);
+    void startNext();
+    void finish(const QJsonObject &event);
+    void send(QJsonObject event, QLocalSocket *socket = nullptr);
+    QJsonObject status() const;
+
+    ResolveSession *m_session;
+    Job m_defaults;
+    QLocalServer *m_server;
+    QList<QLocalSocket *> m_clients;
+    QHash<QLocalSocket *, QByteArray> m_buffers;
+    QVector<Job> m_queue;
+    Job m_current;
+    bool m_running = false;
+    int m_nextId = 1;
+};
+
+#endif // RESOLVEDAEMON_H
+/************** End of ResolveDaemon.h **************************/
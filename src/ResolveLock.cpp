@@ -0,0 +1,286 @@
+/****************************************************************
+ * @file ResolveLock.cpp
+ * @brief Implements the ResolveLock class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of ResolveLock.
+ ***************************************************************/
+#include "ResolveLock.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const int kLockFormat = 1;
+
+void ResolveLock::setPath(const QString &path)
+{
+    m_path = path;
+}
+
+QString ResolveLock::path() const
+{
+    return m_path;
+}
+
+/****************************************************************
+ * @brief Reads the lock of one environment.
+ ***************************************************************/
+bool ResolveLock::load(const QString &environment)
+{
+    m_lines.clear();
+    m_versions.clear();
+    m_pins.clear();
+
+    QFile file(m_path);
+    if (m_path.isEmpty() || !file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("format").toInt() != kLockFormat)
+    {
+        return false;
+    }
+    const QJsonObject entry = root.value("environments").toObject().value(environment).toObject();
+    const QJsonArray lines = entry.value("requirements").toArray();
+    const QJsonArray pins = entry.value("pins").toArray();
+    if (pins.isEmpty())
+    {
+        return false;
+    }
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        const Requirement requirement = Requirement::parse(lines.at(i).toString());
+        m_lines.insert(lineKey(requirement), compact(requirement.line));
+    }
+    for (int i = 0; i < pins.size(); ++i)
+    {
+        const Requirement pin = Requirement::parse(pins.at(i).toString());
+        m_pins << pin.line;
+        if (pin.project.isEmpty())
+        {
+            continue;
+        }
+        // A bare name stands for an unpinned column
+        const bool exact = pin.clauses.size() == 1 && pin.clauses.first().op == Requirement::Op::Equal;
+        m_versions.insert(pin.project, exact ? pin.version(0) : QString());
+    }
+    DEBUG_MSG() << "lock" << environment << m_pins;
+    return true;
+}
+
+/****************************************************************
+ * @brief Replaces the lock of one environment.
+ ***************************************************************/
+bool ResolveLock::save(const QString &environment, const QVector<Requirement> &requirements,
+                       const QStringList &pins)
+{
+    if (m_path.isEmpty())
+    {
+        return false;
+    }
+    QJsonObject root;
+    QFile existing(m_path);
+    if (existing.open(QIODevice::ReadOnly))
+    {
+        root = QJsonDocument::fromJson(existing.readAll()).object();
+        existing.close();
+    }
+    if (root.value("format").toInt() != kLockFormat)
+    {
+        root = QJsonObject();
+    }
+
+    QJsonArray lines;
+    for (int i = 0; i < requirements.size(); ++i)
+    {
+        lines.append(requirements.at(i).line);
+    }
+    QJsonObject entry;
+    entry.insert("requirements", lines);
+    entry.insert("pins", QJsonArray::fromStringList(pins));
+    entry.insert("saved", QDateTime::currentMSecsSinceEpoch());
+    QJsonObject environments = root.value("environments").toObject();
+    environments.insert(environment, entry);
+    root.insert("format", kLockFormat);
+    root.insert("environments", environments);
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "Cannot write resolve lock" << m_path;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    if (!file.commit())
+    {
+        qWarning() << "Cannot commit resolve lock" << m_path;
+        return false;
+    }
+    return load(environment);
+}
+
+bool ResolveLock::isEmpty() const
+{
+    return m_pins.isEmpty();
+}
+
+const QStringList &ResolveLock::pins() const
+{
+    return m_pins;
+}
+
+QString ResolveLock::version(const QString &project) const
+{
+    return m_versions.value(project);
+}
+
+/****************************************************************
+ * @brief Diffs requirement lines against the lock.
+ ***************************************************************/
+QSet<QString> ResolveLock::changedProjects(const QVector<Requirement> &requirements,
+                                           bool *unnamedChanged) const
+{
+    QSet<QString> changed;
+    bool unnamed = false;
+    for (int i = 0; i < requirements.size(); ++i)
+    {
+        const Requirement &requirement = requirements.at(i);
+        const QString key = lineKey(requirement);
+        const auto it = m_lines.constFind(key);
+        if (it != m_lines.constEnd() && it.value() == compact(requirement.line))
+        {
+            continue;
+        }
+        if (requirement.project.isEmpty())
+        {
+            unnamed = true;
+            continue;
+        }
+        changed.insert(requirement.project);
+    }
+    if (unnamedChanged)
+    {
+        *unnamedChanged = unnamed;
+    }
+    return changed;
+}
+
+/****************************************************************
+ * @brief Closes the changed set over reverse dependencies, then
+ *        adds what the changed projects themselves require: their
+ *        new ranges may need other versions of those.
+ ***************************************************************/
+QSet<QString> ResolveLock::affectedProjects(const QSet<QString> &changed,
+                                            const QHash<QString, QSet<QString>> &dependencies)
+{
+    QSet<QString> affected = changed;
+    bool grew = true;
+    while (grew)
+    {
+        grew = false;
+        for (auto it = dependencies.constBegin(); it != dependencies.constEnd(); ++it)
+        {
+            if (!affected.contains(it.key()) && it.value().intersects(affected))
+            {
+                affected.insert(it.key());
+                grew = true;
+            }
+        }
+    }
+    for (auto it = changed.constBegin(); it != changed.constEnd(); ++it)
+    {
+        affected.unite(dependencies.value(*it));
+    }
+    return affected;
+}
+
+/****************************************************************
+ * @brief Keeps unaffected columns at their locked version.
+ ***************************************************************/
+int ResolveLock::narrow(QVector<PackageCandidates> *packages, QVector<ResolverSet> *conflicts,
+                        const QSet<QString> &affected) const
+{
+    if (!packages || isEmpty())
+    {
+        return 0;
+    }
+    QVector<int> kept(packages->size(), -1); ///< column -> surviving old index, -1 for all
+    int narrowed = 0;
+    for (int i = 0; i < packages->size(); ++i)
+    {
+        PackageCandidates &package = (*packages)[i];
+        const QString project = Requirement::parse(package.name).project;
+        if (project.isEmpty() || affected.contains(project) || !m_versions.contains(project)
+            || package.versions.size() < 2)
+        {
+            continue;
+        }
+        const int index = int(package.versions.indexOf(m_versions.value(project)));
+        if (index < 0)
+        {
+            continue; // the locked version is no longer a candidate
+        }
+        package.versions = QStringList() << package.versions.at(index);
+        kept[i] = index;
+        ++narrowed;
+    }
+
+    if (conflicts)
+    {
+        QVector<ResolverSet> remapped;
+        for (int i = 0; i < conflicts->size(); ++i)
+        {
+            ResolverSet set = conflicts->at(i);
+            bool valid = true;
+            for (int j = 0; j < set.size() && valid; ++j)
+            {
+                const int column = set.at(j).package;
+                if (column < 0 || column >= kept.size() || kept.at(column) < 0)
+                {
+                    continue;
+                }
+                valid = set.at(j).version == kept.at(column);
+                set[j].version = 0;
+            }
+            if (valid)
+            {
+                remapped.append(set);
+            }
+        }
+        *conflicts = remapped;
+    }
+    return narrowed;
+}
+
+/****************************************************************
+ * @brief Project of a named line, else the line itself.
+ ***************************************************************/
+QString ResolveLock::lineKey(const Requirement &requirement)
+{
+    return requirement.project.isEmpty() ? compact(requirement.line) : requirement.project;
+}
+
+QString ResolveLock::compact(const QString &line)
+{
+    QString out = line;
+    out.remove(' ');
+    out.remove('\t');
+    return out;
+}
+
+/************** End of ResolveLock.cpp **************************/
@@ -0,0 +1,112 @@
+/****************************************************************
+ * @file ResolveLock.h
+ * @brief Declares ResolveLock, the last successful resolve of each
+ *        environment, for incremental re-resolves.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines ResolveLock. After a resolve succeeds the
+ * session saves its requirement lines and the working pins, keyed
+ * by CompatibilityCache::environmentKey(). When the requirements
+ * are resolved again, changedProjects() diffs them against the
+ * lock, affectedProjects() adds the projects that depend on a
+ * changed one (from requires_dist) and narrow() keeps every other
+ * column at its locked version, so the search only spans what the
+ * edit can have touched.
+ *
+ * Compile results and learned conflicts need no such step: the
+ * compatibility cache keys them by pins, so they stay valid across
+ * edits of the file. The lock only shrinks the matrix; if nothing
+ * compiles around it the session searches the full matrix.
+ *
+ * File (JSON, written through QSaveFile):
+ *   {"format":1,"environments":{"<key>":{"requirements":[...],
+ *    "pins":[...],"saved":<ms since epoch>}}}
+ ***************************************************************/
+#ifndef RESOLVELOCK_H
+#define RESOLVELOCK_H
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "Requirement.h"
+#include "ResolverEngine.h"
+
+/****************************************************************
+ * @class ResolveLock
+ * @brief Requirement lines and pins of the last working resolve.
+ ***************************************************************/
+class ResolveLock
+{
+public:
+    void setPath(const QString &path);
+    QString path() const;
+
+    /****************************************************************
+     * @brief Reads the lock of one environment.
+     * @return false if there is none (the lock is then empty).
+     ***************************************************************/
+    bool load(const QString &environment);
+
+    /****************************************************************
+     * @brief Replaces the lock of one environment and writes the
+     *        file; the locks of other environments are kept.
+     * @param pins ResolverEngine::resolved() pins.
+     ***************************************************************/
+    bool save(const QString &environment, const QVector<Requirement> &requirements,
+              const QStringList &pins);
+
+    bool isEmpty() const;
+    const QStringList &pins() const;
+
+    /****************************************************************
+     * @brief Locked version of a project, empty if not locked.
+     ***************************************************************/
+    QString version(const QString &project) const;
+
+    /****************************************************************
+     * @brief Projects whose requirement line is new or differs from
+     *        the lock (whitespace aside). Removed lines change
+     *        nothing: dropping a pin keeps a working set working.
+     * @param unnamedChanged Set when a line without a project
+     *        (URL, -r, option) is new, since its effect is unknown.
+     ***************************************************************/
+    QSet<QString> changedProjects(const QVector<Requirement> &requirements,
+                                  bool *unnamedChanged = nullptr) const;
+
+    /****************************************************************
+     * @brief The changed projects, everything that transitively
+     *        depends on them and their direct dependencies.
+     * @param dependencies CandidateFetcher::dependencies().
+     ***************************************************************/
+    static QSet<QString> affectedProjects(const QSet<QString> &changed,
+                                          const QHash<QString, QSet<QString>> &dependencies);
+
+    /****************************************************************
+     * @brief Narrows every column outside affected to its locked
+     *        version, if that is still a candidate.
+     * @param packages Matrix to narrow in place.
+     * @param conflicts Static conflicts of the matrix; those with a
+     *        dropped candidate go, the rest are re-indexed.
+     * @return Number of columns narrowed.
+     ***************************************************************/
+    int narrow(QVector<PackageCandidates> *packages, QVector<ResolverSet> *conflicts,
+               const QSet<QString> &affected) const;
+
+private:
+    static QString lineKey(const Requirement &requirement);
+    static QString compact(const QString &line);
+
+    QString m_path;
+    QHash<QString, QString> m_lines;     ///< project (or line) -> compacted line
+    QHash<QString, QString> m_versions;  ///< project -> locked version
+    QStringList m_pins;
+};
+
+#endif // RESOLVELOCK_H
+/************** End of ResolveLock.h ****************************/
@@ -0,0 +1,264 @@
+/****************************************************************
+ * @file ResolveProgress.cpp
+ * @brief Implements the ResolveProgress class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of ResolveProgress. Each
+ * tick appends the frontier and test count to a window of the last
+ * kWindowMs; the rates are the difference between its newest and
+ * oldest points.
+ ***************************************************************/
+#include "ResolveProgress.h"
+#include "ResolverEngine.h"
+#include "Telemetry.h"
+#include <QJsonArray>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const int kDefaultIntervalMs = 1000;
+static const qint64 kWindowMs = 5 * 60 * 1000;
+
+/****************************************************************
+ * @brief Constructor: Attaches to an engine; samples nothing yet.
+ ***************************************************************/
+ResolveProgress::ResolveProgress(ResolverEngine *engine, QObject *parent)
+    : QObject(parent)
+    , m_engine(engine)
+{
+    qRegisterMetaType<ResolveProgress::Sample>();
+    m_timer.setInterval(kDefaultIntervalMs);
+    connect(&m_timer, &QTimer::timeout, this, &ResolveProgress::tick);
+}
+
+void ResolveProgress::setInterval(int intervalMs)
+{
+    m_timer.setInterval(qMax(250, intervalMs));
+}
+
+int ResolveProgress::interval() const
+{
+    return m_timer.interval();
+}
+
+/****************************************************************
+ * @brief Starts a new window at the engine's current position.
+ ***************************************************************/
+void ResolveProgress::begin()
+{
+    m_clock.start();
+    m_window.clear();
+    m_window.append(now());
+    m_timer.start();
+}
+
+/****************************************************************
+ * @brief Stops the timer; one final sample for the display.
+ ***************************************************************/
+void ResolveProgress::end()
+{
+    if (!m_timer.isActive())
+    {
+        return;
+    }
+    m_timer.stop();
+    emit updated(sample());
+}
+
+bool ResolveProgress::isActive() const
+{
+    return m_timer.isActive();
+}
+
+/****************************************************************
+ * @brief Counters of the engine now.
+ ***************************************************************/
+ResolveProgress::Point ResolveProgress::now() const
+{
+    Point point;
+    point.ms = m_clock.isValid() ? m_clock.elapsed() : 0;
+    point.frontier = m_engine->searchPosition();
+    point.tests = m_engine->testsLaunched();
+    return point;
+}
+
+/****************************************************************
+ * @brief Extends the window and emits a sample.
+ ***************************************************************/
+void ResolveProgress::tick()
+{
+    const Point point = now();
+    // A pause, a restart or a widened search invalidates the rates
+    if (m_engine->isPaused() || m_window.isEmpty() || point.frontier < m_window.last().frontier
+        || point.tests < m_window.last().tests)
+    {
+        m_window.clear();
+    }
+    m_window.append(point);
+    while (m_window.size() > 2 && point.ms - m_window.at(1).ms >= kWindowMs)
+    {
+        m_window.removeFirst();
+    }
+    DEBUG_MSG() << "ResolveProgress::tick" << point.ms << point.frontier << point.tests;
+    emit updated(sample());
+}
+
+/****************************************************************
+ * @brief Current values, rates over the window.
+ ***************************************************************/
+ResolveProgress::Sample ResolveProgress::sample() const
+{
+    Sample result;
+    const Point point = now();
+    result.elapsedMs = point.ms;
+    result.paused = m_engine->isPaused();
+    result.combinations = m_engine->totalCombinations();
+    result.frontier = point.frontier;
+    result.pruned = m_engine->combinationsPruned();
+    result.tests = point.tests;
+    result.cacheHits = m_engine->cacheHits();
+    const int answered = result.tests + result.cacheHits;
+    result.cacheHitRate = answered > 0 ? double(result.cacheHits) / answered : 0.0;
+    result.activeWorkers = m_engine->testsInFlight();
+    result.idleWorkers = m_engine->isRunning() ? qMax(0, m_engine->maxParallelTests() - result.activeWorkers) : 0;
+    if (result.combinations > 0.0)
+    {
+        result.percent = qBound(0, static_cast<int>(100.0 * result.frontier / result.combinations), 100);
+    }
+
+    if (!m_window.isEmpty() && !result.paused)
+    {
+        const Point &oldest = m_window.first();
+        const qint64 spanMs = point.ms - oldest.ms;
+        if (spanMs > 0 && point.frontier >= oldest.frontier && point.tests >= oldest.tests)
+        {
+            result.testsPerMinute = 60000.0 * (point.tests - oldest.tests) / spanMs;
+            result.combinationsPerMinute = 60000.0 * (point.frontier - oldest.frontier) / spanMs;
+        }
+    }
+    if (result.combinationsPerMinute > 0.0)
+    {
+        result.etaMs = 60000.0 * (result.combinations - result.frontier) / result.combinationsPerMinute;
+    }
+
+    const Telemetry::Snapshot telemetry = Telemetry::snapshot();
+    for (int i = 0; i < telemetry.phases.size(); ++i)
+    {
+        const Telemetry::Phase &phase = telemetry.phases.at(i);
+        if (phase.count <= 0)
+        {
+            continue;
+        }
+        PhaseMean mean;
+        mean.name = phase.name;
+        mean.count = phase.count;
+        mean.meanMs = phase.totalUs / 1000.0 / phase.count;
+        result.phases.append(mean);
+    }
+    return result;
+}
+
+/****************************************************************
+ * @brief The sample for the daemon's "stats" event.
+ ***************************************************************/
+QJsonObject ResolveProgress::Sample::toJson() const
+{
+    QJsonObject object;
+    object.insert(QStringLiteral("elapsedMs"), double(elapsedMs));
+    object.insert(QStringLiteral("paused"), paused);
+    object.insert(QStringLiteral("percent"), percent);
+    object.insert(QStringLiteral("combinations"), combinations);
+    object.insert(QStringLiteral("frontier"), frontier);
+    object.insert(QStringLiteral("pruned"), pruned);
+    object.insert(QStringLiteral("tests"), tests);
+    object.insert(QStringLiteral("cacheHits"), cacheHits);
+    object.insert(QStringLiteral("cacheHitRate"), cacheHitRate);
+    object.insert(QStringLiteral("testsPerMinute"), testsPerMinute);
+    object.insert(QStringLiteral("combinationsPerMinute"), combinationsPerMinute);
+    object.insert(QStringLiteral("activeWorkers"), activeWorkers);
+    object.insert(QStringLiteral("idleWorkers"), idleWorkers);
+    object.insert(QStringLiteral("etaMs"), etaMs);
+    QJsonArray phaseArray;
+    for (int i = 0; i < phases.size(); ++i)
+    {
+        QJsonObject phase;
+        phase.insert(QStringLiteral("name"), phases.at(i).name);
+        phase.insert(QStringLiteral("count"), phases.at(i).count);
+        phase.insert(QStringLiteral("meanMs"), phases.at(i).meanMs);
+        phaseArray.append(phase);
+    }
+    object.insert(QStringLiteral("phases"), phaseArray);
+    return object;
+}
+
+/****************************************************************
+ * @brief Text of a sample, one line per topic.
+ ***************************************************************/
+QString ResolveProgress::describe(const Sample &sample)
+{
+    QStringList lines;
+    QString eta = tr("unknown");
+    if (sample.paused)
+    {
+        eta = tr("paused");
+    }
+    else if (sample.etaMs >= 0.0)
+    {
+        eta = tr("at most %1").arg(formatDuration(sample.etaMs));
+    }
+    lines << tr("%1% of %2 combinations after %3, ETA %4")
+                 .arg(sample.percent)
+                 .arg(sample.combinations, 0, 'g', 6)
+                 .arg(formatDuration(double(sample.elapsedMs)))
+                 .arg(eta);
+    lines << tr("%1 tests/min, %2 combinations/min, %3 pruned")
+                 .arg(sample.testsPerMinute, 0, 'f', 1)
+                 .arg(sample.combinationsPerMinute, 0, 'g', 4)
+                 .arg(sample.pruned, 0, 'g', 6);
+    lines << tr("Workers %1 busy, %2 idle; %3 tests, %4 from cache (%5%)")
+                 .arg(sample.activeWorkers)
+                 .arg(sample.idleWorkers)
+                 .arg(sample.tests)
+                 .arg(sample.cacheHits)
+                 .arg(100.0 * sample.cacheHitRate, 0, 'f', 0);
+    QStringList means;
+    for (int i = 0; i < sample.phases.size(); ++i)
+    {
+        means << QStringLiteral("%1 %2 ms").arg(sample.phases.at(i).name).arg(sample.phases.at(i).meanMs, 0, 'f', 0);
+    }
+    if (!means.isEmpty())
+    {
+        lines << tr("Mean: %1").arg(means.join(QStringLiteral(", ")));
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+/****************************************************************
+ * @brief Two most significant units of a duration.
+ ***************************************************************/
+QString ResolveProgress::formatDuration(double ms)
+{
+    const qint64 seconds = static_cast<qint64>(qMax(0.0, ms) / 1000.0 + 0.5);
+    if (seconds < 60)
+    {
+        return tr("%1 s").arg(seconds);
+    }
+    const qint64 minutes = seconds / 60;
+    if (minutes < 60)
+    {
+        return tr("%1 min").arg(minutes);
+    }
+    const qint64 hours = minutes / 60;
+    if (hours < 48)
+    {
+        return tr("%1 h %2 min").arg(hours).arg(minutes % 60);
+    }
+    return tr("%1 d %2 h").arg(hours / 24).arg(hours % 24);
+}
+
+/************** End of ResolveProgress.cpp **********************/
@@ -0,0 +1,150 @@
+/****************************************************************
+ * @file ResolveProgress.h
+ * @brief Declares ResolveProgress, the live throughput and ETA of
+ *        a running search.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines ResolveProgress. With pruning and parallel
+ * workers the odometer percentage says little, so while a search
+ * runs this samples the ResolverEngine and Telemetry on a timer
+ * and emits a Sample: tests per minute, combinations retired and
+ * pruned, busy and idle workers, cache hit rate, mean duration per
+ * phase and an ETA.
+ *
+ * The search frontier is the odometer position: every combination
+ * before it is compiled, failed or pruned. Rates are taken over
+ * the last few minutes, so a burst of pruning or a slow start fades
+ * out; the ETA is the remaining frontier at that rate, which is an
+ * upper bound as conflicts learned later prune ahead of it. Pausing
+ * restarts the window.
+ *
+ * Nothing is computed per test: the engine's counters are read once
+ * per interval (1 s by default), so the cost to the GUI thread does
+ * not grow with the test rate.
+ ***************************************************************/
+#ifndef RESOLVEPROGRESS_H
+#define RESOLVEPROGRESS_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+class ResolverEngine;
+
+/****************************************************************
+ * @class ResolveProgress
+ * @brief Periodic progress samples of a ResolverEngine.
+ ***************************************************************/
+class ResolveProgress : public QObject
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************
+     * @struct PhaseMean
+     * @brief Mean duration of one Telemetry phase so far.
+     ***************************************************************/
+    struct PhaseMean
+    {
+        QString name;
+        int count = 0;
+        double meanMs = 0.0;
+    };
+
+    /****************************************************************
+     * @struct Sample
+     * @brief The search at one moment.
+     ***************************************************************/
+    struct Sample
+    {
+        qint64 elapsedMs = 0;            ///< since begin()
+        bool paused = false;
+        int percent = 0;                 ///< frontier / combinations
+        double combinations = 0.0;
+        double frontier = 0.0;           ///< combinations retired
+        double pruned = 0.0;
+        int tests = 0;                   ///< launched, probes included
+        int cacheHits = 0;
+        double cacheHitRate = 0.0;       ///< of all answered sets, 0-1
+        double testsPerMinute = 0.0;
+        double combinationsPerMinute = 0.0;
+        int activeWorkers = 0;
+        int idleWorkers = 0;
+        double etaMs = -1.0;             ///< < 0 while unknown
+        QVector<PhaseMean> phases;
+
+        QJsonObject toJson() const;
+    };
+
+    explicit ResolveProgress(ResolverEngine *engine, QObject *parent = nullptr);
+
+    /****************************************************************
+     * @brief Sets how often updated() is emitted.
+     * @param intervalMs Milliseconds (minimum 250).
+     ***************************************************************/
+    void setInterval(int intervalMs);
+    int interval() const;
+
+    /****************************************************************
+     * @brief Starts sampling a search that has just started or
+     *        resumed from a checkpoint.
+     ***************************************************************/
+    void begin();
+
+    /****************************************************************
+     * @brief Stops sampling and emits the last sample.
+     ***************************************************************/
+    void end();
+
+    bool isActive() const;
+
+    /****************************************************************
+     * @brief Current values, rates over the samples taken so far.
+     ***************************************************************/
+    Sample sample() const;
+
+    /****************************************************************
+     * @brief Multi-line text of a sample for a status panel.
+     ***************************************************************/
+    static QString describe(const Sample &sample);
+
+    /****************************************************************
+     * @brief "45 s", "12 min", "3 h 12 min", "2 d 4 h".
+     ***************************************************************/
+    static QString formatDuration(double ms);
+
+signals:
+    void updated(const ResolveProgress::Sample &sample);
+
+private:
+    /****************************************************************
+     * @struct Point
+     * @brief Counters at one tick, for the rates.
+     ***************************************************************/
+    struct Point
+    {
+        qint64 ms = 0;
+        double frontier = 0.0;
+        int tests = 0;
+    };
+
+    void tick();
+    Point now() const;
+
+    ResolverEngine *m_engine;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    QVector<Point> m_window;             ///< oldest first, within kWindowMs
+};
+
+Q_DECLARE_METATYPE(ResolveProgress::Sample)
+
+#endif // RESOLVEPROGRESS_H
+/************** End of ResolveProgress.h ************************/
@@ -0,0 +1,659 @@
+/****************************************************************
+ * @file ResolveSession.cpp
+ * @brief Implements the ResolveSession class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of ResolveSession. The
+ * order of the steps is the one MainWindow used to drive by hand:
+ * prepare the runner and cache for the environment, fetch the
+ * candidates, store their wheels, then start the engine, the
+ * checkpoint and the progress samples. The engine's own per-step
+ * percentage is not forwarded; the samples are enough and cost
+ * nothing per test.
+ ***************************************************************/
+#include "ResolveSession.h"
+#include "SystemProbe.h"
+#include "Telemetry.h"
+#include "VenvManager.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTimer>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+ResolveSession::ResolveSession(QObject *parent)
+    : QObject(parent)
+    , m_engine(new ResolverEngine(this))
+    , m_runner(new PipCompileRunner(this))
+    , m_cache(new CompatibilityCache(this))
+    , m_fetcher(new CandidateFetcher(this))
+    , m_wheelhouse(new Wheelhouse(this))
+    , m_checkpoint(new ResolverCheckpoint(m_engine, this))
+    , m_progress(new ResolveProgress(m_engine, this))
+{
+    connect(m_engine, &ResolverEngine::testRequested, m_runner, &PipCompileRunner::runTest);
+    connect(m_runner, &PipCompileRunner::testFinished, m_engine, &ResolverEngine::reportTestResult);
+    connect(m_runner, &PipCompileRunner::failureClassified,
+            m_engine, [this](int testId, const QString &, const QStringList &packages) {
+                m_engine->setFailureHint(testId, packages);
+            });
+    connect(m_runner, &PipCompileRunner::workerCountChanged, this, [this](int count) {
+        if (!m_coordinator)
+        {
+            m_engine->setMaxParallelTests(count);
+        }
+    });
+    // After the runner, so the test being asked for is already running
+    connect(m_engine, &ResolverEngine::testRequested, this, &ResolveSession::fetchAhead);
+    connect(m_engine, &ResolverEngine::logMessage, this, &ResolveSession::logMessage);
+    connect(m_progress, &ResolveProgress::updated, this, [this](const ResolveProgress::Sample &sample) {
+        emit progressChanged(sample.percent);
+    });
+    connect(m_engine, &ResolverEngine::resolved,
+            this, [this](const QStringList &pins, const QString &outputPath) {
+                m_checkpoint->end(false);
+                m_progress->end();
+                emit progressChanged(100);
+                m_wheelhouse->cancel();
+                // Probes that passed are in the cache; only the winner is read
+                m_runner->discardOutputs(outputPath);
+                if (m_coordinator)
+                {
+                    m_coordinator->discardOutputs(outputPath);
+                }
+                if (!m_requirements.isEmpty())
+                {
+                    m_lock.save(m_options.environment, m_requirements, pins);
+                }
+                emit resolved(pins, outputPath);
+            });
+    connect(m_engine, &ResolverEngine::failed, this, [this](const QString &error) {
+        // Keep the checkpoint; the search continues once the venv or index is fixed
+        m_checkpoint->end(true);
+        m_progress->end();
+        m_wheelhouse->cancel();
+        m_runner->cancelAll();
+        if (m_coordinator)
+        {
+            m_coordinator->cancelAll();
+        }
+        emit failed(error);
+    });
+    connect(m_engine, &ResolverEngine::exhausted, this, [this]() {
+        m_checkpoint->end(false);
+        m_progress->end();
+        emit progressChanged(100);
+        m_runner->discardOutputs();
+        if (m_coordinator)
+        {
+            m_coordinator->discardOutputs();
+        }
+        if (m_narrowed)
+        {
+            // Learned conflicts are in the cache; the full search reuses them
+            emit logMessage(tr("Nothing compiles around the last lock; searching the full matrix"));
+            m_narrowed = false;
+            m_packages = m_fullPackages;
+            m_staticConflicts = m_fullStaticConflicts;
+            // Not from inside the engine's own exhausted() emission
+            m_widening = true;
+            QTimer::singleShot(0, this, [this]() {
+                if (m_widening)
+                {
+                    m_widening = false;
+                    launch();
+                }
+            });
+            return;
+        }
+        m_wheelhouse->cancel();
+        emit exhausted();
+    });
+    connect(m_runner, &PipCompileRunner::outputReceived,
+            this, [this](const QString &output, bool isError) {
+                // Only the last stderr line; the full text is in the on-disk log
+                const QStringList lines = output.trimmed().split('\n');
+                if (isError && !lines.isEmpty())
+                {
+                    emit logMessage(lines.last().trimmed());
+                }
+            });
+
+    connect(m_fetcher, &CandidateFetcher::logMessage, this, &ResolveSession::logMessage);
+    connect(m_fetcher, &CandidateFetcher::candidatesReady, this, &ResolveSession::onCandidatesReady);
+    connect(m_wheelhouse, &Wheelhouse::logMessage, this, &ResolveSession::logMessage);
+    connect(m_wheelhouse, &Wheelhouse::progressChanged, this, [this](int done, int total) {
+        emit progressChanged(total > 0 ? done * 100 / total : 0);
+    });
+    connect(m_wheelhouse, &Wheelhouse::prefetchFinished, this, &ResolveSession::onPrefetchFinished);
+}
+
+ResolveSession::~ResolveSession()
+{
+    // Keep an interrupted resolve resumable
+    if (m_engine->isRunning())
+    {
+        m_checkpoint->end(true);
+    }
+}
+
+void ResolveSession::setCacheDir(const QString &dir)
+{
+    m_cacheDir = dir;
+    QDir().mkpath(dir);
+    m_checkpoint->setPath(QDir(dir).filePath("checkpoint.cbor"));
+    m_lock.setPath(QDir(dir).filePath("locks.json"));
+    m_fetcher->setCacheDir(QDir(dir).filePath("http"));
+    m_fetcher->setMetadataDir(dir);
+}
+
+QString ResolveSession::cacheDir() const
+{
+    return m_cacheDir;
+}
+
+/****************************************************************
+ * @brief Starts candidate discovery; the search follows in
+ *        onCandidatesReady() and onPrefetchFinished().
+ ***************************************************************/
+bool ResolveSession::start(const QVector<Requirement> &requirements, const Options &options)
+{
+    if (isBusy())
+    {
+        return false;
+    }
+    m_options = options;
+    m_requirements = requirements;
+    m_narrowed = false;
+    prepareRunner();
+
+    // One resolve is one run in the Stats tab and the trace
+    Telemetry::reset();
+
+    m_fetcher->setMatrixRange(m_options.matrixRange);
+    m_fetcher->fetch(requirements);
+    return true;
+}
+
+/****************************************************************
+ * @brief Restores the engine from the checkpoint file. The search
+ *        picks up at the saved odometer position with every
+ *        learned conflict intact.
+ ***************************************************************/
+bool ResolveSession::resumeCheckpoint(const Options &options, QString *error)
+{
+    if (isBusy())
+    {
+        if (error)
+        {
+            *error = tr("Matrix resolution is already running");
+        }
+        return false;
+    }
+    QCborMap context;
+    QCborMap state;
+    QDateTime saved;
+    if (!m_checkpoint->load(&context, &state, &saved))
+    {
+        if (error)
+        {
+            *error = tr("Checkpoint %1 is unreadable").arg(m_checkpoint->path());
+        }
+        return false;
+    }
+    const QString baseVenv = context.value(QStringLiteral("baseVenv")).toString();
+    if (!VenvManager::isVenv(baseVenv))
+    {
+        if (error)
+        {
+            *error = tr("The checkpointed resolve used %1, which no longer exists.").arg(baseVenv);
+        }
+        return false;
+    }
+
+    m_options = options;
+    m_requirements.clear();
+    m_narrowed = false;
+    m_options.baseVenv = baseVenv;
+    m_options.environment = context.value(QStringLiteral("environment")).toString();
+    prepareRunner();
+    m_runner->setFindLinks(context.value(QStringLiteral("findLinks")).toString(),
+                           context.value(QStringLiteral("offline")).toBool());
+    if (m_coordinator)
+    {
+        m_coordinator->setFindLinks(m_runner->findLinks(), m_runner->isOffline());
+    }
+    if (m_options.useWheelhouse && !m_runner->findLinks().isEmpty())
+    {
+        m_wheelhouse->open(QFileInfo(m_runner->findLinks()).absolutePath());
+        m_wheelhouse->setSizeLimit(m_options.wheelhouseLimit);
+        m_wheelhouse->setRateLimit(m_options.prefetchRate);
+    }
+    if (!m_engine->restoreState(state))
+    {
+        if (error)
+        {
+            *error = tr("Checkpoint %1 does not match this version").arg(m_checkpoint->path());
+        }
+        return false;
+    }
+    emit searchStarted();
+    emit logMessage(tr("Resuming resolve checkpointed at %1").arg(saved.toString(Qt::ISODate)));
+    m_checkpoint->begin(context);
+    m_progress->begin();
+    m_engine->resume();
+    return true;
+}
+
+bool ResolveSession::hasCheckpoint(QDateTime *saved) const
+{
+    QCborMap context;
+    QCborMap state;
+    return m_checkpoint->load(&context, &state, saved);
+}
+
+bool ResolveSession::isBusy() const
+{
+    return m_engine->isRunning() || m_fetcher->isFetching() || m_wheelhouse->isPrefetching() || m_widening;
+}
+
+bool ResolveSession::isPaused() const
+{
+    return m_engine->isPaused();
+}
+
+/****************************************************************
+ * @brief Pauses the search; running tests complete.
+ ***************************************************************/
+void ResolveSession::pause()
+{
+    if (!m_engine->isRunning())
+    {
+        return;
+    }
+    emit logMessage(tr("Pausing..."));
+    m_engine->pause();
+    m_checkpoint->writeNow();
+}
+
+bool ResolveSession::resume()
+{
+    if (!m_engine->isPaused())
+    {
+        return false;
+    }
+    emit logMessage(tr("Resuming..."));
+    m_engine->resume();
+    return true;
+}
+
+void ResolveSession::stop()
+{
+    if (m_fetcher->isFetching())
+    {
+        m_fetcher->cancel();
+        emit logMessage(tr("Candidate discovery cancelled"));
+        emit stopped();
+        return;
+    }
+    if (m_wheelhouse->isPrefetching())
+    {
+        m_wheelhouse->cancel();
+        emit logMessage(tr("Wheel prefetch cancelled"));
+        emit stopped();
+        return;
+    }
+    if (m_widening)
+    {
+        m_widening = false;
+        m_wheelhouse->cancel();
+        emit stopped();
+        return;
+    }
+    if (!m_engine->isRunning())
+    {
+        return;
+    }
+    emit logMessage(tr("Stopping..."));
+    m_checkpoint->end(false);
+    m_progress->end();
+    m_engine->stop();
+    m_wheelhouse->cancel();
+    m_runner->cancelAll();
+    if (m_coordinator)
+    {
+        m_coordinator->cancelAll();
+    }
+    emit stopped();
+}
+
+ResolveSession::Options ResolveSession::options() const
+{
+    return m_options;
+}
+
+bool ResolveSession::parseRequirements(const QStringList &lines, QVector<Requirement> *requirements,
+                                       QString *error)
+{
+    requirements->clear();
+    const QStringList logical = Requirement::logicalLines(lines);
+    for (int i = 0; i < logical.size(); ++i)
+    {
+        const Requirement requirement = Requirement::parse(logical.at(i));
+        if (requirement.kind == Requirement::Kind::Invalid)
+        {
+            *error = tr("%1 (%2)").arg(requirement.line, requirement.error);
+            return false;
+        }
+        if (requirement.kind != Requirement::Kind::Blank && requirement.kind != Requirement::Kind::Comment)
+        {
+            requirements->append(requirement);
+        }
+    }
+    if (requirements->isEmpty())
+    {
+        *error = tr("No requirements to resolve");
+        return false;
+    }
+    return true;
+}
+
+bool ResolveSession::readRequirements(const QString &path, QVector<Requirement> *requirements,
+                                      QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        *error = tr("Cannot read %1: %2").arg(path, file.errorString());
+        return false;
+    }
+    const QStringList lines = QString::fromUtf8(file.readAll()).split('\n');
+    if (!parseRequirements(lines, requirements, error))
+    {
+        *error = QString("%1: %2").arg(path, *error);
+        return false;
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Same key the GUI builds from its Settings tab, so the
+ *        CLI and the GUI share cached results.
+ ***************************************************************/
+QString ResolveSession::hostEnvironment(const QString &baseVenv, const QString &pythonVersion,
+                                        bool useCpu, bool cuda)
+{
+    QString version = pythonVersion;
+    if (version.isEmpty())
+    {
+        SystemProbe::run(VenvManager::pythonPath(baseVenv),
+                         {"-c", "import sys; print('%d.%d' % sys.version_info[:2])"},
+                         10000,
+                         &version);
+    }
+    QString os, release, osVersion;
+    SystemProbe::detectOs(&os, &release, &osVersion);
+    return CompatibilityCache::environmentKey(version, os, release, useCpu, cuda);
+}
+
+/****************************************************************
+ * @brief Moves the engine's test traffic between the local runner
+ *        and a coordinator.
+ ***************************************************************/
+void ResolveSession::setCoordinator(ResolveCoordinator *coordinator)
+{
+    if (coordinator == m_coordinator)
+    {
+        return;
+    }
+    if (m_coordinator)
+    {
+        m_coordinator->disconnect(this);
+        m_coordinator->disconnect(m_engine);
+        disconnect(m_engine, &ResolverEngine::testRequested, m_coordinator, nullptr);
+    }
+    else
+    {
+        disconnect(m_engine, &ResolverEngine::testRequested, m_runner, &PipCompileRunner::runTest);
+        disconnect(m_runner, &PipCompileRunner::testFinished, m_engine, &ResolverEngine::reportTestResult);
+    }
+    m_coordinator = coordinator;
+    if (m_coordinator)
+    {
+        connect(m_engine, &ResolverEngine::testRequested, m_coordinator, &ResolveCoordinator::runTest);
+        connect(m_coordinator, &ResolveCoordinator::testFinished, m_engine, &ResolverEngine::reportTestResult);
+        connect(m_coordinator, &ResolveCoordinator::failureClassified,
+                m_engine, [this](int testId, const QString &, const QStringList &packages) {
+                    m_engine->setFailureHint(testId, packages);
+                });
+        connect(m_coordinator, &ResolveCoordinator::logMessage, this, &ResolveSession::logMessage);
+        connect(m_coordinator, &ResolveCoordinator::slotsChanged, this, [this](int count) {
+            m_engine->setMaxParallelTests(count);
+        });
+    }
+    else
+    {
+        connect(m_engine, &ResolverEngine::testRequested, m_runner, &PipCompileRunner::runTest);
+        connect(m_runner, &PipCompileRunner::testFinished, m_engine, &ResolverEngine::reportTestResult);
+        m_engine->setMaxParallelTests(m_runner->workerCount());
+    }
+}
+
+ResolveCoordinator *ResolveSession::coordinator()
+{
+    return m_coordinator;
+}
+
+ResolverEngine *ResolveSession::engine()
+{
+    return m_engine;
+}
+
+PipCompileRunner *ResolveSession::runner()
+{
+    return m_runner;
+}
+
+CandidateFetcher *ResolveSession::fetcher()
+{
+    return m_fetcher;
+}
+
+Wheelhouse *ResolveSession::wheelhouse()
+{
+    return m_wheelhouse;
+}
+
+CompatibilityCache *ResolveSession::cache()
+{
+    return m_cache;
+}
+
+ResolverCheckpoint *ResolveSession::checkpoint()
+{
+    return m_checkpoint;
+}
+
+ResolveProgress *ResolveSession::progress()
+{
+    return m_progress;
+}
+
+/****************************************************************
+ * @brief Points the runner, engine and cache at one environment;
+ *        shared by a new resolve and a checkpoint resume.
+ ***************************************************************/
+void ResolveSession::prepareRunner()
+{
+    m_runner->cancelAll();
+    m_runner->setBaseVenv(m_options.baseVenv);
+    m_runner->setWorkerCount(m_options.workers);
+    m_runner->setWorkDir(m_options.workDir);
+    m_engine->setMaxParallelTests(m_runner->workerCount());
+    if (m_coordinator)
+    {
+        m_coordinator->cancelAll();
+        m_coordinator->setEnvironment(m_options.environment);
+        m_coordinator->setWorkDir(m_options.workDir);
+        m_engine->setMaxParallelTests(m_coordinator->slotCount());
+    }
+
+    m_cache->open(m_cacheDir, m_options.environment);
+    m_engine->setCache(m_cache);
+    emit logMessage(tr("Compatibility cache: %1 known results for %2")
+                        .arg(m_cache->resultCount())
+                        .arg(m_options.environment));
+}
+
+/****************************************************************
+ * @brief Stores every candidate's wheels in the wheelhouse, then
+ *        starts the search (see onPrefetchFinished()); with
+ *        prefetchAhead the search starts now (see fetchAhead()).
+ ***************************************************************/
+void ResolveSession::onCandidatesReady(const QVector<PackageCandidates> &packages)
+{
+    m_packages = packages;
+    m_staticConflicts = m_fetcher->staticConflicts();
+    if (m_options.incremental)
+    {
+        narrowToLock();
+    }
+    if (!m_options.useWheelhouse)
+    {
+        m_runner->setFindLinks(QString(), false);
+        launch();
+        return;
+    }
+
+    m_wheelhouse->open(QDir(m_cacheDir).filePath("wheelhouse"));
+    m_wheelhouse->setSizeLimit(m_options.wheelhouseLimit);
+    if (m_options.prefetchAhead > 0)
+    {
+        // Online with the wheels stored so far; fetchAhead() adds more
+        m_wheelhouse->setRateLimit(m_options.prefetchRate);
+        m_runner->setFindLinks(m_wheelhouse->findLinks(), false);
+        launch();
+        return;
+    }
+
+    QStringList pins;
+    for (int i = 0; i < packages.size(); ++i)
+    {
+        for (int j = 0; j < packages.at(i).versions.size(); ++j)
+        {
+            const QString &version = packages.at(i).versions.at(j);
+            pins << (version.isEmpty() ? packages.at(i).name
+                                       : QString("%1==%2").arg(packages.at(i).name, version));
+        }
+    }
+    m_wheelhouse->prefetch(pins,
+                           m_options.environment,
+                           VenvManager::pythonPath(m_runner->baseVenv()),
+                           m_runner->workerCount());
+}
+
+void ResolveSession::onPrefetchFinished(bool complete)
+{
+    // Offline only when every candidate's wheels are stored. They
+    // hold each pin's own closure only, so the runner compiles a
+    // failed offline test again online before it reaches the cache.
+    m_runner->setFindLinks(m_wheelhouse->findLinks(), complete);
+    launch();
+}
+
+/****************************************************************
+ * @brief Keeps the columns the edit cannot have touched at their
+ *        locked versions. The full matrix is kept for exhausted().
+ ***************************************************************/
+void ResolveSession::narrowToLock()
+{
+    m_narrowed = false;
+    if (!m_lock.load(m_options.environment))
+    {
+        return;
+    }
+    bool unnamedChanged = false;
+    const QSet<QString> changed = m_lock.changedProjects(m_requirements, &unnamedChanged);
+    if (unnamedChanged)
+    {
+        emit logMessage(tr("A requirement without a project name changed; searching the full matrix"));
+        return;
+    }
+    const QSet<QString> affected = ResolveLock::affectedProjects(changed, m_fetcher->dependencies());
+    QVector<PackageCandidates> packages = m_packages;
+    QVector<ResolverSet> conflicts = m_staticConflicts;
+    const int narrowed = m_lock.narrow(&packages, &conflicts, affected);
+    emit logMessage(tr("Last lock: %1 requirements changed, %2 packages affected, %3 kept at their locked version")
+                        .arg(changed.size())
+                        .arg(affected.size())
+                        .arg(narrowed));
+    if (narrowed == 0)
+    {
+        return;
+    }
+    m_fullPackages = m_packages;
+    m_fullStaticConflicts = m_staticConflicts;
+    m_packages = packages;
+    m_staticConflicts = conflicts;
+    m_narrowed = true;
+}
+
+/****************************************************************
+ * @brief Pipelined prefetch: while the requested test compiles,
+ *        fetches the wheels of the combinations the engine will
+ *        try if it fails. Half the workers' slots at most, so the
+ *        compiles keep most of the CPU.
+ ***************************************************************/
+void ResolveSession::fetchAhead()
+{
+    if (!m_options.useWheelhouse || m_options.prefetchAhead <= 0 || m_runner->isOffline()
+        || m_runner->findLinks().isEmpty() || m_wheelhouse->isPrefetching())
+    {
+        return;
+    }
+    m_wheelhouse->prefetchAhead(m_engine->upcomingPins(m_options.prefetchAhead),
+                                m_options.environment,
+                                VenvManager::pythonPath(m_runner->baseVenv()),
+                                qMax(1, m_runner->workerCount() / 2));
+}
+
+/****************************************************************
+ * @brief Starts the engine once the candidates are known.
+ ***************************************************************/
+void ResolveSession::launch()
+{
+    emit logMessage(tr("Starting matrix resolution..."));
+    if (m_coordinator)
+    {
+        m_coordinator->setFindLinks(m_runner->findLinks(), m_runner->isOffline());
+    }
+    m_engine->setCandidates(m_packages);
+    m_engine->setStaticConflicts(m_staticConflicts);
+    emit searchStarted();
+    if (!m_engine->start())
+    {
+        emit failed(tr("No candidates to resolve"));
+        return;
+    }
+    if (!m_engine->isRunning())
+    {
+        return; // settled from the cache alone
+    }
+    // Everything needed to set the runner up again on resume
+    QCborMap context;
+    context.insert(QStringLiteral("environment"), m_options.environment);
+    context.insert(QStringLiteral("baseVenv"), m_runner->baseVenv());
+    context.insert(QStringLiteral("findLinks"), m_runner->findLinks());
+    context.insert(QStringLiteral("offline"), m_runner->isOffline());
+    m_checkpoint->begin(context);
+    m_progress->begin();
+}
+
+/************** End of ResolveSession.cpp ***********************/
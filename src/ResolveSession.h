@@ -0,0 +1,213 @@
+/****************************************************************
+ * @file ResolveSession.h
+ * @brief Declares ResolveSession, one resolve from requirements
+ *        to a working set.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines ResolveSession, the widget-free pipeline shared
+ * by the GUI and the headless pmr-cli:
+ *   CandidateFetcher -> Wheelhouse prefetch (optional)
+ *     -> ResolverEngine + PipCompileRunner + CompatibilityCache,
+ * with a ResolverCheckpoint so an interrupted search can continue
+ * and a ResolveProgress that reports its throughput and ETA.
+ * With Options::incremental the matrix is first narrowed to the
+ * last working lock (see ResolveLock) wherever the requirements
+ * did not change, and widened again if that finds nothing.
+ * With Options::prefetchAhead the prefetch is pipelined instead:
+ * the search starts at once and the wheelhouse fetches the pins
+ * of the next combinations while the current ones compile.
+ * The session owns all of them; the accessors are for wiring
+ * views and extra settings, not for driving the pipeline.
+ *
+ * A resolve ends with exactly one of resolved(), exhausted(),
+ * stopped() or failed().
+ *
+ * With setCoordinator() the tests go to remote workers instead of
+ * the local runner; candidate discovery, prefetch, the search and
+ * the cache stay here.
+ ***************************************************************/
+#ifndef RESOLVESESSION_H
+#define RESOLVESESSION_H
+
+#include <QObject>
+#include <QCborMap>
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "CandidateFetcher.h"
+#include "CompatibilityCache.h"
+#include "PipCompileRunner.h"
+#include "Requirement.h"
+#include "ResolveCoordinator.h"
+#include "ResolveLock.h"
+#include "ResolveProgress.h"
+#include "ResolverCheckpoint.h"
+#include "ResolverEngine.h"
+#include "Wheelhouse.h"
+
+/****************************************************************
+ * @class ResolveSession
+ * @brief Runs candidate discovery, prefetch and the search.
+ ***************************************************************/
+class ResolveSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************
+     * @struct Options
+     * @brief Per-resolve settings.
+     ***************************************************************/
+    struct Options
+    {
+        QString baseVenv;             ///< venv with pip-tools that workers clone
+        QString environment;          ///< CompatibilityCache::environmentKey()
+        QString workDir;              ///< per-test folders
+        int workers = 1;
+        int matrixRange = 2;
+        bool useWheelhouse = true;
+        qint64 wheelhouseLimit = 0;   ///< bytes, 0 for unlimited
+        int prefetchAhead = 3;        ///< combinations fetched ahead of the search, 0 to fetch all first
+        qint64 prefetchRate = 0;      ///< bytes per second for fetching ahead, 0 for unlimited
+        bool incremental = true;      ///< search only around the last lock where nothing changed
+    };
+
+    explicit ResolveSession(QObject *parent = nullptr);
+
+    /****************************************************************
+     * @brief Leaves the checkpoint of a running search for resume.
+     ***************************************************************/
+    ~ResolveSession();
+
+    /****************************************************************
+     * @brief Folder of the compatibility cache, HTTP cache,
+     *        wheelhouse and checkpoint; set before anything else.
+     ***************************************************************/
+    void setCacheDir(const QString &dir);
+    QString cacheDir() const;
+
+    /****************************************************************
+     * @brief Starts a resolve.
+     * @return false if one is already running.
+     ***************************************************************/
+    bool start(const QVector<Requirement> &requirements, const Options &options);
+
+    /****************************************************************
+     * @brief Continues the resolve saved in the checkpoint file.
+     * @param options Workers and folders; the venv, environment and
+     *        wheelhouse links are taken from the checkpoint.
+     * @return false with error set if it cannot be continued.
+     ***************************************************************/
+    bool resumeCheckpoint(const Options &options, QString *error = nullptr);
+
+    /****************************************************************
+     * @brief Reads the checkpoint file without resuming it.
+     ***************************************************************/
+    bool hasCheckpoint(QDateTime *saved = nullptr) const;
+
+    bool isBusy() const;
+    bool isPaused() const;
+    void pause();
+
+    /****************************************************************
+     * @brief Resumes a paused search.
+     * @return false if nothing was paused.
+     ***************************************************************/
+    bool resume();
+
+    /****************************************************************
+     * @brief Cancels discovery, prefetch or the search, whichever
+     *        is running, and emits stopped().
+     ***************************************************************/
+    void stop();
+
+    Options options() const;
+
+    /****************************************************************
+     * @brief Sends tests to remote workers instead of the local
+     *        runner; nullptr switches back. Call while idle.
+     * @param coordinator Not owned.
+     ***************************************************************/
+    void setCoordinator(ResolveCoordinator *coordinator);
+    ResolveCoordinator *coordinator();
+
+    /****************************************************************
+     * @brief Parses requirement lines, skipping blanks and comments.
+     * @return false with error set on the first invalid line.
+     ***************************************************************/
+    static bool parseRequirements(const QStringList &lines, QVector<Requirement> *requirements,
+                                  QString *error);
+    static bool readRequirements(const QString &path, QVector<Requirement> *requirements,
+                                 QString *error);
+
+    /****************************************************************
+     * @brief CompatibilityCache::environmentKey() of this machine.
+     * @param pythonVersion "3.11"; empty to ask the venv's python.
+     ***************************************************************/
+    static QString hostEnvironment(const QString &baseVenv, const QString &pythonVersion,
+                                   bool useCpu, bool cuda);
+
+    ResolverEngine *engine();
+    PipCompileRunner *runner();
+    CandidateFetcher *fetcher();
+    Wheelhouse *wheelhouse();
+    CompatibilityCache *cache();
+    ResolverCheckpoint *checkpoint();
+    ResolveProgress *progress();
+
+signals:
+    void logMessage(const QString &line);
+
+    /****************************************************************
+     * @brief Prefetch progress, then search progress, in percent.
+     *        The search part follows progress() samples.
+     ***************************************************************/
+    void progressChanged(int percent);
+
+    /****************************************************************
+     * @brief The engine has its candidate matrix (new or restored).
+     ***************************************************************/
+    void searchStarted();
+
+    void resolved(const QStringList &pins, const QString &outputPath);
+    void exhausted();
+    void stopped();
+    void failed(const QString &error);
+
+private slots:
+    void onCandidatesReady(const QVector<PackageCandidates> &packages);
+    void onPrefetchFinished(bool complete);
+    void fetchAhead();
+
+private:
+    void prepareRunner();
+    void narrowToLock();
+    void launch();
+
+    ResolverEngine *m_engine;
+    PipCompileRunner *m_runner;
+    CompatibilityCache *m_cache;
+    CandidateFetcher *m_fetcher;
+    Wheelhouse *m_wheelhouse;
+    ResolverCheckpoint *m_checkpoint;
+    ResolveProgress *m_progress;
+    ResolveCoordinator *m_coordinator = nullptr;
+    QString m_cacheDir;
+    Options m_options;
+    QVector<PackageCandidates> m_packages;
+    QVector<ResolverSet> m_staticConflicts; ///< pairs ruled out by requires_dist
+    QVector<Requirement> m_requirements;    ///< of the resolve; empty after a resume
+    ResolveLock m_lock;
+    bool m_narrowed = false;                ///< m_packages narrowed to the lock
+    bool m_widening = false;                ///< full search queued after a narrowed one
+    QVector<PackageCandidates> m_fullPackages;
+    QVector<ResolverSet> m_fullStaticConflicts;
+};
+
+#endif // RESOLVESESSION_H
+/************** End of ResolveSession.h *************************/
@@ -0,0 +1,224 @@
+/****************************************************************
+ * @file ResolveWorker.cpp
+ * @brief Implements the ResolveWorker class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of ResolveWorker, the
+ * worker side of the ResolveCoordinator protocol.
+ ***************************************************************/
+#include "ResolveWorker.h"
+#include "PipCompileRunner.h"
+#include "ResolveCoordinator.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <QUrl>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+ResolveWorker::ResolveWorker(QObject *parent)
+    : QObject(parent)
+    , m_runner(new PipCompileRunner(this))
+    , m_socket(new QTcpSocket(this))
+{
+    m_reconnect.setSingleShot(true);
+    m_reconnect.setInterval(kReconnectMs);
+    connect(&m_reconnect, &QTimer::timeout, this, [this]() {
+        m_socket->connectToHost(m_host, m_port);
+    });
+    connect(m_socket, &QTcpSocket::connected, this, &ResolveWorker::onConnected);
+    connect(m_socket, &QTcpSocket::disconnected, this, &ResolveWorker::onDisconnected);
+    connect(m_socket, &QTcpSocket::readyRead, this, &ResolveWorker::onReadyRead);
+    connect(m_socket, &QTcpSocket::errorOccurred, this, [this](QAbstractSocket::SocketError) {
+        // A refused or timed out connect never reaches disconnected()
+        if (m_socket->state() == QAbstractSocket::UnconnectedState && !m_rejected)
+        {
+            emit logMessage(tr("Coordinator %1:%2: %3").arg(m_host).arg(m_port).arg(m_socket->errorString()));
+            m_reconnect.start();
+        }
+    });
+    connect(m_runner, &PipCompileRunner::testLog,
+            this, [this](int testId, const QStringList &, bool, const QByteArray &output) {
+                m_logs.insert(testId, output.right(kMaxLogBytes));
+            });
+    connect(m_runner, &PipCompileRunner::failureClassified,
+            this, [this](int testId, const QString &kind, const QStringList &packages) {
+                m_failures.insert(testId, QJsonObject{{"failure", kind},
+                                                      {"blamed", QJsonArray::fromStringList(packages)}});
+            });
+    connect(m_runner, &PipCompileRunner::testFinished, this, &ResolveWorker::onTestFinished);
+}
+
+ResolveWorker::~ResolveWorker()
+{
+    m_socket->disconnect(this);
+    m_runner->cancelAll();
+}
+
+PipCompileRunner *ResolveWorker::runner()
+{
+    return m_runner;
+}
+
+void ResolveWorker::setEnvironment(const QString &environment)
+{
+    m_environment = environment;
+}
+
+void ResolveWorker::setToken(const QString &token)
+{
+    m_token = token;
+}
+
+void ResolveWorker::setName(const QString &name)
+{
+    m_name = name;
+}
+
+void ResolveWorker::connectTo(const QString &host, quint16 port)
+{
+    m_host = host;
+    m_port = port;
+    m_rejected = false;
+    m_socket->connectToHost(host, port);
+}
+
+bool ResolveWorker::isConnected() const
+{
+    return m_welcome;
+}
+
+/****************************************************************
+ * @brief The hello waits for the coordinator's challenge.
+ ***************************************************************/
+void ResolveWorker::onConnected()
+{
+    m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+}
+
+/****************************************************************
+ * @brief The coordinator requeues whatever was running here.
+ ***************************************************************/
+void ResolveWorker::onDisconnected()
+{
+    m_runner->cancelAll();
+    m_logs.clear();
+    m_failures.clear();
+    m_buffer.clear();
+    if (m_welcome)
+    {
+        emit logMessage(tr("Disconnected from %1:%2").arg(m_host).arg(m_port));
+    }
+    m_welcome = false;
+    if (!m_rejected)
+    {
+        m_reconnect.start();
+    }
+}
+
+void ResolveWorker::onReadyRead()
+{
+    m_buffer += m_socket->readAll();
+    qsizetype end = m_buffer.indexOf('\n');
+    while (end >= 0)
+    {
+        const QJsonDocument document = QJsonDocument::fromJson(m_buffer.left(end));
+        m_buffer.remove(0, end + 1);
+        if (document.isObject())
+        {
+            handle(document.object());
+        }
+        end = m_buffer.indexOf('\n');
+    }
+}
+
+void ResolveWorker::handle(const QJsonObject &message)
+{
+    const QString type = message.value("type").toString();
+    if (type == "challenge")
+    {
+        // Proves the token without sending it
+        send(QJsonObject{{"type", "hello"},
+                         {"proof", ResolveCoordinator::proof(m_token, message.value("nonce").toString())},
+                         {"environment", m_environment},
+                         {"slots", m_runner->workerCount()},
+                         {"name", m_name}});
+    }
+    else if (type == "welcome")
+    {
+        m_welcome = true;
+        emit logMessage(tr("Connected to %1:%2 with %3 slots")
+                            .arg(m_host).arg(m_port).arg(m_runner->workerCount()));
+    }
+    else if (type == "reject")
+    {
+        m_rejected = true;
+        emit logMessage(tr("Rejected by %1:%2: %3").arg(m_host).arg(m_port).arg(message.value("error").toString()));
+        emit rejected(message.value("error").toString());
+        m_socket->disconnectFromHost();
+    }
+    else if (type == "cancel")
+    {
+        m_runner->cancelAll();
+        m_logs.clear();
+        m_failures.clear();
+    }
+    else if (type == "test" && m_welcome)
+    {
+        // A shared wheelhouse (same path on every node) is used as is
+        const QString findLinks = message.value("findLinks").toString();
+        const QString localPath = QUrl(findLinks).isLocalFile() ? QUrl(findLinks).toLocalFile() : findLinks;
+        const bool usable = !findLinks.isEmpty() && QFileInfo::exists(localPath);
+        m_runner->setFindLinks(usable ? findLinks : QString(),
+                               usable && message.value("offline").toBool());
+        QStringList pins;
+        const QJsonArray array = message.value("pins").toArray();
+        for (int i = 0; i < array.size(); ++i)
+        {
+            pins << array.at(i).toString();
+        }
+        m_runner->runTest(message.value("id").toInt(), pins);
+    }
+}
+
+void ResolveWorker::onTestFinished(int testId, TestOutcome outcome, const QString &outputPath)
+{
+    const bool passed = outcome == TestOutcome::Passed;
+    QByteArray compiled;
+    if (passed)
+    {
+        QFile file(outputPath);
+        if (file.open(QIODevice::ReadOnly))
+        {
+            compiled = file.readAll();
+        }
+    }
+    QJsonObject result = m_failures.take(testId);
+    result.insert("type", "result");
+    result.insert("id", testId);
+    result.insert("passed", passed);
+    result.insert("outcome", testOutcomeName(outcome));
+    result.insert("compiled", QString::fromUtf8(compiled));
+    result.insert("log", QString::fromUtf8(m_logs.take(testId)));
+    send(result);
+    // The coordinator keeps the compiled file now
+    m_runner->discardOutputs();
+}
+
+void ResolveWorker::send(const QJsonObject &message)
+{
+    if (m_socket->state() == QAbstractSocket::ConnectedState)
+    {
+        m_socket->write(ResolveCoordinator::encode(message));
+    }
+}
+
+/************** End of ResolveWorker.cpp ************************/
@@ -0,0 +1,99 @@
+/****************************************************************
+ * @file ResolveWorker.h
+ * @brief Declares ResolveWorker, a remote compile node of a
+ *        ResolveCoordinator.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines ResolveWorker. It connects to a coordinator,
+ * answers its challenge with the token's proof, announces its
+ * environment key and slot count, and runs every
+ * test it is sent on its own PipCompileRunner pool. The compiled
+ * file, the pip-compile stderr and any FailureClassifier verdict
+ * go back with the result. A lost
+ * connection cancels the running tests (the coordinator sends them
+ * elsewhere) and is retried every few seconds.
+ ***************************************************************/
+#ifndef RESOLVEWORKER_H
+#define RESOLVEWORKER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QStringList>
+#include <QString>
+#include <QTimer>
+#include "TestOutcome.h"
+
+class PipCompileRunner;
+class QTcpSocket;
+
+/****************************************************************
+ * @class ResolveWorker
+ * @brief Compiles pin sets for a remote coordinator.
+ ***************************************************************/
+class ResolveWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ResolveWorker(QObject *parent = nullptr);
+    ~ResolveWorker();
+
+    /****************************************************************
+     * @brief Local pool; set its venv, worker count and work dir
+     *        before connectTo().
+     ***************************************************************/
+    PipCompileRunner *runner();
+
+    void setEnvironment(const QString &environment);
+    void setToken(const QString &token);
+    void setName(const QString &name);
+
+    /****************************************************************
+     * @brief Connects now and again after every disconnect.
+     ***************************************************************/
+    void connectTo(const QString &host, quint16 port);
+    bool isConnected() const;
+
+    static const int kReconnectMs = 5000;
+    static const int kMaxLogBytes = 64 * 1024;
+
+signals:
+    void logMessage(const QString &line);
+
+    /****************************************************************
+     * @brief The coordinator refused this worker (wrong token or
+     *        environment); no reconnect follows.
+     ***************************************************************/
+    void rejected(const QString &error);
+
+private:
+    void onConnected();
+    void onDisconnected();
+    void onReadyRead();
+    void handle(const QJsonObject &message);
+    void onTestFinished(int testId, TestOutcome outcome, const QString &outputPath);
+    void send(const QJsonObject &message);
+
+    PipCompileRunner *m_runner;
+    QTcpSocket *m_socket;
+    QTimer m_reconnect;
+    QByteArray m_buffer;
+    QHash<int, QByteArray> m_logs;   ///< stderr of finished tests until reported
+    QHash<int, QJsonObject> m_failures; ///< classified failures until reported
+    QString m_host;
+    quint16 m_port = 0;
+    QString m_environment;
+    QString m_token;
+    QString m_name;
+    bool m_welcome = false;
+    bool m_rejected = false;
+};
+
+#endif // RESOLVEWORKER_H
+/************** End of ResolveWorker.h **************************/
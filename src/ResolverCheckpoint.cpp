@@ -0,0 +1,155 @@
+/****************************************************************
+ * @file ResolverCheckpoint.cpp
+ * @brief Implements the ResolverCheckpoint class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of ResolverCheckpoint.
+ * File layout (CBOR map):
+ *   format   checkpoint format version
+ *   saved    ms since epoch of the snapshot
+ *   context  map given to begin()
+ *   state    ResolverEngine::saveState()
+ ***************************************************************/
+#include "ResolverCheckpoint.h"
+#include "ResolverEngine.h"
+#include <QCborValue>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const int kCheckpointFormat = 1;
+static const int kDefaultIntervalMs = 5000;
+
+/****************************************************************
+ * @brief Constructor: Attaches to an engine; writes nothing yet.
+ ***************************************************************/
+ResolverCheckpoint::ResolverCheckpoint(ResolverEngine *engine, QObject *parent)
+    : QObject(parent)
+    , m_engine(engine)
+{
+    m_timer.setInterval(kDefaultIntervalMs);
+    connect(&m_timer, &QTimer::timeout, this, [this]() { writeNow(); });
+}
+
+void ResolverCheckpoint::setPath(const QString &path)
+{
+    m_path = path;
+}
+
+QString ResolverCheckpoint::path() const
+{
+    return m_path;
+}
+
+void ResolverCheckpoint::setInterval(int intervalMs)
+{
+    m_timer.setInterval(qMax(500, intervalMs));
+}
+
+/****************************************************************
+ * @brief Starts periodic writes for the current resolve.
+ ***************************************************************/
+void ResolverCheckpoint::begin(const QCborMap &context)
+{
+    m_context = context;
+    m_written = false;
+    m_timer.start();
+}
+
+/****************************************************************
+ * @brief Stops periodic writes; optionally deletes the file.
+ ***************************************************************/
+void ResolverCheckpoint::end(bool keepFile)
+{
+    if (keepFile && m_timer.isActive())
+    {
+        writeNow();
+    }
+    m_timer.stop();
+    if (!keepFile && !m_path.isEmpty())
+    {
+        QFile::remove(m_path);
+    }
+}
+
+/****************************************************************
+ * @brief Writes the engine state now if it changed.
+ ***************************************************************/
+bool ResolverCheckpoint::writeNow()
+{
+    if (m_path.isEmpty() || !m_engine->isRunning())
+    {
+        return true;
+    }
+    if (m_written && m_engine->stateRevision() == m_savedRevision)
+    {
+        return true;
+    }
+
+    QCborMap root;
+    root.insert(QStringLiteral("format"), kCheckpointFormat);
+    root.insert(QStringLiteral("saved"), QDateTime::currentMSecsSinceEpoch());
+    root.insert(QStringLiteral("context"), m_context);
+    root.insert(QStringLiteral("state"), m_engine->saveState());
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "Cannot write checkpoint" << m_path;
+        return false;
+    }
+    file.write(QCborValue(root).toCbor());
+    if (!file.commit())
+    {
+        qWarning() << "Cannot commit checkpoint" << m_path;
+        return false;
+    }
+    m_savedRevision = m_engine->stateRevision();
+    m_written = true;
+    DEBUG_MSG() << "Checkpoint written, revision" << m_savedRevision;
+    return true;
+}
+
+bool ResolverCheckpoint::exists() const
+{
+    return !m_path.isEmpty() && QFileInfo::exists(m_path);
+}
+
+/****************************************************************
+ * @brief Reads the checkpoint file.
+ ***************************************************************/
+bool ResolverCheckpoint::load(QCborMap *context, QCborMap *state, QDateTime *saved) const
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    QCborParserError error;
+    const QCborMap root = QCborValue::fromCbor(file.readAll(), &error).toMap();
+    if (error.error != QCborError::NoError
+        || root.value(QStringLiteral("format")).toInteger() != kCheckpointFormat)
+    {
+        qWarning() << "Ignoring unreadable checkpoint" << m_path;
+        return false;
+    }
+    *context = root.value(QStringLiteral("context")).toMap();
+    *state = root.value(QStringLiteral("state")).toMap();
+    if (saved)
+    {
+        *saved = QDateTime::fromMSecsSinceEpoch(root.value(QStringLiteral("saved")).toInteger());
+    }
+    return !state->isEmpty();
+}
+
+/************** End of ResolverCheckpoint.cpp *******************/
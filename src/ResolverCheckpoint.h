@@ -0,0 +1,92 @@
+/****************************************************************
+ * @file ResolverCheckpoint.h
+ * @brief Declares the ResolverCheckpoint class for resumable resolves.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the ResolverCheckpoint class. While a resolve
+ * runs it writes ResolverEngine::saveState() to a CBOR file every
+ * few seconds (only if the state changed), atomically through
+ * QSaveFile, so a crash, reboot or preemption loses at most one
+ * interval of work. A caller-supplied context map (environment,
+ * venv, wheelhouse settings) is stored alongside so the runner
+ * can be set up the same way before the engine is restored.
+ ***************************************************************/
+#ifndef RESOLVERCHECKPOINT_H
+#define RESOLVERCHECKPOINT_H
+
+#include <QObject>
+#include <QString>
+#include <QDateTime>
+#include <QCborMap>
+#include <QTimer>
+
+class ResolverEngine;
+
+/****************************************************************
+ * @class ResolverCheckpoint
+ * @brief Periodic, atomic snapshots of a ResolverEngine.
+ ***************************************************************/
+class ResolverCheckpoint : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ResolverCheckpoint(ResolverEngine *engine, QObject *parent = nullptr);
+
+    /****************************************************************
+     * @brief Sets the checkpoint file.
+     ***************************************************************/
+    void setPath(const QString &path);
+    QString path() const;
+
+    /****************************************************************
+     * @brief Sets how often a changed state is written.
+     * @param intervalMs Milliseconds (minimum 500).
+     ***************************************************************/
+    void setInterval(int intervalMs);
+
+    /****************************************************************
+     * @brief Starts periodic writes for the current resolve.
+     * @param context Stored with every snapshot, see load().
+     ***************************************************************/
+    void begin(const QCborMap &context);
+
+    /****************************************************************
+     * @brief Stops periodic writes.
+     * @param keepFile true leaves the last snapshot for a later
+     *        resume (e.g. on exit); false deletes it.
+     ***************************************************************/
+    void end(bool keepFile);
+
+    /****************************************************************
+     * @brief Writes the engine state now if it changed.
+     * @return true on success or if nothing changed.
+     ***************************************************************/
+    bool writeNow();
+
+    bool exists() const;
+
+    /****************************************************************
+     * @brief Reads the checkpoint file.
+     * @param context Receives the map given to begin().
+     * @param state Receives the map for ResolverEngine::restoreState().
+     * @param saved Receives the time of the snapshot (optional).
+     * @return false if missing or unreadable.
+     ***************************************************************/
+    bool load(QCborMap *context, QCborMap *state, QDateTime *saved = nullptr) const;
+
+private:
+    ResolverEngine *m_engine;
+    QString m_path;
+    QCborMap m_context;
+    QTimer m_timer;
+    quint64 m_savedRevision = 0;
+    bool m_written = false;
+};
+
+#endif // RESOLVERCHECKPOINT_H
+/************** End of ResolverCheckpoint.h *********************/
@@ -0,0 +1,1300 @@
+/****************************************************************
+ * @file ResolverEngine.cpp
+ * @brief Implements the ResolverEngine class for matrix resolution.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of ResolverEngine class.
+ *
+ * Search outline:
+ *   1. Move to the next combination (odometer order) that does
+ *      not contain a learned conflict, counting what is skipped.
+ *   2. Compile it. On success we are done.
+ *   3. On failure, bisect prefixes of the failing combination to
+ *      find a minimal failing subset, learn it, and go to 1. When
+ *      pip named the packages at fault (see FailureClassifier),
+ *      those pins are compiled alone first and, if they fail, the
+ *      bisection runs over them instead of the whole combination.
+ * Every pip-compile is either the answer or buys a new conflict,
+ * and each conflict removes all combinations that contain it.
+ ***************************************************************/
+#include "ResolverEngine.h"
+#include "CompatibilityCache.h"
+#include "Requirement.h"
+#include "Telemetry.h"
+#include <QCborValue>
+#include <algorithm>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const int kStateFormat = 1;
+static const int kLookAheadSteps = 4096; ///< odometer steps per upcomingPins() call
+
+/****************************************************************
+ * @brief Constructor: Initializes an idle engine.
+ ***************************************************************/
+ResolverEngine::ResolverEngine(QObject *parent) : QObject(parent)
+{
+}
+
+/****************************************************************
+ * @brief Replaces the candidate matrix and resets all state.
+ ***************************************************************/
+void ResolverEngine::setCandidates(const QVector<PackageCandidates> &packages)
+{
+    stop();
+    m_packages = packages;
+    m_current.fill(0, m_packages.size());
+    m_conflicts.clear();
+    m_conflictIndex.clear();
+    m_staticConflicts.clear();
+    m_hints.clear();
+    m_passing.clear();
+    m_results.clear();
+    m_outputs.clear();
+    m_testsLaunched = 0;
+    m_pruned = 0.0;
+}
+
+/****************************************************************
+ * @brief Gets the candidate matrix.
+ ***************************************************************/
+const QVector<PackageCandidates> &ResolverEngine::candidates() const
+{
+    return m_packages;
+}
+
+/****************************************************************
+ * @brief Starts a new search from the first combination.
+ ***************************************************************/
+bool ResolverEngine::start()
+{
+    if (m_packages.isEmpty())
+    {
+        return false;
+    }
+    for (int i = 0; i < m_packages.size(); ++i)
+    {
+        if (m_packages.at(i).versions.isEmpty())
+        {
+            emit logMessage(tr("Package %1 has no candidates").arg(m_packages.at(i).name));
+            return false;
+        }
+    }
+
+    m_current.fill(0, m_packages.size());
+    m_paused = false;
+    m_inFlight.clear();
+    m_inFlightKeys.clear();
+    m_errors.clear();
+    m_resumeSets.clear();
+    m_pruned = 0.0;
+    m_cacheHits = 0;
+    ++m_revision;
+    m_phase = Phase::Searching;
+    seedStaticConflicts();
+    seedConflictsFromCache();
+
+    emit logMessage(tr("Resolving %1 packages, %2 combinations, %3 parallel tests")
+                        .arg(m_packages.size())
+                        .arg(totalCombinations(), 0, 'g', 6)
+                        .arg(m_maxParallel));
+    pump();
+    return true;
+}
+
+/****************************************************************
+ * @brief Stops dispatching tests; in-flight results are kept.
+ ***************************************************************/
+void ResolverEngine::pause()
+{
+    if (isRunning())
+    {
+        m_paused = true;
+    }
+}
+
+/****************************************************************
+ * @brief Continues a paused search from where it stopped.
+ ***************************************************************/
+void ResolverEngine::resume()
+{
+    if (!m_paused)
+    {
+        return;
+    }
+    m_paused = false;
+    pump();
+
+    // Sets that were compiling when the snapshot was taken get
+    // whatever slots the state machine left free.
+    const QVector<ResolverSet> pending = m_resumeSets;
+    m_resumeSets.clear();
+    for (int i = 0; i < pending.size() && freeSlots() > 0 && isRunning(); ++i)
+    {
+        if (lookup(pending.at(i)) == Outcome::Unknown && request(pending.at(i)))
+        {
+            Telemetry::add(Telemetry::Counter::Retries);
+        }
+    }
+    if (m_repump)
+    {
+        pump();
+    }
+}
+
+/****************************************************************
+ * @brief Aborts the search. Outstanding results are ignored.
+ ***************************************************************/
+void ResolverEngine::stop()
+{
+    m_phase = Phase::Idle;
+    m_paused = false;
+    m_inFlight.clear();
+    m_inFlightKeys.clear();
+    m_resumeSets.clear();
+    ++m_revision;
+}
+
+bool ResolverEngine::isRunning() const
+{
+    return m_phase == Phase::Searching || m_phase == Phase::Diagnosing;
+}
+
+bool ResolverEngine::isPaused() const
+{
+    return m_paused;
+}
+
+void ResolverEngine::setMaxParallelTests(int count)
+{
+    m_maxParallel = qMax(1, count);
+    pump();
+}
+
+int ResolverEngine::maxParallelTests() const
+{
+    return m_maxParallel;
+}
+
+int ResolverEngine::testsInFlight() const
+{
+    return m_inFlight.size();
+}
+
+int ResolverEngine::testsLaunched() const
+{
+    return m_testsLaunched;
+}
+
+double ResolverEngine::combinationsPruned() const
+{
+    return m_pruned;
+}
+
+double ResolverEngine::totalCombinations() const
+{
+    return m_packages.isEmpty() ? 0.0 : tailProduct(0);
+}
+
+double ResolverEngine::searchPosition() const
+{
+    double position = 0.0;
+    for (int i = 0; i < m_current.size(); ++i)
+    {
+        position += m_current.at(i) * tailProduct(i + 1);
+    }
+    return position;
+}
+
+const QVector<ResolverSet> &ResolverEngine::conflicts() const
+{
+    return m_conflicts;
+}
+
+void ResolverEngine::setStaticConflicts(const QVector<ResolverSet> &conflicts)
+{
+    m_staticConflicts = conflicts;
+}
+
+/****************************************************************
+ * @brief Keeps the pins of a running test that pip blamed.
+ ***************************************************************/
+void ResolverEngine::setFailureHint(int testId, const QStringList &projects)
+{
+    const auto it = m_inFlight.constFind(testId);
+    if (it == m_inFlight.constEnd() || projects.isEmpty())
+    {
+        return;
+    }
+    const ResolverSet &set = it.value();
+    ResolverSet suspects;
+    for (int i = 0; i < set.size(); ++i)
+    {
+        const QString project = Requirement::parse(m_packages.at(set.at(i).package).name).project;
+        if (!project.isEmpty() && projects.contains(project))
+        {
+            suspects.append(set.at(i));
+        }
+    }
+    if (!suspects.isEmpty() && suspects.size() < set.size())
+    {
+        m_hints.insert(setKey(set), suspects);
+    }
+}
+
+void ResolverEngine::setCache(CompatibilityCache *cache)
+{
+    m_cache = cache;
+}
+
+int ResolverEngine::cacheHits() const
+{
+    return m_cacheHits;
+}
+
+/****************************************************************
+ * @brief Builds the pip requirement lines for a set of choices.
+ ***************************************************************/
+QStringList ResolverEngine::pinsFor(const ResolverSet &set) const
+{
+    QStringList pins;
+    for (int i = 0; i < set.size(); ++i)
+    {
+        const PackageCandidates &pkg = m_packages.at(set.at(i).package);
+        const QString &version = pkg.versions.at(set.at(i).version);
+        QString pin = version.isEmpty() ? pkg.name : QString("%1==%2").arg(pkg.name, version);
+        if (!pkg.marker.isEmpty())
+        {
+            pin += "; " + pkg.marker;
+        }
+        pins << pin;
+    }
+    return pins;
+}
+
+/****************************************************************
+ * @brief Walks a copy of the odometer past the combination being
+ *        tested. Combinations that known results or the cache
+ *        already decide need no compile and are not counted.
+ ***************************************************************/
+QStringList ResolverEngine::upcomingPins(int combinations) const
+{
+    QStringList pins;
+    if (!isRunning() || m_current.isEmpty())
+    {
+        return pins;
+    }
+    const QStringList testing = pinsFor(currentSet());
+    const int n = m_packages.size();
+    QVector<int> current = m_current;
+    int found = 0;
+    // Bounded, since a warm cache may decide long runs of combinations
+    for (int step = 0; found < combinations && step < kLookAheadSteps; ++step)
+    {
+        int depth = incrementAt(current, n - 1);
+        if (depth >= 0)
+        {
+            depth = 0;
+        }
+        while (depth >= 0 && depth < n)
+        {
+            depth = violatesConflict(current, depth) ? incrementAt(current, depth) : depth + 1;
+        }
+        if (depth < 0)
+        {
+            break; // wrapped: nothing left to search
+        }
+
+        ResolverSet set;
+        set.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            set.append({i, current.at(i)});
+        }
+        bool passed = false;
+        if (lookup(set) != Outcome::Unknown || (m_cache && m_cache->lookup(setKey(set), &passed)))
+        {
+            continue;
+        }
+        ++found;
+        const QStringList next = pinsFor(set);
+        for (int i = 0; i < next.size(); ++i)
+        {
+            if (!testing.contains(next.at(i)) && !pins.contains(next.at(i)))
+            {
+                pins << next.at(i);
+            }
+        }
+    }
+    return pins;
+}
+
+/****************************************************************
+ * @brief Classifies one full combination from memoized results,
+ *        tests in flight and learned conflicts.
+ ***************************************************************/
+ResolverEngine::CombinationState ResolverEngine::combinationState(const QVector<int> &versions) const
+{
+    ResolverSet set;
+    set.reserve(versions.size());
+    for (int i = 0; i < versions.size(); ++i)
+    {
+        set.append({i, versions.at(i)});
+    }
+    const QString key = setKey(set);
+    if (m_inFlightKeys.contains(key))
+    {
+        return CombinationState::Testing;
+    }
+    const auto exact = m_results.constFind(key);
+    if (exact != m_results.constEnd())
+    {
+        return exact.value() ? CombinationState::Passed : CombinationState::Failed;
+    }
+    for (int i = 0; i < set.size(); ++i)
+    {
+        const auto it = m_conflictIndex.constFind(choiceKey(i, versions.at(i)));
+        if (it == m_conflictIndex.constEnd())
+        {
+            continue;
+        }
+        const QVector<int> &ids = it.value();
+        for (int j = 0; j < ids.size(); ++j)
+        {
+            if (isSubset(m_conflicts.at(ids.at(j)), set))
+            {
+                return CombinationState::Pruned;
+            }
+        }
+    }
+    return CombinationState::Pending;
+}
+
+/****************************************************************
+ * @brief Receives the outcome of a test issued by testRequested().
+ ***************************************************************/
+void ResolverEngine::reportTestResult(int testId, TestOutcome outcome, const QString &outputPath)
+{
+    const auto it = m_inFlight.constFind(testId);
+    if (it == m_inFlight.constEnd())
+    {
+        DEBUG_MSG() << "Ignoring stale test result" << testId;
+        return;
+    }
+
+    const ResolverSet set = it.value();
+    const QString key = setKey(set);
+    m_inFlight.remove(testId);
+    m_inFlightKeys.remove(key);
+    ++m_revision;
+
+    if (outcome == TestOutcome::Error)
+    {
+        // No verdict on the pins: nothing is learned, pump() asks again
+        const int errors = ++m_errors[key];
+        if (errors >= kMaxTestErrors)
+        {
+            stop();
+            emit failed(tr("Could not test %1 (%2 attempts without a result from pip); see the log")
+                            .arg(pinsFor(set).join(", "))
+                            .arg(errors));
+            return;
+        }
+        emit logMessage(tr("Test of %1 got no result from pip; trying again").arg(pinsFor(set).join(", ")));
+        pump();
+        return;
+    }
+    const bool passed = outcome == TestOutcome::Passed;
+    m_errors.remove(key);
+    if (m_cache)
+    {
+        m_cache->record(key, passed, outputPath);
+    }
+    storeResult(set, key, passed, outputPath);
+    pump();
+}
+
+/****************************************************************
+ * @brief Memoizes the outcome of a set.
+ ***************************************************************/
+void ResolverEngine::storeResult(const ResolverSet &set, const QString &key, bool passed,
+                                 const QString &outputPath)
+{
+    m_results.insert(key, passed);
+    if (passed)
+    {
+        m_passing.append(set);
+        m_outputs.insert(key, outputPath);
+    }
+}
+
+/****************************************************************
+ * @brief Drives the state machine until it needs more results.
+ ***************************************************************/
+void ResolverEngine::pump()
+{
+    if (m_pumping)
+    {
+        // A synchronous reportTestResult() from inside request();
+        // the outer loop below picks the new state up.
+        m_repump = true;
+        return;
+    }
+    m_pumping = true;
+    do
+    {
+        m_repump = false;
+        while (!m_paused && isRunning())
+        {
+            const bool progressed = m_phase == Phase::Searching ? searchStep() : diagnoseStep();
+            if (!progressed)
+            {
+                break;
+            }
+        }
+    } while (m_repump && !m_paused && isRunning());
+    m_pumping = false;
+}
+
+/****************************************************************
+ * @brief Tests the next combination free of learned conflicts.
+ * @return true if the phase changed and the caller should loop.
+ ***************************************************************/
+bool ResolverEngine::searchStep()
+{
+    if (!advanceToConsistent())
+    {
+        m_phase = Phase::Finished;
+        emit progressChanged(100);
+        emit logMessage(tr("All combinations ruled out after %1 tests, %2 from cache (%3 pruned)")
+                            .arg(m_testsLaunched)
+                            .arg(m_cacheHits)
+                            .arg(m_pruned, 0, 'g', 6));
+        emit exhausted();
+        return false;
+    }
+    emitProgress();
+
+    const ResolverSet set = currentSet();
+    const Outcome outcome = lookup(set);
+    if (outcome == Outcome::Pass)
+    {
+        m_phase = Phase::Finished;
+        emit progressChanged(100);
+        emit logMessage(tr("Resolved after %1 tests, %2 from cache (%3 combinations pruned)")
+                            .arg(m_testsLaunched)
+                            .arg(m_cacheHits)
+                            .arg(m_pruned, 0, 'g', 6));
+        emit resolved(pinsFor(set), m_outputs.value(setKey(set)));
+        return false;
+    }
+    if (outcome == Outcome::Fail)
+    {
+        beginDiagnosis(set);
+        return true;
+    }
+
+    request(set);
+    // Idle workers start bisecting in case the full set fails.
+    requestBisection(ResolverSet(), set, 0, set.size());
+    return false;
+}
+
+/****************************************************************
+ * @brief Starts shrinking a failing combination.
+ ***************************************************************/
+void ResolverEngine::beginDiagnosis(const ResolverSet &failing)
+{
+    m_diag = Diagnosis();
+    m_diag.failing = failing;
+    m_diag.limit = failing.size();
+    m_diag.hint = m_hints.value(setKey(failing));
+    m_hints.clear(); // only the combination being diagnosed matters
+    m_phase = Phase::Diagnosing;
+    if (!m_diag.hint.isEmpty())
+    {
+        emit logMessage(tr("pip blamed %1; checking those pins alone").arg(pinsFor(m_diag.hint).join(", ")));
+    }
+}
+
+/****************************************************************
+ * @brief Advances the diagnosis as far as known results allow.
+ * @return true if a conflict was learned and the caller should loop.
+ ***************************************************************/
+bool ResolverEngine::diagnoseStep()
+{
+    Diagnosis &d = m_diag;
+    if (!d.hint.isEmpty())
+    {
+        const Outcome outcome = lookup(d.hint);
+        if (outcome == Outcome::Unknown)
+        {
+            request(d.hint);
+            // Idle workers bisect the whole set in case pip was wrong
+            requestBisection(d.core, d.failing, 0, d.limit);
+            return false;
+        }
+        if (outcome == Outcome::Fail)
+        {
+            d.failing = d.hint;
+            d.limit = d.hint.size();
+        }
+        d.hint.clear();
+    }
+    while (true)
+    {
+        if (!d.coreChecked)
+        {
+            if (!d.core.isEmpty())
+            {
+                const Outcome outcome = lookup(d.core);
+                if (outcome == Outcome::Unknown)
+                {
+                    request(d.core);
+                    requestBisection(d.core, d.failing, 0, d.limit);
+                    return false;
+                }
+                if (outcome == Outcome::Fail)
+                {
+                    learnConflict(d.core);
+                    return true;
+                }
+            }
+            d.coreChecked = true;
+            d.lo = 0;
+            d.hi = d.limit;
+            if (d.limit == 0)
+            {
+                // core passes alone yet core + nothing "failed":
+                // results are inconsistent (flaky index?), keep it safe.
+                learnConflict(d.failing);
+                return true;
+            }
+            continue;
+        }
+
+        // Tighten [lo, hi] with every probe result already known.
+        for (int p = d.lo + 1; p < d.hi; ++p)
+        {
+            const Outcome outcome = lookup(unite(d.core, d.failing.mid(0, p)));
+            if (outcome == Outcome::Pass)
+            {
+                d.lo = p;
+            }
+            else if (outcome == Outcome::Fail)
+            {
+                d.hi = p;
+                break;
+            }
+        }
+
+        if (d.hi - d.lo > 1)
+        {
+            requestBisection(d.core, d.failing, d.lo, d.hi);
+            return false;
+        }
+
+        // failing[hi - 1] is required for the failure given core.
+        d.core = unite(d.core, ResolverSet{d.failing.at(d.hi - 1)});
+        d.limit = d.hi - 1;
+        d.coreChecked = false;
+    }
+}
+
+/****************************************************************
+ * @brief Spreads bisection probes over the free slots.
+ ***************************************************************/
+void ResolverEngine::requestBisection(const ResolverSet &core, const ResolverSet &failing,
+                                      int lo, int hi)
+{
+    const int inner = hi - lo - 1;
+    if (inner <= 0)
+    {
+        return;
+    }
+    // The midpoint always goes first so one worker still bisects.
+    const int count = qMin(inner, qMax(1, freeSlots()));
+    for (int i = 1; i <= count; ++i)
+    {
+        const int p = lo + (i * (hi - lo)) / (count + 1);
+        if (p <= lo || p >= hi)
+        {
+            continue;
+        }
+        const ResolverSet probe = unite(core, failing.mid(0, p));
+        if (lookup(probe) == Outcome::Unknown)
+        {
+            request(probe);
+        }
+    }
+}
+
+/****************************************************************
+ * @brief Records a minimal failing set and resumes searching.
+ ***************************************************************/
+void ResolverEngine::learnConflict(const ResolverSet &conflict)
+{
+    m_phase = Phase::Searching;
+    if (conflict.isEmpty())
+    {
+        return;
+    }
+    m_results.insert(setKey(conflict), false);
+    if (!insertConflict(conflict))
+    {
+        return;
+    }
+    if (m_cache)
+    {
+        m_cache->recordConflict(pinsFor(conflict));
+    }
+    emit logMessage(tr("Conflict learned: %1").arg(pinsFor(conflict).join(", ")));
+}
+
+/****************************************************************
+ * @brief Adds a conflict to the prune index.
+ * @return false if a known conflict already covers it.
+ ***************************************************************/
+bool ResolverEngine::insertConflict(const ResolverSet &conflict)
+{
+    for (int i = 0; i < m_conflicts.size(); ++i)
+    {
+        if (isSubset(m_conflicts.at(i), conflict))
+        {
+            return false;
+        }
+    }
+    const ResolverChoice &last = conflict.last();
+    m_conflictIndex[choiceKey(last.package, last.version)].append(m_conflicts.size());
+    m_conflicts.append(conflict);
+    return true;
+}
+
+/****************************************************************
+ * @brief Loads the metadata conflicts that fit the matrix.
+ ***************************************************************/
+void ResolverEngine::seedStaticConflicts()
+{
+    int loaded = 0;
+    for (int i = 0; i < m_staticConflicts.size(); ++i)
+    {
+        const ResolverSet &conflict = m_staticConflicts.at(i);
+        bool usable = !conflict.isEmpty();
+        for (int j = 0; j < conflict.size() && usable; ++j)
+        {
+            const ResolverChoice &choice = conflict.at(j);
+            usable = choice.package >= 0 && choice.package < m_packages.size()
+                     && choice.version >= 0 && choice.version < m_packages.at(choice.package).versions.size()
+                     && (j == 0 || conflict.at(j - 1).package < choice.package);
+        }
+        if (!usable)
+        {
+            continue;
+        }
+        m_results.insert(setKey(conflict), false);
+        if (insertConflict(conflict))
+        {
+            ++loaded;
+        }
+    }
+    if (loaded > 0)
+    {
+        emit logMessage(tr("Ruled out %1 candidate pairs from package metadata").arg(loaded));
+    }
+}
+
+/****************************************************************
+ * @brief Loads cached conflicts whose pins all exist in the matrix.
+ ***************************************************************/
+void ResolverEngine::seedConflictsFromCache()
+{
+    if (!m_cache || m_cache->conflicts().isEmpty())
+    {
+        return;
+    }
+    QHash<QString, ResolverChoice> byPin;
+    for (int i = 0; i < m_packages.size(); ++i)
+    {
+        for (int j = 0; j < m_packages.at(i).versions.size(); ++j)
+        {
+            byPin.insert(pinsFor(ResolverSet{{i, j}}).first(), ResolverChoice{i, j});
+        }
+    }
+
+    const QList<QStringList> &cached = m_cache->conflicts();
+    int loaded = 0;
+    for (int i = 0; i < cached.size(); ++i)
+    {
+        ResolverSet conflict;
+        bool usable = true;
+        for (int j = 0; j < cached.at(i).size() && usable; ++j)
+        {
+            const auto it = byPin.constFind(cached.at(i).at(j));
+            usable = it != byPin.constEnd();
+            if (usable)
+            {
+                conflict.append(it.value());
+            }
+        }
+        if (!usable || conflict.isEmpty())
+        {
+            continue;
+        }
+        std::sort(conflict.begin(), conflict.end(),
+                  [](const ResolverChoice &a, const ResolverChoice &b) { return a.package < b.package; });
+        m_results.insert(setKey(conflict), false);
+        if (insertConflict(conflict))
+        {
+            ++loaded;
+        }
+    }
+    if (loaded > 0)
+    {
+        emit logMessage(tr("Loaded %1 known conflicts from the compatibility cache").arg(loaded));
+    }
+}
+
+/****************************************************************
+ * @brief Moves to the next combination free of learned conflicts.
+ ***************************************************************/
+bool ResolverEngine::advanceToConsistent()
+{
+    const int n = m_packages.size();
+    int depth = 0;
+    while (depth < n)
+    {
+        if (violatesConflict(m_current, depth))
+        {
+            // Every combination sharing this prefix is ruled out.
+            m_pruned += tailProduct(depth + 1);
+            depth = incrementAt(m_current, depth);
+            if (depth < 0)
+            {
+                return false;
+            }
+            continue;
+        }
+        ++depth;
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Checks the choice at depth against conflicts ending there.
+ ***************************************************************/
+bool ResolverEngine::violatesConflict(const QVector<int> &current, int depth) const
+{
+    const auto it = m_conflictIndex.constFind(choiceKey(depth, current.at(depth)));
+    if (it == m_conflictIndex.constEnd())
+    {
+        return false;
+    }
+    const QVector<int> &ids = it.value();
+    for (int i = 0; i < ids.size(); ++i)
+    {
+        const ResolverSet &conflict = m_conflicts.at(ids.at(i));
+        bool all = true;
+        for (int j = 0; j < conflict.size() - 1; ++j)
+        {
+            if (current.at(conflict.at(j).package) != conflict.at(j).version)
+            {
+                all = false;
+                break;
+            }
+        }
+        if (all)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/****************************************************************
+ * @brief Odometer increment at depth; deeper digits reset to 0.
+ * @return The depth that changed after carrying, -1 on wrap.
+ ***************************************************************/
+int ResolverEngine::incrementAt(QVector<int> &current, int depth) const
+{
+    for (int j = depth + 1; j < current.size(); ++j)
+    {
+        current[j] = 0;
+    }
+    while (depth >= 0)
+    {
+        if (++current[depth] < m_packages.at(depth).versions.size())
+        {
+            return depth;
+        }
+        current[depth] = 0;
+        --depth;
+    }
+    return -1;
+}
+
+/****************************************************************
+ * @brief Classifies a set using memoized results and conflicts.
+ ***************************************************************/
+ResolverEngine::Outcome ResolverEngine::lookup(const ResolverSet &set) const
+{
+    const auto exact = m_results.constFind(setKey(set));
+    if (exact != m_results.constEnd())
+    {
+        return exact.value() ? Outcome::Pass : Outcome::Fail;
+    }
+
+    // Any learned conflict inside the set decides it.
+    for (int i = 0; i < set.size(); ++i)
+    {
+        const auto it = m_conflictIndex.constFind(choiceKey(set.at(i).package, set.at(i).version));
+        if (it == m_conflictIndex.constEnd())
+        {
+            continue;
+        }
+        const QVector<int> &ids = it.value();
+        for (int j = 0; j < ids.size(); ++j)
+        {
+            if (isSubset(m_conflicts.at(ids.at(j)), set))
+            {
+                return Outcome::Fail;
+            }
+        }
+    }
+
+    // Pins are monotonic: a subset of a compiling set compiles.
+    for (int i = 0; i < m_passing.size(); ++i)
+    {
+        if (isSubset(set, m_passing.at(i)))
+        {
+            return Outcome::Pass;
+        }
+    }
+    return Outcome::Unknown;
+}
+
+/****************************************************************
+ * @brief Hands a set to the runner unless it is already running.
+ * @return true if a new test was issued.
+ ***************************************************************/
+bool ResolverEngine::request(const ResolverSet &set)
+{
+    const QString key = setKey(set);
+    if (!isRunning() || m_inFlightKeys.contains(key))
+    {
+        return false; // stopped by an error earlier in the same pump
+    }
+
+    bool passed = false;
+    QString outputPath;
+    if (m_cache && m_cache->lookup(key, &passed, &outputPath))
+    {
+        // Answered without a test; pump() re-runs the state machine.
+        ++m_cacheHits;
+        ++m_revision;
+        Telemetry::add(Telemetry::Counter::CacheHits);
+        storeResult(set, key, passed, outputPath);
+        m_repump = true;
+        return false;
+    }
+
+    if (freeSlots() <= 0)
+    {
+        return false;
+    }
+    const int testId = m_nextTestId++;
+    m_inFlight.insert(testId, set);
+    m_inFlightKeys.insert(key);
+    ++m_testsLaunched;
+    ++m_revision;
+    emit testRequested(testId, pinsFor(set));
+    return true;
+}
+
+/****************************************************************
+ * @brief Number of tests that may still be issued right now.
+ ***************************************************************/
+int ResolverEngine::freeSlots() const
+{
+    return m_maxParallel - m_inFlight.size();
+}
+
+/****************************************************************
+ * @brief Returns the current full assignment as a set.
+ ***************************************************************/
+ResolverSet ResolverEngine::currentSet() const
+{
+    ResolverSet set;
+    set.reserve(m_current.size());
+    for (int i = 0; i < m_current.size(); ++i)
+    {
+        set.append({i, m_current.at(i)});
+    }
+    return set;
+}
+
+/****************************************************************
+ * @brief Merges two sorted sets of choices.
+ ***************************************************************/
+ResolverSet ResolverEngine::unite(const ResolverSet &a, const ResolverSet &b) const
+{
+    ResolverSet out;
+    out.reserve(a.size() + b.size());
+    int i = 0;
+    int j = 0;
+    while (i < a.size() || j < b.size())
+    {
+        if (j >= b.size() || (i < a.size() && a.at(i).package < b.at(j).package))
+        {
+            out.append(a.at(i++));
+        }
+        else if (i >= a.size() || b.at(j).package < a.at(i).package)
+        {
+            out.append(b.at(j++));
+        }
+        else
+        {
+            out.append(a.at(i++));
+            ++j;
+        }
+    }
+    return out;
+}
+
+/****************************************************************
+ * @brief Order-independent key for a set of choices.
+ ***************************************************************/
+QString ResolverEngine::setKey(const ResolverSet &set) const
+{
+    QStringList pins = pinsFor(set);
+    pins.sort();
+    return pins.join(';');
+}
+
+/****************************************************************
+ * @brief Checks that every choice in small also appears in big.
+ ***************************************************************/
+bool ResolverEngine::isSubset(const ResolverSet &small, const ResolverSet &big) const
+{
+    int j = 0;
+    for (int i = 0; i < small.size(); ++i)
+    {
+        while (j < big.size() && big.at(j).package < small.at(i).package)
+        {
+            ++j;
+        }
+        if (j >= big.size() || big.at(j).package != small.at(i).package
+            || big.at(j).version != small.at(i).version)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Number of combinations of the columns from depth on.
+ ***************************************************************/
+double ResolverEngine::tailProduct(int depth) const
+{
+    double product = 1.0;
+    for (int i = depth; i < m_packages.size(); ++i)
+    {
+        product *= m_packages.at(i).versions.size();
+    }
+    return product;
+}
+
+/****************************************************************
+ * @brief Emits the odometer position as a percentage.
+ ***************************************************************/
+void ResolverEngine::emitProgress()
+{
+    const double total = totalCombinations();
+    if (total <= 0.0)
+    {
+        return;
+    }
+    emit progressChanged(static_cast<int>(100.0 * searchPosition() / total));
+}
+
+/****************************************************************
+ * @brief Snapshot of the running search.
+ *
+ * Sets are stored as flat [package, version, ...] integer arrays;
+ * results keep their pin-string keys so they stay valid even if
+ * a later matrix orders the columns differently.
+ ***************************************************************/
+QCborMap ResolverEngine::saveState() const
+{
+    QCborMap state;
+    if (!isRunning())
+    {
+        return state;
+    }
+
+    QCborArray packages;
+    for (int i = 0; i < m_packages.size(); ++i)
+    {
+        QCborMap package;
+        package.insert(QStringLiteral("name"), m_packages.at(i).name);
+        package.insert(QStringLiteral("versions"), QCborArray::fromStringList(m_packages.at(i).versions));
+        if (!m_packages.at(i).marker.isEmpty())
+        {
+            package.insert(QStringLiteral("marker"), m_packages.at(i).marker);
+        }
+        packages.append(package);
+    }
+    QCborArray current;
+    for (int i = 0; i < m_current.size(); ++i)
+    {
+        current.append(m_current.at(i));
+    }
+    QCborArray conflicts;
+    for (int i = 0; i < m_conflicts.size(); ++i)
+    {
+        conflicts.append(setToCbor(m_conflicts.at(i)));
+    }
+    QCborArray passing;
+    for (int i = 0; i < m_passing.size(); ++i)
+    {
+        passing.append(setToCbor(m_passing.at(i)));
+    }
+    QCborMap results;
+    for (auto it = m_results.constBegin(); it != m_results.constEnd(); ++it)
+    {
+        results.insert(it.key(), it.value());
+    }
+    QCborMap outputs;
+    for (auto it = m_outputs.constBegin(); it != m_outputs.constEnd(); ++it)
+    {
+        outputs.insert(it.key(), it.value());
+    }
+    QCborArray inFlight;
+    for (auto it = m_inFlight.constBegin(); it != m_inFlight.constEnd(); ++it)
+    {
+        inFlight.append(setToCbor(it.value()));
+    }
+    for (int i = 0; i < m_resumeSets.size(); ++i)
+    {
+        inFlight.append(setToCbor(m_resumeSets.at(i)));
+    }
+
+    QCborMap diag;
+    diag.insert(QStringLiteral("failing"), setToCbor(m_diag.failing));
+    diag.insert(QStringLiteral("core"), setToCbor(m_diag.core));
+    diag.insert(QStringLiteral("limit"), m_diag.limit);
+    diag.insert(QStringLiteral("lo"), m_diag.lo);
+    diag.insert(QStringLiteral("hi"), m_diag.hi);
+    diag.insert(QStringLiteral("coreChecked"), m_diag.coreChecked);
+
+    state.insert(QStringLiteral("format"), kStateFormat);
+    state.insert(QStringLiteral("packages"), packages);
+    state.insert(QStringLiteral("current"), current);
+    state.insert(QStringLiteral("diagnosing"), m_phase == Phase::Diagnosing);
+    state.insert(QStringLiteral("diagnosis"), diag);
+    state.insert(QStringLiteral("conflicts"), conflicts);
+    state.insert(QStringLiteral("passing"), passing);
+    state.insert(QStringLiteral("results"), results);
+    state.insert(QStringLiteral("outputs"), outputs);
+    state.insert(QStringLiteral("inFlight"), inFlight);
+    state.insert(QStringLiteral("testsLaunched"), m_testsLaunched);
+    state.insert(QStringLiteral("cacheHits"), m_cacheHits);
+    state.insert(QStringLiteral("pruned"), m_pruned);
+    return state;
+}
+
+/****************************************************************
+ * @brief Replaces all state with a snapshot; leaves it paused.
+ ***************************************************************/
+bool ResolverEngine::restoreState(const QCborMap &state)
+{
+    if (state.value(QStringLiteral("format")).toInteger() != kStateFormat)
+    {
+        return false;
+    }
+
+    // Parse into locals first so a bad snapshot changes nothing.
+    QVector<PackageCandidates> packages;
+    const QCborArray packageArray = state.value(QStringLiteral("packages")).toArray();
+    for (int i = 0; i < packageArray.size(); ++i)
+    {
+        const QCborMap map = packageArray.at(i).toMap();
+        PackageCandidates package;
+        package.name = map.value(QStringLiteral("name")).toString();
+        package.marker = map.value(QStringLiteral("marker")).toString();
+        const QCborArray versions = map.value(QStringLiteral("versions")).toArray();
+        for (int j = 0; j < versions.size(); ++j)
+        {
+            package.versions << versions.at(j).toString();
+        }
+        if (package.versions.isEmpty())
+        {
+            return false;
+        }
+        packages.append(package);
+    }
+    const QCborArray currentArray = state.value(QStringLiteral("current")).toArray();
+    if (packages.isEmpty() || currentArray.size() != packages.size())
+    {
+        return false;
+    }
+    QVector<int> current;
+    for (int i = 0; i < currentArray.size(); ++i)
+    {
+        const int version = static_cast<int>(currentArray.at(i).toInteger(-1));
+        if (version < 0 || version >= packages.at(i).versions.size())
+        {
+            return false;
+        }
+        current.append(version);
+    }
+
+    // setFromCbor() validates against m_packages
+    const QVector<PackageCandidates> previous = m_packages;
+    m_packages = packages;
+    QVector<ResolverSet> conflicts;
+    QVector<ResolverSet> passing;
+    QVector<ResolverSet> inFlight;
+    Diagnosis diag;
+    bool ok = true;
+    const QCborArray conflictArray = state.value(QStringLiteral("conflicts")).toArray();
+    for (int i = 0; i < conflictArray.size() && ok; ++i)
+    {
+        ResolverSet set;
+        ok = setFromCbor(conflictArray.at(i), &set) && !set.isEmpty();
+        conflicts.append(set);
+    }
+    const QCborArray passingArray = state.value(QStringLiteral("passing")).toArray();
+    for (int i = 0; i < passingArray.size() && ok; ++i)
+    {
+        ResolverSet set;
+        ok = setFromCbor(passingArray.at(i), &set);
+        passing.append(set);
+    }
+    const QCborArray inFlightArray = state.value(QStringLiteral("inFlight")).toArray();
+    for (int i = 0; i < inFlightArray.size() && ok; ++i)
+    {
+        ResolverSet set;
+        ok = setFromCbor(inFlightArray.at(i), &set);
+        inFlight.append(set);
+    }
+    const QCborMap diagMap = state.value(QStringLiteral("diagnosis")).toMap();
+    const bool diagnosing = state.value(QStringLiteral("diagnosing")).toBool();
+    ok = ok && setFromCbor(diagMap.value(QStringLiteral("failing")), &diag.failing)
+         && setFromCbor(diagMap.value(QStringLiteral("core")), &diag.core);
+    diag.limit = static_cast<int>(diagMap.value(QStringLiteral("limit")).toInteger());
+    diag.lo = static_cast<int>(diagMap.value(QStringLiteral("lo")).toInteger());
+    diag.hi = static_cast<int>(diagMap.value(QStringLiteral("hi")).toInteger());
+    diag.coreChecked = diagMap.value(QStringLiteral("coreChecked")).toBool();
+    if (diagnosing)
+    {
+        ok = ok && diag.limit >= 0 && diag.limit <= diag.failing.size()
+             && diag.lo >= 0 && diag.lo <= diag.hi && diag.hi <= diag.limit;
+        // A checked core bisects [lo, hi) and then reads failing[hi - 1]
+        ok = ok && (!diag.coreChecked || (diag.hi >= 1 && diag.lo < diag.hi));
+    }
+    if (!ok)
+    {
+        m_packages = previous;
+        return false;
+    }
+
+    stop();
+    m_current = current;
+    m_conflicts.clear();
+    m_conflictIndex.clear();
+    for (int i = 0; i < conflicts.size(); ++i)
+    {
+        insertConflict(conflicts.at(i));
+    }
+    m_passing = passing;
+    m_results.clear();
+    const QCborMap results = state.value(QStringLiteral("results")).toMap();
+    for (auto it = results.constBegin(); it != results.constEnd(); ++it)
+    {
+        m_results.insert(it.key().toString(), it.value().toBool());
+    }
+    m_outputs.clear();
+    const QCborMap outputs = state.value(QStringLiteral("outputs")).toMap();
+    for (auto it = outputs.constBegin(); it != outputs.constEnd(); ++it)
+    {
+        m_outputs.insert(it.key().toString(), it.value().toString());
+    }
+    m_diag = diag;
+    m_hints.clear();
+    m_resumeSets = inFlight;
+    m_testsLaunched = static_cast<int>(state.value(QStringLiteral("testsLaunched")).toInteger());
+    m_cacheHits = static_cast<int>(state.value(QStringLiteral("cacheHits")).toInteger());
+    m_pruned = state.value(QStringLiteral("pruned")).toDouble();
+    m_phase = diagnosing ? Phase::Diagnosing : Phase::Searching;
+    m_paused = true;
+    ++m_revision;
+
+    emit logMessage(tr("Restored search at %1 tests, %2 conflicts learned")
+                        .arg(m_testsLaunched)
+                        .arg(m_conflicts.size()));
+    emitProgress();
+    return true;
+}
+
+quint64 ResolverEngine::stateRevision() const
+{
+    return m_revision;
+}
+
+/****************************************************************
+ * @brief Flattens a set to [package, version, ...].
+ ***************************************************************/
+QCborArray ResolverEngine::setToCbor(const ResolverSet &set)
+{
+    QCborArray array;
+    for (int i = 0; i < set.size(); ++i)
+    {
+        array.append(set.at(i).package);
+        array.append(set.at(i).version);
+    }
+    return array;
+}
+
+/****************************************************************
+ * @brief Reads a flat set, checking it against the matrix.
+ * @return false if an index is out of range or unsorted.
+ ***************************************************************/
+bool ResolverEngine::setFromCbor(const QCborValue &value, ResolverSet *set) const
+{
+    const QCborArray array = value.toArray();
+    if (array.size() % 2 != 0)
+    {
+        return false;
+    }
+    set->clear();
+    for (int i = 0; i + 1 < array.size(); i += 2)
+    {
+        const int package = static_cast<int>(array.at(i).toInteger(-1));
+        const int version = static_cast<int>(array.at(i + 1).toInteger(-1));
+        if (package < 0 || package >= m_packages.size()
+            || version < 0 || version >= m_packages.at(package).versions.size()
+            || (!set->isEmpty() && set->last().package >= package))
+        {
+            return false;
+        }
+        set->append({package, version});
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Packs a (package, version) pair into a hash key.
+ ***************************************************************/
+quint64 ResolverEngine::choiceKey(int package, int version)
+{
+    return (static_cast<quint64>(static_cast<quint32>(package)) << 32)
+           | static_cast<quint32>(version);
+}
+
+/************** End of ResolverEngine.cpp ***********************/
@@ -0,0 +1,404 @@
+/****************************************************************
+ * @file ResolverEngine.h
+ * @brief Declares the ResolverEngine class for matrix resolution.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the ResolverEngine class that searches the
+ * candidate matrix (one candidate list per package) for a set of
+ * pins that pip-compile accepts.
+ * Features:
+ *   - Lexicographic backtracking over the candidate matrix
+ *   - Conflict diagnosis: each failure is shrunk to a minimal
+ *     failing subset (usually a single package pair)
+ *   - Learned conflicts prune every combination containing them;
+ *     pairs already known to clash from package metadata (see
+ *     DependencyGraph) are seeded the same way
+ *   - Result memoization so no set is compiled twice, also
+ *     across runs through an optional CompatibilityCache
+ *   - Up to N tests in flight: bisection probes are spread over
+ *     the free workers and start speculatively while a full
+ *     combination is still compiling
+ *   - Pause, resume and stop without losing search position
+ *   - Full state snapshot (saveState/restoreState) so a search
+ *     survives a restart; see ResolverCheckpoint
+ *
+ * The engine never launches processes itself. It emits
+ * testRequested() for every set it needs compiled and expects
+ * reportTestResult() in return (see PipCompileRunner). Only a
+ * Passed or Failed outcome is memoized, cached or diagnosed; an
+ * Error is asked again, and a set that errors kMaxTestErrors times
+ * stops the search with failed().
+ ***************************************************************/
+#ifndef RESOLVERENGINE_H
+#define RESOLVERENGINE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QCborMap>
+#include <QCborArray>
+#include "TestOutcome.h"
+
+class CompatibilityCache;
+
+/****************************************************************
+ * @struct PackageCandidates
+ * @brief One matrix column: a package and its candidate versions.
+ *
+ * Versions are listed in preference order. An empty version
+ * string means "leave unpinned" and emits the bare name.
+ ***************************************************************/
+struct PackageCandidates
+{
+    QString name;
+    QStringList versions;
+    QString marker;          ///< PEP 508 environment marker, kept on the pin
+};
+
+/****************************************************************
+ * @struct ResolverChoice
+ * @brief A single (package index, version index) assignment.
+ ***************************************************************/
+struct ResolverChoice
+{
+    int package;
+    int version;
+};
+
+/** A set of choices, kept sorted by package index. */
+using ResolverSet = QVector<ResolverChoice>;
+
+/****************************************************************
+ * @class ResolverEngine
+ * @brief Conflict-driven search over the candidate matrix.
+ ***************************************************************/
+class ResolverEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    /****************************************************************
+     * @enum CombinationState
+     * @brief What the search knows about one full combination.
+     ***************************************************************/
+    enum class CombinationState
+    {
+        Pending,     ///< not reached or not decided yet
+        Testing,     ///< compiling right now
+        Passed,      ///< compiled
+        Failed,      ///< compiled and rejected
+        Pruned       ///< contains a learned conflict, never compiled
+    };
+
+    explicit ResolverEngine(QObject *parent = nullptr);
+
+    /****************************************************************
+     * @brief Replaces the candidate matrix and resets all state.
+     * @param packages One entry per package, in search order.
+     ***************************************************************/
+    void setCandidates(const QVector<PackageCandidates> &packages);
+
+    /****************************************************************
+     * @brief Gets the candidate matrix.
+     * @return Packages with their candidate versions.
+     ***************************************************************/
+    const QVector<PackageCandidates> &candidates() const;
+
+    /****************************************************************
+     * @brief Starts a new search from the first combination.
+     * @return true if started, false if no candidates are set.
+     ***************************************************************/
+    bool start();
+
+    /****************************************************************
+     * @brief Stops dispatching tests; in-flight results are kept.
+     ***************************************************************/
+    void pause();
+
+    /****************************************************************
+     * @brief Continues a paused search from where it stopped.
+     ***************************************************************/
+    void resume();
+
+    /****************************************************************
+     * @brief Aborts the search. Outstanding results are ignored.
+     ***************************************************************/
+    void stop();
+
+    bool isRunning() const;
+    bool isPaused() const;
+
+    /****************************************************************
+     * @brief Sets how many tests may be outstanding at once.
+     * @param count Usually the runner's worker count (minimum 1).
+     ***************************************************************/
+    void setMaxParallelTests(int count);
+    int maxParallelTests() const;
+
+    /****************************************************************
+     * @brief Number of tests currently outstanding.
+     ***************************************************************/
+    int testsInFlight() const;
+
+    /****************************************************************
+     * @brief Number of tests handed out via testRequested().
+     ***************************************************************/
+    int testsLaunched() const;
+
+    /****************************************************************
+     * @brief Number of full combinations skipped by learned conflicts.
+     ***************************************************************/
+    double combinationsPruned() const;
+
+    /****************************************************************
+     * @brief Size of the full combination space (product of columns).
+     ***************************************************************/
+    double totalCombinations() const;
+
+    /****************************************************************
+     * @brief Odometer position: combinations before the current one,
+     *        each compiled, failed or pruned.
+     ***************************************************************/
+    double searchPosition() const;
+
+    /****************************************************************
+     * @brief Learned minimal failing sets.
+     ***************************************************************/
+    const QVector<ResolverSet> &conflicts() const;
+
+    /****************************************************************
+     * @brief Conflicts known without compiling, loaded on start()
+     *        next to the cached ones. Not written to the cache.
+     *        Cleared by setCandidates(), so call it afterwards.
+     * @param conflicts Sets sorted by package index.
+     ***************************************************************/
+    void setStaticConflicts(const QVector<ResolverSet> &conflicts);
+
+    /****************************************************************
+     * @brief Uses a persistent cache for results and conflicts.
+     *        Known conflicts are loaded on start(); known results
+     *        are answered without launching a test.
+     * @param cache Cache opened for the current environment, or
+     *        nullptr to disable. Not owned.
+     ***************************************************************/
+    void setCache(CompatibilityCache *cache);
+
+    /****************************************************************
+     * @brief Number of tests answered by the cache in this run.
+     ***************************************************************/
+    int cacheHits() const;
+
+    static const int kMaxTestErrors = 3; ///< attempts per set without a verdict
+
+    /****************************************************************
+     * @brief Builds the pip requirement lines for a set of choices.
+     * @param set Choices sorted by package index.
+     * @return One "name==version" (or bare name) line per choice.
+     ***************************************************************/
+    QStringList pinsFor(const ResolverSet &set) const;
+
+    /****************************************************************
+     * @brief Pins of the next combinations the search will try if
+     *        the current one fails, for fetching their wheels early.
+     * @param combinations How many untested combinations to look at.
+     * @return New pins in search order, without those of the
+     *         combination being tested.
+     ***************************************************************/
+    QStringList upcomingPins(int combinations) const;
+
+    /****************************************************************
+     * @brief Classifies one full combination, for the matrix view.
+     * @param versions Version index per package.
+     ***************************************************************/
+    CombinationState combinationState(const QVector<int> &versions) const;
+
+    /****************************************************************
+     * @brief Snapshot of the running search: candidate matrix,
+     *        odometer position, diagnosis, learned conflicts,
+     *        memoized results and the sets in flight.
+     * @return CBOR map for restoreState(); empty when not running.
+     ***************************************************************/
+    QCborMap saveState() const;
+
+    /****************************************************************
+     * @brief Replaces all state with a snapshot. The engine comes
+     *        back paused at the saved position; resume() continues
+     *        without revisiting earlier combinations and re-issues
+     *        the sets that were in flight.
+     * @param state Map from saveState().
+     * @return false if the snapshot is malformed (state unchanged).
+     ***************************************************************/
+    bool restoreState(const QCborMap &state);
+
+    /****************************************************************
+     * @brief Counter bumped whenever saveState() would change.
+     ***************************************************************/
+    quint64 stateRevision() const;
+
+public slots:
+    /****************************************************************
+     * @brief Receives the outcome of a test issued by testRequested().
+     * @param testId Identifier passed with testRequested().
+     * @param outcome pip's verdict, or Error if there was none.
+     * @param outputPath Compiled requirements file (may be empty).
+     ***************************************************************/
+    void reportTestResult(int testId, TestOutcome outcome, const QString &outputPath);
+
+    /****************************************************************
+     * @brief Names the packages pip blamed for a test that is about
+     *        to fail. Diagnosis compiles just their pins first.
+     * @param testId Identifier passed with testRequested().
+     * @param projects PEP 503 normalized names.
+     ***************************************************************/
+    void setFailureHint(int testId, const QStringList &projects);
+
+signals:
+    /****************************************************************
+     * @brief Emitted when the engine needs a set of pins compiled.
+     * @param testId Identifier to hand back to reportTestResult().
+     * @param pins Requirement lines to compile together.
+     ***************************************************************/
+    void testRequested(int testId, const QStringList &pins);
+
+    /****************************************************************
+     * @brief Emitted with human-readable search progress.
+     ***************************************************************/
+    void logMessage(const QString &message);
+
+    /****************************************************************
+     * @brief Emitted as the search position advances (0-100).
+     ***************************************************************/
+    void progressChanged(int percent);
+
+    /****************************************************************
+     * @brief Emitted when a full combination compiles.
+     * @param pins The working requirement lines.
+     * @param outputPath Compiled requirements file from the runner.
+     ***************************************************************/
+    void resolved(const QStringList &pins, const QString &outputPath);
+
+    /****************************************************************
+     * @brief Emitted when every combination has been ruled out.
+     ***************************************************************/
+    void exhausted();
+
+    /****************************************************************
+     * @brief Emitted when a set could not be tested kMaxTestErrors
+     *        times in a row; the search is stopped, not exhausted.
+     ***************************************************************/
+    void failed(const QString &error);
+
+private:
+    enum class Phase
+    {
+        Idle,
+        Searching,
+        Diagnosing,
+        Finished
+    };
+
+    enum class Outcome
+    {
+        Unknown,
+        Pass,
+        Fail
+    };
+
+    /****************************************************************
+     * @struct Diagnosis
+     * @brief State for shrinking a failing set to a minimal conflict.
+     *
+     * Invariant: core + failing[0..limit) is known to fail. Each
+     * round bisects for the shortest prefix of failing[] that still
+     * fails with core, which identifies one necessary member.
+     ***************************************************************/
+    struct Diagnosis
+    {
+        ResolverSet failing;
+        ResolverSet core;
+        int limit = 0;
+        int lo = 0;
+        int hi = 0;
+        bool coreChecked = false;
+        ResolverSet hint;            ///< pins pip blamed, checked first
+    };
+
+    void pump();
+    bool searchStep();
+    bool diagnoseStep();
+    void beginDiagnosis(const ResolverSet &failing);
+    void learnConflict(const ResolverSet &conflict);
+    bool insertConflict(const ResolverSet &conflict);
+    void seedConflictsFromCache();
+    void seedStaticConflicts();
+    void storeResult(const ResolverSet &set, const QString &key, bool passed, const QString &outputPath);
+
+    /****************************************************************
+     * @brief Moves the current assignment to the next combination
+     *        that contains no learned conflict.
+     * @return false if the matrix is exhausted.
+     ***************************************************************/
+    bool advanceToConsistent();
+    bool violatesConflict(const QVector<int> &current, int depth) const;
+    int incrementAt(QVector<int> &current, int depth) const;
+
+    Outcome lookup(const ResolverSet &set) const;
+    bool request(const ResolverSet &set);
+    int freeSlots() const;
+
+    /****************************************************************
+     * @brief Spreads probes of core + failing[0..p) over free slots
+     *        for p strictly between lo and hi.
+     ***************************************************************/
+    void requestBisection(const ResolverSet &core, const ResolverSet &failing, int lo, int hi);
+    ResolverSet currentSet() const;
+    ResolverSet unite(const ResolverSet &a, const ResolverSet &b) const;
+    QString setKey(const ResolverSet &set) const;
+    bool isSubset(const ResolverSet &small, const ResolverSet &big) const;
+    double tailProduct(int depth) const;
+    void emitProgress();
+
+    static quint64 choiceKey(int package, int version);
+    static QCborArray setToCbor(const ResolverSet &set);
+    bool setFromCbor(const QCborValue &value, ResolverSet *set) const;
+
+    QVector<PackageCandidates> m_packages;
+    QVector<int> m_current;                  ///< version index per package
+    Phase m_phase = Phase::Idle;
+    bool m_paused = false;
+    bool m_pumping = false;
+    bool m_repump = false;
+    Diagnosis m_diag;
+
+    QVector<ResolverSet> m_conflicts;        ///< learned minimal failing sets
+    QVector<ResolverSet> m_staticConflicts;  ///< from metadata, seeded on start()
+    QHash<QString, ResolverSet> m_hints;     ///< failing set key -> pins pip blamed
+    QHash<quint64, QVector<int>> m_conflictIndex; ///< last choice -> conflict ids
+    QVector<ResolverSet> m_passing;          ///< sets known to compile
+    QHash<QString, bool> m_results;          ///< exact set key -> passed
+    QHash<QString, QString> m_outputs;       ///< exact set key -> compiled file
+
+    int m_nextTestId = 1;
+    int m_maxParallel = 1;
+    QHash<int, ResolverSet> m_inFlight;      ///< test id -> set being compiled
+    QSet<QString> m_inFlightKeys;
+    QHash<QString, int> m_errors;            ///< set key -> tests without a verdict
+    int m_testsLaunched = 0;
+    double m_pruned = 0.0;
+
+    CompatibilityCache *m_cache = nullptr;
+    int m_cacheHits = 0;
+
+    quint64 m_revision = 0;
+    QVector<ResolverSet> m_resumeSets;       ///< in flight when the snapshot was taken
+};
+
+#endif // RESOLVERENGINE_H
+/************** End of ResolverEngine.h *************************/
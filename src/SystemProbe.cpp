@@ -0,0 +1,452 @@
+/****************************************************************
+ * @file SystemProbe.cpp
+ * @brief Implements the SystemProbe class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of SystemProbe.
+ * Cache file layout: {"format": 1, "outputs": {"<key>": "<stdout>"}}
+ * where key is "<canonical path>|<size>|<mtime ms>|<args>[|<boot id>]".
+ * Only the newest boot's entry of a hardware probe is kept.
+ ***************************************************************/
+#include "SystemProbe.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QDebug>
+#include <iterator>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const int kCacheFormat = 1;
+static const int kProbeTimeoutMs = 30000;
+
+/****************************************************************
+ * @brief Process-wide probe cache shared by run() and start().
+ ***************************************************************/
+struct ProbeCache
+{
+    QMutex mutex;
+    QString path;
+    QHash<QString, QString> outputs;
+};
+
+static ProbeCache &probeCache()
+{
+    static ProbeCache cache;
+    return cache;
+}
+
+/****************************************************************
+ * @brief Counts NVIDIA GPUs ("nvidia-smi -L" prints one per line).
+ ***************************************************************/
+static int countGpuLines(const QString &output)
+{
+    const QStringList lines = output.split('\n', Qt::SkipEmptyParts);
+    int count = 0;
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        if (lines.at(i).trimmed().startsWith("GPU "))
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+SystemProbe::SystemProbe(QObject *parent) : QObject(parent)
+{
+}
+
+/****************************************************************
+ * @brief Destructor: Kills probes that are still running.
+ ***************************************************************/
+SystemProbe::~SystemProbe()
+{
+    const QList<QProcess *> processes = m_running.keys();
+    for (int i = 0; i < processes.size(); ++i)
+    {
+        processes.at(i)->disconnect(this);
+        processes.at(i)->kill();
+        processes.at(i)->waitForFinished(1000);
+    }
+    delete m_tempDir;
+}
+
+/****************************************************************
+ * @brief Sets the cache file and loads it.
+ ***************************************************************/
+void SystemProbe::setCacheFile(const QString &path)
+{
+    ProbeCache &cache = probeCache();
+    QMutexLocker locker(&cache.mutex);
+    cache.path = path;
+    cache.outputs.clear();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("format").toInt() != kCacheFormat)
+    {
+        return;
+    }
+    const QJsonObject outputs = root.value("outputs").toObject();
+    for (auto it = outputs.constBegin(); it != outputs.constEnd(); ++it)
+    {
+        cache.outputs.insert(it.key(), it.value().toString());
+    }
+}
+
+/****************************************************************
+ * @brief Changes with every boot. Windows has no boot id, so there
+ *        it is the boot time to the minute; a clock step only costs
+ *        one extra probe.
+ ***************************************************************/
+static QString bootStamp()
+{
+    const QByteArray id = QSysInfo::bootUniqueId();
+    if (!id.isEmpty())
+    {
+        return QString::fromLatin1(id);
+    }
+    QElapsedTimer uptime;
+    uptime.start();
+    const qint64 bootMs = QDateTime::currentMSecsSinceEpoch() - uptime.msecsSinceReference();
+    return QString("boot@%1").arg(bootMs / 60000);
+}
+
+/****************************************************************
+ * @brief Key of a probe; empty if the program is not installed.
+ *        The file a probe writes to is a fresh temporary path each
+ *        run, so it is left out.
+ * @param stem Receives the key without the boot stamp.
+ ***************************************************************/
+QString SystemProbe::cacheKey(const Probe &probe, QString *stem)
+{
+    const QString resolved = QFileInfo(probe.program).isAbsolute()
+                                 ? probe.program
+                                 : QStandardPaths::findExecutable(probe.program);
+    const QFileInfo info(resolved);
+    if (resolved.isEmpty() || !info.exists())
+    {
+        return QString();
+    }
+    QStringList arguments = probe.arguments;
+    if (!probe.outputFile.isEmpty())
+    {
+        arguments.removeAll(probe.outputFile);
+    }
+    QString key = QString("%1|%2|%3|%4")
+                      .arg(info.canonicalFilePath())
+                      .arg(info.size())
+                      .arg(info.lastModified().toMSecsSinceEpoch())
+                      .arg(arguments.join(QChar(0x1f)));
+    if (stem)
+    {
+        *stem = key;
+    }
+    if (probe.hardware)
+    {
+        key += '|' + bootStamp();
+    }
+    return key;
+}
+
+/****************************************************************
+ * @brief Remembers an output and rewrites the cache file.
+ ***************************************************************/
+void SystemProbe::store(const QString &key, const QString &output, const QString &stem)
+{
+    ProbeCache &cache = probeCache();
+    QMutexLocker locker(&cache.mutex);
+    if (cache.outputs.value(key) == output && cache.outputs.contains(key))
+    {
+        return;
+    }
+    if (!stem.isEmpty() && stem != key)
+    {
+        // The output of an earlier boot is stale; keep one per probe
+        const QString earlier = stem + '|';
+        for (auto it = cache.outputs.begin(); it != cache.outputs.end();)
+        {
+            it = it.key().startsWith(earlier) ? cache.outputs.erase(it) : std::next(it);
+        }
+    }
+    cache.outputs.insert(key, output);
+    if (cache.path.isEmpty())
+    {
+        return;
+    }
+
+    QJsonObject outputs;
+    for (auto it = cache.outputs.constBegin(); it != cache.outputs.constEnd(); ++it)
+    {
+        outputs.insert(it.key(), it.value());
+    }
+    QJsonObject root;
+    root.insert("format", kCacheFormat);
+    root.insert("outputs", outputs);
+    QSaveFile file(cache.path);
+    if (file.open(QIODevice::WriteOnly))
+    {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
+
+/****************************************************************
+ * @brief Runs a command, or returns its cached standard output.
+ ***************************************************************/
+bool SystemProbe::run(const QString &program, const QStringList &arguments, int timeoutMs,
+                      QString *output)
+{
+    output->clear();
+    Probe probe;
+    probe.program = program;
+    probe.arguments = arguments;
+    const QString key = cacheKey(probe);
+    if (key.isEmpty())
+    {
+        return false;
+    }
+    {
+        ProbeCache &cache = probeCache();
+        QMutexLocker locker(&cache.mutex);
+        const auto it = cache.outputs.constFind(key);
+        if (it != cache.outputs.constEnd())
+        {
+            *output = it.value();
+            return true;
+        }
+    }
+
+    QProcess process;
+    process.start(program, arguments);
+    if (!process.waitForFinished(timeoutMs))
+    {
+        process.kill();
+        process.waitForFinished(1000);
+        return false;
+    }
+    *output = QString::fromLocal8Bit(process.readAllStandardOutput()).trimmed();
+    store(key, *output);
+    DEBUG_MSG() << "probed" << program << arguments << *output;
+    return true;
+}
+
+/****************************************************************
+ * @brief Names the host OS; on Linux from /etc/os-release.
+ ***************************************************************/
+void SystemProbe::detectOs(QString *os, QString *release, QString *version)
+{
+    os->clear();
+    release->clear();
+    version->clear();
+#if defined(Q_OS_WIN)
+    *os = "Windows";
+    *release = QSysInfo::productType();
+    *version = QSysInfo::productVersion();
+#elif defined(Q_OS_MAC)
+    *os = "Mac";
+    *release = QSysInfo::productType();
+    *version = QSysInfo::productVersion();
+#elif defined(Q_OS_LINUX)
+    *os = "Linux";
+    QFile f("/etc/os-release");
+    if (f.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        while (!f.atEnd())
+        {
+            QString line = f.readLine();
+            if (line.startsWith("ID="))
+                *release = line.mid(3).trimmed().replace("\"", "");
+            if (line.startsWith("VERSION_ID="))
+                *version = line.mid(11).trimmed().replace("\"", "");
+        }
+    }
+#endif
+}
+
+/****************************************************************
+ * @brief Starts every probe at once.
+ ***************************************************************/
+void SystemProbe::start(const QList<QStringList> &warmup)
+{
+    if (m_active)
+    {
+        return;
+    }
+    m_active = true;
+    m_outputs.clear();
+    m_probesRun = 0;
+    m_dxdiagDone = false;
+
+    QList<Probe> probes;
+#if defined(Q_OS_WIN)
+    probes.append({"wmic", "wmic", {"path", "win32_VideoController", "get", "name"}, QString(), true});
+    probes.append({"powershell", "powershell",
+                   {"-Command", "Get-WmiObject Win32_VideoController | Select-Object -ExpandProperty Name"},
+                   QString(), true});
+#elif defined(Q_OS_LINUX)
+    probes.append({"lspci", "lspci", {}, QString(), true});
+#elif defined(Q_OS_MAC)
+    probes.append({"system_profiler", "system_profiler", {"SPDisplaysDataType"}, QString(), true});
+#endif
+    probes.append({"nvidia-smi", "nvidia-smi", {"-L"}, QString(), true});
+    for (int i = 0; i < warmup.size(); ++i)
+    {
+        if (!warmup.at(i).isEmpty())
+        {
+            probes.append({"warmup", warmup.at(i).first(), warmup.at(i).mid(1), QString(), false});
+        }
+    }
+
+    for (int i = 0; i < probes.size(); ++i)
+    {
+        launch(probes.at(i));
+    }
+    if (m_running.isEmpty())
+    {
+        // Everything was cached; still report asynchronously
+        QMetaObject::invokeMethod(this, &SystemProbe::finish, Qt::QueuedConnection);
+    }
+}
+
+bool SystemProbe::isRunning() const
+{
+    return m_active;
+}
+
+/****************************************************************
+ * @brief Uses the cached output of a probe or starts its process.
+ ***************************************************************/
+void SystemProbe::launch(const Probe &probe)
+{
+    const QString key = cacheKey(probe);
+    if (key.isEmpty())
+    {
+        m_outputs.insert(probe.name, QString());
+        return;
+    }
+    {
+        ProbeCache &cache = probeCache();
+        QMutexLocker locker(&cache.mutex);
+        const auto it = cache.outputs.constFind(key);
+        if (it != cache.outputs.constEnd())
+        {
+            m_outputs.insert(probe.name, it.value());
+            return;
+        }
+    }
+
+    QProcess *process = new QProcess(this);
+    m_running.insert(process, probe);
+    ++m_probesRun;
+    connect(process, &QProcess::finished, this, [this, process]() { onProbeFinished(process); });
+    connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error)
+            {
+                if (error == QProcess::FailedToStart)
+                {
+                    onProbeFinished(process);
+                }
+            });
+    QTimer::singleShot(kProbeTimeoutMs, process, [process]() { process->kill(); });
+    DEBUG_MSG() << "probing" << probe.program << probe.arguments;
+    process->start(probe.program, probe.arguments);
+}
+
+/****************************************************************
+ * @brief Caches a finished probe; the last one ends the run.
+ ***************************************************************/
+void SystemProbe::onProbeFinished(QProcess *process)
+{
+    if (!m_running.contains(process))
+    {
+        return;
+    }
+    const Probe probe = m_running.take(process);
+    process->deleteLater();
+
+    const bool ok = process->error() != QProcess::FailedToStart
+                    && process->exitStatus() == QProcess::NormalExit;
+    QString output;
+    if (probe.outputFile.isEmpty())
+    {
+        output = QString::fromLocal8Bit(process->readAllStandardOutput()).trimmed();
+    }
+    else
+    {
+        QFile file(probe.outputFile);
+        if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            output = QString::fromLocal8Bit(file.readAll());
+        }
+    }
+    if (ok)
+    {
+        QString stem;
+        const QString key = cacheKey(probe, &stem);
+        store(key, output, stem);
+    }
+    m_outputs.insert(probe.name, m_outputs.value(probe.name) + output);
+
+    if (m_running.isEmpty())
+    {
+        finish();
+    }
+}
+
+/****************************************************************
+ * @brief Combines the outputs; falls back to dxdiag on Windows.
+ ***************************************************************/
+void SystemProbe::finish()
+{
+    SystemInfo info;
+    info.gpuCount = countGpuLines(m_outputs.value("nvidia-smi"));
+    info.gpuDetected = info.gpuCount > 0;
+    for (auto it = m_outputs.constBegin(); it != m_outputs.constEnd() && !info.gpuDetected; ++it)
+    {
+        info.gpuDetected = it.key() != "warmup" && it.value().contains("NVIDIA", Qt::CaseInsensitive);
+    }
+
+#if defined(Q_OS_WIN)
+    if (!info.gpuDetected && !m_dxdiagDone)
+    {
+        m_dxdiagDone = true;
+        m_tempDir = new QTemporaryDir();
+        launch({"dxdiag", "dxdiag", {"/t", m_tempDir->filePath("dxdiag.txt")}, m_tempDir->filePath("dxdiag.txt"),
+                true});
+        if (!m_running.isEmpty())
+        {
+            return;
+        }
+        finish();
+        return;
+    }
+#endif
+
+    delete m_tempDir;
+    m_tempDir = nullptr;
+    info.probesRun = m_probesRun;
+    m_active = false;
+    emit finished(info);
+}
+
+/************** End of SystemProbe.cpp **************************/
@@ -0,0 +1,126 @@
+/****************************************************************
+ * @file SystemProbe.h
+ * @brief Declares the SystemProbe class for cached system probes.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the SystemProbe class. GPU detection (lspci,
+ * wmic, PowerShell, nvidia-smi, dxdiag, system_profiler) and the
+ * "python --version" probes used to run one blocking QProcess after
+ * another before the window appeared.
+ *
+ * start() now launches all of them at once as asynchronous
+ * processes and emits finished() when the last one ends; dxdiag,
+ * by far the slowest, only runs if nothing else found an NVIDIA
+ * GPU. Every output is cached in a small JSON file keyed by the
+ * tool's resolved path, size and modification time and by the
+ * arguments, so a probe only runs again after the tool changes.
+ * Hardware probes are also keyed by the boot id (on Windows, which
+ * has none, by the boot time), so they are refreshed once per boot
+ * and replace the entry of the previous boot. dxdiag's report file
+ * is a new temporary path each run and is not part of its key.
+ *
+ * run() is the blocking, cached form for callers that need an
+ * answer right away (TerminalEngine::setPythonCommand()); after
+ * the first start it is a lookup.
+ ***************************************************************/
+#ifndef SYSTEMPROBE_H
+#define SYSTEMPROBE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QList>
+#include <QProcess>
+
+class QTemporaryDir;
+
+/****************************************************************
+ * @struct SystemInfo
+ * @brief What the GPU probes found.
+ ***************************************************************/
+struct SystemInfo
+{
+    bool gpuDetected = false;
+    int gpuCount = 0;      ///< NVIDIA GPUs listed by nvidia-smi -L
+    int probesRun = 0;     ///< processes started; 0 if all were cached
+};
+
+/****************************************************************
+ * @class SystemProbe
+ * @brief Concurrent, cached GPU and interpreter probes.
+ ***************************************************************/
+class SystemProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SystemProbe(QObject *parent = nullptr);
+    ~SystemProbe();
+
+    /****************************************************************
+     * @brief Sets the cache file and loads it. Call once at startup,
+     *        before the first probe.
+     ***************************************************************/
+    static void setCacheFile(const QString &path);
+
+    /****************************************************************
+     * @brief Runs a command, or returns its cached standard output.
+     * @param program Executable name or path.
+     * @param arguments Command arguments.
+     * @param timeoutMs How long to wait for the process.
+     * @param output Receives standard output.
+     * @return false if the program is not found or did not finish.
+     ***************************************************************/
+    static bool run(const QString &program, const QStringList &arguments, int timeoutMs,
+                    QString *output);
+
+    /****************************************************************
+     * @brief Operating system, distribution (or product type) and
+     *        its version, as shown in the Settings tab.
+     ***************************************************************/
+    static void detectOs(QString *os, QString *release, QString *version);
+
+    /****************************************************************
+     * @brief Starts every probe; ends with finished().
+     * @param warmup Extra commands (program first) whose output
+     *        should be cached for later run() calls.
+     ***************************************************************/
+    void start(const QList<QStringList> &warmup = QList<QStringList>());
+
+    bool isRunning() const;
+
+signals:
+    void finished(const SystemInfo &info);
+
+private:
+    struct Probe
+    {
+        QString name;         ///< what the output is used for
+        QString program;
+        QStringList arguments;
+        QString outputFile;   ///< read instead of stdout (dxdiag)
+        bool hardware = false;
+    };
+
+    static QString cacheKey(const Probe &probe, QString *stem = nullptr);
+    static void store(const QString &key, const QString &output, const QString &stem = QString());
+
+    void launch(const Probe &probe);
+    void onProbeFinished(QProcess *process);
+    void finish();
+
+    QHash<QString, QString> m_outputs;             ///< probe name -> output
+    QHash<QProcess *, Probe> m_running;
+    QTemporaryDir *m_tempDir = nullptr;
+    bool m_dxdiagDone = false;
+    int m_probesRun = 0;
+    bool m_active = false;
+};
+
+#endif // SYSTEMPROBE_H
+/************** End of SystemProbe.h ****************************/
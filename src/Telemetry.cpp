@@ -0,0 +1,368 @@
+/****************************************************************
+ * @file Telemetry.cpp
+ * @brief Implements the Telemetry recorder.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of Telemetry. Spans are
+ * "X" (complete) events on a track per thread id; counters are
+ * "C" events, sampled at most every kCounterSampleUs so a stream
+ * of download chunks does not flood the trace. Times are in
+ * microseconds from reset(), as the trace format expects.
+ ***************************************************************/
+#include "Telemetry.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+namespace
+{
+const qint64 kCounterSampleUs = 100000;
+
+struct Event
+{
+    QString name;
+    int tid = 0;
+    qint64 startUs = 0;
+    qint64 durUs = -1;         ///< -1 while open
+    bool ok = true;
+    QJsonObject args;
+};
+
+struct Open
+{
+    int phase = 0;
+    int event = -1;            ///< -1 when past kMaxEvents
+    QString track;
+    int lane = 0;
+    qint64 startUs = 0;
+};
+
+struct Sample
+{
+    qint64 ts = 0;
+    int counter = 0;
+    qint64 value = 0;
+};
+
+/****************************************************************
+ * @struct State
+ * @brief Everything recorded since the last reset().
+ ***************************************************************/
+struct State
+{
+    QMutex mutex;
+    QElapsedTimer clock;
+    quint32 generation = 1;
+    quint32 nextSpan = 1;
+    std::array<qint64, int(Telemetry::Counter::Count)> counters{};
+    std::array<qint64, int(Telemetry::Counter::Count)> lastSampleUs{};
+    QVector<Telemetry::Phase> phases;
+    QHash<QString, int> phaseIndex;
+    QVector<Event> events;
+    QVector<Sample> samples;
+    int dropped = 0;
+    QHash<qint64, Open> open;
+    QStringList tracks;                   ///< tid - 1 -> display name
+    QHash<QString, int> trackIds;
+    QHash<QString, QVector<bool>> lanes;  ///< base track -> busy sub-tracks
+
+    State()
+    {
+        clock.start();
+        lastSampleUs.fill(-kCounterSampleUs);
+    }
+
+    qint64 nowUs() const
+    {
+        return clock.nsecsElapsed() / 1000;
+    }
+
+    int trackId(const QString &track, int lane)
+    {
+        const QString name = lane == 0 ? track : QString("%1 #%2").arg(track).arg(lane + 1);
+        const auto it = trackIds.constFind(name);
+        if (it != trackIds.constEnd())
+        {
+            return it.value();
+        }
+        tracks << name;
+        trackIds.insert(name, int(tracks.size()));
+        return int(tracks.size());
+    }
+};
+
+State &state()
+{
+    static State s;
+    return s;
+}
+}
+
+Telemetry::Scope::Scope(const QString &name, const QString &track, const QJsonObject &args)
+    : m_span(Telemetry::begin(name, track, args))
+{
+}
+
+Telemetry::Scope::~Scope()
+{
+    Telemetry::end(m_span, m_ok);
+}
+
+void Telemetry::Scope::setFailed()
+{
+    m_ok = false;
+}
+
+/****************************************************************
+ * @brief Starts a span on the first free sub-track of track.
+ ***************************************************************/
+qint64 Telemetry::begin(const QString &name, const QString &track, const QJsonObject &args)
+{
+    State &s = state();
+    QMutexLocker locker(&s.mutex);
+
+    auto phase = s.phaseIndex.constFind(name);
+    if (phase == s.phaseIndex.constEnd())
+    {
+        Phase added;
+        added.name = name;
+        s.phases.append(added);
+        phase = s.phaseIndex.insert(name, int(s.phases.size()) - 1);
+    }
+    ++s.phases[phase.value()].active;
+
+    QVector<bool> &busy = s.lanes[track];
+    int lane = 0;
+    while (lane < busy.size() && busy.at(lane))
+    {
+        ++lane;
+    }
+    if (lane == busy.size())
+    {
+        busy.append(true);
+    }
+    busy[lane] = true;
+
+    Open span;
+    span.phase = phase.value();
+    span.track = track;
+    span.lane = lane;
+    span.startUs = s.nowUs();
+    if (s.events.size() < kMaxEvents)
+    {
+        Event event;
+        event.name = name;
+        event.tid = s.trackId(track, lane);
+        event.startUs = span.startUs;
+        event.args = args;
+        span.event = int(s.events.size());
+        s.events.append(event);
+    }
+    else
+    {
+        ++s.dropped;
+    }
+    const qint64 id = (qint64(s.generation) << 32) | s.nextSpan++;
+    s.open.insert(id, span);
+    return id;
+}
+
+/****************************************************************
+ * @brief Closes a span and adds it to its phase totals.
+ ***************************************************************/
+void Telemetry::end(qint64 span, bool ok)
+{
+    State &s = state();
+    QMutexLocker locker(&s.mutex);
+    const auto it = s.open.find(span);
+    if (it == s.open.end())
+    {
+        return; // from before reset(), or ended twice
+    }
+    const Open open = it.value();
+    s.open.erase(it);
+
+    const qint64 duration = s.nowUs() - open.startUs;
+    Phase &phase = s.phases[open.phase];
+    --phase.active;
+    ++phase.count;
+    phase.failed += ok ? 0 : 1;
+    phase.totalUs += duration;
+    phase.maxUs = qMax(phase.maxUs, duration);
+    if (open.event >= 0)
+    {
+        s.events[open.event].durUs = duration;
+        s.events[open.event].ok = ok;
+    }
+    s.lanes[open.track][open.lane] = false;
+}
+
+void Telemetry::add(Counter counter, qint64 delta)
+{
+    State &s = state();
+    QMutexLocker locker(&s.mutex);
+    const int c = int(counter);
+    s.counters[c] += delta;
+    const qint64 now = s.nowUs();
+    if (now - s.lastSampleUs[c] >= kCounterSampleUs && s.samples.size() < kMaxEvents)
+    {
+        s.lastSampleUs[c] = now;
+        s.samples.append({now, c, s.counters[c]});
+    }
+}
+
+void Telemetry::reset()
+{
+    State &s = state();
+    QMutexLocker locker(&s.mutex);
+    ++s.generation;
+    s.nextSpan = 1;
+    s.counters.fill(0);
+    s.lastSampleUs.fill(-kCounterSampleUs);
+    s.phases.clear();
+    s.phaseIndex.clear();
+    s.events.clear();
+    s.samples.clear();
+    s.dropped = 0;
+    s.open.clear();
+    s.tracks.clear();
+    s.trackIds.clear();
+    s.lanes.clear();
+    s.clock.restart();
+}
+
+Telemetry::Snapshot Telemetry::snapshot()
+{
+    State &s = state();
+    QMutexLocker locker(&s.mutex);
+    Snapshot snap;
+    snap.elapsedUs = s.nowUs();
+    snap.counters = s.counters;
+    snap.phases = s.phases;
+    snap.events = int(s.events.size());
+    snap.dropped = s.dropped;
+    return snap;
+}
+
+/****************************************************************
+ * @brief Writes {"traceEvents": [...]} one event per line.
+ ***************************************************************/
+bool Telemetry::exportTrace(const QString &path, QString *error)
+{
+    // Copy under the lock, format without it
+    QVector<Event> events;
+    QVector<Sample> samples;
+    QStringList tracks;
+    std::array<qint64, int(Counter::Count)> counters{};
+    qint64 now = 0;
+    {
+        State &s = state();
+        QMutexLocker locker(&s.mutex);
+        events = s.events;
+        samples = s.samples;
+        tracks = s.tracks;
+        counters = s.counters;
+        now = s.nowUs();
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        if (error)
+        {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    const qint64 pid = QCoreApplication::applicationPid();
+    bool first = true;
+    auto write = [&](const QJsonObject &event)
+    {
+        file.write(first ? "{\"traceEvents\":[\n" : ",\n");
+        file.write(QJsonDocument(event).toJson(QJsonDocument::Compact));
+        first = false;
+    };
+
+    write(QJsonObject{{"name", "process_name"}, {"ph", "M"}, {"pid", pid},
+                      {"args", QJsonObject{{"name", QCoreApplication::applicationName()}}}});
+    for (int i = 0; i < tracks.size(); ++i)
+    {
+        write(QJsonObject{{"name", "thread_name"}, {"ph", "M"}, {"pid", pid}, {"tid", i + 1},
+                          {"args", QJsonObject{{"name", tracks.at(i)}}}});
+    }
+    for (int i = 0; i < events.size(); ++i)
+    {
+        const Event &e = events.at(i);
+        QJsonObject args = e.args;
+        if (e.durUs < 0)
+        {
+            args.insert("unfinished", true);
+        }
+        else if (!e.ok)
+        {
+            args.insert("failed", true);
+        }
+        QJsonObject event{{"name", e.name}, {"ph", "X"}, {"pid", pid}, {"tid", e.tid},
+                          {"ts", e.startUs}, {"dur", e.durUs < 0 ? now - e.startUs : e.durUs}};
+        if (!args.isEmpty())
+        {
+            event.insert("args", args);
+        }
+        write(event);
+    }
+    for (int i = 0; i < samples.size(); ++i)
+    {
+        const Sample &sample = samples.at(i);
+        write(QJsonObject{{"name", counterName(Counter(sample.counter))}, {"ph", "C"}, {"pid", pid},
+                          {"ts", sample.ts},
+                          {"args", QJsonObject{{"value", sample.value}}}});
+    }
+    for (int c = 0; c < int(Counter::Count); ++c)
+    {
+        write(QJsonObject{{"name", counterName(Counter(c))}, {"ph", "C"}, {"pid", pid}, {"ts", now},
+                          {"args", QJsonObject{{"value", counters[c]}}}});
+    }
+    file.write("\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    if (!file.commit())
+    {
+        if (error)
+        {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+QString Telemetry::counterName(Counter counter)
+{
+    switch (counter)
+    {
+    case Counter::ProcessLaunches:
+        return QCoreApplication::translate("Telemetry", "Process launches");
+    case Counter::Retries:
+        return QCoreApplication::translate("Telemetry", "Retries");
+    case Counter::CacheHits:
+        return QCoreApplication::translate("Telemetry", "Cache hits");
+    case Counter::BytesDownloaded:
+        return QCoreApplication::translate("Telemetry", "Bytes downloaded");
+    case Counter::EarlyExits:
+        return QCoreApplication::translate("Telemetry", "Early exits");
+    case Counter::HelperQueries:
+        return QCoreApplication::translate("Telemetry", "Helper queries");
+    case Counter::Count:
+        break;
+    }
+    return QString();
+}
+
+/************** End of Telemetry.cpp ****************************/
@@ -0,0 +1,138 @@
+/****************************************************************
+ * @file Telemetry.h
+ * @brief Declares Telemetry, the run's timing and counter record.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines Telemetry, a process-wide, thread-safe record
+ * of what a run spent its time on. Every subprocess phase (venv
+ * creation, pip upgrade, pip-compile, pip wheel, installs, batch
+ * jobs) is a span: begin() when it starts, end() when it finishes,
+ * or a Scope for work that completes in one call. Counters track
+ * process launches, retries, cache hits and bytes downloaded.
+ *
+ * snapshot() feeds the Stats tab; exportTrace() writes the spans
+ * and counter samples as Chrome trace event JSON, which
+ * chrome://tracing and ui.perfetto.dev open directly. Spans that
+ * overlap on one track (parallel workers, batch slots) are spread
+ * over numbered sub-tracks so each row in the viewer is sequential.
+ *
+ * Recording costs one mutex and a few moves per span. After
+ * kMaxEvents spans the trace stops growing, but the per-phase
+ * totals keep counting.
+ ***************************************************************/
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+#include <array>
+
+/****************************************************************
+ * @class Telemetry
+ * @brief Static span and counter recorder.
+ ***************************************************************/
+class Telemetry
+{
+public:
+    /****************************************************************
+     * @enum Counter
+     * @brief Run-wide counters.
+     ***************************************************************/
+    enum class Counter
+    {
+        ProcessLaunches,
+        Retries,
+        CacheHits,
+        BytesDownloaded,
+        EarlyExits,              ///< pip-compile killed by FailureClassifier
+        HelperQueries,           ///< requests sent to a PythonHelper
+        Count
+    };
+
+    /****************************************************************
+     * @struct Phase
+     * @brief Totals of all spans with the same name.
+     ***************************************************************/
+    struct Phase
+    {
+        QString name;
+        int count = 0;           ///< finished spans
+        int failed = 0;
+        int active = 0;          ///< still running
+        qint64 totalUs = 0;
+        qint64 maxUs = 0;
+    };
+
+    /****************************************************************
+     * @struct Snapshot
+     * @brief Counters and phase totals at one moment.
+     ***************************************************************/
+    struct Snapshot
+    {
+        qint64 elapsedUs = 0;    ///< since the run started
+        std::array<qint64, int(Counter::Count)> counters{};
+        QVector<Phase> phases;   ///< in order of first appearance
+        int events = 0;          ///< spans kept for the trace
+        int dropped = 0;         ///< spans past kMaxEvents
+    };
+
+    /****************************************************************
+     * @class Scope
+     * @brief Span for the lifetime of the object.
+     ***************************************************************/
+    class Scope
+    {
+    public:
+        Scope(const QString &name, const QString &track, const QJsonObject &args = QJsonObject());
+        ~Scope();
+        void setFailed();
+
+    private:
+        Q_DISABLE_COPY(Scope)
+        qint64 m_span;
+        bool m_ok = true;
+    };
+
+    /****************************************************************
+     * @brief Starts a span.
+     * @param name Phase, e.g. "pip-compile"; spans are totalled by it.
+     * @param track Timeline row, e.g. "worker 2".
+     * @param args Extra detail shown in the trace viewer.
+     * @return Id for end().
+     ***************************************************************/
+    static qint64 begin(const QString &name, const QString &track,
+                        const QJsonObject &args = QJsonObject());
+
+    /****************************************************************
+     * @brief Ends a span; unknown or stale ids are ignored.
+     ***************************************************************/
+    static void end(qint64 span, bool ok = true);
+
+    static void add(Counter counter, qint64 delta = 1);
+
+    /****************************************************************
+     * @brief Starts a new run: clears spans, totals and counters.
+     *        Spans that are still open end without being recorded.
+     ***************************************************************/
+    static void reset();
+
+    static Snapshot snapshot();
+
+    /****************************************************************
+     * @brief Writes the run as Chrome trace event JSON.
+     * @return false with error set if the file cannot be written.
+     ***************************************************************/
+    static bool exportTrace(const QString &path, QString *error = nullptr);
+
+    static QString counterName(Counter counter);
+
+    static const int kMaxEvents = 200000;
+};
+
+#endif // TELEMETRY_H
+/************** End of Telemetry.h ******************************/
@@ -20,7 +20,17 @@
 #include <QUrl>
 #include <QPushButton>
 #include <QProcess>
+#include <QRegularExpression>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentRun>
 #include "Settings.h"        // central source of truth
+#include "VenvManager.h"
+#include "SystemProbe.h"
+#include "PythonHelper.h"
+#include "Requirement.h"
+#include "Telemetry.h"
 #include "Config.h"
 
 #define SHOW_DEBUG 1
@@ -31,9 +41,11 @@ QStringList TerminalEngine::g_pythonBaseArgs;
 /****************************************************************
  * @brief Constructor: Initializes the terminal engine.
  ***************************************************************/
-TerminalEngine::TerminalEngine(QObject *parent) : QObject(parent), currentProcess(nullptr)
+TerminalEngine::TerminalEngine(QObject *parent)
+    : QObject(parent), currentProcess(nullptr), pythonHelper(new PythonHelper(this))
 {
     venvPath = QDir::current().filePath(".venv");
+    connect(pythonHelper, &PythonHelper::replied, this, &TerminalEngine::onHelperReplied);
 }
 
 /****************************************************************
@@ -103,17 +115,15 @@ void TerminalEngine::setPythonCommand(const QString &versionFromSettings)
                       : QString("python%1").arg(versionFromSettings);
 #endif
 
-    // Probe actual version
-    QProcess proc;
-    proc.start(g_pythonExe, g_pythonBaseArgs + QStringList{"--version"});
-    proc.waitForFinished(3000);
-    QString output = QString::fromUtf8(proc.readAllStandardOutput()).trimmed();
+    // Probe actual version (cached until the interpreter changes)
+    QString output;
+    SystemProbe::run(g_pythonExe, g_pythonBaseArgs + QStringList{"--version"}, 3000, &output);
 
     if (!versionFromSettings.isEmpty() && !output.contains(versionFromSettings))
     {
         // Detect available versions
         QStringList detectedVersions;
-        QStringList candidates = {"python3.10", "python3.11", "python3.12", "python3.13", "python"};
+        const QStringList candidates = pythonCandidates();
 
         // FIX: use index-based loop to avoid detach warning
         for (int i = 0; i < candidates.size(); ++i)
@@ -122,10 +132,8 @@ void TerminalEngine::setPythonCommand(const QString &versionFromSettings)
             QString exe = QStandardPaths::findExecutable(candidate);
             if (!exe.isEmpty())
             {
-                QProcess p;
-                p.start(exe, {"--version"});
-                p.waitForFinished(2000);
-                QString verOut = QString::fromUtf8(p.readAllStandardOutput()).trimmed();
+                QString verOut;
+                SystemProbe::run(exe, {"--version"}, 2000, &verOut);
                 if (!verOut.isEmpty())
                 {
                     detectedVersions << verOut;
@@ -192,6 +200,22 @@ void TerminalEngine::setPythonCommand(const QString &versionFromSettings)
     DEBUG_MSG() << "[DEBUG] setPythonCommand resolved:" << g_pythonExe << g_pythonBaseArgs << "Reported:" << output;
 }
 
+/****************************************************************
+ * @brief Interpreters offered when the requested one is missing.
+ ***************************************************************/
+QStringList TerminalEngine::pythonCandidates()
+{
+    return {"python3.10", "python3.11", "python3.12", "python3.13", "python"};
+}
+
+/****************************************************************
+ * @brief Returns the interpreter chosen by setPythonCommand().
+ ***************************************************************/
+QString TerminalEngine::pythonExe()
+{
+    return g_pythonExe;
+}
+
 /****************************************************************
  * @brief Returns base args (e.g., -3.11).
  ***************************************************************/
@@ -201,102 +225,377 @@ QStringList TerminalEngine::pythonBaseArgs()
 }
 
 /****************************************************************
- * @brief Creates a Python virtual environment and upgrades pip/pip-tools.
+ * @brief Starts creating a Python virtual environment.
  *        Handles both Windows launcher (py.exe) and direct python.exe.
- *        Removes any existing venv first, then runs the command.
+ *        Removes any existing venv first. Every step runs either in
+ *        a QProcess or on the thread pool, so the GUI never blocks:
+ *
+ *        Removing -> CreatingVenv -> UpgradingVenv
+ *        Removing -> [CreatingTemplate -> UpgradingTemplate] -> Cloning
  *
  * @param pythonVersion Version selector (e.g. "-3.10") if using py.exe
- * @return true if venv created successfully, false otherwise
+ * @return true if creation started
  ***************************************************************/
-bool TerminalEngine::createVirtualEnvironment(const QString &pythonVersion)
+bool TerminalEngine::createVirtualEnvironment(const QString &pythonVersion,
+                                              const QString &pipVersion,
+                                              const QString &pipToolsVersion)
 {
     DEBUG_MSG() << "Enter createVirtualEnvironment()";
     DEBUG_MSG() << "Target venv path:" << venvPath;
 
+    if (venvStep != VenvStep::Idle)
+    {
+        emit outputReceived("Virtual environment creation already running", true);
+        return false;
+    }
+    pythonHelper->stop(); // a running interpreter keeps the old venv open
+    venvPythonVersion = pythonVersion;
+    venvPipVersion = pipVersion;
+    venvPipToolsVersion = pipToolsVersion;
+    venvTemplatePath = venvUseTemplate && !venvTemplateRoot.isEmpty()
+                           ? templatePathFor(pythonVersion, pipVersion, pipToolsVersion)
+                           : QString();
+    venvCancelled = false;
+
     emit venvProgress("Checking for existing virtual environment...");
+    startVenvRemoval();
+    return true;
+}
 
-    if (venvExists())
+bool TerminalEngine::isCreatingVenv() const
+{
+    return venvStep != VenvStep::Idle;
+}
+
+/****************************************************************
+ * @brief Aborts venv creation.
+ ***************************************************************/
+void TerminalEngine::cancelVenvCreation()
+{
+    if (venvStep == VenvStep::Idle)
     {
-        DEBUG_MSG() << "Existing venv found, removing...";
-        if (!removeVirtualEnvironment())
-        {
-            emit outputReceived("Failed to remove existing virtual environment", true);
-            return false;
-        }
+        return;
+    }
+    venvCancelled = true;
+    if (venvProcess && venvProcess->state() != QProcess::NotRunning)
+    {
+        venvProcess->kill(); // finished() completes the cancel
     }
+    // Background steps cannot be interrupted; their watcher sees the flag.
+}
+
+void TerminalEngine::setTemplateRoot(const QString &dir)
+{
+    venvTemplateRoot = dir;
+}
+
+QString TerminalEngine::templateRoot() const
+{
+    return venvTemplateRoot;
+}
+
+void TerminalEngine::setUseTemplate(bool enabled)
+{
+    venvUseTemplate = enabled;
+}
+
+bool TerminalEngine::useTemplate() const
+{
+    return venvUseTemplate;
+}
+
+/****************************************************************
+ * @brief Template venv folder for a version triple.
+ ***************************************************************/
+QString TerminalEngine::templatePathFor(const QString &pythonVersion,
+                                        const QString &pipVersion,
+                                        const QString &pipToolsVersion) const
+{
+    QString name = QString("python-%1_pip-%2_piptools-%3")
+                       .arg(pythonVersion.isEmpty() ? "default" : pythonVersion,
+                            pipVersion.isEmpty() ? "latest" : pipVersion,
+                            pipToolsVersion.isEmpty() ? "latest" : pipToolsVersion);
+    name.replace(QRegularExpression("[^A-Za-z0-9._-]"), "_");
+    return QDir(venvTemplateRoot).filePath(name);
+}
+
+/****************************************************************
+ * @brief Step 1: removes the old venv on the thread pool.
+ ***************************************************************/
+void TerminalEngine::startVenvRemoval()
+{
+    const QString target = venvPath;
+    if (!QFileInfo::exists(target))
+    {
+        venvStep = VenvStep::Removing;
+        onVenvProcessFinished(0, QProcess::NormalExit);
+        return;
+    }
+    DEBUG_MSG() << "Existing venv found, removing...";
+    emit venvProgress("Removing existing virtual environment...");
+    runInBackground(VenvStep::Removing, [target]()
+                    {
+                        return QDir(target).removeRecursively()
+                                   ? QString()
+                                   : QString("Failed to remove existing virtual environment");
+                    });
+}
 
+/****************************************************************
+ * @brief Runs "python -m venv <target>".
+ ***************************************************************/
+void TerminalEngine::startVenvProcess(const QString &target)
+{
     QString pythonExe = pythonCommand();
     QStringList args = pythonBaseArgs();
 
-    if (pythonExe.contains("py.exe", Qt::CaseInsensitive) && !pythonVersion.isEmpty())
+    if (pythonExe.contains("py.exe", Qt::CaseInsensitive) && !venvPythonVersion.isEmpty())
     {
-        DEBUG_MSG() << "Detected py.exe → adding version selector:" << pythonVersion;
-        args << pythonVersion << "-m" << "venv" << venvPath;
+        DEBUG_MSG() << "Detected py.exe → adding version selector:" << venvPythonVersion;
+        args << venvPythonVersion << "-m" << "venv" << target;
     }
     else
     {
         DEBUG_MSG() << "Detected direct python interpreter → no version selector";
-        args << "-m" << "venv" << venvPath;
+        args << "-m" << "venv" << target;
     }
 
     DEBUG_MSG() << "Using Python executable:" << pythonExe;
     DEBUG_MSG() << "Command line:" << pythonExe << args;
 
-    QProcess process;
-    process.setProcessChannelMode(QProcess::MergedChannels);
-    process.start(pythonExe, args);
+    venvStep = target == venvPath ? VenvStep::CreatingVenv : VenvStep::CreatingTemplate;
+    emit venvProgress(venvStep == VenvStep::CreatingTemplate
+                          ? QString("Building template venv %1...").arg(target)
+                          : QString("Creating virtual environment..."));
+    runVenvProcess(pythonExe, args);
+}
 
-    if (!process.waitForStarted(5000))
-    {
-        emit outputReceived("Failed to start Python process", true);
-        return false;
-    }
+/****************************************************************
+ * @brief Installs the pinned pip and pip-tools into target.
+ ***************************************************************/
+void TerminalEngine::startUpgradeProcess(const QString &target)
+{
+    QStringList args;
+    args << "-m" << "pip" << "install" << "--upgrade"
+         << (venvPipVersion.isEmpty() ? QString("pip") : QString("pip==%1").arg(venvPipVersion))
+         << (venvPipToolsVersion.isEmpty() ? QString("pip-tools")
+                                           : QString("pip-tools==%1").arg(venvPipToolsVersion));
+
+    DEBUG_MSG() << "Upgrading pip and installing pip-tools..." << args;
+    venvStep = target == venvPath ? VenvStep::UpgradingVenv : VenvStep::UpgradingTemplate;
+    emit venvProgress("Installing pip and pip-tools...");
+    runVenvProcess(venvPythonPath(target), args);
+}
 
-    bool finished = process.waitForFinished(60000);
+/****************************************************************
+ * @brief Clones the template venv to venvPath on the thread pool.
+ ***************************************************************/
+void TerminalEngine::startTemplateClone()
+{
+    const QString source = venvTemplatePath;
+    const QString target = venvPath;
+    emit venvProgress(QString("Cloning template venv %1...").arg(source));
+    runInBackground(VenvStep::Cloning, [source, target]()
+                    {
+                        QString error;
+                        if (!VenvManager::cloneVenv(source, target, &error, VenvManager::CloneMode::Fast))
+                        {
+                            return error.isEmpty() ? QString("Failed to clone template venv") : error;
+                        }
+                        return QString();
+                    });
+}
 
-    QString stdOut = QString::fromUtf8(process.readAllStandardOutput());
-    QString stdErr = QString::fromUtf8(process.readAllStandardError());
+/****************************************************************
+ * @brief Starts one step's process, streaming its output.
+ ***************************************************************/
+void TerminalEngine::runVenvProcess(const QString &program, const QStringList &args)
+{
+    venvProcess = new QProcess(this);
+    venvProcess->setProcessChannelMode(QProcess::MergedChannels);
+    connect(venvProcess, &QProcess::readyReadStandardOutput, this, [this]()
+            {
+                emit outputReceived(QString::fromUtf8(venvProcess->readAllStandardOutput()), false);
+            });
+    connect(venvProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &TerminalEngine::onVenvProcessFinished);
+    connect(venvProcess, &QProcess::errorOccurred, this, [this, program](QProcess::ProcessError error)
+            {
+                if (error == QProcess::FailedToStart)
+                {
+                    emit outputReceived(QString("Failed to start %1").arg(program), true);
+                    onVenvProcessFinished(-1, QProcess::CrashExit);
+                }
+            });
+    venvSpan = Telemetry::begin(venvStepName(), "venv", QJsonObject{{"program", program}});
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
+    venvProcess->start(program, args);
+}
 
-    DEBUG_MSG() << "Process finished:" << finished
-                << " Exit code:" << process.exitCode()
-                << " Exit status:" << process.exitStatus()
-                << " Error:" << process.error();
-    DEBUG_MSG() << "StdOut:" << stdOut;
-    DEBUG_MSG() << "StdErr:" << stdErr;
+/****************************************************************
+ * @brief Runs filesystem work off the GUI thread. The work returns
+ *        an error message, empty on success.
+ ***************************************************************/
+void TerminalEngine::runInBackground(VenvStep step, const std::function<QString()> &work)
+{
+    venvStep = step;
+    venvSpan = Telemetry::begin(venvStepName(), "venv");
+    venvWatcher = new QFutureWatcher<QString>(this);
+    connect(venvWatcher, &QFutureWatcher<QString>::finished, this, [this]()
+            {
+                const QString error = venvWatcher->result();
+                venvWatcher->deleteLater();
+                venvWatcher = nullptr;
+                if (!error.isEmpty())
+                {
+                    emit outputReceived(error, true);
+                }
+                onVenvProcessFinished(error.isEmpty() ? 0 : 1, QProcess::NormalExit);
+            });
+    venvWatcher->setFuture(QtConcurrent::run(work));
+}
 
-    if (!finished || process.exitCode() != 0 || !venvExists())
+/****************************************************************
+ * @brief Advances the state machine after each step.
+ ***************************************************************/
+void TerminalEngine::onVenvProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    const bool ok = exitStatus == QProcess::NormalExit && exitCode == 0;
+    Telemetry::end(venvSpan, ok);
+    venvSpan = 0;
+    if (venvProcess)
     {
-        emit outputReceived(QString("Failed to create virtual environment: %1").arg(stdErr), true);
-        return false;
+        venvProcess->disconnect(this);
+        venvProcess->deleteLater();
+        venvProcess = nullptr;
+    }
+    if (venvStep == VenvStep::Idle)
+    {
+        return; // failure already reported by errorOccurred()
+    }
+    if (venvCancelled)
+    {
+        finishVenvCreation(false, "Virtual environment creation cancelled");
+        return;
     }
 
-    emit venvProgress("Virtual environment created successfully");
+    switch (venvStep)
+    {
+    case VenvStep::Removing:
+        if (!ok)
+        {
+            finishVenvCreation(false, "Failed to remove existing virtual environment");
+        }
+        else if (venvTemplatePath.isEmpty())
+        {
+            startVenvProcess(venvPath);
+        }
+        else if (VenvManager::isTemplateReady(venvTemplatePath))
+        {
+            startTemplateClone();
+        }
+        else
+        {
+            QDir(venvTemplatePath).removeRecursively(); // partial build
+            startVenvProcess(venvTemplatePath);
+        }
+        break;
+
+    case VenvStep::CreatingTemplate:
+    case VenvStep::CreatingVenv:
+    {
+        const QString target = venvStep == VenvStep::CreatingTemplate ? venvTemplatePath : venvPath;
+        if (!ok || !VenvManager::isVenv(target))
+        {
+            finishVenvCreation(false, "Failed to create virtual environment");
+            return;
+        }
+        emit venvProgress("Virtual environment created successfully");
+        startUpgradeProcess(target);
+        break;
+    }
 
-    // 🔧 NEW STEP: upgrade pip and install pip-tools
-    QString venvPython = venvPath + "/Scripts/python.exe"; // Windows path
-    QStringList upgradeArgs;
-    upgradeArgs << "-m" << "pip" << "install" << "--upgrade" << "pip" << "pip-tools";
+    case VenvStep::UpgradingTemplate:
+        if (!ok || !VenvManager::markTemplateReady(venvTemplatePath,
+                                                   templatePathFor(venvPythonVersion,
+                                                                   venvPipVersion,
+                                                                   venvPipToolsVersion)))
+        {
+            finishVenvCreation(false, "pip upgrade failed in template venv");
+            return;
+        }
+        emit venvProgress("Template venv ready");
+        startTemplateClone();
+        break;
 
-    DEBUG_MSG() << "Upgrading pip and installing pip-tools...";
-    QProcess upgradeProc;
-    upgradeProc.setProcessChannelMode(QProcess::MergedChannels);
-    upgradeProc.start(venvPython, upgradeArgs);
-    upgradeProc.waitForFinished(60000);
+    case VenvStep::UpgradingVenv:
+        if (!ok)
+        {
+            finishVenvCreation(false, "pip upgrade failed");
+            return;
+        }
+        finishVenvCreation(true, "pip and pip-tools upgraded successfully");
+        break;
 
-    QString upgradeOut = QString::fromUtf8(upgradeProc.readAllStandardOutput());
-    QString upgradeErr = QString::fromUtf8(upgradeProc.readAllStandardError());
+    case VenvStep::Cloning:
+        if (!ok || !venvExists())
+        {
+            finishVenvCreation(false, "Failed to clone template venv");
+            return;
+        }
+        finishVenvCreation(true, "Virtual environment cloned from template");
+        break;
 
-    DEBUG_MSG() << "Upgrade StdOut:" << upgradeOut;
-    DEBUG_MSG() << "Upgrade StdErr:" << upgradeErr;
+    case VenvStep::Idle:
+        break;
+    }
+}
 
-    if (upgradeProc.exitCode() != 0)
+/****************************************************************
+ * @brief Phase name of the current step, for Telemetry.
+ ***************************************************************/
+QString TerminalEngine::venvStepName() const
+{
+    switch (venvStep)
     {
-        emit outputReceived(QString("pip upgrade failed: %1").arg(upgradeErr), true);
-        return false;
+    case VenvStep::Removing:
+        return QStringLiteral("venv remove");
+    case VenvStep::CreatingTemplate:
+        return QStringLiteral("venv create (template)");
+    case VenvStep::UpgradingTemplate:
+        return QStringLiteral("pip upgrade (template)");
+    case VenvStep::Cloning:
+        return QStringLiteral("venv clone");
+    case VenvStep::CreatingVenv:
+        return QStringLiteral("venv create");
+    case VenvStep::UpgradingVenv:
+        return QStringLiteral("pip upgrade");
+    case VenvStep::Idle:
+        break;
     }
+    return QStringLiteral("venv");
+}
 
-    emit venvProgress("pip and pip-tools upgraded successfully");
-    return true;
+/****************************************************************
+ * @brief Ends the state machine and reports the result.
+ ***************************************************************/
+void TerminalEngine::finishVenvCreation(bool success, const QString &message)
+{
+    const bool building = venvStep == VenvStep::CreatingTemplate || venvStep == VenvStep::UpgradingTemplate;
+    venvStep = VenvStep::Idle;
+    if (!success && building)
+    {
+        QDir(venvTemplatePath).removeRecursively();
+    }
+    if (success)
+    {
+        emit venvProgress(message);
+    }
+    else
+    {
+        emit outputReceived(message, true);
+    }
+    emit venvCreationFinished(success);
 }
 
 /****************************************************************
@@ -314,12 +613,15 @@ bool TerminalEngine::activateVenv()
 
     DEBUG_MSG() << "Activation probe:" << pythonExe << args;
 
+    Telemetry::Scope phase("venv activate", "venv");
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
     QProcess proc;
     proc.start(pythonExe, args);
 
     if (!proc.waitForStarted(5000))
     {
         DEBUG_MSG() << "Activation probe failed to start:" << proc.errorString();
+        phase.setFailed();
         return false;
     }
 
@@ -334,6 +636,7 @@ bool TerminalEngine::activateVenv()
 
     if (!finished || proc.exitCode() != 0)
     {
+        phase.setFailed();
         return false;
     }
 
@@ -393,12 +696,18 @@ bool TerminalEngine::upgradePip()
 
     DEBUG_MSG() << "Upgrading pip with:" << pythonExe << args;
 
+    Telemetry::Scope phase("pip upgrade", "venv");
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
     QProcess proc;
     proc.start(pythonExe, args);
     proc.waitForFinished(30000);
 
     DEBUG_MSG() << "Exit code:" << proc.exitCode() << "StdErr:" << QString::fromUtf8(proc.readAllStandardError());
 
+    if (proc.exitCode() != 0)
+    {
+        phase.setFailed();
+    }
     return proc.exitCode() == 0;
 }
 
@@ -426,9 +735,15 @@ bool TerminalEngine::installPipTools(const QString &version)
         args << QString("pip-tools==%1").arg(version);
     }
 
+    Telemetry::Scope phase("pip-tools install", "venv");
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
     QProcess process;
     process.start(pythonExe, args);
     process.waitForFinished(120000); // 2 minute timeout
+    if (process.exitCode() != 0)
+    {
+        phase.setFailed();
+    }
 
     QString output = process.readAllStandardOutput();
     QString error = process.readAllStandardError();
@@ -467,6 +782,11 @@ void TerminalEngine::executeCommand(const QString &command)
  ***************************************************************/
 void TerminalEngine::stopCurrentProcess()
 {
+    cancelVenvCreation();
+    if (helperRequest != 0)
+    {
+        pythonHelper->stop(); // fails the query through onHelperReplied()
+    }
     if (currentProcess && currentProcess->state() != QProcess::NotRunning)
     {
         emit outputReceived("Terminating process...", false);
@@ -529,6 +849,9 @@ void TerminalEngine::onReadyReadStandardError()
  ***************************************************************/
 void TerminalEngine::onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
+    Telemetry::end(commandSpan, exitStatus == QProcess::NormalExit && exitCode == 0);
+    commandSpan = 0;
+    pythonHelper->stop(); // the command may have changed the venv
     if (exitStatus == QProcess::CrashExit)
     {
         emit outputReceived("Process crashed", true);
@@ -551,6 +874,8 @@ void TerminalEngine::onProcessError(QProcess::ProcessError error)
     {
     case QProcess::FailedToStart:
         errorMsg = "Failed to start process";
+        Telemetry::end(commandSpan, false); // no finished() follows
+        commandSpan = 0;
         break;
     case QProcess::Crashed:
         errorMsg = "Process crashed";
@@ -639,6 +964,10 @@ void TerminalEngine::executePipCommand(const QStringList &args)
         emit commandFinished(1, QProcess::NormalExit);
         return;
     }
+    if (startHelperQuery(args, true))
+    {
+        return;
+    }
 
     if (currentProcess)
     {
@@ -656,7 +985,184 @@ void TerminalEngine::executePipCommand(const QStringList &args)
     QStringList fullArgs;
     fullArgs << "-m" << "pip" << args;
 
-    currentProcess->start(pythonExe, fullArgs);
+    startCurrentProcess(pythonExe, fullArgs);
+}
+
+/****************************************************************
+ * @brief Starts currentProcess as a timed "terminal command" span.
+ ***************************************************************/
+void TerminalEngine::startCurrentProcess(const QString &program, const QStringList &args)
+{
+    commandSpan = Telemetry::begin("terminal command", "terminal", QJsonObject{{"command", currentCommand}});
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
+    currentProcess->start(program, args);
+}
+
+/****************************************************************
+ * @brief Routes read-only queries to the PythonHelper.
+ ***************************************************************/
+bool TerminalEngine::startHelperQuery(const QStringList &args, bool pip)
+{
+    const bool version = args == QStringList{"--version"} || args == QStringList{"-V"};
+    HelperQuery query = HelperQuery::None;
+    QString op = "version";
+    QJsonObject request;
+    if (!pip)
+    {
+        query = version ? HelperQuery::PythonVersion : HelperQuery::None;
+    }
+    else if (version)
+    {
+        query = HelperQuery::PipVersion;
+    }
+    else if (args == QStringList{"list"})
+    {
+        query = HelperQuery::PipList;
+        op = "list";
+    }
+    else if (args.size() > 1 && args.first() == "show" && !args.join(' ').contains(" -"))
+    {
+        // Names only; "pip show --files" and other options go to pip
+        query = HelperQuery::PipShow;
+        op = "show";
+        request.insert("names", QJsonArray::fromStringList(args.mid(1)));
+    }
+    if (query == HelperQuery::None)
+    {
+        return false;
+    }
+
+    pythonHelper->setPython(getPythonExecutable());
+    const int id = pythonHelper->request(op, request);
+    if (id == 0)
+    {
+        return false;
+    }
+    helperQuery = query;
+    helperRequest = id;
+    commandSpan = Telemetry::begin("terminal command", "terminal",
+                                   QJsonObject{{"command", currentCommand}, {"helper", true}});
+    return true;
+}
+
+/****************************************************************
+ * @brief Prints a PythonHelper answer the way pip or python would.
+ ***************************************************************/
+void TerminalEngine::onHelperReplied(int id, bool ok, const QJsonValue &result, const QString &error)
+{
+    if (id != helperRequest)
+    {
+        return;
+    }
+    const HelperQuery query = helperQuery;
+    helperQuery = HelperQuery::None;
+    helperRequest = 0;
+
+    QString output;
+    QString failure = ok ? QString() : error;
+    int exitCode = 0;
+    const QJsonObject version = result.toObject();
+    if (ok && query == HelperQuery::PythonVersion)
+    {
+        output = QString("Python %1\n").arg(version.value("python").toString());
+    }
+    else if (ok && query == HelperQuery::PipVersion)
+    {
+        if (version.value("pip").isString())
+        {
+            const QStringList python = version.value("python").toString().split('.');
+            output = QString("pip %1 from %2 (python %3)\n")
+                         .arg(version.value("pip").toString(), version.value("pip-location").toString(),
+                              python.mid(0, 2).join('.'));
+        }
+        else
+        {
+            failure = "No module named pip";
+        }
+    }
+    else if (ok && query == HelperQuery::PipList)
+    {
+        const QJsonArray packages = result.toArray();
+        int nameWidth = 7; // "Package"
+        int versionWidth = 7; // "Version"
+        for (int i = 0; i < packages.size(); ++i)
+        {
+            const QJsonObject package = packages.at(i).toObject();
+            nameWidth = qMax(nameWidth, int(package.value("name").toString().size()));
+            versionWidth = qMax(versionWidth, int(package.value("version").toString().size()));
+        }
+        output = QString("%1 %2\n%3 %4\n")
+                     .arg(QString("Package").leftJustified(nameWidth), QString("Version"),
+                          QString(nameWidth, '-'), QString(versionWidth, '-'));
+        for (int i = 0; i < packages.size(); ++i)
+        {
+            const QJsonObject package = packages.at(i).toObject();
+            output += QString("%1 %2\n").arg(package.value("name").toString().leftJustified(nameWidth),
+                                              package.value("version").toString());
+        }
+    }
+    else if (ok && query == HelperQuery::PipShow)
+    {
+        const QJsonArray packages = result.toArray();
+        QSet<QString> shown;
+        static const QStringList fields = {"Name", "Version", "Summary", "Home-page", "Author",
+                                           "Author-email", "License", "Location"};
+        for (int i = 0; i < packages.size(); ++i)
+        {
+            const QJsonObject package = packages.at(i).toObject();
+            if (i > 0)
+            {
+                output += "---\n";
+            }
+            for (int f = 0; f < fields.size(); ++f)
+            {
+                output += QString("%1: %2\n")
+                              .arg(fields.at(f), package.value(fields.at(f).toLower()).toString());
+            }
+            QStringList requirements;
+            const QJsonArray requireList = package.value("requires").toArray();
+            for (int r = 0; r < requireList.size(); ++r)
+            {
+                requirements << requireList.at(r).toString();
+            }
+            QStringList requiredBy;
+            const QJsonArray requiredList = package.value("required-by").toArray();
+            for (int r = 0; r < requiredList.size(); ++r)
+            {
+                requiredBy << requiredList.at(r).toString();
+            }
+            output += QString("Requires: %1\nRequired-by: %2\n")
+                          .arg(requirements.join(", "), requiredBy.join(", "));
+            shown << Requirement::normalizeName(package.value("name").toString());
+        }
+        QStringList missing;
+        const QStringList names = currentCommand.split(' ', Qt::SkipEmptyParts).mid(2);
+        for (int i = 0; i < names.size(); ++i)
+        {
+            if (!shown.contains(Requirement::normalizeName(names.at(i))))
+            {
+                missing << names.at(i);
+            }
+        }
+        if (!missing.isEmpty())
+        {
+            emit outputReceived("WARNING: Package(s) not found: " + missing.join(", "), true);
+        }
+        exitCode = packages.isEmpty() ? 1 : 0; // like pip
+    }
+
+    if (!output.isEmpty())
+    {
+        emit outputReceived(output, false);
+    }
+    if (!failure.isEmpty())
+    {
+        emit outputReceived(failure, true);
+        exitCode = 1;
+    }
+    Telemetry::end(commandSpan, exitCode == 0);
+    commandSpan = 0;
+    emit commandFinished(exitCode, QProcess::NormalExit);
 }
 
 /****************************************************************
@@ -687,7 +1193,7 @@ void TerminalEngine::executePipToolsCommand(const QString &tool, const QStringLi
     QStringList fullArgs;
     fullArgs << "-m" << "piptools" << tool << args;
 
-    currentProcess->start(pythonExe, fullArgs);
+    startCurrentProcess(pythonExe, fullArgs);
 }
 
 /****************************************************************
@@ -701,6 +1207,10 @@ void TerminalEngine::executePythonScript(const QStringList &args)
         emit commandFinished(1, QProcess::NormalExit);
         return;
     }
+    if (startHelperQuery(args, false))
+    {
+        return;
+    }
 
     if (currentProcess)
     {
@@ -715,7 +1225,7 @@ void TerminalEngine::executePythonScript(const QStringList &args)
     connect(currentProcess, &QProcess::errorOccurred, this, &TerminalEngine::onProcessError);
 
     QString pythonExe = getPythonExecutable();
-    currentProcess->start(pythonExe, args);
+    startCurrentProcess(pythonExe, args);
 }
 
 /****************************************************************
@@ -738,7 +1248,7 @@ void TerminalEngine::executeShellCommand(const QString &command)
     QString shell = getShell();
     QStringList shellArgs = getShellArgs(command);
 
-    currentProcess->start(shell, shellArgs);
+    startCurrentProcess(shell, shellArgs);
 }
 
 /****************************************************************
@@ -10,10 +10,14 @@
  * This file defines the TerminalEngine class for managing virtual
  * environments, executing commands, and handling terminal I/O.
  * Features:
- *   - Virtual environment creation and management
+ *   - Asynchronous virtual environment creation, optionally
+ *     cloned from a per-Python-version template venv
  *   - Cross-platform command execution
  *   - Real-time output streaming
- *   - Python, pip, and pip-tools command support
+ *   - Python, pip, and pip-tools command support; "pip --version",
+ *     "pip list", "pip show" and "python --version" are answered by
+ *     a PythonHelper kept running in the venv, the rest start a
+ *     process of their own
  *   - Shell command execution
  ***************************************************************/
 #ifndef TERMINALENGINE_H
@@ -26,6 +30,11 @@
 #include <QFile>
 #include <QTextStream>
 #include <QDateTime>
+#include <QFutureWatcher>
+#include <QJsonValue>
+#include <functional>
+
+class PythonHelper;
 
 /****************************************************************
  * @class TerminalEngine
@@ -45,6 +54,13 @@ public:
      ***************************************************************/
     static void setPythonCommand(const QString &versionFromSettings);
     static QStringList pythonBaseArgs();
+    static QString pythonExe();
+
+    /****************************************************************
+     * @brief Interpreter names probed when the requested version is
+     *        not found; SystemProbe warms their "--version" output.
+     ***************************************************************/
+    static QStringList pythonCandidates();
     /****************************************************************
      * @brief Sets the virtual environment path.
      * @param venvPath Absolute path to the virtual environment.
@@ -58,11 +74,52 @@ public:
     QString getVenvPath() const;
 
     /****************************************************************
-     * @brief Creates a new virtual environment.
+     * @brief Starts creating the venv at venvPath and returns at once.
+     *        Steps are reported through venvProgress(), tool output
+     *        through outputReceived(), the result through
+     *        venvCreationFinished().
+     *
+     * In template mode a pristine venv with pinned pip/pip-tools is
+     * built once per version triple under templateRoot() and then
+     * cloned (copy-on-write / hard links) to venvPath.
      * @param pythonVersion Python version to use (e.g., "3.11").
-     * @return true if successful, false otherwise.
+     * @param pipVersion pip to pin, empty for latest.
+     * @param pipToolsVersion pip-tools to pin, empty for latest.
+     * @return false if a creation is already running.
+     ***************************************************************/
+    bool createVirtualEnvironment(const QString &pythonVersion,
+                                  const QString &pipVersion = QString(),
+                                  const QString &pipToolsVersion = QString());
+
+    /****************************************************************
+     * @brief Checks whether createVirtualEnvironment() is running.
+     ***************************************************************/
+    bool isCreatingVenv() const;
+
+    /****************************************************************
+     * @brief Aborts venv creation; venvCreationFinished(false) follows.
+     ***************************************************************/
+    void cancelVenvCreation();
+
+    /****************************************************************
+     * @brief Sets where template venvs are kept.
+     * @param dir Folder holding one subfolder per version triple.
+     ***************************************************************/
+    void setTemplateRoot(const QString &dir);
+    QString templateRoot() const;
+
+    /****************************************************************
+     * @brief Enables cloning new venvs from a template venv.
      ***************************************************************/
-    bool createVirtualEnvironment(const QString &pythonVersion);
+    void setUseTemplate(bool enabled);
+    bool useTemplate() const;
+
+    /****************************************************************
+     * @brief Template venv folder for a version triple.
+     ***************************************************************/
+    QString templatePathFor(const QString &pythonVersion,
+                            const QString &pipVersion,
+                            const QString &pipToolsVersion) const;
 
     /****************************************************************
      * @brief Checks if virtual environment exists.
@@ -152,13 +209,58 @@ signals:
      ***************************************************************/
     void venvProgress(const QString &message);
 
+    /****************************************************************
+     * @brief Emitted when createVirtualEnvironment() completes.
+     * @param success true if venvPath now holds a working venv.
+     ***************************************************************/
+    void venvCreationFinished(bool success);
+
 private slots:
     void onReadyReadStandardOutput();
     void onReadyReadStandardError();
     void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
     void onProcessError(QProcess::ProcessError error);
+    void onVenvProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void onHelperReplied(int id, bool ok, const QJsonValue &result, const QString &error);
 
 private:
+    /****************************************************************
+     * @enum VenvStep
+     * @brief States of the venv creation state machine.
+     ***************************************************************/
+    enum class VenvStep
+    {
+        Idle,
+        Removing,
+        CreatingTemplate,
+        UpgradingTemplate,
+        Cloning,
+        CreatingVenv,
+        UpgradingVenv
+    };
+
+    /****************************************************************
+     * @enum HelperQuery
+     * @brief Commands PythonHelper answers in place of a process.
+     ***************************************************************/
+    enum class HelperQuery
+    {
+        None,
+        PipVersion,
+        PipList,
+        PipShow,
+        PythonVersion
+    };
+
+    void startVenvRemoval();
+    void startVenvProcess(const QString &target);
+    void startUpgradeProcess(const QString &target);
+    void startTemplateClone();
+    void runVenvProcess(const QString &program, const QStringList &args);
+    void runInBackground(VenvStep step, const std::function<QString()> &work);
+    void finishVenvCreation(bool success, const QString &message);
+    QString venvStepName() const;
+
     /****************************************************************
      * @brief Checks if a command is runnable by invoking --version.
      * @param command Interpreter command (name or absolute path).
@@ -224,6 +326,33 @@ private:
 
     QProcess *currentProcess;
     QString currentCommand;
+    qint64 commandSpan = 0;           ///< Telemetry span of currentProcess
+
+    void startCurrentProcess(const QString &program, const QStringList &args);
+
+    /****************************************************************
+     * @brief Sends a read-only query to the venv's PythonHelper.
+     * @param args pip or python arguments.
+     * @return false if the command needs a process of its own.
+     ***************************************************************/
+    bool startHelperQuery(const QStringList &args, bool pip);
+
+    PythonHelper *pythonHelper;
+    HelperQuery helperQuery = HelperQuery::None;
+    int helperRequest = 0;            ///< PythonHelper id of helperQuery
+
+    // Venv creation state machine
+    VenvStep venvStep = VenvStep::Idle;
+    QProcess *venvProcess = nullptr;
+    QFutureWatcher<QString> *venvWatcher = nullptr;
+    qint64 venvSpan = 0;              ///< Telemetry span of the running step
+    QString venvPythonVersion;
+    QString venvPipVersion;
+    QString venvPipToolsVersion;
+    QString venvTemplatePath;
+    QString venvTemplateRoot;
+    bool venvUseTemplate = true;
+    bool venvCancelled = false;
     static QString g_pythonExe;
     static QStringList g_pythonBaseArgs;
 
@@ -0,0 +1,47 @@
+/****************************************************************
+ * @file TestOutcome.h
+ * @brief Declares TestOutcome, the result of one pip-compile test.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * Shared by PipCompileRunner, ResolveCoordinator, ResolveWorker and
+ * ResolverEngine. Only Passed and Failed are pip's verdict on the
+ * pins and may be cached or learned from. Error means the test
+ * never got a verdict: a timeout, a process that did not start or
+ * crashed, an unwritable folder, an unreachable index or a broken
+ * venv. The engine asks again instead of recording it.
+ ***************************************************************/
+#pragma once
+#include <QMetaType>
+#include <QString>
+
+enum class TestOutcome
+{
+    Passed,
+    Failed,
+    Error
+};
+
+Q_DECLARE_METATYPE(TestOutcome)
+
+/****************************************************************
+ * @brief Name used in the worker protocol and logs.
+ ***************************************************************/
+inline QString testOutcomeName(TestOutcome outcome)
+{
+    switch (outcome)
+    {
+    case TestOutcome::Passed:
+        return QStringLiteral("passed");
+    case TestOutcome::Failed:
+        return QStringLiteral("failed");
+    case TestOutcome::Error:
+        break;
+    }
+    return QStringLiteral("error");
+}
+
+/************** End of TestOutcome.h ****************************/
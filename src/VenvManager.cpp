@@ -0,0 +1,373 @@
+/****************************************************************
+ * @file VenvManager.cpp
+ * @brief Implements the VenvManager helpers.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of VenvManager.
+ * A clone records where it came from in ".clone-source" so
+ * repeated resolves reuse per-worker venvs until the base venv
+ * is recreated.
+ ***************************************************************/
+#include "VenvManager.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include "Config.h"
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(Q_OS_LINUX)
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#elif defined(Q_OS_MACOS)
+#include <sys/clonefile.h>
+#endif
+
+#define SHOW_DEBUG 0
+
+static const char *kCloneMarkerFile = ".clone-source";
+static const char *kTemplateMarkerFile = ".template-ready";
+static const qint64 kMaxScriptBytes = 1024 * 1024;
+
+/****************************************************************
+ * @brief Copy-on-write clone of one file; false if unsupported.
+ ***************************************************************/
+static bool reflinkFile(const QString &source, const QString &target)
+{
+#if defined(Q_OS_LINUX)
+    const QByteArray src = QFile::encodeName(source);
+    const QByteArray dst = QFile::encodeName(target);
+    const int in = ::open(src.constData(), O_RDONLY | O_CLOEXEC);
+    if (in < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(in, &st) != 0)
+    {
+        ::close(in);
+        return false;
+    }
+    const int out = ::open(dst.constData(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, st.st_mode & 07777);
+    if (out < 0)
+    {
+        ::close(in);
+        return false;
+    }
+    const bool ok = ::ioctl(out, FICLONE, in) == 0;
+    ::close(out);
+    ::close(in);
+    if (!ok)
+    {
+        ::unlink(dst.constData());
+    }
+    return ok;
+#elif defined(Q_OS_MACOS)
+    return ::clonefile(QFile::encodeName(source).constData(),
+                       QFile::encodeName(target).constData(), CLONE_NOFOLLOW) == 0;
+#else
+    Q_UNUSED(source);
+    Q_UNUSED(target);
+    return false;
+#endif
+}
+
+/****************************************************************
+ * @brief Hard link of one file; false if unsupported (e.g. across
+ *        volumes). QFile::link() makes .lnk shortcuts on Windows,
+ *        so the native calls are used.
+ ***************************************************************/
+static bool hardlinkFile(const QString &source, const QString &target)
+{
+#if defined(Q_OS_WIN)
+    return ::CreateHardLinkW(reinterpret_cast<LPCWSTR>(QDir::toNativeSeparators(target).utf16()),
+                             reinterpret_cast<LPCWSTR>(QDir::toNativeSeparators(source).utf16()),
+                             nullptr) != 0;
+#else
+    return ::link(QFile::encodeName(source).constData(), QFile::encodeName(target).constData()) == 0;
+#endif
+}
+
+/****************************************************************
+ * @brief Gets the interpreter inside a venv.
+ ***************************************************************/
+QString VenvManager::pythonPath(const QString &venvPath)
+{
+#ifdef Q_OS_WIN
+    return QDir(venvPath).filePath("Scripts/python.exe");
+#else
+    return QDir(venvPath).filePath("bin/python3");
+#endif
+}
+
+/****************************************************************
+ * @brief Checks for pyvenv.cfg and an interpreter.
+ ***************************************************************/
+bool VenvManager::isVenv(const QString &venvPath)
+{
+    return QFileInfo::exists(QDir(venvPath).filePath("pyvenv.cfg"))
+           && QFileInfo::exists(pythonPath(venvPath));
+}
+
+/****************************************************************
+ * @brief Gets the site-packages folders of a venv.
+ ***************************************************************/
+QStringList VenvManager::sitePackagesDirs(const QString &venvPath)
+{
+    QStringList dirs;
+#ifdef Q_OS_WIN
+    const QString dir = QDir(venvPath).filePath("Lib/site-packages");
+    if (QFileInfo(dir).isDir())
+    {
+        dirs << dir;
+    }
+#else
+    const QDir lib(QDir(venvPath).filePath("lib"));
+    const QStringList pythons = lib.entryList(QStringList() << "python*", QDir::Dirs | QDir::NoDotAndDotDot);
+    for (int i = 0; i < pythons.size(); ++i)
+    {
+        const QString dir = lib.filePath(pythons.at(i) + "/site-packages");
+        if (QFileInfo(dir).isDir())
+        {
+            dirs << dir;
+        }
+    }
+#endif
+    return dirs;
+}
+
+/****************************************************************
+ * @brief Copies a venv, preserving symlinks as symlinks.
+ ***************************************************************/
+bool VenvManager::cloneVenv(const QString &source, const QString &target, QString *error,
+                            CloneMode mode)
+{
+    if (!isVenv(source))
+    {
+        if (error)
+        {
+            *error = QString("Not a virtual environment: %1").arg(source);
+        }
+        return false;
+    }
+    if (isCloneCurrent(source, target))
+    {
+        return true;
+    }
+
+    QDir targetDir(target);
+    if (targetDir.exists() && !targetDir.removeRecursively())
+    {
+        if (error)
+        {
+            *error = QString("Cannot remove stale clone: %1").arg(target);
+        }
+        return false;
+    }
+    if (!copyTree(source, target, error, mode) || !relocateScripts(source, target, error))
+    {
+        return false;
+    }
+
+    QFile marker(QDir(target).filePath(kCloneMarkerFile));
+    if (!marker.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        if (error)
+        {
+            *error = QString("Cannot write %1").arg(marker.fileName());
+        }
+        return false;
+    }
+    marker.write(cloneMarker(source).toUtf8());
+    return true;
+}
+
+/****************************************************************
+ * @brief Checks whether target was cloned from the current source.
+ ***************************************************************/
+bool VenvManager::isCloneCurrent(const QString &source, const QString &target)
+{
+    QFile marker(QDir(target).filePath(kCloneMarkerFile));
+    if (!isVenv(target) || !marker.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    return QString::fromUtf8(marker.readAll()) == cloneMarker(source);
+}
+
+/****************************************************************
+ * @brief Checks whether a template venv finished building.
+ ***************************************************************/
+bool VenvManager::isTemplateReady(const QString &templatePath)
+{
+    return isVenv(templatePath) && QFileInfo::exists(QDir(templatePath).filePath(kTemplateMarkerFile));
+}
+
+/****************************************************************
+ * @brief Marks a template venv as complete.
+ ***************************************************************/
+bool VenvManager::markTemplateReady(const QString &templatePath, const QString &description)
+{
+    QSaveFile marker(QDir(templatePath).filePath(kTemplateMarkerFile));
+    if (!marker.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    marker.write(description.toUtf8());
+    return marker.commit();
+}
+
+/****************************************************************
+ * @brief Identifies a base venv: its path plus when it was created.
+ ***************************************************************/
+QString VenvManager::cloneMarker(const QString &source)
+{
+    const QFileInfo cfg(QDir(source).filePath("pyvenv.cfg"));
+    return QString("%1\n%2").arg(QDir(source).absolutePath())
+        .arg(cfg.lastModified().toMSecsSinceEpoch());
+}
+
+/****************************************************************
+ * @brief Recursively copies a folder; symlinks stay symlinks so
+ *        bin/python keeps pointing at the base interpreter. In Fast
+ *        mode the first failed reflink (or hard link) switches that
+ *        method off for the rest of the tree.
+ ***************************************************************/
+bool VenvManager::copyTree(const QString &source, const QString &target, QString *error,
+                           CloneMode mode)
+{
+    bool tryReflink = mode == CloneMode::Fast;
+    bool tryHardlink = mode == CloneMode::Fast;
+
+    const QDir sourceDir(source);
+    if (!QDir().mkpath(target))
+    {
+        if (error)
+        {
+            *error = QString("Cannot create %1").arg(target);
+        }
+        return false;
+    }
+
+    QDirIterator it(source,
+                    QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        it.next();
+        const QFileInfo info = it.fileInfo();
+        const QString relative = sourceDir.relativeFilePath(info.filePath());
+        if (relative == kCloneMarkerFile || relative == kTemplateMarkerFile)
+        {
+            continue;
+        }
+        const QString destination = QDir(target).filePath(relative);
+
+        bool ok = true;
+        if (info.isSymLink())
+        {
+            ok = QFile::link(info.readSymLink(), destination);
+        }
+        else if (info.isDir())
+        {
+            ok = QDir().mkpath(destination);
+        }
+        else
+        {
+            ok = false;
+            if (tryReflink)
+            {
+                ok = reflinkFile(info.filePath(), destination);
+                tryReflink = ok;
+            }
+            if (!ok && tryHardlink)
+            {
+                ok = hardlinkFile(info.filePath(), destination);
+                tryHardlink = ok;
+            }
+            if (!ok)
+            {
+                ok = QFile::copy(info.filePath(), destination);
+            }
+        }
+        if (!ok)
+        {
+            if (error)
+            {
+                *error = QString("Cannot copy %1").arg(info.filePath());
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+/****************************************************************
+ * @brief Rewrites the source path in scripts and pyvenv.cfg.
+ *        Files are replaced (QSaveFile), never edited in place, so
+ *        a hard-linked source is left untouched. Binary launchers
+ *        (anything with a NUL byte) are skipped.
+ ***************************************************************/
+bool VenvManager::relocateScripts(const QString &source, const QString &target, QString *error)
+{
+    const QByteArray from = QDir(source).absolutePath().toUtf8();
+    const QByteArray to = QDir(target).absolutePath().toUtf8();
+    if (from == to)
+    {
+        return true;
+    }
+
+#ifdef Q_OS_WIN
+    const QString scriptsDir = QDir(target).filePath("Scripts");
+#else
+    const QString scriptsDir = QDir(target).filePath("bin");
+#endif
+    QStringList files;
+    files << QDir(target).filePath("pyvenv.cfg");
+    const QFileInfoList scripts = QDir(scriptsDir).entryInfoList(QDir::Files | QDir::NoSymLinks);
+    for (int i = 0; i < scripts.size(); ++i)
+    {
+        files << scripts.at(i).filePath();
+    }
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        QFile in(files.at(i));
+        if (in.size() > kMaxScriptBytes || !in.open(QIODevice::ReadOnly))
+        {
+            continue;
+        }
+        QByteArray content = in.readAll();
+        in.close();
+        if (content.contains('\0') || !content.contains(from))
+        {
+            continue;
+        }
+        content.replace(from, to);
+
+        QSaveFile out(files.at(i));
+        if (!out.open(QIODevice::WriteOnly) || out.write(content) != content.size() || !out.commit())
+        {
+            if (error)
+            {
+                *error = QString("Cannot relocate %1").arg(files.at(i));
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+/************** End of VenvManager.cpp **************************/
@@ -0,0 +1,110 @@
+/****************************************************************
+ * @file VenvManager.h
+ * @brief Declares the VenvManager helpers for scratch venvs.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines VenvManager, a set of static helpers used by
+ * the resolver to locate venv interpreters and to clone a base
+ * venv (venv_testing or a template venv) into isolated copies.
+ * Clones are copy-on-write where the filesystem supports it
+ * (reflink on Linux btrfs/XFS, clonefile on APFS), hard links
+ * otherwise, and plain copies as a last resort.
+ * Functions are thread-safe and may run from QtConcurrent.
+ ***************************************************************/
+#ifndef VENVMANAGER_H
+#define VENVMANAGER_H
+
+#include <QString>
+#include <QStringList>
+
+/****************************************************************
+ * @class VenvManager
+ * @brief Static venv path and cloning helpers.
+ ***************************************************************/
+class VenvManager
+{
+public:
+    /****************************************************************
+     * @enum CloneMode
+     * @brief How file contents are duplicated.
+     ***************************************************************/
+    enum class CloneMode
+    {
+        Copy, ///< independent byte copies
+        Fast  ///< reflink, else hard link, else copy; per file
+    };
+
+    /****************************************************************
+     * @brief Gets the interpreter inside a venv.
+     * @param venvPath Root folder of the venv.
+     * @return Scripts/python.exe on Windows, bin/python3 elsewhere.
+     ***************************************************************/
+    static QString pythonPath(const QString &venvPath);
+
+    /****************************************************************
+     * @brief Checks for pyvenv.cfg and an interpreter.
+     * @param venvPath Root folder of the venv.
+     * @return true if the folder looks like a usable venv.
+     ***************************************************************/
+    static bool isVenv(const QString &venvPath);
+
+    /****************************************************************
+     * @brief Gets the site-packages folders of a venv.
+     * @param venvPath Root folder of the venv.
+     * @return Lib/site-packages on Windows, lib/python3.X/site-packages
+     *         (every X present) elsewhere; only existing folders.
+     ***************************************************************/
+    static QStringList sitePackagesDirs(const QString &venvPath);
+
+    /****************************************************************
+     * @brief Clones a venv, preserving symlinks as symlinks. Text
+     *        files in bin/ (Scripts/) and pyvenv.cfg that name the
+     *        source path are rewritten for the new location.
+     *        An up-to-date clone (see isCloneCurrent) is kept.
+     * @param source Venv to copy.
+     * @param target Destination folder; replaced if stale.
+     * @param error Optional error description on failure.
+     * @param mode Copy, or Fast for copy-on-write / hard links.
+     *        Fast clones must be treated as read-only except
+     *        through pip, which replaces files instead of
+     *        editing them in place.
+     * @return true if target is a usable clone of source.
+     ***************************************************************/
+    static bool cloneVenv(const QString &source, const QString &target, QString *error = nullptr,
+                          CloneMode mode = CloneMode::Copy);
+
+    /****************************************************************
+     * @brief Checks whether target was cloned from the current source.
+     * @param source Venv that was copied.
+     * @param target Previously cloned folder.
+     * @return true if the clone marker matches the source.
+     ***************************************************************/
+    static bool isCloneCurrent(const QString &source, const QString &target);
+
+    /****************************************************************
+     * @brief Checks whether a template venv finished building.
+     * @param templatePath Root folder of the template venv.
+     ***************************************************************/
+    static bool isTemplateReady(const QString &templatePath);
+
+    /****************************************************************
+     * @brief Marks a template venv as complete.
+     * @param templatePath Root folder of the template venv.
+     * @param description What the template pins, for humans.
+     * @return true if the marker was written.
+     ***************************************************************/
+    static bool markTemplateReady(const QString &templatePath, const QString &description);
+
+private:
+    static QString cloneMarker(const QString &source);
+    static bool copyTree(const QString &source, const QString &target, QString *error,
+                         CloneMode mode);
+    static bool relocateScripts(const QString &source, const QString &target, QString *error);
+};
+
+#endif // VENVMANAGER_H
+/************** End of VenvManager.h ****************************/
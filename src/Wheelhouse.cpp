@@ -0,0 +1,764 @@
+/****************************************************************
+ * @file Wheelhouse.cpp
+ * @brief Implements the Wheelhouse class.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file contains the implementation of Wheelhouse.
+ * Layout of the wheelhouse directory:
+ *   index.json                 wheels, sizes, last use and pins
+ *   links.html                 --find-links page for pip
+ *   blobs/<sha256>/<file>.whl  one stored wheel
+ *   staging/<n>/               output of one running "pip wheel"
+ ***************************************************************/
+#include "Wheelhouse.h"
+#include "Telemetry.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSet>
+#include <QUrl>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <QDebug>
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static const int kIndexFormat = 1;
+static const int kSaveDelayMs = 2000;
+
+/****************************************************************
+ * @brief Constructor: Initializes an empty, unopened wheelhouse.
+ ***************************************************************/
+Wheelhouse::Wheelhouse(QObject *parent) : QObject(parent)
+{
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(kSaveDelayMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, [this]() { save(); });
+    m_throttleTimer.setSingleShot(true);
+    connect(&m_throttleTimer, &QTimer::timeout, this, [this]() { startNext(); });
+}
+
+/****************************************************************
+ * @brief Destructor: Kills prefetches and flushes the index.
+ ***************************************************************/
+Wheelhouse::~Wheelhouse()
+{
+    cancel();
+    save();
+}
+
+/****************************************************************
+ * @brief Loads the index of a wheelhouse directory.
+ ***************************************************************/
+bool Wheelhouse::open(const QString &dir)
+{
+    if (dir == m_dir)
+    {
+        return true;
+    }
+    cancel();
+    save();
+    m_dir = dir;
+    m_wheels.clear();
+    m_pins.clear();
+    m_totalSize = 0;
+    m_linksDirty = true;
+    QDir().mkpath(QDir(m_dir).filePath("blobs"));
+    QDir(QDir(m_dir).filePath("staging")).removeRecursively();
+
+    QFile file(QDir(m_dir).filePath("index.json"));
+    if (!file.exists())
+    {
+        return writeLinks();
+    }
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Cannot read wheelhouse index" << file.fileName();
+        return false;
+    }
+    QJsonParseError error;
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll(), &error).object();
+    if (error.error != QJsonParseError::NoError || root.value("format").toInt() != kIndexFormat)
+    {
+        qWarning() << "Ignoring unreadable wheelhouse index" << file.fileName();
+        writeLinks();
+        return false;
+    }
+
+    // Blobs deleted behind our back are dropped from the index
+    const QJsonObject wheels = root.value("wheels").toObject();
+    for (auto it = wheels.constBegin(); it != wheels.constEnd(); ++it)
+    {
+        const QJsonObject value = it.value().toObject();
+        Wheel wheel;
+        wheel.fileName = value.value("file").toString();
+        wheel.size = value.value("size").toInteger();
+        wheel.lastUsed = value.value("used").toInteger();
+        if (!QFileInfo::exists(QDir(blobDir(it.key())).filePath(wheel.fileName)))
+        {
+            m_dirty = true;
+            continue;
+        }
+        m_wheels.insert(it.key(), wheel);
+        m_totalSize += wheel.size;
+    }
+    const QJsonObject pins = root.value("pins").toObject();
+    for (auto it = pins.constBegin(); it != pins.constEnd(); ++it)
+    {
+        QStringList hashes;
+        bool intact = true;
+        const QJsonArray array = it.value().toArray();
+        for (int i = 0; i < array.size(); ++i)
+        {
+            hashes << array.at(i).toString();
+            intact = intact && m_wheels.contains(hashes.last());
+        }
+        if (intact)
+        {
+            m_pins.insert(it.key(), hashes);
+        }
+        else
+        {
+            m_dirty = true;
+        }
+    }
+    DEBUG_MSG() << "Wheelhouse" << m_dir << m_wheels.size() << "wheels" << m_pins.size() << "pins";
+    return writeLinks();
+}
+
+QString Wheelhouse::findLinks() const
+{
+    return QDir(m_dir).filePath("links.html");
+}
+
+/****************************************************************
+ * @brief Sets the size limit; evicts right away if exceeded.
+ ***************************************************************/
+void Wheelhouse::setSizeLimit(qint64 bytes)
+{
+    m_sizeLimit = qMax<qint64>(0, bytes);
+    if (!m_running)
+    {
+        evict();
+        writeLinks();
+    }
+}
+
+qint64 Wheelhouse::sizeLimit() const
+{
+    return m_sizeLimit;
+}
+
+qint64 Wheelhouse::totalSize() const
+{
+    return m_totalSize;
+}
+
+int Wheelhouse::wheelCount() const
+{
+    return m_wheels.size();
+}
+
+/****************************************************************
+ * @brief Queues "pip wheel" for every pin not stored yet.
+ ***************************************************************/
+void Wheelhouse::prefetch(const QStringList &pins, const QString &environment,
+                          const QString &pythonExe, int parallel)
+{
+    cancel();
+    m_environment = environment;
+    m_pythonExe = pythonExe;
+    m_parallel = qMax(1, parallel);
+    m_running = true;
+    m_total = 0;
+    m_done = 0;
+    m_failed = 0;
+    m_skipped = 0;
+    m_batchStart = QDateTime::currentMSecsSinceEpoch();
+
+    for (int i = 0; i < pins.size(); ++i)
+    {
+        const QString pin = pins.at(i).trimmed();
+        if (pin.isEmpty() || m_queue.contains(pin))
+        {
+            continue;
+        }
+        ++m_total;
+        // Only exact pins identify a wheel set worth keeping
+        if (!pin.contains("==") || pin.contains(';') || pin.contains('*'))
+        {
+            ++m_skipped;
+            ++m_done;
+            continue;
+        }
+        const auto it = m_pins.constFind(pinKey(pin));
+        if (it != m_pins.constEnd())
+        {
+            touch(it.value(), m_batchStart);
+            ++m_done;
+            Telemetry::add(Telemetry::Counter::CacheHits);
+            continue;
+        }
+        m_queue.append(pin);
+    }
+
+    emit logMessage(tr("Wheelhouse: %1 of %2 pins stored, fetching %3")
+                        .arg(m_done - m_skipped)
+                        .arg(m_total)
+                        .arg(m_queue.size()));
+    emit progressChanged(m_done, m_total);
+
+    // Always finish asynchronously so callers see a uniform flow
+    const int generation = m_generation;
+    QTimer::singleShot(0, this, [this, generation]()
+                       {
+                           if (generation == m_generation)
+                           {
+                               startNext();
+                           }
+                       });
+}
+
+/****************************************************************
+ * @brief Kills running prefetches; no signal is emitted.
+ ***************************************************************/
+void Wheelhouse::cancel()
+{
+    ++m_generation;
+    m_queue.clear();
+    for (int i = 0; i < m_jobs.size(); ++i)
+    {
+        Job *job = m_jobs.at(i);
+        job->process->disconnect(this);
+        if (job->process->state() != QProcess::NotRunning)
+        {
+            job->process->kill();
+            job->process->waitForFinished(2000);
+        }
+        job->process->deleteLater();
+        QDir(job->stagingDir).removeRecursively();
+        Telemetry::end(job->span, false);
+        delete job;
+    }
+    m_jobs.clear();
+    m_ingesting = 0;
+    m_running = false;
+    m_ahead = false;
+    m_throttleTimer.stop();
+}
+
+bool Wheelhouse::isPrefetching() const
+{
+    return m_running;
+}
+
+/****************************************************************
+ * @brief Queues the pins of upcoming combinations behind the jobs
+ *        already running.
+ ***************************************************************/
+void Wheelhouse::prefetchAhead(const QStringList &pins, const QString &environment,
+                               const QString &pythonExe, int parallel)
+{
+    if (m_running)
+    {
+        return; // prefetch() stores every candidate anyway
+    }
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (!m_ahead)
+    {
+        m_ahead = true;
+        m_aheadStart = now;
+        m_aheadBytes = 0;
+        m_aheadFull = false;
+        m_aheadFailed.clear();
+        m_batchStart = now;
+    }
+    m_environment = environment;
+    m_pythonExe = pythonExe;
+    m_parallel = qMax(1, parallel);
+
+    m_queue.clear();
+    for (int i = 0; i < pins.size(); ++i)
+    {
+        const QString pin = pins.at(i).trimmed();
+        if (pin.isEmpty() || !pin.contains("==") || pin.contains(';') || pin.contains('*')
+            || m_queue.contains(pin) || m_aheadFailed.contains(pin))
+        {
+            continue;
+        }
+        const auto it = m_pins.constFind(pinKey(pin));
+        if (it != m_pins.constEnd())
+        {
+            touch(it.value(), now);
+            continue;
+        }
+        bool running = false;
+        for (int j = 0; j < m_jobs.size() && !running; ++j)
+        {
+            running = m_jobs.at(j)->pin == pin;
+        }
+        if (!running)
+        {
+            m_queue.append(pin);
+        }
+    }
+    DEBUG_MSG() << "prefetch ahead" << m_queue;
+    startNext();
+}
+
+bool Wheelhouse::isPrefetchingAhead() const
+{
+    return m_ahead && (!m_jobs.isEmpty() || !m_queue.isEmpty() || m_ingesting > 0);
+}
+
+void Wheelhouse::setRateLimit(qint64 bytesPerSecond)
+{
+    m_rateLimit = qMax<qint64>(0, bytesPerSecond);
+}
+
+qint64 Wheelhouse::rateLimit() const
+{
+    return m_rateLimit;
+}
+
+/****************************************************************
+ * @brief Removes every stored wheel.
+ ***************************************************************/
+void Wheelhouse::clear()
+{
+    cancel();
+    QDir(QDir(m_dir).filePath("blobs")).removeRecursively();
+    QDir().mkpath(QDir(m_dir).filePath("blobs"));
+    m_wheels.clear();
+    m_pins.clear();
+    m_totalSize = 0;
+    m_linksDirty = true;
+    writeLinks();
+    markDirty();
+}
+
+/****************************************************************
+ * @brief Writes pending index changes atomically.
+ ***************************************************************/
+bool Wheelhouse::save()
+{
+    m_saveTimer.stop();
+    if (!m_dirty || m_dir.isEmpty())
+    {
+        return true;
+    }
+
+    QJsonObject wheels;
+    for (auto it = m_wheels.constBegin(); it != m_wheels.constEnd(); ++it)
+    {
+        QJsonObject value;
+        value.insert("file", it.value().fileName);
+        value.insert("size", it.value().size);
+        value.insert("used", it.value().lastUsed);
+        wheels.insert(it.key(), value);
+    }
+    QJsonObject pins;
+    for (auto it = m_pins.constBegin(); it != m_pins.constEnd(); ++it)
+    {
+        pins.insert(it.key(), QJsonArray::fromStringList(it.value()));
+    }
+    QJsonObject root;
+    root.insert("format", kIndexFormat);
+    root.insert("wheels", wheels);
+    root.insert("pins", pins);
+
+    QSaveFile file(QDir(m_dir).filePath("index.json"));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "Cannot write wheelhouse index" << file.fileName();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit())
+    {
+        qWarning() << "Cannot commit wheelhouse index" << file.fileName();
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+/****************************************************************
+ * @brief Hashes the wheels of a staging directory and moves each
+ *        into blobs/ unless that content is already stored. Runs
+ *        on the thread pool; touches no member state.
+ ***************************************************************/
+Wheelhouse::Staged Wheelhouse::storeStaged(const QString &stagingDir, const QString &blobsRoot)
+{
+    Staged staged;
+    const QFileInfoList files = QDir(stagingDir).entryInfoList(QStringList() << "*.whl", QDir::Files);
+    for (int i = 0; i < files.size(); ++i)
+    {
+        const QFileInfo info = files.at(i);
+        QFile file(info.absoluteFilePath());
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            continue;
+        }
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        hash.addData(&file);
+        file.close();
+
+        const QString sha = QString::fromLatin1(hash.result().toHex());
+        const QString dir = QDir(blobsRoot).filePath(sha);
+        const QString target = QDir(dir).filePath(info.fileName());
+        if (!QFileInfo::exists(target))
+        {
+            QDir().mkpath(dir);
+            if (!QFile::rename(info.absoluteFilePath(), target)
+                && !QFile::copy(info.absoluteFilePath(), target))
+            {
+                continue;
+            }
+        }
+        Wheel wheel;
+        wheel.fileName = info.fileName();
+        wheel.size = info.size();
+        staged.hashes << sha;
+        staged.wheels << wheel;
+    }
+    QDir(stagingDir).removeRecursively();
+    return staged;
+}
+
+/****************************************************************
+ * @brief Fills free slots from the queue; finishes when drained.
+ ***************************************************************/
+void Wheelhouse::startNext()
+{
+    while (m_jobs.size() < m_parallel && !m_queue.isEmpty() && (m_running || canStartAhead()))
+    {
+        startJob(m_queue.takeFirst());
+    }
+    if (m_running && m_jobs.isEmpty() && m_queue.isEmpty() && m_ingesting == 0)
+    {
+        finishBatch();
+    }
+}
+
+/****************************************************************
+ * @brief Applies the caps of prefetchAhead(). Over the rate the
+ *        throttle timer retries once the budget allows a job.
+ ***************************************************************/
+bool Wheelhouse::canStartAhead()
+{
+    if (m_sizeLimit > 0 && m_totalSize >= m_sizeLimit)
+    {
+        // Evicting could pull wheels from under a running compile
+        if (!m_aheadFull)
+        {
+            m_aheadFull = true;
+            emit logMessage(tr("Wheelhouse: size limit reached, no longer fetching ahead"));
+        }
+        m_queue.clear();
+        return false;
+    }
+    if (m_rateLimit <= 0)
+    {
+        return true;
+    }
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 due = m_aheadStart + m_aheadBytes * 1000 / m_rateLimit;
+    if (now >= due)
+    {
+        return true;
+    }
+    if (!m_throttleTimer.isActive())
+    {
+        m_throttleTimer.start(int(qMin<qint64>(due - now, 60 * 1000)));
+    }
+    return false;
+}
+
+/****************************************************************
+ * @brief Runs "pip wheel" for one pin into its own staging dir.
+ *        Wheels already stored are offered through --find-links
+ *        so pip copies instead of downloading them again.
+ ***************************************************************/
+void Wheelhouse::startJob(const QString &pin)
+{
+    Job *job = new Job;
+    job->pin = pin;
+    job->stagingDir = QDir(m_dir).filePath(QString("staging/%1").arg(m_nextStaging++));
+    QDir(job->stagingDir).removeRecursively();
+    QDir().mkpath(job->stagingDir);
+    m_jobs.append(job);
+
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert("PIP_DISABLE_PIP_VERSION_CHECK", "1");
+    env.remove("PYTHONHOME");
+
+    job->process = new QProcess(this);
+    job->process->setProcessChannelMode(QProcess::MergedChannels);
+    job->process->setProcessEnvironment(env);
+    connect(job->process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, [this, job](int exitCode, QProcess::ExitStatus exitStatus)
+            {
+                finishJob(job, exitStatus == QProcess::NormalExit && exitCode == 0);
+            });
+    connect(job->process, &QProcess::errorOccurred, this, [this, job](QProcess::ProcessError error)
+            {
+                if (error == QProcess::FailedToStart)
+                {
+                    finishJob(job, false);
+                }
+            });
+
+    QStringList args;
+    args << "-m" << "pip" << "wheel" << "--quiet" << "--progress-bar" << "off"
+         << "--wheel-dir" << job->stagingDir
+         << "--find-links" << findLinks()
+         << pin;
+    DEBUG_MSG() << "wheelhouse" << m_pythonExe << args;
+    job->span = Telemetry::begin("pip wheel", "wheelhouse", QJsonObject{{"pin", pin}});
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
+    job->process->start(m_pythonExe, args);
+}
+
+/****************************************************************
+ * @brief Ends one job; successful output is hashed off-thread.
+ ***************************************************************/
+void Wheelhouse::finishJob(Job *job, bool ok)
+{
+    m_jobs.removeOne(job);
+    Telemetry::end(job->span, ok);
+    const QString pin = job->pin;
+    const QString stagingDir = job->stagingDir;
+    const QString output = QString::fromUtf8(job->process->readAll()).trimmed();
+    job->process->disconnect(this);
+    job->process->deleteLater();
+    delete job;
+
+    if (!ok)
+    {
+        ++m_failed;
+        ++m_done;
+        const QStringList lines = output.split('\n');
+        emit logMessage(tr("Wheelhouse: %1 failed: %2")
+                            .arg(pin, lines.isEmpty() ? tr("pip wheel error") : lines.last().trimmed()));
+        if (m_ahead)
+        {
+            m_aheadFailed.insert(pin);
+        }
+        else
+        {
+            emit progressChanged(m_done, m_total);
+        }
+        QDir(stagingDir).removeRecursively();
+        startNext();
+        return;
+    }
+
+    ++m_ingesting;
+    const int generation = m_generation;
+    const QString blobsRoot = QDir(m_dir).filePath("blobs");
+    QFutureWatcher<Staged> *watcher = new QFutureWatcher<Staged>(this);
+    connect(watcher, &QFutureWatcher<Staged>::finished, this, [this, watcher, pin, generation]()
+            {
+                watcher->deleteLater();
+                // Blobs are on disk either way, so index them even after a cancel
+                const qint64 before = m_totalSize;
+                ingest(pin, watcher->result());
+                if (generation != m_generation)
+                {
+                    return;
+                }
+                --m_ingesting;
+                ++m_done;
+                if (m_ahead)
+                {
+                    // The next compile picks the new wheels up
+                    m_aheadBytes += m_totalSize - before;
+                    writeLinks();
+                }
+                else
+                {
+                    emit progressChanged(m_done, m_total);
+                }
+                startNext();
+            });
+    watcher->setFuture(QtConcurrent::run(&Wheelhouse::storeStaged, stagingDir, blobsRoot));
+}
+
+/****************************************************************
+ * @brief Evicts over the limit, publishes links.html and reports.
+ ***************************************************************/
+void Wheelhouse::finishBatch()
+{
+    m_running = false;
+    evict();
+    writeLinks();
+    save();
+
+    const bool complete = m_failed == 0 && m_skipped == 0;
+    emit logMessage(tr("Wheelhouse: %1 wheels, %2 MB%3")
+                        .arg(m_wheels.size())
+                        .arg(m_totalSize / (1024 * 1024))
+                        .arg(complete ? QString() : tr(", %1 pins not stored").arg(m_failed + m_skipped)));
+    emit prefetchFinished(complete);
+}
+
+/****************************************************************
+ * @brief Indexes the wheels one pin needs.
+ ***************************************************************/
+void Wheelhouse::ingest(const QString &pin, const Staged &staged)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < staged.hashes.size(); ++i)
+    {
+        const QString &hash = staged.hashes.at(i);
+        if (!m_wheels.contains(hash))
+        {
+            m_wheels.insert(hash, staged.wheels.at(i));
+            m_totalSize += staged.wheels.at(i).size;
+            m_linksDirty = true;
+        }
+        m_wheels[hash].lastUsed = now;
+    }
+    m_pins.insert(pinKey(pin), staged.hashes);
+    markDirty();
+}
+
+void Wheelhouse::touch(const QStringList &hashes, qint64 now)
+{
+    for (int i = 0; i < hashes.size(); ++i)
+    {
+        auto it = m_wheels.find(hashes.at(i));
+        if (it != m_wheels.end())
+        {
+            it.value().lastUsed = now;
+        }
+    }
+    markDirty();
+}
+
+/****************************************************************
+ * @brief Drops least recently used wheels until under the limit.
+ *        Wheels used by the latest prefetch are kept, since a
+ *        resolve may be installing from them right now.
+ ***************************************************************/
+void Wheelhouse::evict()
+{
+    if (m_sizeLimit <= 0 || m_totalSize <= m_sizeLimit)
+    {
+        return;
+    }
+    QStringList hashes = m_wheels.keys();
+    std::sort(hashes.begin(), hashes.end(), [this](const QString &a, const QString &b)
+              {
+                  return m_wheels.value(a).lastUsed < m_wheels.value(b).lastUsed;
+              });
+
+    QSet<QString> evicted;
+    for (int i = 0; i < hashes.size() && m_totalSize > m_sizeLimit; ++i)
+    {
+        const Wheel wheel = m_wheels.value(hashes.at(i));
+        if (wheel.lastUsed >= m_batchStart)
+        {
+            break;
+        }
+        QDir(blobDir(hashes.at(i))).removeRecursively();
+        m_totalSize -= wheel.size;
+        m_wheels.remove(hashes.at(i));
+        evicted.insert(hashes.at(i));
+    }
+    if (evicted.isEmpty())
+    {
+        return;
+    }
+
+    // A pin missing any of its wheels has to be fetched again
+    for (auto it = m_pins.begin(); it != m_pins.end();)
+    {
+        bool intact = true;
+        for (int i = 0; i < it.value().size() && intact; ++i)
+        {
+            intact = !evicted.contains(it.value().at(i));
+        }
+        it = intact ? std::next(it) : m_pins.erase(it);
+    }
+    m_linksDirty = true;
+    markDirty();
+    emit logMessage(tr("Wheelhouse: evicted %1 least recently used wheels").arg(evicted.size()));
+}
+
+/****************************************************************
+ * @brief Rewrites links.html from the index.
+ ***************************************************************/
+bool Wheelhouse::writeLinks()
+{
+    if (!m_linksDirty || m_dir.isEmpty())
+    {
+        return true;
+    }
+    QStringList hashes = m_wheels.keys();
+    hashes.sort();
+
+    QByteArray html("<!DOCTYPE html>\n<html><body>\n");
+    for (int i = 0; i < hashes.size(); ++i)
+    {
+        const QString &hash = hashes.at(i);
+        const QString fileName = m_wheels.value(hash).fileName;
+        const QUrl url = QUrl::fromLocalFile(QDir(blobDir(hash)).filePath(fileName));
+        html += QString("<a href=\"%1#sha256=%2\">%3</a><br/>\n")
+                    .arg(QString::fromUtf8(url.toEncoded()), hash, fileName.toHtmlEscaped())
+                    .toUtf8();
+    }
+    html += "</body></html>\n";
+
+    QSaveFile file(findLinks());
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "Cannot write" << file.fileName();
+        return false;
+    }
+    file.write(html);
+    if (!file.commit())
+    {
+        qWarning() << "Cannot commit" << file.fileName();
+        return false;
+    }
+    m_linksDirty = false;
+    return true;
+}
+
+/****************************************************************
+ * @brief Schedules a save so bursts of changes cost one write.
+ ***************************************************************/
+void Wheelhouse::markDirty()
+{
+    m_dirty = true;
+    if (!m_saveTimer.isActive())
+    {
+        m_saveTimer.start();
+    }
+}
+
+QString Wheelhouse::pinKey(const QString &pin) const
+{
+    return m_environment + '|' + pin.toLower().remove(' ');
+}
+
+QString Wheelhouse::blobDir(const QString &hash) const
+{
+    return QDir(QDir(m_dir).filePath("blobs")).filePath(hash);
+}
+
+/************** End of Wheelhouse.cpp ***************************/
@@ -0,0 +1,224 @@
+/****************************************************************
+ * @file Wheelhouse.h
+ * @brief Declares the Wheelhouse class, a shared local wheel store.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * This file defines the Wheelhouse class. Before a resolve it runs
+ * "pip wheel" once for every candidate pin that is not stored yet,
+ * several at a time, and keeps the resulting wheels (including
+ * dependencies and wheels built from sdists) under the cache dir.
+ *
+ * Wheels are content addressed: each is stored once as
+ * blobs/<sha256>/<filename>, no matter how many pins pulled it in.
+ * links.html lists every blob with its #sha256= fragment and is
+ * what pip gets as --find-links, so pip also verifies the hashes.
+ * When the store outgrows its size limit the least recently used
+ * wheels are evicted, together with the pins that referenced them.
+ *
+ * prefetchAhead() is the pipelined alternative to prefetch(): the
+ * search starts right away and the wheelhouse fetches the pins of
+ * the combinations it will try next, so downloads overlap compiles.
+ * It is capped by its own job count, an average download rate and
+ * the size limit, and never evicts while compiles may be reading.
+ ***************************************************************/
+#ifndef WHEELHOUSE_H
+#define WHEELHOUSE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QProcess>
+#include <QTimer>
+
+/****************************************************************
+ * @class Wheelhouse
+ * @brief Content-addressed wheel cache with parallel prefetch.
+ ***************************************************************/
+class Wheelhouse : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit Wheelhouse(QObject *parent = nullptr);
+    ~Wheelhouse();
+
+    /****************************************************************
+     * @brief Loads the index of a wheelhouse directory.
+     * @param dir Directory, created on demand.
+     * @return true if an index was read or none existed.
+     ***************************************************************/
+    bool open(const QString &dir);
+
+    /****************************************************************
+     * @brief Path to hand pip as --find-links.
+     ***************************************************************/
+    QString findLinks() const;
+
+    /****************************************************************
+     * @brief Sets the size limit; evicts right away if exceeded.
+     * @param bytes Limit, 0 for unlimited.
+     ***************************************************************/
+    void setSizeLimit(qint64 bytes);
+    qint64 sizeLimit() const;
+
+    qint64 totalSize() const;
+    int wheelCount() const;
+
+    /****************************************************************
+     * @brief Downloads or builds wheels for every pin not stored yet.
+     *        Ends with prefetchFinished().
+     * @param pins "name==version" lines; other lines are skipped
+     *        and make the prefetch incomplete.
+     * @param environment Key of the target interpreter; pins are
+     *        only shared between runs with the same key.
+     * @param pythonExe Interpreter whose pip runs "pip wheel".
+     * @param parallel Concurrent pip processes (minimum 1).
+     ***************************************************************/
+    void prefetch(const QStringList &pins, const QString &environment,
+                  const QString &pythonExe, int parallel);
+
+    /****************************************************************
+     * @brief Kills running prefetches; no signal is emitted.
+     ***************************************************************/
+    void cancel();
+
+    bool isPrefetching() const;
+
+    /****************************************************************
+     * @brief Fetches wheels for pins a running search will need
+     *        soon. Pins still queued from the previous call are
+     *        replaced; running jobs finish. links.html is updated
+     *        after every pin and no prefetchFinished() is emitted.
+     *        Pins that failed once are not retried until cancel().
+     *        Ignored while prefetch() runs.
+     * @param pins "name==version" lines, most urgent first.
+     * @param environment Key of the target interpreter.
+     * @param pythonExe Interpreter whose pip runs "pip wheel".
+     * @param parallel Concurrent pip processes (minimum 1).
+     ***************************************************************/
+    void prefetchAhead(const QStringList &pins, const QString &environment,
+                       const QString &pythonExe, int parallel);
+
+    /****************************************************************
+     * @brief true while prefetchAhead() has jobs or queued pins.
+     ***************************************************************/
+    bool isPrefetchingAhead() const;
+
+    /****************************************************************
+     * @brief Caps the average rate of prefetchAhead(): a job starts
+     *        only once the bytes stored so far fit the budget.
+     * @param bytesPerSecond Rate, 0 for unlimited.
+     ***************************************************************/
+    void setRateLimit(qint64 bytesPerSecond);
+    qint64 rateLimit() const;
+
+    /****************************************************************
+     * @brief Removes every stored wheel.
+     ***************************************************************/
+    void clear();
+
+    /****************************************************************
+     * @brief Writes pending index changes now.
+     ***************************************************************/
+    bool save();
+
+signals:
+    /****************************************************************
+     * @brief Emitted when every requested pin has been handled.
+     * @param complete true if all pins are stored, so installs may
+     *        use --no-index.
+     ***************************************************************/
+    void prefetchFinished(bool complete);
+
+    void progressChanged(int done, int total);
+
+    void logMessage(const QString &message);
+
+private:
+    struct Wheel
+    {
+        QString fileName;
+        qint64 size = 0;
+        qint64 lastUsed = 0;          ///< ms since epoch
+    };
+
+    /****************************************************************
+     * @struct Job
+     * @brief One running "pip wheel" and its staging directory.
+     ***************************************************************/
+    struct Job
+    {
+        QString pin;
+        QString stagingDir;
+        QProcess *process = nullptr;
+        qint64 span = 0;             ///< Telemetry span
+    };
+
+    /****************************************************************
+     * @struct Staged
+     * @brief Wheels moved out of a staging directory into blobs/.
+     ***************************************************************/
+    struct Staged
+    {
+        QStringList hashes;
+        QList<Wheel> wheels;
+    };
+
+    static Staged storeStaged(const QString &stagingDir, const QString &blobsRoot);
+
+    void startNext();
+    bool canStartAhead();
+    void startJob(const QString &pin);
+    void finishJob(Job *job, bool ok);
+    void finishBatch();
+    void ingest(const QString &pin, const Staged &staged);
+    void touch(const QStringList &hashes, qint64 now);
+    void evict();
+    bool writeLinks();
+    void markDirty();
+    QString pinKey(const QString &pin) const;
+    QString blobDir(const QString &hash) const;
+
+    QString m_dir;
+    qint64 m_sizeLimit = 0;
+    qint64 m_totalSize = 0;
+    QHash<QString, Wheel> m_wheels;          ///< sha256 -> stored wheel
+    QHash<QString, QStringList> m_pins;      ///< environment|pin -> sha256 list
+    bool m_dirty = false;
+    bool m_linksDirty = true;
+    QTimer m_saveTimer;
+
+    QString m_environment;
+    QString m_pythonExe;
+    int m_parallel = 1;
+    bool m_running = false;
+    QStringList m_queue;
+    QList<Job *> m_jobs;
+    int m_ingesting = 0;
+    int m_total = 0;
+    int m_done = 0;
+    int m_failed = 0;
+    int m_skipped = 0;
+    int m_nextStaging = 0;
+    int m_generation = 0;                    ///< bumps on cancel
+    qint64 m_batchStart = 0;                 ///< wheels used since are not evicted
+
+    bool m_ahead = false;                    ///< prefetchAhead() mode
+    qint64 m_rateLimit = 0;                  ///< bytes per second, 0 for unlimited
+    qint64 m_aheadStart = 0;
+    qint64 m_aheadBytes = 0;                 ///< stored by prefetchAhead() since m_aheadStart
+    bool m_aheadFull = false;                ///< size limit reached, logged once
+    QSet<QString> m_aheadFailed;
+    QTimer m_throttleTimer;
+};
+
+#endif // WHEELHOUSE_H
+/************** End of Wheelhouse.h *****************************/
@@ -0,0 +1,338 @@
+/****************************************************************
+ * @file cli_main.cpp
+ * @brief Entry point of pmr-cli, the headless resolver.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * pmr-cli runs the same ResolveSession as the GUI without widgets,
+ * for servers, CI and scripts:
+ *   pmr-cli resolve requirements.txt --venv PATH [options]
+ *   pmr-cli resume [options]
+ *   pmr-cli daemon [--socket NAME] [options]
+ *   pmr-cli worker --connect HOST:PORT --venv PATH [options]
+ * resolve and resume with --listen PORT --token SECRET hand the
+ * pip-compile tests to the workers that connect with the same
+ * token (see ResolveCoordinator); --bind ADDRESS limits them to
+ * one interface.
+ * It shares ~/PipMatrixResolverCache with the GUI. Exit status:
+ * 0 resolved (or daemon shut down), 1 no compatible combination,
+ * 2 usage error, failure or stop.
+ ***************************************************************/
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QHostAddress>
+#include <QHostInfo>
+#include <QTextStream>
+#include <QThread>
+#include "ResolveCoordinator.h"
+#include "ResolveDaemon.h"
+#include "ResolveSession.h"
+#include "ResolveWorker.h"
+#include "Telemetry.h"
+#include "Config.h"
+
+#define SHOW_DEBUG 0
+
+static QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+static QTextStream &err()
+{
+    static QTextStream stream(stderr);
+    return stream;
+}
+
+static int usageError(const QCommandLineParser &parser, const QString &message)
+{
+    err() << message << "\n\n" << parser.helpText();
+    err().flush();
+    return 2;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication::setOrganizationName("AM-Tower");
+    QCoreApplication::setApplicationName("PipMatrixResolver");
+    QCoreApplication::setApplicationVersion("0.1.3");
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless pip matrix resolver.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("command", "resolve, resume, daemon or worker");
+    parser.addPositionalArgument("requirements", "requirements file (resolve only)", "[requirements]");
+    const QCommandLineOption venvOption("venv", "Venv with pip-tools that workers clone.", "path");
+    const QCommandLineOption workersOption("workers", "Parallel pip-compile workers.", "n",
+                                           QString::number(qMax(1, QThread::idealThreadCount())));
+    const QCommandLineOption rangeOption("range", "Versions above the floor per package.", "n", "2");
+    const QCommandLineOption noWheelhouseOption("no-wheelhouse", "Resolve against the index, not the wheelhouse.");
+    const QCommandLineOption wheelhouseLimitOption("wheelhouse-limit", "Wheelhouse size limit in GB, 0 for none.",
+                                                   "gb", "20");
+    const QCommandLineOption prefetchAheadOption("prefetch-ahead",
+                                                 "Fetch wheels for the next n combinations while testing, 0 to "
+                                                 "fetch every candidate first.", "n", "3");
+    const QCommandLineOption prefetchRateOption("prefetch-rate", "Average rate of fetching ahead in MB/s, 0 for none.",
+                                                "mb", "0");
+    const QCommandLineOption fullOption("full", "Search the whole matrix, not just around the last lock.");
+    const QCommandLineOption pythonOption("python-version", "Python version of the cache key (default: the venv's).",
+                                          "x.y");
+    const QCommandLineOption cpuOption("cpu", "Cache key for CPU-only builds.");
+    const QCommandLineOption noCudaOption("no-cuda", "Cache key without CUDA.");
+    const QCommandLineOption cacheOption("cache", "Cache folder.", "dir",
+                                         QDir::homePath() + "/PipMatrixResolverCache");
+    const QCommandLineOption workDirOption("work-dir", "Per-test folders.", "dir",
+                                           QDir::homePath() + "/PipMatrixResolverLogs/matrix");
+    const QCommandLineOption outputOption("output", "Copy the compiled requirements here.", "file");
+    const QCommandLineOption traceOption("trace", "Write a Chrome trace of the run here.", "file");
+    const QCommandLineOption socketOption("socket", "Daemon socket name.", "name",
+                                          ResolveDaemon::defaultSocketName());
+    const QCommandLineOption listenOption("listen", "Run the tests on remote workers connecting to this port.",
+                                          "port");
+    const QCommandLineOption bindOption("bind", "Interface --listen accepts workers on (default: all).", "address");
+    const QCommandLineOption connectOption("connect", "Coordinator of a worker.", "host:port");
+    const QCommandLineOption tokenOption("token", "Shared secret of coordinator and workers.", "token");
+    const QCommandLineOption nameOption("name", "Worker name shown by the coordinator.", "name",
+                                        QHostInfo::localHostName());
+    const QCommandLineOption quietOption({"q", "quiet"}, "Only print the result.");
+    parser.addOptions({venvOption, workersOption, rangeOption, noWheelhouseOption, wheelhouseLimitOption,
+                       prefetchAheadOption, prefetchRateOption, fullOption,
+                       pythonOption, cpuOption, noCudaOption, cacheOption, workDirOption, outputOption,
+                       traceOption, socketOption, listenOption, bindOption, connectOption, tokenOption, nameOption,
+                       quietOption});
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    const QString command = positional.value(0);
+    bool workersOk = false;
+    bool rangeOk = false;
+    bool limitOk = false;
+    bool aheadOk = false;
+    bool rateOk = false;
+    ResolveDaemon::Job defaults;
+    defaults.options.baseVenv = parser.value(venvOption);
+    defaults.options.workDir = parser.value(workDirOption);
+    defaults.options.workers = parser.value(workersOption).toInt(&workersOk);
+    defaults.options.matrixRange = parser.value(rangeOption).toInt(&rangeOk);
+    defaults.options.useWheelhouse = !parser.isSet(noWheelhouseOption);
+    defaults.options.wheelhouseLimit = qint64(parser.value(wheelhouseLimitOption).toInt(&limitOk))
+                                       * 1024 * 1024 * 1024;
+    defaults.options.prefetchAhead = parser.value(prefetchAheadOption).toInt(&aheadOk);
+    defaults.options.prefetchRate = qint64(parser.value(prefetchRateOption).toInt(&rateOk)) * 1024 * 1024;
+    defaults.options.incremental = !parser.isSet(fullOption);
+    defaults.pythonVersion = parser.value(pythonOption);
+    defaults.useCpu = parser.isSet(cpuOption);
+    defaults.cuda = !parser.isSet(noCudaOption);
+    defaults.output = parser.value(outputOption);
+    defaults.trace = parser.value(traceOption);
+    if (!workersOk || defaults.options.workers < 1 || !rangeOk || defaults.options.matrixRange < 0
+        || !limitOk || defaults.options.wheelhouseLimit < 0 || !aheadOk || defaults.options.prefetchAhead < 0
+        || !rateOk || defaults.options.prefetchRate < 0)
+    {
+        return usageError(parser, "--workers, --range, --wheelhouse-limit, --prefetch-ahead and --prefetch-rate "
+                                  "take non-negative numbers.");
+    }
+
+    ResolveSession session;
+    session.setCacheDir(parser.value(cacheOption));
+    const bool quiet = parser.isSet(quietOption);
+
+    if (command == "daemon")
+    {
+        ResolveDaemon daemon(&session, defaults);
+        QString error;
+        if (!daemon.listen(parser.value(socketOption), &error))
+        {
+            err() << "Cannot listen on " << parser.value(socketOption) << ": " << error << "\n";
+            return 2;
+        }
+        if (!quiet)
+        {
+            err() << "Listening on " << parser.value(socketOption) << "\n";
+            err().flush();
+        }
+        QObject::connect(&daemon, &ResolveDaemon::shutdownRequested, &app, &QCoreApplication::quit,
+                         Qt::QueuedConnection);
+        return app.exec();
+    }
+
+    if (command == "worker")
+    {
+        const QString target = parser.value(connectOption);
+        const qsizetype colon = target.lastIndexOf(':');
+        bool portOk = false;
+        const quint16 port = colon > 0 ? target.mid(colon + 1).toUShort(&portOk) : 0;
+        if (!portOk || port == 0)
+        {
+            return usageError(parser, "worker needs --connect host:port.");
+        }
+        if (defaults.options.baseVenv.isEmpty())
+        {
+            return usageError(parser, "worker needs --venv.");
+        }
+        if (parser.value(tokenOption).isEmpty())
+        {
+            return usageError(parser, "worker needs --token.");
+        }
+        ResolveWorker worker;
+        worker.runner()->setBaseVenv(defaults.options.baseVenv);
+        worker.runner()->setWorkerCount(defaults.options.workers);
+        worker.runner()->setWorkDir(defaults.options.workDir);
+        worker.setEnvironment(ResolveSession::hostEnvironment(defaults.options.baseVenv, defaults.pythonVersion,
+                                                              defaults.useCpu, defaults.cuda));
+        worker.setToken(parser.value(tokenOption));
+        worker.setName(parser.value(nameOption));
+        if (!quiet)
+        {
+            QObject::connect(&worker, &ResolveWorker::logMessage, [](const QString &line) {
+                err() << line << "\n";
+                err().flush();
+            });
+        }
+        QObject::connect(&worker, &ResolveWorker::rejected, [&app]() {
+            QMetaObject::invokeMethod(&app, [&app]() { app.exit(2); }, Qt::QueuedConnection);
+        });
+        worker.connectTo(target.left(colon), port);
+        return app.exec();
+    }
+
+    if (command != "resolve" && command != "resume")
+    {
+        return usageError(parser, command.isEmpty() ? QString("Missing command.")
+                                                    : QString("Unknown command \"%1\".").arg(command));
+    }
+
+    // Queued: the session may finish before the event loop runs
+    auto quit = [&app]() {
+        QMetaObject::invokeMethod(&app, &QCoreApplication::quit, Qt::QueuedConnection);
+    };
+    int exitCode = 2;
+
+    // Workers are let in once start() or resume has set the environment
+    ResolveCoordinator coordinator;
+    quint16 listenPort = 0;
+    QHostAddress listenAddress = QHostAddress::Any;
+    if (parser.isSet(listenOption))
+    {
+        bool portOk = false;
+        listenPort = parser.value(listenOption).toUShort(&portOk);
+        if (!portOk)
+        {
+            return usageError(parser, "--listen takes a port number.");
+        }
+        // Any host that reaches the port could report results
+        if (parser.value(tokenOption).isEmpty())
+        {
+            return usageError(parser, "--listen needs --token.");
+        }
+        if (parser.isSet(bindOption) && !listenAddress.setAddress(parser.value(bindOption)))
+        {
+            return usageError(parser, "--bind takes an IP address.");
+        }
+        coordinator.setToken(parser.value(tokenOption));
+        session.setCoordinator(&coordinator);
+    }
+    if (!quiet)
+    {
+        QObject::connect(&session, &ResolveSession::logMessage, [](const QString &line) {
+            err() << line << "\n";
+            err().flush();
+        });
+    }
+    QObject::connect(&session, &ResolveSession::resolved,
+                     [&](const QStringList &pins, const QString &outputPath) {
+                         exitCode = 0;
+                         QString written = outputPath;
+                         if (!defaults.output.isEmpty())
+                         {
+                             QFile::remove(defaults.output);
+                             if (QFile::copy(outputPath, defaults.output))
+                             {
+                                 written = defaults.output;
+                             }
+                             else
+                             {
+                                 err() << "Cannot write " << defaults.output << "\n";
+                             }
+                         }
+                         out() << pins.join('\n') << "\n";
+                         out().flush();
+                         err() << "Compiled requirements: " << written << "\n";
+                         quit();
+                     });
+    QObject::connect(&session, &ResolveSession::exhausted, [&]() {
+        exitCode = 1;
+        err() << "No compatible combination found\n";
+        quit();
+    });
+    QObject::connect(&session, &ResolveSession::stopped, quit);
+    QObject::connect(&session, &ResolveSession::failed, [&](const QString &error) {
+        err() << error << "\n";
+        quit();
+    });
+
+    if (command == "resume")
+    {
+        QString error;
+        if (!session.resumeCheckpoint(defaults.options, &error))
+        {
+            err() << error << "\n";
+            return 2;
+        }
+    }
+    else
+    {
+        if (positional.size() < 2)
+        {
+            return usageError(parser, "resolve needs a requirements file.");
+        }
+        if (defaults.options.baseVenv.isEmpty())
+        {
+            return usageError(parser, "resolve needs --venv.");
+        }
+        QVector<Requirement> requirements;
+        QString error;
+        if (!ResolveSession::readRequirements(positional.at(1), &requirements, &error))
+        {
+            err() << error << "\n";
+            return 2;
+        }
+        ResolveSession::Options options = defaults.options;
+        options.environment = ResolveSession::hostEnvironment(options.baseVenv, defaults.pythonVersion,
+                                                              defaults.useCpu, defaults.cuda);
+        session.start(requirements, options);
+    }
+    if (session.coordinator())
+    {
+        QString error;
+        if (!coordinator.listen(listenPort, &error, listenAddress))
+        {
+            err() << "Cannot listen on port " << listenPort << ": " << error << "\n";
+            session.stop();
+            return 2;
+        }
+        err() << "Waiting for workers on port " << coordinator.serverPort() << "\n";
+        err().flush();
+    }
+    app.exec();
+
+    if (!defaults.trace.isEmpty())
+    {
+        QString error;
+        if (!Telemetry::exportTrace(defaults.trace, &error))
+        {
+            err() << "Cannot write run trace " << defaults.trace << ": " << error << "\n";
+        }
+    }
+    err().flush();
+    return exitCode;
+}
+/************** End of cli_main.cpp *****************************/
@@ -0,0 +1,657 @@
+/****************************************************************
+ * @file bench_resolver.cpp
+ * @brief Resolver benchmark on recorded PyPI metadata.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * Runs the real CandidateFetcher and ResolverEngine end to end
+ * without network or Python:
+ *   - PyPI JSON responses are replayed from fixtures/pypi through
+ *     file:// URLs, so candidate discovery takes the normal path.
+ *   - pip-compile is replaced by MockCompileRunner, which answers
+ *     from fixtures/compile_rules.json after a synthetic latency.
+ * Each requirements file is resolved twice against one
+ * CompatibilityCache, cold then warm, and the report lists test
+ * launches, cache hits, wall time and peak RSS per run.
+ *
+ * --micro n instead times version handling over n synthetic
+ * versions: packing, sorting, and specifier evaluation through
+ * CandidateFetcher::satisfies(), SpecifierSet::matches(),
+ * filter() and filterSorted(), in nanoseconds per version.
+ *
+ * Usage: bench_resolver [--latency ms] [--workers n] [--range n]
+ *                       [--fixtures dir] [--micro n] [--json]
+ *                       [--check] [requirements.txt ...]
+ * --check exits non-zero if a warm run launches any test or the
+ * two runs disagree, or if the specifier evaluators disagree,
+ * which is what the ctest entries use.
+ ***************************************************************/
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+#include <QUrl>
+#include <cstdio>
+#include "CandidateFetcher.h"
+#include "CompatibilityCache.h"
+#include "PackedVersion.h"
+#include "ResolverEngine.h"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/****************************************************************
+ * @brief Peak resident set size of this process in KiB.
+ ***************************************************************/
+static qint64 peakRssKb()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if defined(Q_OS_MACOS)
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;        // KiB on Linux
+#endif
+#endif
+}
+
+/****************************************************************
+ * @class MockCompileRunner
+ * @brief Stands in for PipCompileRunner: a pin set fails if it
+ *        matches every specifier of any rule.
+ ***************************************************************/
+class MockCompileRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MockCompileRunner(const QList<QStringList> &rules, int latencyMs, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_rules(rules)
+        , m_latencyMs(latencyMs)
+        , m_random(20261014)
+    {
+    }
+
+    int launches() const
+    {
+        return m_launches;
+    }
+
+    int peakInFlight() const
+    {
+        return m_peakInFlight;
+    }
+
+    void reset()
+    {
+        m_launches = 0;
+        m_peakInFlight = 0;
+    }
+
+public slots:
+    void runTest(int testId, const QStringList &pins)
+    {
+        ++m_launches;
+        ++m_inFlight;
+        m_peakInFlight = qMax(m_peakInFlight, m_inFlight);
+        const bool passed = compiles(pins);
+        // +-25 % jitter so results arrive out of order like real workers
+        const int jitter = m_latencyMs / 4;
+        const int delay = m_latencyMs + (jitter > 0 ? m_random.bounded(-jitter, jitter + 1) : 0);
+        QTimer::singleShot(qMax(0, delay), this, [this, testId, passed]()
+                           {
+                               --m_inFlight;
+                               emit testFinished(testId, passed ? TestOutcome::Passed : TestOutcome::Failed, QString());
+                           });
+    }
+
+signals:
+    void testFinished(int testId, TestOutcome outcome, const QString &outputPath);
+
+private:
+    bool compiles(const QStringList &pins) const
+    {
+        QHash<QString, QString> versions;
+        for (int i = 0; i < pins.size(); ++i)
+        {
+            const int eq = pins.at(i).indexOf("==");
+            if (eq > 0)
+            {
+                versions.insert(projectOf(pins.at(i).left(eq)), pins.at(i).mid(eq + 2));
+            }
+        }
+        for (int r = 0; r < m_rules.size(); ++r)
+        {
+            bool all = true;
+            for (int s = 0; s < m_rules.at(r).size() && all; ++s)
+            {
+                all = matches(m_rules.at(r).at(s), versions);
+            }
+            if (all)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static QString projectOf(const QString &name)
+    {
+        return CandidateFetcher::normalizeName(name.section('[', 0, 0).trimmed());
+    }
+
+    static bool matches(const QString &specifier, const QHash<QString, QString> &versions)
+    {
+        static const QRegularExpression re("^\\s*([A-Za-z0-9._\\-\\[\\]]+)\\s*(==|!=|<=|>=|<|>)\\s*(\\S+)\\s*$");
+        const QRegularExpressionMatch m = re.match(specifier);
+        if (!m.hasMatch())
+        {
+            return false;
+        }
+        const auto it = versions.constFind(projectOf(m.captured(1)));
+        if (it == versions.constEnd())
+        {
+            return false;
+        }
+        const QString op = m.captured(2);
+        QString version = m.captured(3);
+        if (version.endsWith(".*"))
+        {
+            version.chop(2);
+            const bool prefix = it.value() == version || it.value().startsWith(version + '.');
+            return op == "==" ? prefix : !prefix;
+        }
+        const int c = CandidateFetcher::compareVersions(it.value(), version);
+        if (op == "==") return c == 0;
+        if (op == "!=") return c != 0;
+        if (op == "<") return c < 0;
+        if (op == "<=") return c <= 0;
+        if (op == ">") return c > 0;
+        return c >= 0;
+    }
+
+    QList<QStringList> m_rules;
+    int m_latencyMs;
+    QRandomGenerator m_random;
+    int m_launches = 0;
+    int m_inFlight = 0;
+    int m_peakInFlight = 0;
+};
+
+/****************************************************************
+ * @struct RunResult
+ * @brief Metrics of one resolve.
+ ***************************************************************/
+struct RunResult
+{
+    QString fixture;
+    QString run;
+    QString outcome;
+    int launches = 0;
+    int cacheHits = 0;
+    int conflicts = 0;
+    int peakInFlight = 0;
+    double combinations = 0.0;
+    double pruned = 0.0;
+    qint64 discoverMs = 0;
+    qint64 resolveMs = 0;
+    QStringList pins;
+};
+
+static QList<QStringList> loadRules(const QString &path)
+{
+    QList<QStringList> rules;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return rules;
+    }
+    const QJsonArray array = QJsonDocument::fromJson(file.readAll()).object().value("rules").toArray();
+    for (int i = 0; i < array.size(); ++i)
+    {
+        QStringList rule;
+        const QJsonArray specs = array.at(i).toArray();
+        for (int j = 0; j < specs.size(); ++j)
+        {
+            rule << specs.at(j).toString();
+        }
+        rules << rule;
+    }
+    return rules;
+}
+
+static QStringList readLines(const QString &path)
+{
+    QStringList lines;
+    QFile file(path);
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QTextStream in(&file);
+        while (!in.atEnd())
+        {
+            lines << in.readLine();
+        }
+    }
+    return lines;
+}
+
+/****************************************************************
+ * @brief Discovers candidates from the recorded index and resolves.
+ ***************************************************************/
+static RunResult runOnce(const QString &requirementsPath, const QString &pypiDir, int matrixRange,
+                         int workers, MockCompileRunner *runner, CompatibilityCache *cache)
+{
+    RunResult result;
+    result.fixture = QFileInfo(requirementsPath).fileName();
+    runner->reset();
+
+    QEventLoop loop;
+    QElapsedTimer timer;
+    timer.start();
+
+    CandidateFetcher fetcher;
+    fetcher.setIndexUrl(QUrl::fromLocalFile(pypiDir).toString());
+    fetcher.setMatrixRange(matrixRange);
+    QVector<PackageCandidates> packages;
+    QObject::connect(&fetcher, &CandidateFetcher::candidatesReady,
+                     &loop, [&](const QVector<PackageCandidates> &found)
+                     {
+                         packages = found;
+                         loop.quit();
+                     });
+    fetcher.fetch(readLines(requirementsPath));
+    if (fetcher.isFetching())
+    {
+        loop.exec();
+    }
+    result.discoverMs = timer.restart();
+
+    ResolverEngine engine;
+    engine.setMaxParallelTests(workers);
+    engine.setCache(cache);
+    QObject::connect(&engine, &ResolverEngine::testRequested, runner, &MockCompileRunner::runTest);
+    QObject::connect(runner, &MockCompileRunner::testFinished, &engine, &ResolverEngine::reportTestResult);
+    QObject::connect(&engine, &ResolverEngine::resolved,
+                     &loop, [&](const QStringList &pins, const QString &)
+                     {
+                         result.outcome = "resolved";
+                         result.pins = pins;
+                         loop.quit();
+                     });
+    QObject::connect(&engine, &ResolverEngine::exhausted, &loop, [&]()
+                     {
+                         result.outcome = "exhausted";
+                         loop.quit();
+                     });
+    engine.setCandidates(packages);
+    engine.setStaticConflicts(fetcher.staticConflicts());
+    result.combinations = engine.totalCombinations();
+    if (!engine.start())
+    {
+        result.outcome = "invalid";
+    }
+    else if (result.outcome.isEmpty())
+    {
+        loop.exec();
+    }
+    result.resolveMs = timer.elapsed();
+
+    // Results still in the mock's timers must not reach a later run
+    QObject::disconnect(runner, nullptr, &engine, nullptr);
+    result.launches = runner->launches();
+    result.peakInFlight = runner->peakInFlight();
+    result.cacheHits = engine.cacheHits();
+    result.conflicts = engine.conflicts().size();
+    result.pruned = engine.combinationsPruned();
+    return result;
+}
+
+static QJsonObject toJson(const RunResult &r)
+{
+    QJsonObject o;
+    o.insert("fixture", r.fixture);
+    o.insert("run", r.run);
+    o.insert("outcome", r.outcome);
+    o.insert("launches", r.launches);
+    o.insert("cacheHits", r.cacheHits);
+    o.insert("hitRate", r.launches + r.cacheHits > 0
+                            ? double(r.cacheHits) / (r.launches + r.cacheHits) : 0.0);
+    o.insert("conflicts", r.conflicts);
+    o.insert("peakInFlight", r.peakInFlight);
+    o.insert("combinations", r.combinations);
+    o.insert("pruned", r.pruned);
+    o.insert("discoverMs", r.discoverMs);
+    o.insert("resolveMs", r.resolveMs);
+    o.insert("pins", QJsonArray::fromStringList(r.pins));
+    return o;
+}
+
+/****************************************************************
+ * @struct MicroResult
+ * @brief One micro-benchmark.
+ ***************************************************************/
+struct MicroResult
+{
+    QString name;
+    int versions = 0;
+    double nsPerVersion = 0.0;
+};
+
+/****************************************************************
+ * @brief Average time of body per item over rounds repetitions.
+ ***************************************************************/
+template <typename Body>
+static double nsPerItem(qint64 items, int rounds, Body body)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int r = 0; r < rounds; ++r)
+    {
+        body();
+    }
+    return double(timer.nsecsElapsed()) / double(qMax<qint64>(1, items * rounds));
+}
+
+/****************************************************************
+ * @brief Release-like versions, about one in six a pre-, post- or
+ *        dev release; fixed seed so runs compare.
+ ***************************************************************/
+static QStringList syntheticVersions(int count)
+{
+    static const char *const kSuffixes[] = {"", "", "", "", "", "", "", "", "rc1", "a2", ".post1", ".dev3"};
+    QRandomGenerator random(20261014);
+    QStringList versions;
+    versions.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        versions << QString("%1.%2.%3%4")
+                        .arg(random.bounded(10))
+                        .arg(random.bounded(40))
+                        .arg(random.bounded(20))
+                        .arg(QLatin1String(kSuffixes[random.bounded(int(std::size(kSuffixes)))]));
+    }
+    return versions;
+}
+
+/****************************************************************
+ * @brief Times version handling; agree is cleared if filter(),
+ *        filterSorted() and matches() differ anywhere.
+ ***************************************************************/
+static QList<MicroResult> runMicro(int count, bool *agree)
+{
+    static const char *const kSpecifiers[] = {"x>=1.23,<2,!=1.24.*", "x~=4.2.1", "x==7.*",
+                                              "x>1.0,<=3.5.1,!=2.0.0"};
+    const int specifierCount = int(std::size(kSpecifiers));
+    const QStringList texts = syntheticVersions(count);
+    const int rounds = qMax(1, 2000000 / qMax(1, count));
+    QList<MicroResult> results;
+    qint64 sink = 0;
+
+    QVector<PackedVersion> versions(count);
+    results << MicroResult{"pack", count, nsPerItem(count, rounds, [&]()
+                           {
+                               for (int i = 0; i < count; ++i)
+                               {
+                                   sink += PackedVersion::pack(texts.at(i), &versions[i]);
+                               }
+                           })};
+
+    QStringList sortedTexts;
+    results << MicroResult{"sort compareVersions()", count, nsPerItem(count, 1, [&]()
+                           {
+                               sortedTexts = texts;
+                               std::sort(sortedTexts.begin(), sortedTexts.end(),
+                                         [](const QString &a, const QString &b)
+                                         { return CandidateFetcher::compareVersions(a, b) < 0; });
+                           })};
+    QVector<PackedVersion> sorted;
+    results << MicroResult{"sort packed", count, nsPerItem(count, rounds, [&]()
+                           {
+                               sorted = versions;
+                               std::sort(sorted.begin(), sorted.end());
+                           })};
+    // Position of each version in sorted, to compare filterSorted()
+    QVector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&versions](int a, int b) { return versions.at(a) < versions.at(b); });
+
+    QVector<Requirement> requirements;
+    QVector<SpecifierSet> specifiers;
+    for (int s = 0; s < specifierCount; ++s)
+    {
+        requirements << Requirement::parse(QLatin1String(kSpecifiers[s]));
+        specifiers << SpecifierSet::compile(requirements.last());
+        *agree = *agree && specifiers.last().isValid();
+    }
+    const qint64 evaluations = qint64(count) * specifierCount;
+
+    results << MicroResult{"satisfies() on text", count, nsPerItem(evaluations, 1, [&]()
+                           {
+                               for (int s = 0; s < specifierCount; ++s)
+                               {
+                                   for (int i = 0; i < count; ++i)
+                                   {
+                                       sink += CandidateFetcher::satisfies(requirements.at(s), texts.at(i));
+                                   }
+                               }
+                           })};
+    results << MicroResult{"matches()", count, nsPerItem(evaluations, rounds, [&]()
+                           {
+                               for (int s = 0; s < specifierCount; ++s)
+                               {
+                                   for (int i = 0; i < count; ++i)
+                                   {
+                                       sink += specifiers.at(s).matches(versions.at(i));
+                                   }
+                               }
+                           })};
+    QVector<quint8> matches(count);
+    results << MicroResult{"filter()", count, nsPerItem(evaluations, rounds, [&]()
+                           {
+                               for (int s = 0; s < specifierCount; ++s)
+                               {
+                                   specifiers.at(s).filter(versions.constData(), count, matches.data());
+                                   sink += matches.at(count - 1);
+                               }
+                           })};
+    QBitArray bits;
+    results << MicroResult{"filterSorted()", count, nsPerItem(evaluations, rounds, [&]()
+                           {
+                               for (int s = 0; s < specifierCount; ++s)
+                               {
+                                   sink += specifiers.at(s).filterSorted(sorted, &bits);
+                               }
+                           })};
+
+    for (int s = 0; s < specifierCount && *agree; ++s)
+    {
+        specifiers.at(s).filter(versions.constData(), count, matches.data());
+        specifiers.at(s).filterSorted(sorted, &bits);
+        for (int i = 0; i < count && *agree; ++i)
+        {
+            *agree = (matches.at(i) != 0) == specifiers.at(s).matches(versions.at(i))
+                     && (matches.at(order.at(i)) != 0) == bits.testBit(i);
+        }
+    }
+    if (sink == -1)
+    {
+        std::fprintf(stderr, "unreachable\n"); // keeps the timed loops from being discarded
+    }
+    return results;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("bench_resolver");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks ResolverEngine on recorded PyPI metadata with a mocked pip-compile.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("requirements", "Requirements files to resolve.", "[requirements.txt...]");
+    QCommandLineOption latencyOption("latency", "Synthetic pip-compile latency.", "ms", "50");
+    QCommandLineOption workersOption("workers", "Parallel tests.", "n", "4");
+    QCommandLineOption rangeOption("range", "MATRIX_RANGE for candidate discovery.", "n", "2");
+    QCommandLineOption fixturesOption("fixtures", "Fixture directory (pypi/, compile_rules.json).", "dir",
+                                      QStringLiteral(PMR_FIXTURES_DIR));
+    QCommandLineOption microOption("micro", "Time version packing and specifier matching instead of resolving.",
+                                   "n");
+    QCommandLineOption jsonOption("json", "Print results as JSON.");
+    QCommandLineOption checkOption("check", "Fail if a warm run launches tests or the runs disagree.");
+    parser.addOptions({latencyOption, workersOption, rangeOption, fixturesOption, microOption, jsonOption,
+                       checkOption});
+    parser.process(app);
+
+    if (parser.isSet(microOption))
+    {
+        bool agree = true;
+        const QList<MicroResult> micro = runMicro(qMax(1, parser.value(microOption).toInt()), &agree);
+        QTextStream out(stdout);
+        if (parser.isSet(jsonOption))
+        {
+            QJsonArray array;
+            for (int i = 0; i < micro.size(); ++i)
+            {
+                array.append(QJsonObject{{"name", micro.at(i).name},
+                                         {"versions", micro.at(i).versions},
+                                         {"nsPerVersion", micro.at(i).nsPerVersion}});
+            }
+            out << QJsonDocument(QJsonObject{{"micro", array}}).toJson(QJsonDocument::Indented);
+        }
+        else
+        {
+            out << QString("%1 %2 %3\n").arg("benchmark", -24).arg("versions", 9).arg("ns/version", 11);
+            for (int i = 0; i < micro.size(); ++i)
+            {
+                out << QString("%1 %2 %3\n")
+                           .arg(micro.at(i).name, -24)
+                           .arg(micro.at(i).versions, 9)
+                           .arg(micro.at(i).nsPerVersion, 11, 'f', 2);
+            }
+        }
+        out.flush();
+        if (parser.isSet(checkOption) && !agree)
+        {
+            std::fprintf(stderr, "filter(), filterSorted() and matches() disagree\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    const QDir fixtures(parser.value(fixturesOption));
+    QStringList requirementFiles = parser.positionalArguments();
+    if (requirementFiles.isEmpty())
+    {
+        requirementFiles << QStringLiteral(PMR_DEFAULT_REQUIREMENTS);
+    }
+    const QList<QStringList> rules = loadRules(fixtures.filePath("compile_rules.json"));
+    if (rules.isEmpty())
+    {
+        std::fprintf(stderr, "No rules in %s\n", qPrintable(fixtures.filePath("compile_rules.json")));
+        return 2;
+    }
+
+    MockCompileRunner runner(rules, parser.value(latencyOption).toInt());
+    const int workers = qMax(1, parser.value(workersOption).toInt());
+    const int range = qMax(0, parser.value(rangeOption).toInt());
+
+    QList<RunResult> results;
+    bool ok = true;
+    for (int i = 0; i < requirementFiles.size(); ++i)
+    {
+        QTemporaryDir cacheDir;
+        CompatibilityCache cache;
+        cache.open(cacheDir.path(), CompatibilityCache::environmentKey("bench", "bench", "0", true, false));
+
+        RunResult cold = runOnce(requirementFiles.at(i), fixtures.filePath("pypi"), range, workers, &runner, &cache);
+        cold.run = "cold";
+        RunResult warm = runOnce(requirementFiles.at(i), fixtures.filePath("pypi"), range, workers, &runner, &cache);
+        warm.run = "warm";
+        ok = ok && warm.launches == 0 && warm.outcome == cold.outcome && warm.pins == cold.pins;
+        results << cold << warm;
+    }
+    const qint64 rss = peakRssKb();
+
+    QTextStream out(stdout);
+    if (parser.isSet(jsonOption))
+    {
+        QJsonArray runs;
+        for (int i = 0; i < results.size(); ++i)
+        {
+            runs.append(toJson(results.at(i)));
+        }
+        QJsonObject root;
+        root.insert("latencyMs", parser.value(latencyOption).toInt());
+        root.insert("workers", workers);
+        root.insert("matrixRange", range);
+        root.insert("peakRssKb", rss);
+        root.insert("runs", runs);
+        out << QJsonDocument(root).toJson(QJsonDocument::Indented);
+    }
+    else
+    {
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9\n")
+                   .arg("fixture", -20).arg("run", -5).arg("outcome", -10)
+                   .arg("launches", 9).arg("hits", 6).arg("hit%", 6)
+                   .arg("conflicts", 10).arg("inflight", 9).arg("wall ms", 9);
+        for (int i = 0; i < results.size(); ++i)
+        {
+            const RunResult &r = results.at(i);
+            const int total = r.launches + r.cacheHits;
+            out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9\n")
+                       .arg(r.fixture, -20).arg(r.run, -5).arg(r.outcome, -10)
+                       .arg(r.launches, 9).arg(r.cacheHits, 6)
+                       .arg(total > 0 ? 100.0 * r.cacheHits / total : 0.0, 6, 'f', 1)
+                       .arg(r.conflicts, 10).arg(r.peakInFlight, 9)
+                       .arg(r.discoverMs + r.resolveMs, 9);
+        }
+        out << QString("combinations %1, peak RSS %2 MiB\n")
+                   .arg(results.isEmpty() ? 0.0 : results.first().combinations, 0, 'g', 6)
+                   .arg(rss / 1024.0, 0, 'f', 1);
+    }
+    out.flush();
+
+    if (parser.isSet(checkOption) && !ok)
+    {
+        std::fprintf(stderr, "Warm run launched tests or disagreed with the cold run\n");
+        return 1;
+    }
+    return 0;
+}
+
+#include "bench_resolver.moc"
+/************** End of bench_resolver.cpp ***********************/
@@ -1,9 +0,0 @@
-#include <gtest/gtest.h>
-#include "ResolverEngine.h"
-
-TEST(ResolverEngineTest, BasicSanity)
-{
-    ResolverEngine engine;
-    // Replace with a real method from your class
-    EXPECT_TRUE(engine.isValid());
-}
@@ -1,24 +1,60 @@
+/****************************************************************
+ * @file qtest_mainwindow.cpp
+ * @brief Smoke tests for MainWindow.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * Builds the real window offscreen. QStandardPaths test mode and
+ * a temporary settings path keep the user's configuration, cache
+ * and history out of the run.
+ ***************************************************************/
 #include <QtTest/QtTest>
+#include <QAction>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QTemporaryDir>
 #include "MainWindow.h"
 
-class TestMainWindow : public QObject {
+/****************************************************************
+ * @class TestMainWindow
+ ***************************************************************/
+class TestMainWindow : public QObject
+{
     Q_OBJECT
 
 private slots:
-    void initTestCase() {
-        // Runs before all tests
+    void initTestCase()
+    {
+        QVERIFY(m_settingsDir.isValid());
+        QStandardPaths::setTestModeEnabled(true);
+        QSettings::setPath(QSettings::NativeFormat, QSettings::UserScope, m_settingsDir.path());
+        QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, m_settingsDir.path());
+        QCoreApplication::setOrganizationName(MainWindow::kOrganizationName);
+        QCoreApplication::setApplicationName(MainWindow::kApplicationName);
     }
 
-    void testFetchRequirementsAction() {
+    void testFetchRequirementsAction()
+    {
         MainWindow w;
-        QAction *action = w.findChild<QAction*>("actionFetchRequirements");
+        QAction *action = w.findChild<QAction *>("actionFetchRequirements");
         QVERIFY(action != nullptr);
+        QVERIFY(action->isEnabled());
     }
 
-    void cleanupTestCase() {
-        // Runs after all tests
+    void testMainTabs()
+    {
+        MainWindow w;
+        QVERIFY(w.findChild<QWidget *>("tabMain") != nullptr);
+        QVERIFY(w.findChild<QWidget *>("tabSettings") != nullptr);
     }
+
+private:
+    QTemporaryDir m_settingsDir;
 };
 
 QTEST_MAIN(TestMainWindow)
 #include "qtest_mainwindow.moc"
+/************** End of qtest_mainwindow.cpp *********************/
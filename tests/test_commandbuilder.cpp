@@ -0,0 +1,85 @@
+/****************************************************************
+ * @file test_commandbuilder.cpp
+ * @brief Unit tests for CommandBuilder.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include "CommandBuilder.h"
+
+/****************************************************************
+ * @class TestCommandBuilder
+ ***************************************************************/
+class TestCommandBuilder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void splitsQuotedWords();
+    void keepsWindowsPaths();
+    void reportsUnterminatedQuote();
+    void buildsArguments();
+    void commandLineRoundTrips();
+};
+
+void TestCommandBuilder::splitsQuotedWords()
+{
+    QCOMPARE(CommandBuilder::splitArguments("a  \"b c\" 'd \"e\"' f\\ g \"\""),
+             QStringList({"a", "b c", "d \"e\"", "f g", ""}));
+    QCOMPARE(CommandBuilder::splitArguments("x\"y z\"w"), QStringList({"xy zw"}));
+    QCOMPARE(CommandBuilder::splitArguments("\"say \\\"hi\\\"\""), QStringList({"say \"hi\""}));
+    QVERIFY(CommandBuilder::splitArguments("   ").isEmpty());
+}
+
+void TestCommandBuilder::keepsWindowsPaths()
+{
+    QCOMPARE(CommandBuilder::splitArguments("C:\\data\\in.wav \"C:\\My Files\\out.mp4\""),
+             QStringList({"C:\\data\\in.wav", "C:\\My Files\\out.mp4"}));
+}
+
+void TestCommandBuilder::reportsUnterminatedQuote()
+{
+    QString error;
+    CommandBuilder::splitArguments("a \"b c", &error);
+    QVERIFY(!error.isEmpty());
+    error.clear();
+    CommandBuilder::splitArguments("a \"b\" c", &error);
+    QVERIFY(error.isEmpty());
+}
+
+void TestCommandBuilder::buildsArguments()
+{
+    ProjectDef project;
+    project.scriptPath = "run.py";
+    project.inputs = {{"Audio", "--audio"}, {"Image", "--image"}, {"Out", ""}};
+    CommandBuilder builder(project, "python3", "--fps 30 --title \"My Song\"");
+
+    QString program;
+    QStringList arguments;
+    builder.build({"a b.wav", "", "out.mp4"}, &program, &arguments);
+    QCOMPARE(program, QString("python3"));
+    QCOMPARE(arguments, QStringList({"run.py", "--audio", "a b.wav", "out.mp4",
+                                     "--fps", "30", "--title", "My Song"}));
+
+    builder.build({"x.wav"}, &program, &arguments);
+    QCOMPARE(arguments, QStringList({"run.py", "--audio", "x.wav", "--fps", "30", "--title", "My Song"}));
+}
+
+void TestCommandBuilder::commandLineRoundTrips()
+{
+    ProjectDef project;
+    project.scriptPath = "my script.py";
+    project.inputs = {{"In", "-i"}};
+    CommandBuilder builder(project, "python", QString());
+    const QString line = builder.commandLine({"say \"hi\".txt"});
+    QCOMPARE(line, QString("python \"my script.py\" -i \"say \\\"hi\\\".txt\""));
+    QCOMPARE(CommandBuilder::splitArguments(line),
+             QStringList({"python", "my script.py", "-i", "say \"hi\".txt"}));
+}
+
+QTEST_GUILESS_MAIN(TestCommandBuilder)
+#include "test_commandbuilder.moc"
+/************** End of test_commandbuilder.cpp ******************/
@@ -0,0 +1,277 @@
+/****************************************************************
+ * @file test_coordinator.cpp
+ * @brief Unit tests for ResolveCoordinator, driven by fake
+ *        workers on a loopback socket.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <memory>
+#include "ResolveCoordinator.h"
+
+/****************************************************************
+ * @brief Waits (running the event loop) for the next message.
+ ***************************************************************/
+static QJsonObject nextMessage(QTcpSocket *socket, int timeoutMs = 5000)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!socket->canReadLine() && timer.elapsed() < timeoutMs
+           && socket->state() == QAbstractSocket::ConnectedState)
+    {
+        QTest::qWait(5);
+    }
+    if (!socket->canReadLine())
+    {
+        return QJsonObject();
+    }
+    return QJsonDocument::fromJson(socket->readLine()).object();
+}
+
+static const QString kToken = QStringLiteral("secret");
+
+/****************************************************************
+ * @brief Connects and answers the challenge like ResolveWorker.
+ ***************************************************************/
+static QTcpSocket *connectWorker(ResolveCoordinator &coordinator, const QString &environment, int capacity,
+                                 const QString &token = kToken)
+{
+    QTcpSocket *socket = new QTcpSocket;
+    socket->connectToHost(QHostAddress::LocalHost, coordinator.serverPort());
+    const QJsonObject challenge = socket->waitForConnected(5000) ? nextMessage(socket) : QJsonObject();
+    if (challenge.value("type").toString() != "challenge")
+    {
+        delete socket;
+        return nullptr;
+    }
+    const QString nonce = challenge.value("nonce").toString();
+    socket->write(ResolveCoordinator::encode(QJsonObject{{"type", "hello"},
+                                                         {"proof", ResolveCoordinator::proof(token, nonce)},
+                                                         {"environment", environment},
+                                                         {"slots", capacity},
+                                                         {"name", "fake"}}));
+    return socket;
+}
+
+/****************************************************************
+ * @class TestCoordinator
+ ***************************************************************/
+class TestCoordinator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dispatchesQueuedTestsToWorkers();
+    void requeuesTestsOfLostWorkers();
+    void rejectsOtherEnvironments();
+    void cancelsRunningTests();
+    void requiresToken();
+    void closesSilentConnections();
+};
+
+void TestCoordinator::dispatchesQueuedTestsToWorkers()
+{
+    QTemporaryDir dir;
+    ResolveCoordinator coordinator;
+    coordinator.setEnvironment("python=3.11|os=Linux");
+    coordinator.setWorkDir(dir.path());
+    coordinator.setFindLinks("/shared/wheelhouse", true);
+    coordinator.setToken(kToken);
+    QVERIFY(coordinator.listen(0));
+    QSignalSpy slotsSpy(&coordinator, &ResolveCoordinator::slotsChanged);
+    QSignalSpy finishedSpy(&coordinator, &ResolveCoordinator::testFinished);
+    QSignalSpy classifiedSpy(&coordinator, &ResolveCoordinator::failureClassified);
+
+    coordinator.runTest(1, {"a==1", "b==2"});
+    coordinator.runTest(2, {"a==2", "b==2"});
+    coordinator.runTest(3, {"a==3", "b==2"});
+    QCOMPARE(coordinator.testsQueued(), 3);
+
+    std::unique_ptr<QTcpSocket> worker(connectWorker(coordinator, "python=3.11|os=Linux", 2));
+    QVERIFY(worker);
+    QCOMPARE(nextMessage(worker.get()).value("type").toString(), QString("welcome"));
+    QTRY_COMPARE(slotsSpy.size(), 1);
+    QCOMPARE(slotsSpy.last().at(0).toInt(), 2);
+    QCOMPARE(coordinator.workerCount(), 1);
+
+    const QJsonObject first = nextMessage(worker.get());
+    const QJsonObject second = nextMessage(worker.get());
+    QCOMPARE(first.value("type").toString(), QString("test"));
+    QCOMPARE(first.value("id").toInt(), 1);
+    QCOMPARE(first.value("pins").toArray().size(), 2);
+    QCOMPARE(first.value("findLinks").toString(), QString("/shared/wheelhouse"));
+    QCOMPARE(first.value("offline").toBool(), true);
+    QCOMPARE(second.value("id").toInt(), 2);
+    QCOMPARE(coordinator.testsQueued(), 1); // both slots busy
+
+    worker->write(ResolveCoordinator::encode(QJsonObject{{"type", "result"}, {"id", 2}, {"passed", true},
+                                                         {"compiled", "a==2\nb==2\n"}}));
+    QTRY_COMPARE(finishedSpy.size(), 1);
+    QCOMPARE(finishedSpy.at(0).at(0).toInt(), 2);
+    QCOMPARE(finishedSpy.at(0).at(1).value<TestOutcome>(), TestOutcome::Passed);
+    QFile compiled(finishedSpy.at(0).at(2).toString());
+    QVERIFY(compiled.open(QIODevice::ReadOnly));
+    QCOMPARE(compiled.readAll(), QByteArray("a==2\nb==2\n"));
+    compiled.close();
+    coordinator.discardOutputs();
+    QVERIFY(!compiled.exists());
+
+    // The freed slot takes the last queued test
+    QCOMPARE(nextMessage(worker.get()).value("id").toInt(), 3);
+    worker->write(ResolveCoordinator::encode(QJsonObject{{"type", "result"}, {"id", 1}, {"passed", false},
+                                                         {"log", "ERROR: ResolutionImpossible"},
+                                                         {"failure", "ResolutionImpossible"},
+                                                         {"blamed", QJsonArray{"a", "b"}}}));
+    QTRY_COMPARE(finishedSpy.size(), 2);
+    QCOMPARE(classifiedSpy.size(), 1);
+    QCOMPARE(classifiedSpy.at(0).at(0).toInt(), 1);
+    QCOMPARE(classifiedSpy.at(0).at(2).toStringList(), QStringList({"a", "b"}));
+    QCOMPARE(finishedSpy.at(1).at(0).toInt(), 1);
+    QCOMPARE(finishedSpy.at(1).at(1).value<TestOutcome>(), TestOutcome::Failed);
+    QVERIFY(finishedSpy.at(1).at(2).toString().isEmpty());
+}
+
+void TestCoordinator::requeuesTestsOfLostWorkers()
+{
+    QTemporaryDir dir;
+    ResolveCoordinator coordinator;
+    coordinator.setEnvironment("env");
+    coordinator.setWorkDir(dir.path());
+    coordinator.setToken(kToken);
+    QVERIFY(coordinator.listen(0));
+    QSignalSpy slotsSpy(&coordinator, &ResolveCoordinator::slotsChanged);
+
+    std::unique_ptr<QTcpSocket> lost(connectWorker(coordinator, "env", 1));
+    QVERIFY(lost);
+    QCOMPARE(nextMessage(lost.get()).value("type").toString(), QString("welcome"));
+    coordinator.runTest(7, {"x==1"});
+    QCOMPARE(nextMessage(lost.get()).value("id").toInt(), 7);
+
+    std::unique_ptr<QTcpSocket> spare(connectWorker(coordinator, "env", 1));
+    QVERIFY(spare);
+    QCOMPARE(nextMessage(spare.get()).value("type").toString(), QString("welcome"));
+    QTRY_COMPARE(coordinator.slotCount(), 2);
+
+    lost->abort();
+    QCOMPARE(nextMessage(spare.get()).value("id").toInt(), 7);
+    QTRY_COMPARE(coordinator.workerCount(), 1);
+    QCOMPARE(slotsSpy.last().at(0).toInt(), 1);
+}
+
+void TestCoordinator::rejectsOtherEnvironments()
+{
+    ResolveCoordinator coordinator;
+    coordinator.setEnvironment("python=3.11");
+    coordinator.setToken(kToken);
+    QVERIFY(coordinator.listen(0));
+
+    std::unique_ptr<QTcpSocket> wrongEnvironment(connectWorker(coordinator, "python=3.10", 4));
+    QVERIFY(wrongEnvironment);
+    QCOMPARE(nextMessage(wrongEnvironment.get()).value("type").toString(), QString("reject"));
+
+    std::unique_ptr<QTcpSocket> wrongToken(connectWorker(coordinator, "python=3.11", 4, "guess"));
+    QVERIFY(wrongToken);
+    QCOMPARE(nextMessage(wrongToken.get()).value("type").toString(), QString("reject"));
+    QCOMPARE(coordinator.workerCount(), 0);
+
+    std::unique_ptr<QTcpSocket> good(connectWorker(coordinator, "python=3.11", 4));
+    QVERIFY(good);
+    QCOMPARE(nextMessage(good.get()).value("type").toString(), QString("welcome"));
+    QCOMPARE(coordinator.slotCount(), 4);
+}
+
+void TestCoordinator::cancelsRunningTests()
+{
+    QTemporaryDir dir;
+    ResolveCoordinator coordinator;
+    coordinator.setEnvironment("env");
+    coordinator.setWorkDir(dir.path());
+    coordinator.setToken(kToken);
+    QVERIFY(coordinator.listen(0));
+    QSignalSpy finishedSpy(&coordinator, &ResolveCoordinator::testFinished);
+
+    std::unique_ptr<QTcpSocket> worker(connectWorker(coordinator, "env", 1));
+    QVERIFY(worker);
+    QCOMPARE(nextMessage(worker.get()).value("type").toString(), QString("welcome"));
+    coordinator.runTest(1, {"a==1"});
+    coordinator.runTest(2, {"a==2"});
+    QCOMPARE(nextMessage(worker.get()).value("id").toInt(), 1);
+
+    coordinator.cancelAll();
+    QCOMPARE(nextMessage(worker.get()).value("type").toString(), QString("cancel"));
+    QCOMPARE(coordinator.testsQueued(), 0);
+
+    // A late result of a cancelled test is ignored
+    worker->write(ResolveCoordinator::encode(QJsonObject{{"type", "result"}, {"id", 1}, {"passed", true}}));
+    QTest::qWait(100);
+    QCOMPARE(finishedSpy.size(), 0);
+    QCOMPARE(coordinator.workerCount(), 1);
+}
+
+/****************************************************************
+ * @brief No port without a token; the token itself in the hello
+ *        is no proof.
+ ***************************************************************/
+void TestCoordinator::requiresToken()
+{
+    ResolveCoordinator open;
+    QString error;
+    QVERIFY(!open.listen(0, &error));
+    QVERIFY(!error.isEmpty());
+
+    ResolveCoordinator coordinator;
+    coordinator.setEnvironment("env");
+    coordinator.setToken(kToken);
+    QVERIFY(coordinator.listen(0, &error, QHostAddress::LocalHost));
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, coordinator.serverPort());
+    QVERIFY(socket.waitForConnected(5000));
+    const QJsonObject challenge = nextMessage(&socket);
+    QCOMPARE(challenge.value("type").toString(), QString("challenge"));
+    QCOMPARE(challenge.value("nonce").toString().size(), 64);
+    socket.write(ResolveCoordinator::encode(QJsonObject{{"type", "hello"}, {"token", kToken},
+                                                        {"environment", "env"}, {"slots", 1}}));
+    QCOMPARE(nextMessage(&socket).value("type").toString(), QString("reject"));
+    QCOMPARE(coordinator.workerCount(), 0);
+
+    // Every connection gets its own nonce
+    std::unique_ptr<QTcpSocket> first(connectWorker(coordinator, "env", 1));
+    std::unique_ptr<QTcpSocket> second(connectWorker(coordinator, "env", 1));
+    QVERIFY(first && second);
+    QCOMPARE(nextMessage(first.get()).value("type").toString(), QString("welcome"));
+    QCOMPARE(nextMessage(second.get()).value("type").toString(), QString("welcome"));
+    QVERIFY(ResolveCoordinator::proof(kToken, "a") != ResolveCoordinator::proof(kToken, "b"));
+}
+
+void TestCoordinator::closesSilentConnections()
+{
+    ResolveCoordinator coordinator;
+    coordinator.setEnvironment("env");
+    coordinator.setToken(kToken);
+    coordinator.setHelloTimeout(100);
+    QVERIFY(coordinator.listen(0));
+
+    QTcpSocket silent;
+    silent.connectToHost(QHostAddress::LocalHost, coordinator.serverPort());
+    QVERIFY(silent.waitForConnected(5000));
+    std::unique_ptr<QTcpSocket> worker(connectWorker(coordinator, "env", 1));
+    QVERIFY(worker);
+    QCOMPARE(nextMessage(worker.get()).value("type").toString(), QString("welcome"));
+    QTRY_COMPARE(silent.state(), QAbstractSocket::UnconnectedState);
+
+    // An accepted worker is not affected
+    QTest::qWait(200);
+    QCOMPARE(worker->state(), QAbstractSocket::ConnectedState);
+    QCOMPARE(coordinator.workerCount(), 1);
+}
+
+QTEST_GUILESS_MAIN(TestCoordinator)
+#include "test_coordinator.moc"
+/************** End of test_coordinator.cpp *********************/
@@ -0,0 +1,186 @@
+/****************************************************************
+ * @file test_dependencygraph.cpp
+ * @brief Unit tests for DependencyGraph and the specifier check
+ *        it shares with CandidateFetcher.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * The requires_dist entries below are trimmed from the published
+ * tensorflow and tensorboard metadata.
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include "CandidateFetcher.h"
+#include "DependencyGraph.h"
+#include "PackedVersion.h"
+
+/****************************************************************
+ * @brief tensorflow, tensorboard, numpy and one unpinned line.
+ ***************************************************************/
+static QVector<PackageCandidates> stack()
+{
+    return {
+        PackageCandidates{"tensorflow", {"2.14.1", "2.15.1", "2.16.2"}},
+        PackageCandidates{"tensorboard", {"2.16.2", "2.15.2", "2.14.1"}},
+        PackageCandidates{"numpy", {"1.21.6", "1.23.5", "1.26.4", "2.0.2"}},
+        PackageCandidates{"requests", {""}},
+    };
+}
+
+static DependencyGraph stackGraph()
+{
+    DependencyGraph graph(stack());
+    graph.addRequiresDist(0, 0, {"tensorboard<2.15,>=2.14", "numpy>=1.23.5", "requests<3,>=2.21.0"});
+    graph.addRequiresDist(0, 1, {"tensorboard<2.16,>=2.15", "numpy<2.0.0,>=1.23.5"});
+    graph.addRequiresDist(0, 2, {"tensorboard<2.17,>=2.16",
+                                 "numpy<2.0.0,>=1.26.0; python_version >= \"3.12\"",
+                                 "numpy<2.0.0,>=1.23.5; python_version <= \"3.11\""});
+    for (int v = 0; v < 3; ++v)
+    {
+        graph.addRequiresDist(1, v, {"numpy>=1.22.0", "numpy<2.0.0rc1", "six>1.9"});
+    }
+    return graph;
+}
+
+/****************************************************************
+ * @class TestDependencyGraph
+ ***************************************************************/
+class TestDependencyGraph : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void satisfiesSpecifiers();
+    void buildsEdgesFromRequiresDist();
+    void eliminatesUnsupportedCandidates();
+    void ordersMostConstrainedFirst();
+    void appliesToMatrix();
+};
+
+void TestDependencyGraph::satisfiesSpecifiers()
+{
+    QVERIFY(CandidateFetcher::satisfies(Requirement::parse("x~=1.4.2"), "1.4.9"));
+    QVERIFY(!CandidateFetcher::satisfies(Requirement::parse("x~=1.4.2"), "1.5"));
+    QVERIFY(CandidateFetcher::satisfies(Requirement::parse("x==2.*"), "2.3"));
+    QVERIFY(!CandidateFetcher::satisfies(Requirement::parse("x==2.*"), "3.0"));
+    QVERIFY(!CandidateFetcher::satisfies(Requirement::parse("x (>=1.2, !=1.3)"), "1.3.0"));
+    // requires_dist pins "==" exactly, unlike candidate selection
+    QVERIFY(CandidateFetcher::satisfies(Requirement::parse("x==1.1"), "1.1.0"));
+    QVERIFY(!CandidateFetcher::satisfies(Requirement::parse("x==1.1"), "1.2"));
+    QVERIFY(!CandidateFetcher::satisfies(Requirement::parse("x==1.1"), "1.99999"));
+    QVERIFY(!CandidateFetcher::satisfies(Requirement::parse("x!=1.4.*"), "1.4.2"));
+    QVERIFY(CandidateFetcher::satisfies(Requirement::parse("x!=1.4.*"), "1.5"));
+    // Too wide to pack: the release numbers are compared instead
+    QVERIFY(!CandidateFetcher::satisfies(Requirement::parse("x!=1.4.*"), "1.4.99999"));
+    QVERIFY(CandidateFetcher::satisfies(Requirement::parse("x!=1.4.*"), "1.99999"));
+    QVERIFY(CandidateFetcher::satisfies(Requirement::parse("x===1.0+local"), "1.0+local"));
+
+    // Same answer as the packed filter DependencyGraph uses
+    const QStringList lines = {"x==1.4", "x~=1.4.2", "x>1.4", "x<=1.4", "x!=1.4.*", "x==1.4.*", "x (>=1.2, !=1.4.2)"};
+    const QStringList versions = {"1", "1.2", "1.4", "1.4.0", "1.4.2", "1.4.10", "1.5", "2.0"};
+    for (int l = 0; l < lines.size(); ++l)
+    {
+        const Requirement requirement = Requirement::parse(lines.at(l));
+        const SpecifierSet set = SpecifierSet::compile(requirement);
+        QVERIFY(set.isValid());
+        for (int v = 0; v < versions.size(); ++v)
+        {
+            PackedVersion packed;
+            QVERIFY(PackedVersion::pack(versions.at(v), &packed));
+            QCOMPARE(CandidateFetcher::satisfies(requirement, versions.at(v)), set.matches(packed));
+        }
+    }
+}
+
+/****************************************************************
+ * @brief Markers, pre-release bounds, unpinned columns and
+ *        projects outside the matrix add no edge.
+ ***************************************************************/
+void TestDependencyGraph::buildsEdgesFromRequiresDist()
+{
+    const DependencyGraph graph = stackGraph();
+    QCOMPARE(graph.columnCount(), 4);
+    // tensorflow -> tensorboard x3, -> numpy x2; tensorboard -> numpy x3
+    QCOMPARE(graph.edgeCount(), 8);
+
+    QVERIFY(graph.compatible(0, 1, 1, 1));
+    QVERIFY(!graph.compatible(0, 1, 1, 2));
+    QVERIFY(!graph.compatible(1, 2, 0, 1)); // either direction
+    QVERIFY(!graph.compatible(0, 1, 2, 3));
+    QVERIFY(graph.compatible(0, 2, 2, 3));  // only bounded behind a marker
+    QVERIFY(graph.compatible(1, 2, 2, 3));  // "<2.0.0rc1" is not compared
+    QVERIFY(graph.compatible(0, 0, 3, 0));
+}
+
+void TestDependencyGraph::eliminatesUnsupportedCandidates()
+{
+    DependencyGraph graph = stackGraph();
+    QCOMPARE(graph.eliminate(), 1);
+    QVERIFY(!graph.isViable(2, 0)); // numpy 1.21.6: below tensorboard's floor
+    QVERIFY(graph.isViable(2, 3));
+    QCOMPARE(graph.eliminate(), 0);
+
+    // The last candidate of a column stays for pip-compile to report
+    DependencyGraph single(QVector<PackageCandidates>{{"a", {"1.0"}}, {"b", {"1.0"}}});
+    single.addRequiresDist(0, 0, {"b>=2"});
+    QCOMPARE(single.eliminate(), 0);
+    QVERIFY(!single.compatible(0, 0, 1, 0));
+}
+
+void TestDependencyGraph::ordersMostConstrainedFirst()
+{
+    DependencyGraph graph = stackGraph();
+    graph.eliminate();
+    // requests: 1 candidate; tensorflow: 7 clashing pairs,
+    // tensorboard: 6, numpy: 1
+    QCOMPARE(graph.searchOrder(), QVector<int>({3, 0, 1, 2}));
+}
+
+void TestDependencyGraph::appliesToMatrix()
+{
+    DependencyGraph graph = stackGraph();
+    graph.eliminate();
+    QVector<PackageCandidates> packages = stack();
+    const QVector<ResolverSet> conflicts = graph.apply(&packages);
+
+    QCOMPARE(packages.size(), 4);
+    QCOMPARE(packages.at(0).name, QString("requests"));
+    QCOMPARE(packages.at(1).name, QString("tensorflow"));
+    QCOMPARE(packages.at(3).versions, QStringList({"1.23.5", "1.26.4", "2.0.2"}));
+
+    QCOMPARE(conflicts.size(), 7);
+    bool found = false;
+    for (int i = 0; i < conflicts.size(); ++i)
+    {
+        QCOMPARE(conflicts.at(i).size(), 2);
+        QVERIFY(conflicts.at(i).at(0).package < conflicts.at(i).at(1).package);
+        found = found
+                || (conflicts.at(i).at(0).package == 1 && conflicts.at(i).at(0).version == 1
+                    && conflicts.at(i).at(1).package == 3 && conflicts.at(i).at(1).version == 2);
+    }
+    QVERIFY(found); // tensorflow 2.15.1 x numpy 2.0.2
+
+    // Seeded into the engine, tensorboard 2.16.2 and 2.15.2 are
+    // skipped next to tensorflow 2.14.1 without compiling
+    ResolverEngine engine;
+    engine.setCandidates(packages);
+    engine.setStaticConflicts(conflicts);
+    QList<QStringList> requested;
+    connect(&engine, &ResolverEngine::testRequested, this,
+            [&](int testId, const QStringList &pins) {
+                requested << pins;
+                engine.reportTestResult(testId, TestOutcome::Passed, QString());
+            });
+    QSignalSpy resolved(&engine, &ResolverEngine::resolved);
+    QVERIFY(engine.start());
+    QCOMPARE(resolved.size(), 1);
+    QCOMPARE(requested.size(), 1);
+    QCOMPARE(requested.first(),
+             QStringList({"requests", "tensorflow==2.14.1", "tensorboard==2.14.1", "numpy==1.23.5"}));
+}
+
+QTEST_GUILESS_MAIN(TestDependencyGraph)
+#include "test_dependencygraph.moc"
+/************** End of test_dependencygraph.cpp *****************/
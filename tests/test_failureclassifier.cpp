@@ -0,0 +1,178 @@
+/****************************************************************
+ * @file test_failureclassifier.cpp
+ * @brief Unit tests for FailureClassifier.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * The stderr samples are pip 24 output, as printed through
+ * pip-compile.
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include "FailureClassifier.h"
+
+static const char kResolutionImpossible[] =
+    "ERROR: Cannot install -r requirements.in (line 1) and numpy==1.21.6 because these package versions"
+    " have conflicting dependencies.\n"
+    "\n"
+    "The conflict is caused by:\n"
+    "    The user requested numpy==1.21.6\n"
+    "    tensorflow 2.15.1 depends on numpy<2.0.0 and >=1.23.5\n"
+    "\n"
+    "To fix this you could try to:\n"
+    "1. loosen the range of package versions you've specified\n"
+    "2. remove package versions to allow pip to attempt to solve the dependency conflict\n"
+    "\n"
+    "ERROR: ResolutionImpossible: for help visit"
+    " https://pip.pypa.io/en/latest/topics/dependency-resolution/#dealing-with-dependency-conflicts\n";
+
+/****************************************************************
+ * @class TestFailureClassifier
+ ***************************************************************/
+class TestFailureClassifier : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decidesResolutionImpossible();
+    void decidesNoMatchingDistribution();
+    void decidesBuildFailure();
+    void separatesEnvironmentFailures();
+    void blamesSetupImportingPip();
+    void ignoresOtherOutput();
+};
+
+/****************************************************************
+ * @brief Chunks split lines anywhere; the verdict comes with the
+ *        ResolutionImpossible line and names both packages.
+ ***************************************************************/
+void TestFailureClassifier::decidesResolutionImpossible()
+{
+    const QByteArray text(kResolutionImpossible);
+    const qsizetype last = text.indexOf("ERROR: ResolutionImpossible");
+    FailureClassifier classifier;
+    for (qsizetype i = 0; i < last; i += 7)
+    {
+        QVERIFY(!classifier.feed(text.mid(i, qMin<qsizetype>(7, last - i))));
+    }
+    QVERIFY(!classifier.isDecided());
+    QVERIFY(classifier.feed(text.mid(last)));
+    QCOMPARE(classifier.kind(), FailureClassifier::Kind::ResolutionImpossible);
+    QCOMPARE(classifier.packages(), QStringList({"numpy", "tensorflow"}));
+    QVERIFY(classifier.reason().startsWith("ERROR: ResolutionImpossible"));
+    QCOMPARE(FailureClassifier::kindName(classifier.kind()), QString("ResolutionImpossible"));
+
+    // Decided stays decided until reset()
+    QVERIFY(classifier.feed("anything\n"));
+    classifier.reset();
+    QVERIFY(!classifier.isDecided());
+    QVERIFY(classifier.packages().isEmpty());
+}
+
+void TestFailureClassifier::decidesNoMatchingDistribution()
+{
+    FailureClassifier classifier;
+    QVERIFY(!classifier.feed("ERROR: Could not find a version that satisfies the requirement Torch_Audio==9.9 "
+                             "(from versions: 2.0.1, 2.1.0)\n"));
+    // No newline yet: finish() matches the last line
+    QVERIFY(!classifier.feed("ERROR: No matching distribution found for Torch_Audio==9.9"));
+    QVERIFY(classifier.finish());
+    QCOMPARE(classifier.kind(), FailureClassifier::Kind::NoMatchingDistribution);
+    QCOMPARE(classifier.packages(), QStringList({"torch-audio"}));
+}
+
+void TestFailureClassifier::decidesBuildFailure()
+{
+    FailureClassifier classifier;
+    QVERIFY(!classifier.feed("Collecting pycocotools==2.0.2\n"
+                             "  Using cached pycocotools-2.0.2.tar.gz (23 kB)\n"
+                             "  Preparing metadata (setup.py) ... error\n"
+                             "  error: subprocess-exited-with-error\n"
+                             "  \xc3\x97 python setup.py egg_info did not run successfully.\n"));
+    QVERIFY(classifier.feed("error: metadata-generation-failed\n\r\n"));
+    QCOMPARE(classifier.kind(), FailureClassifier::Kind::BuildFailure);
+    QCOMPARE(classifier.packages(), QStringList({"pycocotools"}));
+
+    classifier.reset();
+    QVERIFY(classifier.feed("ERROR: Failed building wheel for lap\r\n"));
+    QCOMPARE(classifier.kind(), FailureClassifier::Kind::BuildFailure);
+    QCOMPARE(classifier.packages(), QStringList({"lap"}));
+}
+
+/****************************************************************
+ * @brief "No matching distribution" after network errors, and a
+ *        venv without pip-tools, are no verdict on the pins.
+ ***************************************************************/
+void TestFailureClassifier::separatesEnvironmentFailures()
+{
+    FailureClassifier classifier;
+    QVERIFY(!classifier.feed("WARNING: Retrying (Retry(total=4, connect=None, read=None, redirect=None, status=None))"
+                             " after connection broken by 'NewConnectionError(\"Failed to establish a new connection:"
+                             " [Errno -3] Temporary failure in name resolution\")': /simple/numpy/\n"
+                             "ERROR: Could not find a version that satisfies the requirement numpy==1.26.4"
+                             " (from versions: none)\n"));
+    QVERIFY(classifier.feed("ERROR: No matching distribution found for numpy==1.26.4\n"));
+    QCOMPARE(classifier.kind(), FailureClassifier::Kind::Environment);
+
+    // Network trouble alone decides nothing until the process ends
+    classifier.reset();
+    QVERIFY(!classifier.feed("WARNING: Retrying (Retry(total=4)) after connection broken by 'ReadTimeoutError'\n"));
+    QVERIFY(classifier.finish());
+    QCOMPARE(classifier.kind(), FailureClassifier::Kind::Environment);
+
+    classifier.reset();
+    QVERIFY(classifier.feed("/tmp/worker_0/venv/bin/python: No module named piptools\n"));
+    QCOMPARE(classifier.kind(), FailureClassifier::Kind::Environment);
+    QCOMPARE(FailureClassifier::kindName(classifier.kind()), QString("Environment"));
+
+    // A crash of pip itself is no verdict on the pins
+    classifier.reset();
+    QVERIFY(classifier.feed("Traceback (most recent call last):\n"
+                            "  File \"/venv/lib/python3.12/site-packages/piptools/scripts/compile.py\", line 9\n"));
+    QCOMPARE(classifier.kind(), FailureClassifier::Kind::Environment);
+}
+
+/****************************************************************
+ * @brief A setup.py that imports pip fails its own build; that is
+ *        the candidate's fault, not the venv's.
+ ***************************************************************/
+void TestFailureClassifier::blamesSetupImportingPip()
+{
+    FailureClassifier classifier;
+    QVERIFY(!classifier.feed("Collecting oldpkg==0.1\n"
+                             "  Downloading oldpkg-0.1.tar.gz (5 kB)\n"
+                             "  Preparing metadata (setup.py): started\n"
+                             "  error: subprocess-exited-with-error\n"
+                             "  python setup.py egg_info did not run successfully.\n"
+                             "  exit code: 1\n"
+                             "  [5 lines of output]\n"
+                             "      Traceback (most recent call last):\n"
+                             "        File \"/tmp/pip-install-x/oldpkg/setup.py\", line 3, in <module>\n"
+                             "          from pip.req import parse_requirements\n"
+                             "      ModuleNotFoundError: No module named 'pip.req'\n"
+                             "      [end of output]\n"));
+    QVERIFY(!classifier.isDecided());
+    QVERIFY(!classifier.feed("      ModuleNotFoundError: No module named 'pip'\n"));
+    QVERIFY(classifier.feed("error: metadata-generation-failed\n"));
+    QCOMPARE(classifier.kind(), FailureClassifier::Kind::BuildFailure);
+    QCOMPARE(classifier.packages(), QStringList({"oldpkg"}));
+}
+
+void TestFailureClassifier::ignoresOtherOutput()
+{
+    FailureClassifier classifier;
+    QVERIFY(!classifier.feed("WARNING: the legacy dependency resolver is deprecated\n"
+                             "INFO: pip is looking at multiple versions of numpy to determine which version"
+                             " is compatible with other requirements. This could take a while.\n"));
+    // An endless progress bar is dropped, not buffered forever
+    QVERIFY(!classifier.feed(QByteArray(FailureClassifier::kMaxLineBytes + 1, '#')));
+    QVERIFY(!classifier.isDecided());
+    QVERIFY(classifier.feed("\nERROR: ResolutionImpossible\n"));
+    QVERIFY(classifier.packages().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestFailureClassifier)
+#include "test_failureclassifier.moc"
+/************** End of test_failureclassifier.cpp ***************/
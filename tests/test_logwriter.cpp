@@ -0,0 +1,158 @@
+/****************************************************************
+ * @file test_logwriter.cpp
+ * @brief Unit tests for LogWriter.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include "LogWriter.h"
+
+static QStringList segmentFiles(const QString &dir)
+{
+    return QDir(dir).entryList({"session-*"}, QDir::Files, QDir::Name);
+}
+
+/****************************************************************
+ * @class TestLogWriter
+ ***************************************************************/
+class TestLogWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writesJsonLines();
+    void findsCombinationOutput();
+    void rotatesAndCompresses();
+    void deletesOldestAboveLimit();
+    void continuesNumberingAfterRestart();
+};
+
+void TestLogWriter::writesJsonLines()
+{
+    QTemporaryDir dir;
+    LogWriter writer;
+    QVERIFY(writer.open(dir.path(), "session"));
+    writer.write("app", LogWriter::Level::Info, "first");
+    writer.write("terminal", LogWriter::Level::Error, "line\nwith \"quotes\"");
+    writer.flush();
+
+    QFile file(writer.currentSegment());
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    QCOMPARE(lines.size(), 3);
+    QVERIFY(lines.last().isEmpty());
+    const QJsonObject second = QJsonDocument::fromJson(lines.at(1)).object();
+    QCOMPARE(second.value("source").toString(), QString("terminal"));
+    QCOMPARE(second.value("level").toString(), QString("error"));
+    QCOMPARE(second.value("message").toString(), QString("line\nwith \"quotes\""));
+    QVERIFY(!second.value("time").toString().isEmpty());
+    QCOMPARE(writer.dropped(), qint64(0));
+}
+
+void TestLogWriter::findsCombinationOutput()
+{
+    QCOMPARE(LogWriter::combinationId({"a==1", "b==2"}), LogWriter::combinationId({"b==2", "a==1"}));
+    QVERIFY(LogWriter::combinationId({"a==1"}) != LogWriter::combinationId({"a==2"}));
+
+    QTemporaryDir dir;
+    LogWriter writer;
+    QVERIFY(writer.open(dir.path(), "session"));
+    writer.writeTest(1, {"a==1", "b==2"}, false, "ERROR: first try");
+    writer.write("app", LogWriter::Level::Info, "between");
+    writer.writeTest(7, {"b==2", "a==1"}, false, "ERROR: Could not find a version");
+    writer.flush();
+
+    QJsonObject record;
+    QVERIFY(LogWriter::readCombination(dir.path(), "session", LogWriter::combinationId({"a==1", "b==2"}),
+                                       &record));
+    QCOMPARE(record.value("test").toInt(), 7); // newest wins
+    QCOMPARE(record.value("passed").toBool(), false);
+    QCOMPARE(record.value("output").toString(), QString("ERROR: Could not find a version"));
+    QCOMPARE(record.value("pins").toArray().size(), 2);
+    QVERIFY(!LogWriter::readCombination(dir.path(), "session", LogWriter::combinationId({"c==1"}), &record));
+}
+
+void TestLogWriter::rotatesAndCompresses()
+{
+    QTemporaryDir dir;
+    LogWriter writer;
+    writer.setSegmentBytes(4096);
+    writer.setCompressRotated(true);
+    QVERIFY(writer.open(dir.path(), "session"));
+    const QByteArray output(1500, 'x');
+    for (int i = 0; i < 10; ++i)
+    {
+        writer.writeTest(i, {QString("p==%1").arg(i)}, true, output);
+    }
+    writer.flush();
+
+    const QStringList files = segmentFiles(dir.path());
+    QVERIFY(files.contains("session-000001.log.z"));
+    QVERIFY(!files.contains("session-000001.log"));
+    QVERIFY(files.contains("session-000001.idx"));
+    QVERIFY(writer.currentSegment().endsWith(".log"));
+    QVERIFY(!writer.currentSegment().endsWith("session-000001.log"));
+
+    // Read back from the compressed first segment and the open last one
+    QJsonObject record;
+    QVERIFY(LogWriter::readCombination(dir.path(), "session", LogWriter::combinationId({"p==0"}), &record));
+    QCOMPARE(record.value("test").toInt(), 0);
+    QCOMPARE(record.value("output").toString().size(), 1500);
+    QVERIFY(LogWriter::readCombination(dir.path(), "session", LogWriter::combinationId({"p==9"}), &record));
+    QCOMPARE(record.value("test").toInt(), 9);
+}
+
+void TestLogWriter::deletesOldestAboveLimit()
+{
+    QTemporaryDir dir;
+    LogWriter writer;
+    writer.setSegmentBytes(4096);
+    writer.setCompressRotated(false);
+    writer.setMaxBytes(3 * 4096);
+    QVERIFY(writer.open(dir.path(), "session"));
+    const QByteArray output(1500, 'y');
+    for (int i = 0; i < 40; ++i)
+    {
+        writer.writeTest(i, {QString("q==%1").arg(i)}, false, output);
+    }
+    writer.flush();
+
+    const QStringList files = segmentFiles(dir.path());
+    QVERIFY(!files.contains("session-000001.log"));
+    QVERIFY(!files.contains("session-000001.idx"));
+    qint64 total = 0;
+    for (int i = 0; i < files.size(); ++i)
+    {
+        total += QFileInfo(QDir(dir.path()).filePath(files.at(i))).size();
+    }
+    QVERIFY(total <= 4 * 4096); // the limit plus the open segment
+    QVERIFY(!LogWriter::readCombination(dir.path(), "session", LogWriter::combinationId({"q==0"}), nullptr));
+    QVERIFY(LogWriter::readCombination(dir.path(), "session", LogWriter::combinationId({"q==39"}), nullptr));
+}
+
+void TestLogWriter::continuesNumberingAfterRestart()
+{
+    QTemporaryDir dir;
+    {
+        LogWriter writer;
+        QVERIFY(writer.open(dir.path(), "session"));
+        writer.writeTest(1, {"a==1"}, false, "old");
+    } // destructor writes the queue
+    LogWriter writer;
+    QVERIFY(writer.open(dir.path(), "session"));
+    QVERIFY(writer.currentSegment().endsWith("session-000002.log"));
+
+    QJsonObject record;
+    QVERIFY(LogWriter::readCombination(dir.path(), "session", LogWriter::combinationId({"a==1"}), &record));
+    QCOMPARE(record.value("output").toString(), QString("old"));
+}
+
+QTEST_GUILESS_MAIN(TestLogWriter)
+#include "test_logwriter.moc"
+/************** End of test_logwriter.cpp ***********************/
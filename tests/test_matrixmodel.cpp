@@ -0,0 +1,115 @@
+/****************************************************************
+ * @file test_matrixmodel.cpp
+ * @brief Unit tests for MatrixModel.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QAbstractItemModelTester>
+#include <QColor>
+#include "MatrixModel.h"
+
+static QVector<PackageCandidates> matrix(const QList<QPair<QString, QStringList>> &columns)
+{
+    QVector<PackageCandidates> packages;
+    for (int i = 0; i < columns.size(); ++i)
+    {
+        packages.append(PackageCandidates{columns.at(i).first, columns.at(i).second});
+    }
+    return packages;
+}
+
+/****************************************************************
+ * @class TestMatrixModel
+ ***************************************************************/
+class TestMatrixModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decodesRowsInOdometerOrder();
+    void colorsRowsByState();
+    void capsHugeMatrices();
+};
+
+void TestMatrixModel::decodesRowsInOdometerOrder()
+{
+    ResolverEngine engine;
+    engine.setCandidates(matrix({{"a", {"1", "2"}}, {"b", {"1", "2", "3"}}, {"c", {"", "9"}}}));
+    MatrixModel model(&engine);
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    model.reload();
+
+    QCOMPARE(model.rowCount(), 12);
+    QCOMPARE(model.columnCount(), 3);
+    QCOMPARE(model.headerData(1, Qt::Horizontal).toString(), QString("b"));
+    QCOMPARE(model.index(0, 0).data().toString(), QString("1"));
+    QCOMPARE(model.index(0, 2).data().toString(), QString("(any)"));
+    QCOMPARE(model.index(1, 2).data().toString(), QString("9"));
+    QCOMPARE(model.index(2, 1).data().toString(), QString("2"));
+    QCOMPARE(model.index(11, 0).data().toString(), QString("2"));
+    QCOMPARE(model.versionsAt(7), QVector<int>({1, 0, 1}));
+    for (int row = 0; row < model.rowCount(); ++row)
+    {
+        QCOMPARE(model.rowOf(model.versionsAt(row)), row);
+    }
+}
+
+void TestMatrixModel::colorsRowsByState()
+{
+    ResolverEngine engine;
+    // Everything with a==1 fails; the engine learns {a==1} and skips it
+    connect(&engine, &ResolverEngine::testRequested, &engine, [&engine](int id, const QStringList &pins) {
+        engine.reportTestResult(id, pins.contains("a==1") ? TestOutcome::Failed : TestOutcome::Passed, QString());
+    });
+    engine.setCandidates(matrix({{"a", {"1", "2"}}, {"b", {"1", "2", "3"}}}));
+    MatrixModel model(&engine);
+    model.reload();
+    QCOMPARE(model.stateAt(0), ResolverEngine::CombinationState::Pending);
+
+    QVERIFY(engine.start());
+    QCOMPARE(model.stateAt(0), ResolverEngine::CombinationState::Failed);
+    QCOMPARE(model.stateAt(1), ResolverEngine::CombinationState::Pruned);
+    QCOMPARE(model.stateAt(2), ResolverEngine::CombinationState::Pruned);
+    QCOMPARE(model.stateAt(3), ResolverEngine::CombinationState::Passed);
+    QCOMPARE(model.stateAt(4), ResolverEngine::CombinationState::Pending);
+
+    QVERIFY(model.index(0, 0).data(Qt::BackgroundRole).canConvert<QColor>());
+    QVERIFY(model.index(3, 1).data(Qt::BackgroundRole).canConvert<QColor>());
+    QVERIFY(!model.index(4, 0).data(Qt::BackgroundRole).isValid());
+    QVERIFY(model.index(0, 0).data(Qt::BackgroundRole) != model.index(3, 0).data(Qt::BackgroundRole));
+
+    // New candidates without reload(): cells go blank instead of stale
+    engine.setCandidates(matrix({{"x", {"1"}}}));
+    QVERIFY(!model.index(0, 0).data().isValid());
+}
+
+void TestMatrixModel::capsHugeMatrices()
+{
+    QList<QPair<QString, QStringList>> columns;
+    for (int i = 0; i < 20; ++i)
+    {
+        columns.append({QString("p%1").arg(i), {"1", "2", "3"}});
+    }
+    ResolverEngine engine;
+    engine.setCandidates(matrix(columns));
+    MatrixModel model(&engine);
+    model.reload();
+
+    QCOMPARE(model.rowCount(), std::numeric_limits<int>::max());
+    QCOMPARE(model.totalCombinations(), 3486784401.0);
+    const int last = model.rowCount() - 1;
+    QCOMPARE(model.rowOf(model.versionsAt(last)), last);
+    QCOMPARE(model.index(last, 19).data().toString(),
+             QString::number(model.versionsAt(last).at(19) + 1));
+    QVector<int> beyond(20, 0);
+    beyond[0] = 2;
+    QCOMPARE(model.rowOf(beyond), -1);
+}
+
+QTEST_GUILESS_MAIN(TestMatrixModel)
+#include "test_matrixmodel.moc"
+/************** End of test_matrixmodel.cpp *********************/
@@ -0,0 +1,190 @@
+/****************************************************************
+ * @file test_metadatastore.cpp
+ * @brief Unit tests for MetadataStore and its use by
+ *        CandidateFetcher.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * Stores are written to temporary directories. The fetcher test
+ * serves the recorded numpy fixture from a copy and removes it
+ * before the second lookup, which must then come from the store.
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "CandidateFetcher.h"
+#include "MetadataStore.h"
+
+static const QStringList kNumpy = {"1.26.4", "1.9.0", "2.0.0rc1", "1.10.1", "1.26.4.post1"};
+
+/****************************************************************
+ * @class TestMetadataStore
+ ***************************************************************/
+class TestMetadataStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void packsVersions();
+    void roundTripsReleases();
+    void keepsRequiresDist();
+    void mergesConcurrentSaves();
+    void replacesInvalidFile();
+    void servesFetcherFromStore();
+};
+
+void TestMetadataStore::packsVersions()
+{
+    QVector<quint32> components;
+    QVERIFY(MetadataStore::packVersion("1.26.4", &components));
+    QCOMPARE(components, QVector<quint32>({1, 26, 4}));
+    QVERIFY(MetadataStore::packVersion("2023.07.22", &components));
+    QCOMPARE(components, QVector<quint32>({2023, 7, 22}));
+    QVERIFY(!MetadataStore::packVersion("2.0.0rc1", &components));
+    QVERIFY(components.isEmpty());
+    QVERIFY(!MetadataStore::packVersion("1..2", &components));
+    QVERIFY(!MetadataStore::packVersion("", &components));
+    QVERIFY(!MetadataStore::packVersion("1.99999999999", &components));
+}
+
+void TestMetadataStore::roundTripsReleases()
+{
+    QTemporaryDir dir;
+    MetadataStore store;
+    QVERIFY(!store.open(dir.filePath("metadata.pmrm")));
+    store.setReleases("numpy", kNumpy, "\"n1\"");
+    store.setReleases("certifi", {"2023.07.22", "2024.2.2", "1.0", "1.0.0"}, QByteArray());
+    QCOMPARE(store.releases("numpy"), QStringList({"1.9.0", "1.10.1", "1.26.4"}));
+    QVERIFY(store.isDirty());
+    QVERIFY(store.save());
+    QVERIFY(store.isMapped());
+    QVERIFY(!store.isDirty());
+
+    MetadataStore reread;
+    QVERIFY(reread.open(store.path()));
+    QCOMPARE(reread.projectCount(), 2);
+    QCOMPARE(reread.releases("numpy"), QStringList({"1.9.0", "1.10.1", "1.26.4"}));
+    QCOMPARE(reread.releases("certifi"), QStringList({"1.0", "2023.07.22", "2024.2.2"}));
+    QCOMPARE(reread.etag("numpy"), QByteArray("\"n1\""));
+    QVERIFY(reread.etag("certifi").isEmpty());
+    QVERIFY(reread.checked("numpy") > 0);
+    QVERIFY(!reread.contains("torch"));
+    QVERIFY(reread.releases("torch").isEmpty());
+    QCOMPARE(reread.checked("torch"), qint64(0));
+}
+
+void TestMetadataStore::keepsRequiresDist()
+{
+    QTemporaryDir dir;
+    MetadataStore store;
+    store.open(dir.filePath("metadata.pmrm"));
+    store.setReleases("tensorflow", {"2.15.1", "2.16.2"}, "\"t1\"");
+    QStringList entries;
+    QVERIFY(!store.requiresDist("tensorflow", "2.15.1", &entries));
+    store.setRequiresDist("tensorflow", "2.15.1", {"numpy<2.0.0,>=1.23.5", "tensorboard<2.16,>=2.15"});
+    store.setRequiresDist("tensorflow", "2.16.2", {});
+    store.setRequiresDist("tensorflow", "9.9", {"ignored"});
+    store.setRequiresDist("keras", "3.0.0", {"ignored"});
+    QVERIFY(store.save());
+
+    MetadataStore reread;
+    QVERIFY(reread.open(store.path()));
+    QVERIFY(reread.requiresDist("tensorflow", "2.15.1", &entries));
+    QCOMPARE(entries, QStringList({"numpy<2.0.0,>=1.23.5", "tensorboard<2.16,>=2.15"}));
+    QVERIFY(reread.requiresDist("tensorflow", "2.16.2", &entries));
+    QVERIFY(entries.isEmpty());
+    QVERIFY(!reread.requiresDist("tensorflow", "9.9", &entries));
+    QVERIFY(!reread.contains("keras"));
+
+    // A new release list keeps what is known of the releases still in it
+    reread.setReleases("tensorflow", {"2.15.1", "2.17.0"}, "\"t2\"");
+    QVERIFY(reread.requiresDist("tensorflow", "2.15.1", &entries));
+    QCOMPARE(entries.size(), 2);
+    QVERIFY(!reread.requiresDist("tensorflow", "2.17.0", &entries));
+}
+
+void TestMetadataStore::mergesConcurrentSaves()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("metadata.pmrm");
+    MetadataStore first;
+    MetadataStore second;
+    first.open(path);
+    second.open(path);
+    first.setReleases("numpy", {"1.26.4"}, QByteArray());
+    second.setReleases("torch", {"2.3.1"}, QByteArray());
+    QVERIFY(first.save());
+    QVERIFY(second.save());
+
+    MetadataStore reread;
+    QVERIFY(reread.open(path));
+    QVERIFY(reread.contains("numpy"));
+    QVERIFY(reread.contains("torch"));
+}
+
+void TestMetadataStore::replacesInvalidFile()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("metadata.pmrm");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(64, 'x'));
+    file.close();
+
+    MetadataStore store;
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Ignoring invalid metadata store"));
+    QVERIFY(!store.open(path));
+    QVERIFY(!store.contains("numpy"));
+    store.setReleases("numpy", {"1.26.4"}, QByteArray());
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Ignoring invalid metadata store"));
+    QVERIFY(store.save()); // merges with the file first
+    QVERIFY(store.isMapped());
+    QVERIFY(store.contains("numpy"));
+}
+
+/****************************************************************
+ * @brief Runs one lookup of numpy>=1.23 against a local index.
+ ***************************************************************/
+static QVector<PackageCandidates> fetchNumpy(const QString &indexDir, const QString &cacheDir)
+{
+    CandidateFetcher fetcher;
+    fetcher.setCacheDir(QDir(cacheDir).filePath("http"));
+    fetcher.setMetadataDir(cacheDir);
+    fetcher.setIndexUrl(QUrl::fromLocalFile(indexDir).toString());
+    fetcher.setMatrixRange(1);
+    QVector<PackageCandidates> packages;
+    bool ready = false;
+    QObject::connect(&fetcher, &CandidateFetcher::candidatesReady, &fetcher,
+                     [&](const QVector<PackageCandidates> &found)
+                     {
+                         packages = found;
+                         ready = true;
+                     });
+    fetcher.fetch(QStringList{"numpy>=1.23"});
+    QTest::qWaitFor([&]() { return ready; }, 10000);
+    return packages;
+}
+
+void TestMetadataStore::servesFetcherFromStore()
+{
+    QTemporaryDir index;
+    QTemporaryDir cache;
+    QVERIFY(QDir().mkpath(index.filePath("numpy")));
+    QVERIFY(QFile::copy(QStringLiteral(PMR_FIXTURES_DIR "/pypi/numpy/json"), index.filePath("numpy/json")));
+
+    const QVector<PackageCandidates> first = fetchNumpy(index.path(), cache.path());
+    QCOMPARE(first.size(), 1);
+    QCOMPARE(first.at(0).versions, QStringList({"1.23.0", "1.24.4"}));
+
+    // The index is gone; the releases checked a moment ago are stored
+    QVERIFY(QFile::remove(index.filePath("numpy/json")));
+    const QVector<PackageCandidates> second = fetchNumpy(index.path(), cache.path());
+    QCOMPARE(second.size(), 1);
+    QCOMPARE(second.at(0).versions, first.at(0).versions);
+}
+
+QTEST_GUILESS_MAIN(TestMetadataStore)
+#include "test_metadatastore.moc"
+/************** End of test_metadatastore.cpp *******************/
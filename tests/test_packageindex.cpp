@@ -0,0 +1,120 @@
+/****************************************************************
+ * @file test_packageindex.cpp
+ * @brief Unit tests for PackageIndex.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "PackageIndex.h"
+
+/****************************************************************
+ * @class TestPackageIndex
+ ***************************************************************/
+class TestPackageIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void normalizesNames();
+    void takesAnchorsAcrossChunks();
+    void buildsSortedUniqueNames();
+    void ranksPrefixThenSubstringThenTypos();
+    void savesAndLoads();
+    void rejectsMalformedFile();
+    void boundsEditDistance();
+};
+
+void TestPackageIndex::normalizesNames()
+{
+    QCOMPARE(PackageIndex::normalize("Foo__Bar.baz"), QByteArray("foo-bar-baz"));
+    QCOMPARE(PackageIndex::normalize("zope.interface"), QByteArray("zope-interface"));
+    QCOMPARE(PackageIndex::normalize("req_"), QByteArray("req-"));
+}
+
+void TestPackageIndex::takesAnchorsAcrossChunks()
+{
+    const QByteArray page = "<html><body>\n<a href=\"/simple/requests/\">requests</a>\n"
+                            "<a href=\"/simple/numpy/\">numpy</a>\n<a href=\"/simple/six/\">six</a>\n"
+                            "</body></html>";
+    QByteArray buffer;
+    QByteArray names;
+    int found = 0;
+    for (int i = 0; i < page.size(); i += 7)
+    {
+        buffer += page.mid(i, 7);
+        found += PackageIndex::takeAnchors(&buffer, &names);
+    }
+    QCOMPARE(found, 3);
+    QCOMPARE(names, QByteArray("requests\nnumpy\nsix\n"));
+    QVERIFY(buffer.size() < 20);
+}
+
+void TestPackageIndex::buildsSortedUniqueNames()
+{
+    const auto names = PackageIndex::build("Zeta\nalpha\nAlpha\n\nmid_dle\n", "etag");
+    QCOMPARE(names->size(), 3);
+    QCOMPARE(names->at(0), QByteArrayView("alpha"));
+    QCOMPARE(names->at(1), QByteArrayView("mid-dle"));
+    QCOMPARE(names->at(2), QByteArrayView("zeta"));
+    QCOMPARE(names->etag, QByteArray("etag"));
+}
+
+void TestPackageIndex::ranksPrefixThenSubstringThenTypos()
+{
+    PackageIndex index;
+    index.setNames({"requests-oauthlib", "requests", "grequests", "requests-toolbelt",
+                    "numpy", "numba", "nump", "six"});
+
+    QCOMPARE(index.search("Requests", 10),
+             QStringList({"requests", "requests-oauthlib", "requests-toolbelt", "grequests"}));
+    QCOMPARE(index.search("requests", 2), QStringList({"requests", "requests-oauthlib"}));
+    QCOMPARE(index.search("numpyy", 10), QStringList({"numpy", "nump"}));
+    QCOMPARE(index.search("nmupy", 10).size(), 0);     // a swap is two edits, limit is one
+    QCOMPARE(index.search("numy", 5), QStringList({"nump", "numpy"}));
+    QVERIFY(index.search("", 10).isEmpty());
+}
+
+void TestPackageIndex::savesAndLoads()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("names.idx");
+    const auto names = PackageIndex::build("b\na\nc\n", "\"W/abc\"");
+    QVERIFY(PackageIndex::save(path, *names));
+
+    const auto loaded = PackageIndex::load(path);
+    QVERIFY(loaded);
+    QCOMPARE(loaded->block, names->block);
+    QCOMPARE(loaded->offsets, names->offsets);
+    QCOMPARE(loaded->etag, names->etag);
+    QVERIFY(loaded->updated.isValid());
+}
+
+void TestPackageIndex::rejectsMalformedFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("names.idx");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("not an index\n");
+    file.close();
+    QVERIFY(!PackageIndex::load(path));
+    QVERIFY(!PackageIndex::load(dir.filePath("missing.idx")));
+}
+
+void TestPackageIndex::boundsEditDistance()
+{
+    QCOMPARE(PackageIndex::boundedDistance("kitten", "sitting", 3), 3);
+    QCOMPARE(PackageIndex::boundedDistance("kitten", "sitting", 2), 3);
+    QCOMPARE(PackageIndex::boundedDistance("same", "same", 1), 0);
+    QCOMPARE(PackageIndex::boundedDistance("a", "abcd", 1), 2);
+}
+
+QTEST_GUILESS_MAIN(TestPackageIndex)
+#include "test_packageindex.moc"
+/************** End of test_packageindex.cpp ********************/
@@ -0,0 +1,157 @@
+/****************************************************************
+ * @file test_packedversion.cpp
+ * @brief Unit tests for PackedVersion and SpecifierSet.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * The expected orders and matches are those of the packaging
+ * library pip uses (SpecifierSet.contains with prereleases=True).
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include "PackedVersion.h"
+
+static PackedVersion packed(const QString &version)
+{
+    PackedVersion result;
+    if (!PackedVersion::pack(version, &result))
+    {
+        qWarning() << "Cannot pack" << version;
+    }
+    return result;
+}
+
+static const QStringList kAscending = {
+    "0.dev0", "0", "1.0.dev1", "1.0a1.dev2", "1.0a1", "1.0a1.post1", "1.0b2", "1.0rc1",
+    "1.0", "1.0.post1.dev1", "1.0.post1", "1.0.post2", "1.0.1", "1.2.3.4", "1.4.2", "1.4.9",
+    "1.5.dev0", "1.5a1", "1.5", "1.23.5", "1.24.0", "1.24.4", "1.25.0", "2.0.0rc1", "2.0",
+    "2.0.2", "2023.07.22", "1!0.5"};
+
+/****************************************************************
+ * @class TestPackedVersion
+ ***************************************************************/
+class TestPackedVersion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void ordersLikePep440();
+    void normalizesSpellings();
+    void rejectsWhatDoesNotFit();
+    void matchesSpecifiers_data();
+    void matchesSpecifiers();
+    void rejectsUnpackableClauses();
+};
+
+void TestPackedVersion::ordersLikePep440()
+{
+    for (int i = 1; i < kAscending.size(); ++i)
+    {
+        QVERIFY2(packed(kAscending.at(i - 1)) < packed(kAscending.at(i)),
+                 qPrintable(kAscending.at(i - 1) + " < " + kAscending.at(i)));
+    }
+    QVERIFY(packed("1.0a1").isPreRelease());
+    QVERIFY(packed("1.0.post1.dev1").isPreRelease());
+    QVERIFY(!packed("1.0.post1").isPreRelease());
+    QVERIFY(packed("1.0.post1").isPostRelease());
+    QVERIFY(packed("1.4.9").sameRelease(packed("1.4.9rc1")));
+    QVERIFY(!packed("1.4.9").sameRelease(packed("1.4")));
+}
+
+void TestPackedVersion::normalizesSpellings()
+{
+    QCOMPARE(packed("1.0"), packed("1.0.0"));
+    QCOMPARE(packed("1.2.3.4.0"), packed("1.2.3.4"));
+    QCOMPARE(packed("V1.0-RC1"), packed("1.0rc1"));
+    QCOMPARE(packed("1.0c1"), packed("1.0rc1"));
+    QCOMPARE(packed("1.0.alpha.2"), packed("1.0a2"));
+    QCOMPARE(packed("1.0-1"), packed("1.0.post1"));
+    QCOMPARE(packed("1.0.post"), packed("1.0.post0"));
+    QCOMPARE(packed("1.0_rev3"), packed("1.0.post3"));
+    QCOMPARE(packed(" 2.0.dev "), packed("2.0.dev0"));
+
+    PackedVersion version;
+    int length = 0;
+    QVERIFY(PackedVersion::pack(u"1.24", &version, &length));
+    QCOMPARE(length, 2);
+}
+
+void TestPackedVersion::rejectsWhatDoesNotFit()
+{
+    const QStringList invalid = {"", "1..2", "1.0+local", "1.0.0.0.1", "70000", "1.0rc8192", "1!2!3",
+                                 "1.0 x", "latest"};
+    PackedVersion version;
+    for (int i = 0; i < invalid.size(); ++i)
+    {
+        QVERIFY2(!PackedVersion::pack(invalid.at(i), &version), qPrintable(invalid.at(i)));
+    }
+}
+
+void TestPackedVersion::matchesSpecifiers_data()
+{
+    QTest::addColumn<QString>("requirement");
+    QTest::addColumn<QStringList>("allowed");
+
+    QTest::newRow("range and prefix") << "x>=1.23,<2,!=1.24.*"
+                                      << QStringList({"1.23.5", "1.25.0"});
+    QTest::newRow("compatible") << "x~=1.4.2" << QStringList({"1.4.2", "1.4.9"});
+    QTest::newRow("prefix") << "x==2.*" << QStringList({"2.0.0rc1", "2.0", "2.0.2"});
+    QTest::newRow("exact pads zeros") << "x==1.0" << QStringList({"1.0"});
+    QTest::newRow("no pre of the bound") << "x<1.0"
+                                         << QStringList({"0.dev0", "0"});
+    QTest::newRow("no post of the bound") << "x>1.5,<2.0"
+                                          << QStringList({"1.23.5", "1.24.0", "1.24.4", "1.25.0"});
+    QTest::newRow("post bound") << "x<1.0.post1"
+                                << QStringList({"0.dev0", "0", "1.0"});
+    QTest::newRow("pre bound") << "x>1.0a1,<=1.0"
+                               << QStringList({"1.0b2", "1.0rc1", "1.0"});
+    QTest::newRow("epoch") << "x>=1!0" << QStringList({"1!0.5"});
+    QTest::newRow("empty") << "x>1.0,<1.0" << QStringList();
+}
+
+/****************************************************************
+ * @brief matches(), filter() and filterSorted() agree with the
+ *        expected set over the whole ascending list.
+ ***************************************************************/
+void TestPackedVersion::matchesSpecifiers()
+{
+    QFETCH(QString, requirement);
+    QFETCH(QStringList, allowed);
+
+    const SpecifierSet specifiers = SpecifierSet::compile(Requirement::parse(requirement));
+    QVERIFY(specifiers.isValid());
+    QVector<PackedVersion> versions;
+    for (int i = 0; i < kAscending.size(); ++i)
+    {
+        versions.append(packed(kAscending.at(i)));
+    }
+    QVector<quint8> matches(versions.size());
+    specifiers.filter(versions.constData(), int(versions.size()), matches.data());
+    QBitArray sorted;
+    QCOMPARE(specifiers.filterSorted(versions, &sorted), int(allowed.size()));
+
+    for (int i = 0; i < kAscending.size(); ++i)
+    {
+        const bool expected = allowed.contains(kAscending.at(i));
+        QVERIFY2(specifiers.matches(versions.at(i)) == expected, qPrintable(kAscending.at(i)));
+        QCOMPARE(matches.at(i) != 0, expected);
+        QCOMPARE(sorted.testBit(i), expected);
+    }
+}
+
+void TestPackedVersion::rejectsUnpackableClauses()
+{
+    QVERIFY(SpecifierSet::compile(Requirement::parse("x")).isValid());
+    QVERIFY(!SpecifierSet::compile(Requirement::parse("x===1.0")).isValid());
+    QVERIFY(!SpecifierSet::compile(Requirement::parse("x~=1")).isValid());
+    QVERIFY(!SpecifierSet::compile(Requirement::parse("x<1.0.*")).isValid());
+    QVERIFY(!SpecifierSet::compile(Requirement::parse("x==1.0a1.*")).isValid());
+    QVERIFY(!SpecifierSet::compile(Requirement::parse("x>=20231001")).isValid());
+    QVERIFY(!SpecifierSet::compile(Requirement::parse("x @ https://example.com/x.whl")).isValid());
+}
+
+QTEST_GUILESS_MAIN(TestPackedVersion)
+#include "test_packedversion.moc"
+/************** End of test_packedversion.cpp *******************/
@@ -0,0 +1,144 @@
+/****************************************************************
+ * @file test_pythonhelper.cpp
+ * @brief Unit tests for PythonHelper.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * The helper runs the first python3 (or python) on PATH; the tests
+ * are skipped when there is none.
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include "PythonHelper.h"
+
+static QString findPython()
+{
+    const QString python3 = QStandardPaths::findExecutable("python3");
+    return python3.isEmpty() ? QStandardPaths::findExecutable("python") : python3;
+}
+
+/****************************************************************
+ * @class TestPythonHelper
+ ***************************************************************/
+class TestPythonHelper : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void answersInOneInterpreter();
+    void reportsPythonErrors();
+    void answersAsynchronously();
+    void restartsAfterStop();
+    void failsWithoutInterpreter();
+
+private:
+    QString m_python;
+};
+
+void TestPythonHelper::initTestCase()
+{
+    m_python = findPython();
+    if (m_python.isEmpty())
+    {
+        QSKIP("No Python interpreter on PATH");
+    }
+}
+
+void TestPythonHelper::answersInOneInterpreter()
+{
+    PythonHelper helper;
+    helper.setPython(m_python);
+    QVERIFY(!helper.isRunning());
+
+    QJsonValue result;
+    QString error;
+    QVERIFY2(helper.call("ping", QJsonObject(), 30000, &result, &error), qPrintable(error));
+    QCOMPARE(result.toString(), QString("pong"));
+
+    QVERIFY(helper.call("version", QJsonObject(), 30000, &result, &error));
+    QVERIFY(result.toObject().value("python").toString().startsWith('3'));
+
+    QVERIFY(helper.call("list", QJsonObject(), 30000, &result, &error));
+    QVERIFY(result.isArray());
+
+    QVERIFY(helper.call("show", QJsonObject{{"names", QJsonArray{"no-such-project-xyz"}}}, 30000, &result,
+                        &error));
+    QVERIFY(result.toArray().isEmpty());
+
+    // Import tests need a fresh interpreter; the helper has no such op
+    QVERIFY(!helper.call("import", QJsonObject{{"modules", QJsonArray{"json"}}}, 30000, &result, &error));
+    QVERIFY(error.startsWith("KeyError"));
+
+    QVERIFY(helper.isRunning());
+    QCOMPARE(helper.launches(), 1);
+}
+
+void TestPythonHelper::reportsPythonErrors()
+{
+    PythonHelper helper;
+    helper.setPython(m_python);
+    QJsonValue result;
+    QString error;
+    QVERIFY(!helper.call("no-such-op", QJsonObject(), 30000, &result, &error));
+    QVERIFY(error.startsWith("KeyError"));
+    // The helper survives its own errors
+    QVERIFY(helper.call("ping", QJsonObject(), 30000, &result, &error));
+    QCOMPARE(helper.launches(), 1);
+}
+
+void TestPythonHelper::answersAsynchronously()
+{
+    PythonHelper helper;
+    helper.setPython(m_python);
+    QSignalSpy spy(&helper, &PythonHelper::replied);
+    const int first = helper.request("ping");
+    const int second = helper.request("version");
+    QVERIFY(first > 0 && second > first);
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 2, 30000);
+    QCOMPARE(spy.at(0).at(0).toInt(), first);
+    QVERIFY(spy.at(0).at(1).toBool());
+    QCOMPARE(spy.at(1).at(0).toInt(), second);
+    QVERIFY(spy.at(1).at(2).value<QJsonValue>().isObject());
+}
+
+void TestPythonHelper::restartsAfterStop()
+{
+    PythonHelper helper;
+    helper.setPython(m_python);
+    QJsonValue result;
+    QVERIFY(helper.call("ping", QJsonObject(), 30000, &result));
+
+    // A request still pending when the helper goes fails at once
+    QSignalSpy spy(&helper, &PythonHelper::replied);
+    const int id = helper.request("list");
+    helper.stop();
+    QVERIFY(!helper.isRunning());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toInt(), id);
+    QVERIFY(!spy.at(0).at(1).toBool());
+
+    QVERIFY(helper.call("ping", QJsonObject(), 30000, &result));
+    QCOMPARE(helper.launches(), 2);
+}
+
+void TestPythonHelper::failsWithoutInterpreter()
+{
+    PythonHelper helper;
+    QCOMPARE(helper.request("ping"), 0);
+    helper.setPython(QDir::temp().filePath("no-such-python-xyz"));
+    QJsonValue result;
+    QString error;
+    QVERIFY(!helper.call("ping", QJsonObject(), 5000, &result, &error));
+    QVERIFY(!error.isEmpty());
+    QVERIFY(!helper.isRunning());
+}
+
+QTEST_GUILESS_MAIN(TestPythonHelper)
+#include "test_pythonhelper.moc"
+/************** End of test_pythonhelper.cpp ********************/
@@ -0,0 +1,147 @@
+/****************************************************************
+ * @file test_requirement.cpp
+ * @brief Unit tests for the Requirement parser.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include "Requirement.h"
+
+/****************************************************************
+ * @class TestRequirement
+ ***************************************************************/
+class TestRequirement : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void classifiesLines();
+    void parsesNameExtrasAndClauses();
+    void parsesParenthesizedClauses();
+    void parsesUrlsAndMarkers();
+    void parsesHashesAndComments();
+    void reportsErrors();
+    void joinsContinuations();
+    void internsProjects();
+};
+
+void TestRequirement::classifiesLines()
+{
+    QCOMPARE(Requirement::parse("   ").kind, Requirement::Kind::Blank);
+    QCOMPARE(Requirement::parse("# pinned by hand").kind, Requirement::Kind::Comment);
+    QCOMPARE(Requirement::parse("numpy").kind, Requirement::Kind::Package);
+    QCOMPARE(Requirement::parse("./local/pkg").kind, Requirement::Kind::Url);
+    QCOMPARE(Requirement::parse("https://example.com/pkg-1.0.tar.gz").kind, Requirement::Kind::Url);
+    QCOMPARE(Requirement::parse("--index-url https://example.com/simple").kind,
+             Requirement::Kind::Option);
+
+    const Requirement include = Requirement::parse("-r base.txt  # shared");
+    QCOMPARE(include.kind, Requirement::Kind::Include);
+    QCOMPARE(include.text(include.argument), QStringView(u"base.txt"));
+    const Requirement attached = Requirement::parse("-rbase.txt");
+    QCOMPARE(attached.kind, Requirement::Kind::Include);
+    QCOMPARE(attached.text(attached.argument), QStringView(u"base.txt"));
+    const Requirement constraint = Requirement::parse("--constraint=pins.txt");
+    QCOMPARE(constraint.kind, Requirement::Kind::Constraint);
+    QCOMPARE(constraint.text(constraint.argument), QStringView(u"pins.txt"));
+    QCOMPARE(Requirement::parse("-e git+https://example.com/repo.git#egg=pkg").kind,
+             Requirement::Kind::Editable);
+}
+
+void TestRequirement::parsesNameExtrasAndClauses()
+{
+    const Requirement r = Requirement::parse("  Foo_Bar.baz [ Security , socks ] >=1.0, <2.0 , !=1.5.* ");
+    QCOMPARE(r.kind, Requirement::Kind::Package);
+    QCOMPARE(r.text(r.name), QStringView(u"Foo_Bar.baz"));
+    QCOMPARE(r.project, QString("foo-bar-baz"));
+    QCOMPARE(r.extraList(), QStringList({"Security", "socks"}));
+    QCOMPARE(r.nameWithExtras(), QString("Foo_Bar.baz[Security , socks]"));
+    QCOMPARE(r.clauses.size(), 3);
+    QCOMPARE(r.clauses.at(0).op, Requirement::Op::GreaterEqual);
+    QCOMPARE(r.version(0), QString("1.0"));
+    QCOMPARE(r.clauses.at(1).op, Requirement::Op::Less);
+    QCOMPARE(r.version(1), QString("2.0"));
+    QCOMPARE(r.clauses.at(2).op, Requirement::Op::NotEqual);
+    QCOMPARE(r.version(2), QString("1.5.*"));
+    QVERIFY(r.isIndexPackage());
+
+    const Requirement arbitrary = Requirement::parse("pkg===1.0+local");
+    QCOMPARE(arbitrary.clauses.at(0).op, Requirement::Op::Arbitrary);
+    QCOMPARE(arbitrary.version(0), QString("1.0+local"));
+    QVERIFY(!arbitrary.isIndexPackage());
+    QCOMPARE(Requirement::parse("pkg~=1.4.2").clauses.at(0).op, Requirement::Op::Compatible);
+}
+
+void TestRequirement::parsesParenthesizedClauses()
+{
+    const Requirement r = Requirement::parse("name (>=1.0,<2)");
+    QCOMPARE(r.kind, Requirement::Kind::Package);
+    QCOMPARE(r.clauses.size(), 2);
+    QCOMPARE(r.version(1), QString("2"));
+}
+
+void TestRequirement::parsesUrlsAndMarkers()
+{
+    const Requirement direct = Requirement::parse("pkg[extra] @ https://example.com/pkg.whl ; os_name == 'nt'");
+    QCOMPARE(direct.kind, Requirement::Kind::Package);
+    QCOMPARE(direct.text(direct.url), QStringView(u"https://example.com/pkg.whl"));
+    QCOMPARE(direct.text(direct.marker), QStringView(u"os_name == 'nt'"));
+    QVERIFY(!direct.isIndexPackage());
+
+    const Requirement marked = Requirement::parse(
+        "pkg>=1; python_version < \"3.11\" and (sys_platform == 'linux' or extra == \"x;y\")");
+    QCOMPARE(marked.version(0), QString("1"));
+    QCOMPARE(marked.text(marked.marker),
+             QStringView(u"python_version < \"3.11\" and (sys_platform == 'linux' or extra == \"x;y\")"));
+}
+
+void TestRequirement::parsesHashesAndComments()
+{
+    const Requirement r = Requirement::parse(
+        "pkg==1.0 ; python_version >= '3.9' --hash=sha256:abc --hash sha256:def  # keep");
+    QCOMPARE(r.kind, Requirement::Kind::Package);
+    QCOMPARE(r.text(r.marker), QStringView(u"python_version >= '3.9'"));
+    QCOMPARE(r.hashes.size(), 2);
+    QCOMPARE(r.text(r.hashes.at(0)), QStringView(u"sha256:abc"));
+    QCOMPARE(r.text(r.hashes.at(1)), QStringView(u"sha256:def"));
+
+    const Requirement tagged = Requirement::parse("pkg#1 >= 2");
+    QCOMPARE(tagged.kind, Requirement::Kind::Invalid);
+}
+
+void TestRequirement::reportsErrors()
+{
+    const QStringList bad = {"pkg>=", "pkg[extra", "pkg (>=1.0", "pkg==1.0,", "pkg==1.0 junk",
+                             "pkg-", "pkg ; python_version < '3", "pkg --hash=sha256", "-r", "pkg @"};
+    for (int i = 0; i < bad.size(); ++i)
+    {
+        const Requirement r = Requirement::parse(bad.at(i));
+        QVERIFY2(r.kind == Requirement::Kind::Invalid, qPrintable(bad.at(i)));
+        QVERIFY2(!r.error.isEmpty(), qPrintable(bad.at(i)));
+    }
+    QCOMPARE(Requirement::parse(QString(70000, 'a')).kind, Requirement::Kind::Invalid);
+}
+
+void TestRequirement::joinsContinuations()
+{
+    const QStringList lines = Requirement::logicalLines(
+        {"pkg==1.0 \\", "    --hash=sha256:abc \\", "    --hash=sha256:def", "other\r", "tail \\"});
+    QCOMPARE(lines, QStringList({"pkg==1.0 --hash=sha256:abc --hash=sha256:def", "other", "tail \\"}));
+    QCOMPARE(Requirement::parse(lines.at(0)).hashes.size(), 2);
+}
+
+void TestRequirement::internsProjects()
+{
+    const Requirement a = Requirement::parse("Zope.Interface==5");
+    const Requirement b = Requirement::parse("zope_interface>=4");
+    QCOMPARE(a.project, QString("zope-interface"));
+    QVERIFY(a.project.constData() == b.project.constData());
+    QCOMPARE(Requirement::normalizeName(u"A__b.-C"), QString("a-b-c"));
+}
+
+QTEST_GUILESS_MAIN(TestRequirement)
+#include "test_requirement.moc"
+/************** End of test_requirement.cpp *********************/
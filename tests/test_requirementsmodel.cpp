@@ -0,0 +1,125 @@
+/****************************************************************
+ * @file test_requirementsmodel.cpp
+ * @brief Unit tests for RequirementsModel.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QAbstractItemModelTester>
+#include "RequirementsModel.h"
+
+/****************************************************************
+ * @class TestRequirementsModel
+ ***************************************************************/
+class TestRequirementsModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parsesNames();
+    void identicalReloadEmitsNothing();
+    void pinBumpUpdatesInPlace();
+    void keepsUnchangedRowsAcrossEdits();
+    void reordersAndDuplicates();
+    void appendsStreamedLines();
+};
+
+void TestRequirementsModel::parsesNames()
+{
+    QCOMPARE(RequirementsModel::parse("  Foo_Bar.baz[extra]>=1.0 ").requirement.project, QString("foo-bar-baz"));
+    QCOMPARE(RequirementsModel::parse("numpy==1.26.4").requirement.project, QString("numpy"));
+    QVERIFY(RequirementsModel::parse("# comment").requirement.project.isEmpty());
+    QVERIFY(RequirementsModel::parse("-r base.txt").requirement.project.isEmpty());
+}
+
+void TestRequirementsModel::identicalReloadEmitsNothing()
+{
+    RequirementsModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    const QStringList lines = {"a==1", "", "b==2", "# note", "c==3"};
+    model.setLines(lines);
+    QCOMPARE(model.lines(), QStringList({"a==1", "b==2", "# note", "c==3"}));
+
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy reset(&model, &QAbstractItemModel::modelReset);
+    model.setLines(lines);
+    QCOMPARE(changed.count() + inserted.count() + removed.count() + reset.count(), 0);
+}
+
+void TestRequirementsModel::pinBumpUpdatesInPlace()
+{
+    RequirementsModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    model.setLines({"a==1", "b==2", "c==3"});
+    const QPersistentModelIndex b = model.index(1, 0);
+
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    model.setLines({"a==1", "b==2.1", "c==3"});
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(inserted.count(), 0);
+    QCOMPARE(b.row(), 1);
+    QCOMPARE(b.data().toString(), QString("b==2.1"));
+}
+
+void TestRequirementsModel::keepsUnchangedRowsAcrossEdits()
+{
+    RequirementsModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    model.setLines({"a==1", "b==2", "c==3", "d==4", "e==5"});
+    const QPersistentModelIndex a = model.index(0, 0);
+    const QPersistentModelIndex d = model.index(3, 0);
+    const QPersistentModelIndex e = model.index(4, 0);
+
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    model.setLines({"a==1", "x==9", "y==8", "d==4", "e==5.1", "f==6"});
+    QCOMPARE(model.lines(), QStringList({"a==1", "x==9", "y==8", "d==4", "e==5.1", "f==6"}));
+    QCOMPARE(removed.count(), 1);       // b and c in one run
+    QCOMPARE(inserted.count(), 2);      // x,y in one run, f at the end
+    QCOMPARE(a.row(), 0);
+    QCOMPARE(d.row(), 3);
+    QCOMPARE(e.row(), 4);
+    QCOMPARE(e.data().toString(), QString("e==5.1"));
+}
+
+void TestRequirementsModel::reordersAndDuplicates()
+{
+    RequirementsModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    model.setLines({"a==1", "b==2", "c==3", "# x", "# x"});
+    const QPersistentModelIndex c = model.index(2, 0);
+
+    model.setLines({"c==3", "a==1", "# x", "b==2", "# x", "# x"});
+    QCOMPARE(model.lines(), QStringList({"c==3", "a==1", "# x", "b==2", "# x", "# x"}));
+    QCOMPARE(c.row(), 0);
+
+    model.setLines({});
+    QCOMPARE(model.rowCount(), 0);
+}
+
+void TestRequirementsModel::appendsStreamedLines()
+{
+    RequirementsModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    model.appendLines({"a==1", "  "});
+    model.appendLines({"a==2", "b==1"});
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.row(1).key, QString("a#2"));
+    QCOMPARE(model.longestRow(), 0);
+
+    // A later full load of the same content changes nothing
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    model.setLines({"a==1", "a==2", "b==1"});
+    QCOMPARE(inserted.count() + removed.count(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestRequirementsModel)
+#include "test_requirementsmodel.moc"
+/************** End of test_requirementsmodel.cpp ***************/
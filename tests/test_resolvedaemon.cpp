@@ -0,0 +1,133 @@
+/****************************************************************
+ * @file test_resolvedaemon.cpp
+ * @brief Unit tests for ResolveDaemon requests and the
+ *        ResolveSession requirement helpers.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include "ResolveDaemon.h"
+
+/****************************************************************
+ * @class TestResolveDaemon
+ ***************************************************************/
+class TestResolveDaemon : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parsesResolveWithDefaults();
+    void parsesInlineLines();
+    void parsesControlCommands();
+    void rejectsBadRequests_data();
+    void rejectsBadRequests();
+    void parsesRequirementLines();
+};
+
+static ResolveDaemon::Job defaults()
+{
+    ResolveDaemon::Job job;
+    job.options.baseVenv = "/opt/venv";
+    job.options.workers = 3;
+    job.options.matrixRange = 2;
+    job.options.wheelhouseLimit = 20LL * 1024 * 1024 * 1024;
+    return job;
+}
+
+void TestResolveDaemon::parsesResolveWithDefaults()
+{
+    ResolveDaemon::Job job;
+    QString error;
+    QVERIFY2(ResolveDaemon::parseJob(R"({"cmd":"resolve","id":"a","requirements":"/tmp/req.txt",
+                                           "workers":8,"wheelhouse":false,"python":"3.11","cuda":false})",
+                                     defaults(), &job, &error),
+             qPrintable(error));
+    QCOMPARE(job.cmd, QString("resolve"));
+    QCOMPARE(job.id, QString("a"));
+    QCOMPARE(job.requirementsFile, QString("/tmp/req.txt"));
+    QCOMPARE(job.options.baseVenv, QString("/opt/venv"));
+    QCOMPARE(job.options.workers, 8);
+    QCOMPARE(job.options.matrixRange, 2);
+    QCOMPARE(job.options.useWheelhouse, false);
+    QCOMPARE(job.options.wheelhouseLimit, 20LL * 1024 * 1024 * 1024);
+    QCOMPARE(job.pythonVersion, QString("3.11"));
+    QCOMPARE(job.cuda, false);
+    QCOMPARE(job.useCpu, false);
+}
+
+void TestResolveDaemon::parsesInlineLines()
+{
+    ResolveDaemon::Job job;
+    QString error;
+    QVERIFY2(ResolveDaemon::parseJob(R"({"cmd":"resolve","lines":["numpy>=1.24","requests"],"venv":"/v",
+                                           "wheelhouseLimitGb":0,"prefetchAhead":0,"prefetchRateMb":5})",
+                                     defaults(), &job, &error),
+             qPrintable(error));
+    QCOMPARE(job.lines, QStringList({"numpy>=1.24", "requests"}));
+    QVERIFY(job.requirementsFile.isEmpty());
+    QCOMPARE(job.options.baseVenv, QString("/v"));
+    QCOMPARE(job.options.wheelhouseLimit, qint64(0));
+    QCOMPARE(job.options.prefetchAhead, 0);
+    QCOMPARE(job.options.prefetchRate, 5LL * 1024 * 1024);
+}
+
+void TestResolveDaemon::parsesControlCommands()
+{
+    const QStringList commands = {"status", "stop", "shutdown"};
+    for (int i = 0; i < commands.size(); ++i)
+    {
+        ResolveDaemon::Job job;
+        QString error;
+        const QByteArray line = QString(R"({"cmd":"%1"})").arg(commands.at(i)).toUtf8();
+        QVERIFY2(ResolveDaemon::parseJob(line, defaults(), &job, &error), qPrintable(error));
+        QCOMPARE(job.cmd, commands.at(i));
+    }
+}
+
+void TestResolveDaemon::rejectsBadRequests_data()
+{
+    QTest::addColumn<QByteArray>("line");
+    QTest::newRow("not json") << QByteArray("resolve requirements.txt");
+    QTest::newRow("array") << QByteArray(R"(["resolve"])");
+    QTest::newRow("unknown cmd") << QByteArray(R"({"cmd":"compile"})");
+    QTest::newRow("no requirements") << QByteArray(R"({"cmd":"resolve"})");
+    QTest::newRow("workers type") << QByteArray(R"({"cmd":"resolve","lines":["a"],"workers":"4"})");
+    QTest::newRow("workers zero") << QByteArray(R"({"cmd":"resolve","lines":["a"],"workers":0})");
+    QTest::newRow("workers fraction") << QByteArray(R"({"cmd":"resolve","lines":["a"],"workers":1.5})");
+    QTest::newRow("bool type") << QByteArray(R"({"cmd":"resolve","lines":["a"],"cuda":1})");
+    QTest::newRow("lines type") << QByteArray(R"({"cmd":"resolve","lines":[1]})");
+    QTest::newRow("empty venv") << QByteArray(R"({"cmd":"resolve","lines":["a"],"venv":""})");
+}
+
+void TestResolveDaemon::rejectsBadRequests()
+{
+    QFETCH(QByteArray, line);
+    ResolveDaemon::Job job;
+    QString error;
+    QVERIFY(!ResolveDaemon::parseJob(line, defaults(), &job, &error));
+    QVERIFY(!error.isEmpty());
+}
+
+void TestResolveDaemon::parsesRequirementLines()
+{
+    QVector<Requirement> requirements;
+    QString error;
+    QVERIFY2(ResolveSession::parseRequirements({"# pinned", "", "numpy>=1.24 \\", "    --hash=sha256:abc",
+                                                "requests"},
+                                               &requirements, &error),
+             qPrintable(error));
+    QCOMPARE(requirements.size(), 2);
+    QCOMPARE(requirements.at(0).project, QString("numpy"));
+    QCOMPARE(requirements.at(0).hashes.size(), 1);
+
+    QVERIFY(!ResolveSession::parseRequirements({"requests", "numpy>="}, &requirements, &error));
+    QVERIFY(error.contains("numpy"));
+    QVERIFY(!ResolveSession::parseRequirements({"# only comments"}, &requirements, &error));
+}
+
+QTEST_GUILESS_MAIN(TestResolveDaemon)
+#include "test_resolvedaemon.moc"
+/************** End of test_resolvedaemon.cpp *******************/
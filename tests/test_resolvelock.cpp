@@ -0,0 +1,140 @@
+/****************************************************************
+ * @file test_resolvelock.cpp
+ * @brief Unit tests for ResolveLock.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * A lock is saved for a small tensorflow stack, then the file is
+ * edited by one line and the matrix narrowed around it.
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "ResolveLock.h"
+
+static QVector<Requirement> parse(const QStringList &lines)
+{
+    QVector<Requirement> requirements;
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        requirements << Requirement::parse(lines.at(i));
+    }
+    return requirements;
+}
+
+static const QStringList kLines = {"tensorflow>=2.14", "tensorboard", "numpy>=1.23", "requests", "Pillow>=9"};
+static const QStringList kPins = {"tensorflow==2.15.1", "tensorboard==2.15.2", "numpy==1.26.4", "requests",
+                                  "Pillow==10.3.0"};
+
+/****************************************************************
+ * @class TestResolveLock
+ ***************************************************************/
+class TestResolveLock : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void savesPerEnvironment();
+    void diffsRequirementLines();
+    void affectsDependents();
+    void narrowsUnaffectedColumns();
+};
+
+void TestResolveLock::savesPerEnvironment()
+{
+    QTemporaryDir dir;
+    ResolveLock lock;
+    lock.setPath(dir.filePath("locks.json"));
+    QVERIFY(!lock.load("linux-3.11"));
+    QVERIFY(lock.save("linux-3.11", parse(kLines), kPins));
+    QVERIFY(lock.save("linux-3.12", parse({"numpy"}), {"numpy==2.0.2"}));
+
+    ResolveLock reread;
+    reread.setPath(lock.path());
+    QVERIFY(reread.load("linux-3.11"));
+    QCOMPARE(reread.pins(), kPins);
+    QCOMPARE(reread.version("numpy"), QString("1.26.4"));
+    QCOMPARE(reread.version("pillow"), QString("10.3.0"));
+    QVERIFY(reread.version("requests").isEmpty());
+    QVERIFY(reread.load("linux-3.12"));
+    QCOMPARE(reread.version("numpy"), QString("2.0.2"));
+    QVERIFY(!reread.load("win-3.11"));
+    QVERIFY(reread.isEmpty());
+}
+
+void TestResolveLock::diffsRequirementLines()
+{
+    QTemporaryDir dir;
+    ResolveLock lock;
+    lock.setPath(dir.filePath("locks.json"));
+    QVERIFY(lock.save("env", parse(kLines), kPins));
+
+    bool unnamed = true;
+    QVERIFY(lock.changedProjects(parse(kLines), &unnamed).isEmpty());
+    QVERIFY(!unnamed);
+
+    // Spacing and removed lines do not count; a bump and a new line do
+    const QSet<QString> changed = lock.changedProjects(
+        parse({"tensorflow >= 2.14", "tensorboard", "numpy>=1.24", "requests", "scipy"}), &unnamed);
+    QCOMPARE(changed, QSet<QString>({"numpy", "scipy"}));
+    QVERIFY(!unnamed);
+
+    lock.changedProjects(parse({"numpy>=1.23", "./vendor/tool"}), &unnamed);
+    QVERIFY(unnamed);
+}
+
+void TestResolveLock::affectsDependents()
+{
+    const QHash<QString, QSet<QString>> dependencies = {
+        {"tensorflow", {"tensorboard", "numpy", "requests"}},
+        {"tensorboard", {"numpy"}},
+        {"pillow", {}},
+        {"keras", {"tensorflow"}},
+    };
+    // numpy's dependents, transitively; numpy requires nothing here
+    QCOMPARE(ResolveLock::affectedProjects({"numpy"}, dependencies),
+             QSet<QString>({"numpy", "tensorboard", "tensorflow", "keras"}));
+    // The dependencies of a changed project, but not their dependents
+    QCOMPARE(ResolveLock::affectedProjects({"tensorboard"}, dependencies),
+             QSet<QString>({"tensorboard", "tensorflow", "keras", "numpy"}));
+    QCOMPARE(ResolveLock::affectedProjects({"pillow"}, dependencies), QSet<QString>({"pillow"}));
+}
+
+void TestResolveLock::narrowsUnaffectedColumns()
+{
+    QTemporaryDir dir;
+    ResolveLock lock;
+    lock.setPath(dir.filePath("locks.json"));
+    QVERIFY(lock.save("env", parse(kLines), kPins));
+
+    QVector<PackageCandidates> packages = {
+        PackageCandidates{"tensorflow", {"2.14.1", "2.15.1", "2.16.2"}},
+        PackageCandidates{"numpy", {"1.23.5", "1.26.4", "2.0.2"}},
+        PackageCandidates{"Pillow", {"9.5.0", "10.3.0"}},
+        PackageCandidates{"requests", {""}},
+        PackageCandidates{"tensorboard", {"2.16.2", "2.14.1"}}, // locked 2.15.2 is gone
+    };
+    QVector<ResolverSet> conflicts = {
+        ResolverSet{{0, 1}, {1, 2}}, // tensorflow 2.15.1 x numpy 2.0.2
+        ResolverSet{{0, 0}, {4, 0}}, // tensorflow 2.14.1 x tensorboard 2.16.2
+        ResolverSet{{1, 0}, {2, 1}}, // numpy 1.23.5 x Pillow 10.3.0
+        ResolverSet{{1, 0}, {2, 0}}, // numpy 1.23.5 x Pillow 9.5.0
+    };
+    QCOMPARE(lock.narrow(&packages, &conflicts, {"numpy"}), 2);
+    QCOMPARE(packages.at(0).versions, QStringList({"2.15.1"}));
+    QCOMPARE(packages.at(1).versions.size(), 3);
+    QCOMPARE(packages.at(2).versions, QStringList({"10.3.0"}));
+    QCOMPARE(packages.at(4).versions.size(), 2);
+
+    QCOMPARE(conflicts.size(), 2);
+    QCOMPARE(conflicts.at(0).at(0).version, 0);
+    QCOMPARE(conflicts.at(0).at(1).version, 2);
+    QCOMPARE(conflicts.at(1).at(0).package, 1);
+    QCOMPARE(conflicts.at(1).at(1).version, 0);
+}
+
+QTEST_GUILESS_MAIN(TestResolveLock)
+#include "test_resolvelock.moc"
+/************** End of test_resolvelock.cpp *********************/
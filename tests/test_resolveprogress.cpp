@@ -0,0 +1,190 @@
+/****************************************************************
+ * @file test_resolveprogress.cpp
+ * @brief Unit tests for ResolveProgress.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * The engine's tests are queued by QueuedRunner and answered one at
+ * a time (every combination with a==1 fails), so the samples can be
+ * taken with tests outstanding.
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include "ResolveProgress.h"
+#include "ResolverEngine.h"
+#include "Telemetry.h"
+
+/****************************************************************
+ * @class QueuedRunner
+ * @brief Fake pip-compile holding tests until released.
+ ***************************************************************/
+class QueuedRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QueuedRunner(ResolverEngine *engine)
+    {
+        connect(engine, &ResolverEngine::testRequested, this, &QueuedRunner::runTest);
+        connect(this, &QueuedRunner::testFinished, engine, &ResolverEngine::reportTestResult);
+    }
+
+    int pending() const
+    {
+        return m_pending.size();
+    }
+
+    bool releaseOne()
+    {
+        if (m_pending.isEmpty())
+        {
+            return false;
+        }
+        const QPair<int, QStringList> test = m_pending.takeFirst();
+        emit testFinished(test.first,
+                          test.second.contains(QStringLiteral("a==1")) ? TestOutcome::Failed : TestOutcome::Passed,
+                          QString());
+        return true;
+    }
+
+public slots:
+    void runTest(int testId, const QStringList &pins)
+    {
+        m_pending.append(qMakePair(testId, pins));
+    }
+
+signals:
+    void testFinished(int testId, TestOutcome outcome, const QString &outputPath);
+
+private:
+    QList<QPair<int, QStringList>> m_pending;
+};
+
+static QVector<PackageCandidates> matrix()
+{
+    return {PackageCandidates{"a", {"1", "2", "3"}}, PackageCandidates{"b", {"1", "2"}}};
+}
+
+/****************************************************************
+ * @class TestResolveProgress
+ ***************************************************************/
+class TestResolveProgress : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void samplesRunningSearch();
+    void emitsOnTimerAndEnd();
+    void averagesPhases();
+    void formatsDurations();
+};
+
+/****************************************************************
+ * @brief Workers and counts follow the engine; rates and the ETA
+ *        appear once the frontier moves.
+ ***************************************************************/
+void TestResolveProgress::samplesRunningSearch()
+{
+    ResolverEngine engine;
+    engine.setCandidates(matrix());
+    engine.setMaxParallelTests(2);
+    QueuedRunner runner(&engine);
+    ResolveProgress progress(&engine);
+    QVERIFY(engine.start());
+    progress.begin();
+
+    ResolveProgress::Sample sample = progress.sample();
+    QCOMPARE(sample.combinations, 6.0);
+    QCOMPARE(sample.frontier, 0.0);
+    QCOMPARE(sample.percent, 0);
+    QVERIFY(sample.activeWorkers > 0);
+    QCOMPARE(sample.activeWorkers, runner.pending());
+    QCOMPARE(sample.activeWorkers + sample.idleWorkers, 2);
+    QCOMPARE(sample.tests, engine.testsLaunched());
+    QCOMPARE(sample.cacheHitRate, 0.0);
+    QVERIFY(sample.etaMs < 0.0);
+
+    QTest::qWait(20);
+    QSignalSpy resolved(&engine, &ResolverEngine::resolved);
+    while (runner.releaseOne())
+    {
+    }
+    QCOMPARE(resolved.size(), 1);
+
+    sample = progress.sample();
+    QCOMPARE(sample.frontier, engine.searchPosition());
+    QVERIFY(sample.frontier > 0.0);
+    QCOMPARE(sample.percent, static_cast<int>(100.0 * sample.frontier / 6.0));
+    QCOMPARE(sample.activeWorkers, 0);
+    QCOMPARE(sample.idleWorkers, 0);
+    QVERIFY(sample.testsPerMinute > 0.0);
+    QVERIFY(sample.combinationsPerMinute > 0.0);
+    QVERIFY(sample.etaMs > 0.0);
+    QCOMPARE(sample.toJson().value("tests").toInt(), sample.tests);
+}
+
+/****************************************************************
+ * @brief One sample per interval while active, one more on end();
+ *        a paused search has no rates.
+ ***************************************************************/
+void TestResolveProgress::emitsOnTimerAndEnd()
+{
+    ResolverEngine engine;
+    engine.setCandidates(matrix());
+    QueuedRunner runner(&engine);
+    ResolveProgress progress(&engine);
+    progress.setInterval(10);
+    QCOMPARE(progress.interval(), 250);
+    QSignalSpy updated(&progress, &ResolveProgress::updated);
+
+    QVERIFY(engine.start());
+    progress.begin();
+    QVERIFY(progress.isActive());
+    engine.pause();
+    QVERIFY(updated.wait(2000));
+    const ResolveProgress::Sample sample = updated.last().first().value<ResolveProgress::Sample>();
+    QVERIFY(sample.paused);
+    QCOMPARE(sample.testsPerMinute, 0.0);
+    QVERIFY(sample.etaMs < 0.0);
+
+    const int before = int(updated.size());
+    progress.end();
+    QVERIFY(!progress.isActive());
+    QCOMPARE(int(updated.size()), before + 1);
+    progress.end();
+    QCOMPARE(int(updated.size()), before + 1);
+    engine.stop();
+}
+
+void TestResolveProgress::averagesPhases()
+{
+    Telemetry::reset();
+    const qint64 span = Telemetry::begin(QStringLiteral("compile"), QStringLiteral("worker 0"));
+    Telemetry::end(span);
+    Telemetry::begin(QStringLiteral("install"), QStringLiteral("worker 1")); // still running
+
+    ResolverEngine engine;
+    ResolveProgress progress(&engine);
+    const ResolveProgress::Sample sample = progress.sample();
+    QCOMPARE(sample.phases.size(), 1);
+    QCOMPARE(sample.phases.first().name, QStringLiteral("compile"));
+    QCOMPARE(sample.phases.first().count, 1);
+    QVERIFY(sample.phases.first().meanMs >= 0.0);
+    QVERIFY(ResolveProgress::describe(sample).contains(QStringLiteral("compile")));
+    Telemetry::reset();
+}
+
+void TestResolveProgress::formatsDurations()
+{
+    QCOMPARE(ResolveProgress::formatDuration(45000.0), QStringLiteral("45 s"));
+    QCOMPARE(ResolveProgress::formatDuration(12 * 60000.0), QStringLiteral("12 min"));
+    QCOMPARE(ResolveProgress::formatDuration((3 * 60 + 12) * 60000.0), QStringLiteral("3 h 12 min"));
+    QCOMPARE(ResolveProgress::formatDuration((52 * 60 + 5) * 60000.0), QStringLiteral("2 d 4 h"));
+    QCOMPARE(ResolveProgress::formatDuration(-1.0), QStringLiteral("0 s"));
+}
+
+QTEST_GUILESS_MAIN(TestResolveProgress)
+#include "test_resolveprogress.moc"
+/************** End of test_resolveprogress.cpp *****************/
@@ -1,8 +1,544 @@
-#include <gtest/gtest.h>
+/****************************************************************
+ * @file test_resolver.cpp
+ * @brief Unit tests for ResolverEngine and CandidateFetcher.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ * @section DESCRIPTION
+ * pip-compile is replaced by ScriptedRunner, which answers from a
+ * predicate over the pinned versions. Results are either reported
+ * synchronously from testRequested() or queued and released one
+ * at a time, so checkpoints can be taken mid-search.
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <functional>
+#include "CandidateFetcher.h"
+#include "CompatibilityCache.h"
 #include "ResolverEngine.h"
 
-TEST(ResolverEngineTest, BasicSanity) 
+/** name -> version of one pin set */
+using PinMap = QHash<QString, QString>;
+
+/****************************************************************
+ * @class ScriptedRunner
+ * @brief Fake pip-compile driven by a predicate.
+ ***************************************************************/
+class ScriptedRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ScriptedRunner(std::function<bool(const PinMap &)> compiles, bool queued = false)
+        : m_compiles(compiles)
+        , m_queued(queued)
+    {
+    }
+
+    void attach(ResolverEngine *engine)
+    {
+        connect(engine, &ResolverEngine::testRequested, this, &ScriptedRunner::runTest);
+        connect(this, &ScriptedRunner::testFinished, engine, &ResolverEngine::reportTestResult);
+    }
+
+    void detach(ResolverEngine *engine)
+    {
+        disconnect(engine, nullptr, this, nullptr);
+        disconnect(this, nullptr, engine, nullptr);
+    }
+
+    /****************************************************************
+     * @brief Reports the oldest queued test.
+     * @return false if nothing was queued.
+     ***************************************************************/
+    bool releaseOne()
+    {
+        if (m_pending.isEmpty())
+        {
+            return false;
+        }
+        const QPair<int, QStringList> test = m_pending.takeFirst();
+        m_answered << test.second;
+        emit testFinished(test.first, m_compiles(toMap(test.second)) ? TestOutcome::Passed : TestOutcome::Failed, QString());
+        return true;
+    }
+
+    void dropPending()
+    {
+        m_pending.clear();
+    }
+
+    int launches() const
+    {
+        return m_requested.size();
+    }
+
+    const QList<QStringList> &requested() const
+    {
+        return m_requested;
+    }
+
+    const QList<QStringList> &answered() const
+    {
+        return m_answered;
+    }
+
+public slots:
+    void runTest(int testId, const QStringList &pins)
+    {
+        m_requested << pins;
+        if (m_queued)
+        {
+            m_pending.append(qMakePair(testId, pins));
+            return;
+        }
+        emit testFinished(testId, m_compiles(toMap(pins)) ? TestOutcome::Passed : TestOutcome::Failed, QString());
+    }
+
+signals:
+    void testFinished(int testId, TestOutcome outcome, const QString &outputPath);
+
+private:
+    static PinMap toMap(const QStringList &pins)
+    {
+        PinMap map;
+        for (int i = 0; i < pins.size(); ++i)
+        {
+            map.insert(pins.at(i).section("==", 0, 0), pins.at(i).section("==", 1));
+        }
+        return map;
+    }
+
+    std::function<bool(const PinMap &)> m_compiles;
+    bool m_queued;
+    QList<QPair<int, QStringList>> m_pending;
+    QList<QStringList> m_requested;
+    QList<QStringList> m_answered;
+};
+
+static QVector<PackageCandidates> matrix(const QList<QPair<QString, QStringList>> &columns)
+{
+    QVector<PackageCandidates> packages;
+    for (int i = 0; i < columns.size(); ++i)
+    {
+        packages.append(PackageCandidates{columns.at(i).first, columns.at(i).second});
+    }
+    return packages;
+}
+
+/****************************************************************
+ * @class TestResolver
+ ***************************************************************/
+class TestResolver : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void resolvesFirstPassingCombination();
+    void learnsMinimalConflict();
+    void exhaustsWhenNothingCompiles();
+    void timedOutTestIsNotCached();
+    void failsWhenTestsNeverRun();
+    void failureHintShortensDiagnosis();
+    void upcomingPinsFollowOdometer();
+    void checkpointRoundTrip();
+    void restoreRejectsMalformedState();
+    void buildCandidatesFromFloor();
+    void buildCandidatesWithUpperBound();
+    void buildCandidatesWithoutFloor();
+    void buildCandidatesExcludesPrefix();
+    void buildCandidatesExactPin();
+    void buildCandidatesKeepsMarker();
+};
+
+/****************************************************************
+ * @brief The odometer returns the first compiling combination.
+ ***************************************************************/
+void TestResolver::resolvesFirstPassingCombination()
 {
     ResolverEngine engine;
-    EXPECT_TRUE(engine.isValid());
+    engine.setCandidates(matrix({{"a", {"1", "2", "3"}}, {"b", {"1", "2"}}, {"c", {"1", "2"}}}));
+    ScriptedRunner runner([](const PinMap &pins) { return pins.value("a", "2") != "1"; });
+    runner.attach(&engine);
+    QSignalSpy resolved(&engine, &ResolverEngine::resolved);
+
+    QVERIFY(engine.start());
+    QCOMPARE(resolved.size(), 1);
+    QCOMPARE(resolved.first().first().toStringList(), QStringList({"a==2", "b==1", "c==1"}));
+    QVERIFY(!engine.isRunning());
 }
+
+/****************************************************************
+ * @brief Bisection learns exactly the two pins that clash.
+ ***************************************************************/
+void TestResolver::learnsMinimalConflict()
+{
+    ResolverEngine engine;
+    engine.setCandidates(matrix({{"a", {"1", "2"}}, {"b", {"1", "2"}}, {"c", {"1", "2"}}}));
+    ScriptedRunner runner([](const PinMap &pins)
+                          { return !(pins.value("a") == "1" && pins.value("c") == "1"); });
+    runner.attach(&engine);
+    QSignalSpy resolved(&engine, &ResolverEngine::resolved);
+
+    QVERIFY(engine.start());
+    QCOMPARE(resolved.size(), 1);
+    QCOMPARE(resolved.first().first().toStringList(), QStringList({"a==1", "b==1", "c==2"}));
+    QCOMPARE(engine.conflicts().size(), 1);
+    const ResolverSet conflict = engine.conflicts().first();
+    QCOMPARE(conflict.size(), 2);
+    QCOMPARE(conflict.at(0).package, 0);
+    QCOMPARE(conflict.at(0).version, 0);
+    QCOMPARE(conflict.at(1).package, 2);
+    QCOMPARE(conflict.at(1).version, 0);
+}
+
+/****************************************************************
+ * @brief Single-pin conflicts on every version exhaust the search.
+ ***************************************************************/
+void TestResolver::exhaustsWhenNothingCompiles()
+{
+    ResolverEngine engine;
+    engine.setCandidates(matrix({{"a", {"1", "2"}}, {"b", {"1", "2", "3"}}}));
+    ScriptedRunner runner([](const PinMap &pins) { return !pins.contains("b"); });
+    runner.attach(&engine);
+    QSignalSpy resolved(&engine, &ResolverEngine::resolved);
+    QSignalSpy exhausted(&engine, &ResolverEngine::exhausted);
+
+    QVERIFY(engine.start());
+    QCOMPARE(exhausted.size(), 1);
+    QCOMPARE(resolved.size(), 0);
+    QCOMPARE(engine.conflicts().size(), 3);
+    for (int i = 0; i < engine.conflicts().size(); ++i)
+    {
+        QCOMPARE(engine.conflicts().at(i).size(), 1);
+        QCOMPARE(engine.conflicts().at(i).first().package, 1);
+    }
+}
+
+/****************************************************************
+ * @brief A test that timed out is neither cached nor learned from;
+ *        the same set is asked again and its verdict recorded.
+ ***************************************************************/
+void TestResolver::timedOutTestIsNotCached()
+{
+    QTemporaryDir dir;
+    CompatibilityCache cache;
+    QVERIFY(cache.open(dir.path(), CompatibilityCache::environmentKey("3.11", "linux", "6", true, false)));
+    ResolverEngine engine;
+    engine.setCandidates(matrix({{"a", {"1", "2"}}, {"b", {"1", "2"}}}));
+    engine.setCache(&cache);
+    QList<QStringList> requested;
+    int errors = 0;
+    QObject::connect(&engine, &ResolverEngine::testRequested, &engine,
+                     [&](int testId, const QStringList &pins)
+                     {
+                         // The first attempt of every set hits the runner's timeout
+                         const bool timedOut = !requested.contains(pins);
+                         requested << pins;
+                         errors += timedOut ? 1 : 0;
+                         engine.reportTestResult(testId, timedOut ? TestOutcome::Error : TestOutcome::Passed, QString());
+                     });
+    QSignalSpy resolved(&engine, &ResolverEngine::resolved);
+
+    QVERIFY(engine.start());
+    QCOMPARE(resolved.size(), 1);
+    QCOMPARE(resolved.first().first().toStringList(), QStringList({"a==1", "b==1"}));
+    QCOMPARE(requested.count(requested.first()), 2);
+    QVERIFY(engine.conflicts().isEmpty());
+    QCOMPARE(cache.resultCount(), int(requested.size()) - errors);
+    QVERIFY(cache.conflicts().isEmpty());
+}
+
+/****************************************************************
+ * @brief A set that never gets a verdict fails the search instead
+ *        of exhausting it, and leaves nothing in the cache.
+ ***************************************************************/
+void TestResolver::failsWhenTestsNeverRun()
+{
+    QTemporaryDir dir;
+    CompatibilityCache cache;
+    QVERIFY(cache.open(dir.path(), CompatibilityCache::environmentKey("3.11", "linux", "6", true, false)));
+    ResolverEngine engine;
+    engine.setCandidates(matrix({{"a", {"1", "2"}}, {"b", {"1", "2"}}}));
+    engine.setCache(&cache);
+    QHash<QString, int> attempts;
+    QObject::connect(&engine, &ResolverEngine::testRequested, &engine,
+                     [&](int testId, const QStringList &pins)
+                     {
+                         ++attempts[pins.join(",")];
+                         engine.reportTestResult(testId, TestOutcome::Error, QString());
+                     });
+    QSignalSpy failed(&engine, &ResolverEngine::failed);
+    QSignalSpy exhausted(&engine, &ResolverEngine::exhausted);
+
+    QVERIFY(engine.start());
+    QCOMPARE(failed.size(), 1);
+    QCOMPARE(exhausted.size(), 0);
+    QCOMPARE(attempts.value("a==1,b==1"), int(ResolverEngine::kMaxTestErrors));
+    QVERIFY(!engine.isRunning());
+    QVERIFY(engine.conflicts().isEmpty());
+    QCOMPARE(cache.resultCount(), 0);
+    QVERIFY(cache.conflicts().isEmpty());
+}
+
+/****************************************************************
+ * @brief Compiles a..f (a==1 clashes with f==1), optionally telling
+ *        the engine which packages pip blamed.
+ ***************************************************************/
+static int launchesToResolve(bool hinted, QVector<ResolverSet> *conflicts)
+{
+    ResolverEngine engine;
+    engine.setCandidates(matrix({{"a", {"1", "2"}}, {"b", {"1", "2"}}, {"c", {"1", "2"}},
+                                 {"d", {"1", "2"}}, {"e", {"1", "2"}}, {"f", {"1", "2"}}}));
+    int launches = 0;
+    QObject::connect(&engine, &ResolverEngine::testRequested, &engine,
+                     [&](int testId, const QStringList &pins)
+                     {
+                         ++launches;
+                         const bool clash = pins.contains("a==1") && pins.contains("f==1");
+                         if (clash && hinted)
+                         {
+                             engine.setFailureHint(testId, {"f", "a"});
+                         }
+                         engine.reportTestResult(testId, clash ? TestOutcome::Failed : TestOutcome::Passed, QString());
+                     });
+    engine.start();
+    *conflicts = engine.conflicts();
+    return launches;
+}
+
+/****************************************************************
+ * @brief pip's blame is checked alone before bisecting the rest.
+ ***************************************************************/
+void TestResolver::failureHintShortensDiagnosis()
+{
+    QVector<ResolverSet> plain;
+    QVector<ResolverSet> hinted;
+    const int plainLaunches = launchesToResolve(false, &plain);
+    const int hintedLaunches = launchesToResolve(true, &hinted);
+    QVERIFY2(hintedLaunches < plainLaunches,
+             qPrintable(QString("%1 vs %2").arg(hintedLaunches).arg(plainLaunches)));
+    QCOMPARE(hinted.size(), 1);
+    QCOMPARE(hinted.first().size(), 2);
+    QCOMPARE(hinted.first().at(0).package, plain.first().at(0).package);
+    QCOMPARE(hinted.first().at(1).package, 5);
+}
+
+/****************************************************************
+ * @brief The look-ahead skips ruled-out combinations and the pins
+ *        already being compiled.
+ ***************************************************************/
+void TestResolver::upcomingPinsFollowOdometer()
+{
+    ResolverEngine engine;
+    engine.setCandidates(matrix({{"a", {"1", "2"}}, {"b", {"1", "2", "3"}}}));
+    engine.setStaticConflicts({ResolverSet{{0, 0}, {1, 1}}}); // a==1 x b==2
+    ScriptedRunner runner([](const PinMap &) { return false; }, true);
+    runner.attach(&engine);
+    QVERIFY(engine.upcomingPins(2).isEmpty());
+
+    QVERIFY(engine.start());
+    QCOMPARE(runner.requested().size(), 1);
+    QCOMPARE(runner.requested().first(), QStringList({"a==1", "b==1"}));
+    QCOMPARE(engine.upcomingPins(1), QStringList({"b==3"}));
+    QCOMPARE(engine.upcomingPins(2), QStringList({"b==3", "a==2"}));
+    QCOMPARE(engine.upcomingPins(10), QStringList({"b==3", "a==2", "b==2"}));
+    engine.stop();
+    QVERIFY(engine.upcomingPins(2).isEmpty());
+}
+
+/****************************************************************
+ * @brief A search restored from a mid-run snapshot ends where an
+ *        uninterrupted one does, without repeating settled tests.
+ ***************************************************************/
+void TestResolver::checkpointRoundTrip()
+{
+    const QVector<PackageCandidates> packages =
+        matrix({{"a", {"1", "2", "3"}}, {"b", {"1", "2", "3"}}, {"c", {"1", "2"}}, {"d", {"1", "2"}}});
+    const auto compiles = [](const PinMap &pins)
+    {
+        if (pins.value("a") == "1" && pins.value("d") == "1")
+        {
+            return false;
+        }
+        if (pins.value("b") == "1" && pins.value("c") != "2" && pins.contains("c"))
+        {
+            return false;
+        }
+        return pins.value("a") != "2";
+    };
+
+    ResolverEngine reference;
+    reference.setCandidates(packages);
+    reference.setMaxParallelTests(2);
+    ScriptedRunner direct(compiles, true);
+    direct.attach(&reference);
+    QSignalSpy referenceResolved(&reference, &ResolverEngine::resolved);
+    QVERIFY(reference.start());
+    while (direct.releaseOne())
+    {
+    }
+    QCOMPARE(referenceResolved.size(), 1);
+
+    ResolverEngine first;
+    first.setCandidates(packages);
+    first.setMaxParallelTests(2);
+    ScriptedRunner before(compiles, true);
+    before.attach(&first);
+    QVERIFY(first.start());
+    for (int i = 0; i < 3; ++i)
+    {
+        QVERIFY(before.releaseOne());
+    }
+    QVERIFY(first.isRunning());
+    const quint64 revision = first.stateRevision();
+    const QCborMap state = first.saveState();
+    QVERIFY(!state.isEmpty());
+    QCOMPARE(first.stateRevision(), revision);
+    before.detach(&first);
+    before.dropPending();
+
+    // Through bytes, as ResolverCheckpoint stores it
+    const QCborMap reloaded = QCborValue::fromCbor(QCborValue(state).toCbor()).toMap();
+    ResolverEngine second;
+    QVERIFY(second.restoreState(reloaded));
+    QVERIFY(second.isRunning());
+    QVERIFY(second.isPaused());
+    QCOMPARE(second.conflicts().size(), first.conflicts().size());
+
+    ScriptedRunner after(compiles, true);
+    after.attach(&second);
+    QSignalSpy resolved(&second, &ResolverEngine::resolved);
+    second.resume();
+    while (after.releaseOne())
+    {
+    }
+    QCOMPARE(resolved.size(), 1);
+    QCOMPARE(resolved.first().first().toStringList(), referenceResolved.first().first().toStringList());
+    for (int i = 0; i < before.answered().size(); ++i)
+    {
+        QVERIFY(!after.requested().contains(before.answered().at(i)));
+    }
+}
+
+void TestResolver::restoreRejectsMalformedState()
+{
+    ResolverEngine engine;
+    engine.setCandidates(matrix({{"a", {"1"}}}));
+    QVERIFY(!engine.restoreState(QCborMap()));
+    QCborMap bogus;
+    bogus.insert(QStringLiteral("format"), 999);
+    QVERIFY(!engine.restoreState(bogus));
+    QVERIFY(!engine.isRunning());
+    QCOMPARE(engine.candidates().size(), 1);
+
+    // A checked core with an empty bisection range would read failing[-1]
+    ResolverEngine running;
+    running.setCandidates(matrix({{"a", {"1"}}}));
+    ScriptedRunner held([](const PinMap &) { return true; }, true);
+    held.attach(&running);
+    QVERIFY(running.start());
+    const QCborValue format = running.saveState().value(QStringLiteral("format"));
+    QCborMap package;
+    package.insert(QStringLiteral("name"), QStringLiteral("a"));
+    package.insert(QStringLiteral("versions"), QCborArray{QStringLiteral("1")});
+    QCborMap diagnosis;
+    diagnosis.insert(QStringLiteral("failing"), QCborArray{0, 0});
+    diagnosis.insert(QStringLiteral("core"), QCborArray());
+    diagnosis.insert(QStringLiteral("limit"), 1);
+    diagnosis.insert(QStringLiteral("lo"), 0);
+    diagnosis.insert(QStringLiteral("hi"), 0);
+    diagnosis.insert(QStringLiteral("coreChecked"), true);
+    QCborMap diagnosing;
+    diagnosing.insert(QStringLiteral("format"), format);
+    diagnosing.insert(QStringLiteral("packages"), QCborArray{package});
+    diagnosing.insert(QStringLiteral("current"), QCborArray{0});
+    diagnosing.insert(QStringLiteral("diagnosing"), true);
+    diagnosing.insert(QStringLiteral("diagnosis"), diagnosis);
+    QVERIFY(!engine.restoreState(diagnosing));
+    diagnosis.insert(QStringLiteral("lo"), 1);
+    diagnosis.insert(QStringLiteral("hi"), 1);
+    diagnosing.insert(QStringLiteral("diagnosis"), diagnosis);
+    QVERIFY(!engine.restoreState(diagnosing));
+    QVERIFY(!engine.isRunning());
+
+    diagnosis.insert(QStringLiteral("lo"), 0);
+    diagnosing.insert(QStringLiteral("diagnosis"), diagnosis);
+    QVERIFY(engine.restoreState(diagnosing));
+    QVERIFY(engine.isPaused());
+    engine.stop();
+}
+
+static const QStringList kReleases = {"1.0", "1.1", "1.1.2", "1.2", "1.2.1", "1.3", "2.0rc1", "2.0"};
+
+/****************************************************************
+ * @brief "==" is a floor: the floor, then the next minors' latest
+ *        patches; pre-releases are never candidates.
+ ***************************************************************/
+void TestResolver::buildCandidatesFromFloor()
+{
+    const PackageCandidates pkg = CandidateFetcher::buildCandidates("Some_Pkg==1.1", kReleases, 2);
+    QCOMPARE(pkg.name, QString("Some_Pkg"));
+    QCOMPARE(pkg.versions, QStringList({"1.1", "1.2.1", "1.3"}));
+
+    QCOMPARE(CandidateFetcher::buildCandidates("pkg>=1.2", kReleases, 5).versions,
+             QStringList({"1.2", "1.3", "2.0"}));
+    QCOMPARE(CandidateFetcher::buildCandidates("pkg>=1.1", kReleases, 0).versions,
+             QStringList({"1.1"}));
+
+    // Through SpecifierSet: only it reads the pre-release bound
+    QCOMPARE(CandidateFetcher::buildCandidates("Some_Pkg==1.1,<1.3rc1", kReleases, 2).versions,
+             QStringList({"1.1", "1.2.1"}));
+}
+
+void TestResolver::buildCandidatesWithUpperBound()
+{
+    QCOMPARE(CandidateFetcher::buildCandidates("pkg>=1.1,<1.3", kReleases, 2).versions,
+             QStringList({"1.1", "1.2.1"}));
+    QCOMPARE(CandidateFetcher::buildCandidates("pkg>=1.1,!=1.1", kReleases, 1).versions,
+             QStringList({"1.1.2", "1.2.1"}));
+    QVERIFY(CandidateFetcher::buildCandidates("pkg>=3.0", kReleases, 2).versions.isEmpty());
+}
+
+void TestResolver::buildCandidatesWithoutFloor()
+{
+    const PackageCandidates pkg = CandidateFetcher::buildCandidates("imageio[ffmpeg]", kReleases, 1);
+    QCOMPARE(pkg.name, QString("imageio[ffmpeg]"));
+    QCOMPARE(pkg.versions, QStringList({"2.0", "1.3"}));
+}
+
+/****************************************************************
+ * @brief "!=X.*" drops the whole release series, not just "X".
+ ***************************************************************/
+void TestResolver::buildCandidatesExcludesPrefix()
+{
+    QCOMPARE(CandidateFetcher::buildCandidates("pkg>=1.0,!=1.1.*", kReleases, 5).versions,
+             QStringList({"1.0", "1.2.1", "1.3", "2.0"}));
+    QCOMPARE(CandidateFetcher::buildCandidates("pkg!=1.*", kReleases, 2).versions, QStringList({"2.0"}));
+    QCOMPARE(CandidateFetcher::buildCandidates("pkg>=1.1,!=1.1", kReleases, 0).versions,
+             QStringList({"1.1.2"}));
+}
+
+void TestResolver::buildCandidatesExactPin()
+{
+    QCOMPARE(CandidateFetcher::buildCandidates("pkg===1.1.2", kReleases, 2).versions,
+             QStringList({"1.1.2"}));
+    QVERIFY(CandidateFetcher::buildCandidates("-r other.txt", kReleases, 2).versions.isEmpty());
+}
+
+void TestResolver::buildCandidatesKeepsMarker()
+{
+    const PackageCandidates pkg = CandidateFetcher::buildCandidates(
+        "pkg (>=1.3) ; python_version >= \"3.9\" --hash=sha256:abc", kReleases, 0);
+    QCOMPARE(pkg.name, QString("pkg"));
+    QCOMPARE(pkg.versions, QStringList({"1.3"}));
+    QCOMPARE(pkg.marker, QString("python_version >= \"3.9\""));
+    QVERIFY(CandidateFetcher::buildCandidates("pkg @ https://example.com/pkg.whl", kReleases, 2)
+                .versions.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestResolver)
+#include "test_resolver.moc"
+/************** End of test_resolver.cpp ************************/
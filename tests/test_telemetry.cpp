@@ -0,0 +1,164 @@
+/****************************************************************
+ * @file test_telemetry.cpp
+ * @brief Unit tests for Telemetry.
+ *
+ * @author Jeffrey Scott Flesher
+ * @version 0.1
+ * @date    2026-10-14
+ * @section License MIT
+ ***************************************************************/
+#include <QtTest/QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include "Telemetry.h"
+
+static const Telemetry::Phase *findPhase(const Telemetry::Snapshot &snap, const QString &name)
+{
+    for (int i = 0; i < snap.phases.size(); ++i)
+    {
+        if (snap.phases.at(i).name == name)
+        {
+            return &snap.phases.at(i);
+        }
+    }
+    return nullptr;
+}
+
+/****************************************************************
+ * @class TestTelemetry
+ ***************************************************************/
+class TestTelemetry : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void totalsSpansByPhase();
+    void countsCounters();
+    void resetDropsOpenSpans();
+    void exportsTraceEvents();
+};
+
+void TestTelemetry::init()
+{
+    Telemetry::reset();
+}
+
+void TestTelemetry::totalsSpansByPhase()
+{
+    const qint64 a = Telemetry::begin("pip-compile", "worker 1");
+    const qint64 b = Telemetry::begin("pip-compile", "worker 2");
+    {
+        Telemetry::Scope scope("pip upgrade", "terminal");
+        scope.setFailed();
+    }
+    Telemetry::Snapshot snap = Telemetry::snapshot();
+    QCOMPARE(findPhase(snap, "pip-compile")->active, 2);
+    QCOMPARE(findPhase(snap, "pip-compile")->count, 0);
+    QCOMPARE(findPhase(snap, "pip upgrade")->failed, 1);
+
+    QTest::qSleep(5);
+    Telemetry::end(a, true);
+    Telemetry::end(b, false);
+    Telemetry::end(b, false); // ignored
+    snap = Telemetry::snapshot();
+    const Telemetry::Phase *compile = findPhase(snap, "pip-compile");
+    QCOMPARE(compile->active, 0);
+    QCOMPARE(compile->count, 2);
+    QCOMPARE(compile->failed, 1);
+    QVERIFY(compile->maxUs >= 5000);
+    QVERIFY(compile->totalUs >= 2 * 5000);
+    QCOMPARE(snap.phases.first().name, QString("pip-compile"));
+    QCOMPARE(snap.events, 3);
+}
+
+void TestTelemetry::countsCounters()
+{
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
+    Telemetry::add(Telemetry::Counter::ProcessLaunches);
+    Telemetry::add(Telemetry::Counter::BytesDownloaded, 4096);
+    const Telemetry::Snapshot snap = Telemetry::snapshot();
+    QCOMPARE(snap.counters[int(Telemetry::Counter::ProcessLaunches)], qint64(2));
+    QCOMPARE(snap.counters[int(Telemetry::Counter::BytesDownloaded)], qint64(4096));
+    QCOMPARE(snap.counters[int(Telemetry::Counter::Retries)], qint64(0));
+    QVERIFY(!Telemetry::counterName(Telemetry::Counter::CacheHits).isEmpty());
+}
+
+void TestTelemetry::resetDropsOpenSpans()
+{
+    const qint64 stale = Telemetry::begin("pip wheel", "wheelhouse");
+    Telemetry::add(Telemetry::Counter::Retries);
+    Telemetry::reset();
+    const qint64 fresh = Telemetry::begin("pip wheel", "wheelhouse");
+    QVERIFY(fresh != stale);
+
+    Telemetry::end(stale);
+    Telemetry::Snapshot snap = Telemetry::snapshot();
+    QCOMPARE(findPhase(snap, "pip wheel")->active, 1);
+    QCOMPARE(findPhase(snap, "pip wheel")->count, 0);
+    QCOMPARE(snap.counters[int(Telemetry::Counter::Retries)], qint64(0));
+
+    Telemetry::end(fresh);
+    snap = Telemetry::snapshot();
+    QCOMPARE(findPhase(snap, "pip wheel")->count, 1);
+}
+
+void TestTelemetry::exportsTraceEvents()
+{
+    // Two overlapping spans on one track go to separate rows
+    const qint64 first = Telemetry::begin("batch job", "batch", QJsonObject{{"label", "train"}});
+    const qint64 second = Telemetry::begin("batch job", "batch");
+    Telemetry::end(first, false);
+    const qint64 third = Telemetry::begin("batch job", "batch");
+    Telemetry::end(third);
+    Telemetry::add(Telemetry::Counter::CacheHits, 3);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("trace.json");
+    QVERIFY(Telemetry::exportTrace(path));
+    Telemetry::end(second);
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    const QJsonArray events = doc.object().value("traceEvents").toArray();
+
+    QStringList threadNames;
+    QList<QJsonObject> spans;
+    qint64 lastCacheHits = -1;
+    for (int i = 0; i < events.size(); ++i)
+    {
+        const QJsonObject event = events.at(i).toObject();
+        const QString ph = event.value("ph").toString();
+        if (ph == "M" && event.value("name").toString() == "thread_name")
+        {
+            threadNames << event.value("args").toObject().value("name").toString();
+        }
+        else if (ph == "X")
+        {
+            spans << event;
+        }
+        else if (ph == "C" && event.value("name").toString() == Telemetry::counterName(Telemetry::Counter::CacheHits))
+        {
+            lastCacheHits = event.value("args").toObject().value("value").toInteger();
+        }
+    }
+    QCOMPARE(threadNames, QStringList({"batch", "batch #2"}));
+    QCOMPARE(spans.size(), 3);
+    QCOMPARE(spans.at(0).value("tid").toInt(), 1);
+    QCOMPARE(spans.at(1).value("tid").toInt(), 2);
+    QCOMPARE(spans.at(2).value("tid").toInt(), 1); // reuses the freed row
+    QCOMPARE(spans.at(0).value("args").toObject().value("label").toString(), QString("train"));
+    QVERIFY(spans.at(0).value("args").toObject().value("failed").toBool());
+    QVERIFY(spans.at(1).value("args").toObject().value("unfinished").toBool());
+    QVERIFY(!spans.at(2).contains("args"));
+    QCOMPARE(lastCacheHits, qint64(3));
+}
+
+QTEST_GUILESS_MAIN(TestTelemetry)
+#include "test_telemetry.moc"
+/************** End of test_telemetry.cpp ***********************/